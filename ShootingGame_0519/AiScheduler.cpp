@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <cstdint>
+#include "AiScheduler.h"
+#include "GameObject.h"
+#include "RandomService.h"
+
+using namespace DirectX::SimpleMath;
+
+namespace
+{
+    //iK̍XVԊu(t[)
+    constexpr uint32_t TIER_INTERVALS[AiScheduler::MAX_AI_TIER] = { 1, 2, 4, 8 };
+
+    //vC[炱̋܂ł̒iK(FreeStage01  400 x 600 炢)
+    constexpr float TIER_DISTANCES[AiScheduler::MAX_AI_TIER - 1] = { 150.0f, 300.0f, 500.0f };
+
+    //ʂ̒[Ő؂ւȂ悤ɏL߂Ɍ(NbvԂ̊)
+    constexpr float VISIBLE_MARGIN = 0.2f;
+
+    //~܂ĂɈxɐi߂Ȃ(߂ dt ̏)
+    constexpr float MAX_ACCUMULATED_DT = 0.5f;
+
+    //1t[AI̎Ԃ̏̏l
+    constexpr float DEFAULT_BUDGET_MS = 2.0f;
+}
+
+bool AiScheduler::m_enabled = true;
+float AiScheduler::m_budgetMs = DEFAULT_BUDGET_MS;
+
+bool AiScheduler::m_hasFocus = false;
+Vector3 AiScheduler::m_focusPos;
+Matrix AiScheduler::m_viewProj;
+
+uint32_t AiScheduler::m_frame = 0;
+std::unordered_map<const GameObject*, AiScheduler::OwnerFrame> AiScheduler::m_owners;
+std::unordered_set<const GameObject*> AiScheduler::m_overdue;
+AiScheduler::Stats AiScheduler::m_stats;
+AiScheduler::Stats AiScheduler::m_lastStats;
+
+AiScheduler::Agent::Agent()
+{
+    //Ō܂(AhXƎsɕς)
+    phase = RandomService::CreateEntityStream(RandomService::RANDOM_SYSTEM_AI).Next();
+}
+
+AiScheduler::Slice::Slice(Agent& agent, GameObject* owner, float dt)
+{
+    agent.accumulatedDt = std::min(agent.accumulatedDt + dt, MAX_ACCUMULATED_DT);
+
+    if (!m_enabled || !m_hasFocus || !owner)
+    {
+        agent.tier = AI_TIER_NEAR;
+        m_stats.agents[AI_TIER_NEAR]++;
+        m_stats.updated++;
+    }
+    else
+    {
+        //IuWFNg2ڈȍ~̃R|[lg͍ŏ̔ɏ]
+        const OwnerFrame& decision = Decide(owner, agent.phase);
+        agent.tier = decision.tier;
+        if (!decision.run)
+        {
+            return;
+        }
+    }
+
+    m_run = true;
+    m_dt = agent.accumulatedDt;
+    agent.accumulatedDt = 0.0f;
+
+    m_start = std::chrono::high_resolution_clock::now();
+}
+
+AiScheduler::Slice::~Slice()
+{
+    if (!m_run)
+    {
+        return;
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    m_stats.aiMs += static_cast<float>(std::chrono::duration<double, std::milli>(end - m_start).count());
+}
+
+void AiScheduler::SetFocus(const Vector3& focusPos, const Matrix& viewProj)
+{
+    m_focusPos = focusPos;
+    m_viewProj = viewProj;
+    m_hasFocus = true;
+}
+
+void AiScheduler::EndFrame()
+{
+    m_lastStats = m_stats;
+    m_stats = Stats();
+
+    //Ŕ΂IuWFNg͎̃t[ŔԂɊ֌WȂ
+    m_overdue.clear();
+    for (const auto& [owner, decision] : m_owners)
+    {
+        if (decision.deferred)
+        {
+            m_overdue.insert(owner);
+        }
+    }
+    m_owners.clear();
+
+    m_hasFocus = false;
+    m_frame++;
+}
+
+const AiScheduler::OwnerFrame& AiScheduler::Decide(GameObject* owner, uint32_t phase)
+{
+    auto [it, inserted] = m_owners.try_emplace(owner);
+    OwnerFrame& decision = it->second;
+    if (!inserted)
+    {
+        return decision;
+    }
+
+    decision.tier = SelectTier(owner);
+    m_stats.agents[decision.tier]++;
+
+    if (decision.tier != AI_TIER_NEAR)
+    {
+        //̔ԂłȂAOɔ΂ĂȂȂ dt 𒙂߂邾
+        const uint32_t interval = TIER_INTERVALS[decision.tier];
+        if (m_overdue.count(owner) == 0 && (m_frame + phase) % interval != 0)
+        {
+            return decision;
+        }
+
+        //𒴂玟̃t[(߂G͕K)
+        if (m_budgetMs > 0.0f && m_stats.aiMs >= m_budgetMs)
+        {
+            decision.deferred = true;
+            m_stats.deferred++;
+            return decision;
+        }
+    }
+
+    decision.run = true;
+    m_stats.updated++;
+    return decision;
+}
+
+AiScheduler::AI_TIER AiScheduler::SelectTier(GameObject* owner)
+{
+    const Vector3& pos = owner->GetPosition();
+    const float distSq = (pos - m_focusPos).LengthSquared();
+
+    int tier = MAX_AI_TIER - 1;
+    for (int i = 0; i < MAX_AI_TIER - 1; ++i)
+    {
+        if (distSq < TIER_DISTANCES[i] * TIER_DISTANCES[i])
+        {
+            tier = i;
+            break;
+        }
+    }
+
+    //ʂɉfĂȂȂ1iKƂ
+    if (!IsVisible(pos))
+    {
+        tier = std::min(tier + 1, MAX_AI_TIER - 1);
+    }
+
+    return static_cast<AI_TIER>(tier);
+}
+
+bool AiScheduler::IsVisible(const Vector3& pos)
+{
+    const Vector4 clip = Vector4::Transform(Vector4(pos.x, pos.y, pos.z, 1.0f), m_viewProj);
+
+    //J̌
+    if (clip.w <= 0.0f)
+    {
+        return false;
+    }
+
+    const float limit = clip.w * (1.0f + VISIBLE_MARGIN);
+    return clip.x >= -limit && clip.x <= limit &&
+           clip.y >= -limit && clip.y <= limit &&
+           clip.z <= clip.w;
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <SimpleMath.h>
+
+class GameObject;
+
+//---------------------------------------------------------
+// GAI̍XVpx߂NX(AILOD)
+// vC[̋ƉʂɉfĂ邩ŒiK(tier)߁A
+// EĂȂG͐t[1񂾂 Update 
+// EiK̓G̓IuWFNgɂ炵t[ŉ(Ehr)
+//   炷l RandomService ̃IuWFNg̗񂩂̂ŁAV[hȂ疈񓯂
+// E΂t[ dt ͒߂ĂAɉ鎞ɂ܂Ƃ߂ēn
+// E1t[AI̎Ԃ𒴂A߂GȊÕ͎t[ɉ
+// iKƏ̔̓IuWFNgɃt[1񂾂sA
+// IuWFNg̃R|[lg͂܂Ƃ߂ĉ(܂͑Sɉ)
+//---------------------------------------------------------
+class AiScheduler
+{
+public:
+    enum AI_TIER
+    {
+        AI_TIER_NEAR,       //t[
+        AI_TIER_MID,        //2t[1
+        AI_TIER_FAR,        //4t[1
+        AI_TIER_DORMANT,    //8t[1
+
+        MAX_AI_TIER
+    };
+
+    //R|[lg1(΂ dt ̓R|[lgɒ߂)
+    struct Agent
+    {
+        Agent();
+
+        float accumulatedDt = 0.0f;     //܂nĂȂ dt
+        AI_TIER tier = AI_TIER_NEAR;
+        uint32_t phase = 0;             //Ԃ炷l(IuWFNgł͂̃t[ōŏɉR|[lg̒lg)
+    };
+
+    //Update ̓ōBfalse Ȃ獡t[͉Ȃ
+    //鎞 GetDt() ɒ߂ dt A鎞AI̎Ԃɑ
+    //  AiScheduler::Slice slice(m_aiAgent, GetOwner(), dt);
+    //  if (!slice) { return; }
+    //  dt = slice.GetDt();
+    class Slice
+    {
+    public:
+        Slice(Agent& agent, GameObject* owner, float dt);
+        ~Slice();
+
+        Slice(const Slice&) = delete;
+        Slice& operator=(const Slice&) = delete;
+
+        explicit operator bool() const { return m_run; }
+        float GetDt() const { return m_dt; }
+
+    private:
+        bool m_run = false;
+        float m_dt = 0.0f;
+        std::chrono::high_resolution_clock::time_point m_start;
+    };
+
+    //1t[̓v(̓IuWFNgP)
+    struct Stats
+    {
+        int agents[MAX_AI_TIER] = {};   //iK̐
+        int updated = 0;                //
+        int deferred = 0;               //Ŏɉ񂵂
+        float aiMs = 0.0f;              //̍v
+    };
+
+    //t[G Update ̑OɌĂ(̊ƉʂɉfĂ邩𒲂ׂs)
+    static void SetFocus(const DirectX::SimpleMath::Vector3& focusPos, const DirectX::SimpleMath::Matrix& viewProj);
+
+    //t[̓vm肳(Game ̍XV̍ŌɌĂ)
+    static void EndFrame();
+
+    //--------Set֐-------
+    static void SetEnabled(bool enable) { m_enabled = enable; }
+    //0 Ȃ(wbhXs͎ԂŌʂςȂ悤 0 ɂ)
+    static void SetBudgetMs(float ms) { m_budgetMs = ms; }
+
+    //--------Get֐-------
+    static bool IsEnabled() { return m_enabled; }
+    static float GetBudgetMs() { return m_budgetMs; }
+    static const Stats& GetStats() { return m_lastStats; }
+
+private:
+    //IuWFNĝ̃t[̔(ŏ̃R|[lg Slice Ō߂)
+    struct OwnerFrame
+    {
+        AI_TIER tier = AI_TIER_NEAR;
+        bool run = false;
+        bool deferred = false;          //Ŕ΂(̃t[ŕK)
+    };
+
+    static const OwnerFrame& Decide(GameObject* owner, uint32_t phase);
+    static AI_TIER SelectTier(GameObject* owner);
+    static bool IsVisible(const DirectX::SimpleMath::Vector3& pos);
+
+    static bool m_enabled;
+    static float m_budgetMs;
+
+    //SetFocus Ă΂ꂽt[iKt(Ă΂ȂV[ł͑St[)
+    static bool m_hasFocus;
+    static DirectX::SimpleMath::Vector3 m_focusPos;
+    static DirectX::SimpleMath::Matrix m_viewProj;
+
+    static uint32_t m_frame;
+    static std::unordered_map<const GameObject*, OwnerFrame> m_owners;
+    static std::unordered_set<const GameObject*> m_overdue;     //Õt[ŏŔ΂IuWFNg
+    static Stats m_stats;
+    static Stats m_lastStats;
+};
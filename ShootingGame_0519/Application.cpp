@@ -1,6 +1,7 @@
 #include <chrono>
 #include <iostream>
 #include "Application.h"
+#include <d3d11.h>
 #include "renderer.h"
 #include "DebugGlobals.h"
 #include "TransitionManager.h"
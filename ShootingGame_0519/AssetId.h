@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+//---------------------------------------------------------
+// AZbg̃pXnbV ID
+// pX FNV-1a (64bit) ŃnbVALbV(AssetTable)͂ ID ň
+// constexpr  AssetPath ̓RpCɃnbVςނ̂ŁA
+// š͐ł̒TɂȂ
+//---------------------------------------------------------
+
+namespace AssetHash
+{
+    constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+    constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+    //char  wchar_t œpXȂ瓯lɂȂ悤ɁA1ʃoCg珇ɍ
+    //(ASCII 1oCg)
+    template<typename CharT>
+    constexpr uint64_t Hash(const CharT* str, size_t length)
+    {
+        uint64_t hash = FNV_OFFSET;
+        for (size_t i = 0; i < length; ++i)
+        {
+            uint32_t c = static_cast<uint32_t>(static_cast<std::make_unsigned_t<CharT>>(str[i]));
+            do
+            {
+                hash ^= (c & 0xFF);
+                hash *= FNV_PRIME;
+                c >>= 8;
+            } while (c != 0);
+        }
+        return hash;
+    }
+}
+
+//Tag Ŏނ𕪂 ID (eNX` ID TEhɓnƃRpCG[)
+template<typename Tag>
+struct AssetId
+{
+    uint64_t value = 0;
+
+    constexpr AssetId() = default;
+    constexpr explicit AssetId(uint64_t hash) : value(hash) {}
+
+    //sɕ񂩂(ǂݍݎȂǁAzbgpXȊOŎg)
+    template<typename CharT>
+    static AssetId FromString(const std::basic_string<CharT>& path)
+    {
+        return AssetId(AssetHash::Hash(path.data(), path.size()));
+    }
+
+    constexpr bool operator==(AssetId other) const { return value == other.value; }
+    constexpr bool operator!=(AssetId other) const { return value != other.value; }
+};
+
+//ID ƌ̃pX̑g(LbVɖ͂̃pXǂݍ)
+//񃊃e炵Ȃ̂ŁAconstexpr ϐɂĂ΃nbV̓RpCɍς
+//  ) constexpr TexturePath BULLET_TRAIL_TEXTURE("Asset/Effect/Bullet_Trail.png");
+template<typename Tag, typename CharT = char>
+struct AssetPath
+{
+    AssetId<Tag> id;
+    const CharT* path = nullptr;
+
+    template<size_t N>
+    constexpr explicit AssetPath(const CharT (&str)[N]) : id(AssetHash::Hash(str, N - 1)), path(str) {}
+};
+
+//-----------------------AZbg̎-----------------------
+struct TextureAssetTag {};
+struct SoundAssetTag {};
+struct SceneAssetTag {};
+struct ModelAssetTag {};
+
+using TextureId = AssetId<TextureAssetTag>;
+using TexturePath = AssetPath<TextureAssetTag>;
+using SoundId = AssetId<SoundAssetTag>;
+using SoundPath = AssetPath<SoundAssetTag, wchar_t>;
+using SceneId = AssetId<SceneAssetTag>;
+using ModelId = AssetId<ModelAssetTag>;
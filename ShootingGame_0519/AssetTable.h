@@ -0,0 +1,198 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <utility>
+#include "AssetId.h"
+
+#if defined(_DEBUG)
+#include <cassert>
+#include <windows.h>
+#endif
+
+//---------------------------------------------------------
+// AssetId L[ɂI[vAhX@(`T)̃nbVe[u
+// L[ɃnbVlȂ̂ŁAʃrbĝ܂܈ʒuɎg
+// vf͔zɒڕԂ̂ŁA Value ͈ړ
+// (AhXOɓnl unique_ptr ȂǂŎ)
+//
+// fobOrhł̖͌OoĂA
+// ႤO ID ňꂽ(nbV̏Փ)~߂
+//---------------------------------------------------------
+template<typename Tag, typename Value>
+class AssetTable
+{
+public:
+    //Ȃ nullptr
+    //name : ƂĂ錳̖O(fobOrh̏ՓˌoɎg)
+    template<typename CharT>
+    Value* Find(AssetId<Tag> id, const CharT* name)
+    {
+        if (m_slots.empty()) { return nullptr; }
+
+        const size_t mask = m_slots.size() - 1;
+        for (size_t i = static_cast<size_t>(id.value) & mask; ; i = (i + 1) & mask)
+        {
+            Slot& slot = m_slots[i];
+            if (!slot.used) { return nullptr; }
+            if (slot.key == id.value)
+            {
+                CheckCollision(slot, name);
+                return &slot.value;
+            }
+        }
+    }
+
+    Value* Find(AssetId<Tag> id)
+    {
+        return Find(id, static_cast<const char*>(nullptr));
+    }
+
+    // ID Ώ㏑
+    template<typename CharT>
+    Value& Insert(AssetId<Tag> id, const CharT* name, Value value)
+    {
+        if (Value* existing = Find(id, name))
+        {
+            *existing = std::move(value);
+            return *existing;
+        }
+
+        //gp𔼕ȉɕۂ
+        if ((m_count + 1) * 2 > m_slots.size())
+        {
+            Rehash(m_slots.empty() ? INITIAL_CAPACITY : m_slots.size() * 2);
+        }
+
+        Slot& slot = FindEmpty(id.value);
+        slot.used = true;
+        slot.key = id.value;
+        slot.value = std::move(value);
+#if defined(_DEBUG)
+        slot.name = ToName(name);
+#endif
+        m_count++;
+        return slot.value;
+    }
+
+    //Ώ true
+    bool Erase(AssetId<Tag> id)
+    {
+        if (m_slots.empty()) { return false; }
+
+        const size_t mask = m_slots.size() - 1;
+        size_t i = static_cast<size_t>(id.value) & mask;
+        while (m_slots[i].used && m_slots[i].key != id.value)
+        {
+            i = (i + 1) & mask;
+        }
+        if (!m_slots[i].used) { return false; }
+
+        //ɑvfl߂āAT̓r؂Ȃ(WgȂ)
+        size_t hole = i;
+        for (size_t j = (i + 1) & mask; m_slots[j].used; j = (j + 1) & mask)
+        {
+            const size_t home = static_cast<size_t>(m_slots[j].key) & mask;
+            //home  (hole, j] ̊OȂ hole Ɉڂ
+            const bool between = (hole <= j) ? (hole < home && home <= j) : (hole < home || home <= j);
+            if (!between)
+            {
+                m_slots[hole] = std::move(m_slots[j]);
+                hole = j;
+            }
+        }
+        m_slots[hole] = Slot{};
+        m_count--;
+        return true;
+    }
+
+    void Clear()
+    {
+        m_slots.clear();
+        m_count = 0;
+    }
+
+    //func(AssetId<Tag>, Value&)
+    template<typename Func>
+    void ForEach(Func func)
+    {
+        for (auto& slot : m_slots)
+        {
+            if (slot.used) { func(AssetId<Tag>(slot.key), slot.value); }
+        }
+    }
+
+    //--------Get֐-------
+    size_t GetCount() const { return m_count; }
+    size_t GetCapacity() const { return m_slots.size(); }
+
+private:
+    static constexpr size_t INITIAL_CAPACITY = 64;   //2̗ݏ
+
+    struct Slot
+    {
+        uint64_t key = 0;
+        bool used = false;
+        Value value{};
+#if defined(_DEBUG)
+        std::string name;
+#endif
+    };
+
+    Slot& FindEmpty(uint64_t key)
+    {
+        const size_t mask = m_slots.size() - 1;
+        size_t i = static_cast<size_t>(key) & mask;
+        while (m_slots[i].used)
+        {
+            i = (i + 1) & mask;
+        }
+        return m_slots[i];
+    }
+
+    void Rehash(size_t capacity)
+    {
+        std::vector<Slot> old;
+        old.swap(m_slots);
+        m_slots.resize(capacity);
+
+        for (auto& slot : old)
+        {
+            if (slot.used)
+            {
+                FindEmpty(slot.key) = std::move(slot);
+            }
+        }
+    }
+
+#if defined(_DEBUG)
+    template<typename CharT>
+    static std::string ToName(const CharT* name)
+    {
+        std::string result;
+        for (; name && *name; ++name)
+        {
+            result.push_back(static_cast<char>(*name));
+        }
+        return result;
+    }
+
+    template<typename CharT>
+    static void CheckCollision(const Slot& slot, const CharT* name)
+    {
+        if (!name) { return; }
+
+        const std::string requested = ToName(name);
+        if (requested != slot.name)
+        {
+            OutputDebugStringA(("AssetTable: hash collision \"" + requested + "\" vs \"" + slot.name + "\"\n").c_str());
+            assert(false && "AssetTable: asset id collision");
+        }
+    }
+#else
+    template<typename CharT>
+    static void CheckCollision(const Slot&, const CharT*) {}
+#endif
+
+    std::vector<Slot> m_slots;
+    size_t m_count = 0;
+};
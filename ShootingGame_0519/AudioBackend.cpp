@@ -0,0 +1,124 @@
+#if defined(_MSC_VER) && !defined(_CRT_SECURE_NO_WARNINGS)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+#include <algorithm>
+#include "AudioBackend.h"
+#include "AudioMixKernels.h"
+
+namespace
+{
+    //1 render ŏt[̏
+    constexpr int MAX_RENDER_FRAMES = 1024;
+}
+
+//-----------------------NullAudioBackend-----------------------
+
+bool NullAudioBackend::Start(int sampleRate, int channels, RenderFunc render)
+{
+    m_render = std::move(render);
+    m_sampleRate = sampleRate;
+    m_channels = channels;
+    m_pendingFrames = 0.0;
+    m_renderedFrames = 0;
+    m_buffer.assign(static_cast<size_t>(MAX_RENDER_FRAMES) * channels, 0.0f);
+    return true;
+}
+
+void NullAudioBackend::Stop()
+{
+    m_render = nullptr;
+}
+
+void NullAudioBackend::Update(float dt)
+{
+    if (!m_render || dt <= 0.0f) { return; }
+
+    //[͎̃t[Ɏz
+    m_pendingFrames += static_cast<double>(dt) * m_sampleRate;
+    int frames = static_cast<int>(m_pendingFrames);
+    m_pendingFrames -= frames;
+
+    while (frames > 0)
+    {
+        const int count = std::min(frames, MAX_RENDER_FRAMES);
+        m_render(m_buffer.data(), count);
+        OnRendered(m_buffer.data(), count);
+
+        m_renderedFrames += count;
+        frames -= count;
+    }
+}
+
+//-----------------------WavWriterAudioBackend-----------------------
+
+WavWriterAudioBackend::~WavWriterAudioBackend()
+{
+    Stop();
+}
+
+bool WavWriterAudioBackend::Start(int sampleRate, int channels, RenderFunc render)
+{
+    //JȂ false(Ă񂾑 GetPath o)
+    m_file = fopen(m_filepath.c_str(), "wb");
+    if (!m_file)
+    {
+        return false;
+    }
+
+    NullAudioBackend::Start(sampleRate, channels, std::move(render));
+
+    //TCY͕鎞ɏ
+    m_dataBytes = 0;
+    WriteHeader(0);
+    return true;
+}
+
+void WavWriterAudioBackend::Stop()
+{
+    NullAudioBackend::Stop();
+
+    if (!m_file) { return; }
+
+    fseek(m_file, 0, SEEK_SET);
+    WriteHeader(m_dataBytes);
+    fclose(m_file);
+    m_file = nullptr;
+}
+
+void WavWriterAudioBackend::OnRendered(const float* samples, int frames)
+{
+    if (!m_file) { return; }
+
+    const int count = frames * m_channels;
+    m_pcm.resize(count);
+    AudioMixKernels::ToInt16(AudioMixKernels::GetBestKernel(), samples, m_pcm.data(), count);
+
+    fwrite(m_pcm.data(), sizeof(int16_t), count, m_file);
+    m_dataBytes += static_cast<uint32_t>(count * sizeof(int16_t));
+}
+
+void WavWriterAudioBackend::WriteHeader(uint32_t dataBytes)
+{
+    const uint16_t channels = static_cast<uint16_t>(m_channels);
+    const uint32_t sampleRate = static_cast<uint32_t>(m_sampleRate);
+    const uint16_t bits = 16;
+    const uint16_t blockAlign = channels * bits / 8;
+    const uint32_t byteRate = sampleRate * blockAlign;
+    const uint32_t riffSize = 36 + dataBytes;
+    const uint32_t fmtSize = 16;
+    const uint16_t formatTag = 1;   //PCM
+
+    fwrite("RIFF", 1, 4, m_file);
+    fwrite(&riffSize, 4, 1, m_file);
+    fwrite("WAVE", 1, 4, m_file);
+    fwrite("fmt ", 1, 4, m_file);
+    fwrite(&fmtSize, 4, 1, m_file);
+    fwrite(&formatTag, 2, 1, m_file);
+    fwrite(&channels, 2, 1, m_file);
+    fwrite(&sampleRate, 4, 1, m_file);
+    fwrite(&byteRate, 4, 1, m_file);
+    fwrite(&blockAlign, 2, 1, m_file);
+    fwrite(&bits, 2, 1, m_file);
+    fwrite("data", 1, 4, m_file);
+    fwrite(&dataBytes, 4, 1, m_file);
+}
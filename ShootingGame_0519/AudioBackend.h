@@ -0,0 +1,82 @@
+#pragma once
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+
+//---------------------------------------------------------
+// ~bNXς݂̉(float ̃XeI)̏o͐
+// @ł XAudio2AudioBackendBwbhXsł
+// NullAudioBackend(̂Ă) / WavWriterAudioBackend(WAV ɏ) ɍւ
+//---------------------------------------------------------
+class AudioBackend
+{
+public:
+    //out  frames t[̉֐(AudioMixer::Render)
+    using RenderFunc = std::function<void(float* out, int frames)>;
+
+    virtual ~AudioBackend() = default;
+
+    //--------Get֐-------
+    virtual const char* GetName() const = 0;
+
+    //render ĂтȂo͂n߂(foCX͎̂̃XbhĂ)
+    virtual bool Start(int sampleRate, int channels, RenderFunc render) = 0;
+    virtual void Stop() = 0;
+
+    //Q[̃t[ɌĂ(foCXȂ̂͌oߎԕ render )
+    virtual void Update(float dt) {}
+};
+
+//foCXBԕ~bNXĎ̂Ă({CX̍ĐEI͎@Ɠɐi)
+class NullAudioBackend : public AudioBackend
+{
+public:
+    const char* GetName() const override { return "Null"; }
+
+    bool Start(int sampleRate, int channels, RenderFunc render) override;
+    void Stop() override;
+    void Update(float dt) override;
+
+    //--------Get֐-------
+    long long GetRenderedFrames() const { return m_renderedFrames; }
+
+protected:
+    //~bNXubNɌĂ΂
+    virtual void OnRendered(const float* samples, int frames) {}
+
+    RenderFunc m_render;
+    int m_sampleRate = 0;
+    int m_channels = 0;
+    double m_pendingFrames = 0.0;
+    long long m_renderedFrames = 0;
+    std::vector<float> m_buffer;
+};
+
+//~bNXʂ 16bit  WAV t@Cɏo(wbhXsłׁ̒Ep)
+class WavWriterAudioBackend : public NullAudioBackend
+{
+public:
+    explicit WavWriterAudioBackend(const std::string& filepath) : m_filepath(filepath) {}
+    ~WavWriterAudioBackend() override;
+
+    const char* GetName() const override { return "WavWriter"; }
+
+    bool Start(int sampleRate, int channels, RenderFunc render) override;
+    void Stop() override;
+
+    //--------Get֐-------
+    const std::string& GetPath() const { return m_filepath; }
+
+protected:
+    void OnRendered(const float* samples, int frames) override;
+
+private:
+    void WriteHeader(uint32_t dataBytes);
+
+    std::string m_filepath;
+    FILE* m_file = nullptr;
+    uint32_t m_dataBytes = 0;
+    std::vector<int16_t> m_pcm;
+};
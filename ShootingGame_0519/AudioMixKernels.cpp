@@ -0,0 +1,337 @@
+#include <cstring>
+#include <algorithm>
+#include "AudioMixKernels.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define AUDIO_MIX_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+//AVX ̊֐ AVX ŃRpC(MSVC ͎w肵ȂĂgݍ݊֐̂܂܏o)
+#if defined(AUDIO_MIX_X86) && defined(__GNUC__)
+#define AUDIO_MIX_TARGET_AVX __attribute__((target("avx")))
+#else
+#define AUDIO_MIX_TARGET_AVX
+#endif
+
+namespace
+{
+    constexpr float INT16_TO_FLOAT = 1.0f / 32768.0f;
+    constexpr float FLOAT_TO_INT16 = 32767.0f;
+    constexpr float FRACTION_SCALE = 1.0f / 4294967296.0f;
+
+    //-----------------------XJ[-----------------------
+
+    //\[X1t[(XeIɍL)
+    inline void ReadFrame(const int16_t* samples, int channels, uint32_t frame, float& left, float& right)
+    {
+        if (channels == 1)
+        {
+            left = right = samples[frame];
+        }
+        else
+        {
+            left = samples[frame * 2];
+            right = samples[frame * 2 + 1];
+        }
+    }
+
+    //frame ̎̃t[(IȂ烋[v擪At[JԂ)
+    inline uint32_t NextFrame(uint32_t frame, uint32_t sampleFrames, bool loop)
+    {
+        if (frame + 1 < sampleFrames) { return frame + 1; }
+        return loop ? 0 : frame;
+    }
+
+    //count t[AԂȂ珑(͈͂̊mF͌Ăяo)
+    void ResampleScalar(const int16_t* samples, uint32_t sampleFrames, int channels,
+                        uint64_t position, uint64_t step, bool loop, float* out, int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            const uint32_t frame = static_cast<uint32_t>(position >> 32);
+            const float t = static_cast<float>(static_cast<uint32_t>(position)) * FRACTION_SCALE;
+
+            float l0, r0, l1, r1;
+            ReadFrame(samples, channels, frame, l0, r0);
+            ReadFrame(samples, channels, NextFrame(frame, sampleFrames, loop), l1, r1);
+
+            out[i * 2] = (l0 + (l1 - l0) * t) * INT16_TO_FLOAT;
+            out[i * 2 + 1] = (r0 + (r1 - r0) * t) * INT16_TO_FLOAT;
+
+            position += step;
+        }
+    }
+
+    void MixRampScalar(float* bus, const float* src, int begin, int frames, float gain, float gainStep)
+    {
+        for (int i = begin; i < frames; ++i)
+        {
+            const float g = gain + gainStep * static_cast<float>(i);
+            bus[i * 2] += src[i * 2] * g;
+            bus[i * 2 + 1] += src[i * 2 + 1] * g;
+        }
+    }
+
+    void ToInt16Scalar(const float* src, int16_t* dst, int begin, int samples)
+    {
+        for (int i = begin; i < samples; ++i)
+        {
+            const float v = std::clamp(src[i], -1.0f, 1.0f) * FLOAT_TO_INT16;
+            dst[i] = static_cast<int16_t>(v < 0.0f ? v - 0.5f : v + 0.5f);
+        }
+    }
+
+#if defined(AUDIO_MIX_X86)
+    //-----------------------SSE-----------------------
+
+    //16bit 4( 64bit) float 4
+    inline __m128 Int16x4ToFloat(__m128i v)
+    {
+        return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+    }
+
+    inline __m128i LoadStereoFrame(const int16_t* samples, uint32_t frame)
+    {
+        int32_t pair;
+        memcpy(&pair, samples + frame * 2, sizeof(pair));
+        return _mm_cvtsi32_si128(pair);
+    }
+
+    //XeĨ\[X2t[Ԃ(frame + 1 ͈͓̏)
+    //߂l : t[(c̓XJ[)
+    int ResampleStereoSse(const int16_t* samples, uint64_t position, uint64_t step, float* out, int count)
+    {
+        const __m128 scale = _mm_set1_ps(INT16_TO_FLOAT);
+
+        //sb`̂܂܂Œ[Εϊ
+        if (step == AudioMixKernels::POSITION_ONE && static_cast<uint32_t>(position) == 0)
+        {
+            const int16_t* src = samples + (position >> 32) * 2;
+            int i = 0;
+            for (; i + 2 <= count; i += 2)
+            {
+                __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i * 2));
+                _mm_storeu_ps(out + i * 2, _mm_mul_ps(Int16x4ToFloat(v), scale));
+            }
+            return i;
+        }
+
+        int i = 0;
+        for (; i + 2 <= count; i += 2)
+        {
+            const uint64_t p0 = position;
+            const uint64_t p1 = position + step;
+            const uint32_t f0 = static_cast<uint32_t>(p0 >> 32);
+            const uint32_t f1 = static_cast<uint32_t>(p1 >> 32);
+
+            //L0 R0 L1 R1
+            __m128i a = _mm_unpacklo_epi32(LoadStereoFrame(samples, f0), LoadStereoFrame(samples, f1));
+            __m128i b = _mm_unpacklo_epi32(LoadStereoFrame(samples, f0 + 1), LoadStereoFrame(samples, f1 + 1));
+
+            const float t0 = static_cast<float>(static_cast<uint32_t>(p0)) * FRACTION_SCALE;
+            const float t1 = static_cast<float>(static_cast<uint32_t>(p1)) * FRACTION_SCALE;
+            const __m128 t = _mm_set_ps(t1, t1, t0, t0);
+
+            const __m128 fa = Int16x4ToFloat(a);
+            const __m128 fb = Int16x4ToFloat(b);
+            const __m128 v = _mm_add_ps(fa, _mm_mul_ps(_mm_sub_ps(fb, fa), t));
+            _mm_storeu_ps(out + i * 2, _mm_mul_ps(v, scale));
+
+            position += step * 2;
+        }
+        return i;
+    }
+
+    int MixRampSse(float* bus, const float* src, int frames, float gain, float gainStep)
+    {
+        //12t[(L R L R)
+        const __m128 offset = _mm_set_ps(gainStep, gainStep, 0.0f, 0.0f);
+        int i = 0;
+        for (; i + 2 <= frames; i += 2)
+        {
+            const __m128 g = _mm_add_ps(_mm_set1_ps(gain + gainStep * static_cast<float>(i)), offset);
+            const __m128 b = _mm_loadu_ps(bus + i * 2);
+            const __m128 s = _mm_loadu_ps(src + i * 2);
+            _mm_storeu_ps(bus + i * 2, _mm_add_ps(b, _mm_mul_ps(s, g)));
+        }
+        return i;
+    }
+
+    int ToInt16Sse(const float* src, int16_t* dst, int samples)
+    {
+        const __m128 scale = _mm_set1_ps(FLOAT_TO_INT16);
+        const __m128 lo = _mm_set1_ps(-1.0f);
+        const __m128 hi = _mm_set1_ps(1.0f);
+
+        int i = 0;
+        for (; i + 8 <= samples; i += 8)
+        {
+            __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i), lo), hi);
+            __m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i + 4), lo), hi);
+            __m128i ia = _mm_cvtps_epi32(_mm_mul_ps(a, scale));
+            __m128i ib = _mm_cvtps_epi32(_mm_mul_ps(b, scale));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(ia, ib));
+        }
+        return i;
+    }
+
+    //-----------------------AVX-----------------------
+
+    AUDIO_MIX_TARGET_AVX int MixRampAvx(float* bus, const float* src, int frames, float gain, float gainStep)
+    {
+        //14t[
+        const __m256 offset = _mm256_set_ps(gainStep * 3.0f, gainStep * 3.0f, gainStep * 2.0f, gainStep * 2.0f,
+                                            gainStep, gainStep, 0.0f, 0.0f);
+        int i = 0;
+        for (; i + 4 <= frames; i += 4)
+        {
+            const __m256 g = _mm256_add_ps(_mm256_set1_ps(gain + gainStep * static_cast<float>(i)), offset);
+            const __m256 b = _mm256_loadu_ps(bus + i * 2);
+            const __m256 s = _mm256_loadu_ps(src + i * 2);
+            _mm256_storeu_ps(bus + i * 2, _mm256_add_ps(b, _mm256_mul_ps(s, g)));
+        }
+        _mm256_zeroupper();
+        return i;
+    }
+
+    bool HasAvx()
+    {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx) { return false; }
+
+        //OS  YMM WX^ۑĂ邩
+        return (_xgetbv(0) & 0x6) == 0x6;
+#else
+        return __builtin_cpu_supports("avx");
+#endif
+    }
+#endif
+}
+
+namespace AudioMixKernels
+{
+    MIX_KERNEL GetBestKernel()
+    {
+        if (IsSupported(MIX_KERNEL_AVX)) { return MIX_KERNEL_AVX; }
+        if (IsSupported(MIX_KERNEL_SSE)) { return MIX_KERNEL_SSE; }
+        return MIX_KERNEL_SCALAR;
+    }
+
+    bool IsSupported(MIX_KERNEL kernel)
+    {
+        switch (kernel)
+        {
+        case MIX_KERNEL_SCALAR:
+            return true;
+#if defined(AUDIO_MIX_X86)
+        case MIX_KERNEL_SSE:
+            return true;    //x64 ȂK
+        case MIX_KERNEL_AVX:
+        {
+            static const bool s_hasAvx = HasAvx();
+            return s_hasAvx;
+        }
+#endif
+        default:
+            return false;
+        }
+    }
+
+    const char* GetName(MIX_KERNEL kernel)
+    {
+        switch (kernel)
+        {
+        case MIX_KERNEL_SCALAR: return "scalar";
+        case MIX_KERNEL_SSE:    return "SSE";
+        case MIX_KERNEL_AVX:    return "AVX";
+        default:                return "?";
+        }
+    }
+
+    int Resample(MIX_KERNEL kernel, const int16_t* samples, uint32_t sampleFrames, int channels,
+                 uint64_t& position, uint64_t step, bool loop, float* out, int frames)
+    {
+        if (!samples || sampleFrames == 0 || step == 0) { return 0; }
+
+        const uint64_t end = static_cast<uint64_t>(sampleFrames) << 32;
+        int written = 0;
+
+        while (written < frames)
+        {
+            if (position >= end)
+            {
+                if (!loop) { break; }
+                position %= end;
+            }
+
+            //̃t[͈͓Ɏ܂鏊͂܂Ƃ߂ď
+            const uint64_t safeEnd = end - POSITION_ONE;
+            int count = 0;
+            if (position < safeEnd)
+            {
+                const uint64_t n = (safeEnd - position + step - 1) / step;
+                count = static_cast<int>(std::min<uint64_t>(n, static_cast<uint64_t>(frames - written)));
+            }
+
+            if (count > 0)
+            {
+                int done = 0;
+#if defined(AUDIO_MIX_X86)
+                if (kernel != MIX_KERNEL_SCALAR && channels == 2)
+                {
+                    done = ResampleStereoSse(samples, position, step, out + written * 2, count);
+                }
+#endif
+                ResampleScalar(samples, sampleFrames, channels, position + step * done, step, loop,
+                               out + (written + done) * 2, count - done);
+
+                position += step * count;
+                written += count;
+                continue;
+            }
+
+            //Ō̃t[(̓[v擪At[)
+            ResampleScalar(samples, sampleFrames, channels, position, step, loop, out + written * 2, 1);
+            position += step;
+            written++;
+        }
+
+        return written;
+    }
+
+    void MixRamp(MIX_KERNEL kernel, float* bus, const float* src, int frames, float gain, float gainStep)
+    {
+        int done = 0;
+#if defined(AUDIO_MIX_X86)
+        if (kernel == MIX_KERNEL_AVX)
+        {
+            done = MixRampAvx(bus, src, frames, gain, gainStep);
+        }
+        else if (kernel == MIX_KERNEL_SSE)
+        {
+            done = MixRampSse(bus, src, frames, gain, gainStep);
+        }
+#endif
+        MixRampScalar(bus, src, done, frames, gain, gainStep);
+    }
+
+    void ToInt16(MIX_KERNEL kernel, const float* src, int16_t* dst, int samples)
+    {
+        int done = 0;
+#if defined(AUDIO_MIX_X86)
+        if (kernel != MIX_KERNEL_SCALAR)
+        {
+            done = ToInt16Sse(src, dst, samples);
+        }
+#endif
+        ToInt16Scalar(src, dst, done, samples);
+    }
+}
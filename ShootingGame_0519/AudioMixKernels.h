@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+
+//---------------------------------------------------------
+// \tgEFA~LT[̓̃[v
+// oX float ̃XeI(L R L R ...)BSSE / AVX ΂g
+// (AVX  256bit ̐߂̂ŁAϊ SSE Ɠ)
+//---------------------------------------------------------
+namespace AudioMixKernels
+{
+    enum MIX_KERNEL
+    {
+        MIX_KERNEL_SCALAR = 0,
+        MIX_KERNEL_SSE,
+        MIX_KERNEL_AVX,
+        MAX_MIX_KERNEL
+    };
+
+    //Đʒu 32.32 ̌Œ菬( 32bit \[X̃t[ԍ)
+    constexpr uint64_t POSITION_ONE = 1ull << 32;
+
+    // CPU Ŏgԑ
+    MIX_KERNEL GetBestKernel();
+    bool IsSupported(MIX_KERNEL kernel);
+    const char* GetName(MIX_KERNEL kernel);
+
+    //16bit PCM(m / XeI)`Ԃœǂݐi߂āAXeI float ɕϊ
+    //position : ǂݎn߂ʒu(ǂ񂾕i߂)
+    //step : o1t[Őiޗ(\[X̃[g / o͂̃[g)
+    //loop : I܂ŗ擪ɖ߂
+    //߂l : t[([vȂ͏I܂ŗ frames 菭Ȃ)
+    int Resample(MIX_KERNEL kernel, const int16_t* samples, uint32_t sampleFrames, int channels,
+                 uint64_t& position, uint64_t step, bool loop, float* out, int frames);
+
+    //bus += src * gain (gain 1t[Ƃ gainStep ςBtF[hp)
+    void MixRamp(MIX_KERNEL kernel, float* bus, const float* src, int frames, float gain, float gainStep);
+
+    //float(-1`1)  16bit ɕϊ(͈͊O͖Oa)
+    void ToInt16(MIX_KERNEL kernel, const float* src, int16_t* dst, int samples);
+}
@@ -0,0 +1,408 @@
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include "AudioMixer.h"
+
+using namespace AudioMixKernels;
+
+namespace
+{
+    constexpr uint32_t GENERATION_MASK = 0xFFFFFF;
+
+    AudioMixer::VoiceHandle MakeHandle(int index, uint32_t generation)
+    {
+        return (generation << 8) | static_cast<uint32_t>(index + 1);
+    }
+}
+
+AudioMixer::AudioMixer()
+    : m_scratch(BLOCK_FRAMES * OUTPUT_CHANNELS)
+    , m_kernel(GetBestKernel())
+{
+    m_busGain.fill(1.0f);
+    m_appliedBusGain.fill(1.0f);
+    m_stats.kernel = m_kernel;
+}
+
+void AudioMixer::SetKernel(MIX_KERNEL kernel)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_kernel = IsSupported(kernel) ? kernel : GetBestKernel();
+    m_stats.kernel = m_kernel;
+}
+
+AudioMixer::VoiceHandle AudioMixer::Play(const AudioClip& clip, float gain, bool loop, AUDIO_BUS bus)
+{
+    if (!clip.samples || clip.frames == 0 || clip.sampleRate <= 0 ||
+        (clip.channels != 1 && clip.channels != 2))
+    {
+        return INVALID_VOICE;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    VoiceHandle handle = INVALID_VOICE;
+    Voice* voice = AllocateVoice(handle);
+    if (!voice) { return INVALID_VOICE; }
+
+    voice->clip = clip;
+    voice->step = static_cast<uint64_t>(static_cast<double>(clip.sampleRate) / OUTPUT_RATE * POSITION_ONE);
+    voice->gain = std::max(gain, 0.0f);
+    voice->targetGain = voice->gain;
+    voice->loop = loop;
+    voice->bus = bus;
+    voice->active = true;
+
+    return handle;
+}
+
+AudioMixer::VoiceHandle AudioMixer::PlayStream(AudioStream* stream, float gain, AUDIO_BUS bus)
+{
+    if (!stream || stream->GetSampleRate() <= 0 ||
+        (stream->GetChannels() != 1 && stream->GetChannels() != 2))
+    {
+        return INVALID_VOICE;
+    }
+
+    const uint64_t step = static_cast<uint64_t>(static_cast<double>(stream->GetSampleRate()) / OUTPUT_RATE * POSITION_ONE);
+
+    //1ubNŐiރt[ + ԗp1t[ + [
+    const uint32_t capacity = static_cast<uint32_t>((step * BLOCK_FRAMES) >> 32) + 4;
+    std::vector<int16_t> staging(static_cast<size_t>(capacity) * stream->GetChannels());
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    VoiceHandle handle = INVALID_VOICE;
+    Voice* voice = AllocateVoice(handle);
+    if (!voice) { return INVALID_VOICE; }
+
+    voice->stream = stream;
+    voice->staging = std::move(staging);
+    voice->stagingCapacity = capacity;
+    voice->clip.samples = voice->staging.data();
+    voice->clip.frames = 0;
+    voice->clip.channels = stream->GetChannels();
+    voice->clip.sampleRate = stream->GetSampleRate();
+    voice->step = step;
+    voice->gain = std::max(gain, 0.0f);
+    voice->targetGain = voice->gain;
+    voice->bus = bus;
+    voice->active = true;
+
+    return handle;
+}
+
+AudioMixer::Voice* AudioMixer::AllocateVoice(VoiceHandle& outHandle)
+{
+    for (int i = 0; i < MAX_VOICES; ++i)
+    {
+        Voice& voice = m_voices[i];
+        if (voice.active) { continue; }
+
+        const uint32_t generation = (voice.generation + 1) & GENERATION_MASK;
+
+        voice = Voice{};
+        voice.generation = generation == 0 ? 1 : generation;
+
+        outHandle = MakeHandle(i, voice.generation);
+        return &voice;
+    }
+
+    m_stats.droppedVoices++;
+    return nullptr;
+}
+
+void AudioMixer::Stop(VoiceHandle voice)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (Voice* v = FindVoice(voice))
+    {
+        v->active = false;
+    }
+}
+
+void AudioMixer::StopAll()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& voice : m_voices)
+    {
+        voice.active = false;
+    }
+}
+
+void AudioMixer::SetGain(VoiceHandle voice, float gain, float fadeSeconds)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Voice* v = FindVoice(voice);
+    if (!v) { return; }
+
+    gain = std::max(gain, 0.0f);
+    const int frames = static_cast<int>(std::max(fadeSeconds, 0.0f) * OUTPUT_RATE + 0.5f);
+
+    v->targetGain = gain;
+    v->stopAtFadeEnd = false;
+    if (frames <= 0)
+    {
+        v->gain = gain;
+        v->gainPerFrame = 0.0f;
+        v->fadeFrames = 0;
+    }
+    else
+    {
+        v->gainPerFrame = (gain - v->gain) / static_cast<float>(frames);
+        v->fadeFrames = frames;
+    }
+}
+
+void AudioMixer::FadeOut(VoiceHandle voice, float fadeSeconds)
+{
+    if (fadeSeconds <= 0.0f)
+    {
+        Stop(voice);
+        return;
+    }
+
+    SetGain(voice, 0.0f, fadeSeconds);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (Voice* v = FindVoice(voice))
+    {
+        v->stopAtFadeEnd = true;
+    }
+}
+
+void AudioMixer::SetBusGain(AUDIO_BUS bus, float gain)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_busGain[bus] = std::clamp(gain, 0.0f, 1.0f);
+}
+
+void AudioMixer::Render(float* out, int frames)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    memset(out, 0, sizeof(float) * OUTPUT_CHANNELS * frames);
+
+    for (int offset = 0; offset < frames; offset += BLOCK_FRAMES)
+    {
+        const int count = std::min(BLOCK_FRAMES, frames - offset);
+
+        //oX̉ʂ̓ubN̓I܂łŕς
+        float busStart[MAX_AUDIO_BUS];
+        float busEnd[MAX_AUDIO_BUS];
+        for (int b = 0; b < MAX_AUDIO_BUS; ++b)
+        {
+            busStart[b] = m_appliedBusGain[b];
+            busEnd[b] = m_busGain[b];
+            m_appliedBusGain[b] = m_busGain[b];
+        }
+
+        int active = 0;
+        for (auto& voice : m_voices)
+        {
+            if (!voice.active) { continue; }
+
+            active++;
+            MixVoice(voice, out + offset * OUTPUT_CHANNELS, count, busStart, busEnd);
+        }
+
+        m_stats.activeVoices = active;
+        m_stats.peakVoices = std::max(m_stats.peakVoices, active);
+    }
+
+    m_stats.renderedFrames += frames;
+    m_stats.mixSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void AudioMixer::FillStaging(Voice& voice, int frames)
+{
+    const int channels = voice.clip.channels;
+    int16_t* staging = voice.staging.data();
+
+    //ǂݏIt[̂ĂđOɋl߂
+    const uint32_t consumed = std::min(static_cast<uint32_t>(voice.position >> 32), voice.clip.frames);
+    if (consumed > 0)
+    {
+        const uint32_t remain = voice.clip.frames - consumed;
+        memmove(staging, staging + consumed * channels, sizeof(int16_t) * remain * channels);
+        voice.clip.frames = remain;
+        voice.position -= static_cast<uint64_t>(consumed) << 32;
+    }
+
+    //̃ubN̍Ō̃t[̎(ԗp)܂
+    const uint32_t needed = std::min(static_cast<uint32_t>((voice.position + voice.step * frames) >> 32) + 2,
+                                     voice.stagingCapacity);
+    if (voice.clip.frames < needed)
+    {
+        voice.clip.frames += static_cast<uint32_t>(voice.stream->Read(staging + voice.clip.frames * channels,
+                                                                      static_cast<int>(needed - voice.clip.frames)));
+    }
+}
+
+void AudioMixer::MixVoice(Voice& voice, float* out, int frames, const float* busStart, const float* busEnd)
+{
+    if (voice.stream)
+    {
+        FillStaging(voice, frames);
+    }
+
+    const AudioClip& clip = voice.clip;
+    const int written = Resample(m_kernel, clip.samples, clip.frames, clip.channels,
+                                 voice.position, voice.step, voice.loop, m_scratch.data(), frames);
+
+    //tF[hubN̓rŏI鎞́A܂łXtAc̉ʂő
+    const float busFrom = busStart[voice.bus];
+    const float busStep = (busEnd[voice.bus] - busFrom) / static_cast<float>(frames);
+
+    const float gainFrom = voice.gain;
+    const int fadeCount = std::min(voice.fadeFrames, written);
+    float gainTo = gainFrom + voice.gainPerFrame * static_cast<float>(fadeCount);
+
+    voice.fadeFrames -= fadeCount;
+    const bool fadeEnded = (fadeCount > 0 && voice.fadeFrames == 0);
+    if (fadeEnded)
+    {
+        gainTo = voice.targetGain;
+    }
+    voice.gain = gainTo;
+
+    auto mixSegment = [&](int begin, int end, float voiceFrom, float voiceTo)
+    {
+        if (end <= begin) { return; }
+
+        const float from = voiceFrom * (busFrom + busStep * static_cast<float>(begin));
+        const float to = voiceTo * (busFrom + busStep * static_cast<float>(end));
+        MixRamp(m_kernel, out + begin * OUTPUT_CHANNELS, m_scratch.data() + begin * OUTPUT_CHANNELS,
+                end - begin, from, (to - from) / static_cast<float>(end - begin));
+    };
+
+    mixSegment(0, fadeCount, gainFrom, gainTo);
+    mixSegment(fadeCount, written, gainTo, gainTo);
+
+    //Xg[͏I܂ŗ~߂(ǂݍ݂xꂽȂ疳ő҂)
+    bool ended = written < frames;
+    if (ended && voice.stream && !voice.stream->IsFinished())
+    {
+        ended = false;
+        m_stats.streamUnderruns++;
+    }
+
+    if (ended || (fadeEnded && voice.stopAtFadeEnd))
+    {
+        voice.active = false;
+    }
+}
+
+bool AudioMixer::IsPlaying(VoiceHandle voice) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return FindVoice(voice) != nullptr;
+}
+
+float AudioMixer::GetGain(VoiceHandle voice) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const Voice* v = FindVoice(voice);
+    return v ? v->gain : 0.0f;
+}
+
+float AudioMixer::GetBusGain(AUDIO_BUS bus) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_busGain[bus];
+}
+
+AudioMixer::Stats AudioMixer::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+AudioMixer::Voice* AudioMixer::FindVoice(VoiceHandle voice)
+{
+    return const_cast<Voice*>(static_cast<const AudioMixer*>(this)->FindVoice(voice));
+}
+
+const AudioMixer::Voice* AudioMixer::FindVoice(VoiceHandle voice) const
+{
+    const int index = static_cast<int>(voice & 0xFF) - 1;
+    if (index < 0 || index >= MAX_VOICES) { return nullptr; }
+
+    const Voice& v = m_voices[index];
+    if (!v.active || v.generation != (voice >> 8)) { return nullptr; }
+    return &v;
+}
+
+void AudioMixer::RunMixBenchmark(std::vector<std::string>& outLines)
+{
+    const int voiceCounts[] = { 1, 8, 32, 64 };
+    const int iterations = 3;
+    const int audioSeconds = 2;
+    const int sourceRate = 44100;
+
+    //44.1kHz ̃XeI 1 b(o͂ 48kHz ֕ϊ)
+    std::vector<int16_t> samples(sourceRate * 2);
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> dist(-16000, 16000);
+    for (auto& s : samples)
+    {
+        s = static_cast<int16_t>(dist(rng));
+    }
+
+    AudioClip clip;
+    clip.samples = samples.data();
+    clip.frames = sourceRate;
+    clip.channels = 2;
+    clip.sampleRate = sourceRate;
+
+    std::vector<float> out(BLOCK_FRAMES * OUTPUT_CHANNELS);
+    const int blocks = audioSeconds * OUTPUT_RATE / BLOCK_FRAMES;
+
+    char buf[256];
+    snprintf(buf, sizeof(buf), "Audio mix benchmark (44.1kHz stereo -> %dHz, %d s of audio, best of %d)",
+        OUTPUT_RATE, audioSeconds, iterations);
+    outLines.push_back(buf);
+
+    for (int k = 0; k < MAX_MIX_KERNEL; ++k)
+    {
+        const MIX_KERNEL kernel = static_cast<MIX_KERNEL>(k);
+        if (!IsSupported(kernel)) { continue; }
+
+        for (int voices : voiceCounts)
+        {
+            double best = 1.0e9;
+            for (int it = 0; it < iterations; ++it)
+            {
+                AudioMixer mixer;
+                mixer.SetKernel(kernel);
+
+                //̓tF[h(Xt̑)ɂĂ
+                for (int v = 0; v < voices; ++v)
+                {
+                    VoiceHandle handle = mixer.Play(clip, 0.5f, true, AUDIO_BUS_SE);
+                    if (v % 2 == 0)
+                    {
+                        mixer.SetGain(handle, 0.1f, static_cast<float>(audioSeconds));
+                    }
+                }
+
+                for (int b = 0; b < blocks; ++b)
+                {
+                    mixer.Render(out.data(), BLOCK_FRAMES);
+                }
+
+                best = std::min(best, mixer.GetStats().mixSeconds);
+            }
+
+            const double msPerBlock = best * 1000.0 / blocks;
+            snprintf(buf, sizeof(buf), "  %-6s %2d voices : %.4f ms / 10ms block (%.2f us per voice, %.2f%% of realtime)",
+                GetName(kernel), voices, msPerBlock, msPerBlock * 1000.0 / voices,
+                100.0 * best / audioSeconds);
+            outLines.push_back(buf);
+        }
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include <array>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "AudioMixKernels.h"
+
+//---------------------------------------------------------
+// \tgEFA~LT[
+// 炵Ă鉹({CX)o͂̃[gɕϊȂ float ̃XeIoXɑ
+// ʂ̕ύXEtF[h̓{CXƂɂōsAo͐(AudioBackend)
+// oオoX󂯎邾(XAudio2 ł WAV t@CłʂɂȂ)
+// Render ͏o͐̃XbhĂ΂邱Ƃ̂ŁA͑S mutex Ŏ
+//---------------------------------------------------------
+
+//ʂ܂Ƃ߂ĕςO[v
+enum AUDIO_BUS
+{
+    AUDIO_BUS_BGM = 0,
+    AUDIO_BUS_SE,
+    MAX_AUDIO_BUS
+};
+
+//炷g`(16bit PCMBg͌ĂяoI܂ŎĂ)
+struct AudioClip
+{
+    const int16_t* samples = nullptr;
+    uint32_t frames = 0;
+    int channels = 0;       //1  2
+    int sampleRate = 0;
+};
+
+//͂g`(BGM ̃Xg[~OȂ)
+//Read ̓~LT[̃XbhĂ΂̂ŁA҂ɕԂ
+class AudioStream
+{
+public:
+    virtual ~AudioStream() = default;
+
+    //--------Get֐-------
+    virtual int GetChannels() const = 0;
+    virtual int GetSampleRate() const = 0;
+
+    //out(C^[u 16bit)ɍő frames t[AԂ
+    //܂͂ĂȂ͏ȂĂ 0 łǂ
+    virtual int Read(int16_t* out, int frames) = 0;
+
+    //([vȂ̏I܂œǂ)
+    virtual bool IsFinished() const = 0;
+};
+
+class AudioMixer
+{
+public:
+    static constexpr int OUTPUT_RATE = 48000;
+    static constexpr int OUTPUT_CHANNELS = 2;
+    static constexpr int BLOCK_FRAMES = 480;    //10ms
+    static constexpr int MAX_VOICES = 64;
+
+    // 8bit {CX̔ԍ + 1Aʂ(0 ͖)
+    using VoiceHandle = uint32_t;
+    static constexpr VoiceHandle INVALID_VOICE = 0;
+
+    struct Stats
+    {
+        AudioMixKernels::MIX_KERNEL kernel = AudioMixKernels::MIX_KERNEL_SCALAR;
+        int activeVoices = 0;
+        int peakVoices = 0;
+        int droppedVoices = 0;          //{CX肸ɖ点Ȃ
+        int streamUnderruns = 0;        //Xg[̓ǂݍ݂Ԃɍ킸ɂȂubN
+        long long renderedFrames = 0;
+        double mixSeconds = 0.0;        //Render ɂԂ̍v
+
+        //Ԃɑ΂~bNX̕(%)
+        double GetLoadPercent() const
+        {
+            const double audioSeconds = static_cast<double>(renderedFrames) / OUTPUT_RATE;
+            return audioSeconds > 0.0 ? 100.0 * mixSeconds / audioSeconds : 0.0;
+        }
+    };
+
+    AudioMixer();
+    AudioMixer(const AudioMixer&) = delete;
+    AudioMixer& operator=(const AudioMixer&) = delete;
+
+    //gȂ߃Zbgw肵͎g钆ňԑ̂ɂ
+    void SetKernel(AudioMixKernels::MIX_KERNEL kernel);
+
+    //gain : {CX̉(oX̉ʂƊ|킹)
+    //߂l : {CX̃nh(点Ȃ INVALID_VOICE)
+    VoiceHandle Play(const AudioClip& clip, float gain, bool loop, AUDIO_BUS bus);
+    //stream  Stop 邩I܂ŌĂяoĂ
+    VoiceHandle PlayStream(AudioStream* stream, float gain, AUDIO_BUS bus);
+    void Stop(VoiceHandle voice);
+    void StopAll();
+
+    //fadeSeconds  gain ܂Œŕς(0 Ȃ炷)
+    void SetGain(VoiceHandle voice, float gain, float fadeSeconds = 0.0f);
+    //0 ܂ŃtF[hĂ~߂
+    void FadeOut(VoiceHandle voice, float fadeSeconds);
+
+    void SetBusGain(AUDIO_BUS bus, float gain);
+
+    //o͐悩ĂԁBout ɃXeI frames t[
+    void Render(float* out, int frames);
+
+    //--------Get֐-------
+    bool IsPlaying(VoiceHandle voice) const;
+    float GetGain(VoiceHandle voice) const;
+    float GetBusGain(AUDIO_BUS bus) const;
+    Stats GetStats() const;
+
+    //{CXƁE߃ZbgƂ̃~bNX̎(DebugBenchmark ɓo^)
+    static void RunMixBenchmark(std::vector<std::string>& outLines);
+
+private:
+    struct Voice
+    {
+        AudioClip clip;
+        uint64_t position = 0;      //32.32 Œ菬
+        uint64_t step = 0;
+        float gain = 0.0f;
+        float targetGain = 0.0f;
+        float gainPerFrame = 0.0f;  //tF[h1t[̕ω
+        int fadeFrames = 0;         //tF[h̎ct[
+        bool stopAtFadeEnd = false;
+        bool loop = false;
+        bool active = false;
+        uint32_t generation = 0;
+        AUDIO_BUS bus = AUDIO_BUS_SE;
+
+        //Xg[̎ clip  staging w(ǂ񂾕͑Oɋl߂)
+        AudioStream* stream = nullptr;
+        std::vector<int16_t> staging;
+        uint32_t stagingCapacity = 0;
+    };
+
+    Voice* AllocateVoice(VoiceHandle& outHandle);
+    //Xg[玟̃ubNɗv镪 staging ɓǂݑ
+    void FillStaging(Voice& voice, int frames);
+    Voice* FindVoice(VoiceHandle voice);
+    const Voice* FindVoice(VoiceHandle voice) const;
+    void MixVoice(Voice& voice, float* out, int frames, const float* busStart, const float* busEnd);
+
+    mutable std::mutex m_mutex;
+    std::array<Voice, MAX_VOICES> m_voices;
+    std::array<float, MAX_AUDIO_BUS> m_busGain;
+    std::array<float, MAX_AUDIO_BUS> m_appliedBusGain;  //ÕubN̒l(}ɕςƃmCYɂȂ̂ŃubN̊ԂŕԂ)
+    std::vector<float> m_scratch;
+    AudioMixKernels::MIX_KERNEL m_kernel;
+    Stats m_stats;
+};
@@ -0,0 +1,567 @@
+#if defined(_MSC_VER) && !defined(_CRT_SECURE_NO_WARNINGS)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#endif
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include "BgmStream.h"
+#include "ImaAdpcm.h"
+
+namespace
+{
+    //1ɓǂރt[̖ڈƁAOɗ߂`N̐
+    //(44.1kHz  4096 t[ * 4 =  0.37 b)
+    constexpr int CHUNK_FRAMES = 4096;
+    constexpr int RING_CHUNKS = 4;
+
+    //ǂݍ݃XbhŐ󂫂҂Ԋu(Read N)
+    constexpr auto READER_WAIT = std::chrono::milliseconds(5);
+
+    //ADPCM ɕϊ鎞̃ubN̑傫(`l 1024 oCg = 2041 t[)
+    constexpr int ENCODE_FRAMES_PER_BLOCK = 2041;
+
+    void Print(const char* text)
+    {
+        printf("%s\n", text);
+#ifdef _WIN32
+        OutputDebugStringA(text);
+        OutputDebugStringA("\n");
+#endif
+    }
+
+    void Log(const char* text)
+    {
+#ifdef _WIN32
+        OutputDebugStringA(text);
+#else
+        fputs(text, stderr);
+#endif
+    }
+
+    //Q[ BGM ̓Ch̃pXŊJ
+    FILE* OpenRead(const std::filesystem::path& path)
+    {
+#ifdef _WIN32
+        return _wfopen(path.c_str(), L"rb");
+#else
+        return fopen(path.c_str(), "rb");
+#endif
+    }
+
+    uint32_t ReadU32(FILE* fp)
+    {
+        uint32_t v = 0;
+        fread(&v, sizeof(v), 1, fp);
+        return v;
+    }
+
+    uint16_t ReadU16(FILE* fp)
+    {
+        uint16_t v = 0;
+        fread(&v, sizeof(v), 1, fp);
+        return v;
+    }
+
+    //ϊ 16bit PCM ۂƓǂ(ItC̕ϊp)
+    bool LoadPcm16(const std::string& path, int& channels, int& sampleRate, std::vector<int16_t>& samples)
+    {
+        FILE* fp = fopen(path.c_str(), "rb");
+        if (!fp) { return false; }
+
+        char id[4]{};
+        fread(id, 1, 4, fp);
+        ReadU32(fp);
+        char wave[4]{};
+        fread(wave, 1, 4, fp);
+        if (memcmp(id, "RIFF", 4) != 0 || memcmp(wave, "WAVE", 4) != 0)
+        {
+            fclose(fp);
+            return false;
+        }
+
+        bool foundFmt = false;
+        bool foundData = false;
+        while (!foundData && fread(id, 1, 4, fp) == 4)
+        {
+            const uint32_t size = ReadU32(fp);
+            if (memcmp(id, "fmt ", 4) == 0)
+            {
+                const uint16_t format = ReadU16(fp);
+                channels = ReadU16(fp);
+                sampleRate = static_cast<int>(ReadU32(fp));
+                ReadU32(fp);
+                ReadU16(fp);
+                const uint16_t bits = ReadU16(fp);
+                fseek(fp, static_cast<long>(size - 16 + (size & 1)), SEEK_CUR);
+
+                if (format != 1 || bits != 16 || (channels != 1 && channels != 2)) { break; }
+                foundFmt = true;
+            }
+            else if (memcmp(id, "data", 4) == 0 && foundFmt)
+            {
+                samples.resize(size / sizeof(int16_t));
+                samples.resize(fread(samples.data(), sizeof(int16_t), samples.size(), fp));
+                foundData = true;
+            }
+            else
+            {
+                fseek(fp, static_cast<long>(size + (size & 1)), SEEK_CUR);
+            }
+        }
+
+        fclose(fp);
+        return foundFmt && foundData;
+    }
+
+    bool WriteAdpcmWav(const std::string& path, int channels, int sampleRate, int blockAlign,
+                       uint32_t totalFrames, const std::vector<uint8_t>& data)
+    {
+        FILE* fp = fopen(path.c_str(), "wb");
+        if (!fp) { return false; }
+
+        const uint16_t formatTag = ImaAdpcm::WAVE_FORMAT_IMA_ADPCM;
+        const uint16_t ch = static_cast<uint16_t>(channels);
+        const uint32_t rate = static_cast<uint32_t>(sampleRate);
+        const uint16_t align = static_cast<uint16_t>(blockAlign);
+        const uint16_t framesPerBlock = static_cast<uint16_t>(ImaAdpcm::GetFramesPerBlock(blockAlign, channels));
+        const uint32_t byteRate = static_cast<uint32_t>(static_cast<uint64_t>(rate) * align / framesPerBlock);
+        const uint16_t bits = 4;
+        const uint16_t extraSize = 2;
+        const uint32_t fmtSize = 20;
+        const uint32_t factSize = 4;
+        const uint32_t dataSize = static_cast<uint32_t>(data.size());
+        const uint32_t riffSize = 4 + (8 + fmtSize) + (8 + factSize) + (8 + dataSize);
+
+        fwrite("RIFF", 1, 4, fp);
+        fwrite(&riffSize, 4, 1, fp);
+        fwrite("WAVE", 1, 4, fp);
+        fwrite("fmt ", 1, 4, fp);
+        fwrite(&fmtSize, 4, 1, fp);
+        fwrite(&formatTag, 2, 1, fp);
+        fwrite(&ch, 2, 1, fp);
+        fwrite(&rate, 4, 1, fp);
+        fwrite(&byteRate, 4, 1, fp);
+        fwrite(&align, 2, 1, fp);
+        fwrite(&bits, 2, 1, fp);
+        fwrite(&extraSize, 2, 1, fp);
+        fwrite(&framesPerBlock, 2, 1, fp);
+        fwrite("fact", 1, 4, fp);
+        fwrite(&factSize, 4, 1, fp);
+        fwrite(&totalFrames, 4, 1, fp);
+        fwrite("data", 1, 4, fp);
+        fwrite(&dataSize, 4, 1, fp);
+        const bool ok = fwrite(data.data(), 1, data.size(), fp) == data.size();
+
+        fclose(fp);
+        return ok;
+    }
+}
+
+BgmStream::~BgmStream()
+{
+    Close();
+}
+
+bool BgmStream::Open(const std::wstring& filepath, bool loop)
+{
+    Close();
+
+    m_openTime = std::chrono::steady_clock::now();
+
+    m_file = OpenRead(std::filesystem::path(filepath));
+    if (!m_file)
+    {
+        return false;
+    }
+
+    if (!ReadHeader())
+    {
+        Log("BgmStream: unsupported wav (16bit PCM / IMA-ADPCM only)\n");
+        Close();
+        return false;
+    }
+
+    m_loop = loop;
+    m_dataRead = 0;
+    m_framesDecoded = 0;
+
+    //ADPCM ̓ubNPʂłǂ߂Ȃ̂ŁA`NubN̔{ɂ
+    if (m_compressed)
+    {
+        const int blocks = std::max(CHUNK_FRAMES / m_framesPerBlock, 1);
+        m_chunkFrames = blocks * m_framesPerBlock;
+        m_readBuffer.resize(static_cast<size_t>(blocks) * m_blockAlign);
+    }
+    else
+    {
+        m_chunkFrames = CHUNK_FRAMES;
+        m_readBuffer.clear();
+    }
+    m_decode.resize(static_cast<size_t>(m_chunkFrames) * m_channels);
+
+    m_ringFrames = static_cast<uint32_t>(m_chunkFrames * RING_CHUNKS);
+    m_ring.assign(static_cast<size_t>(m_ringFrames) * m_channels, 0);
+    m_writeFrame = 0;
+    m_readFrame = 0;
+    m_endOfData = false;
+    m_quit = false;
+    m_loops = 0;
+    m_firstAudioUs = -1;
+
+    m_thread = std::thread(&BgmStream::ReaderMain, this);
+    return true;
+}
+
+void BgmStream::Close()
+{
+    if (m_thread.joinable())
+    {
+        m_quit = true;
+        m_wakeCv.notify_one();
+        m_thread.join();
+    }
+
+    if (m_file)
+    {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+
+    m_ring.clear();
+    m_ring.shrink_to_fit();
+    m_readBuffer.clear();
+    m_readBuffer.shrink_to_fit();
+    m_decode.clear();
+    m_decode.shrink_to_fit();
+}
+
+bool BgmStream::ReadHeader()
+{
+    char id[4]{};
+    fread(id, 1, 4, m_file);
+    ReadU32(m_file);
+    char wave[4]{};
+    fread(wave, 1, 4, m_file);
+    if (memcmp(id, "RIFF", 4) != 0 || memcmp(wave, "WAVE", 4) != 0)
+    {
+        return false;
+    }
+
+    uint16_t formatTag = 0;
+    uint16_t bits = 0;
+    m_totalFrames = 0;
+
+    while (fread(id, 1, 4, m_file) == 4)
+    {
+        const uint32_t size = ReadU32(m_file);
+
+        if (memcmp(id, "fmt ", 4) == 0)
+        {
+            formatTag = ReadU16(m_file);
+            m_channels = ReadU16(m_file);
+            m_sampleRate = static_cast<int>(ReadU32(m_file));
+            ReadU32(m_file);
+            m_blockAlign = ReadU16(m_file);
+            bits = ReadU16(m_file);
+            fseek(m_file, static_cast<long>(size - 16 + (size & 1)), SEEK_CUR);
+        }
+        else if (memcmp(id, "fact", 4) == 0)
+        {
+            m_totalFrames = ReadU32(m_file);
+            fseek(m_file, static_cast<long>(size - 4 + (size & 1)), SEEK_CUR);
+        }
+        else if (memcmp(id, "data", 4) == 0)
+        {
+            //data ̒g͓ǂݍ݃Xbhǂ
+            m_dataOffset = ftell(m_file);
+            m_dataBytes = size;
+            break;
+        }
+        else
+        {
+            fseek(m_file, static_cast<long>(size + (size & 1)), SEEK_CUR);
+        }
+    }
+
+    if (m_dataBytes == 0 || m_blockAlign <= 0 || (m_channels != 1 && m_channels != 2))
+    {
+        return false;
+    }
+
+    if (formatTag == 1 && bits == 16)
+    {
+        m_compressed = false;
+        m_framesPerBlock = 1;
+        m_totalFrames = m_dataBytes / m_blockAlign;
+    }
+    else if (formatTag == ImaAdpcm::WAVE_FORMAT_IMA_ADPCM && bits == 4)
+    {
+        m_compressed = true;
+        m_framesPerBlock = ImaAdpcm::GetFramesPerBlock(m_blockAlign, m_channels);
+        if (m_framesPerBlock <= 0) { return false; }
+        if (m_totalFrames == 0)
+        {
+            m_totalFrames = (m_dataBytes / m_blockAlign) * m_framesPerBlock;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    return m_dataBytes >= static_cast<uint32_t>(m_blockAlign);
+}
+
+void BgmStream::ReaderMain()
+{
+    while (!m_quit)
+    {
+        const uint64_t write = m_writeFrame.load(std::memory_order_relaxed);
+        const uint64_t read = m_readFrame.load(std::memory_order_acquire);
+
+        //1`N̋󂫂o܂ő҂
+        if (m_ringFrames - (write - read) < static_cast<uint64_t>(m_chunkFrames))
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wakeCv.wait_for(lock, READER_WAIT);
+            continue;
+        }
+
+        const int frames = DecodeChunk();
+        if (frames <= 0)
+        {
+            m_endOfData = true;
+            break;
+        }
+
+        //ȌIׂ2ɕď
+        const uint32_t start = static_cast<uint32_t>(write % m_ringFrames);
+        const uint32_t first = std::min(static_cast<uint32_t>(frames), m_ringFrames - start);
+        memcpy(m_ring.data() + static_cast<size_t>(start) * m_channels, m_decode.data(),
+               sizeof(int16_t) * first * m_channels);
+        memcpy(m_ring.data(), m_decode.data() + static_cast<size_t>(first) * m_channels,
+               sizeof(int16_t) * (frames - first) * m_channels);
+
+        m_writeFrame.store(write + frames, std::memory_order_release);
+    }
+}
+
+int BgmStream::DecodeChunk()
+{
+    for (int attempt = 0; attempt < 2; ++attempt)
+    {
+        //I܂ŗ瓪ɖ߂(Oɑď̂Ōpڂ͏oȂ)
+        if (m_dataRead + m_blockAlign > m_dataBytes || m_framesDecoded >= m_totalFrames)
+        {
+            if (!m_loop) { return 0; }
+
+            fseek(m_file, m_dataOffset, SEEK_SET);
+            m_dataRead = 0;
+            m_framesDecoded = 0;
+            m_loops++;
+        }
+
+        int frames = 0;
+        if (m_compressed)
+        {
+            const uint32_t maxBlocks = static_cast<uint32_t>(m_readBuffer.size() / m_blockAlign);
+            const uint32_t blocks = std::min(maxBlocks, (m_dataBytes - m_dataRead) / m_blockAlign);
+            const size_t bytes = fread(m_readBuffer.data(), 1, static_cast<size_t>(blocks) * m_blockAlign, m_file);
+            const uint32_t blocksRead = static_cast<uint32_t>(bytes / m_blockAlign);
+
+            for (uint32_t b = 0; b < blocksRead; ++b)
+            {
+                ImaAdpcm::DecodeBlock(m_readBuffer.data() + static_cast<size_t>(b) * m_blockAlign, m_blockAlign, m_channels,
+                                      m_decode.data() + static_cast<size_t>(b) * m_framesPerBlock * m_channels);
+            }
+
+            frames = static_cast<int>(blocksRead) * m_framesPerBlock;
+            m_dataRead = (blocksRead == blocks) ? m_dataRead + blocks * m_blockAlign : m_dataBytes;
+        }
+        else
+        {
+            const uint32_t maxFrames = (m_dataBytes - m_dataRead) / m_blockAlign;
+            const uint32_t want = std::min(static_cast<uint32_t>(m_chunkFrames), maxFrames);
+            const size_t bytes = fread(m_decode.data(), 1, static_cast<size_t>(want) * m_blockAlign, m_file);
+
+            frames = static_cast<int>(bytes / m_blockAlign);
+            m_dataRead = (static_cast<uint32_t>(frames) == want) ? m_dataRead + want * m_blockAlign : m_dataBytes;
+        }
+
+        //ADPCM ̍Ō̃ubN̗]͎̂Ă
+        frames = std::min(frames, static_cast<int>(m_totalFrames - m_framesDecoded));
+        m_framesDecoded += frames;
+
+        if (frames > 0) { return frames; }
+    }
+
+    return 0;
+}
+
+int BgmStream::Read(int16_t* out, int frames)
+{
+    const uint64_t write = m_writeFrame.load(std::memory_order_acquire);
+    const uint64_t read = m_readFrame.load(std::memory_order_relaxed);
+
+    const int count = static_cast<int>(std::min<uint64_t>(static_cast<uint64_t>(frames), write - read));
+    if (count > 0)
+    {
+        const uint32_t start = static_cast<uint32_t>(read % m_ringFrames);
+        const uint32_t first = std::min(static_cast<uint32_t>(count), m_ringFrames - start);
+        memcpy(out, m_ring.data() + static_cast<size_t>(start) * m_channels, sizeof(int16_t) * first * m_channels);
+        memcpy(out + static_cast<size_t>(first) * m_channels, m_ring.data(),
+               sizeof(int16_t) * (count - first) * m_channels);
+
+        m_readFrame.store(read + count, std::memory_order_release);
+
+        if (m_firstAudioUs.load(std::memory_order_relaxed) < 0)
+        {
+            m_firstAudioUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - m_openTime).count();
+        }
+    }
+
+    //󂫂ł̂œǂݍ݃XbhN
+    m_wakeCv.notify_one();
+    return count;
+}
+
+bool BgmStream::IsFinished() const
+{
+    return m_endOfData.load(std::memory_order_acquire) &&
+           m_readFrame.load(std::memory_order_relaxed) == m_writeFrame.load(std::memory_order_acquire);
+}
+
+BgmStream::Stats BgmStream::GetStats() const
+{
+    Stats stats;
+    stats.compressed = m_compressed;
+    const long long firstUs = m_firstAudioUs.load();
+    stats.firstAudioMs = firstUs >= 0 ? firstUs / 1000.0 : -1.0;
+    stats.residentBytes = m_ring.size() * sizeof(int16_t) + m_readBuffer.size() + m_decode.size() * sizeof(int16_t);
+    stats.fileBytes = m_dataBytes;
+    stats.pcmBytes = static_cast<size_t>(m_totalFrames) * m_channels * sizeof(int16_t);
+    stats.loops = m_loops.load();
+    return stats;
+}
+
+std::wstring BgmStream::GetCompressedPath(const std::wstring& filepath)
+{
+    return filepath + L".adpcm";
+}
+
+bool BgmStream::HasFreshCompressed(const std::wstring& filepath)
+{
+    std::error_code ec;
+    const std::wstring compressedPath = GetCompressedPath(filepath);
+    if (!std::filesystem::exists(compressedPath, ec))
+    {
+        return false;
+    }
+
+    // WAV ւ̌Â͎̂gȂ
+    const auto compressedTime = std::filesystem::last_write_time(compressedPath, ec);
+    if (ec) { return false; }
+
+    const auto sourceTime = std::filesystem::last_write_time(filepath, ec);
+    if (ec) { return true; }    // WAV Έkłŗǂ
+
+    return compressedTime >= sourceTime;
+}
+
+int BgmStream::Encode(const std::vector<std::string>& paths)
+{
+    std::vector<std::string> files;
+    for (const auto& path : paths)
+    {
+        std::error_code ec;
+        if (std::filesystem::is_directory(path, ec))
+        {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(path, ec))
+            {
+                if (entry.is_regular_file() && entry.path().extension() == ".wav")
+                {
+                    files.push_back(entry.path().generic_string());
+                }
+            }
+        }
+        else
+        {
+            files.push_back(path);
+        }
+    }
+
+    int result = 0;
+    char buf[512];
+
+    for (const auto& path : files)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        int channels = 0;
+        int sampleRate = 0;
+        std::vector<int16_t> samples;
+        if (!LoadPcm16(path, channels, sampleRate, samples))
+        {
+            snprintf(buf, sizeof(buf), "ADPCM encode failed: %s (16bit PCM only)", path.c_str());
+            Print(buf);
+            result = 1;
+            continue;
+        }
+
+        const uint32_t totalFrames = static_cast<uint32_t>(samples.size() / channels);
+        const int blockAlign = ImaAdpcm::GetBlockAlign(ENCODE_FRAMES_PER_BLOCK, channels);
+        const int framesPerBlock = ImaAdpcm::GetFramesPerBlock(blockAlign, channels);
+        const uint32_t blocks = (totalFrames + framesPerBlock - 1) / framesPerBlock;
+
+        std::vector<uint8_t> data(static_cast<size_t>(blocks) * blockAlign);
+        std::vector<int16_t> decoded(static_cast<size_t>(framesPerBlock) * channels);
+        int stepIndex[2] = { 0, 0 };
+        double signal = 0.0;
+        double noise = 0.0;
+
+        for (uint32_t b = 0; b < blocks; ++b)
+        {
+            const uint32_t first = b * framesPerBlock;
+            const int frames = static_cast<int>(std::min<uint32_t>(framesPerBlock, totalFrames - first));
+            uint8_t* block = data.data() + static_cast<size_t>(b) * blockAlign;
+
+            ImaAdpcm::EncodeBlock(samples.data() + static_cast<size_t>(first) * channels, frames, channels,
+                                  block, blockAlign, stepIndex);
+
+            //߂Č덷𑪂
+            ImaAdpcm::DecodeBlock(block, blockAlign, channels, decoded.data());
+            for (int i = 0; i < frames * channels; ++i)
+            {
+                const double s = samples[static_cast<size_t>(first) * channels + i];
+                const double d = s - decoded[i];
+                signal += s * s;
+                noise += d * d;
+            }
+        }
+
+        const std::string outPath = path + ".adpcm";
+        if (!WriteAdpcmWav(outPath, channels, sampleRate, blockAlign, totalFrames, data))
+        {
+            snprintf(buf, sizeof(buf), "ADPCM encode failed: cannot write %s", outPath.c_str());
+            Print(buf);
+            result = 1;
+            continue;
+        }
+
+        const size_t pcmBytes = samples.size() * sizeof(int16_t);
+        const double snr = noise > 0.0 ? 10.0 * std::log10(signal / noise) : 99.0;
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        snprintf(buf, sizeof(buf), "  %s -> %s : %dHz %dch, %zu KB -> %zu KB (%.0f%%), SNR %.1f dB, %.0f ms",
+            path.c_str(), outPath.c_str(), sampleRate, channels, pcmBytes / 1024, data.size() / 1024,
+            pcmBytes > 0 ? 100.0 * data.size() / pcmBytes : 0.0, snr, ms);
+        Print(buf);
+    }
+
+    return result;
+}
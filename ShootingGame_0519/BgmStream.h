@@ -0,0 +1,100 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AudioMixer.h"
+
+//---------------------------------------------------------
+// BGM ̃Xg[~OĐ
+// ʃXbh WAV ǂ(16bit PCM / IMA-ADPCM 𕜍)
+// ȃOobt@ɗ߁A~LT[ Read ł邾
+// [v͓ǂݎ肪t@C̓ɖ߂ēOɏ̂Ōpڂ
+// (t@CŜ̓ɍڂȂBJɃwb_ǂ)
+//---------------------------------------------------------
+class BgmStream : public AudioStream
+{
+public:
+    struct Stats
+    {
+        bool compressed = false;        //IMA-ADPCM
+        double firstAudioMs = -1.0;     //Open ŏ̉~LT[ɓn܂(܂Ȃ畉)
+        size_t residentBytes = 0;       //O + ǂݍݗp̃obt@
+        size_t fileBytes = 0;           //data `N̑傫
+        size_t pcmBytes = 0;            //S 16bit ɓWJ̑傫
+        int loops = 0;
+    };
+
+    BgmStream() = default;
+    ~BgmStream() override;
+    BgmStream(const BgmStream&) = delete;
+    BgmStream& operator=(const BgmStream&) = delete;
+
+    //wb_ǂœǂݍ݃Xbh𗧂Ă(̂͑҂Ȃ)
+    bool Open(const std::wstring& filepath, bool loop);
+    void Close();
+
+    //--------AudioStream-------
+    int GetChannels() const override { return m_channels; }
+    int GetSampleRate() const override { return m_sampleRate; }
+    int Read(int16_t* out, int frames) override;
+    bool IsFinished() const override;
+
+    //--------Get֐-------
+    Stats GetStats() const;
+
+    //16bit PCM  WAV  IMA-ADPCM  WAV(<̃t@C>.adpcm)ɕϊ
+    //(main  --encode-adpcm ĂԁBfBNgnƒ .wav S)
+    static int Encode(const std::vector<std::string>& paths);
+
+    //ꂪΌ WAV ̑ɗ
+    static std::wstring GetCompressedPath(const std::wstring& filepath);
+    static bool HasFreshCompressed(const std::wstring& filepath);
+
+private:
+    bool ReadHeader();
+    void ReaderMain();
+    //̃`N𕜍 m_decode ɏ(IȂ烋[v̓ɖ߂)
+    //߂l : t[(0 Ȃ)
+    int DecodeChunk();
+
+    FILE* m_file = nullptr;
+    bool m_loop = false;
+
+    //--------`-------
+    int m_channels = 0;
+    int m_sampleRate = 0;
+    int m_blockAlign = 0;
+    int m_framesPerBlock = 0;       //ADPCM 1ubÑt[
+    bool m_compressed = false;
+    long m_dataOffset = 0;
+    uint32_t m_dataBytes = 0;
+    uint32_t m_totalFrames = 0;     //fact `N(ADPCM ̍Ō̃ubN̒[؂)
+
+    //--------ǂݍ݈ʒu(ǂݍ݃XbhG)-------
+    uint32_t m_dataRead = 0;
+    uint32_t m_framesDecoded = 0;
+    std::vector<uint8_t> m_readBuffer;
+    std::vector<int16_t> m_decode;
+    int m_chunkFrames = 0;
+
+    //--------O(ǂݍ݃XbhA~LT[ǂ)-------
+    std::vector<int16_t> m_ring;
+    uint32_t m_ringFrames = 0;
+    std::atomic<uint64_t> m_writeFrame{ 0 };
+    std::atomic<uint64_t> m_readFrame{ 0 };
+    std::atomic<bool> m_endOfData{ false };
+    std::atomic<bool> m_quit{ false };
+    std::atomic<int> m_loops{ 0 };
+
+    std::thread m_thread;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCv;
+
+    std::chrono::steady_clock::time_point m_openTime;
+    std::atomic<long long> m_firstAudioUs{ -1 };
+};
@@ -1,6 +1,7 @@
 #include "BillboardEffectComponent.h"
 #include "TextureManager.h"
 #include "GameObject.h"
+#include <d3d11.h>
 #include "Renderer.h"
 #include <algorithm>
 
@@ -111,7 +112,7 @@ void BillboardEffectComponent::Draw(float dt)
 
     DirectX::SimpleMath::Vector4 color(1, 1, 1, 1);
 
-    Renderer::DrawBillboard(m_textureSrv,
+    Renderer::DrawBillboard(m_textureSrv.Get(),
                             pos,
                             m_size,
                             color,
@@ -1,6 +1,7 @@
 #pragma once
 #include "Component.h"
 #include <d3d11.h>
+#include <wrl/client.h>
 #include <string>
 #include <SimpleMath.h>
 
@@ -65,6 +66,6 @@ private:
     DirectX::SimpleMath::Vector4 m_color = DirectX::SimpleMath::Vector4(1, 1, 1, 1);
 
  
-    ID3D11ShaderResourceView* m_textureSrv = nullptr;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_textureSrv;
 };
 
@@ -1,4 +1,5 @@
 #include "BoxComponent.h"
+#include <d3d11.h>
 #include "Renderer.h"
 #include "GameObject.h"
 #include <cassert>
@@ -13,7 +14,7 @@ void BoxComponent::Initialize()
     if (!s_sharedPrimitive)
     {
         ID3D11Device* device = Renderer::GetDevice();
-        assert(device && "Renderer::GetDevice() is null in BoxComponent::Initialize");
+        assert((device || Renderer::IsHeadless()) && "Renderer::GetDevice() is null in BoxComponent::Initialize");
 
         // allocate and create unit box (1x1x1)
         s_sharedPrimitive = std::make_shared<Primitive>();
@@ -1,3 +1,4 @@
+#define NOMINMAX
 #include "BuildingSpawner.h"
 #include "GameObject.h"
 #include "GameScene.h"
@@ -7,32 +8,109 @@
 #include "ModelCache.h"
 #include "PushOutComponent.h"
 #include "Building.h"
-#include <random>
 #include <cmath>
+#include <algorithm>
 
-BuildingSpawner::BuildingSpawner(IScene* scene) : m_scene(scene)
+BuildingSpawner::BuildingSpawner(IScene* scene)
+    : m_scene(scene),
+    m_rng(RandomService::CreateSystemStream(RandomService::RANDOM_SYSTEM_BUILDING))   //ZbVV[h猈܂
 {
-	std::random_device rd;
-	m_rng.seed(rd());   //_V[h̏
 }
 
-static float RandFloatStd(std::mt19937_64& rng, float a, float b)
+static float RandFloatStd(RandomStream& rng, float a, float b)
 {
-    std::uniform_real_distribution<float> d(a, b);
-    return d(rng);
+    return rng.Range(a, b);
 }
 
 int BuildingSpawner::RandomSpawn(const BuildingConfig& cfg)
 {
     if (!m_scene) { return 0; }
 
-	m_placed.clear();       //zuς݌̃NA
-
 	float halfAreaX = cfg.areaWidth * 0.5f;     //GA̔̕
 	float halfAreaZ = cfg.areaDepth * 0.5f;     //GA̔̉s   
+
+    //zuς݌̃NA(}X͈ԑ傫傫)
+    const float maxHalf = std::max(cfg.scaleX, cfg.scaleZ) * 0.5f * std::max(cfg.minScale, cfg.maxScale) + cfg.spacing * 0.5f;
+    m_grid.Reset(-halfAreaX, -halfAreaZ, halfAreaX, halfAreaZ, maxHalf * 2.0f);
     
 	int placedCount = 0;    //zu̐ۑp
 
+    //dȂȂ x,z ɒu
+    auto tryPlace = [&](float x, float z)
+    {
+        //XP[_Ɍ
+        float scale = (cfg.minScale == cfg.maxScale) ? cfg.minScale : RandFloatStd(m_rng, cfg.minScale, cfg.maxScale);
+
+        //Y]_Ɍ
+        //float yaw = cfg.randomizeRotation ? RandFloatStd(m_rng, 0.0f, 2.0f * 3.14159265358979323846f) : 0.0f;
+
+        //footprintiXZj̔vZiXP[j
+        float halfW = (cfg.scaleX * 0.5f) * scale + cfg.spacing * 0.5f;
+        float halfD = (cfg.scaleZ * 0.5f) * scale + cfg.spacing * 0.5f;
+
+        //ɔzûƋ`Փ˂Ȃ`FbNiXZʁB߂̃}Xj
+        if (!m_grid.TryInsert({ x, z, halfW, halfD }))
+        {
+            return false;   //Փ˂Ȃʂ̌
+        }
+
+        // Փ˂ȂΎۂɃIuWFNg쐬ăV[ɒǉ
+        auto obj = std::make_shared<Building>();
+        obj->SetScene(m_scene);
+        //iYj͕KvɉĒĂBł -12 ̃R[hƓɂĂ܂
+        obj->SetPosition({ x, -12.0f, z });
+        obj->SetScale({ 20.0f, 20.0f, 20.0f });
+        obj->SetRotation({ 0.0f, 0.0f, 0.0f });
+
+        //RC_[iOBBjǉBbaseColliderSize  scale Z
+        auto col = std::make_shared<AABBColliderComponent>();
+        col->SetSize({ 3.5f, 16.5f, 3.5f });
+        col->SetEnabled(false);
+        obj->AddComponent(col);
+        col->isStatic = true;
+
+        //fǂݍ݂
+        auto mc = std::make_shared<ModelComponent>();
+        mc->LoadModel(cfg.modelPath);
+        mc->SetInstanced(true);
+        obj->AddComponent(mc);
+
+        obj->Initialize();
+        m_scene->AddObject(obj);
+
+        ++placedCount;
+        return true;
+    };
+
+    if (cfg.usePoissonDisk)
+    {
+        //ԏłKdȂ鋗߂͍Ȃ
+        const float minHalf = std::min(cfg.scaleX, cfg.scaleZ) * 0.5f * std::min(cfg.minScale, cfg.maxScale) + cfg.spacing * 0.5f;
+
+        std::vector<DirectX::SimpleMath::Vector3> samples;
+        PlacementGrid::SamplePoissonDisk(-halfAreaX, -halfAreaZ, halfAreaX, halfAreaZ, minHalf * 2.0f, m_rng, 0, samples);
+
+        //ŏ̓_L鏇ɕł̂ŁAĂ count ܂Ŏg
+        for (int i = static_cast<int>(samples.size()) - 1; i > 0; --i)
+        {
+            std::swap(samples[i], samples[m_rng.RangeInt(0, i + 1)]);
+        }
+
+        for (const auto& sample : samples)
+        {
+            if (placedCount >= cfg.count) { break; }
+            tryPlace(sample.x, sample.z);
+        }
+
+        if (placedCount < cfg.count)
+        {
+            char buf[256];
+            sprintf_s(buf, "WARN: BuildingSpawner placed %d / %d buildings (area is full)\n", placedCount, cfg.count);
+            OutputDebugStringA(buf);
+        }
+        return placedCount;
+    }
+
     for (int i = 0; i < cfg.count; ++i)
     {
         bool placed = false;
@@ -40,68 +118,15 @@ int BuildingSpawner::RandomSpawn(const BuildingConfig& cfg)
 		//Max̎s񐔂܂Ŏs
         for (int attempt = 0; attempt < cfg.maxAttemptsPerBuilding; ++attempt)
         {
-            //ʒuEXP[E]
+            //ʒu
             float x = RandFloatStd(m_rng, -halfAreaX, halfAreaX);
             float z = RandFloatStd(m_rng, -halfAreaZ, halfAreaZ);
 
-			//XP[_Ɍ
-            float scale = (cfg.minScale == cfg.maxScale) ? cfg.minScale : RandFloatStd(m_rng, cfg.minScale, cfg.maxScale);
-
-			//Y]_Ɍ
-            //float yaw = cfg.randomizeRotation ? RandFloatStd(m_rng, 0.0f, 2.0f * 3.14159265358979323846f) : 0.0f;
-
-            //footprintiXZj̔vZiXP[j
-            float halfW = (cfg.scaleX * 0.5f) * scale + cfg.spacing * 0.5f;
-            float halfD = (cfg.scaleZ * 0.5f) * scale + cfg.spacing * 0.5f;
-
-            //ɔzûƋ`Փ˂Ȃ`FbNiXZʁj
-            bool overlap = false;
-            for (const auto& pr : m_placed)
+            if (tryPlace(x, z))
             {
-                if (std::fabs(x - pr.cx) < (halfW + pr.halfW) &&
-                    std::fabs(z - pr.cz) < (halfD + pr.halfD))
-                {
-                    overlap = true;
-                    break;
-                }
+                placed = true;
+                break;
             }
-
-            if (overlap) { continue; }  //Փ˂Ȃʂ̌
-
-            // Փ˂ȂΎۂɃIuWFNg쐬ăV[ɒǉ
-            auto obj = std::make_shared<Building>();
-            obj->SetScene(m_scene);
-            //iYj͕KvɉĒĂBł -12 ̃R[hƓɂĂ܂
-            obj->SetPosition({ x, -12.0f, z });
-            obj->SetScale({ 20.0f, 20.0f, 20.0f });
-            obj->SetRotation({ 0.0f, 0.0f, 0.0f });
-
-            //RC_[iOBBjǉBbaseColliderSize  scale Z
-            auto col = std::make_shared<AABBColliderComponent>();
-            col->SetSize({ 3.5f, 16.5f, 3.5f });
-            col->SetEnabled(false);
-            obj->AddComponent(col);
-            col->isStatic = true;
-
-            //fǂݍ݂
-            auto mc = std::make_shared<ModelComponent>();
-            mc->LoadModel(cfg.modelPath);
-            obj->AddComponent(mc);
-
-            obj->Initialize();
-            m_scene->AddObject(obj);
-
-            //L^
-            PlacedRect pr;
-            pr.cx = x;
-            pr.cz = z;
-            pr.halfW = halfW;
-            pr.halfD = halfD;
-            m_placed.push_back(pr);
-
-            placed = true;
-            ++placedCount;
-            break;
         } //attempts
 
         if (!placed)
@@ -125,13 +150,26 @@ int BuildingSpawner::Spawn(const BuildingConfig& cfg)
         return 0;
     }
 
-    m_placed.clear();   // ЂƂ܂̌ĂяoŔzu`
+    std::vector<DirectX::SimpleMath::Vector3> positions;
+    SelectFixedPositions(cfg, positions);
+
+    for (const auto& pos : positions)
+    {
+        Place(cfg, CreateBuilding(cfg, pos));
+    }
+
+    return static_cast<int>(positions.size());
+}
+
+void BuildingSpawner::SelectFixedPositions(const BuildingConfig& cfg, std::vector<DirectX::SimpleMath::Vector3>& out)
+{
+    out.clear();
 
     // u fixedPositions ̐ count ̏
     int numPositions = static_cast<int>(cfg.fixedPositions.size());
     if (numPositions <= 0)
     { 
-        return 0;
+        return;
     }
 
     int numToSpawn = numPositions;
@@ -140,32 +178,32 @@ int BuildingSpawner::Spawn(const BuildingConfig& cfg)
         numToSpawn = cfg.count;
     }
 
-    int placedCount = 0;
+    // footprintiXZj̔vZispacing j
+    float halfW = (cfg.scaleX * 0.5f) + cfg.spacing * 0.5f;
+    float halfD = (cfg.scaleZ * 0.5f) + cfg.spacing * 0.5f;
 
-    for (int i = 0; i < numToSpawn; ++i)
-    {
-        DirectX::SimpleMath::Vector3 pos = cfg.fixedPositions[i];
+    out.reserve(numToSpawn);
 
-        float x = pos.x;
-        float z = pos.z;
+    // ͈̔͂ɃObh𒣂([J[ĂԂ̂Ńo m_grid ͎gȂ)
+    float minX = cfg.fixedPositions[0].x, maxX = minX;
+    float minZ = cfg.fixedPositions[0].z, maxZ = minZ;
+    for (int i = 1; i < numToSpawn; ++i)
+    {
+        minX = std::min(minX, cfg.fixedPositions[i].x);
+        maxX = std::max(maxX, cfg.fixedPositions[i].x);
+        minZ = std::min(minZ, cfg.fixedPositions[i].z);
+        maxZ = std::max(maxZ, cfg.fixedPositions[i].z);
+    }
 
-        // footprintiXZj̔vZispacing j
-        float halfW = (cfg.scaleX * 0.5f) + cfg.spacing * 0.5f;
-        float halfD = (cfg.scaleZ * 0.5f) + cfg.spacing * 0.5f;
+    PlacementGrid grid;
+    grid.Reset(minX - halfW, minZ - halfD, maxX + halfW, maxZ + halfD, std::max(halfW, halfD) * 2.0f);
 
-        // ɔzûƋ`Փ˂Ȃ`FbNiXZʁj
-        bool overlap = false;
-        for (const auto& pr : m_placed)
-        {
-            if (std::fabs(x - pr.cx) < (halfW + pr.halfW) &&
-                std::fabs(z - pr.cz) < (halfD + pr.halfD))
-            {
-                overlap = true;
-                break;
-            }
-        }
+    for (int i = 0; i < numToSpawn; ++i)
+    {
+        DirectX::SimpleMath::Vector3 pos = cfg.fixedPositions[i];
 
-        if (overlap)
+        // ɑI񂾂̂Ƌ`Փ˂Ȃ`FbNiXZʁB߂̃}Xj
+        if (!grid.TryInsert({ pos.x, pos.z, halfW, halfD }))
         {
             // ł́udȂ肻ȂXLbvvƂĂ
             // KvȂ烍OoċzuAȂǂɕςĂ OK
@@ -175,49 +213,54 @@ int BuildingSpawner::Spawn(const BuildingConfig& cfg)
             continue;
         }
 
-        auto obj = std::make_shared<Building>();
-        obj->SetScene(m_scene);
+        out.push_back(pos);
+    }
+}
 
-        obj->SetPosition(pos);
+std::shared_ptr<Building> BuildingSpawner::CreateBuilding(const BuildingConfig& cfg, const DirectX::SimpleMath::Vector3& pos)
+{
+    auto obj = std::make_shared<Building>();
 
-        obj->SetScale({ cfg.scaleX, cfg.scaleY, cfg.scaleZ });
-        obj->SetRotation({ 0.0f, 0.0f, 0.0f }); 
+    obj->SetPosition(pos);
 
-        auto col = std::make_shared<AABBColliderComponent>();
-        col->SetSize(cfg.baseColliderSize);
-        col->SetEnabled(false);
-        obj->AddComponent(col);
-        col->isStatic = true;
+    obj->SetScale({ cfg.scaleX, cfg.scaleY, cfg.scaleZ });
+    obj->SetRotation({ 0.0f, 0.0f, 0.0f }); 
 
-        // fǂݍ
-        auto mc = std::make_shared<ModelComponent>();
-        mc->LoadModel(cfg.modelPath);
-        //mc->SetAlpha(0.25f);
-        obj->AddComponent(mc);
+    auto col = std::make_shared<AABBColliderComponent>();
+    col->SetSize(cfg.baseColliderSize);
+    col->SetEnabled(false);
+    obj->AddComponent(col);
+    col->isStatic = true;
 
-        auto push = std::make_shared<PushOutComponent>();
-        obj->AddComponent(push);
+    auto push = std::make_shared<PushOutComponent>();
+    obj->AddComponent(push);
 
-        obj->Initialize();
-        m_scene->AddObject(obj);
+    return obj;
+}
 
-        auto gameScene = dynamic_cast<GameScene*>(m_scene);
+void BuildingSpawner::Place(const BuildingConfig& cfg, const std::shared_ptr<Building>& obj)
+{
+    if (!m_scene || !obj)
+    {
+        return;
+    }
 
-        if (gameScene)
-        {
-            gameScene->AddStageBuilding(obj);
-        }
+    obj->SetScene(m_scene);
 
-        // footprint L^
-        PlacedRect pr;
-        pr.cx = x;
-        pr.cz = z;
-        pr.halfW = halfW;
-        pr.halfD = halfD;
-        m_placed.push_back(pr);
+    // fǂݍ(2ڂ ModelCache ɂ)
+    auto mc = std::make_shared<ModelComponent>();
+    mc->LoadModel(cfg.modelPath);
+    mc->SetInstanced(true);
+    //mc->SetAlpha(0.25f);
+    obj->AddComponent(mc);
 
-        ++placedCount;
-    }
+    obj->Initialize();
+    m_scene->AddObject(obj);
 
-    return placedCount;
+    auto gameScene = dynamic_cast<GameScene*>(m_scene);
+
+    if (gameScene)
+    {
+        gameScene->AddStageBuilding(obj);
+    }
 }
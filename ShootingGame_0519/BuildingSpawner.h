@@ -3,7 +3,8 @@
 #include <memory>
 #include <SimpleMath.h>
 #include <string>
-#include <random>   
+#include "RandomService.h"
+#include "PlacementGrid.h"
 #include "ModelResource.h"
 
 
@@ -27,10 +28,13 @@ struct BuildingConfig
 
     int maxAttemptsPerBuilding = 50;    //1̌u߂Ɏs񐔏
 
+    bool usePoissonDisk = false;        //RandomSpawn  Poisson fBXNŎU炷(ԊuAs񐔂̏)
+
     std::vector<DirectX::SimpleMath::Vector3> fixedPositions;  //Œ萶̌̈ʒu;
 };
 
 class IScene;
+class Building;
 
 class BuildingSpawner
 {
@@ -43,15 +47,22 @@ public:
 
     int Spawn(const BuildingConfig& cfg);
 
+    //-----------------------Spawn 𕪂(WorldStreamer g)-----------------------
+    //fixedPositions dȂȂʒuI(oGȂ̂Ń[J[Ăׂ)
+    static void SelectFixedPositions(const BuildingConfig& cfg, std::vector<DirectX::SimpleMath::Vector3>& out);
+
+    //RC_[Ɖot(D3D V[GȂ̂Ń[J[Ăׂ)
+    static std::shared_ptr<Building> CreateBuilding(const BuildingConfig& cfg, const DirectX::SimpleMath::Vector3& pos);
+
+    //ftăV[ɒu(CXbh)
+    void Place(const BuildingConfig& cfg, const std::shared_ptr<Building>& obj);
+
+    //--------Get֐-------
+    IScene* GetScene() const { return m_scene; }
+
 private:
     IScene* m_scene;
 
-    struct PlacedRect
-    {
-        float cx, cz;           //SW X,Z
-        float halfW, halfD;     //, s
-    };
-
-    std::vector<PlacedRect> m_placed;   //ɔzu footprint
-    std::mt19937_64 m_rng;
+    PlacementGrid m_grid;   //ɔzu footprint
+    RandomStream m_rng;
 };
\ No newline at end of file
@@ -4,7 +4,9 @@
 #include "CollisionManager.h"
 #include "SphereComponent.h"
 #include "PushOutComponent.h"
+#include <d3d11.h>
 #include "Renderer.h" // optional: for debug draw
+#include "RenderQueue.h"
 #include <iostream>
 
 void Bullet::Initialize()
@@ -50,24 +52,7 @@ void Bullet::Draw(float alpha)
 {
     GameObject::Draw(alpha);
 
-    //[hsZbg
-    Matrix4x4 world = GetTransform().GetMatrix();
-    Renderer::SetWorldMatrix(&world);
-
-    Renderer::SetDepthEnable(true);
-    Renderer::DisableCulling(false);
-
-    //ۑ:  PS ɃoChĂ CB(slot3) 擾Ă
-    ID3D11Buffer* prevPSCB = nullptr;
-    Renderer::GetDeviceContext()->PSGetConstantBuffers(3, 1, &prevPSCB);
-
-    // --- 2) }eAZbgislot 3 g݌vɍ킹j ---
-    MATERIAL mat{};
-    mat.Diffuse = Color(1.0f, 0.0f, 0.0f, 1.0f); // 
-    Renderer::SetMaterial(mat);
-
-    // --- 3) (IvVS) 1x1 ̐ԃeNX`쐬 t0 ɃoCh ---
-    // static ɂĈx
+    //1x1 ̒PFeNX` (static ɂĈx)
     static ComPtr<ID3D11ShaderResourceView> s_redSRV;
 
     static ComPtr<ID3D11ShaderResourceView> s_blueSRV;
@@ -82,7 +67,7 @@ void Bullet::Draw(float alpha)
 
     // helper lambda: create 1x1 SRV with RGBA
     auto createColorSRV = [&](ComPtr<ID3D11ShaderResourceView>& outSRV, ID3D11Device* dev, uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
-        if (outSRV) { return; }
+        if (outSRV || !dev) { return; }
         D3D11_TEXTURE2D_DESC td{};
         td.Width = 1; td.Height = 1; td.MipLevels = 1; td.ArraySize = 1;
         td.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
@@ -112,18 +97,20 @@ void Bullet::Draw(float alpha)
     if (owner == BulletComponent::BulletType::ENEMY) colorSRV = s_blueSRV.Get();
     else colorSRV = s_redSRV.Get();
 
-    // ۑĂ PS SRV oĕł悤ɂĂ
-    ID3D11ShaderResourceView* prevSRV = nullptr;
-    Renderer::GetDeviceContext()->PSGetShaderResources(0, 1, &prevSRV);
-
-    if (colorSRV) Renderer::GetDeviceContext()->PSSetShaderResources(0, 1, &colorSRV);
-
-    //`
-    m_primitive.Draw(Renderer::GetDeviceContext());
-
-    //
-    Renderer::GetDeviceContext()->PSSetShaderResources(0, 1, &prevSRV);
-    if (prevSRV) prevSRV->Release();
+    //`pPbg RenderQueue ɓo^
+    //(Ԃ̕ۑE̓L[ł܂Ƃ߂čs)
+    DrawPacket packet;
+    packet.vertexBuffer = m_primitive.GetVertexBuffer();
+    packet.stride = m_primitive.GetStride();
+    packet.indexBuffer = m_primitive.GetIndexBuffer();
+    packet.indexCount = m_primitive.GetIndexCount();
+    packet.material.Diffuse = Color(1.0f, 0.0f, 0.0f, 1.0f); // 
+    packet.texture = colorSRV;
+    packet.depthEnable = true;
+    packet.cullBack = false;
+    packet.world = GetTransform().GetMatrix();
+
+    RenderQueue::Submit(packet);
 }
 
 void Bullet::OnCollision(GameObject* other)
@@ -21,7 +21,31 @@ void BulletComponent::Initialize()
         m_speed = 20.0f;
     }
 
-    m_age = 0.0f;
+    StartLifeTimer();
+}
+
+void BulletComponent::SetLifetime(float lifetime)
+{
+    m_lifetime = lifetime;
+
+    //łe͍琔
+    if (m_lifeTimer.IsActive())
+    {
+        StartLifeTimer();
+    }
+}
+
+void BulletComponent::StartLifeTimer()
+{
+    //͖t[AԂĂ΂悤ɂ
+    m_lifeTimer.Start(m_lifetime, [this]()
+        {
+            GameObject* owner = GetOwner();
+            if (!owner) { return; }
+
+            IScene* scene = owner->GetScene();
+            if (scene) { scene->RemoveObject(owner); }
+        });
 }
 
 void BulletComponent::SetVelocity(const Vector3& velocity)
@@ -39,16 +63,6 @@ void BulletComponent::Update(float dt)
     GameObject* owner = GetOwner();
     if (!owner) { return; }
 
-    m_age += dt;
-
-    //  `FbN
-    if (m_age >= m_lifetime)
-    {
-        IScene* scene = owner->GetScene();
-        if (scene) { scene->RemoveObject(owner); }
-        return;
-    }
-
     //  ƏǏ]i펞Lj
     if (m_followAim && m_aimTargetProvider)
     {
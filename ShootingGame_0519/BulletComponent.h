@@ -2,6 +2,7 @@
 #include "Component.h"
 #include <SimpleMath.h>
 #include <functional>
+#include "TimerWheel.h"
 
 using namespace DirectX::SimpleMath;
 
@@ -24,7 +25,7 @@ public:
     //-------------Set֐--------------
     void SetVelocity(const Vector3& velocity);
     void SetSpeed(float speed) { m_speed = speed; }
-    void SetLifetime(float lifetime) { m_lifetime = lifetime; }
+    void SetLifetime(float lifetime);
     void SetBulletType(BulletType type) { m_ownerType = type; }
     void SetColor(const Vector4& color) { m_color = color; }
 
@@ -41,13 +42,15 @@ public:
     bool GetFollowAim() const { return m_followAim; }
 
 private:
+    void StartLifeTimer();
+
     //--------------ړ֘A------------------
     Vector3 m_velocity = Vector3::Forward;
     float m_speed = 40.0f;
 
     //--------------֘A------------------
-    float m_age = 0.0f;
     float m_lifetime = 1.0f;
+    TimerWheel::Timer m_lifeTimer;  //ԂV[O
 
     //--------------ƏǏ]֘A------------------
     bool m_followAim = false;
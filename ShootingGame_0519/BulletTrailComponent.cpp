@@ -1,4 +1,5 @@
 #include "BulletTrailComponent.h"
+#include <d3d11.h>
 #include "Renderer.h"
 #include <algorithm>
 
@@ -58,7 +59,7 @@ void BulletTrailComponent::Draw(float dt)
     col.w *= (1.0f - t);
 
     Renderer::DrawTrailBillboard(
-        m_textureSrv,
+        m_textureSrv.Get(),
         m_startPos,
         m_endPos,
         m_width,
@@ -2,6 +2,7 @@
 #include "Component.h"
 #include <SimpleMath.h>
 #include <d3d11.h>
+#include <wrl/client.h>
 
 class BulletTrailComponent : public Component
 {
@@ -37,6 +38,6 @@ private:
     //--------------ڊ֘A------------------
     float m_width = 0.35f;
     DirectX::SimpleMath::Vector4 m_color = { 0.2f, 1.0f, 1.0f, 0.25f };
-    ID3D11ShaderResourceView* m_textureSrv = nullptr;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_textureSrv;
     bool m_isAdditive = true;
 };
\ No newline at end of file
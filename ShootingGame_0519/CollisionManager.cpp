@@ -9,6 +9,7 @@
 #include "Collision.h"
 #include "CollisionResolver.h"
 #include "DebugGlobals.h"
+#include <d3d11.h>
 #include "renderer.h"
 #include "GameObject.h"
 #include "MoveComponent.h"
@@ -30,6 +30,7 @@ public:
 
     //m_Colliders ɓo^ꂽRC_[̑Sgݍ킹𔻒肷֐
     //肪OnCollisionĂяo
+    //(OnCollision  GameplayEvents ɐςނɂāA_[WȂǂ͌ Dispatch ł܂Ƃ߂ď)
     static void CheckCollisions();
 
     static void DebugDrawAllColliders(DebugRenderer& dr);
@@ -1,4 +1,10 @@
+#define NOMINMAX
 #include "CsvGridLoader.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 
@@ -49,4 +55,141 @@ std::vector<std::vector<int>> CsvGridLoader::LoadGrid(const std::string& filePat
     }
 
     return grid;
-}
\ No newline at end of file
+}
+
+//-----------------------}bv1œǂޔ-----------------------
+namespace
+{
+    inline bool IsCellSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    //[begin, end) 1s̃}X( , ͐ȂBs 0)
+    int CountCells(const char* begin, const char* end)
+    {
+        while (end > begin && IsCellSpace(end[-1]))
+        {
+            --end;
+        }
+        if (end == begin)
+        {
+            return 0;
+        }
+
+        int count = 1 + static_cast<int>(std::count(begin, end, ','));
+        if (end[-1] == ',')
+        {
+            --count;
+        }
+        return count;
+    }
+
+    inline const char* FindLineEnd(const char* p, const char* end)
+    {
+        const void* nl = memchr(p, '\n', static_cast<size_t>(end - p));
+        return nl ? static_cast<const char*>(nl) : end;
+    }
+}
+
+bool CsvGridLoader::LoadFlatGrid(const std::string& filePath, StageGrid& outGrid)
+{
+    outGrid = StageGrid();
+
+    MappedFile file;
+    //1oCgL ASCII ȊÕpX̂ŁApath ɔCĕϊ
+    if (!file.Open(std::filesystem::path(filePath).wstring()))
+    {
+        return false;
+    }
+
+    return ParseFlatGrid(reinterpret_cast<const char*>(file.GetData()), file.GetSize(), outGrid);
+}
+
+bool CsvGridLoader::ParseFlatGrid(const char* data, size_t size, StageGrid& outGrid)
+{
+    outGrid = StageGrid();
+    if (!data || size == 0)
+    {
+        return false;
+    }
+
+    const char* begin = data;
+    const char* end = data + size;
+
+    //Excel Ȃǂt UTF-8  BOM
+    if (size >= 3 &&
+        static_cast<unsigned char>(begin[0]) == 0xEF &&
+        static_cast<unsigned char>(begin[1]) == 0xBB &&
+        static_cast<unsigned char>(begin[2]) == 0xBF)
+    {
+        begin += 3;
+    }
+
+    //1 : sƈԒs̃}XāAObh1Ŋmۂ
+    int rows = 0;
+    int cols = 0;
+    for (const char* p = begin; p < end; )
+    {
+        const char* lineEnd = FindLineEnd(p, end);
+        cols = std::max(cols, CountCells(p, lineEnd));
+        ++rows;
+        p = lineEnd + 1;
+    }
+
+    if (rows == 0 || cols == 0)
+    {
+        return false;
+    }
+
+    outGrid.rows = rows;
+    outGrid.cols = cols;
+    outGrid.cells.assign(static_cast<size_t>(rows) * cols, 0);
+
+    //2 : from_chars ł̏Őɂ(͍Ȃ)
+    int row = 0;
+    for (const char* p = begin; p < end; ++row)
+    {
+        const char* lineEnd = FindLineEnd(p, end);
+        int* out = &outGrid.cells[static_cast<size_t>(row) * cols];
+
+        int col = 0;
+        const char* cell = p;
+        while (cell < lineEnd && col < cols)
+        {
+            while (cell < lineEnd && IsCellSpace(*cell))
+            {
+                ++cell;
+            }
+            if (cell < lineEnd && *cell == '+')
+            {
+                ++cell;
+            }
+
+            int value = 0;
+            const std::from_chars_result result = std::from_chars(cell, lineEnd, value);
+            if (result.ec != std::errc())
+            {
+                value = 0;
+            }
+            out[col++] = value;
+
+            //قƂǂ͐̂낪 , Ȃ̂ŁAłȂT
+            cell = (result.ec == std::errc()) ? result.ptr : cell;
+            if (cell < lineEnd && *cell != ',')
+            {
+                const void* comma = memchr(cell, ',', static_cast<size_t>(lineEnd - cell));
+                cell = comma ? static_cast<const char*>(comma) : lineEnd;
+            }
+            if (cell >= lineEnd)
+            {
+                break;
+            }
+            ++cell;
+        }
+
+        p = lineEnd + 1;
+    }
+
+    return true;
+}
@@ -1,9 +1,29 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <cstddef>
+
+//sD(row-major)ɋl߂̃Obh
+//Zs̑Ȃ}X 0()Ŗ߂
+struct StageGrid
+{
+    int rows = 0;
+    int cols = 0;
+    std::vector<int> cells;     //rows * cols
+
+    bool IsEmpty() const { return rows == 0 || cols == 0; }
+    int At(int row, int col) const { return cells[static_cast<size_t>(row) * cols + col]; }
+};
 
 class CsvGridLoader
 {
 public:
+    //1s stringstream ŕ(x`}[N̔rpɎcĂ)
     static std::vector<std::vector<int>> LoadGrid(const std::string& filePath);
+
+    //t@C}bv1œǂ(łȂ}X 0A擪 BOM ͔΂)
+    static bool LoadFlatGrid(const std::string& filePath, StageGrid& outGrid);
+
+    // CSV ǂ(LoadFlatGrid ̒g)
+    static bool ParseFlatGrid(const char* data, size_t size, StageGrid& outGrid);
 };
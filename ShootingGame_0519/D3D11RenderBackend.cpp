@@ -0,0 +1,152 @@
+#include <d3d11.h>
+#include "D3D11RenderBackend.h"
+#include "renderer.h"
+
+namespace
+{
+    DXGI_FORMAT ToDxgiFormat(RENDER_INDEX_FORMAT format)
+    {
+        switch (format)
+        {
+        case RIF_UINT16: return DXGI_FORMAT_R16_UINT;
+        case RIF_UINT32: return DXGI_FORMAT_R32_UINT;
+        default:         return DXGI_FORMAT_UNKNOWN;
+        }
+    }
+
+    D3D11_PRIMITIVE_TOPOLOGY ToD3DTopology(RENDER_TOPOLOGY topology)
+    {
+        switch (topology)
+        {
+        case RT_TRIANGLE_LIST:  return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+        case RT_TRIANGLE_STRIP: return D3D11_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP;
+        case RT_LINE_LIST:      return D3D11_PRIMITIVE_TOPOLOGY_LINELIST;
+        default:                return D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED;
+        }
+    }
+}
+
+//Renderer  Set ֐ D3D11 obNGh͎̎ D3D ĂԂ̂ŁA
+//ĂłobNGhւ͖߂ĂȂ
+
+void D3D11RenderBackend::BeginFrame()
+{
+    Count(RC_BEGIN_FRAME);
+}
+
+void D3D11RenderBackend::EndFrame()
+{
+    Count(RC_END_FRAME);
+    CloseFrameStats();
+}
+
+void D3D11RenderBackend::SetShaders(ID3D11VertexShader* vertexShader, ID3D11PixelShader* pixelShader, ID3D11InputLayout* inputLayout)
+{
+    Count(RC_SET_SHADERS);
+
+    ID3D11DeviceContext* ctx = Renderer::GetDeviceContext();
+    ctx->IASetInputLayout(inputLayout);
+    ctx->VSSetShader(vertexShader, nullptr, 0);
+    ctx->PSSetShader(pixelShader, nullptr, 0);
+}
+
+void D3D11RenderBackend::SetBlendState(int blendState)
+{
+    Count(RC_SET_BLEND);
+    Renderer::SetBlendState(blendState);
+}
+
+void D3D11RenderBackend::SetDepthEnable(bool enable)
+{
+    Count(RC_SET_DEPTH);
+    Renderer::SetDepthEnable(enable);
+}
+
+void D3D11RenderBackend::SetCulling(bool cullBack)
+{
+    Count(RC_SET_CULLING);
+    Renderer::DisableCulling(cullBack);
+}
+
+void D3D11RenderBackend::SetGeometry(ID3D11Buffer* vertexBuffer, uint32_t stride, ID3D11Buffer* indexBuffer, RENDER_INDEX_FORMAT indexFormat, RENDER_TOPOLOGY topology)
+{
+    Count(RC_SET_GEOMETRY);
+
+    ID3D11DeviceContext* ctx = Renderer::GetDeviceContext();
+    uint32_t offset = 0;
+    ctx->IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &offset);
+    ctx->IASetIndexBuffer(indexBuffer, ToDxgiFormat(indexFormat), 0);
+    ctx->IASetPrimitiveTopology(ToD3DTopology(topology));
+}
+
+void D3D11RenderBackend::SetInstanceBuffer(ID3D11Buffer* instanceBuffer, uint32_t stride)
+{
+    Count(RC_SET_INSTANCE_BUFFER);
+
+    uint32_t offset = 0;
+    Renderer::GetDeviceContext()->IASetVertexBuffers(1, 1, &instanceBuffer, &stride, &offset);
+}
+
+void D3D11RenderBackend::SetTexture(ID3D11ShaderResourceView* texture)
+{
+    Count(RC_SET_TEXTURE);
+    Renderer::GetDeviceContext()->PSSetShaderResources(0, 1, &texture);
+}
+
+void D3D11RenderBackend::SetMaterial(const MATERIAL& material)
+{
+    Count(RC_SET_MATERIAL);
+    Renderer::SetMaterial(material);
+}
+
+void D3D11RenderBackend::SetWorldMatrix(const Matrix4x4& world)
+{
+    Count(RC_SET_WORLD);
+
+    Matrix4x4 mat = world;
+    Renderer::SetWorldMatrix(&mat);
+}
+
+void D3D11RenderBackend::SetViewMatrix(const Matrix4x4& view)
+{
+    Count(RC_SET_VIEW);
+    Renderer::SetViewMatrix(view);
+}
+
+void D3D11RenderBackend::SetProjectionMatrix(const Matrix4x4& projection)
+{
+    Count(RC_SET_PROJECTION);
+    Renderer::SetProjectionMatrix(projection);
+}
+
+void D3D11RenderBackend::DrawIndexed(uint32_t indexCount)
+{
+    Count(RC_DRAW_INDEXED);
+    CountDraw(indexCount, 1);
+
+    Renderer::GetDeviceContext()->DrawIndexed(indexCount, 0, 0);
+}
+
+void D3D11RenderBackend::DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t startInstance)
+{
+    Count(RC_DRAW_INSTANCED);
+    CountDraw(indexCount, instanceCount);
+
+    Renderer::GetDeviceContext()->DrawIndexedInstanced(indexCount, instanceCount, 0, 0, startInstance);
+}
+
+void D3D11RenderBackend::DrawTexture(ID3D11ShaderResourceView* texture, const Vector2& position, const Vector2& size)
+{
+    Count(RC_DRAW_TEXTURE);
+    CountDraw(6, 1);
+
+    Renderer::DrawTexture(texture, position, size);
+}
+
+void D3D11RenderBackend::DrawBillboard(ID3D11ShaderResourceView* texture, const Vector3& worldPos, float size)
+{
+    Count(RC_DRAW_BILLBOARD);
+    CountDraw(6, 1);
+
+    Renderer::DrawBillboard(texture, worldPos, size, Vector4(1.0f, 1.0f, 1.0f, 1.0f));
+}
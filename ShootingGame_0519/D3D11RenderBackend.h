@@ -0,0 +1,33 @@
+#pragma once
+#include "RenderBackend.h"
+
+//---------------------------------------------------------
+// ʏ̃obNGhBR}ĥ܂ D3D11 ̃ReLXg֔s
+// (uhE[xȂǂ̃Xe[g Renderer Ă̂g)
+//---------------------------------------------------------
+class D3D11RenderBackend : public RenderBackend
+{
+public:
+    const char* GetName() const override { return "D3D11"; }
+    bool IsHeadless() const override { return false; }
+
+    void BeginFrame() override;
+    void EndFrame() override;
+
+    void SetShaders(ID3D11VertexShader* vertexShader, ID3D11PixelShader* pixelShader, ID3D11InputLayout* inputLayout) override;
+    void SetBlendState(int blendState) override;
+    void SetDepthEnable(bool enable) override;
+    void SetCulling(bool cullBack) override;
+    void SetGeometry(ID3D11Buffer* vertexBuffer, uint32_t stride, ID3D11Buffer* indexBuffer, RENDER_INDEX_FORMAT indexFormat, RENDER_TOPOLOGY topology) override;
+    void SetInstanceBuffer(ID3D11Buffer* instanceBuffer, uint32_t stride) override;
+    void SetTexture(ID3D11ShaderResourceView* texture) override;
+    void SetMaterial(const MATERIAL& material) override;
+    void SetWorldMatrix(const Matrix4x4& world) override;
+    void SetViewMatrix(const Matrix4x4& view) override;
+    void SetProjectionMatrix(const Matrix4x4& projection) override;
+
+    void DrawIndexed(uint32_t indexCount) override;
+    void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t startInstance) override;
+    void DrawTexture(ID3D11ShaderResourceView* texture, const Vector2& position, const Vector2& size) override;
+    void DrawBillboard(ID3D11ShaderResourceView* texture, const Vector3& worldPos, float size) override;
+};
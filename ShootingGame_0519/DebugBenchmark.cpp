@@ -0,0 +1,60 @@
+#include "DebugBenchmark.h"
+#include "system/imGui/imgui.h"
+
+std::vector<DebugBenchmark::Entry> DebugBenchmark::m_entries;
+
+void DebugBenchmark::Register(const std::string& name, BenchmarkFunc func)
+{
+    if (!func) { return; }
+
+    //OȂ㏑
+    for (auto& entry : m_entries)
+    {
+        if (entry.name == name)
+        {
+            entry.func = func;
+            return;
+        }
+    }
+
+    Entry entry;
+    entry.name = name;
+    entry.func = func;
+    m_entries.push_back(entry);
+}
+
+void DebugBenchmark::DrawWindow()
+{
+    if (m_entries.empty()) { return; }
+
+    ImGui::Begin("Benchmark");
+
+    for (auto& entry : m_entries)
+    {
+        ImGui::PushID(entry.name.c_str());
+
+        if (ImGui::Button("Run"))
+        {
+            //d̂Ń{^t[s
+            entry.results.clear();
+            entry.func(entry.results);
+        }
+        ImGui::SameLine();
+        ImGui::Text("%s", entry.name.c_str());
+
+        for (const auto& line : entry.results)
+        {
+            ImGui::TextUnformatted(line.c_str());
+        }
+
+        ImGui::Separator();
+        ImGui::PopID();
+    }
+
+    ImGui::End();
+}
+
+void DebugBenchmark::Clear()
+{
+    m_entries.clear();
+}
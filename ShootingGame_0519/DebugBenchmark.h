@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+
+//---------------------------------------------------------
+// fobOp̃x`}[N܂Ƃ߂ ImGui sNX
+// eVXe Register ĂA{^s
+//---------------------------------------------------------
+class DebugBenchmark
+{
+public:
+    //outLines Ɍʂ1sǉ֐
+    using BenchmarkFunc = std::function<void(std::vector<std::string>& outLines)>;
+
+    static void Register(const std::string& name, BenchmarkFunc func);
+
+    //DebugUI::Render ̒Ă
+    static void DrawWindow();
+
+    static void Clear();
+
+private:
+    struct Entry
+    {
+        std::string name;
+        BenchmarkFunc func;
+        std::vector<std::string> results;   //߂̌
+    };
+
+    static std::vector<Entry> m_entries;
+};
@@ -2,6 +2,7 @@
 #include "DebugScene.h"
 #include "Input.h"
 #include "DebugGlobals.h" 
+#include <d3d11.h>
 #include "renderer.h"
 #include "Application.h"
 #include "Collision.h"
@@ -16,6 +17,7 @@
 #include "PushOutComponent.h"
 #include "SphereColliderComponent.h"
 #include "EffectManager.h"
+#include "GameplayEvents.h"
 #include "SceneManager.h"
 
 #include "IniFile.h"
@@ -85,30 +87,30 @@ bool DebugScene::LoadPlayerConfigFromIni()
 
 void DebugScene::SavePlayerConfigToIni()
 {
+    //読み込んだ表を書き換えて、最後に1回で書き出す(コメントや他のキーは残る)
     IniFile ini(m_iniPath.c_str());
 
-    bool ok = true;
-
     //書き込み
-    ok = ok && ini.WriteFloatResult("Player", "MoveSpeed", m_playerMoveSpeed);
-    ok = ok && ini.WriteFloatResult("Player", "BoostMultiplier", m_playerBoostMultiplier);
-    ok = ok && ini.WriteFloatResult("Player", "BulletSpeed", m_playerBulletSpeed);
-    ok = ok && ini.WriteFloatResult("Player", "HpMax", m_playerHp);
+    ini.WriteFloat("Player", "MoveSpeed", m_playerMoveSpeed);
+    ini.WriteFloat("Player", "BoostMultiplier", m_playerBoostMultiplier);
+    ini.WriteFloat("Player", "BulletSpeed", m_playerBulletSpeed);
+    ini.WriteFloat("Player", "HpMax", m_playerHp);
 
 	//書き込み
-    ok = ok && ini.WriteFloatResult("Camera", "Distance", m_cameraDistance);
-    ok = ok && ini.WriteFloatResult("Camera", "Heigh", m_cameraHeight);
-    ok = ok && ini.WriteFloatResult("Camera", "FovDeg", m_cameraFovDeg);
-    ok = ok && ini.WriteFloatResult("Camera", "BoostFovDeg", m_cameraBoostFovDeg);
-    ok = ok && ini.WriteFloatResult("Camera", "Sensitivity", m_cameraSensitivity);
+    ini.WriteFloat("Camera", "Distance", m_cameraDistance);
+    ini.WriteFloat("Camera", "Heigh", m_cameraHeight);
+    ini.WriteFloat("Camera", "FovDeg", m_cameraFovDeg);
+    ini.WriteFloat("Camera", "BoostFovDeg", m_cameraBoostFovDeg);
+    ini.WriteFloat("Camera", "Sensitivity", m_cameraSensitivity);
 
 	//書き込み
-    ok = ok && ini.WriteFloatResult("Blur", "Stretch", m_blurStretch);
-    ok = ok && ini.WriteFloatResult("Blur", "StartPoint", m_blurStartPoint);
-    ok = ok && ini.WriteFloatResult("Blur", "EndPoint", m_blurEndPoint);
-    ok = ok && ini.WriteFloatResult("Blur", "CenterX", m_blurCenterX);
-    ok = ok && ini.WriteFloatResult("Blur", "CenterY", m_blurCenterY);
+    ini.WriteFloat("Blur", "Stretch", m_blurStretch);
+    ini.WriteFloat("Blur", "StartPoint", m_blurStartPoint);
+    ini.WriteFloat("Blur", "EndPoint", m_blurEndPoint);
+    ini.WriteFloat("Blur", "CenterX", m_blurCenterX);
+    ini.WriteFloat("Blur", "CenterY", m_blurCenterY);
 
+    const bool ok = ini.Save();
     if (ok)
     {
          m_imguiMessageLog = "Saved: GameSetting.ini";
@@ -492,10 +494,10 @@ void DebugScene::InitializeUI()
     m_miniMap->SetRotateWithPlayer(true);
     m_miniMap->SetIconSize(10.0f);
 
-    m_miniMap->SetBackgroundSRV(m_miniMapBgSRV);
-    m_miniMap->SetPlayerIconSRV(m_miniMapPlayerSRV);
-    m_miniMap->SetEnemyIconSRV(m_miniMapEnemySRV);
-    m_miniMap->SetBuildingIconSRV(m_miniMapBuildingSRV);
+    m_miniMap->SetBackgroundSRV(m_miniMapBgSRV.Get());
+    m_miniMap->SetPlayerIconSRV(m_miniMapPlayerSRV.Get());
+    m_miniMap->SetEnemyIconSRV(m_miniMapEnemySRV.Get());
+    m_miniMap->SetBuildingIconSRV(m_miniMapBuildingSRV.Get());
 
     m_miniMap->SetPlayer(m_player.get()); // m_playerがshared_ptr<GameObject>想定
 
@@ -740,6 +742,7 @@ void DebugScene::Update(float deltatime)
 
         //当たり判定チェック実行
         CollisionManager::CheckCollisions();
+        GameplayEvents::Dispatch();
 
         for (auto& obj : m_GameObjects)
         {
@@ -930,28 +933,12 @@ void DebugScene::Uninit()
     // DebugUI に「登録解除」があるならここで呼ぶ
     // DebugUI::Clear();
 
-    // ---------------- SRVの解放（必要な設計の場合のみ） ----------------
-    // TextureManager が所有しているなら Release しないこと！
-    if (m_miniMapBgSRV)
-    {
-        m_miniMapBgSRV->Release();
-        m_miniMapBgSRV = nullptr;
-    }
-    if (m_miniMapPlayerSRV)
-    {
-        m_miniMapPlayerSRV->Release();
-        m_miniMapPlayerSRV = nullptr;
-    }
-    if (m_miniMapEnemySRV)
-    {
-        m_miniMapEnemySRV->Release();
-        m_miniMapEnemySRV = nullptr;
-    }
-    if (m_miniMapBuildingSRV)
-    {
-        m_miniMapBuildingSRV->Release();
-        m_miniMapBuildingSRV = nullptr;
-    }
+    // ---------------- SRVの参照を外す ----------------
+    // 実体は TextureManager が持っている。参照が無くなれば ResidencyManager が外せる
+    m_miniMapBgSRV.Reset();
+    m_miniMapPlayerSRV.Reset();
+    m_miniMapEnemySRV.Reset();
+    m_miniMapBuildingSRV.Reset();
 
     // ---------------- spawner / renderer ----------------
     if (m_enemySpawner)
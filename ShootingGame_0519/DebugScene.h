@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <d3d11.h>
+#include <wrl/client.h>
 #include "IScene.h"
 #include "FreeCamera.h"
 #include "Player.h"
@@ -133,10 +134,10 @@ private:
 	std::shared_ptr<GameObject> m_miniMapUi;
 	MiniMapComponent* m_miniMap = nullptr;
 
-	ID3D11ShaderResourceView* m_miniMapBgSRV = nullptr;
-	ID3D11ShaderResourceView* m_miniMapPlayerSRV = nullptr;
-	ID3D11ShaderResourceView* m_miniMapEnemySRV = nullptr;
-	ID3D11ShaderResourceView* m_miniMapBuildingSRV = nullptr;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_miniMapBgSRV;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_miniMapPlayerSRV;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_miniMapEnemySRV;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_miniMapBuildingSRV;
 
 	//------------ݒpt@C֘A------------------
 	std::string m_iniPath = "Data/GameSettings.ini";
@@ -1,4 +1,20 @@
 #include "DebugUI.h"
+#include "InstancedRenderer.h"
+#include "RenderQueue.h"
+#include "MeshLod.h"
+#include "TextureManager.h"
+#include "ResidencyManager.h"
+#include "DebugBenchmark.h"
+#include "Sound.h"
+#include "PatrolSteering.h"
+#include "HomingSwarm.h"
+#include "FlowField.h"
+#include "AiScheduler.h"
+#include "RandomService.h"
+#include "StageCache.h"
+#include "WorldStreamer.h"
+#include "TimerWheel.h"
+#include "GameplayEvents.h"
 
 std::vector<std::function<void(void)>> DebugUI::m_debugfunction;
 
@@ -45,8 +61,167 @@ void DebugUI::Render() {
     ImGuiIO& io = ImGui::GetIO();
     ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
 
+    // CX^X`̓v(Ot[)
+    const auto& inst = InstancedRenderer::GetStats();
+    ImGui::Text("Instanced: %d draws / %d instances (culled %d)", inst.drawCalls, inst.instances, inst.culled);
+
+    // `L[̏ԕύX(Ot[)
+    const auto& rq = RenderQueue::GetStats();
+    ImGui::Text("RenderQueue: %d draws, %d state changes (%d skipped)",
+        rq.drawCalls, rq.TotalChanges(), rq.TotalSkipped());
+    ImGui::Text("  build %.3f ms / sort %.3f ms (%d threads, %d sources)",
+        rq.buildMs, rq.sortMs, rq.threads, rq.sources);
+    if (ImGui::TreeNode("State changes"))
+    {
+        for (int i = 0; i < RenderQueue::MAX_STATE; ++i)
+        {
+            ImGui::Text("%-10s %4d set / %4d skipped", RenderQueue::GetStateName(i), rq.changes[i], rq.skipped[i]);
+        }
+        ImGui::TreePop();
+    }
+
+    // LOD Ō炵Op`(Ot[)
+    bool lodEnabled = MeshLod::IsEnabled();
+    if (ImGui::Checkbox("Mesh LOD", &lodEnabled))
+    {
+        MeshLod::SetEnabled(lodEnabled);
+    }
+    const auto& lod = MeshLod::GetStats();
+    ImGui::SameLine();
+    ImGui::Text("%d -> %d tris (L0 %d / L1 %d / L2 %d / L3 %d)",
+        lod.fullTriangles, lod.triangles,
+        lod.levelMeshes[0], lod.levelMeshes[1], lod.levelMeshes[2], lod.levelMeshes[3]);
+
+    // 񂷂G̃XeAO(ob`؂1̂ Update ̒ŌvZ)
+    bool steeringBatched = PatrolSteering::IsBatched();
+    if (ImGui::Checkbox("Batched patrol steering", &steeringBatched))
+    {
+        PatrolSteering::SetBatched(steeringBatched);
+    }
+    const auto& steering = PatrolSteering::GetStats();
+    ImGui::SameLine();
+    ImGui::Text("%s, %d enemies, %.3f ms", PatrolSteering::GetKernelName(steering.kernel),
+        steering.enemies, steering.steerMs);
+
+    // ǔě}vZ(targets ͑xς̐)
+    bool swarmBatched = HomingSwarm::IsBatched();
+    if (ImGui::Checkbox("Batched homing swarm", &swarmBatched))
+    {
+        HomingSwarm::SetBatched(swarmBatched);
+    }
+    const auto& swarm = HomingSwarm::GetStats();
+    ImGui::SameLine();
+    ImGui::Text("%s, %d missiles / %d targets, %.3f ms", HomingSwarm::GetKernelName(swarm.kernel),
+        swarm.missiles, swarm.targets, swarm.steerMs);
+
+    // GAILOD(deferred oĂȂ1t[̏ɓĂ)
+    bool aiLod = AiScheduler::IsEnabled();
+    if (ImGui::Checkbox("AI LOD", &aiLod))
+    {
+        AiScheduler::SetEnabled(aiLod);
+    }
+    const auto& ai = AiScheduler::GetStats();
+    ImGui::SameLine();
+    ImGui::Text("near %d / mid %d / far %d / dormant %d, updated %d, deferred %d, %.3f / %.1f ms",
+        ai.agents[AiScheduler::AI_TIER_NEAR], ai.agents[AiScheduler::AI_TIER_MID],
+        ai.agents[AiScheduler::AI_TIER_FAR], ai.agents[AiScheduler::AI_TIER_DORMANT],
+        ai.updated, ai.deferred, ai.aiMs, AiScheduler::GetBudgetMs());
+
+    // ǂG̗(slices  1 傫Ȃgݒ𕪂Ă)
+    const auto& flow = FlowField::GetStats();
+    ImGui::Text("Flow field: %dx%d, blocked %d, reachable %d, rebuilds %d, %.3f ms in %d slices%s",
+        flow.cols, flow.rows, flow.blocked, flow.reachable, flow.rebuilds,
+        flow.buildMs, flow.slices, flow.building ? " (building)" : "");
+
+    // Xe[W̓ǂݍ(cache = <csv>.stage ʂ)
+    const auto& stage = StageCache::GetStats();
+    ImGui::Text("Stage: %dx%d, %d placements, %.3f ms%s",
+        stage.cols, stage.rows, stage.placements, stage.loadMs, stage.fromCache ? " (cache)" : " (csv)");
+
+    // ̃`Nǂݍ(resident = V[ɒuĂ錚)
+    if (WorldStreamer::IsActive())
+    {
+        const auto& stream = WorldStreamer::GetStats();
+        ImGui::Text("Stream: %d/%d chunks (%d pending), %d resident, load %d / unload %d, plan %.1f ms, model %.1f ms",
+            stream.loaded, stream.chunks, stream.pending, stream.resident, stream.loads, stream.unloads, stream.planMs, stream.modelMs);
+    }
+
+    // EN[_Ȇ҂(fired = ̃t[ɎԂ)
+    const auto& timers = TimerWheel::GetGame().GetStats();
+    ImGui::Text("Timers: %d active, fired %d, scheduled %d, cancelled %d, cascaded %d, %.3f ms",
+        timers.active, timers.fired, timers.scheduled, timers.cancelled, timers.cascaded, timers.advanceMs);
+
+    // 蔻̌ɂ܂Ƃ߂ďCxg(dropped oeʂ𑝂₷)
+    const auto& events = GameplayEvents::GetStats();
+    ImGui::Text("Events: damage %d, deaths %d, SE %d (played %d), dropped %d, %.3f ms",
+        events.damage, events.deaths, events.sounds, events.soundsPlayed, events.dropped, events.dispatchMs);
+
+    // ̃ZbVV[h(--headless --seed ɓnΓzuEɂȂ)
+    ImGui::Text("Random seed: %llu", static_cast<unsigned long long>(RandomService::GetSessionSeed()));
+
+    // eNX`̓ǂݍ(DDS = Oϊς݁AWIC = PNG/JPEG ̃fR[h)
+    const auto& tex = TextureManager::GetStats();
+    ImGui::Text("Textures: DDS %d (%.1f ms, %zu KB) / WIC %d (%.1f ms, %zu KB)",
+        tex.bakedCount, tex.bakedMs, tex.bakedBytes / 1024,
+        tex.decodedCount, tex.decodedMs, tex.decodedBytes / 1024);
+
+    // SE ̃{CX(created Ȃv[ĂȂ)
+    const auto& se = Sound::GetSeStats();
+    ImGui::Text("SE voices: %d/%d active, created %d, plays %d, steals %d, drops %d, throttled %d",
+        se.active, se.pooled, se.created, se.plays, se.steals, se.drops, se.throttled);
+
+    // SE oN(disk loads oN̏ĂY)
+    const Sound::SeBankStats bank = Sound::GetSeBankStats();
+    ImGui::Text("SE bank: %d sounds, %zu KB mapped, disk loads %d",
+        bank.sounds, bank.mappedBytes / 1024, bank.diskLoads);
+
+    // ~LT[̕(Ԃɑ΂銄)
+    const AudioMixer::Stats mix = Sound::GetMixerStats();
+    ImGui::Text("Audio mixer: %s / %s, voices %d (peak %d), load %.2f%%",
+        Sound::GetBackendName(), AudioMixKernels::GetName(mix.kernel),
+        mix.activeVoices, mix.peakVoices, mix.GetLoadPercent());
+
+    // BGM ̃Xg[~O(풓Ă̂̓OƓǂݍݗp̃obt@)
+    const BgmStream::Stats bgm = Sound::GetBgmStats();
+    if (bgm.fileBytes > 0)
+    {
+        ImGui::Text("BGM stream: %s, first audio %.1f ms, resident %zu KB (file %zu KB, PCM %zu KB), loops %d, underruns %d",
+            bgm.compressed ? "IMA-ADPCM" : "PCM", bgm.firstAudioMs, bgm.residentBytes / 1024,
+            bgm.fileBytes / 1024, bgm.pcmBytes / 1024, bgm.loops, mix.streamUnderruns);
+    }
+
+    // 풓AZbg̃(\Z𒴂ƎQƂ̖̂ÂɊO)
+    int budgetMb = static_cast<int>(ResidencyManager::GetBudget() / (1024 * 1024));
+    if (ImGui::SliderInt("Asset budget (MB)", &budgetMb, 16, 2048))
+    {
+        ResidencyManager::SetBudget(static_cast<size_t>(budgetMb) * 1024 * 1024);
+    }
+    if (ImGui::TreeNode("Resident assets"))
+    {
+        std::vector<std::string> lines;
+        ResidencyManager::GetReport(lines);
+        for (const auto& line : lines)
+        {
+            ImGui::TextUnformatted(line.c_str());
+        }
+        if (ImGui::Button("Trim now"))
+        {
+            ResidencyManager::Trim();
+        }
+        ImGui::TreePop();
+    }
+
+    // obNGh󂯎`R}h(Ot[)
+    if (RenderBackend* backend = Renderer::GetBackend())
+    {
+        const auto& bs = backend->GetStats();
+        ImGui::Text("Backend(%s): %d draws / %d tris", backend->GetName(), bs.drawCalls, bs.triangles);
+    }
+
     ImGui::End();
 
+    DebugBenchmark::DrawWindow();
+
     // fobO֐̎s
     for (auto& f : m_debugfunction)
     {
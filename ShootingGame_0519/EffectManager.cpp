@@ -3,8 +3,14 @@
 #include "TextureManager.h"
 #include "BillboardEffectComponent.h"
 #include "BulletTrailComponent.h"
+#include <d3d11.h>
 #include "renderer.h"
 
+namespace
+{
+	constexpr TexturePath BULLET_TRAIL_TEXTURE("Asset/Effect/Bullet_Trail.png");
+}
+
 std::vector<std::shared_ptr<GameObject>> EffectManager::m_effectObjects;
 
 void EffectManager::Init()
@@ -84,7 +90,7 @@ void EffectManager::SpawnBulletTrail(const DirectX::SimpleMath::Vector3& startPo
 
 
 	//z
-	auto srv = TextureManager::Load("Asset/Effect/Bullet_Trail.png");
+	auto srv = TextureManager::Load(BULLET_TRAIL_TEXTURE);
 
 	trail->SetTexture(srv);
 
@@ -4,6 +4,14 @@
 #include "HitPointCompornent.h"
 #include "PatrolComponent.h"
 #include "EffectManager.h"
+#include "GameplayEvents.h"
+
+namespace
+{
+    constexpr SoundPath BULLET_HIT_SE(L"Asset/Sound/SE/Bullet_Hit01.wav");
+    //t[ɂ܂Ƃ߂ē邱Ƃ̂ŊԈ
+    constexpr SeLimits BULLET_HIT_LIMITS{ 6, 0, 0.03f };
+}
 
 void Enemy::Initialize()
 {
@@ -55,7 +63,7 @@ void Enemy::OnCollision(GameObject* other)
         if (bulletComp->GetBulletType() == BulletComponent::BulletType::PLAYER)
         { 
 
-            Sound::PlaySeWav(L"Asset/Sound/SE/Bullet_Hit01.wav", 0.3f);
+            GameplayEvents::PushSound(BULLET_HIT_SE, 0.3f, BULLET_HIT_LIMITS);
 
             auto hp = GetComponent<HitPointComponent>();
 
@@ -64,22 +72,32 @@ void Enemy::OnCollision(GameObject* other)
             DamageInfo di;
             di.amount = 1;
             di.instigator = other;
-            di.tag = "player_bullet";
-            bool applied = hp->ApplyDamage(di);
-
-            if (hp->GetHP() <= 0)
-            {
-                OnDeath();
-
-                if (auto scene = GetScene())
-                {
-                    scene->RemoveObject(other);
-                }
-            }
+            di.source = DamageSource::PlayerBullet;
+            GameplayEvents::PushDamage(this, hp.get(), di);
+        }
+    }
+}
+
+void Enemy::OnDamageResolved(const DamageInfo& info, bool applied)
+{
+    if (info.source != DamageSource::PlayerBullet || !info.instigator) { return; }
+
+    //|ĂGɓe͏(t[ɓeS)
+    auto hp = GetComponent<HitPointComponent>();
+    if (hp && hp->GetHP() <= 0)
+    {
+        if (auto scene = GetScene())
+        {
+            scene->RemoveObject(info.instigator);
         }
     }
 }
 
+void Enemy::OnKilled(GameObject* killer)
+{
+    OnDeath();
+}
+
 void Enemy::Damage(int amount)
 {
     if (amount <= 0) { return; }
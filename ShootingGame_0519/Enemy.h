@@ -37,9 +37,13 @@ public:
     //񂾂Ƃ̏
     virtual void OnDeath();     
 
-    //Փˏ
+    //Փˏ(_[W SE  GameplayEvents ɐς)
     void OnCollision(GameObject* other) override; 
 
+    //GameplayEvents Ă΂
+    void OnDamageResolved(const DamageInfo& info, bool applied) override;
+    void OnKilled(GameObject* killer) override;
+
     //-------------------Set֐-------------------
     void SetOnDeathCallback(const std::function<void(Enemy*)>& callback);
 protected:
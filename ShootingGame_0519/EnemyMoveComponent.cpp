@@ -0,0 +1,56 @@
+#include "EnemyMoveComponent.h"
+#include "FlowField.h"
+#include "GameObject.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX::SimpleMath;
+
+void EnemyMoveComponent::Update(float dt)
+{
+    m_moving = false;
+
+    //eIuWFNgȂȂ
+    if (!GetOwner()) { return; }
+    //f^^C0菬ꍇ
+    if (dt <= 0.0f) { return; }
+
+    //̃}X̌ǂނ
+    Vector3 desired;
+    if (!FlowField::GetDirection(GetOwner()->GetPosition(), desired))
+    {
+        return;
+    }
+
+    //̌班Ȃ(}X̋ڂŃJNbƋȂȂ悤)
+    const float t = std::clamp(m_turnRate * dt, 0.0f, 1.0f);
+    Vector3 dir = Vector3::Lerp(m_currentDir, desired, t);
+    dir.y = 0.0f;
+    if (dir.LengthSquared() < 1e-6f)
+    {
+        dir = desired;
+    }
+    dir.Normalize();
+    m_currentDir = dir;
+    m_moving = true;
+
+    GetOwner()->SetPosition(GetOwner()->GetPosition() + m_currentDir * m_speed * dt);
+
+    if (m_faceMovement)
+    {
+        Vector3 rot = GetOwner()->GetRotation();
+        rot.y = std::atan2(m_currentDir.x, m_currentDir.z);
+        GetOwner()->SetRotation(rot);
+    }
+}
+
+void EnemyMoveComponent::SetVelocity(const Vector3& velocity)
+{
+    //oőxς͌p
+    Vector3 flat(velocity.x, 0.0f, velocity.z);
+    if (flat.LengthSquared() > 1e-6f)
+    {
+        flat.Normalize();
+        m_currentDir = flat;
+    }
+}
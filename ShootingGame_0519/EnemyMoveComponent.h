@@ -1 +1,40 @@
 #pragma once
+#include "Component.h"
+#include "IMovable.h"
+#include <SimpleMath.h>
+
+using namespace DirectX::SimpleMath;
+
+/// <summary>
+/// FlowField ̌ǂŃvC[ǂړR|[lgB
+/// 
+/// oHT FlowField vC[̃}X1񂾂ŝŁA
+/// ̂Ă1̂̌vZ̓}X̌1ǂނB
+/// Ȃ(Obh̊OEsȂ}X)͂̏ŌۂB
+/// </summary>
+class EnemyMoveComponent : public Component, public IMovable
+{
+public:
+	EnemyMoveComponent() = default;
+	~EnemyMoveComponent() override = default;
+
+	void Update(float dt) override;
+
+	//-------------Set֐--------------
+	void SetSpeed(float s) { m_speed = s; }                       //ړx̃Zbg
+	void SetTurnRate(float r) { m_turnRate = r; }                 //Ȃ鑬
+	void SetFaceMovement(bool face) { m_faceMovement = face; }    //isǂ
+
+	void SetVelocity(const DirectX::SimpleMath::Vector3& velocity) override;
+
+	//-------------Get֐--------------
+	DirectX::SimpleMath::Vector3 GetVelocity() const override { return m_moving ? m_currentDir * m_speed : Vector3::Zero; }
+
+private:
+	float m_speed = 30.0f;						//ړx
+	float m_turnRate = 6.0f;					//Ȃ鑬il傫قǋȂ₷j
+	bool m_faceMovement = true;					//isĂ邩ǂbool
+	bool m_moving = false;						//̃t[ɓǂ
+
+	Vector3 m_currentDir = Vector3(0.0f, 0.0f, 1.0f);		//݂̈ړxNg
+};
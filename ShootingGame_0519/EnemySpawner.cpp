@@ -14,7 +14,7 @@
 
 EnemySpawner::EnemySpawner(GameScene* scene)
     : m_scene(scene),
-    m_randomEngine(std::random_device{}())
+    m_randomEngine(RandomService::CreateSystemStream(RandomService::RANDOM_SYSTEM_ENEMY_SPAWN))
 {
     patrolCfg.waypoints =
     {
@@ -22,11 +22,111 @@ EnemySpawner::EnemySpawner(GameScene* scene)
     };
 }
 
-static int GetRandomIndex(std::mt19937& engine, int maxValue)
+static int GetRandomIndex(RandomStream& engine, int maxValue)
 {
-    if (maxValue <= 0) { return 0; }
-    std::uniform_int_distribution<int> dist(0, maxValue - 1);
-    return dist(engine);
+    return engine.RangeInt(0, maxValue);
+}
+
+/// <summary>
+/// EFC|Cg̃Zbg񃋁[gɏĂi{̓[vA͔񃋁[vj
+/// </summary>
+PatrolRoute EnemySpawner::BakePatrolRoute(
+    const std::vector<DirectX::SimpleMath::Vector3>& waypoints,
+    const std::vector<BranchPointConfig>& branchPoints)
+{
+    PatrolRoute route;
+    route.main = PatrolPath::Create(waypoints, true);
+    if (!route.main)
+    {
+        return route;
+    }
+
+    for (const auto& bp : branchPoints)
+    {
+        if (bp.mainIndex < 0)
+        {
+            continue;
+        }
+
+        if (static_cast<size_t>(bp.mainIndex) >= waypoints.size())
+        {
+            continue;
+        }
+
+        PatrolRoute::BranchPoint baked;
+        baked.mainIndex = static_cast<size_t>(bp.mainIndex);
+
+        // ő3ibp.options 3ȓɂĂzj
+        for (const auto& opt : bp.options)
+        {
+            if (opt.loopWaypoints.empty())
+            {
+                continue;
+            }
+
+            PatrolRoute::BranchOption option;
+            option.weight = opt.weight > 0.0f ? opt.weight : 1.0f;
+            option.route = RouteDecisionComponent::BakeBranchRoute(waypoints[baked.mainIndex], opt.loopWaypoints);
+            if (option.route)
+            {
+                baked.options.push_back(option);
+            }
+        }
+
+        route.branchPoints.push_back(std::move(baked));
+    }
+
+    return route;
+}
+
+const PatrolRoute& EnemySpawner::GetPatrolRoute(int setIndex)
+{
+    if (m_patrolRoutes.size() != patrolWaypointSets.size())
+    {
+        m_patrolRoutes.clear();
+        m_patrolRoutes.resize(patrolWaypointSets.size());
+    }
+
+    PatrolRoute& route = m_patrolRoutes[setIndex];
+    if (!route.main)
+    {
+        static const std::vector<BranchPointConfig> noBranchPoints;
+        const auto& branchPoints = setIndex < static_cast<int>(patrolBranchPointSets.size())
+            ? patrolBranchPointSets[setIndex] : noBranchPoints;
+
+        route = BakePatrolRoute(patrolWaypointSets[setIndex], branchPoints);
+    }
+
+    return route;
+}
+
+/// <summary>
+/// G̏ER|[lgɃ[gݒ肷inhnŃRs[͂Ȃj
+/// </summary>
+void EnemySpawner::ApplyPatrolRoute(GameObject* enemy, const PatrolRoute& route)
+{
+    auto routeDecision = enemy->GetComponent<RouteDecisionComponent>();
+    if (!routeDecision)
+    {
+        if (auto patrol = enemy->GetComponent<PatrolComponent>())
+        {
+            patrol->SetPath(route.main);
+        }
+        return;
+    }
+
+    // {ւƕ_̂ŁǍœo^
+    routeDecision->SetMainPath(route.main);
+
+    for (const auto& bp : route.branchPoints)
+    {
+        routeDecision->AddBranchPoint(bp.mainIndex);
+
+        for (const auto& opt : bp.options)
+        {
+            routeDecision->AddBranchOption(opt.route, opt.weight);
+        }
+    }
 }
 
 
@@ -38,6 +138,7 @@ static int GetRandomIndex(std::mt19937& engine, int maxValue)
 /// <returns></returns>
 std::shared_ptr<GameObject> EnemySpawner::SpawnPatrolEnemy(
     const PatrolConfig& cfg, 
+    const PatrolRoute& route,
     const DirectX::SimpleMath::Vector3& pos)
 {
     //Enemy𐶐Aݒs
@@ -58,14 +159,11 @@ std::shared_ptr<GameObject> EnemySpawner::SpawnPatrolEnemy(
     //f̐ݒsAComponentt
     auto model = std::make_shared<ModelComponent>();
     model->LoadModel("Asset/Model/Enemy/EnemyFighterjet.obj");
+    model->SetInstanced(true);
     enemy->AddComponent(model);
 
     //--------------PatrolComponent------------------
     auto patrol = std::make_shared<PatrolComponent>();
-    if (!cfg.waypoints.empty())
-    {
-        patrol->SetWaypoints(cfg.waypoints);
-    }
     patrol->SetSpeed(cfg.speed);
     patrol->SetArrivalThreshold(cfg.arrival);
     patrol->SetPingPong(cfg.pingPong);
@@ -73,7 +171,6 @@ std::shared_ptr<GameObject> EnemySpawner::SpawnPatrolEnemy(
     //XvCp̐ݒǉ
     patrol->SetUseSpline(true);
     patrol->SetSplineTension(5.0f);
-    patrol->SetLoop(true);
     patrol->SetFaceMovement(true);
 
     //R|[lgǉ(G̓)
@@ -82,48 +179,13 @@ std::shared_ptr<GameObject> EnemySpawner::SpawnPatrolEnemy(
     //--------------RouteDecisionComponentiǉj------------------
     auto routeDecision = std::make_shared<RouteDecisionComponent>();
     routeDecision->SetPatrol(patrol.get());
-    routeDecision->SetMainWaypoints(cfg.waypoints);
     routeDecision->SetArrivalThreshold(cfg.arrival);
     routeDecision->SetBranchCooldown(0.25f); // D݂
-
-    // _o^
-    if (!cfg.branchPoints.empty())
-    {
-        for (const auto& bp : cfg.branchPoints)
-        {
-            if (bp.mainIndex < 0)
-            {
-                continue;
-            }
-
-            if (static_cast<size_t>(bp.mainIndex) >= cfg.waypoints.size())
-            {
-                continue;
-            }
-
-            routeDecision->AddBranchPoint(static_cast<size_t>(bp.mainIndex));
-
-            // ő3ibp.options 3ȓɂĂzj
-            for (const auto& opt : bp.options)
-            {
-                if (opt.loopWaypoints.empty())
-                {
-                    continue;
-                }
-
-                float w = opt.weight;
-                if (w <= 0.0f)
-                {
-                    w = 1.0f;
-                }
-
-                routeDecision->AddBranchOption(opt.loopWaypoints, w);
-            }
-        }
-    }
-
     enemy->AddComponent(routeDecision);
 
+    // [gi{ƕ_jݒ
+    ApplyPatrolRoute(enemy.get(), route);
+
     //HPݒ
     auto hp = std::make_shared<HitPointComponent>(1.0f);
     hp->SetInvincibilityOnHit(0.0f);
@@ -162,6 +224,7 @@ std::shared_ptr<GameObject> EnemySpawner::SpawnCircleEnemy(const CircleConfig& c
     //f̐ݒsAComponentt
     auto model = std::make_shared<ModelComponent>();
     model->LoadModel("Asset/Model/Enemy/EnemyFighterjet.obj");
+    model->SetInstanced(true);
     enemy->AddComponent(model);
 
     //蔻̐ݒsAComponentt
@@ -203,6 +266,7 @@ std::shared_ptr<GameObject> EnemySpawner::SpawnTurretEnemy(const TurretConfig& c
     //f̐ݒsAComponentt
     auto model = std::make_shared<ModelComponent>();
     model->LoadModel("Asset/Model/Enemy/EnemyFighterjet.obj");
+    model->SetInstanced(true);
     enemy->AddComponent(model);
 
     //蔻̐ݒsAComponentt
@@ -215,6 +279,7 @@ std::shared_ptr<GameObject> EnemySpawner::SpawnTurretEnemy(const TurretConfig& c
     turt->SetCooldown(turretCfg.coolTime);
     turt->SetBulletSpeed(turretCfg.bulletSpeed);
     turt->SetTarget(turretCfg.target);
+    turt->SetHomingVolley(turretCfg.homingVolley);
     enemy->AddComponent(turt);
 
     //HPݒ
@@ -266,25 +331,13 @@ void EnemySpawner::EnsurePatrolCount()
         for (int i = 0; i < spawnNeedCount; ++i)
         {
             int routeSetIndex = GetRandomIndex(m_randomEngine, static_cast<int>(patrolWaypointSets.size()));
-            const auto& selectedWaypoints = patrolWaypointSets[routeSetIndex];
+            const PatrolRoute& route = GetPatrolRoute(routeSetIndex);
 
-            if (selectedWaypoints.empty()){ continue; }
-
-            PatrolConfig localCfg = patrolCfg;
-            localCfg.waypoints = selectedWaypoints;
-
-            if (routeSetIndex < static_cast<int>(patrolBranchPointSets.size()))
-            {
-                localCfg.branchPoints = patrolBranchPointSets[routeSetIndex];
-            }
-            else
-            {
-                localCfg.branchPoints.clear();
-            }
+            if (!route.main){ continue; }
 
-            DirectX::SimpleMath::Vector3 spawnPos = selectedWaypoints.front();
+            DirectX::SimpleMath::Vector3 spawnPos = route.main->GetWaypoint(0);
 
-            auto e = AcquirePatrolEnemy(localCfg, spawnPos);
+            auto e = AcquirePatrolEnemy(patrolCfg, route, spawnPos);
             if (e)
             {
                 m_spawnedPatrols.push_back(e);
@@ -445,6 +498,9 @@ void EnemySpawner::EnsureCircleCount()
 
 void EnemySpawner::ApplyPatrolSettingsToAll()
 {
+    // S[gɂȂ̂1񂾂ĂċL
+    const PatrolRoute route = BakePatrolRoute(patrolCfg.waypoints, {});
+
     for (auto& w : m_spawnedPatrols)
     {
         //ptrĂ
@@ -455,7 +511,10 @@ void EnemySpawner::ApplyPatrolSettingsToAll()
             if (patrol)
             {
                 //猻iKł̐ݒ
-                patrol->SetWaypoints(patrolCfg.waypoints);
+                if (route.main)
+                {
+                    ApplyPatrolRoute(sp.get(), route);
+                }
                 patrol->SetSpeed(patrolCfg.speed);
                 patrol->SetArrivalThreshold(patrolCfg.arrival);
                 patrol->SetPingPong(patrolCfg.pingPong);
@@ -498,6 +557,7 @@ void EnemySpawner::ApplyTurretSettingsToAll()
             {
                 turt->SetCooldown(turretCfg.coolTime);
                 turt->SetBulletSpeed(turretCfg.bulletSpeed);
+                turt->SetHomingVolley(turretCfg.homingVolley);
             }
         }
     }
@@ -532,16 +592,13 @@ void EnemySpawner::DestroyAll()
 
 void EnemySpawner::PrewarmPatrolEnemies(int count)
 {
+    // oɃ[gݒ肵̂ŁAł͍ŏ̃ZbgɎĂ
+    const PatrolRoute defaultRoute = patrolWaypointSets.empty()
+        ? BakePatrolRoute(patrolCfg.waypoints, {}) : GetPatrolRoute(0);
+
     for (int i = 0; i < count; ++i)
     {
-        PatrolConfig localCfg = patrolCfg;
-
-        if (!patrolWaypointSets.empty())
-        {
-            localCfg.waypoints = patrolWaypointSets[0];
-        }
-
-        auto enemy = SpawnPatrolEnemy(localCfg, { 0.0f, -10000.0f, 0.0f });
+        auto enemy = SpawnPatrolEnemy(patrolCfg, defaultRoute, { 0.0f, -10000.0f, 0.0f });
 
         if (!enemy)
         {
@@ -555,6 +612,7 @@ void EnemySpawner::PrewarmPatrolEnemies(int count)
 
 std::shared_ptr<GameObject> EnemySpawner::AcquirePatrolEnemy(
     const PatrolConfig& cfg,
+    const PatrolRoute& route,
     const DirectX::SimpleMath::Vector3& pos)
 {
     for (auto& enemyObj : m_patrolEnemyPool)
@@ -584,13 +642,14 @@ std::shared_ptr<GameObject> EnemySpawner::AcquirePatrolEnemy(
             hp->SetMaxHP(1.0f);
         }
 
+        //OɑĂ[gƕ̏Ԃ͎̂Ă
+        ApplyPatrolRoute(enemyObj.get(), route);
+
         if (auto patrol = enemyObj->GetComponent<PatrolComponent>())
         {
-            patrol->SetWaypoints(cfg.waypoints);
             patrol->SetSpeed(cfg.speed);
             patrol->SetArrivalThreshold(cfg.arrival);
             patrol->SetPingPong(cfg.pingPong);
-            patrol->Reset();
         }
 
         if (auto col = enemyObj->GetComponent<SphereColliderComponent>())
@@ -601,7 +660,7 @@ std::shared_ptr<GameObject> EnemySpawner::AcquirePatrolEnemy(
         return enemyObj;
     }
 
-    auto newEnemy = SpawnPatrolEnemy(cfg, pos);
+    auto newEnemy = SpawnPatrolEnemy(cfg, route, pos);
 
     if (newEnemy)
     {
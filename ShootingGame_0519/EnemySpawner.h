@@ -1,10 +1,11 @@
 #pragma once
 #include <vector>
 #include <memory>
-#include <random>
+#include "RandomService.h"
 #include <SimpleMath.h>
 #include <functional>
 #include "GameObject.h"
+#include "PatrolPath.h"
 
 class EnemyAIComponent;
 class Enemy;
@@ -29,7 +30,25 @@ struct PatrolConfig
 	float arrival = 0.5f;
 	bool pingPong = true;
 	std::vector<DirectX::SimpleMath::Vector3> waypoints;
-	std::vector<BranchPointConfig> branchPoints;
+};
+
+//Ă񃋁[giEFC|Cg̃ZbgƂ1񂾂ĂAZbg̓GŋLj
+struct PatrolRoute
+{
+	struct BranchOption
+	{
+		float weight = 1.0f;
+		PatrolPathHandle route;
+	};
+
+	struct BranchPoint
+	{
+		size_t mainIndex = 0;
+		std::vector<BranchOption> options;
+	};
+
+	PatrolPathHandle main;
+	std::vector<BranchPoint> branchPoints;
 };
 
 struct CircleConfig
@@ -47,6 +66,7 @@ struct TurretConfig
 	int spawnCount = 3;
 	float coolTime = 1.0f;
 	float bulletSpeed = 15.0;
+	int homingVolley = 0;		//1Ɍǔe̐(0 Ȃ畁ʂ̒e)
 	DirectX::SimpleMath::Vector3 pos = { 0,0,0 };
 	std::weak_ptr<GameObject> target;
 };
@@ -80,7 +100,8 @@ public:
 
 	void SetWaypoints(std::vector<DirectX::SimpleMath::Vector3> waypoint)
 	{
-		patrolWaypointSets.push_back(waypoint);
+		patrolWaypointSets.push_back(std::move(waypoint));
+		m_patrolRoutes.clear();
 	}
 
 	void SetRadius(float radius)
@@ -101,6 +122,7 @@ public:
 	void SetBranchPoints(const std::vector<BranchPointConfig>& branchPoints)
 	{
 		patrolBranchPointSets.push_back(branchPoints);
+		m_patrolRoutes.clear();
 	}
 
 	//-------------Set֐--------------
@@ -109,7 +131,7 @@ private:
 	GameScene* m_scene;
 
 	// GW
-	std::mt19937 m_randomEngine;
+	RandomStream m_randomEngine;
 
 	//PatrolEnemÿړԒn_̔z
 	std::vector<std::vector<DirectX::SimpleMath::Vector3>> patrolWaypointSets;
@@ -132,14 +154,21 @@ private:
 	//--------------PatrolEnemyv[֘A------------------
 	std::vector<std::shared_ptr<GameObject>> m_patrolEnemyPool;
 
+	//Ă[gipatrolWaypointSets ƓсBŏɎgɏĂj
+	std::vector<PatrolRoute> m_patrolRoutes;
+
+	const PatrolRoute& GetPatrolRoute(int setIndex);
+	static PatrolRoute BakePatrolRoute(const std::vector<DirectX::SimpleMath::Vector3>& waypoints, const std::vector<BranchPointConfig>& branchPoints);
+	static void ApplyPatrolRoute(GameObject* enemy, const PatrolRoute& route);
+
 	//EnemyFactory֐
-	std::shared_ptr<GameObject> SpawnPatrolEnemy(const PatrolConfig& cfg, const DirectX::SimpleMath::Vector3& pos);
+	std::shared_ptr<GameObject> SpawnPatrolEnemy(const PatrolConfig& cfg, const PatrolRoute& route, const DirectX::SimpleMath::Vector3& pos);
 	std::shared_ptr<GameObject> SpawnCircleEnemy(const CircleConfig& cfg, const DirectX::SimpleMath::Vector3& pos);
 	std::shared_ptr<GameObject> SpawnTurretEnemy(const TurretConfig& cfg, const DirectX::SimpleMath::Vector3& pos);
 
 	std::vector<std::vector<BranchPointConfig>> patrolBranchPointSets;
 
-	std::shared_ptr<GameObject> AcquirePatrolEnemy(const PatrolConfig& cfg, const DirectX::SimpleMath::Vector3& pos);
+	std::shared_ptr<GameObject> AcquirePatrolEnemy(const PatrolConfig& cfg, const PatrolRoute& route, const DirectX::SimpleMath::Vector3& pos);
 
 	//--------------Gjʒm֘A------------------
 	std::function<void(Enemy*)> m_onPatrolEnemyDefeated;
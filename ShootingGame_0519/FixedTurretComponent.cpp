@@ -1,17 +1,35 @@
 #include "FixedTurretComponent.h"
 #include "SceneManager.h"
 #include "Bullet.h"
+#include "HomingComponent.h"
 #include <iostream>
 
 void FixedTurretComponent::Initialize()
 {
-    m_timer = 0.0f;
+    m_ready = false;
+    m_cooldownTimer.Stop();
+}
+
+void FixedTurretComponent::StartCooldown()
+{
+    m_ready = false;
+    m_cooldownTimer.Start(m_cooldown, [this]() { m_ready = true; });
 }
 
 void FixedTurretComponent::Update(float dt)
 {
     if (!GetOwner()) { return; }
 
+    //EĂȂC͐t[1(N[_E͊ԈɊ֌WȂԒʂɏI)
+    AiScheduler::Slice slice(m_aiAgent, GetOwner(), dt);
+    if (!slice) { return; }
+
+    //ŏ̍XVN[_E𐔂n߂
+    if (!m_ready && !m_cooldownTimer.IsActive())
+    {
+        StartCooldown();
+    }
+
     //^[Qbg݂ȂꍇPlayer擾
     if (auto sp = m_target.lock())
     {
@@ -32,12 +50,18 @@ void FixedTurretComponent::Update(float dt)
         }
 
 		
-        // ˌ^C}[
-        m_timer += dt;
-        if (m_timer >= m_cooldown)
+        // N[_EIĂΌ
+        if (m_ready)
         {
-            Shoot(toTarget);
-            m_timer = 0.0f;
+            if (m_homingVolley > 0)
+            {
+                ShootHomingVolley(toTarget);
+            }
+            else
+            {
+                Shoot(toTarget);
+            }
+            StartCooldown();
         }
     }
 }
@@ -74,3 +98,56 @@ void FixedTurretComponent::Shoot(const Vector3& dir)
         scene->AddObject(bullet);
     }
 }
+
+void FixedTurretComponent::ShootHomingVolley(const Vector3& dir)
+{
+    auto owner = GetOwner();
+    if (!owner) { return; }
+
+    Vector3 forward = dir;
+    if (forward.LengthSquared() > 1e-8f)
+    {
+        forward.Normalize();
+    }
+    else
+    {
+        forward = Vector3(0, 0, 1);     //tH[obN
+    }
+
+    //˕ɐ2(ɂ΂炯)
+    Vector3 right = Vector3::Up.Cross(forward);
+    if (right.LengthSquared() < 1e-6f)
+    {
+        right = Vector3::Right;
+    }
+    right.Normalize();
+    Vector3 up = forward.Cross(right);
+
+    for (int i = 0; i < m_homingVolley; ++i)
+    {
+        auto bullet = std::make_shared<Bullet>();
+        bullet->SetPosition(owner->GetPosition() + Vector3(0, 3.0f, 0));
+
+        auto bc = bullet->AddComponent<BulletComponent>();
+        bc->SetVelocity(forward);
+        bc->SetSpeed(m_bulletSpeed);
+        bc->SetLifetime(5.0f);
+        bc->SetBulletType(BulletComponent::ENEMY);
+
+        //pŉ񂵂āAĎˌ̒edȂȂ悤ɂ
+        const float angle = static_cast<float>(i) * 2.39996323f;
+        auto homing = bullet->AddComponent<HomingComponent>();
+        homing->SetTarget(m_target);
+        homing->SetLifeTime(5.0f);
+        homing->SetAimBias(right * std::cos(angle) + up * std::sin(angle));
+        homing->SetAimBiasStrength(0.6f);
+        homing->SetAimBiasDecay(0.5f);
+
+        bullet->Initialize();
+
+        if (auto scene = owner->GetScene())
+        {
+            scene->AddObject(bullet);
+        }
+    }
+}
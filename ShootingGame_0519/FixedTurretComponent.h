@@ -3,6 +3,8 @@
 #include "IScene.h"
 #include "GameObject.h"
 #include "BulletComponent.h"
+#include "AiScheduler.h"
+#include "TimerWheel.h"
 #include <SimpleMath.h>
 #include <memory>
 
@@ -21,12 +23,19 @@ public:
     void SetTarget(std::weak_ptr<GameObject> t) { m_target = t; }
     void SetCooldown(float cd) { m_cooldown = cd; }
     void SetBulletSpeed(float sp) { m_bulletSpeed = sp; }
+    void SetHomingVolley(int count) { m_homingVolley = count < 0 ? 0 : count; }   // 0 Ȃ畁ʂ̒e
 
 private:
     std::weak_ptr<GameObject> m_target;
     float m_cooldown = 1.0f;   // ˊԊu
-    float m_timer = 0.0f;
+    bool m_ready = false;      // N[_EIČĂ
+    TimerWheel::Timer m_cooldownTimer;  // I m_ready 𗧂Ă
     float m_bulletSpeed = 50.0f;
+    int m_homingVolley = 0;    // 1Ɍǔe̐
 
+    AiScheduler::Agent m_aiAgent;   //͑_𐔃t[1񂾂t
+
+    void StartCooldown();
     void Shoot(const Vector3& dir);
+    void ShootHomingVolley(const Vector3& dir);
 };
@@ -1,5 +1,6 @@
 #include "FloorComponent.h"
 #include "GameObject.h"
+#include <d3d11.h>
 #include "Renderer.h"
 #include "TextureManager.h"
 #include "DebugRenderer.h"
@@ -16,7 +17,8 @@ void FloorComponent::Initialize()
 
     auto device = Renderer::GetDevice();
 
-    if (!device) 
+    //wbhXsł͒_ECfbNX̔z񂾂
+    if (!device && !Renderer::IsHeadless())
     {
         OutputDebugStringA("FloorComponent::Initialize - Renderer::GetDevice() == nullptr\n");
         return;
@@ -66,7 +68,7 @@ void FloorComponent::Draw(float alpha)
     //eNX`oCh
     if (m_gridSRV)
     {
-        Renderer::SetTexture(m_gridSRV);
+        Renderer::SetTexture(m_gridSRV.Get());
     }
     else
     {
@@ -78,6 +80,5 @@ void FloorComponent::Draw(float alpha)
     m_prim.Draw(Renderer::GetDeviceContext());
 
     //PSSRVĂƈS
-    ID3D11ShaderResourceView* nullSrv[1] = { nullptr };
-    Renderer::GetDeviceContext()->PSSetShaderResources(0, 1, nullSrv);
+    Renderer::SetTexture(nullptr);
 }
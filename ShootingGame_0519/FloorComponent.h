@@ -4,6 +4,7 @@
 #include "AABBColliderComponent.h"
 #include "TextureManager.h"
 #include "CollisionManager.h"
+#include <d3d11.h>
 #include "renderer.h"
 #include <SimpleMath.h>
 #include <wrl/client.h>
@@ -60,7 +61,7 @@ private:
     std::string m_texture;
     float m_tileU = 1.0f;
     float m_tileV = 1.0f;
-    ID3D11ShaderResourceView* m_gridSRV = nullptr;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_gridSRV;
 
     Primitive m_prim;           //NX
     std::shared_ptr<AABBColliderComponent> m_collider; // LGameObjectvectorɂ邪֋Xێ
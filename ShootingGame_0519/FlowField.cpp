@@ -0,0 +1,470 @@
+#define NOMINMAX
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <windows.h>
+#include "FlowField.h"
+
+using namespace DirectX::SimpleMath;
+
+namespace
+{
+    constexpr uint32_t COST_INFINITE = 0xffffffffu;
+
+    //̂̏d(΂߂ 2  1.4)
+    constexpr uint32_t COST_STRAIGHT = 10;
+    constexpr uint32_t COST_DIAGONAL = 14;
+    constexpr uint32_t BUCKET_COUNT = COST_DIAGONAL + 1;
+
+    //1 Update ōL}X̏l(FreeStage01 炢Ȃ1ŏI)
+    constexpr int DEFAULT_CELL_BUDGET = 16384;
+
+    //8ߖT(ŏ4㉺E)
+    constexpr int NEIGHBOR_ROW[8] = { -1, 1, 0, 0, -1, -1, 1, 1 };
+    constexpr int NEIGHBOR_COL[8] = { 0, 0, -1, 1, -1, 1, -1, 1 };
+
+    inline bool IsBlockedValue(int value)
+    {
+        //1ԁE2Ԃ̊
+        return value == 1 || value == 2;
+    }
+}
+
+std::vector<uint8_t> FlowField::m_blocked;
+int FlowField::m_rows = 0;
+int FlowField::m_cols = 0;
+int FlowField::m_centerRow = 0;
+int FlowField::m_centerCol = 0;
+float FlowField::m_cellSize = 1.0f;
+float FlowField::m_invCellSize = 1.0f;
+
+FlowField::Field FlowField::m_front;
+FlowField::Field FlowField::m_back;
+
+std::vector<uint32_t> FlowField::m_buckets[15];
+uint32_t FlowField::m_sweepCost = 0;
+size_t FlowField::m_queued = 0;
+bool FlowField::m_building = false;
+int FlowField::m_buildSlices = 0;
+double FlowField::m_buildMs = 0.0;
+
+int FlowField::m_cellBudget = DEFAULT_CELL_BUDGET;
+FlowField::Stats FlowField::m_stats;
+
+static_assert(BUCKET_COUNT == 15, "m_buckets ̐ӂ̏dɍ킹");
+
+bool FlowField::Init(const StageGrid& grid, float cellSize)
+{
+    Uninit();
+
+    if (grid.IsEmpty() || cellSize <= 0.0f)
+    {
+        OutputDebugStringA("[FlowField] empty grid\n");
+        return false;
+    }
+
+    m_rows = grid.rows;
+    m_cols = grid.cols;
+
+    //GameScene ̔zu(StageCache)Ɠ^񒆂̃}X_ɂ
+    m_centerRow = m_rows / 2;
+    m_centerCol = m_cols / 2;
+    m_cellSize = cellSize;
+    m_invCellSize = 1.0f / cellSize;
+
+    //т͓sDȂ̂ł̂܂܎ʂ
+    const size_t cellCount = static_cast<size_t>(m_rows) * m_cols;
+    m_blocked.assign(cellCount, 0);
+
+    int blocked = 0;
+    for (size_t i = 0; i < cellCount; ++i)
+    {
+        if (IsBlockedValue(grid.cells[i]))
+        {
+            m_blocked[i] = 1;
+            ++blocked;
+        }
+    }
+
+    //gݒŊmۂȂ悤ɎĂ
+    for (Field* field : { &m_front, &m_back })
+    {
+        field->cost.assign(cellCount, COST_INFINITE);
+        field->dirX.assign(cellCount, 0.0f);
+        field->dirZ.assign(cellCount, 0.0f);
+        field->targetCell = -1;
+        field->ready = false;
+    }
+
+    m_stats.rows = m_rows;
+    m_stats.cols = m_cols;
+    m_stats.blocked = blocked;
+
+    return true;
+}
+
+void FlowField::Uninit()
+{
+    m_blocked.clear();
+    m_rows = 0;
+    m_cols = 0;
+
+    m_front = Field();
+    m_back = Field();
+
+    for (auto& bucket : m_buckets)
+    {
+        bucket.clear();
+    }
+    m_queued = 0;
+    m_building = false;
+
+    m_stats = Stats();
+}
+
+int FlowField::ToCell(const Vector3& pos)
+{
+    //}X̐^񒆂}X̍WȂ̂Ŏľܓ
+    const int col = static_cast<int>(std::floor(pos.x * m_invCellSize + 0.5f)) + m_centerCol;
+    const int row = static_cast<int>(std::floor(pos.z * m_invCellSize + 0.5f)) + m_centerRow;
+
+    if (row < 0 || row >= m_rows || col < 0 || col >= m_cols)
+    {
+        return -1;
+    }
+    return row * m_cols + col;
+}
+
+void FlowField::Update(const Vector3& targetPos)
+{
+    if (m_blocked.empty())
+    {
+        return;
+    }
+
+    //Obh̊Oɂ鎞͈ԋ߂[̃}Xڎw
+    Vector3 clamped = targetPos;
+    const float minX = static_cast<float>(-m_centerCol) * m_cellSize;
+    const float minZ = static_cast<float>(-m_centerRow) * m_cellSize;
+    clamped.x = std::clamp(clamped.x, minX, minX + static_cast<float>(m_cols - 1) * m_cellSize);
+    clamped.z = std::clamp(clamped.z, minZ, minZ + static_cast<float>(m_rows - 1) * m_cellSize);
+
+    const int cell = ToCell(clamped);
+
+    //}X̒Ȃ͂̂܂(ڕW̃}X̒͒ڌ̂ňʒu͍XV)
+    m_front.targetPos = targetPos;
+
+    const int buildingFor = m_building ? m_back.targetCell : m_front.targetCell;
+    if (cell != buildingFor)
+    {
+        BeginBuild(cell, targetPos);
+    }
+    m_back.targetPos = targetPos;
+
+    if (!m_building)
+    {
+        return;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    const bool done = StepBuild(m_cellBudget);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    m_buildMs += std::chrono::duration<double, std::milli>(end - start).count();
+    ++m_buildSlices;
+
+    if (done)
+    {
+        //gݏオǂޑɂ(z͓ւ邾)
+        std::swap(m_front, m_back);
+        m_building = false;
+
+        m_stats.rebuilds++;
+        m_stats.slices = m_buildSlices;
+        m_stats.buildMs = static_cast<float>(m_buildMs);
+    }
+
+    m_stats.building = m_building;
+}
+
+void FlowField::BeginBuild(int targetCell, const Vector3& targetPos)
+{
+    std::fill(m_back.cost.begin(), m_back.cost.end(), COST_INFINITE);
+    m_back.targetCell = targetCell;
+    m_back.targetPos = targetPos;
+    m_back.ready = false;
+
+    for (auto& bucket : m_buckets)
+    {
+        bucket.clear();
+    }
+
+    //ڕW̃}X̒łA͊O֍L
+    m_back.cost[targetCell] = 0;
+    m_buckets[0].push_back(static_cast<uint32_t>(targetCell));
+    m_sweepCost = 0;
+    m_queued = 1;
+
+    m_building = true;
+    m_buildSlices = 0;
+    m_buildMs = 0.0;
+}
+
+bool FlowField::StepBuild(int budget)
+{
+    //d 10  14 ̐Ȃ̂ŁÂ % 15 ̃oPcɉ(Dial ̕@)
+    //q[vg킸 Dijkstra ƓԂŊm肵Ă
+    uint32_t* cost = m_back.cost.data();
+    const uint8_t* blocked = m_blocked.data();
+
+    int processed = 0;
+    while (m_queued > 0)
+    {
+        if (budget > 0 && processed >= budget)
+        {
+            return false;
+        }
+
+        std::vector<uint32_t>& bucket = m_buckets[m_sweepCost % BUCKET_COUNT];
+        if (bucket.empty())
+        {
+            ++m_sweepCost;
+            continue;
+        }
+
+        const uint32_t cell = bucket.back();
+        bucket.pop_back();
+        --m_queued;
+
+        //ƒZŊmς
+        if (cost[cell] != m_sweepCost)
+        {
+            continue;
+        }
+        ++processed;
+
+        const int row = static_cast<int>(cell) / m_cols;
+        const int col = static_cast<int>(cell) % m_cols;
+
+        for (int n = 0; n < 8; ++n)
+        {
+            const int nr = row + NEIGHBOR_ROW[n];
+            const int nc = col + NEIGHBOR_COL[n];
+            if (nr < 0 || nr >= m_rows || nc < 0 || nc >= m_cols)
+            {
+                continue;
+            }
+
+            const size_t next = static_cast<size_t>(nr) * m_cols + nc;
+            if (blocked[next])
+            {
+                continue;
+            }
+
+            uint32_t weight = COST_STRAIGHT;
+            if (n >= 4)
+            {
+                //΂߂͗e󂢂Ă鎞(̊p؂Ȃ)
+                if (blocked[static_cast<size_t>(row) * m_cols + nc] || blocked[static_cast<size_t>(nr) * m_cols + col])
+                {
+                    continue;
+                }
+                weight = COST_DIAGONAL;
+            }
+
+            const uint32_t nextCost = m_sweepCost + weight;
+            if (nextCost < cost[next])
+            {
+                cost[next] = nextCost;
+                m_buckets[nextCost % BUCKET_COUNT].push_back(static_cast<uint32_t>(next));
+                ++m_queued;
+            }
+        }
+    }
+
+    BuildDirections(m_back);
+    m_back.ready = true;
+    return true;
+}
+
+void FlowField::BuildDirections(Field& field)
+{
+    const uint32_t* cost = field.cost.data();
+    const uint8_t* blocked = m_blocked.data();
+
+    int reachable = 0;
+
+    for (int row = 0; row < m_rows; ++row)
+    {
+        for (int col = 0; col < m_cols; ++col)
+        {
+            const size_t cell = static_cast<size_t>(row) * m_cols + col;
+            const bool inRock = blocked[cell] != 0;
+
+            //̒(oꂽȂ)͋󂢂Ăׂ֏o
+            uint32_t best = inRock ? COST_INFINITE : cost[cell];
+            int bestRow = 0;
+            int bestCol = 0;
+
+            if (!inRock && best != COST_INFINITE)
+            {
+                ++reachable;
+            }
+
+            for (int n = 0; n < 8; ++n)
+            {
+                const int nr = row + NEIGHBOR_ROW[n];
+                const int nc = col + NEIGHBOR_COL[n];
+                if (nr < 0 || nr >= m_rows || nc < 0 || nc >= m_cols)
+                {
+                    continue;
+                }
+
+                const size_t next = static_cast<size_t>(nr) * m_cols + nc;
+                if (cost[next] >= best)
+                {
+                    continue;
+                }
+
+                //LƓp͐؂Ȃ
+                if (n >= 4 && !inRock &&
+                    (blocked[static_cast<size_t>(row) * m_cols + nc] || blocked[static_cast<size_t>(nr) * m_cols + col]))
+                {
+                    continue;
+                }
+
+                best = cost[next];
+                bestRow = NEIGHBOR_ROW[n];
+                bestCol = NEIGHBOR_COL[n];
+            }
+
+            //ڕW̃}XƍsȂ}X 0(GetDirection Ō)
+            float dx = static_cast<float>(bestCol);
+            float dz = static_cast<float>(bestRow);
+            if (bestRow != 0 && bestCol != 0)
+            {
+                dx *= 0.70710678f;
+                dz *= 0.70710678f;
+            }
+            field.dirX[cell] = dx;
+            field.dirZ[cell] = dz;
+        }
+    }
+
+    m_stats.reachable = reachable;
+}
+
+bool FlowField::GetDirection(const Vector3& worldPos, Vector3& outDir)
+{
+    const Field& field = m_front;
+    if (!field.ready)
+    {
+        return false;
+    }
+
+    const int cell = ToCell(worldPos);
+    if (cell < 0)
+    {
+        return false;
+    }
+
+    //ڕWƓ}XȂ璼ڌ
+    if (cell == field.targetCell)
+    {
+        Vector3 toTarget = field.targetPos - worldPos;
+        toTarget.y = 0.0f;
+        if (toTarget.LengthSquared() < 1e-6f)
+        {
+            return false;
+        }
+        toTarget.Normalize();
+        outDir = toTarget;
+        return true;
+    }
+
+    const float dx = field.dirX[cell];
+    const float dz = field.dirZ[cell];
+    if (dx == 0.0f && dz == 0.0f)
+    {
+        return false;
+    }
+
+    outDir = Vector3(dx, 0.0f, dz);
+    return true;
+}
+
+void FlowField::RunBuildBenchmark(std::vector<std::string>& outLines)
+{
+    //Xe[W̏󂳂Ȃ悤ޔĂ
+    std::vector<uint8_t> blocked = m_blocked;
+    const int rows = m_rows;
+    const int cols = m_cols;
+    const int centerRow = m_centerRow;
+    const int centerCol = m_centerCol;
+    const float cellSize = m_cellSize;
+    Field front = m_front;
+    Field back = m_back;
+    const bool building = m_building;
+    const Stats stats = m_stats;
+
+    const int sizes[] = { 32, 64, 128, 256, 512 };
+    const int iterations = 8;
+    char buf[256];
+
+    //FreeStage01 Ɠ炢̊̊
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+
+    for (int size : sizes)
+    {
+        StageGrid grid;
+        grid.rows = size;
+        grid.cols = size;
+        grid.cells.resize(static_cast<size_t>(size) * size);
+        for (int& value : grid.cells)
+        {
+            value = dist(rng) < 0.15f ? 1 : 0;
+        }
+
+        Init(grid, 45.0f);
+
+        //vC[}X1ڂĂ̑gݒ
+        double totalMs = 0.0;
+        for (int i = 0; i < iterations; ++i)
+        {
+            const Vector3 target(static_cast<float>(i) * 45.0f, 0.0f, static_cast<float>(i) * 45.0f);
+
+            auto start = std::chrono::high_resolution_clock::now();
+            BeginBuild(ToCell(target), target);
+            StepBuild(0);
+            auto end = std::chrono::high_resolution_clock::now();
+
+            totalMs += std::chrono::duration<double, std::milli>(end - start).count();
+        }
+
+        const double ms = totalMs / iterations;
+        const double cells = static_cast<double>(size) * size;
+        sprintf_s(buf, "  %3dx%-3d : %.3f ms / build (%.1f ns per cell), reachable %d",
+            size, size, ms, ms * 1.0e6 / cells, m_stats.reachable);
+        outLines.push_back(buf);
+    }
+
+    m_blocked = std::move(blocked);
+    m_rows = rows;
+    m_cols = cols;
+    m_centerRow = centerRow;
+    m_centerCol = centerCol;
+    m_cellSize = cellSize;
+    m_invCellSize = 1.0f / cellSize;
+    m_front = std::move(front);
+    m_back = std::move(back);
+    m_building = false;
+    m_stats = stats;
+
+    //gݒ̓rȂŏ蒼
+    if (building && m_back.targetCell >= 0)
+    {
+        BeginBuild(m_back.targetCell, m_back.targetPos);
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <SimpleMath.h>
+#include "CsvGridLoader.h"
+
+//---------------------------------------------------------
+// Xe[W̃Obh(CsvGridLoader Ɠ CSV)̏ɒ闬
+// 1E2 ̊̃}XǂƂāAvC[̂}X Dijkstra 
+// S}Xւ̓̂LAe}XɁû肪kޕvĂ
+// ǂG͎̃}X̕ǂނȂ̂ŉ̂Ă O(1)
+// vC[}XڂƂgݒAgݒ1t[
+// L}X߂Đt[ɕ(̊Ԃ͑Ȍǂ)
+//---------------------------------------------------------
+class FlowField
+{
+public:
+    struct Stats
+    {
+        int rows = 0;
+        int cols = 0;
+        int blocked = 0;        //̃}X
+        int reachable = 0;      //vC[܂ōs}X
+        int rebuilds = 0;       //gݒI
+        int slices = 0;         //߂̑gݒɂ Update ̉
+        float buildMs = 0.0f;   //߂̑gݒ̍v
+        bool building = false;  //gݒ̓r
+    };
+
+    //cellSize  GameScene ̔zuƓ(Es̐^񒆂̃}X_)
+    static bool Init(const StageGrid& grid, float cellSize);
+    static void Uninit();
+
+    //t[ǂ鑊̈ʒuŌĂ(}Xςgݒ)
+    static void Update(const DirectX::SimpleMath::Vector3& targetPos);
+
+    //worldPos ̃}Xiނׂ(XZAKς)
+    //Obh̊OE܂ōsȂ}XEꂪ܂ false
+    static bool GetDirection(const DirectX::SimpleMath::Vector3& worldPos, DirectX::SimpleMath::Vector3& outDir);
+
+    //--------Set֐-------
+    //1 Update ōL}X(0 Ȃgݒ1ŏI点)
+    static void SetCellBudget(int cells) { m_cellBudget = cells < 0 ? 0 : cells; }
+
+    //--------Get֐-------
+    static bool IsReady() { return m_front.ready; }
+    static int GetCellBudget() { return m_cellBudget; }
+    static const Stats& GetStats() { return m_stats; }
+
+    //32x32 ` 512x512 ̃Obhőgݒ̎Ԃ𑪂(DebugBenchmark ɓo^)
+    static void RunBuildBenchmark(std::vector<std::string>& outLines);
+
+private:
+    //}X̓̂ƌ
+    struct Field
+    {
+        std::vector<uint32_t> cost;     //i 10A΂ 14 ̐̓̂
+        std::vector<float> dirX;
+        std::vector<float> dirZ;
+        int targetCell = -1;
+        DirectX::SimpleMath::Vector3 targetPos;
+        bool ready = false;
+    };
+
+    static void BeginBuild(int targetCell, const DirectX::SimpleMath::Vector3& targetPos);
+    static bool StepBuild(int budget);      //I true
+    static void BuildDirections(Field& field);
+
+    static int ToCell(const DirectX::SimpleMath::Vector3& pos);
+
+    //--------------Obh------------------
+    static std::vector<uint8_t> m_blocked;
+    static int m_rows;
+    static int m_cols;
+    static int m_centerRow;
+    static int m_centerCol;
+    static float m_cellSize;
+    static float m_invCellSize;
+
+    //--------------(ǂނ̂ frontAgݒ̂ back)------------------
+    static Field m_front;
+    static Field m_back;
+
+    //--------------gݒ̓ȑ------------------
+    static std::vector<uint32_t> m_buckets[15];     //̂ % 15 Ƃ̑҂s(ӂ̏d͍ő 14)
+    static uint32_t m_sweepCost;
+    static size_t m_queued;
+    static bool m_building;
+    static int m_buildSlices;
+    static double m_buildMs;
+
+    static int m_cellBudget;
+    static Stats m_stats;
+};
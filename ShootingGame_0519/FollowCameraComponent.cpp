@@ -1,6 +1,7 @@
 ﻿#define NOMINMAX
 #include <cmath> 
 #include "FollowCameraComponent.h"
+#include <d3d11.h>
 #include "Renderer.h"
 #include "Application.h"
 #include "Input.h"
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include "FreeCamera.h"
 #include "Application.h"
+#include <d3d11.h>
 #include "renderer.h"
 
 using namespace DirectX;
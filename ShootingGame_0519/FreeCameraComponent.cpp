@@ -2,6 +2,7 @@
 #include "FreeCameraComponent.h"
 #include "Application.h"
 #include "Input.h"
+#include <d3d11.h>
 #include "Renderer.h"
 #include <algorithm>
 #include <iostream>
@@ -1,5 +1,6 @@
 #include <chrono>
 #include "Game.h"
+#include <d3d11.h>
 #include "renderer.h"
 #include "SceneManager.h"
 #include "Application.h"
@@ -7,12 +8,41 @@
 #include "TransitionManager.h"
 #include "DebugUI.h"
 #include "EffectManager.h"
+#include "InstancedRenderer.h"
+#include "RenderQueue.h"
+#include "MeshLod.h"
+#include "WorkerPool.h"
+#include "DebugBenchmark.h"
+#include "ModelCache.h"
+#include "TextureManager.h"
+#include "ResidencyManager.h"
+#include "AudioMixer.h"
+#include "PatrolSteering.h"
+#include "HomingSwarm.h"
+#include "FlowField.h"
+#include "AiScheduler.h"
+#include "RandomService.h"
+#include "StageCache.h"
+#include "WorldStreamer.h"
+#include "IniFile.h"
+#include "PlacementGrid.h"
+#include "TimerWheel.h"
+#include "GameplayEvents.h"
+#include "TextureCompressor.h"
+#include "InstanceBatcher.h"
 
 void Game::GameInit()
 {
     //Application::HideCursorAndClip(); 
 
+    //シードはデバッグ出力に出る(同じ値を HeadlessRunner に渡せば再現できる)
+    RandomService::Init();
+
+    WorkerPool::Init();
+
     Renderer::Init();
+
+    InstancedRenderer::Init();
     
     Sound::Init();
 
@@ -20,9 +50,30 @@ void Game::GameInit()
 
     EffectManager::Init();
 
+    //予算を超えたら参照の無いアセットを古い順に外す
+    ResidencyManager::RegisterCache(RESIDENT_TEXTURE, TextureManager::GatherResident, TextureManager::Evict);
+    ResidencyManager::RegisterCache(RESIDENT_MODEL, ModelCache::GatherResident, ModelCache::Evict);
+    ResidencyManager::RegisterCache(RESIDENT_SOUND, Sound::GatherResidentSe, Sound::EvictSe);
+
     SceneManager::Init();
 
     DebugUI::Init(Renderer::GetDevice(), Renderer::GetDeviceContext());
+
+    DebugBenchmark::Register("DrawList build", RenderQueue::RunBuildBenchmark);
+    DebugBenchmark::Register("Texture load (WIC vs DDS)", TextureManager::RunLoadBenchmark);
+    DebugBenchmark::Register("Audio mix", AudioMixer::RunMixBenchmark);
+    DebugBenchmark::Register("Patrol steering (10 - 10000 enemies)", PatrolSteering::RunSteeringBenchmark);
+    DebugBenchmark::Register("Homing swarm (100 - 10000 missiles)", HomingSwarm::RunSwarmBenchmark);
+    DebugBenchmark::Register("Flow field build (32 - 512 grid)", FlowField::RunBuildBenchmark);
+    DebugBenchmark::Register("Random (mt19937 vs PCG32)", RandomService::RunRandomBenchmark);
+    DebugBenchmark::Register("Stage load (9x13 - 4096x4096)", StageCache::RunStageBenchmark);
+    DebugBenchmark::Register("World streaming (128 - 512)", WorldStreamer::RunStreamingBenchmark);
+    DebugBenchmark::Register("INI (GetPrivateProfile vs parsed)", IniFile::RunIniBenchmark);
+    DebugBenchmark::Register("Placement (100k props)", PlacementGrid::RunPlacementBenchmark);
+    DebugBenchmark::Register("Timers (polling vs wheel)", TimerWheel::RunTimerBenchmark);
+    DebugBenchmark::Register("Gameplay events (immediate vs queued)", GameplayEvents::RunEventBenchmark);
+    DebugBenchmark::Register("Self-check: texture compressor (PSNR)", [](std::vector<std::string>& lines) { TextureCompressor::RunSelfCheck(lines); });
+    DebugBenchmark::Register("Self-check: instance batcher", [](std::vector<std::string>& lines) { InstanceBatcher::RunSelfCheck(lines); });
 }
 
 void Game::GameUninit()
@@ -31,21 +82,48 @@ void Game::GameUninit()
 
     SceneManager::Uninit();
 
+    PatrolSteering::Clear();
+    HomingSwarm::Clear();
+    TimerWheel::GetGame().Clear();
+    GameplayEvents::Clear();
+
     EffectManager::Uninit();
 
     TransitionManager::Uninit();
 
     Sound::Uninit();
 
+    RenderQueue::Clear();
+
+    ModelCache::Clear();
+
+    TextureManager::Clear();
+
+    ResidencyManager::Clear();
+
+    InstancedRenderer::Uninit();
+
     Renderer::Uninit();
+
+    DebugBenchmark::Clear();
+
+    WorkerPool::Uninit();
 }
 
 void Game::GameUpdate(float deltaTime)
 {
     Sound::Update(deltaTime);
 
+    //寿命・クールダウンは時間が来たものだけここで呼ぶ(オブジェクトの Update より先)
+    TimerWheel::GetGame().Advance(deltaTime);
+
     SceneManager::Update(deltaTime);
 
+    //シーン側で Flush していない巡回の敵・追尾弾があればここで動かす
+    PatrolSteering::Flush();
+    HomingSwarm::Flush(deltaTime);
+    AiScheduler::EndFrame();
+
 	EffectManager::Update(deltaTime);
 
     TransitionManager::Update(deltaTime);
@@ -57,6 +135,10 @@ void Game::GameDraw(float deltaTime)
 
     SceneManager::DrawWorld(deltaTime);
 
+    //シーン側で描き切れていないインスタンス・パケットがあればここで描く
+    InstancedRenderer::Flush();
+    RenderQueue::Flush();
+
     EffectManager::Draw3D(deltaTime);
 
     Renderer::ApplyMotionBlur();
@@ -65,5 +147,10 @@ void Game::GameDraw(float deltaTime)
 
     TransitionManager::Draw(deltaTime);
 
+    InstancedRenderer::EndFrame();
+    RenderQueue::EndFrame();
+    MeshLod::EndFrame();
+    ResidencyManager::EndFrame();
+
     Renderer::End();
 }
\ No newline at end of file
@@ -7,7 +7,8 @@
 #include "CameraObject.h"
 #include "ModelComponent.h"
 #include "FloorComponent.h"
-#include "CsvGridLoader.h"
+#include "StageCache.h"
+#include <d3d11.h>
 #include "renderer.h"
 
 void GameForwardScene::Init()
@@ -63,51 +64,43 @@ void GameForwardScene::Init()
         }
     }
 
-    auto grid = CsvGridLoader::LoadGrid("Data/ForwardStage01.csv");
+    // ͒As͎O z = 0
+    StageLayout layout;
+    layout.cellSize = 10.0f;
+    layout.baseY = 0.0f;
+    layout.centerRows = false;
 
-    float cellSize = 10.0f;
-
-    int rowCount = grid.size();
-    int colCount = grid[0].size();
-
-    // ɂ
-    int centerCol = colCount / 2;
-
-    for (int row = 0; row < rowCount; ++row)
+    StageData stage;
+    if (!StageCache::Load("Data/ForwardStage01.csv", layout, stage))
     {
-        for (int col = 0; col < colCount; ++col)
-        {
-            int value = grid[row][col];
+        return;
+    }
 
-            float x = (col - centerCol) * cellSize;
-            float z = row * cellSize;
-            float y = 0.0f;
+    for (const auto& pos : stage.GetPlacements(1))
+    {
+        auto tree = std::make_shared<GameObject>();
 
-            if (value == 1)
-            {
-                auto tree = std::make_shared<GameObject>();
+        auto model = tree->AddComponent<ModelComponent>();
+        model->LoadModel("Asset/Build/tree_0817053737_refine.obj");
 
-                auto model = tree->AddComponent<ModelComponent>();
-                model->LoadModel("Asset/Build/tree_0817053737_refine.obj");
+        tree->SetPosition(pos);
+        tree->SetScale({ 10.0, 10.0, 10.0 });
 
-                tree->SetPosition({ x, y, z });
-                tree->SetScale({ 10.0, 10.0, 10.0 });
+        AddObject(tree);
+    }
 
-                AddObject(tree);
-            }
-            else if (value == 2)
-            {
-                /*auto enemy = std::make_shared<GameObject>();
+    //2 ͓G̗\n(܂uȂ)
+    /*for (const auto& pos : stage.GetPlacements(2))
+    {
+        auto enemy = std::make_shared<GameObject>();
 
-                auto model = enemy->AddComponent<ModelComponent>();
-                model->LoadModel("Asset/Model/Enemy/enemy.obj");
+        auto model = enemy->AddComponent<ModelComponent>();
+        model->LoadModel("Asset/Model/Enemy/enemy.obj");
 
-                enemy->SetPosition({ x, y, z });*/
+        enemy->SetPosition(pos);
 
-                //AddObject(enemy);
-            }
-        }
-    }
+        AddObject(enemy);
+    }*/
 }
 
 void GameForwardScene::Update(float deltatime)
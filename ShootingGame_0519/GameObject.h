@@ -8,6 +8,7 @@
 #include "IScene.h"
 
 class Component;
+struct DamageInfo;
 
 class GameObject
 {
@@ -61,6 +62,10 @@ public:
     //Փ˒ʒm
     virtual void OnCollision(GameObject* other) {}
 
+    //蔻̌ GameplayEvents ܂Ƃ߂ČĂ
+    virtual void OnDamageResolved(const DamageInfo& info, bool applied) {}    //applied = GȂǂŒeꂸ HP 
+    virtual void OnKilled(GameObject* killer) {}                              //̃t[̃_[W HP  0 ɂȂ
+
     template<typename T>
     std::shared_ptr<T> GetComponent() const
     {
@@ -1,7 +1,9 @@
 ﻿#include <iostream>
+#include <algorithm>
 
 #include "GameScene.h"
 #include "Input.h"
+#include <d3d11.h>
 #include "renderer.h"
 #include "Application.h"
 
@@ -14,6 +16,14 @@
 #include "HPBar.h"
 #include "Building.h"
 #include "PatrolComponent.h"
+#include "PatrolSteering.h"
+#include "HomingSwarm.h"
+#include "FlowField.h"
+#include "WorldStreamer.h"
+#include "TimerWheel.h"
+#include "GameplayEvents.h"
+#include "AiScheduler.h"
+#include "RandomService.h"
 #include "CircularPatrolComponent.h"
 #include "FloorComponent.h"
 #include "PlayAreaComponent.h"
@@ -26,30 +36,18 @@
 #include "TextureManager.h"
 #include "Sound.h"
 
-#include "CsvGridLoader.h"
+#include "StageCache.h"
+#include "InstancedRenderer.h"
+#include "RenderQueue.h"
 
-/// <summary>
-/// ファイルが存在しているかどうかを探す関数
-/// </summary>
-/// <param name="path">ファイルパス</param>
-/// <returns></returns>
-static bool IsFileExists(const std::string& path)
+namespace
 {
-    DWORD attr = GetFileAttributesA(path.c_str());
-
-    //ファイルが存在しないか、ディレクトリだった場合は失敗
-    if (attr == INVALID_FILE_ATTRIBUTES)
-    {
-        return false;
-    }
+    constexpr SoundPath COUNTDOWN_SE(L"Asset/Sound/SE/Countdown_SE.wav");
+    //聞き逃すと困るので他の SE から横取りしてでも鳴らす
+    constexpr SeLimits COUNTDOWN_LIMITS{ 1, 3, 0.0f };
 
-    //ファイルがディレクトリだった場合は失敗
-    if (attr & FILE_ATTRIBUTE_DIRECTORY)
-    {
-        return false;
-    }
-
-    return true;
+    //設定ファイルの更新日時を見る間隔(秒)
+    constexpr float INI_POLL_INTERVAL = 0.5f;
 }
 
 /// <summary>
@@ -57,12 +55,13 @@ static bool IsFileExists(const std::string& path)
 /// </summary>
 bool GameScene::LoadPlayerConfigFromIni()
 {
-    if (!IsFileExists(m_iniPath))
+    //ファイルは1回だけ読み、14キーはメモリの表から引く
+    if (!m_ini.Load(m_iniPath))
     {
         return false;
     }
 
-    IniFile ini(m_iniPath.c_str());
+    const IniFile& ini = m_ini;
 
     //読み込み
     m_playerMoveSpeed = ini.ReadFloat("Player", "MoveSpeed", m_playerMoveSpeed);
@@ -87,6 +86,46 @@ bool GameScene::LoadPlayerConfigFromIni()
     return true;
 }
 
+void GameScene::ApplyPlayerConfig(bool resetHp)
+{
+    if (m_player)
+    {
+        if (auto moveComp = m_player->GetComponent<MoveComponent>())
+        {
+            moveComp->SetSpeed(m_playerMoveSpeed);
+            moveComp->SetBoostMultiplier(m_playerBoostMultiplier);
+        }
+
+        if (auto shootComp = m_player->GetComponent<ShootingComponent>())
+        {
+            shootComp->SetBulletSpeed(m_playerBulletSpeed);
+        }
+
+        //SetMaxHP は今の HP も戻すので、最大HPを変えた時だけ
+        if (resetHp)
+        {
+            if (auto hpComp = m_player->GetComponent<HitPointComponent>())
+            {
+                hpComp->SetMaxHP(m_playerHp);
+            }
+        }
+    }
+
+    if (m_FollowCamera)
+    {
+        if (auto followCom = m_FollowCamera->GetComponent<FollowCameraComponent>())
+        {
+            followCom->SetFov(m_cameraFovDeg);
+            followCom->SetBoostFov(m_cameraBoostFovDeg);
+            followCom->SetSensitivity(m_cameraSensitivity);
+            followCom->SetDistance(m_cameraDistance);
+            followCom->SetHeight(m_cameraHeight);
+        }
+    }
+
+    InitializeEffect();
+}
+
 void GameScene::DebugCollisionMode()
 {
     static int selected = 1;
@@ -132,6 +171,9 @@ void GameScene::InitializeDebug()
     //DebugUI::RedistDebugFunction([this]() {DebugSetAimDistance(); });
 	//DebugUI::RedistDebugFunction([this]() {DebugMotionBlur(); });
 
+    //ヘッドレス実行ではデバッグ線は描かない
+    if (Renderer::IsHeadless()) { return; }
+
     //DebugRendererの初期化
     m_debugRenderer = std::make_unique<DebugRenderer>();
     m_debugRenderer->Initialize(Renderer::GetDevice(), 
@@ -157,6 +199,7 @@ void GameScene::InitializePhase()
 {
     m_gameState = GameState::Countdown;
     m_countdownRemaining = 4.0f;
+    m_countdownTimer.Stop();
 }
 
 /// <summary>
@@ -361,43 +404,21 @@ void GameScene::InitializeStageObject()
     m_buildingSpawner = std::make_unique<BuildingSpawner>(this);
 
     //-----------------------
-    // CSVから建物配置を読み込み
+    // CSVから建物配置を読み込み(2回目からは Data/FreeStage01.csv.stage を使う)
     //-----------------------
-    auto grid = CsvGridLoader::LoadGrid("Data/FreeStage01.csv");
+    StageLayout layout;
+    layout.cellSize = 45.0f;
+    layout.baseY = -12.0f;
+    layout.centerRows = true;
 
-    if (!grid.empty())
+    StageData stage;
+    if (StageCache::Load("Data/FreeStage01.csv", layout, stage))
     {
-        float cellSize = 45.0f;
-
-        int rowCount = static_cast<int>(grid.size());
-        int colCount = static_cast<int>(grid[0].size());
-
-        int centerCol = colCount / 2;
-        int centerRow = rowCount / 2;
-
-        std::vector<Vector3> type1Positions;
-        std::vector<Vector3> type2Positions;
-
-        for (int row = 0; row < rowCount; row++)
-        {
-            for (int col = 0; col < static_cast<int>(grid[row].size()); col++)
-            {
-                int value = grid[row][col];
-
-                float x = static_cast<float>(col - centerCol) * cellSize;
-                float y = -12.0f;
-                float z = static_cast<float>(row - centerRow) * cellSize;
+        //岩のマスを壁にして追いかける敵の経路を引く
+        FlowField::Init(stage.grid, layout.cellSize);
 
-                if (value == 1)
-                {
-                    type1Positions.push_back(Vector3(x, y, z));
-                }
-                else if (value == 2)
-                {
-                    type2Positions.push_back(Vector3(x, y, z));
-                }
-            }
-        }
+        const std::vector<Vector3>& type1Positions = stage.GetPlacements(1);
+        const std::vector<Vector3>& type2Positions = stage.GetPlacements(2);
 
         //-----------------------
         // 1番の岩
@@ -405,7 +426,6 @@ void GameScene::InitializeStageObject()
         BuildingConfig bc1;
         bc1.modelPath = "Asset/Build/rock_0817055319_refine.obj";
         bc1.count = static_cast<int>(type1Positions.size());
-        bc1.fixedPositions = type1Positions;
         bc1.spacing = 30.0f;
 
         bc1.scaleX = 60.0f;
@@ -415,15 +435,12 @@ void GameScene::InitializeStageObject()
         bc1.baseColliderSize = { 1.0f, 1.0f, 1.0f };
         bc1.maxAttemptsPerBuilding = 50;
 
-        m_buildingSpawner->Spawn(bc1);
-
         //-----------------------
         // 2番の岩 大きめ
         //-----------------------
         BuildingConfig bc2;
         bc2.modelPath = "Asset/Build/rock02/rock_0817054342_refine.obj";
         bc2.count = static_cast<int>(type2Positions.size());
-        bc2.fixedPositions = type2Positions;
         bc2.spacing = 40.0f;
 
         bc2.scaleX = 80.0f;
@@ -433,9 +450,19 @@ void GameScene::InitializeStageObject()
         bc2.baseColliderSize = { 1.0f, 1.0f, 1.0f };
         bc2.maxAttemptsPerBuilding = 50;
 
-        m_buildingSpawner->Spawn(bc2);
-
+        //-----------------------
+        // プレイヤーの周りのチャンクだけ置く(置き場所は WorldStreamer がステージから埋める)
+        //-----------------------
+        WorldStreamer::Settings streamSettings;
+        streamSettings.chunkCells = 8;
+        streamSettings.loadRadius = 600.0f;
+        streamSettings.unloadRadius = 750.0f;
+        streamSettings.spawnBudget = 64;
 
+        if (WorldStreamer::Init(m_buildingSpawner.get(), stage, { { 1, bc1 }, { 2, bc2 } }, streamSettings))
+        {
+            WorldStreamer::LoadAround(m_player ? m_player->GetPosition() : Vector3::Zero);
+        }
     }
 
     //------------------スカイドーム作成-------------------------
@@ -529,10 +556,10 @@ void GameScene::InitializeUI()
     m_miniMap->SetRotateWithPlayer(true);
     m_miniMap->SetIconSize(10.0f);
 
-    m_miniMap->SetBackgroundSRV(m_miniMapBgSRV);
-    m_miniMap->SetPlayerIconSRV(m_miniMapPlayerSRV);
-    m_miniMap->SetEnemyIconSRV(m_miniMapEnemySRV);
-    m_miniMap->SetBuildingIconSRV(m_miniMapBuildingSRV);
+    m_miniMap->SetBackgroundSRV(m_miniMapBgSRV.Get());
+    m_miniMap->SetPlayerIconSRV(m_miniMapPlayerSRV.Get());
+    m_miniMap->SetEnemyIconSRV(m_miniMapEnemySRV.Get());
+    m_miniMap->SetBuildingIconSRV(m_miniMapBuildingSRV.Get());
 
     m_miniMap->SetPlayer(m_player.get()); // m_playerがshared_ptr<GameObject>想定
 
@@ -602,6 +629,9 @@ void GameScene::InitializeWingTrail()
 
 void GameScene::Init()
 {    
+    //敵ごとの乱数の列を作る順番を数え直す(同じシードなら毎回同じステージになる)
+    RandomService::ResetEntities();
+
     LoadPlayerConfigFromIni();
     //デバッグ初期化
 	InitializeDebug();
@@ -635,33 +665,54 @@ void GameScene::Init()
     }
 
     // 例: Renderer::Init() の後
-    DebugRenderer::Get().Initialize(Renderer::GetDevice(), Renderer::GetDeviceContext());
+    if (!Renderer::IsHeadless())
+    {
+        DebugRenderer::Get().Initialize(Renderer::GetDevice(), Renderer::GetDeviceContext());
+    }
 }
 
 void GameScene::Update(float deltatime)
 {
     DebugGameDateSet();
 
+    //設定ファイルが書き換えられたら読み直して、今のプレイヤー・カメラに反映する
+    if (m_iniHotReload)
+    {
+        m_iniPollTimer += deltatime;
+        if (m_iniPollTimer >= INI_POLL_INTERVAL)
+        {
+            m_iniPollTimer = 0.0f;
+
+            const float prevHp = m_playerHp;
+            if (m_ini.HasChanged() && LoadPlayerConfigFromIni())
+            {
+                ApplyPlayerConfig(m_playerHp != prevHp);
+                OutputDebugStringA(("[GameScene] reloaded " + m_iniPath + "\n").c_str());
+            }
+        }
+    }
+
     static float currentBlur = 0.0f;
 
     if (m_gameState == GameState::Countdown)
     {
-        if (m_countdownRemaining >= 4.0f)
+        //最初のフレームで SE を鳴らし、終わる時間を予約する
+        if (!m_countdownTimer.IsActive())
         {
-            Sound::PlaySeWav(L"Asset/Sound/SE/Countdown_SE.wav", 0.3f);
+            Sound::PlaySeWav(COUNTDOWN_SE, 0.3f, COUNTDOWN_LIMITS);
+
+            m_countdownTimer.Start(m_countdownRemaining, [this]()
+                {
+                    m_gameState = GameState::Playing;
+                    m_countdownRemaining = 0.0f;
+                    Sound::PlayBgmWav(L"Asset/Sound/BGM/StageBGM.wav", 0.1f);
+                });
         }
 
-        m_countdownRemaining -= deltatime;
+        m_countdownRemaining = m_countdownTimer.GetRemaining();
 
         m_FollowCamera->Update(deltatime);
         m_SkyDome->Update(deltatime);
-
-        if (m_countdownRemaining <= 0.0f)
-        {
-            m_gameState = GameState::Playing;
-            m_countdownRemaining = 0.0f;
-            Sound::PlayBgmWav(L"Asset/Sound/BGM/StageBGM.wav", 0.1f);
-        }
     }
 
     if (m_gameState == GameState::Playing)
@@ -745,6 +796,18 @@ void GameScene::Update(float deltatime)
             }
         }
 
+        //追いかける敵の流れ場(プレイヤーがマスを移った時だけ組み直す)
+        FlowField::Update(m_player->GetPosition());
+
+        //プレイヤーの周りのチャンクを読み込み、遠いチャンクを外す
+        WorldStreamer::Update(m_player->GetPosition());
+
+        //敵のAIの更新頻度をプレイヤーからの距離と画面に映っているかで決める
+        if (auto camera = m_FollowCamera->GetCameraComponent())
+        {
+            AiScheduler::SetFocus(m_player->GetPosition(), camera->GetView() * camera->GetProj());
+        }
+
         //----------------- 既存オブジェクト更新 -----------------
         for (auto& obj : m_GameObjects)
         {
@@ -755,6 +818,12 @@ void GameScene::Update(float deltatime)
             obj->Update(deltatime);
         }
 
+        //巡回する敵のステアリングをまとめて計算(当たり判定の前に位置を確定させる)
+        PatrolSteering::Flush();
+
+        //追尾弾の迎撃計算も狙う相手ごとにまとめて行う
+        HomingSwarm::Flush(deltatime);
+
         for (auto& obj : m_TextureObjects)
         {
             if (!obj){ continue; }
@@ -781,6 +850,9 @@ void GameScene::Update(float deltatime)
         //----------------- 当たり判定 -----------------
         CollisionManager::CheckCollisions();
 
+        //当たり判定で積んだダメージ・撃破・SE をまとめて処理する
+        GameplayEvents::Dispatch();
+
         //----------------- 押し出し -----------------
         for (auto& obj : m_GameObjects)
         {
@@ -889,6 +961,12 @@ void GameScene::UpdateBuildingOcclusionFade()
     Vector3 rayDir = rayVec;
     rayDir.Normalize();
 
+    //WorldStreamer が外した建物を消す
+    m_stageBuildings.erase(
+        std::remove_if(m_stageBuildings.begin(), m_stageBuildings.end(),
+            [](const std::weak_ptr<Building>& b) { return b.expired(); }),
+        m_stageBuildings.end());
+
     for (auto& weakBuilding : m_stageBuildings)
     {
         auto building = weakBuilding.lock();
@@ -973,10 +1051,17 @@ void GameScene::DrawWorld(float deltatime)
         obj->Draw(deltatime);
     }
 
+    //建物・敵などインスタンス描画に登録されたものをまとめて描く
+    InstancedRenderer::Flush();
+
+    //それ以外の描画パケットをソートして描く
+    RenderQueue::Flush();
+
     if (m_player)
     {
         Renderer::BeginPlayerRenderTarget();
         m_player->Draw(deltatime);
+        RenderQueue::Flush();   //プレイヤー用のRTにいる間に描き切る
         Renderer::SetSceneRenderTarget();
     }
 
@@ -1096,32 +1181,25 @@ void GameScene::Uninit()
 {
     // ---------------- 外部登録の解除 ----------------
     CollisionManager::Clear();
+    FlowField::Uninit();
+
+    //建物を置く spawner より先に読み込み用スレッドを止める
+    WorldStreamer::Uninit();
+
+    //待っている寿命・クールダウンは次のシーンに持ち越さない
+    m_countdownTimer.Stop();
+    TimerWheel::GetGame().Clear();
+    GameplayEvents::Clear();
 
     // DebugUI に「登録解除」があるならここで呼ぶ
     // DebugUI::Clear();
 
-    // ---------------- SRVの解放（必要な設計の場合のみ） ----------------
-    // TextureManager が所有しているなら Release しないこと！
-   /* if (m_miniMapBgSRV)
-    {
-        m_miniMapBgSRV->Release();
-        m_miniMapBgSRV = nullptr;
-    }
-    if (m_miniMapPlayerSRV)
-    {
-        m_miniMapPlayerSRV->Release();
-        m_miniMapPlayerSRV = nullptr;
-    }
-    if (m_miniMapEnemySRV)
-    {
-        m_miniMapEnemySRV->Release();
-        m_miniMapEnemySRV = nullptr;
-    }
-    if (m_miniMapBuildingSRV)
-    {
-        m_miniMapBuildingSRV->Release();
-        m_miniMapBuildingSRV = nullptr;
-    }*/
+    // ---------------- SRVの参照を外す ----------------
+    // 実体は TextureManager が持っている。参照が無くなれば ResidencyManager が外せる
+    m_miniMapBgSRV.Reset();
+    m_miniMapPlayerSRV.Reset();
+    m_miniMapEnemySRV.Reset();
+    m_miniMapBuildingSRV.Reset();
 
     // ---------------- spawner / renderer ----------------
     if (m_enemySpawner)
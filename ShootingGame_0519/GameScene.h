@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <d3d11.h>
+#include <wrl/client.h>
 #include "IScene.h"
 #include "FreeCamera.h"
 #include "Player.h"
@@ -21,6 +22,8 @@
 #include "MiniMapComponent.h"
 #include "Building.h"
 #include "NumberTextureUI.h"
+#include "IniFile.h"
+#include "TimerWheel.h"
 
 //---------------------------------
 //IScenepGameScene
@@ -76,7 +79,8 @@ public:
 private:
 	GameState m_gameState = GameState::Countdown;
 
-	float m_countdownRemaining = 4.0f;		//JnJEg_Ep
+	float m_countdownRemaining = 4.0f;		//JnJEg_Ep(\p m_countdownTimer ̎cʂ)
+	TimerWheel::Timer m_countdownTimer;		//I Playing ɂ
 
 	float m_aimMarginX = 80.0f;   // E}[WiDȒlɕςOKj
 	float m_aimMarginY = 45.0f;   // ㉺}[W
@@ -158,10 +162,10 @@ private:
 	std::shared_ptr<GameObject> m_miniMapUi;
 	MiniMapComponent* m_miniMap = nullptr;
 
-	ID3D11ShaderResourceView* m_miniMapBgSRV = nullptr;
-	ID3D11ShaderResourceView* m_miniMapPlayerSRV = nullptr;
-	ID3D11ShaderResourceView* m_miniMapEnemySRV = nullptr;
-	ID3D11ShaderResourceView* m_miniMapBuildingSRV = nullptr;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_miniMapBgSRV;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_miniMapPlayerSRV;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_miniMapEnemySRV;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_miniMapBuildingSRV;
 
 	//--------------jUI֘A------------------
 	NumberTextureUI m_KillCountNumberUI;
@@ -185,6 +189,9 @@ private:
 	bool LoadPlayerConfigFromIni();
 	void SavePlayerConfigToIni();
 
+	//ǂݍ񂾒l̃vC[EJEu[ɔf(resetHp Ȃ HP őɂ)
+	void ApplyPlayerConfig(bool resetHp);
+
 	//------------Update֘A--------------------
 	void UpdateBuildingOcclusionFade();
 
@@ -192,6 +199,11 @@ private:
 
 	//------------ݒpt@C֘A------------------
 	std::string m_iniPath = "Data/GameSettings.ini";
+	IniFile m_ini;
+
+	//ݒt@C̏āAV[蒼ɔf
+	bool m_iniHotReload = true;
+	float m_iniPollTimer = 0.0f;
 
 	//--------------Playerݒ֘A------------------
 	float m_playerMoveSpeed = 35.0f;
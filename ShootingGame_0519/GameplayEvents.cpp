@@ -0,0 +1,216 @@
+#define NOMINMAX
+#include <windows.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include "GameplayEvents.h"
+#include "GameObject.h"
+#include "Sound.h"
+#include "RandomService.h"
+
+GameplayEvents::Queue<GameplayEvents::DamageEvent, GameplayEvents::MAX_DAMAGE_EVENTS> GameplayEvents::m_damage;
+GameplayEvents::Queue<GameplayEvents::DeathEvent, GameplayEvents::MAX_DEATH_EVENTS> GameplayEvents::m_deaths;
+GameplayEvents::Queue<GameplayEvents::SoundEvent, GameplayEvents::MAX_SOUND_EVENTS> GameplayEvents::m_sounds;
+GameplayEvents::Stats GameplayEvents::m_stats;
+
+void GameplayEvents::PushDamage(GameObject* target, HitPointComponent* hp, const DamageInfo& info)
+{
+    if (!hp) { return; }
+
+    DamageEvent e;
+    e.target = target;
+    e.hp = hp;
+    e.info = info;
+    m_damage.Push(e);
+}
+
+void GameplayEvents::PushDeath(GameObject* victim, GameObject* killer, DamageSource source)
+{
+    if (!victim) { return; }
+
+    DeathEvent e;
+    e.victim = victim;
+    e.killer = killer;
+    e.source = source;
+    m_deaths.Push(e);
+}
+
+void GameplayEvents::PushSound(const SoundPath& path, float volume, const SeLimits& limits)
+{
+    SoundEvent e;
+    e.path = &path;
+    e.volume = volume;
+    e.limits = limits;
+    m_sounds.Push(e);
+}
+
+void GameplayEvents::Dispatch()
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    //j̏_[WςނƂ̂ŁAǂcĂȂȂ܂ŉ
+    int damageDone = 0;
+    int deathDone = 0;
+    while (damageDone < m_damage.GetCount() || deathDone < m_deaths.GetCount())
+    {
+        for (; damageDone < m_damage.GetCount(); ++damageDone)
+        {
+            ResolveDamage(m_damage[damageDone]);
+        }
+
+        for (; deathDone < m_deaths.GetCount(); ++deathDone)
+        {
+            const DeathEvent& e = m_deaths[deathDone];
+            e.victim->OnKilled(e.killer);
+        }
+    }
+
+    //SE ͍Ōɂ܂Ƃ߂Ė炷
+    //Ԋu̐ SE ͓t[2ڈȍ~͂ǂȂ̂ŁAŗƂ
+    int played = 0;
+    for (int i = 0; i < m_sounds.GetCount(); ++i)
+    {
+        const SoundEvent& e = m_sounds[i];
+
+        bool duplicate = false;
+        if (e.limits.minInterval > 0.0f)
+        {
+            for (int j = 0; j < i; ++j)
+            {
+                if (m_sounds[j].path->id == e.path->id)
+                {
+                    duplicate = true;
+                    break;
+                }
+            }
+        }
+        if (duplicate) { continue; }
+
+        Sound::PlaySeWav(*e.path, e.volume, e.limits);
+        played++;
+    }
+
+    m_stats.damage = m_damage.GetCount();
+    m_stats.deaths = m_deaths.GetCount();
+    m_stats.sounds = m_sounds.GetCount();
+    m_stats.soundsPlayed = played;
+    m_stats.dropped = m_damage.GetDropped() + m_deaths.GetDropped() + m_sounds.GetDropped();
+
+    Clear();
+
+    m_stats.dispatchMs = static_cast<float>(std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count());
+}
+
+void GameplayEvents::Clear()
+{
+    m_damage.Clear();
+    m_deaths.Clear();
+    m_sounds.Clear();
+
+    m_damage.ResetDropped();
+    m_deaths.ResetDropped();
+    m_sounds.ResetDropped();
+}
+
+void GameplayEvents::ResolveDamage(const DamageEvent& e)
+{
+    const bool applied = e.hp->ApplyDamage(e.info);
+
+    if (e.target)
+    {
+        e.target->OnDamageResolved(e.info, applied);
+    }
+
+    //Ɏł ApplyDamage  false Ȃ̂ŁAj͂1ς
+    if (applied && e.hp->IsDead())
+    {
+        PushDeath(e.target, e.info.instigator, e.info.source);
+    }
+}
+
+void GameplayEvents::RunEventBenchmark(std::vector<std::string>& outLines)
+{
+    const int targets = 1000;
+    const int hits = 100000;
+    const int iterations = 10;
+    char buf[256];
+
+    outLines.push_back("Gameplay event benchmark (100000 hits on 1000 HP components, best of 10)");
+
+    //O DamageInfo(tag )
+    struct OldDamageInfo
+    {
+        int amount = 1;
+        GameObject* instigator = nullptr;
+        std::string tag;
+        bool ignoreInvincibility = false;
+    };
+
+    std::vector<std::unique_ptr<HitPointComponent>> hps;
+    hps.reserve(targets);
+    for (int i = 0; i < targets; ++i)
+    {
+        auto hp = std::make_unique<HitPointComponent>(1e9f);
+        hp->SetInvincibilityOnHit(0.0f);
+        hps.push_back(std::move(hp));
+    }
+
+    //鏇Ԃ͂΂΂(蔻̃yȀ)
+    RandomStream rng(7, 0);
+    std::vector<int> order(hits);
+    for (int& o : order)
+    {
+        o = rng.RangeInt(0, targets);
+    }
+
+    //̏ŏ : x DamageInfo  ApplyDamage
+    double immediateMs = 1e30;
+    for (int it = 0; it < iterations; ++it)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int h = 0; h < hits; ++h)
+        {
+            OldDamageInfo old;
+            old.amount = 1;
+            old.tag = "collision_building";
+
+            DamageInfo di;
+            di.amount = old.amount;
+            hps[order[h]]->ApplyDamage(di);
+        }
+        immediateMs = std::min(immediateMs, std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count());
+    }
+
+    //ςł܂Ƃ߂ď(L[ςɂȂxɗ)
+    auto queue = std::make_unique<Queue<DamageEvent, MAX_DAMAGE_EVENTS>>();
+    double queuedMs = 1e30;
+    for (int it = 0; it < iterations; ++it)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        int h = 0;
+        while (h < hits)
+        {
+            for (; h < hits && queue->GetCount() < MAX_DAMAGE_EVENTS; ++h)
+            {
+                DamageEvent e;
+                e.hp = hps[order[h]].get();
+                e.info.amount = 1;
+                e.info.source = DamageSource::BuildingCollision;
+                queue->Push(e);
+            }
+
+            for (int i = 0; i < queue->GetCount(); ++i)
+            {
+                ResolveDamage((*queue)[i]);
+            }
+            queue->Clear();
+        }
+        queuedMs = std::min(queuedMs, std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count());
+    }
+
+    sprintf_s(buf, "  immediate (string tag) %.3f ms, queued %.3f ms (%.1fx), event %zu bytes",
+        immediateMs, queuedMs, queuedMs > 0.0 ? immediateMs / queuedMs : 0.0, sizeof(DamageEvent));
+    outLines.push_back(buf);
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "AssetId.h"
+#include "SeVoicePool.h"
+#include "HitPointCompornent.h"
+
+class GameObject;
+
+//---------------------------------------------------------
+// 蔻ŋN(_[WEjESE)𒙂߂āǍɂ܂Ƃ߂ďL[
+// OnCollision ͎ނƂ̌Œ蒷̔zɃRs[Đςނɂ(new )
+// Dispatch ͎ނƂɏɏ : _[W  j  SE
+// (_[W HP  0 ɂȂΌjς݁Aj̏Ŗ炷 SE  Dispatch Ŗ)
+// IuWFNg̍폜̓t[̍ŌȂ̂ŁAς񂾃|C^ Dispatch ܂ŗL
+//---------------------------------------------------------
+class GameplayEvents
+{
+public:
+    //HP 炷(hp  target  HitPointComponentBςޑŒTĂ)
+    struct DamageEvent
+    {
+        GameObject* target = nullptr;
+        HitPointComponent* hp = nullptr;
+        DamageInfo info;
+    };
+
+    //̃t[̃_[W HP  0 ɂȂ(XRA Enemy ̌jʒm琔)
+    struct DeathEvent
+    {
+        GameObject* victim = nullptr;
+        GameObject* killer = nullptr;
+        DamageSource source = DamageSource::Unknown;
+    };
+
+    //SE 炷(path  constexpr  SoundPath w)
+    struct SoundEvent
+    {
+        const SoundPath* path = nullptr;
+        float volume = 1.0f;
+        SeLimits limits;
+    };
+
+    //---------------------------------------------------------
+    // Œ蒷̐ςނ̔z(ςȂ̂ĂĐ)
+    //---------------------------------------------------------
+    template<typename T, int CAPACITY>
+    class Queue
+    {
+    public:
+        bool Push(const T& e)
+        {
+            if (m_count >= CAPACITY)
+            {
+                m_dropped++;
+                return false;
+            }
+            m_items[m_count++] = e;
+            return true;
+        }
+
+        void Clear() { m_count = 0; }
+
+        int GetCount() const { return m_count; }
+        int GetDropped() const { return m_dropped; }
+        void ResetDropped() { m_dropped = 0; }
+        const T& operator[](int index) const { return m_items[index]; }
+
+    private:
+        T m_items[CAPACITY];
+        int m_count = 0;
+        int m_dropped = 0;
+    };
+
+    static constexpr int MAX_DAMAGE_EVENTS = 1024;
+    static constexpr int MAX_DEATH_EVENTS = 256;
+    static constexpr int MAX_SOUND_EVENTS = 128;
+
+    //߂ Dispatch ̓v
+    struct Stats
+    {
+        int damage = 0;
+        int deaths = 0;
+        int sounds = 0;         //ς܂ꂽ
+        int soundsPlayed = 0;   //t[̏dĖ炵
+        int dropped = 0;        //ςŎ̂Ă(0 łȂΗeʂ𑝂₷)
+        float dispatchMs = 0.0f;
+    };
+
+    //--------ς(OnCollision Ă)-------
+    static void PushDamage(GameObject* target, HitPointComponent* hp, const DamageInfo& info);
+    static void PushDeath(GameObject* victim, GameObject* killer, DamageSource source);
+    static void PushSound(const SoundPath& path, float volume, const SeLimits& limits);
+
+    //蔻̌ɌĂ(ɐς܂ꂽ̂Ăяoŏ)
+    static void Dispatch();
+
+    //ς񂾂̂Ɏ̂Ă(V[𔲂鎞)
+    static void Clear();
+
+    //--------Get֐-------
+    static const Stats& GetStats() { return m_stats; }
+
+    //̏ŏO̍Ɣׂ(DebugBenchmark ɓo^)
+    static void RunEventBenchmark(std::vector<std::string>& outLines);
+
+private:
+    //1̃_[W𔽉fāA|猂jς
+    static void ResolveDamage(const DamageEvent& e);
+
+    static Queue<DamageEvent, MAX_DAMAGE_EVENTS> m_damage;
+    static Queue<DeathEvent, MAX_DEATH_EVENTS> m_deaths;
+    static Queue<SoundEvent, MAX_SOUND_EVENTS> m_sounds;
+
+    static Stats m_stats;
+};
@@ -1,5 +1,6 @@
 #include "HPBar.h"
 #include "Input.h"
+#include <d3d11.h>
 #include "Renderer.h"
 #include "Application.h"
 #include <Windows.h>
@@ -0,0 +1,192 @@
+#if defined(_MSC_VER) && !defined(_CRT_SECURE_NO_WARNINGS)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <cstdio>
+#include "HeadlessRenderBackend.h"
+#include "RenderTypes.h"
+
+namespace
+{
+    uint64_t ToArg(const void* ptr)
+    {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr));
+    }
+}
+
+//------------------------------NullRenderBackend------------------------------
+
+void NullRenderBackend::BeginFrame()
+{
+    Count(RC_BEGIN_FRAME);
+    OnCommand(RC_BEGIN_FRAME, 0, 0, 0);
+}
+
+void NullRenderBackend::EndFrame()
+{
+    Count(RC_END_FRAME);
+    OnCommand(RC_END_FRAME, 0, 0, 0);
+    CloseFrameStats();
+
+    m_frameIndex++;
+}
+
+void NullRenderBackend::SetShaders(ID3D11VertexShader* vertexShader, ID3D11PixelShader* pixelShader, ID3D11InputLayout* inputLayout)
+{
+    Count(RC_SET_SHADERS);
+    OnCommand(RC_SET_SHADERS, ToArg(vertexShader), static_cast<uint32_t>(ToArg(pixelShader)), static_cast<uint32_t>(ToArg(inputLayout)));
+}
+
+void NullRenderBackend::SetBlendState(int blendState)
+{
+    Count(RC_SET_BLEND);
+    OnCommand(RC_SET_BLEND, static_cast<uint64_t>(blendState), 0, 0);
+}
+
+void NullRenderBackend::SetDepthEnable(bool enable)
+{
+    Count(RC_SET_DEPTH);
+    OnCommand(RC_SET_DEPTH, enable ? 1 : 0, 0, 0);
+}
+
+void NullRenderBackend::SetCulling(bool cullBack)
+{
+    Count(RC_SET_CULLING);
+    OnCommand(RC_SET_CULLING, cullBack ? 1 : 0, 0, 0);
+}
+
+void NullRenderBackend::SetGeometry(ID3D11Buffer* vertexBuffer, uint32_t stride, ID3D11Buffer* indexBuffer, RENDER_INDEX_FORMAT indexFormat, RENDER_TOPOLOGY topology)
+{
+    Count(RC_SET_GEOMETRY);
+    OnCommand(RC_SET_GEOMETRY, ToArg(vertexBuffer) ^ (ToArg(indexBuffer) << 1), stride, (static_cast<uint32_t>(indexFormat) << 16) | static_cast<uint32_t>(topology));
+}
+
+void NullRenderBackend::SetInstanceBuffer(ID3D11Buffer* instanceBuffer, uint32_t stride)
+{
+    Count(RC_SET_INSTANCE_BUFFER);
+    OnCommand(RC_SET_INSTANCE_BUFFER, ToArg(instanceBuffer), stride, 0);
+}
+
+void NullRenderBackend::SetTexture(ID3D11ShaderResourceView* texture)
+{
+    Count(RC_SET_TEXTURE);
+    OnCommand(RC_SET_TEXTURE, ToArg(texture), 0, 0);
+}
+
+void NullRenderBackend::SetMaterial(const MATERIAL& material)
+{
+    Count(RC_SET_MATERIAL);
+
+    //FRGBA8ɋl߂Ďc
+    Color diffuse = material.Diffuse;
+    diffuse.Saturate();
+    uint32_t rgba = static_cast<uint32_t>(diffuse.RGBA().v);
+    OnCommand(RC_SET_MATERIAL, rgba, material.TextureEnable ? 1 : 0, 0);
+}
+
+void NullRenderBackend::SetWorldMatrix(const Matrix4x4& world)
+{
+    Count(RC_SET_WORLD);
+    OnCommand(RC_SET_WORLD, 0, 0, 0);
+}
+
+void NullRenderBackend::SetViewMatrix(const Matrix4x4& view)
+{
+    Count(RC_SET_VIEW);
+    OnCommand(RC_SET_VIEW, 0, 0, 0);
+}
+
+void NullRenderBackend::SetProjectionMatrix(const Matrix4x4& projection)
+{
+    Count(RC_SET_PROJECTION);
+    OnCommand(RC_SET_PROJECTION, 0, 0, 0);
+}
+
+void NullRenderBackend::DrawIndexed(uint32_t indexCount)
+{
+    Count(RC_DRAW_INDEXED);
+    CountDraw(indexCount, 1);
+    OnCommand(RC_DRAW_INDEXED, 0, indexCount, 1);
+}
+
+void NullRenderBackend::DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t startInstance)
+{
+    Count(RC_DRAW_INSTANCED);
+    CountDraw(indexCount, instanceCount);
+    OnCommand(RC_DRAW_INSTANCED, startInstance, indexCount, instanceCount);
+}
+
+void NullRenderBackend::DrawTexture(ID3D11ShaderResourceView* texture, const Vector2& position, const Vector2& size)
+{
+    Count(RC_DRAW_TEXTURE);
+    CountDraw(6, 1);
+    OnCommand(RC_DRAW_TEXTURE, ToArg(texture), static_cast<uint32_t>(size.x), static_cast<uint32_t>(size.y));
+}
+
+void NullRenderBackend::DrawBillboard(ID3D11ShaderResourceView* texture, const Vector3& worldPos, float size)
+{
+    Count(RC_DRAW_BILLBOARD);
+    CountDraw(6, 1);
+    OnCommand(RC_DRAW_BILLBOARD, ToArg(texture), static_cast<uint32_t>(size), 1);
+}
+
+//------------------------------RecordingRenderBackend------------------------------
+
+void RecordingRenderBackend::OnCommand(RENDER_COMMAND command, uint64_t arg0, uint32_t arg1, uint32_t arg2)
+{
+    if (m_trace.size() >= m_maxEntries)
+    {
+        m_droppedEntries++;
+        return;
+    }
+
+    RenderTraceEntry entry;
+    entry.frame = static_cast<uint32_t>(m_frameIndex);
+    entry.command = command;
+    entry.arg0 = arg0;
+    entry.arg1 = arg1;
+    entry.arg2 = arg2;
+    m_trace.push_back(entry);
+}
+
+bool RecordingRenderBackend::SaveTrace(const std::string& filepath) const
+{
+    FILE* fp = fopen(filepath.c_str(), "w");
+    if (!fp)
+    {
+        const std::string message = "RecordingRenderBackend: failed to open " + filepath + "\n";
+#ifdef _WIN32
+        OutputDebugStringA(message.c_str());
+#else
+        fputs(message.c_str(), stderr);
+#endif
+        return false;
+    }
+
+    fprintf(fp, "# frame command arg0 arg1 arg2\n");
+    for (const auto& e : m_trace)
+    {
+        fprintf(fp, "%u %s %llx %u %u\n",
+            e.frame, GetCommandName(e.command),
+            static_cast<unsigned long long>(e.arg0), e.arg1, e.arg2);
+    }
+
+    if (m_droppedEntries > 0)
+    {
+        fprintf(fp, "# dropped %zu commands (trace limit)\n", m_droppedEntries);
+    }
+
+    //ŌɍvĂ(rp)
+    const RenderBackendStats& total = GetTotalStats();
+    fprintf(fp, "# frames=%d drawCalls=%d instances=%d triangles=%d\n",
+        total.frames, total.drawCalls, total.instances, total.triangles);
+    for (int i = 0; i < MAX_RENDER_COMMAND; ++i)
+    {
+        fprintf(fp, "# %s=%d\n", GetCommandName(static_cast<RENDER_COMMAND>(i)), total.commands[i]);
+    }
+
+    fclose(fp);
+    return true;
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "RenderBackend.h"
+
+//---------------------------------------------------------
+// GPU gȂobNGh
+// NullRenderBackend      : R}h𐔂邾(`擝vp)
+// RecordingRenderBackend : ăR}hL^At@Cɏo
+// ǂ IsHeadless()  true Ȃ̂ŁARenderer  D3D foCXȂ
+//---------------------------------------------------------
+class NullRenderBackend : public RenderBackend
+{
+public:
+    const char* GetName() const override { return "Null"; }
+    bool IsHeadless() const override { return true; }
+
+    void BeginFrame() override;
+    void EndFrame() override;
+
+    void SetShaders(ID3D11VertexShader* vertexShader, ID3D11PixelShader* pixelShader, ID3D11InputLayout* inputLayout) override;
+    void SetBlendState(int blendState) override;
+    void SetDepthEnable(bool enable) override;
+    void SetCulling(bool cullBack) override;
+    void SetGeometry(ID3D11Buffer* vertexBuffer, uint32_t stride, ID3D11Buffer* indexBuffer, RENDER_INDEX_FORMAT indexFormat, RENDER_TOPOLOGY topology) override;
+    void SetInstanceBuffer(ID3D11Buffer* instanceBuffer, uint32_t stride) override;
+    void SetTexture(ID3D11ShaderResourceView* texture) override;
+    void SetMaterial(const MATERIAL& material) override;
+    void SetWorldMatrix(const Matrix4x4& world) override;
+    void SetViewMatrix(const Matrix4x4& view) override;
+    void SetProjectionMatrix(const Matrix4x4& projection) override;
+
+    void DrawIndexed(uint32_t indexCount) override;
+    void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t startInstance) override;
+    void DrawTexture(ID3D11ShaderResourceView* texture, const Vector2& position, const Vector2& size) override;
+    void DrawBillboard(ID3D11ShaderResourceView* texture, const Vector3& worldPos, float size) override;
+
+protected:
+    //R}hɌĂ΂(arg ̈Ӗ̓R}hɈႤ)
+    virtual void OnCommand(RENDER_COMMAND command, uint64_t arg0, uint32_t arg1, uint32_t arg2) {}
+
+    int m_frameIndex = 0;
+};
+
+//L^R}h1
+struct RenderTraceEntry
+{
+    uint32_t frame;
+    RENDER_COMMAND command;
+    uint64_t arg0;      //\[X̃AhX / Xe[glȂ
+    uint32_t arg1;      //CfbNX / XgChȂ
+    uint32_t arg2;      //CX^XȂ
+};
+
+class RecordingRenderBackend : public NullRenderBackend
+{
+public:
+    //maxEntries : L^R}h̏(͐)
+    explicit RecordingRenderBackend(size_t maxEntries = 1000000) : m_maxEntries(maxEntries) {}
+
+    const char* GetName() const override { return "Recording"; }
+
+    //L^R}heLXgŏo(1s1R}h)
+    bool SaveTrace(const std::string& filepath) const;
+
+    void ClearTrace()
+    {
+        m_trace.clear();
+        m_droppedEntries = 0;
+    }
+
+    //--------Get֐-------
+    const std::vector<RenderTraceEntry>& GetTrace() const { return m_trace; }
+    size_t GetDroppedEntries() const { return m_droppedEntries; }
+
+protected:
+    void OnCommand(RENDER_COMMAND command, uint64_t arg0, uint32_t arg1, uint32_t arg2) override;
+
+private:
+    std::vector<RenderTraceEntry> m_trace;
+    size_t m_maxEntries;
+    size_t m_droppedEntries = 0;
+};
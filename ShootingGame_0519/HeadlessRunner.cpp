@@ -0,0 +1,337 @@
+#if defined(_MSC_VER) && !defined(_CRT_SECURE_NO_WARNINGS)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <cstdio>
+#include <algorithm>
+#include <memory>
+#include <iterator>
+#include "HeadlessRunner.h"
+#include "HeadlessRenderBackend.h"
+#include "renderer.h"
+#include "SceneManager.h"
+#include "EffectManager.h"
+#include "InstancedRenderer.h"
+#include "RenderQueue.h"
+#include "WorkerPool.h"
+#include "ModelCache.h"
+#include "ModelComponent.h"
+#include "MeshLod.h"
+#include "TextureManager.h"
+#include "ResidencyManager.h"
+#include "Sound.h"
+#include "AudioBackend.h"
+#include "PatrolSteering.h"
+#include "HomingSwarm.h"
+#include "AiScheduler.h"
+#include "RandomService.h"
+#include "TimerWheel.h"
+#include "TextureCompressor.h"
+#include "InstanceBatcher.h"
+
+namespace
+{
+    constexpr float FIXED_DELTA_TIME = 1.0f / 60.0f;
+
+    //`擝vR\[ƃfobOo̗͂ɏo
+    void Print(const char* text)
+    {
+        printf("%s\n", text);
+#ifdef _WIN32
+        OutputDebugStringA(text);
+        OutputDebugStringA("\n");
+#endif
+    }
+}
+
+int HeadlessRunner::Run(int frames, const std::string& tracePath, const std::string& audioPath, uint64_t seed)
+{
+    frames = std::max(frames, 1);
+
+    auto backendPtr = std::make_unique<RecordingRenderBackend>();
+    RecordingRenderBackend* backend = backendPtr.get();
+
+    //-----------------------(D3DEJډo͎gȂB̓~bNX)-----------------------
+    RandomService::Init(seed);
+
+    //AI̎Ԃ̏ŉ񂷓GςƓV[hłʂς̂ŁA͊O
+    AiScheduler::SetBudgetMs(0.0f);
+
+    WorkerPool::Init();
+
+    Renderer::SetBackend(std::move(backendPtr));
+    Renderer::Init();
+
+    InstancedRenderer::Init();
+
+    if (audioPath.empty())
+    {
+        Sound::Init(std::make_unique<NullAudioBackend>());
+    }
+    else if (!Sound::Init(std::make_unique<WavWriterAudioBackend>(audioPath)))
+    {
+        Print(("Headless run: cannot write " + audioPath).c_str());
+    }
+
+    EffectManager::Init();
+
+    ResidencyManager::RegisterCache(RESIDENT_TEXTURE, TextureManager::GatherResident, TextureManager::Evict);
+    ResidencyManager::RegisterCache(RESIDENT_MODEL, ModelCache::GatherResident, ModelCache::Evict);
+    ResidencyManager::RegisterCache(RESIDENT_SOUND, Sound::GatherResidentSe, Sound::EvictSe);
+
+    SceneManager::Init();
+    SceneManager::SetCurrentScene("GameScene");
+
+    //-----------------------C[v-----------------------
+    int maxDrawCalls = 0;
+    long long queuePackets = 0;
+    long long queueChanges = 0;
+    long long queueSkipped = 0;
+    long long instancedDrawCalls = 0;
+    long long instancedInstances = 0;
+    long long lodFullTriangles = 0;
+    long long lodTriangles = 0;
+
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        Sound::Update(FIXED_DELTA_TIME);
+        TimerWheel::GetGame().Advance(FIXED_DELTA_TIME);
+        SceneManager::Update(FIXED_DELTA_TIME);
+        PatrolSteering::Flush();
+        HomingSwarm::Flush(FIXED_DELTA_TIME);
+        AiScheduler::EndFrame();
+        EffectManager::Update(FIXED_DELTA_TIME);
+
+        //Q[IăUgɈڂ炻Ŏ~߂
+        if (SceneManager::GetCurrentSceneName() != "GameScene")
+        {
+            break;
+        }
+
+        Renderer::Begin();
+
+        SceneManager::DrawWorld(FIXED_DELTA_TIME);
+
+        InstancedRenderer::Flush();
+        RenderQueue::Flush();
+
+        EffectManager::Draw3D(FIXED_DELTA_TIME);
+
+        SceneManager::DrawUI(FIXED_DELTA_TIME);
+
+        InstancedRenderer::EndFrame();
+        RenderQueue::EndFrame();
+        MeshLod::EndFrame();
+        ResidencyManager::EndFrame();
+
+        Renderer::End();
+
+        //-----------------------t[̓v-----------------------
+        const RenderBackendStats& stats = backend->GetStats();
+        maxDrawCalls = std::max(maxDrawCalls, stats.drawCalls);
+
+        const RenderQueue::Stats& queue = RenderQueue::GetStats();
+        queuePackets += queue.packets;
+        queueChanges += queue.TotalChanges();
+        queueSkipped += queue.TotalSkipped();
+
+        const InstancedRenderer::Stats& instanced = InstancedRenderer::GetStats();
+        instancedDrawCalls += instanced.drawCalls;
+        instancedInstances += instanced.instances;
+
+        const MeshLod::Stats& lod = MeshLod::GetStats();
+        lodFullTriangles += lod.fullTriangles;
+        lodTriangles += lod.triangles;
+    }
+
+    //-----------------------ʂ̏o-----------------------
+    const RenderBackendStats& total = backend->GetTotalStats();
+    const int frameCount = std::max(total.frames, 1);
+
+    char buf[256];
+    snprintf(buf, sizeof(buf), "Headless run: backend=%s frames=%d/%d scene=%s seed=%llu",
+        backend->GetName(), total.frames, frames, SceneManager::GetCurrentSceneName().c_str(),
+        static_cast<unsigned long long>(RandomService::GetSessionSeed()));
+    Print(buf);
+
+    snprintf(buf, sizeof(buf), "  draw calls : total=%d avg=%.1f max=%d",
+        total.drawCalls, static_cast<float>(total.drawCalls) / frameCount, maxDrawCalls);
+    Print(buf);
+
+    snprintf(buf, sizeof(buf), "  instances=%d triangles=%d (avg %.0f / frame)",
+        total.instances, total.triangles, static_cast<float>(total.triangles) / frameCount);
+    Print(buf);
+
+    snprintf(buf, sizeof(buf), "  RenderQueue : packets=%lld changes=%lld skipped=%lld",
+        queuePackets, queueChanges, queueSkipped);
+    Print(buf);
+
+    snprintf(buf, sizeof(buf), "  Instanced   : drawCalls=%lld instances=%lld",
+        instancedDrawCalls, instancedInstances);
+    Print(buf);
+
+    snprintf(buf, sizeof(buf), "  Mesh LOD    : triangles %lld -> %lld (%.1f%%)",
+        lodFullTriangles, lodTriangles,
+        lodFullTriangles > 0 ? 100.0 * lodTriangles / lodFullTriangles : 100.0);
+    Print(buf);
+
+    for (int i = 0; i < MAX_RENDER_COMMAND; ++i)
+    {
+        snprintf(buf, sizeof(buf), "  %-22s %8d (avg %.1f / frame)",
+            RenderBackend::GetCommandName(static_cast<RENDER_COMMAND>(i)),
+            total.commands[i], static_cast<float>(total.commands[i]) / frameCount);
+        Print(buf);
+    }
+
+    //(~bNXׂ̕ SE ̃{CX̊蓖)
+    const AudioMixer::Stats mix = Sound::GetMixerStats();
+    snprintf(buf, sizeof(buf), "  Audio       : %s, %s, %.2f s mixed, peak voices=%d, load %.2f%%",
+        Sound::GetBackendName(), AudioMixKernels::GetName(mix.kernel),
+        static_cast<double>(mix.renderedFrames) / AudioMixer::OUTPUT_RATE, mix.peakVoices, mix.GetLoadPercent());
+    Print(buf);
+
+    const BgmStream::Stats bgm = Sound::GetBgmStats();
+    if (bgm.fileBytes > 0)
+    {
+        snprintf(buf, sizeof(buf), "  BGM stream  : %s, first audio %.1f ms, resident %zu KB (PCM %zu KB), underruns=%d",
+            bgm.compressed ? "IMA-ADPCM" : "PCM", bgm.firstAudioMs, bgm.residentBytes / 1024,
+            bgm.pcmBytes / 1024, mix.streamUnderruns);
+        Print(buf);
+    }
+
+    const SeVoicePool::Stats& se = Sound::GetSeStats();
+    snprintf(buf, sizeof(buf), "  SE voices   : plays=%d steals=%d drops=%d throttled=%d",
+        se.plays, se.steals, se.drops, se.throttled);
+    Print(buf);
+
+    //풓(wbhXł GPU ̃oCg 0)
+    std::vector<std::string> residency;
+    ResidencyManager::GetReport(residency);
+    for (const auto& line : residency)
+    {
+        Print(("  " + line).c_str());
+    }
+
+    int result = 0;
+    if (!tracePath.empty())
+    {
+        if (backend->SaveTrace(tracePath))
+        {
+            snprintf(buf, sizeof(buf), "  trace : %s (%zu commands)", tracePath.c_str(), backend->GetTrace().size());
+            Print(buf);
+        }
+        else
+        {
+            result = 1;
+        }
+    }
+
+    //-----------------------I-----------------------
+    SceneManager::Uninit();
+    PatrolSteering::Clear();
+    HomingSwarm::Clear();
+    TimerWheel::GetGame().Clear();
+    EffectManager::Uninit();
+    Sound::Uninit();
+    RenderQueue::Clear();
+    ModelCache::Clear();
+    TextureManager::Clear();
+    ResidencyManager::Clear();
+    InstancedRenderer::Uninit();
+    Renderer::Uninit();
+    WorkerPool::Uninit();
+
+    return result;
+}
+
+int HeadlessRunner::BakeLods(const std::vector<std::string>& modelPaths)
+{
+    //obt@͍Ȃ̂ GPU ŉ
+    Renderer::SetBackend(std::make_unique<NullRenderBackend>());
+    Renderer::Init();
+
+    int result = 0;
+    char buf[256];
+
+    for (const auto& path : modelPaths)
+    {
+        //Â LOD ĂǂނƁAǂݍݎɍ蒼ĕۑ
+        const std::string lodPath = MeshLodFile::GetPath(path);
+        MeshLodFile::Remove(lodPath);
+
+        ModelComponent model;
+        model.LoadModel(path);
+
+        std::shared_ptr<ModelData> data = ModelCache::Find(path);
+        if (!data)
+        {
+            snprintf(buf, sizeof(buf), "LOD bake failed: %s", path.c_str());
+            Print(buf);
+            result = 1;
+            continue;
+        }
+
+        snprintf(buf, sizeof(buf), "LOD bake: %s -> %s", path.c_str(), lodPath.c_str());
+        Print(buf);
+
+        for (size_t i = 0; i < data->meshes.size(); ++i)
+        {
+            const ModelMeshData& mesh = data->meshes[i];
+
+            std::string levels;
+            for (const auto& lod : mesh.lods)
+            {
+                char level[64];
+                snprintf(level, sizeof(level), " %u (err %.4f)", lod.indexCount / 3, lod.error);
+                levels += level;
+            }
+
+            snprintf(buf, sizeof(buf), "  mesh %zu : %u tris ->%s", i, mesh.indexCount / 3,
+                levels.empty() ? " (no lod)" : levels.c_str());
+            Print(buf);
+
+            snprintf(buf, sizeof(buf), "           ACMR %.3f -> %.3f, %u -> %u bytes (%s, %s indices)",
+                mesh.acmrBefore, mesh.acmrAfter, mesh.bytesBefore, mesh.bytesAfter,
+                mesh.packedVertices ? "packed vertices" : "VERTEX_3D",
+                mesh.indexFormat == RIF_UINT16 ? "16bit" : "32bit");
+            Print(buf);
+        }
+    }
+
+    ModelCache::Clear();
+    Renderer::Uninit();
+
+    return result;
+}
+
+int HeadlessRunner::RunSelfChecks()
+{
+    using SelfCheck = bool (*)(std::vector<std::string>& outLines);
+    const SelfCheck checks[] =
+    {
+        TextureCompressor::RunSelfCheck,
+        InstanceBatcher::RunSelfCheck,
+    };
+
+    int failed = 0;
+    for (SelfCheck check : checks)
+    {
+        std::vector<std::string> lines;
+        if (!check(lines))
+        {
+            failed++;
+        }
+        for (const auto& line : lines)
+        {
+            Print(line.c_str());
+        }
+    }
+
+    char buf[64];
+    snprintf(buf, sizeof(buf), "Self-check: %d / %d passed", static_cast<int>(std::size(checks)) - failed, static_cast<int>(std::size(checks)));
+    Print(buf);
+
+    return (failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+
+//---------------------------------------------------------
+// EBhEEGPU  GameScene 񂷃NX
+// Renderer  RecordingRenderBackend ɍւĎwt[
+// XVƕ`sA`R}h̓vWo͂ɏo
+// ̓foCXŃ~bNXs(audioPath n WAV ɏo)
+// (main  --headless ĂԁB`܂̕ύX̔rECI p)
+//---------------------------------------------------------
+class HeadlessRunner
+{
+public:
+    //frames : 񂷃t[ (Œ 1/60 b)
+    //tracePath : łȂ΃R}h̃t@Cɏo
+    //audioPath : łȂ΃~bNX WAV ɏo
+    //seed : ̃ZbVV[h(lȂG̔zuEɂȂ)
+    //߂l : vZX̏IR[h
+    static int Run(int frames, const std::string& tracePath, const std::string& audioPath = "", uint64_t seed = 1);
+
+    //fǂݍ LOD 蒼A<f>.lod ɏo
+    //bVɒ_LbV̌(ACMR) VB/IB ̃oCg̕ωo
+    //(main  --bake-lod ĂԁBN̊ȗȂ)
+    static int BakeLods(const std::vector<std::string>& modelPaths);
+
+    //CPU Ŋm߂鎩ȃ`FbN܂Ƃ߂ĉ(GPUEEBhEEAZbg)
+    //(main  --self-check ĂԁBCI p)
+    //߂l : Sʂ 0
+    static int RunSelfChecks();
+};
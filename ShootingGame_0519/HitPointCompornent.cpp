@@ -7,19 +7,6 @@ HitPointComponent::HitPointComponent(float maxHP): m_maxHp(maxHP), m_hp(maxHP)
 	//RXgN^
 }
 
-void HitPointComponent::Update(float dt)
-{
-	if(m_isInvincible)
-	{
-		m_invTimer -= dt;
-		if (m_invTimer <= 0.0f)
-		{
-			m_isInvincible = false;
-			m_invTimer = 0.0f;
-		}
-	}
-}
-
 bool HitPointComponent::ApplyDamage(const DamageInfo& info)
 {
 	//ɎłȂ
@@ -34,8 +21,7 @@ bool HitPointComponent::ApplyDamage(const DamageInfo& info)
 
 	if(m_invOnHit > 0.0f)
 	{
-		m_isInvincible = true;
-		m_invTimer = m_invOnHit;
+		SetInvincible(m_invOnHit);
 	}
 
 	if (m_hp == 0)
@@ -59,12 +45,12 @@ void HitPointComponent::SetInvincible(float seconds)
 	if (seconds > 0.0f)
 	{
 		m_isInvincible = true;
-		m_invTimer = seconds;
+		m_invTimer.Start(seconds, [this]() { m_isInvincible = false; });
 	}
 	else
 	{
 		m_isInvincible = false;
-		m_invTimer = 0.0f;
+		m_invTimer.Stop();
 	}
 }
 
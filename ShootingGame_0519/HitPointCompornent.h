@@ -1,16 +1,27 @@
 #pragma once
 #include "Component.h"
 #include <functional>
-#include <string>
+#include <cstdint>
+#include "TimerWheel.h"
 
 class GameObject;
 
-//_[WŎgp̃CtH[V
+//_[W̎(O͕ tag ŎĂ)
+enum class DamageSource : uint8_t
+{
+    Unknown,
+    PlayerBullet,
+    EnemyBullet,
+    BuildingCollision,
+    EnemyCollision,
+};
+
+//_[WŎgp̃CtH[V(Rs[ōςނ̂ŃCxgɂ̂܂ܐς߂)
 struct DamageInfo
 {
 	int amount = 1;                   //_[W
     GameObject* instigator = nullptr; //_[W
-    std::string tag;                  //
+    DamageSource source = DamageSource::Unknown;
     bool ignoreInvincibility = false; //Op
 };
 
@@ -20,7 +31,7 @@ public:
     HitPointComponent(float maxHP);
 
     void Initialize() override {}
-    void Update(float dt) override;
+    void Update(float dt) override {}     //GԂ m_invTimer ̂Ŗt[͖̏
 
     bool ApplyDamage(const DamageInfo& info); //Damage
     void Heal(int amount);                    //HP񕜂
@@ -48,7 +59,7 @@ private:
 	float m_hp;       //݂HP
 	float m_maxHp;    //őHP
 	bool  m_isInvincible = false;    //GԂ̃tO
-	float m_invTimer = 0.0f;         //Gԗp̃^C}[
+	TimerWheel::Timer m_invTimer;    //GԂI m_isInvincible ߂
 	float m_invOnHit = 1.5f;         //eɎŖGɂȂ鎞
 
 	std::function<void(const DamageInfo&)> m_onDamaged;     //_[WR[obN
@@ -2,6 +2,8 @@
 #include "Component.h"
 #include <SimpleMath.h>
 #include <memory>
+#include "AiScheduler.h"
+#include "TimerWheel.h"
 
 using namespace DirectX::SimpleMath;
 
@@ -12,13 +14,13 @@ class HomingComponent : public Component
 {
 public:
     HomingComponent() = default;
-    ~HomingComponent() override = default;
+    ~HomingComponent() override;
 
     //------------Set֐--------------
     void SetTarget(const std::weak_ptr<GameObject>& t) { m_target = t; }
     void SetTimeToIntercept(float t) { m_timeToIntercept = t; }
     void SetMaxAcceleration(float a) { m_maxAcceleration = a; }
-    void SetLifeTime(float sec) { m_lifeTime = sec; }
+    void SetLifeTime(float sec);
     void SetAimBias(const Vector3& b) { m_aimBias = b; }
     void SetAimBiasStrength(float s) { m_aimBiasStrength = s; }
     void SetAimBiasDecay(float d) { m_aimBiasDecay = d; }
@@ -33,18 +35,25 @@ public:
     void Update(float dt) override;
 
 private:
+    void StartLifeTimer();
+
+    //}̌vZ̓o͂ HomingSwarm ړǂݏ
+    friend class HomingSwarm;
+
     //--------------ǔ֘A------------------
     std::weak_ptr<GameObject> m_target;
+    BulletComponent* m_bullet = nullptr;    // IuWFNg BulletComponentiŏ Update 1񂾂Tj
     float m_timeToIntercept = 1.5f;   // ftHg 1 bŖڎw
-    float m_maxAcceleration = 400.0f;   // 0 = A>0 Ő
+    float m_maxAcceleration = 400.0f;   // 0 = A>0 ŉ̉x(Ȃpx)𐧌
     float m_lifeTime = 5.0f;          // Homing ̎ioptionalj
-    float m_age = 0.0f;               // oߎ
+    TimerWheel::Timer m_lifeTimer;    // V[OiԈĂĂԒʂɏj
 
-    Vector3 m_prevTargetPos = Vector3::Zero;
-    bool m_havePrevTargetPos = false;
     float m_maxTurnRateDeg = 120.0f;
 
     Vector3 m_aimBias = Vector3::Zero;      // ˎ̃_oCAXixNgj
     float m_aimBiasStrength = 0.0f;         // oCAX̋iZʂ̃XJ[j
     float m_aimBiasDecay = 1.0f;            // 1 b̌ʁi 0 ɂȂ܂Ōj
+
+    AiScheduler::Agent m_aiAgent;           // ͌}_̌vZ𐔃t[1ɂ
+    float m_stepDt = 0.0f;                  // Ȃ鎞ԁiHomingSwarm ǂށj
 };
\ No newline at end of file
@@ -0,0 +1,623 @@
+#define NOMINMAX
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cfloat>
+#include <memory>
+#include <windows.h>
+#include "HomingSwarm.h"
+#include "HomingComponent.h"
+#include "BulletComponent.h"
+#include "GameObject.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define HOMING_SWARM_SSE 1
+#include <emmintrin.h>
+#endif
+
+using namespace DirectX::SimpleMath;
+
+std::vector<HomingComponent*> HomingSwarm::m_pending;
+std::vector<HomingComponent*> HomingSwarm::m_active;
+std::vector<HomingSwarm::Target> HomingSwarm::m_targets;
+HomingSwarm::Batch HomingSwarm::m_batch;
+
+bool HomingSwarm::m_batched = true;
+#if defined(HOMING_SWARM_SSE)
+HomingSwarm::SWARM_KERNEL HomingSwarm::m_kernel = HomingSwarm::SWARM_SSE;
+#else
+HomingSwarm::SWARM_KERNEL HomingSwarm::m_kernel = HomingSwarm::SWARM_SCALAR;
+#endif
+HomingSwarm::Stats HomingSwarm::m_stats;
+
+namespace
+{
+    constexpr float EPSILON = 1e-6f;
+    constexpr float EPSILON_SQ = 1e-6f;
+    constexpr float PARALLEL_SQ = 1e-12f;
+    constexpr float MIN_SPEED = 1e-3f;
+    constexpr float MIN_INTERCEPT_TIME = 0.001f;
+    constexpr float PI = 3.14159265359f;
+    constexpr float DEG2RAD = PI / 180.0f;
+
+    //̏ݒ肳ĂȂ
+    constexpr float DEFAULT_TURN_RATE_DEG = 60.0f;
+
+    //-----------------------XJ[(HomingComponent 1ĂvZƓ)-----------------------
+    void SteerScalar(HomingSwarm::Batch& b, size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const float px = b.posX[i], py = b.posY[i], pz = b.posZ[i];
+            const float dx = b.dirX[i], dy = b.dirY[i], dz = b.dirZ[i];
+            const float speed = b.speed[i];
+            const float tvx = b.targetVelX[i], tvy = b.targetVelY[i], tvz = b.targetVelZ[i];
+
+            //} : |rel + tv * t| = speed * t ̐̍ŏ
+            const float rx = b.targetX[i] - px;
+            const float ry = b.targetY[i] - py;
+            const float rz = b.targetZ[i] - pz;
+            const float qa = tvx * tvx + tvy * tvy + tvz * tvz - speed * speed;
+            const float qb = 2.0f * (rx * tvx + ry * tvy + rz * tvz);
+            const float qc = rx * rx + ry * ry + rz * rz;
+
+            float t = FLT_MAX;
+            if (std::fabs(qa) < EPSILON)
+            {
+                //ƓȂꎟ
+                if (std::fabs(qb) >= EPSILON && -qc / qb > 0.0f)
+                {
+                    t = -qc / qb;
+                }
+            }
+            else
+            {
+                const float disc = qb * qb - 4.0f * qa * qc;
+                if (disc >= 0.0f)
+                {
+                    const float sqrtD = std::sqrt(disc);
+                    const float t1 = (-qb + sqrtD) / (2.0f * qa);
+                    const float t2 = (-qb - sqrtD) / (2.0f * qa);
+                    if (t1 > 0.0f) { t = std::min(t, t1); }
+                    if (t2 > 0.0f) { t = std::min(t, t2); }
+                }
+            }
+            if (t == FLT_MAX)
+            {
+                t = std::max(b.timeToIntercept[i], MIN_INTERCEPT_TIME);
+            }
+
+            //}_֌
+            float wx = rx + tvx * t;
+            float wy = ry + tvy * t;
+            float wz = rz + tvz * t;
+            if (wx * wx + wy * wy + wz * wz < EPSILON_SQ)
+            {
+                wx = dx; wy = dy; wz = dz;
+            }
+
+            //ˎ̂΂炯𑫂Č
+            const float strength = b.biasStrength[i];
+            if (strength > 0.0f)
+            {
+                wx += b.biasX[i] * strength;
+                wy += b.biasY[i] * strength;
+                wz += b.biasZ[i] * strength;
+                b.biasStrength[i] = std::max(strength - b.biasDecay[i] * b.dt[i], 0.0f);
+            }
+
+            float lenSq = wx * wx + wy * wy + wz * wz;
+            if (lenSq < EPSILON_SQ)
+            {
+                wx = dx; wy = dy; wz = dz;
+                lenSq = 1.0f;
+            }
+            const float inv = 1.0f / std::sqrt(lenSq);
+            wx *= inv; wy *= inv; wz *= inv;
+
+            //Ȃpx̓Ȃ炻̂܂܁AOȂ dir ܂ŉ
+            const float cosTheta = std::clamp(dx * wx + dy * wy + dz * wz, -1.0f, 1.0f);
+            float nx = wx, ny = wy, nz = wz;
+            if (cosTheta < b.cosTurn[i])
+            {
+                //desired  dir ɐȐ񂷌(^Ȃ琅ɉ)
+                float ux = wx - dx * cosTheta;
+                float uy = wy - dy * cosTheta;
+                float uz = wz - dz * cosTheta;
+                float uSq = ux * ux + uy * uy + uz * uz;
+                if (uSq < PARALLEL_SQ)
+                {
+                    ux = -dz; uy = 0.0f; uz = dx;
+                    uSq = ux * ux + uz * uz;
+                    if (uSq < PARALLEL_SQ)
+                    {
+                        ux = 1.0f; uy = 0.0f; uz = 0.0f;
+                        uSq = 1.0f;
+                    }
+                }
+                const float uInv = 1.0f / std::sqrt(uSq);
+                ux *= uInv; uy *= uInv; uz *= uInv;
+
+                nx = dx * b.cosTurn[i] + ux * b.sinTurn[i];
+                ny = dy * b.cosTurn[i] + uy * b.sinTurn[i];
+                nz = dz * b.cosTurn[i] + uz * b.sinTurn[i];
+                const float nInv = 1.0f / std::sqrt(std::max(nx * nx + ny * ny + nz * nz, EPSILON_SQ));
+                nx *= nInv; ny *= nInv; nz *= nInv;
+            }
+
+            b.dirX[i] = nx;
+            b.dirY[i] = ny;
+            b.dirZ[i] = nz;
+            b.speed[i] = std::max(speed, MIN_SPEED);
+        }
+    }
+
+#if defined(HOMING_SWARM_SSE)
+    //-----------------------SSE(4)-----------------------
+    inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    inline __m128 Dot(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz)
+    {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+    }
+
+    inline __m128 Abs(__m128 v)
+    {
+        return _mm_andnot_ps(_mm_set1_ps(-0.0f), v);
+    }
+
+    void SteerSse(HomingSwarm::Batch& b, size_t count)
+    {
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 two = _mm_set1_ps(2.0f);
+        const __m128 four = _mm_set1_ps(4.0f);
+        const __m128 epsilon = _mm_set1_ps(EPSILON);
+        const __m128 epsilonSq = _mm_set1_ps(EPSILON_SQ);
+        const __m128 parallelSq = _mm_set1_ps(PARALLEL_SQ);
+        const __m128 fltMax = _mm_set1_ps(FLT_MAX);
+
+        //Resize  4 ̔{܂ 0 Ŗ߂Ă̂Œ[̏͗vȂ
+        for (size_t i = 0; i < count; i += 4)
+        {
+            const __m128 px = _mm_loadu_ps(&b.posX[i]);
+            const __m128 py = _mm_loadu_ps(&b.posY[i]);
+            const __m128 pz = _mm_loadu_ps(&b.posZ[i]);
+            const __m128 dx = _mm_loadu_ps(&b.dirX[i]);
+            const __m128 dy = _mm_loadu_ps(&b.dirY[i]);
+            const __m128 dz = _mm_loadu_ps(&b.dirZ[i]);
+            const __m128 speed = _mm_loadu_ps(&b.speed[i]);
+            const __m128 tvx = _mm_loadu_ps(&b.targetVelX[i]);
+            const __m128 tvy = _mm_loadu_ps(&b.targetVelY[i]);
+            const __m128 tvz = _mm_loadu_ps(&b.targetVelZ[i]);
+
+            //} : |rel + tv * t| = speed * t ̐̍ŏ
+            const __m128 rx = _mm_sub_ps(_mm_loadu_ps(&b.targetX[i]), px);
+            const __m128 ry = _mm_sub_ps(_mm_loadu_ps(&b.targetY[i]), py);
+            const __m128 rz = _mm_sub_ps(_mm_loadu_ps(&b.targetZ[i]), pz);
+            const __m128 qa = _mm_sub_ps(Dot(tvx, tvy, tvz, tvx, tvy, tvz), _mm_mul_ps(speed, speed));
+            const __m128 qb = _mm_mul_ps(two, Dot(rx, ry, rz, tvx, tvy, tvz));
+            const __m128 qc = Dot(rx, ry, rz, rx, ry, rz);
+
+            //񎟎(鐔 0 ̗͌Ŏ̂Ă̂ 1 ɂĂ)
+            const __m128 linear = _mm_cmplt_ps(Abs(qa), epsilon);
+            const __m128 disc = _mm_sub_ps(_mm_mul_ps(qb, qb), _mm_mul_ps(four, _mm_mul_ps(qa, qc)));
+            const __m128 sqrtD = _mm_sqrt_ps(_mm_max_ps(disc, zero));
+            const __m128 inv2a = _mm_div_ps(one, Select(linear, one, _mm_mul_ps(two, qa)));
+            const __m128 t1 = _mm_mul_ps(_mm_add_ps(_mm_sub_ps(zero, qb), sqrtD), inv2a);
+            const __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(zero, qb), sqrtD), inv2a);
+            const __m128 hasRoots = _mm_cmpge_ps(disc, zero);
+            __m128 tq = _mm_min_ps(Select(_mm_cmpgt_ps(t1, zero), t1, fltMax), Select(_mm_cmpgt_ps(t2, zero), t2, fltMax));
+            tq = Select(hasRoots, tq, fltMax);
+
+            //ꎟ
+            const __m128 bValid = _mm_cmpge_ps(Abs(qb), epsilon);
+            const __m128 tl0 = _mm_div_ps(_mm_sub_ps(zero, qc), Select(bValid, qb, one));
+            const __m128 tl = Select(_mm_and_ps(bValid, _mm_cmpgt_ps(tl0, zero)), tl0, fltMax);
+
+            __m128 t = Select(linear, tl, tq);
+            const __m128 fallback = _mm_max_ps(_mm_loadu_ps(&b.timeToIntercept[i]), _mm_set1_ps(MIN_INTERCEPT_TIME));
+            t = Select(_mm_cmpeq_ps(t, fltMax), fallback, t);
+
+            //}_֌
+            __m128 wx = _mm_add_ps(rx, _mm_mul_ps(tvx, t));
+            __m128 wy = _mm_add_ps(ry, _mm_mul_ps(tvy, t));
+            __m128 wz = _mm_add_ps(rz, _mm_mul_ps(tvz, t));
+            const __m128 onTarget = _mm_cmplt_ps(Dot(wx, wy, wz, wx, wy, wz), epsilonSq);
+            wx = Select(onTarget, dx, wx);
+            wy = Select(onTarget, dy, wy);
+            wz = Select(onTarget, dz, wz);
+
+            //ˎ̂΂炯𑫂Č( 0 ̗͑ĂςȂ)
+            const __m128 strength = _mm_loadu_ps(&b.biasStrength[i]);
+            wx = _mm_add_ps(wx, _mm_mul_ps(_mm_loadu_ps(&b.biasX[i]), strength));
+            wy = _mm_add_ps(wy, _mm_mul_ps(_mm_loadu_ps(&b.biasY[i]), strength));
+            wz = _mm_add_ps(wz, _mm_mul_ps(_mm_loadu_ps(&b.biasZ[i]), strength));
+            const __m128 decayed = _mm_sub_ps(strength, _mm_mul_ps(_mm_loadu_ps(&b.biasDecay[i]), _mm_loadu_ps(&b.dt[i])));
+            _mm_storeu_ps(&b.biasStrength[i], Select(_mm_cmpgt_ps(strength, zero), _mm_max_ps(decayed, zero), strength));
+
+            const __m128 lenSq = Dot(wx, wy, wz, wx, wy, wz);
+            const __m128 tiny = _mm_cmplt_ps(lenSq, epsilonSq);
+            const __m128 inv = _mm_div_ps(one, _mm_sqrt_ps(Select(tiny, one, lenSq)));
+            wx = Select(tiny, dx, _mm_mul_ps(wx, inv));
+            wy = Select(tiny, dy, _mm_mul_ps(wy, inv));
+            wz = Select(tiny, dz, _mm_mul_ps(wz, inv));
+
+            //Ȃpx̓Ȃ炻̂܂܁AOȂ dir ܂ŉ
+            const __m128 cosTheta = _mm_max_ps(_mm_min_ps(Dot(dx, dy, dz, wx, wy, wz), one), _mm_set1_ps(-1.0f));
+            const __m128 cosTurn = _mm_loadu_ps(&b.cosTurn[i]);
+            const __m128 sinTurn = _mm_loadu_ps(&b.sinTurn[i]);
+            const __m128 clampTurn = _mm_cmplt_ps(cosTheta, cosTurn);
+
+            __m128 ux = _mm_sub_ps(wx, _mm_mul_ps(dx, cosTheta));
+            __m128 uy = _mm_sub_ps(wy, _mm_mul_ps(dy, cosTheta));
+            __m128 uz = _mm_sub_ps(wz, _mm_mul_ps(dz, cosTheta));
+
+            //^Ȃ琅ɉ(^E^Ă鎞 x )
+            const __m128 parallel = _mm_cmplt_ps(Dot(ux, uy, uz, ux, uy, uz), parallelSq);
+            const __m128 hx = _mm_sub_ps(zero, dz);
+            const __m128 hz = dx;
+            const __m128 vertical = _mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(hx, hx), _mm_mul_ps(hz, hz)), parallelSq);
+            ux = Select(parallel, Select(vertical, one, hx), ux);
+            uy = Select(parallel, zero, uy);
+            uz = Select(parallel, Select(vertical, zero, hz), uz);
+
+            const __m128 uInv = _mm_div_ps(one, _mm_sqrt_ps(_mm_max_ps(Dot(ux, uy, uz, ux, uy, uz), parallelSq)));
+            ux = _mm_mul_ps(ux, uInv);
+            uy = _mm_mul_ps(uy, uInv);
+            uz = _mm_mul_ps(uz, uInv);
+
+            __m128 nx = _mm_add_ps(_mm_mul_ps(dx, cosTurn), _mm_mul_ps(ux, sinTurn));
+            __m128 ny = _mm_add_ps(_mm_mul_ps(dy, cosTurn), _mm_mul_ps(uy, sinTurn));
+            __m128 nz = _mm_add_ps(_mm_mul_ps(dz, cosTurn), _mm_mul_ps(uz, sinTurn));
+            const __m128 nInv = _mm_div_ps(one, _mm_sqrt_ps(_mm_max_ps(Dot(nx, ny, nz, nx, ny, nz), epsilonSq)));
+            nx = _mm_mul_ps(nx, nInv);
+            ny = _mm_mul_ps(ny, nInv);
+            nz = _mm_mul_ps(nz, nInv);
+
+            _mm_storeu_ps(&b.dirX[i], Select(clampTurn, nx, wx));
+            _mm_storeu_ps(&b.dirY[i], Select(clampTurn, ny, wy));
+            _mm_storeu_ps(&b.dirZ[i], Select(clampTurn, nz, wz));
+            _mm_storeu_ps(&b.speed[i], _mm_max_ps(speed, _mm_set1_ps(MIN_SPEED)));
+        }
+    }
+#endif
+
+    //wĂ weak_ptr 
+    inline bool IsSameTarget(const std::weak_ptr<GameObject>& a, const std::weak_ptr<GameObject>& b)
+    {
+        return !a.owner_before(b) && !b.owner_before(a);
+    }
+}
+
+void HomingSwarm::Batch::Resize(size_t n)
+{
+    count = n;
+
+    //SSE  4 ǂ߂悤ɗ] 0 Ŗ߂
+    const size_t padded = (n + 3) & ~static_cast<size_t>(3);
+    for (std::vector<float>* v : { &posX, &posY, &posZ, &dirX, &dirY, &dirZ, &speed,
+        &targetX, &targetY, &targetZ, &targetVelX, &targetVelY, &targetVelZ,
+        &biasX, &biasY, &biasZ, &biasStrength, &biasDecay, &timeToIntercept, &cosTurn, &sinTurn, &dt })
+    {
+        v->resize(padded);
+        std::fill(v->begin() + n, v->end(), 0.0f);
+    }
+}
+
+void HomingSwarm::Steer(SWARM_KERNEL kernel, Batch& batch)
+{
+#if defined(HOMING_SWARM_SSE)
+    if (kernel == SWARM_SSE)
+    {
+        SteerSse(batch, batch.count);
+        return;
+    }
+#endif
+    SteerScalar(batch, 0, batch.count);
+}
+
+const char* HomingSwarm::GetKernelName(SWARM_KERNEL kernel)
+{
+    switch (kernel)
+    {
+    case SWARM_SCALAR: return "Scalar";
+    case SWARM_SSE:    return "SSE";
+    default:           return "?";
+    }
+}
+
+void HomingSwarm::Submit(HomingComponent* homing, float dt)
+{
+    homing->m_stepDt = dt;
+
+    if (m_batched)
+    {
+        m_pending.push_back(homing);
+        return;
+    }
+
+    //ob`Ȃ͍܂Œʂ肻̏1(̑x1ς)
+    m_targets.clear();
+    const Target& target = FindTarget(homing, dt);
+    if (!target.alive)
+    {
+        return;
+    }
+
+    m_batch.Resize(1);
+    Gather(homing, target, 0);
+    SteerScalar(m_batch, 0, 1);
+    Scatter(homing, 0);
+}
+
+void HomingSwarm::Cancel(HomingComponent* homing)
+{
+    m_pending.erase(std::remove(m_pending.begin(), m_pending.end(), homing), m_pending.end());
+}
+
+void HomingSwarm::Flush(float dt)
+{
+    if (m_pending.empty())
+    {
+        return;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    //育Ƃ1񂾂 lock đxςAW߂
+    m_targets.clear();
+    m_active.clear();
+    m_batch.Resize(m_pending.size());
+
+    size_t count = 0;
+    for (HomingComponent* homing : m_pending)
+    {
+        const Target& target = FindTarget(homing, dt);
+        if (!target.alive)
+        {
+            continue;
+        }
+
+        Gather(homing, target, count);
+        m_active.push_back(homing);
+        ++count;
+    }
+    m_batch.Resize(count);
+
+    //܂Ƃ߂ČvZ
+    Steer(m_kernel, m_batch);
+
+    //߂
+    for (size_t i = 0; i < count; ++i)
+    {
+        Scatter(m_active[i], i);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    m_stats.kernel = m_kernel;
+    m_stats.missiles = static_cast<int>(count);
+    m_stats.targets = static_cast<int>(m_targets.size());
+    m_stats.steerMs = std::chrono::duration<float, std::milli>(end - start).count();
+
+    m_pending.clear();
+    m_active.clear();
+}
+
+void HomingSwarm::Clear()
+{
+    m_pending.clear();
+    m_active.clear();
+    m_targets.clear();
+    m_stats = Stats{};
+}
+
+const HomingSwarm::Target& HomingSwarm::FindTarget(HomingComponent* homing, float dt)
+{
+    //_e͑Č邱Ƃ̂Ō납T
+    for (size_t i = m_targets.size(); i-- > 0;)
+    {
+        if (IsSameTarget(m_targets[i].object, homing->m_target))
+        {
+            return m_targets[i];
+        }
+    }
+
+    Target target;
+    target.object = homing->m_target;
+    if (auto sp = homing->m_target.lock())
+    {
+        //̃t[ Update ̑Öʒu瑬xo
+        target.position = sp->GetPosition();
+        target.velocity = Vector3::Zero;
+        if (dt > EPSILON)
+        {
+            target.velocity = (target.position - sp->GetPrevPosition()) / dt;
+        }
+        target.alive = true;
+    }
+
+    m_targets.push_back(target);
+    return m_targets.back();
+}
+
+void HomingSwarm::Gather(HomingComponent* homing, const Target& target, size_t i)
+{
+    const BulletComponent* bullet = homing->m_bullet;
+    const Vector3& pos = homing->GetOwner()->GetPosition();
+
+    //͐Kēn([ɋ߂ΑO)
+    Vector3 dir = bullet->GetVelocity();
+    if (dir.LengthSquared() < EPSILON_SQ)
+    {
+        dir = Vector3::UnitZ;
+    }
+    else
+    {
+        dir.Normalize();
+    }
+    const float speed = bullet->GetSpeed();
+    const float dt = homing->m_stepDt;
+
+    //Ȃpx : ̏ƁẢx̏(a = v * )̏
+    float turnRateDeg = homing->m_maxTurnRateDeg;
+    if (turnRateDeg <= 0.0f)
+    {
+        turnRateDeg = DEFAULT_TURN_RATE_DEG;
+    }
+    float maxTurn = turnRateDeg * dt * DEG2RAD;
+    if (homing->m_maxAcceleration > 0.0f && speed > MIN_SPEED)
+    {
+        maxTurn = std::min(maxTurn, homing->m_maxAcceleration * dt / speed);
+    }
+    maxTurn = std::min(maxTurn, PI);
+
+    m_batch.posX[i] = pos.x;
+    m_batch.posY[i] = pos.y;
+    m_batch.posZ[i] = pos.z;
+    m_batch.dirX[i] = dir.x;
+    m_batch.dirY[i] = dir.y;
+    m_batch.dirZ[i] = dir.z;
+    m_batch.speed[i] = speed;
+    m_batch.targetX[i] = target.position.x;
+    m_batch.targetY[i] = target.position.y;
+    m_batch.targetZ[i] = target.position.z;
+    m_batch.targetVelX[i] = target.velocity.x;
+    m_batch.targetVelY[i] = target.velocity.y;
+    m_batch.targetVelZ[i] = target.velocity.z;
+    m_batch.biasX[i] = homing->m_aimBias.x;
+    m_batch.biasY[i] = homing->m_aimBias.y;
+    m_batch.biasZ[i] = homing->m_aimBias.z;
+    m_batch.biasStrength[i] = homing->m_aimBiasStrength;
+    m_batch.biasDecay[i] = homing->m_aimBiasDecay;
+    m_batch.timeToIntercept[i] = homing->m_timeToIntercept;
+    m_batch.cosTurn[i] = std::cos(maxTurn);
+    m_batch.sinTurn[i] = std::sin(maxTurn);
+    m_batch.dt[i] = dt;
+}
+
+void HomingSwarm::Scatter(HomingComponent* homing, size_t i)
+{
+    //ʒu BulletComponent  Update Ői߂
+    homing->m_bullet->SetVelocity(Vector3(m_batch.dirX[i], m_batch.dirY[i], m_batch.dirZ[i]));
+    homing->m_bullet->SetSpeed(m_batch.speed[i]);
+    homing->m_aimBiasStrength = m_batch.biasStrength[i];
+}
+
+void HomingSwarm::RunSwarmBenchmark(std::vector<std::string>& outLines)
+{
+    const bool batched = m_batched;
+    const SWARM_KERNEL kernel = m_kernel;
+    const Stats stats = m_stats;
+
+    const int missileCounts[] = { 100, 500, 2000, 10000 };
+    const int frames = 60;
+    const float dt = 1.0f / 60.0f;
+
+    const int modeCount = 3;
+    const char* modeNames[modeCount] = { "per-object", "batch scalar", "batch SSE" };
+
+    char buf[256];
+    sprintf_s(buf, "Homing swarm benchmark (%d frames, ms / frame, 4 targets)", frames);
+    outLines.push_back(buf);
+
+    for (int count : missileCounts)
+    {
+        double ms[modeCount] = {};
+        std::vector<Vector3> finalPositions[modeCount];
+
+        for (int mode = 0; mode < modeCount; ++mode)
+        {
+#if !defined(HOMING_SWARM_SSE)
+            if (mode == 2) { continue; }
+#endif
+            m_batched = (mode != 0);
+            m_kernel = (mode == 2) ? SWARM_SSE : SWARM_SCALAR;
+
+            //C̈Ďˌ̂悤ɐ猂A~`ē鑊ǂ킹
+            std::vector<std::shared_ptr<GameObject>> targets;
+            for (int t = 0; t < 4; ++t)
+            {
+                auto target = std::make_shared<GameObject>();
+                target->SetPosition(Vector3(static_cast<float>(t) * 50.0f, 10.0f, 200.0f));
+                targets.push_back(target);
+            }
+
+            std::vector<std::shared_ptr<GameObject>> missiles;
+            missiles.reserve(count);
+            for (int i = 0; i < count; ++i)
+            {
+                const float angle = static_cast<float>(i) * 2.39996323f;   //pł΂炯
+                auto obj = std::make_shared<GameObject>();
+                obj->SetPosition(Vector3(static_cast<float>(i % 40) * 5.0f, 0.0f, static_cast<float>(i / 40) * 0.5f));
+
+                auto bullet = obj->AddComponent<BulletComponent>();
+                bullet->SetVelocity(Vector3(0.0f, 0.0f, 1.0f));
+                bullet->SetSpeed(100.0f);
+                bullet->SetLifetime(1000.0f);
+
+                auto homing = obj->AddComponent<HomingComponent>();
+                homing->SetTarget(targets[i % targets.size()]);
+                homing->SetLifeTime(1000.0f);
+                homing->SetAimBias(Vector3(std::cos(angle), std::sin(angle), 0.0f));
+                homing->SetAimBiasStrength(0.6f);
+                homing->SetAimBiasDecay(0.5f);
+
+                obj->Initialize();
+                missiles.push_back(obj);
+            }
+
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int f = 0; f < frames; ++f)
+            {
+                const float time = static_cast<float>(f) * dt;
+                for (size_t t = 0; t < targets.size(); ++t)
+                {
+                    //Update őÖʒuoĂ瓮
+                    targets[t]->Update(dt);
+                    const float phase = time * 2.0f + static_cast<float>(t);
+                    targets[t]->SetPosition(Vector3(static_cast<float>(t) * 50.0f + std::cos(phase) * 40.0f, 10.0f, 200.0f + std::sin(phase) * 40.0f));
+                }
+
+                for (auto& obj : missiles)
+                {
+                    obj->Update(dt);
+                }
+                Flush(dt);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+
+            ms[mode] = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+
+            for (auto& obj : missiles)
+            {
+                finalPositions[mode].push_back(obj->GetPosition());
+            }
+        }
+
+        //SSE ƃXJ[̂
+        float maxDiff = 0.0f;
+        if (!finalPositions[2].empty())
+        {
+            for (size_t i = 0; i < finalPositions[1].size(); ++i)
+            {
+                maxDiff = std::max(maxDiff, (finalPositions[2][i] - finalPositions[1][i]).Length());
+            }
+        }
+
+        sprintf_s(buf, "  %5d missiles : %s %.3f / %s %.3f / %s %.3f (x%.1f), SSE diff pos %.5f",
+            count, modeNames[0], ms[0], modeNames[1], ms[1], modeNames[2], ms[2],
+            ms[2] > 0.0 ? ms[0] / ms[2] : 0.0, maxDiff);
+        outLines.push_back(buf);
+    }
+
+    m_batched = batched;
+    m_kernel = kernel;
+    m_stats = stats;
+    m_pending.clear();
+    m_targets.clear();
+}
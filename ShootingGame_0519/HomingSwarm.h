@@ -0,0 +1,108 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <SimpleMath.h>
+
+class GameObject;
+class HomingComponent;
+
+//---------------------------------------------------------
+// ǔe(HomingComponent)̌}vZ܂Ƃ߂čsNX
+// HomingComponent::Update ͎i߂Ď Submit 邾ɂāA
+// Flush ő_Ă鑊育Ƃ1񂾂xς(weak_ptr  lock 1)A
+// ëʒuEEËʒuƑxz(SoA)ɏW߂
+// }Ԃ̓񎟕  _  Ex̐ 1̃[vŉ
+// (SSE ł 4 ܂Ƃ߂ČvZ)
+//---------------------------------------------------------
+class HomingSwarm
+{
+public:
+    enum SWARM_KERNEL
+    {
+        SWARM_SCALAR,
+        SWARM_SSE,
+
+        MAX_SWARM_KERNEL
+    };
+
+    //SoA ̓o(Resize  4 ̔{ɂ낦A] 0 Ŗ߂)
+    struct Batch
+    {
+        std::vector<float> posX, posY, posZ;
+        std::vector<float> dirX, dirY, dirZ;                    //:̌(Kς) o:Ȃ̌
+        std::vector<float> speed;                               //o͍͂Œᑬxۏ؂l
+        std::vector<float> targetX, targetY, targetZ;
+        std::vector<float> targetVelX, targetVelY, targetVelZ;  //育Ƃ̌ςʂ
+        std::vector<float> biasX, biasY, biasZ;                 //ˎ̂΂炯(PʃxNg)
+        std::vector<float> biasStrength;                        //:̋ o:̋
+        std::vector<float> biasDecay;
+        std::vector<float> timeToIntercept;                     //Ɏg}
+        std::vector<float> cosTurn, sinTurn;                    //̃XebvŋȂpx(Ɖx̐̏)
+        std::vector<float> dt;
+        size_t count = 0;
+
+        void Resize(size_t n);
+    };
+
+    struct Stats
+    {
+        SWARM_KERNEL kernel = SWARM_SCALAR;
+        int missiles = 0;       //߂ Flush œe
+        int targets = 0;        //̒e_Ă̐
+        float steerMs = 0.0f;   //ςEW߂EvZE߂̍v
+    };
+
+    //HomingComponent::Update Ă(ob`Ȃ͂̏1vZ)
+    static void Submit(HomingComponent* homing, float dt);
+
+    //j鎞ɊO(Flush OɏĂ߂Ȃ)
+    static void Cancel(HomingComponent* homing);
+
+    //IuWFNg Update ̌ɌĂ(dt ͑̑xςt[̎)
+    static void Flush(float dt);
+
+    static void Clear();
+
+    //batch.count vZ(x`}[N璼ڌĂ)
+    static void Steer(SWARM_KERNEL kernel, Batch& batch);
+
+    //--------Set֐-------
+    static void SetBatched(bool batched) { m_batched = batched; }
+    static void SetKernel(SWARM_KERNEL kernel) { m_kernel = kernel; }
+
+    //--------Get֐-------
+    static bool IsBatched() { return m_batched; }
+    static SWARM_KERNEL GetKernel() { return m_kernel; }
+    static const Stats& GetStats() { return m_stats; }
+    static const char* GetKernelName(SWARM_KERNEL kernel);
+
+    //100 ` 10000  1 Update ƃob`Ŕׂ(DebugBenchmark ɓo^)
+    static void RunSwarmBenchmark(std::vector<std::string>& outLines);
+
+private:
+    //_Ă鑊(Flush Ƃɍ蒼)
+    struct Target
+    {
+        std::weak_ptr<GameObject> object;
+        DirectX::SimpleMath::Vector3 position;
+        DirectX::SimpleMath::Vector3 velocity;
+        bool alive = false;
+    };
+
+    //homing ̑ m_targets T( lock đxςđ)
+    static const Target& FindTarget(HomingComponent* homing, float dt);
+
+    static void Gather(HomingComponent* homing, const Target& target, size_t index);
+    static void Scatter(HomingComponent* homing, size_t index);
+
+    static std::vector<HomingComponent*> m_pending;
+    static std::vector<HomingComponent*> m_active;      //Flush ő肪Ăe(batch Ɠ)
+    static std::vector<Target> m_targets;
+    static Batch m_batch;
+
+    static bool m_batched;
+    static SWARM_KERNEL m_kernel;
+    static Stats m_stats;
+};
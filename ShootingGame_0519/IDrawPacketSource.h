@@ -0,0 +1,23 @@
+#pragma once
+#include <DirectXCollision.h>
+
+class DrawPacketList;
+
+//`惊Xg쐬ɓn
+struct DrawBuildContext
+{
+    DirectX::BoundingFrustum frustum;   //[hԂ̎(JOp)
+};
+
+/// <summary>
+/// `pPbg[J[XbhōIuWFNg̃C^[tF[X
+/// BuildDrawPackets ͕Xbh瓯ɌĂ΂̂ŁA
+/// ̏Ԃǂނɂ D3D ̌ĂяoȂ
+/// </summary>
+class IDrawPacketSource
+{
+public:
+    virtual ~IDrawPacketSource() = default;
+
+    virtual void BuildDrawPackets(const DrawBuildContext& context, DrawPacketList& out) const = 0;
+};
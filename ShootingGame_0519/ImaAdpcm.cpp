@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cstring>
+#include "ImaAdpcm.h"
+
+namespace
+{
+    constexpr int STEP_TABLE[89] =
+    {
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17,
+        19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+        50, 55, 60, 66, 73, 80, 88, 97, 107, 118,
+        130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+        337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+        876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+        2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358,
+        5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+        15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+    };
+
+    constexpr int INDEX_TABLE[16] =
+    {
+        -1, -1, -1, -1, 2, 4, 6, 8,
+        -1, -1, -1, -1, 2, 4, 6, 8
+    };
+
+    //`l1̗\
+    struct Predictor
+    {
+        int sample = 0;
+        int index = 0;
+
+        int Decode(int nibble)
+        {
+            const int step = STEP_TABLE[index];
+
+            int diff = step >> 3;
+            if (nibble & 1) { diff += step >> 2; }
+            if (nibble & 2) { diff += step >> 1; }
+            if (nibble & 4) { diff += step; }
+            if (nibble & 8) { diff = -diff; }
+
+            sample = std::clamp(sample + diff, -32768, 32767);
+            index = std::clamp(index + INDEX_TABLE[nibble], 0, 88);
+            return sample;
+        }
+
+        int Encode(int target)
+        {
+            const int step = STEP_TABLE[index];
+            int diff = target - sample;
+
+            int nibble = 0;
+            if (diff < 0)
+            {
+                nibble = 8;
+                diff = -diff;
+            }
+
+            int threshold = step;
+            if (diff >= threshold) { nibble |= 4; diff -= threshold; }
+            threshold >>= 1;
+            if (diff >= threshold) { nibble |= 2; diff -= threshold; }
+            threshold >>= 1;
+            if (diff >= threshold) { nibble |= 1; }
+
+            //ƓvZŗ\li߂(덷܂Ȃ)
+            Decode(nibble);
+            return nibble;
+        }
+    };
+
+    int16_t ReadI16(const uint8_t* p)
+    {
+        return static_cast<int16_t>(p[0] | (p[1] << 8));
+    }
+}
+
+namespace ImaAdpcm
+{
+    int GetFramesPerBlock(int blockAlign, int channels)
+    {
+        if (channels <= 0 || blockAlign <= 4 * channels) { return 0; }
+        return (blockAlign - 4 * channels) * 2 / channels + 1;
+    }
+
+    int GetBlockAlign(int framesPerBlock, int channels)
+    {
+        //wb_1Tv 8 Tv(4 oCg)Pʂɐ؂グ
+        const int groups = (std::max(framesPerBlock - 1, 8) + 7) / 8;
+        return channels * (4 + groups * 4);
+    }
+
+    void DecodeBlock(const uint8_t* block, int blockAlign, int channels, int16_t* out)
+    {
+        const int frames = GetFramesPerBlock(blockAlign, channels);
+
+        Predictor predictors[2];
+        for (int c = 0; c < channels; ++c)
+        {
+            predictors[c].sample = ReadI16(block + c * 4);
+            predictors[c].index = std::clamp(static_cast<int>(block[c * 4 + 2]), 0, 88);
+            out[c] = static_cast<int16_t>(predictors[c].sample);
+        }
+
+        //`l 4 oCg(8 Tv)݂ɕł
+        const uint8_t* data = block + channels * 4;
+        const int groups = (frames - 1) / 8;
+        for (int g = 0; g < groups; ++g)
+        {
+            for (int c = 0; c < channels; ++c)
+            {
+                const uint8_t* bytes = data + (g * channels + c) * 4;
+                for (int i = 0; i < 8; ++i)
+                {
+                    const int nibble = (i & 1) ? (bytes[i >> 1] >> 4) : (bytes[i >> 1] & 0x0F);
+                    const int frame = 1 + g * 8 + i;
+                    out[frame * channels + c] = static_cast<int16_t>(predictors[c].Decode(nibble));
+                }
+            }
+        }
+    }
+
+    void EncodeBlock(const int16_t* in, int frames, int channels, uint8_t* out, int blockAlign, int* stepIndex)
+    {
+        const int blockFrames = GetFramesPerBlock(blockAlign, channels);
+        memset(out, 0, blockAlign);
+
+        auto sampleAt = [&](int frame, int c) -> int
+        {
+            if (frames <= 0) { return 0; }
+            return in[std::min(frame, frames - 1) * channels + c];
+        };
+
+        Predictor predictors[2];
+        for (int c = 0; c < channels; ++c)
+        {
+            const int first = sampleAt(0, c);
+            predictors[c].sample = first;
+            predictors[c].index = std::clamp(stepIndex[c], 0, 88);
+
+            out[c * 4] = static_cast<uint8_t>(first & 0xFF);
+            out[c * 4 + 1] = static_cast<uint8_t>((first >> 8) & 0xFF);
+            out[c * 4 + 2] = static_cast<uint8_t>(predictors[c].index);
+        }
+
+        uint8_t* data = out + channels * 4;
+        const int groups = (blockFrames - 1) / 8;
+        for (int g = 0; g < groups; ++g)
+        {
+            for (int c = 0; c < channels; ++c)
+            {
+                uint8_t* bytes = data + (g * channels + c) * 4;
+                for (int i = 0; i < 8; ++i)
+                {
+                    const int nibble = predictors[c].Encode(sampleAt(1 + g * 8 + i, c));
+                    bytes[i >> 1] |= static_cast<uint8_t>((i & 1) ? (nibble << 4) : nibble);
+                }
+            }
+        }
+
+        for (int c = 0; c < channels; ++c)
+        {
+            stepIndex[c] = predictors[c].index;
+        }
+    }
+}
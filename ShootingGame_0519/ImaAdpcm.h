@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+//---------------------------------------------------------
+// IMA-ADPCM (WAV  wFormatTag = 0x11) ̕E
+// 1Tv 4bit Ȃ̂ 16bit PCM ̖ 1/4 ̑傫ɂȂ
+// ubN̓Ƀ`l̗\lEXebv̂ŁAubNPʂ
+// ǂłł(Xg[~OE[v̊߂ɌĂ)
+//---------------------------------------------------------
+namespace ImaAdpcm
+{
+    constexpr uint16_t WAVE_FORMAT_IMA_ADPCM = 0x11;
+
+    //ubN1ɓt[(wb_1Tv + 4bit ̃Tv)
+    int GetFramesPerBlock(int blockAlign, int channels);
+
+    //t[ubN̑傫(`l 8 TvP)
+    int GetBlockAlign(int framesPerBlock, int channels);
+
+    //block 𕜍 out(C^[u 16bit) GetFramesPerBlock 
+    void DecodeBlock(const uint8_t* block, int blockAlign, int channels, int16_t* out);
+
+    //in(C^[u 16bit) frames t[1ubNɕ
+    //frames 1ubN菭Ȃ͍Ō̃TvJԂĖ߂
+    //stepIndex : `l̃Xebv(ÕubNpƓ̉rȂ)
+    void EncodeBlock(const int16_t* in, int frames, int channels, uint8_t* out, int blockAlign, int* stepIndex);
+}
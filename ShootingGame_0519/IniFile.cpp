@@ -0,0 +1,443 @@
+#if defined(_MSC_VER) && !defined(_CRT_SECURE_NO_WARNINGS)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <cstring>
+#include "IniFile.h"
+
+namespace
+{
+    //Ő󔒂͈
+    void Trim(const char*& begin, const char*& end)
+    {
+        while (begin < end && (*begin == ' ' || *begin == '\t')) { ++begin; }
+        while (end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) { --end; }
+    }
+
+    //Windows ł͏o̓EBhEAȊO͕WG[ɏo
+    void Log(const std::string& message)
+    {
+#ifdef _WIN32
+        OutputDebugStringA(message.c_str());
+#else
+        fputs(message.c_str(), stderr);
+#endif
+    }
+}
+
+bool IniFile::Load(const std::string& filePath)
+{
+    m_fileName = filePath;
+    m_sections.clear();
+    m_sectionIndex.clear();
+    m_loaded = false;
+
+    std::error_code ec;
+    m_writeTime = std::filesystem::last_write_time(m_fileName, ec);
+    if (ec)
+    {
+        m_writeTime = {};
+        return false;
+    }
+
+    FILE* fp = fopen(m_fileName.c_str(), "rb");
+    if (!fp)
+    {
+        Log("IniFile: cannot open " + m_fileName + "\n");
+        return false;
+    }
+
+    std::string text;
+    char buf[4096];
+    size_t read = 0;
+    while ((read = fread(buf, 1, sizeof(buf), fp)) > 0)
+    {
+        text.append(buf, read);
+    }
+    fclose(fp);
+
+    Parse(text.data(), text.size());
+    m_loaded = true;
+    return true;
+}
+
+void IniFile::Parse(const char* data, size_t size)
+{
+    const char* p = data;
+    const char* end = data + size;
+
+    //UTF-8  BOM ͔΂
+    if (size >= 3 && static_cast<unsigned char>(p[0]) == 0xEF &&
+        static_cast<unsigned char>(p[1]) == 0xBB && static_cast<unsigned char>(p[2]) == 0xBF)
+    {
+        p += 3;
+    }
+
+    m_crlf = false;
+
+    //擪̃ZNVO̍s閼OZNV
+    m_sections.push_back(Section());
+    Section* current = &m_sections.back();
+
+    while (p < end)
+    {
+        const char* lineEnd = static_cast<const char*>(memchr(p, '\n', end - p));
+        if (!lineEnd) { lineEnd = end; }
+        if (lineEnd > p && lineEnd[-1] == '\r') { m_crlf = true; }
+
+        const char* begin = p;
+        const char* last = lineEnd;
+        Trim(begin, last);
+
+        Line line;
+        if (begin < last && *begin == '[')
+        {
+            //[ZNV]
+            const char* close = static_cast<const char*>(memchr(begin, ']', last - begin));
+            const char* nameBegin = begin + 1;
+            const char* nameEnd = close ? close : last;
+            Trim(nameBegin, nameEnd);
+
+            Section section;
+            section.name.assign(nameBegin, nameEnd);
+
+            //O2oĂŏ̕g(GetPrivateProfileString Ɠ)
+            m_sectionIndex.emplace(ToLower(section.name), m_sections.size());
+            m_sections.push_back(std::move(section));
+            current = &m_sections.back();
+        }
+        else if (begin < last && *begin != ';' && *begin != '#' &&
+            memchr(begin, '=', last - begin))
+        {
+            //L[=l
+            const char* equal = static_cast<const char*>(memchr(begin, '=', last - begin));
+            const char* keyEnd = equal;
+            const char* valueBegin = equal + 1;
+            const char* valueEnd = last;
+            Trim(begin, keyEnd);
+            Trim(valueBegin, valueEnd);
+
+            //"l" ȂpO
+            if (valueEnd - valueBegin >= 2 && *valueBegin == '"' && valueEnd[-1] == '"')
+            {
+                ++valueBegin;
+                --valueEnd;
+            }
+
+            line.key.assign(begin, keyEnd);
+            line.value.assign(valueBegin, valueEnd);
+            ParseNumber(line);
+
+            current->keyIndex.emplace(ToLower(line.key), current->lines.size());
+            current->lines.push_back(std::move(line));
+        }
+        else
+        {
+            //RgEs͂̂܂܎c
+            const char* rawEnd = (lineEnd > p && lineEnd[-1] == '\r') ? lineEnd - 1 : lineEnd;
+            line.raw.assign(p, rawEnd);
+            current->lines.push_back(std::move(line));
+        }
+
+        p = (lineEnd < end) ? lineEnd + 1 : end;
+    }
+}
+
+void IniFile::ParseNumber(Line& line)
+{
+    line.hasNumber = false;
+    line.number = 0.0;
+    if (line.value.empty())
+    {
+        return;
+    }
+
+    char* parseEnd = nullptr;
+    const double number = std::strtod(line.value.c_str(), &parseEnd);
+    if (parseEnd != line.value.c_str())
+    {
+        line.hasNumber = true;
+        line.number = number;
+    }
+}
+
+bool IniFile::Save()
+{
+    if (m_fileName.empty())
+    {
+        return false;
+    }
+
+    const char* newline = m_crlf ? "\r\n" : "\n";
+
+    std::string text;
+    for (size_t i = 0; i < m_sections.size(); ++i)
+    {
+        const Section& section = m_sections[i];
+        if (i > 0)
+        {
+            text += "[" + section.name + "]" + newline;
+        }
+        for (const Line& line : section.lines)
+        {
+            text += line.key.empty() ? line.raw : line.key + "=" + line.value;
+            text += newline;
+        }
+    }
+
+    //rŗĂݒ肪Ȃ悤ɁAIĂ獷ւ
+    const std::string tempPath = m_fileName + ".tmp";
+    FILE* fp = fopen(tempPath.c_str(), "wb");
+    if (!fp)
+    {
+        Log("IniFile: cannot write " + m_fileName + "\n");
+        return false;
+    }
+
+    bool ok = fwrite(text.data(), 1, text.size(), fp) == text.size();
+    ok = (fclose(fp) == 0) && ok;
+
+    std::error_code ec;
+    if (ok)
+    {
+        std::filesystem::rename(tempPath, m_fileName, ec);
+    }
+    if (!ok || ec)
+    {
+        std::filesystem::remove(tempPath, ec);
+        Log("IniFile: cannot write " + m_fileName + "\n");
+        return false;
+    }
+
+    //ŏ HasChanged ɏoȂ
+    m_writeTime = std::filesystem::last_write_time(m_fileName, ec);
+    m_loaded = true;
+    return true;
+}
+
+bool IniFile::HasChanged() const
+{
+    std::error_code ec;
+    const auto writeTime = std::filesystem::last_write_time(m_fileName, ec);
+    if (ec)
+    {
+        return false;   //GfB^̕ۑȂǂňu͎Ɍ
+    }
+    return writeTime != m_writeTime;
+}
+
+float IniFile::ReadFloat(const char* section, const char* key, float defaultValue) const
+{
+    const Line* line = Find(section, key);
+    if (!line || !line->hasNumber)
+    {
+        return defaultValue;
+    }
+    return static_cast<float>(line->number);
+}
+
+int IniFile::ReadInt(const char* section, const char* key, int defaultValue) const
+{
+    const Line* line = Find(section, key);
+    if (!line || !line->hasNumber)
+    {
+        return defaultValue;
+    }
+    return static_cast<int>(line->number);
+}
+
+std::string IniFile::ReadString(const char* section, const char* key, const std::string& defaultValue) const
+{
+    const Line* line = Find(section, key);
+    if (!line || line->value.empty())
+    {
+        return defaultValue;
+    }
+    return line->value;
+}
+
+void IniFile::WriteFloat(const char* section, const char* key, float value)
+{
+    char buf[64]{};
+    snprintf(buf, sizeof(buf), "%.6f", value);
+    WriteString(section, key, buf);
+}
+
+void IniFile::WriteInt(const char* section, const char* key, int value)
+{
+    char buf[64]{};
+    snprintf(buf, sizeof(buf), "%d", value);
+    WriteString(section, key, buf);
+}
+
+void IniFile::WriteString(const char* section, const char* key, const std::string& value)
+{
+    if (!section || !key) { return; }
+
+    Line& line = FindOrAdd(section, key);
+    line.value = value;
+    ParseNumber(line);
+}
+
+const IniFile::Line* IniFile::Find(const char* section, const char* key) const
+{
+    if (!section || !key)
+    {
+        return nullptr;
+    }
+
+    auto sectionIt = m_sectionIndex.find(ToLower(section));
+    if (sectionIt == m_sectionIndex.end())
+    {
+        return nullptr;
+    }
+
+    const Section& s = m_sections[sectionIt->second];
+    auto keyIt = s.keyIndex.find(ToLower(key));
+    if (keyIt == s.keyIndex.end())
+    {
+        return nullptr;
+    }
+    return &s.lines[keyIt->second];
+}
+
+IniFile::Line& IniFile::FindOrAdd(const char* section, const char* key)
+{
+    if (m_sections.empty())
+    {
+        m_sections.push_back(Section());
+    }
+
+    const std::string sectionName = ToLower(section);
+    auto sectionIt = m_sectionIndex.find(sectionName);
+    if (sectionIt == m_sectionIndex.end())
+    {
+        //ÕZNVƂ̊Ԃɋs
+        Section& prev = m_sections.back();
+        if (!prev.lines.empty() && !(prev.lines.back().key.empty() && prev.lines.back().raw.empty()))
+        {
+            prev.lines.push_back(Line());
+        }
+
+        Section s;
+        s.name = section;
+        sectionIt = m_sectionIndex.emplace(sectionName, m_sections.size()).first;
+        m_sections.push_back(std::move(s));
+    }
+
+    Section& s = m_sections[sectionIt->second];
+    const std::string keyName = ToLower(key);
+    auto keyIt = s.keyIndex.find(keyName);
+    if (keyIt != s.keyIndex.end())
+    {
+        return s.lines[keyIt->second];
+    }
+
+    //ZNV̍Ō̃L[̌ɑ(̋s̓ZNV̋؂Ɏc)
+    size_t insertAt = s.lines.size();
+    while (insertAt > 0 && s.lines[insertAt - 1].key.empty())
+    {
+        --insertAt;
+    }
+
+    Line line;
+    line.key = key;
+    s.lines.insert(s.lines.begin() + insertAt, std::move(line));
+
+    for (auto& entry : s.keyIndex)
+    {
+        if (entry.second >= insertAt) { entry.second++; }
+    }
+    s.keyIndex.emplace(keyName, insertAt);
+    return s.lines[insertAt];
+}
+
+std::string IniFile::ToLower(const std::string& text)
+{
+    std::string lower(text);
+    for (char& c : lower)
+    {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return lower;
+}
+
+void IniFile::RunIniBenchmark(std::vector<std::string>& outLines)
+{
+    //GameScene::LoadPlayerConfigFromIni Ɠ14L[
+    static const char* KEYS[][2] =
+    {
+        { "Player", "MoveSpeed" }, { "Player", "BoostMultiplier" }, { "Player", "BulletSpeed" }, { "Player", "HpMax" },
+        { "Camera", "Distance" }, { "Camera", "Height" }, { "Camera", "FovDeg" }, { "Camera", "BoostFovDeg" }, { "Camera", "Sensitivity" },
+        { "Blur", "Stretch" }, { "Blur", "StartPoint" }, { "Blur", "EndPoint" }, { "Blur", "CenterX" }, { "Blur", "CenterY" },
+    };
+    const int keyCount = static_cast<int>(sizeof(KEYS) / sizeof(KEYS[0]));
+    const int loops = 200;
+
+    //GetPrivateProfileString ͑΃pX Windows tH_T̂Ő΃pXɂ
+    std::error_code ec;
+    const std::string path = (std::filesystem::temp_directory_path(ec) / "IniBenchmark.ini").string();
+
+    IniFile source;
+    source.m_fileName = path;
+    for (int i = 0; i < keyCount; ++i)
+    {
+        source.WriteFloat(KEYS[i][0], KEYS[i][1], static_cast<float>(i) + 0.5f);
+    }
+    if (!source.Save())
+    {
+        outLines.push_back("INI benchmark: cannot write " + path);
+        return;
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+    float sum = 0.0f;
+
+#ifdef _WIN32
+    //1L[ƂɃt@CJĒT(O IniFile)
+    auto profileStart = Clock::now();
+    for (int loop = 0; loop < loops; ++loop)
+    {
+        for (int i = 0; i < keyCount; ++i)
+        {
+            char buf[256]{};
+            if (GetPrivateProfileStringA(KEYS[i][0], KEYS[i][1], "", buf, static_cast<DWORD>(sizeof(buf)), path.c_str()) > 0)
+            {
+                sum += static_cast<float>(std::atof(buf));
+            }
+        }
+    }
+    const double profileMs = std::chrono::duration<double, std::milli>(Clock::now() - profileStart).count();
+#endif
+
+    //1ǂŕ\
+    auto start = Clock::now();
+    for (int loop = 0; loop < loops; ++loop)
+    {
+        IniFile ini;
+        ini.Load(path);
+        for (int i = 0; i < keyCount; ++i)
+        {
+            sum += ini.ReadFloat(KEYS[i][0], KEYS[i][1], 0.0f);
+        }
+    }
+    const double parsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::filesystem::remove(path, ec);
+
+    char buf[256];
+    snprintf(buf, sizeof(buf), "INI benchmark (%d keys x %d loads, checksum %.0f)", keyCount, loops, sum);
+    outLines.push_back(buf);
+#ifdef _WIN32
+    snprintf(buf, sizeof(buf), "  GetPrivateProfileString : %8.3f ms (%.1f us / load)", profileMs, profileMs * 1000.0 / loops);
+    outLines.push_back(buf);
+#endif
+    snprintf(buf, sizeof(buf), "  IniFile (1 read)        : %8.3f ms (%.1f us / load)", parsedMs, parsedMs * 1000.0 / loops);
+    outLines.push_back(buf);
+}
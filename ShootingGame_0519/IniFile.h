@@ -1,131 +1,112 @@
 #pragma once
-#include <Windows.h>
 #include <string>
-#include <cstdlib>
-
+#include <vector>
+#include <unordered_map>
+#include <filesystem>
+
+//---------------------------------------------------------
+// .ini t@C1œǂݍŃ̕\ɂĂNX
+// ERead ̓t@CJɕ\Ԃ(l͓ǂݍݎ1񂾂ϊ)
+// EWrite ͕\邾ŁASave ł܂Ƃ߂ďo(ꎞt@C獷ւ)
+// ERgsAL[̏Ԃ͓ǂݍ񂾂܂܏߂
+// EZNVƃL[ GetPrivateProfileString Ɠ啶ʂȂ
+//---------------------------------------------------------
 class IniFile
 {
 public:
+	IniFile() = default;
+
 	explicit IniFile(const char* filePath)
-		: m_fileName(filePath ? filePath : ""){ }
+	{
+		Load(filePath ? filePath : "");
+	}
+
+	/// <summary>
+	/// t@CŜǂݍŕ\蒼
+	/// </summary>
+	/// <param name="filePath">t@CpX</param>
+	/// <returns>t@CEǂ߂Ȃ false(\͋ɂȂ)</returns>
+	bool Load(const std::string& filePath);
+
+	/// <summary>
+	/// \ǂݍ񂾃t@C֏߂
+	/// </summary>
+	/// <returns>߂Ȃ false(̃t@C͂̂܂)</returns>
+	bool Save();
+
+	/// <summary>
+	/// ǂݍ(܂ Save)̌Ƀt@Cꂽ
+	/// </summary>
+	bool HasChanged() const;
 
 	/// <summary>
 	/// .init@Cfloat̒lǂݍނ߂̊֐
 	/// </summary>
 	/// <param name="section">ZNV</param>
-	/// <param name="kay">L[</param>
+	/// <param name="key">L[</param>
 	/// <param name="defaultValue">ǂݍ߂Ȃۂɓl</param>
 	/// <returns></returns>
-	float ReadFloat(const char* section, const char* kay, float defaultValue) const
-	{
-		if (!section || !kay)
-		{
-			return defaultValue;
-		}
-
-		char buf[256]{};
-		DWORD len = GetPrivateProfileStringA(section, kay, "", buf, static_cast<DWORD>(sizeof(buf)), m_fileName.c_str());
-
-		if(len == 0)
-		{
-			return defaultValue;
-		}
-
-		return static_cast<float>(std::atof(buf));
-	}
+	float ReadFloat(const char* section, const char* key, float defaultValue) const;
 
 	/// <summary>
 	/// .init@Cint̒lǂݍނ߂̊֐
 	/// </summary>
 	/// <param name="section">ZNV</param>
-	/// <param name="kay">L[</param>
+	/// <param name="key">L[</param>
 	/// <param name="defaultValue">ǂݍ߂Ȃۂɓl</param>
 	/// <returns></returns>
-	int ReadInt(const char* section, const char* key, int defaultValue)
-	{
-		if (!section || !key)
-		{
-			return defaultValue;
-		}
-
-		return static_cast<int>(GetPrivateProfileIntA(section, key, defaultValue, m_fileName.c_str()));
+	int ReadInt(const char* section, const char* key, int defaultValue) const;
 
-	}
-	
 	/// <summary>
-	/// 
+	/// .init@C當̂܂ܓǂݍނ߂̊֐
 	/// </summary>
-	/// <param name="section"></param>
-	/// <param name="key"></param>
-	/// <param name="value"></param>
-	/// <returns></returns>
-	bool WriteFloatResult(const char* section, const char* key, float value) const
-	{
-		if (!section || !key)
-		{
-			return false;
-		}
-
-		char buf[64]{};
-		sprintf_s(buf, "%.6f", value);
-
-		bool ok = WritePrivateProfileStringA(section, key, buf, m_fileName.c_str());
-		return ok;
-	}
+	std::string ReadString(const char* section, const char* key, const std::string& defaultValue) const;
 
 	/// <summary>
-	/// 
+	/// l(΃ZNVEL[𑫂)Bt@Cɂ Save ŏ
 	/// </summary>
-	/// <param name="section"></param>
-	/// <param name="key"></param>
-	/// <param name="value"></param>
-	/// <returns></returns>
-	bool WriteIntResult(const char* section, const char* key, int value) const
-	{
-		if (!section || !key)
-		{
-			return false;
-		}
+	void WriteFloat(const char* section, const char* key, float value);
+	void WriteInt(const char* section, const char* key, int value);
+	void WriteString(const char* section, const char* key, const std::string& value);
 
-		char buf[64]{};
-		sprintf_s(buf, "%d", value);
+	//--------Get֐-------
+	bool IsLoaded() const { return m_loaded; }
+	const std::string& GetFileName() const { return m_fileName; }
 
-		bool ok = WritePrivateProfileStringA(section, key, buf, m_fileName.c_str());
-		return ok;
-	}
+	//GetPrivateProfileString 1L[ǂނ̂Ɣׂ(DebugBenchmark ɓo^)
+	static void RunIniBenchmark(std::vector<std::string>& outLines);
 
-	/// <summary>
-	/// 
-	/// </summary>
-	/// <param name="section"></param>
-	/// <param name="key"></param>
-	/// <param name="value"></param>
-	void WriteFloat(const char* section, const char* key, float value) const
+private:
+	//1s(key ȂRgEs raw ̂܂܏߂)
+	struct Line
 	{
-		if (!section || !key){ return; }
+		std::string key;
+		std::string value;
+		std::string raw;
 
-		char buf[64]{};
-		sprintf_s(buf, "%.6f", value);
-		WritePrivateProfileStringA(section, key, buf, m_fileName.c_str());
-	}
+		bool hasNumber = false;
+		double number = 0.0;	//value ǂݍݎɕϊĂ
+	};
 
-	/// <summary>
-	/// 
-	/// </summary>
-	/// <param name="section"></param>
-	/// <param name="key"></param>
-	/// <param name="value"></param>
-	void WriteInt(const char* section, const char* key, int value) const
+	struct Section
 	{
-		if (!section || !key){ return; }
+		std::string name;		//擪̃ZNVO̍s͖O
+		std::vector<Line> lines;
+		std::unordered_map<std::string, size_t> keyIndex;	//̃L[  lines ̔ԍ
+	};
 
-		char buf[64]{};
-		sprintf_s(buf, "%d", value);
-		WritePrivateProfileStringA(section, key, buf, m_fileName.c_str());
-	}
+	const Line* Find(const char* section, const char* key) const;
+	Line& FindOrAdd(const char* section, const char* key);
 
-	
-private:
-	std::string m_fileName;	
-};
+	void Parse(const char* data, size_t size);
+	static void ParseNumber(Line& line);
+	static std::string ToLower(const std::string& text);
 
+	std::string m_fileName;
+	std::vector<Section> m_sections;
+	std::unordered_map<std::string, size_t> m_sectionIndex;	//̃ZNV  m_sections ̔ԍ
+	bool m_loaded = false;
+	bool m_crlf = false;	//̉s CRLF Ȃ珑߂ CRLF
+
+	std::filesystem::file_time_type m_writeTime{};
+};
@@ -0,0 +1,230 @@
+#include "InstanceBatcher.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include "RandomService.h"
+
+namespace
+{
+    //O[v̕`揇(s  A̒̓bVE}eAELOD)
+    //bṼO[vԂ̂Œ_obt@ECAEg̐؂ւ
+    bool GroupKeyLess(const InstanceGroupKey& a, const InstanceGroupKey& b)
+    {
+        if (a.isTransparent != b.isTransparent) { return !a.isTransparent; }
+        if (a.mesh != b.mesh) { return std::less<const void*>()(a.mesh, b.mesh); }
+        if (a.material != b.material) { return std::less<const void*>()(a.material, b.material); }
+        return a.lod < b.lod;
+    }
+}
+
+void InstanceBatcher::Clear()
+{
+    m_pending.clear();
+    m_keyToGroup.clear();
+    m_groups.clear();
+    m_instances.clear();
+}
+
+void InstanceBatcher::Add(const InstanceGroupKey& key,
+                          const DirectX::XMFLOAT4X4& world,
+                          const DirectX::XMFLOAT4& tint)
+{
+    //߂ČL[ȂO[v
+    auto it = m_keyToGroup.find(key);
+    uint32_t groupIndex = 0;
+
+    if (it == m_keyToGroup.end())
+    {
+        groupIndex = static_cast<uint32_t>(m_groups.size());
+        m_keyToGroup.emplace(key, groupIndex);
+
+        InstanceGroup group;
+        group.key = key;
+        m_groups.push_back(group);
+    }
+    else
+    {
+        groupIndex = it->second;
+    }
+
+    m_groups[groupIndex].instanceCount++;
+
+    PendingInstance pending;
+    pending.groupIndex = groupIndex;
+    pending.data.world = world;
+    pending.data.tint = tint;
+    m_pending.push_back(pending);
+}
+
+void InstanceBatcher::Build()
+{
+    m_instances.clear();
+
+    if (m_pending.empty()) { return; }
+
+    //sA̒̓bVE}eAELOD ̏ɕׂ(L[͏dȂ)
+    std::vector<uint32_t> order(m_groups.size());
+    for (uint32_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+
+    std::sort(order.begin(), order.end(),
+        [this](uint32_t a, uint32_t b) { return GroupKeyLess(m_groups[a].key, m_groups[b].key); });
+
+    //eO[v̊Jnʒu߂
+    std::vector<uint32_t> writePos(m_groups.size());
+    uint32_t offset = 0;
+
+    for (uint32_t index : order)
+    {
+        m_groups[index].startInstance = offset;
+        writePos[index] = offset;
+        offset += m_groups[index].instanceCount;
+    }
+
+    //CX^Xl߂
+    m_instances.resize(m_pending.size());
+
+    for (const auto& pending : m_pending)
+    {
+        m_instances[writePos[pending.groupIndex]++] = pending.data;
+    }
+
+    //O[vz`揇ɕבւĂ
+    std::vector<InstanceGroup> sorted;
+    sorted.reserve(m_groups.size());
+
+    for (uint32_t index : order)
+    {
+        sorted.push_back(m_groups[index]);
+    }
+
+    m_groups.swap(sorted);
+    m_keyToGroup.clear();
+    m_pending.clear();
+}
+
+bool InstanceBatcher::RunSelfCheck(std::vector<std::string>& outLines)
+{
+    const int instanceCount = 5000;
+    const int meshCount = 12;
+    const int materialCount = 5;
+    const int lodCount = 3;
+
+    outLines.push_back("Instance batcher self-check (5000 instances, 12 meshes x 5 materials x 3 LODs)");
+
+    //bVE}eA̎ʎq͔z̗vf̃AhXőp
+    static const char meshes[meshCount] = {};
+    static const char materials[materialCount] = {};
+
+    //΂΂̏œo^ACX^X̔ԍsɖ߂Ă
+    InstanceBatcher batcher;
+    std::vector<InstanceGroupKey> keys(instanceCount);
+    std::vector<InstanceData> sources(instanceCount);
+    RandomStream rng(26, 0);
+    for (int i = 0; i < instanceCount; ++i)
+    {
+        InstanceGroupKey& key = keys[i];
+        key.mesh = &meshes[rng.RangeInt(0, meshCount)];
+        key.material = &materials[rng.RangeInt(0, materialCount)];
+        key.lod = static_cast<uint32_t>(rng.RangeInt(0, lodCount));
+        key.isTransparent = rng.Chance(0.2f);
+
+        InstanceData& data = sources[i];
+        for (int r = 0; r < 4; ++r)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                data.world.m[r][c] = rng.Range(-100.0f, 100.0f);
+            }
+        }
+        data.world.m[3][3] = static_cast<float>(i);     //ԍ(Ȃ̂ float ł̂܂ܖ߂)
+        data.tint = DirectX::XMFLOAT4(rng.NextFloat(), rng.NextFloat(), rng.NextFloat(), rng.NextFloat());
+
+        batcher.Add(key, data.world, data.tint);
+    }
+    batcher.Build();
+
+    const std::vector<InstanceGroup>& groups = batcher.GetGroups();
+    const std::vector<InstanceData>& instances = batcher.GetInstances();
+
+    //1. O[v̓L[̏ŁAL[2oĂȂ
+    bool ordered = true;
+    for (size_t g = 1; g < groups.size(); ++g)
+    {
+        if (!GroupKeyLess(groups[g - 1].key, groups[g].key))
+        {
+            ordered = false;
+        }
+    }
+
+    //2. startInstance  0 猄ԖAvCX^Xƍ
+    bool contiguous = true;
+    uint32_t next = 0;
+    for (const InstanceGroup& group : groups)
+    {
+        if (group.startInstance != next || group.instanceCount == 0)
+        {
+            contiguous = false;
+        }
+        next = group.startInstance + group.instanceCount;
+    }
+    contiguous = contiguous && next == static_cast<uint32_t>(instances.size()) && instances.size() == sources.size();
+
+    //3. l߂f[^͌ƓŁÃO[v͈̔͂ɂAO[v͓o^
+    bool roundTrip = contiguous;
+    std::vector<int> seen(instanceCount, 0);
+    for (size_t g = 0; roundTrip && g < groups.size(); ++g)
+    {
+        int previous = -1;
+        for (uint32_t i = groups[g].startInstance; i < groups[g].startInstance + groups[g].instanceCount; ++i)
+        {
+            const int index = static_cast<int>(instances[i].world.m[3][3]);
+            if (index < 0 || index >= instanceCount || index <= previous ||
+                !(keys[index] == groups[g].key) ||
+                std::memcmp(&instances[i], &sources[index], sizeof(InstanceData)) != 0)
+            {
+                roundTrip = false;
+                break;
+            }
+            seen[index]++;
+            previous = index;
+        }
+    }
+    for (int count : seen)
+    {
+        roundTrip = roundTrip && count == 1;
+    }
+
+    //4. bVE}eAELOD ̑gݍ킹SO[vɏoĂ
+    std::vector<bool> covered(static_cast<size_t>(meshCount) * materialCount * lodCount, false);
+    for (const InstanceGroup& group : groups)
+    {
+        const std::ptrdiff_t mesh = static_cast<const char*>(group.key.mesh) - meshes;
+        const std::ptrdiff_t material = static_cast<const char*>(group.key.material) - materials;
+        if (mesh >= 0 && mesh < meshCount && material >= 0 && material < materialCount && group.key.lod < static_cast<uint32_t>(lodCount))
+        {
+            covered[(static_cast<size_t>(mesh) * materialCount + material) * lodCount + group.key.lod] = true;
+        }
+    }
+    const int coveredCount = static_cast<int>(std::count(covered.begin(), covered.end(), true));
+    const bool coverage = coveredCount == static_cast<int>(covered.size());
+
+    char buf[256];
+    snprintf(buf, sizeof(buf), "  groups ordered by transparency / mesh / material / lod : %s (%zu groups)",
+        ordered ? "OK" : "FAIL", groups.size());
+    outLines.push_back(buf);
+    snprintf(buf, sizeof(buf), "  startInstance contiguous : %s", contiguous ? "OK" : "FAIL");
+    outLines.push_back(buf);
+    snprintf(buf, sizeof(buf), "  packed data round-trip   : %s", roundTrip ? "OK" : "FAIL");
+    outLines.push_back(buf);
+    snprintf(buf, sizeof(buf), "  key coverage             : %s (%d / %zu)", coverage ? "OK" : "FAIL", coveredCount, covered.size());
+    outLines.push_back(buf);
+
+    const bool passed = ordered && contiguous && roundTrip && coverage;
+    outLines.push_back(passed ? "  result : PASS" : "  result : FAIL");
+    return passed;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include <DirectXMath.h>
+
+//---------------------------------------------------------
+// CX^X`̃O[vƃCX^Xobt@̋lߍ݂sNX
+// GPUɂ͈ؐGȂ̂ŁAfoCXłʂmFł
+//---------------------------------------------------------
+
+//CX^X1̃f[^(CX^Xobt@1vf)
+struct InstanceData
+{
+    DirectX::XMFLOAT4X4 world;  //[hs(SimpleMath̍sxNg`̂܂)
+    DirectX::XMFLOAT4   tint;   //FEAt@
+};
+static_assert(sizeof(InstanceData) == 80, "InstanceData size mismatch");
+
+//O[ṽL[(bVELODxE}eȂg)
+struct InstanceGroupKey
+{
+    const void* mesh = nullptr;       //bV̎ʎq
+    const void* material = nullptr;   //}eA(eNX`)̎ʎq
+    uint32_t lod = 0;                 //LODx(xɃCfbNXobt@Ⴄ)
+    bool isTransparent = false;       //Ȃtrue(šɂ܂Ƃ߂ĕ`)
+
+    bool operator==(const InstanceGroupKey& other) const
+    {
+        return mesh == other.mesh &&
+               material == other.material &&
+               lod == other.lod &&
+               isTransparent == other.isTransparent;
+    }
+};
+
+//DrawIndexedInstanced 1񕪂̃O[v
+struct InstanceGroup
+{
+    InstanceGroupKey key;
+    uint32_t startInstance = 0;   //CX^Xobt@̊Jnʒu
+    uint32_t instanceCount = 0;   //CX^X
+};
+
+class InstanceBatcher
+{
+public:
+    //t[JnɌĂ
+    void Clear();
+
+    //CX^X1o^
+    void Add(const InstanceGroupKey& key,
+             const DirectX::XMFLOAT4X4& world,
+             const DirectX::XMFLOAT4& tint);
+
+    //o^ꂽCX^XO[vɋlߒ
+    //(sO[vAO[vB̒̓bVE}eAELOD ̏BO[v͓o^)
+    void Build();
+
+    //--------Get֐-------
+    const std::vector<InstanceData>& GetInstances() const { return m_instances; }
+    const std::vector<InstanceGroup>& GetGroups() const { return m_groups; }
+    size_t GetPendingCount() const { return m_pending.size(); }
+
+    //GPU ŃO[v̕сEstartInstance ̘AEl߂f[^̈vm߂
+    //(DebugBenchmark  main  --self-check ĂԁB߂l : Sʂ true)
+    static bool RunSelfCheck(std::vector<std::string>& outLines);
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const InstanceGroupKey& k) const
+        {
+            size_t h = std::hash<const void*>()(k.mesh);
+            h ^= std::hash<const void*>()(k.material) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= static_cast<size_t>(k.lod) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h ^ (k.isTransparent ? 0x5bd1e995 : 0);
+        }
+    };
+
+    struct PendingInstance
+    {
+        uint32_t groupIndex;
+        InstanceData data;
+    };
+
+    std::vector<PendingInstance> m_pending;                         //o^̃CX^X
+    std::unordered_map<InstanceGroupKey, uint32_t, KeyHash> m_keyToGroup;
+    std::vector<InstanceGroup> m_groups;                            //Build̃O[v
+    std::vector<InstanceData> m_instances;                          //Build̃CX^Xz
+};
@@ -0,0 +1,24 @@
+// CX^X`p̃sNZVF[_[
+// BasicPixelShader ƓA}eA Diffuse ̓At@̂ݔf
+
+Texture2D texDiffuse : register(t0);
+SamplerState sampLinear : register(s0);
+
+struct PSInput
+{
+    float4 posH     : SV_POSITION;
+    float4 col      : COLOR;
+    float3 normal   : NORMAL;
+    float2 texcoord : TEXCOORD;
+    float4 tint     : INSTCOLOR;
+};
+
+float4 PSMain(PSInput input) : SV_TARGET
+{
+    float4 texColor = texDiffuse.Sample(
+        sampLinear,
+        float2(input.texcoord.x, 1.0f - input.texcoord.y)
+    );
+
+    return float4(texColor.rgb, texColor.a * input.tint.a);
+}
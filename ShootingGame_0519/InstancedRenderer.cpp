@@ -0,0 +1,291 @@
+#include <stdexcept>
+#include <algorithm>
+#include <iterator>
+#include "InstancedRenderer.h"
+#include "ModelCache.h"
+#include <d3d11.h>
+#include "renderer.h"
+#include "MeshLod.h"
+
+InstanceBatcher InstancedRenderer::m_batcher;
+
+ComPtr<ID3D11VertexShader> InstancedRenderer::m_vertexShader;
+ComPtr<ID3D11PixelShader>  InstancedRenderer::m_pixelShader;
+ComPtr<ID3D11InputLayout>  InstancedRenderer::m_inputLayout;
+ComPtr<ID3D11InputLayout>  InstancedRenderer::m_packedInputLayout;
+ComPtr<ID3D11Buffer>       InstancedRenderer::m_instanceBuffer;
+size_t InstancedRenderer::m_instanceCapacity = 0;
+
+DirectX::BoundingFrustum InstancedRenderer::m_frustum;
+bool InstancedRenderer::m_frustumDirty = true;
+
+InstancedRenderer::Stats InstancedRenderer::m_stats;
+InstancedRenderer::Stats InstancedRenderer::m_lastStats;
+
+void InstancedRenderer::Init()
+{
+    m_batcher.Clear();
+    m_frustumDirty = true;
+
+    //wbhXsł̓VF[_[obt@Ȃ(R}h)
+    if (Renderer::IsHeadless()) { return; }
+
+    ID3D11Device* device = Renderer::GetDevice();
+
+    //-----------------------VF[_[̃RpC-----------------------
+    auto vsBlob = Renderer::CompileShader(L"InstancedVertexShader.hlsl", "VSMain", "vs_5_0");
+    HRESULT hr = device->CreateVertexShader(
+        vsBlob->GetBufferPointer(),
+        vsBlob->GetBufferSize(),
+        nullptr,
+        m_vertexShader.GetAddressOf());
+    if (FAILED(hr))
+    {
+        throw std::runtime_error("Failed to create Instanced vertex shader");
+    }
+
+    auto psBlob = Renderer::CompileShader(L"InstancedPixelShader.hlsl", "PSMain", "ps_5_0");
+    hr = device->CreatePixelShader(
+        psBlob->GetBufferPointer(),
+        psBlob->GetBufferSize(),
+        nullptr,
+        m_pixelShader.GetAddressOf());
+    if (FAILED(hr))
+    {
+        throw std::runtime_error("Failed to create Instanced pixel shader");
+    }
+
+    //-----------------------_CAEg쐬-----------------------
+    //Xbg0 : VERTEX_3D, Xbg1 : InstanceData
+    D3D11_INPUT_ELEMENT_DESC layoutDesc[] =
+    {
+        { "POSITION",  0, DXGI_FORMAT_R32G32B32_FLOAT,    0, offsetof(VERTEX_3D, Position), D3D11_INPUT_PER_VERTEX_DATA,   0 },
+        { "NORMAL",    0, DXGI_FORMAT_R32G32B32_FLOAT,    0, offsetof(VERTEX_3D, Normal),   D3D11_INPUT_PER_VERTEX_DATA,   0 },
+        { "COLOR",     0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, offsetof(VERTEX_3D, Diffuse),  D3D11_INPUT_PER_VERTEX_DATA,   0 },
+        { "TEXCOORD",  0, DXGI_FORMAT_R32G32_FLOAT,       0, offsetof(VERTEX_3D, TexCoord), D3D11_INPUT_PER_VERTEX_DATA,   0 },
+        { "WORLD",     0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0,                             D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "WORLD",     1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 16,                            D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "WORLD",     2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 32,                            D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "WORLD",     3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 48,                            D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+        { "INSTCOLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, offsetof(InstanceData, tint),  D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+    };
+
+    hr = device->CreateInputLayout(
+        layoutDesc,
+        _countof(layoutDesc),
+        vsBlob->GetBufferPointer(),
+        vsBlob->GetBufferSize(),
+        m_inputLayout.GetAddressOf());
+    if (FAILED(hr))
+    {
+        throw std::runtime_error("Failed to create Instanced input layout");
+    }
+
+    //Xbg0 VERTEX_PACKED ̏ꍇ(VF[_[͓B` float ɖ߂)
+    D3D11_INPUT_ELEMENT_DESC packedLayoutDesc[_countof(layoutDesc)];
+    std::copy(std::begin(layoutDesc), std::end(layoutDesc), packedLayoutDesc);
+    packedLayoutDesc[0] = { "POSITION",  0, DXGI_FORMAT_R32G32B32_FLOAT, 0, offsetof(VERTEX_PACKED, Position), D3D11_INPUT_PER_VERTEX_DATA, 0 };
+    packedLayoutDesc[1] = { "NORMAL",    0, DXGI_FORMAT_R8G8B8A8_SNORM,  0, offsetof(VERTEX_PACKED, Normal),   D3D11_INPUT_PER_VERTEX_DATA, 0 };
+    packedLayoutDesc[2] = { "COLOR",     0, DXGI_FORMAT_R8G8B8A8_UNORM,  0, offsetof(VERTEX_PACKED, Diffuse),  D3D11_INPUT_PER_VERTEX_DATA, 0 };
+    packedLayoutDesc[3] = { "TEXCOORD",  0, DXGI_FORMAT_R16G16_FLOAT,    0, offsetof(VERTEX_PACKED, TexCoord), D3D11_INPUT_PER_VERTEX_DATA, 0 };
+
+    hr = device->CreateInputLayout(
+        packedLayoutDesc,
+        _countof(packedLayoutDesc),
+        vsBlob->GetBufferPointer(),
+        vsBlob->GetBufferSize(),
+        m_packedInputLayout.GetAddressOf());
+    if (FAILED(hr))
+    {
+        throw std::runtime_error("Failed to create Instanced packed input layout");
+    }
+
+    //ŏ͏Ȃ߂ɊmۂāAȂȂ蒼
+    EnsureInstanceBuffer(256);
+}
+
+void InstancedRenderer::Uninit()
+{
+    m_batcher.Clear();
+
+    m_instanceBuffer.Reset();
+    m_instanceCapacity = 0;
+
+    m_inputLayout.Reset();
+    m_packedInputLayout.Reset();
+    m_vertexShader.Reset();
+    m_pixelShader.Reset();
+}
+
+/// <summary>
+/// CX^Xobt@̗eʂȂ΍蒼֐
+/// </summary>
+bool InstancedRenderer::EnsureInstanceBuffer(size_t count)
+{
+    if (m_instanceBuffer && count <= m_instanceCapacity)
+    {
+        return true;
+    }
+
+    size_t capacity = (m_instanceCapacity > 0) ? m_instanceCapacity : 256;
+    while (capacity < count)
+    {
+        capacity *= 2;
+    }
+
+    D3D11_BUFFER_DESC desc{};
+    desc.ByteWidth = static_cast<UINT>(sizeof(InstanceData) * capacity);
+    desc.Usage = D3D11_USAGE_DYNAMIC;
+    desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+    desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    ComPtr<ID3D11Buffer> buffer;
+    HRESULT hr = Renderer::GetDevice()->CreateBuffer(&desc, nullptr, buffer.GetAddressOf());
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("Failed to create instance buffer\n");
+        return false;
+    }
+
+    m_instanceBuffer = buffer;
+    m_instanceCapacity = capacity;
+    return true;
+}
+
+/// <summary>
+/// ߂ɃZbgꂽView/Proj烏[hԂ̎֐
+/// </summary>
+void InstancedRenderer::UpdateFrustum()
+{
+    using namespace DirectX;
+
+    BoundingFrustum::CreateFromMatrix(m_frustum, Renderer::m_cachedProjection);
+
+    XMMATRIX invView = XMMatrixInverse(nullptr, Renderer::m_cachedView);
+    m_frustum.Transform(m_frustum, invView);
+
+    m_frustumDirty = false;
+}
+
+void InstancedRenderer::Submit(const ModelMeshData& mesh, const Matrix4x4& world, const Color& tint, int lod)
+{
+    if (mesh.indexCount == 0) { return; }
+    if (!Renderer::IsHeadless() && (!mesh.vertexBuffer || !mesh.indexBuffer)) { return; }
+
+    m_stats.submitted++;
+
+    if (m_frustumDirty)
+    {
+        UpdateFrustum();
+    }
+
+    //JO
+    DirectX::BoundingSphere worldBounds;
+    mesh.bounds.Transform(worldBounds, world);
+
+    if (m_frustum.Contains(worldBounds) == DirectX::DISJOINT)
+    {
+        m_stats.culled++;
+        return;
+    }
+
+    lod = std::clamp(lod, 0, mesh.GetLodCount() - 1);
+    MeshLod::AddStats(lod, mesh.indexCount, mesh.GetIndexCount(lod));
+
+    InstanceGroupKey key;
+    key.mesh = &mesh;
+    key.material = mesh.srvDiffuse.Get();
+    key.lod = static_cast<uint32_t>(lod);
+    key.isTransparent = (tint.w < 1.0f);
+
+    m_batcher.Add(key, world, tint);
+}
+
+void InstancedRenderer::Flush()
+{
+    //Submitł͍ŐVView/Projg
+    m_frustumDirty = true;
+
+    if (m_batcher.GetPendingCount() == 0) { return; }
+
+    m_batcher.Build();
+
+    const auto& instances = m_batcher.GetInstances();
+    const auto& groups = m_batcher.GetGroups();
+
+    //-----------------------CX^Xobt@XV-----------------------
+    //(wbhXsł̓obt@̂ōXVȂ)
+    if (!Renderer::IsHeadless())
+    {
+        if (!EnsureInstanceBuffer(instances.size()))
+        {
+            m_batcher.Clear();
+            return;
+        }
+
+        ID3D11DeviceContext* ctx = Renderer::GetDeviceContext();
+
+        D3D11_MAPPED_SUBRESOURCE mapped{};
+        if (FAILED(ctx->Map(m_instanceBuffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)))
+        {
+            m_batcher.Clear();
+            return;
+        }
+        memcpy(mapped.pData, instances.data(), sizeof(InstanceData) * instances.size());
+        ctx->Unmap(m_instanceBuffer.Get(), 0);
+    }
+
+    //-----------------------pCvCݒ-----------------------
+    RenderBackend* backend = Renderer::GetBackend();
+
+    backend->SetShaders(m_vertexShader.Get(), m_pixelShader.Get(), m_inputLayout.Get());
+    backend->SetInstanceBuffer(m_instanceBuffer.Get(), sizeof(InstanceData));
+
+    bool isTransparent = false;
+    backend->SetBlendState(BS_NONE);
+
+    ID3D11InputLayout* currentLayout = m_inputLayout.Get();
+
+    for (const auto& group : groups)
+    {
+        const ModelMeshData* mesh = static_cast<const ModelMeshData*>(group.key.mesh);
+
+        //O[v͕s̏ɕł̂ŁA؂ւ1񂾂
+        if (group.key.isTransparent && !isTransparent)
+        {
+            backend->SetBlendState(BS_ALPHABLEND);
+            isTransparent = true;
+        }
+
+        //_̌`ς鎞̓CAEg؂ւ
+        ID3D11InputLayout* layout = mesh->packedVertices ? m_packedInputLayout.Get() : m_inputLayout.Get();
+        if (layout != currentLayout)
+        {
+            backend->SetShaders(m_vertexShader.Get(), m_pixelShader.Get(), layout);
+            currentLayout = layout;
+        }
+
+        const int lod = static_cast<int>(group.key.lod);
+
+        backend->SetGeometry(mesh->vertexBuffer.Get(), mesh->vertexStride, mesh->GetIndexBuffer(lod), mesh->indexFormat, RT_TRIANGLE_LIST);
+        backend->SetTexture(mesh->srvDiffuse.Get());
+        backend->DrawIndexedInstanced(mesh->GetIndexCount(lod), group.instanceCount, group.startInstance);
+
+        m_stats.drawCalls++;
+        m_stats.instances += static_cast<int>(group.instanceCount);
+    }
+
+    //-----------------------ʏ`pɖ߂-----------------------
+    backend->SetInstanceBuffer(nullptr, 0);
+    backend->SetShaders(Renderer::m_vertexShader.Get(), Renderer::m_pixelShader.Get(), Renderer::m_inputLayout.Get());
+    backend->SetBlendState(BS_NONE);
+
+    m_batcher.Clear();
+}
+
+void InstancedRenderer::EndFrame()
+{
+    m_lastStats = m_stats;
+    m_stats = Stats{};
+    m_frustumDirty = true;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <DirectXCollision.h>
+#include "commontypes.h"
+#include "InstanceBatcher.h"
+
+struct ModelMeshData;
+
+//---------------------------------------------------------
+// bVE}eÃf܂Ƃ߂ĕ`悷NX
+// ModelComponent  Submit ꂽCX^X (bV, }eA) ɂ܂Ƃ߁A
+// Flush ŃO[v DrawIndexedInstanced 1񂾂Ă
+//---------------------------------------------------------
+class InstancedRenderer
+{
+public:
+    //1t[̓v
+    struct Stats
+    {
+        int submitted = 0;      //Submitꂽ
+        int culled = 0;         //OŎ̂Ă
+        int instances = 0;      //ۂɕ`CX^X
+        int drawCalls = 0;      //DrawIndexedInstanced̉
+    };
+
+    static void Init();
+    static void Uninit();
+
+    //CX^X1o^(OȂ炱Ŏ̂Ă)
+    //lod : `LODx(bVłxɕʂ̃O[vɂȂ)
+    static void Submit(const ModelMeshData& mesh, const Matrix4x4& world, const Color& tint, int lod = 0);
+
+    //܂CX^X܂Ƃ߂ĕ`悷
+    static void Flush();
+
+    //t[̓vm肳(Game::GameDraw ̍ŌɌĂ)
+    static void EndFrame();
+
+    //--------Get֐-------
+    static const Stats& GetStats() { return m_lastStats; }
+
+private:
+    static void UpdateFrustum();
+    static bool EnsureInstanceBuffer(size_t count);
+
+    static InstanceBatcher m_batcher;
+
+    static ComPtr<ID3D11VertexShader> m_vertexShader;
+    static ComPtr<ID3D11PixelShader>  m_pixelShader;
+    static ComPtr<ID3D11InputLayout>  m_inputLayout;
+    static ComPtr<ID3D11InputLayout>  m_packedInputLayout;    //Xbg0 VERTEX_PACKED ̃bVp
+    static ComPtr<ID3D11Buffer>       m_instanceBuffer;
+    static size_t m_instanceCapacity;
+
+    //JOp̎([h)
+    static DirectX::BoundingFrustum m_frustum;
+    static bool m_frustumDirty;
+
+    static Stats m_stats;
+    static Stats m_lastStats;
+};
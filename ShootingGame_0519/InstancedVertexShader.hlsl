@@ -0,0 +1,56 @@
+// CX^X`p̒_VF[_[
+// [hsƐF̓Xbg1̃CX^Xobt@󂯎
+
+// VS ̓
+struct VSInput
+{
+    // Xbg0 : _f[^ (VERTEX_3D)
+    float3 pos      : POSITION;
+    float3 normal   : NORMAL;
+    float4 col      : COLOR;
+    float2 texcoord : TEXCOORD;
+
+    // Xbg1 : CX^Xf[^ (InstanceData)
+    float4 world0   : WORLD0;
+    float4 world1   : WORLD1;
+    float4 world2   : WORLD2;
+    float4 world3   : WORLD3;
+    float4 tint     : INSTCOLOR;
+};
+
+// VS  PS ւ̏o
+struct VSOutput
+{
+    float4 posH     : SV_POSITION;
+    float4 col      : COLOR;
+    float3 normal   : NORMAL;
+    float2 texcoord : TEXCOORD;
+    float4 tint     : INSTCOLOR;
+};
+
+cbuffer ViewBuffer : register(b1)
+{
+    matrix gView;
+}
+cbuffer ProjBuffer : register(b2)
+{
+    matrix gProj;
+}
+
+VSOutput VSMain(VSInput vin)
+{
+    VSOutput output;
+
+    // sxNg`̂܂܋l߂Ă̂ŁÂ܂܍sƂđgݗĂ
+    float4x4 world = float4x4(vin.world0, vin.world1, vin.world2, vin.world3);
+
+    float4 worldPos = mul(float4(vin.pos, 1), world);
+    float4 viewPos = mul(worldPos, gView);
+    output.posH = mul(viewPos, gProj);
+
+    output.col = vin.col;
+    output.normal = normalize(mul(vin.normal, (float3x3) world)); // [hԖ@
+    output.texcoord = vin.texcoord;
+    output.tint = vin.tint;
+    return output;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+//---------------------------------------------------------
+// ǂݎpŃt@CɃ}bv
+// g OS y[WPʂœǂݍނ̂ŁAJł͑S͓ǂ܂Ȃ
+// GetData ̃|C^ Close ܂ŗL
+//---------------------------------------------------------
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::wstring& filepath);
+    void Close();
+
+    //--------Get֐-------
+    const uint8_t* GetData() const { return m_data; }
+    size_t GetSize() const { return m_size; }
+    bool IsOpen() const { return m_data != nullptr; }
+
+private:
+#ifdef _WIN32
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+#else
+    int m_file = -1;
+#endif
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+};
@@ -0,0 +1,268 @@
+#include <cstdio>
+#include <algorithm>
+#include <filesystem>
+#include "MeshLod.h"
+#include <d3d11.h>
+#include "renderer.h"
+#include "MeshOptimizer.h"
+
+bool MeshLod::m_enabled = true;
+
+std::atomic<int> MeshLod::m_meshes{ 0 };
+std::atomic<int> MeshLod::m_levelMeshes[MAX_LEVELS];
+std::atomic<int> MeshLod::m_fullTriangles{ 0 };
+std::atomic<int> MeshLod::m_triangles{ 0 };
+
+MeshLod::Stats MeshLod::m_lastStats;
+
+namespace
+{
+    //ex̖ڕWOp`(ɑ΂銄)
+    const std::vector<float> LEVEL_RATIOS = { 0.5f, 0.25f, 0.1f };
+
+    //ȏ`ȗ͂Ȃ(bV̑傫ɑ΂銄)
+    constexpr float MAX_SIMPLIFY_ERROR = 0.02f;
+
+    //Op`ȂbVLODȂ
+    constexpr size_t MIN_LOD_TRIANGLES = 1000;
+
+    //ʏ̑傫玟̃x(x1, 2, 3 ւ̋E)
+    constexpr float LEVEL_SCREEN_SIZES[MeshLod::MAX_LEVELS - 1] = { 0.20f, 0.08f, 0.03f };
+
+    //E炱̊܂ł͍̃xۂ
+    constexpr float HYSTERESIS = 0.2f;
+
+    constexpr uint32_t LOD_FILE_MAGIC = 0x444F4C4D;     // "MLOD"
+    constexpr uint32_t LOD_FILE_VERSION = 2;     //2 : _gpɕבւ̃CfbNX
+
+    //f̃pX UTF-8 Ȃ̂ŁAWindows ł̓ChɒĊJ(ModelComponent::FileExists Ɠ)
+    std::filesystem::path ToFsPath(const std::string& path)
+    {
+#ifdef _WIN32
+        const int len = ::MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+        if (len <= 0) { return std::filesystem::path(); }
+        std::wstring wpath(len, L'\0');
+        ::MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &wpath[0], len);
+        wpath.resize(len - 1);
+        return std::filesystem::path(wpath);
+#else
+        return std::filesystem::path(path);
+#endif
+    }
+
+    FILE* OpenFile(const std::string& path, bool write)
+    {
+        const std::filesystem::path fsPath = ToFsPath(path);
+        if (fsPath.empty()) { return nullptr; }
+
+        FILE* fp = nullptr;
+#ifdef _WIN32
+        if (_wfopen_s(&fp, fsPath.c_str(), write ? L"wb" : L"rb") != 0) { return nullptr; }
+#else
+        fp = fopen(fsPath.c_str(), write ? "wb" : "rb");
+#endif
+        return fp;
+    }
+}
+
+std::vector<SimplifyLevel> MeshLod::BuildLevels(const float* positions, const float* uvs, size_t stride,
+                                                size_t vertexCount, const std::vector<uint32_t>& indices)
+{
+    std::vector<SimplifyLevel> levels = SimplifyMeshLevels(positions, uvs, stride, vertexCount,
+                                                           indices, LEVEL_RATIOS, MAX_SIMPLIFY_ERROR);
+
+    if (levels.size() > MAX_LEVELS - 1)
+    {
+        levels.resize(MAX_LEVELS - 1);
+    }
+
+    //ȗŕт̂Ŋex_LbVɍ킹ĕג
+    for (auto& level : levels)
+    {
+        MeshOptimizer::OptimizeVertexCache(level.indices, vertexCount);
+    }
+    return levels;
+}
+
+bool MeshLod::NeedsLod(size_t indexCount)
+{
+    return indexCount / 3 >= MIN_LOD_TRIANGLES;
+}
+
+float MeshLod::GetScreenSize(const DirectX::BoundingSphere& worldBounds)
+{
+    Vector3 center(worldBounds.Center.x, worldBounds.Center.y, worldBounds.Center.z);
+    Vector3 viewPos = Vector3::Transform(center, Renderer::m_cachedView);
+
+    //EnȂ̂Ńr[Ԃł -z O
+    float depth = -viewPos.z;
+
+    //J̒ɂ鎞͈ԍׂ`
+    if (depth <= worldBounds.Radius) { return 1.0e6f; }
+
+    //_22 = 1 / tan(fovY / 2)
+    return worldBounds.Radius * Renderer::m_cachedProjection._22 / depth;
+}
+
+int MeshLod::SelectLevel(float screenSize, int currentLevel, int levelCount)
+{
+    if (!m_enabled || levelCount <= 1) { return 0; }
+
+    levelCount = std::min(levelCount, MAX_LEVELS);
+    int level = std::clamp(currentLevel, 0, levelCount - 1);
+
+    //e : E\
+    while (level < levelCount - 1 && screenSize < LEVEL_SCREEN_SIZES[level] * (1.0f - HYSTERESIS))
+    {
+        level++;
+    }
+
+    //ׂ : E\
+    while (level > 0 && screenSize > LEVEL_SCREEN_SIZES[level - 1] * (1.0f + HYSTERESIS))
+    {
+        level--;
+    }
+
+    return level;
+}
+
+void MeshLod::AddStats(int level, uint32_t fullIndexCount, uint32_t indexCount)
+{
+    level = std::clamp(level, 0, MAX_LEVELS - 1);
+
+    m_meshes.fetch_add(1, std::memory_order_relaxed);
+    m_levelMeshes[level].fetch_add(1, std::memory_order_relaxed);
+    m_fullTriangles.fetch_add(static_cast<int>(fullIndexCount / 3), std::memory_order_relaxed);
+    m_triangles.fetch_add(static_cast<int>(indexCount / 3), std::memory_order_relaxed);
+}
+
+void MeshLod::EndFrame()
+{
+    Stats stats;
+    stats.meshes = m_meshes.exchange(0);
+    for (int i = 0; i < MAX_LEVELS; ++i)
+    {
+        stats.levelMeshes[i] = m_levelMeshes[i].exchange(0);
+    }
+    stats.fullTriangles = m_fullTriangles.exchange(0);
+    stats.triangles = m_triangles.exchange(0);
+
+    m_lastStats = stats;
+}
+
+//------------------------------MeshLodFile------------------------------
+
+bool MeshLodFile::Load(const std::string& path)
+{
+    m_meshes.clear();
+    m_dirty = false;
+
+    FILE* fp = OpenFile(path, false);
+    if (!fp)
+    {
+        return false;
+    }
+
+    auto readU32 = [fp](uint32_t& out) { return fread(&out, sizeof(out), 1, fp) == 1; };
+
+    uint32_t magic = 0, version = 0, meshCount = 0;
+    bool ok = readU32(magic) && readU32(version) && readU32(meshCount) &&
+              magic == LOD_FILE_MAGIC && version == LOD_FILE_VERSION;
+
+    for (uint32_t m = 0; ok && m < meshCount; ++m)
+    {
+        MeshEntry entry;
+        uint32_t levelCount = 0;
+        ok = readU32(entry.vertexCount) && readU32(entry.indexCount) && readU32(levelCount);
+
+        for (uint32_t l = 0; ok && l < levelCount; ++l)
+        {
+            SimplifyLevel level;
+            uint32_t count = 0;
+            ok = fread(&level.error, sizeof(float), 1, fp) == 1 && readU32(count);
+            if (!ok) { break; }
+
+            level.indices.resize(count);
+            ok = count == 0 || fread(level.indices.data(), sizeof(uint32_t), count, fp) == count;
+
+            //ꂽf[^Ŕ͈͊Oǂ܂Ȃ悤
+            for (uint32_t index : level.indices)
+            {
+                if (index >= entry.vertexCount) { ok = false; break; }
+            }
+
+            entry.levels.push_back(std::move(level));
+        }
+
+        m_meshes.push_back(std::move(entry));
+    }
+
+    fclose(fp);
+
+    if (!ok)
+    {
+        OutputDebugStringA(("MeshLodFile: broken lod file " + path + "\n").c_str());
+        m_meshes.clear();
+    }
+    return ok;
+}
+
+bool MeshLodFile::Save(const std::string& path) const
+{
+    FILE* fp = OpenFile(path, true);
+    if (!fp)
+    {
+        OutputDebugStringA(("MeshLodFile: failed to write " + path + "\n").c_str());
+        return false;
+    }
+
+    auto writeU32 = [fp](uint32_t value) { fwrite(&value, sizeof(value), 1, fp); };
+
+    writeU32(LOD_FILE_MAGIC);
+    writeU32(LOD_FILE_VERSION);
+    writeU32(static_cast<uint32_t>(m_meshes.size()));
+
+    for (const auto& entry : m_meshes)
+    {
+        writeU32(entry.vertexCount);
+        writeU32(entry.indexCount);
+        writeU32(static_cast<uint32_t>(entry.levels.size()));
+
+        for (const auto& level : entry.levels)
+        {
+            fwrite(&level.error, sizeof(float), 1, fp);
+            writeU32(static_cast<uint32_t>(level.indices.size()));
+            fwrite(level.indices.data(), sizeof(uint32_t), level.indices.size(), fp);
+        }
+    }
+
+    bool ok = (ferror(fp) == 0);
+    fclose(fp);
+    return ok;
+}
+
+bool MeshLodFile::Remove(const std::string& path)
+{
+    std::error_code ec;
+    return std::filesystem::remove(ToFsPath(path), ec);
+}
+
+const MeshLodFile::MeshEntry* MeshLodFile::Find(size_t meshIndex, uint32_t vertexCount, uint32_t indexCount) const
+{
+    if (meshIndex >= m_meshes.size()) { return nullptr; }
+
+    const MeshEntry& entry = m_meshes[meshIndex];
+    if (entry.vertexCount != vertexCount || entry.indexCount != indexCount) { return nullptr; }
+
+    return &entry;
+}
+
+void MeshLodFile::Set(size_t meshIndex, MeshEntry entry)
+{
+    if (m_meshes.size() <= meshIndex)
+    {
+        m_meshes.resize(meshIndex + 1);
+    }
+    m_meshes[meshIndex] = std::move(entry);
+    m_dirty = true;
+}
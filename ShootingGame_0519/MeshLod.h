@@ -0,0 +1,102 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <DirectXCollision.h>
+#include "MeshSimplifier.h"
+
+//---------------------------------------------------------
+// bVLOD(ڍדx)̍쐬ƑI
+// Eǂݍݎɓ񎟌덷ŊȗCfbNXAfׂ̗
+//   <f>.lod Ƃĕۑ(񂩂͂ǂނ)
+// E`掞͉ʏ̑傫ŃxIԁBEt߂ōs藈
+//   Ȃ悤ɁA؂ւɂ̓qXeVXt
+//---------------------------------------------------------
+class MeshLod
+{
+public:
+    static constexpr int MAX_LEVELS = 4;   //x0(̃bV)܂
+
+    //1t[̓v
+    struct Stats
+    {
+        int meshes = 0;                     //`bV
+        int levelMeshes[MAX_LEVELS] = {};   //x̃bV
+        int fullTriangles = 0;              //Sx0ŕ`ꍇ̎Op`
+        int triangles = 0;                  //ۂɕ`Op`
+    };
+
+    //x1ȍ~(ꂽxԂ)
+    //positions / uvs : _̐擪̃|C^, stride : _1̃oCg
+    static std::vector<SimplifyLevel> BuildLevels(const float* positions, const float* uvs, size_t stride,
+                                                  size_t vertexCount, const std::vector<uint32_t>& indices);
+
+    //̎Op`菭ȂbVLODȂ
+    static bool NeedsLod(size_t indexCount);
+
+    //ʏ̑傫(aʂ̍̔̉)
+    //߂ Renderer ɃZbgꂽ View / Proj g
+    static float GetScreenSize(const DirectX::BoundingSphere& worldBounds);
+
+    //ʏ̑傫烌xI(currentLevel ؂ւ邩ǂɃqXeVXt)
+    static int SelectLevel(float screenSize, int currentLevel, int levelCount);
+
+    //`bV𓝌vɑ([J[XbhĂł悢)
+    static void AddStats(int level, uint32_t fullIndexCount, uint32_t indexCount);
+
+    //t[̓vm肳
+    static void EndFrame();
+
+    //--------Set֐-------
+    static void SetEnabled(bool enable) { m_enabled = enable; }
+
+    //--------Get֐-------
+    static bool IsEnabled() { return m_enabled; }
+    static const Stats& GetStats() { return m_lastStats; }
+
+private:
+    static bool m_enabled;
+
+    static std::atomic<int> m_meshes;
+    static std::atomic<int> m_levelMeshes[MAX_LEVELS];
+    static std::atomic<int> m_fullTriangles;
+    static std::atomic<int> m_triangles;
+
+    static Stats m_lastStats;
+};
+
+//---------------------------------------------------------
+// fׂ̗ɒu LOD f[^(<f>.lod)̓ǂݏ
+// bVɌ̒_ECfbNXĂāA
+// fςĂ炻 LOD ͎gȂ(蒼)
+//---------------------------------------------------------
+class MeshLodFile
+{
+public:
+    struct MeshEntry
+    {
+        uint32_t vertexCount = 0;
+        uint32_t indexCount = 0;
+        std::vector<SimplifyLevel> levels;
+    };
+
+    static std::string GetPath(const std::string& modelPath) { return modelPath + ".lod"; }
+
+    //path  UTF-8 (f̃pXƓ)
+    bool Load(const std::string& path);
+    bool Save(const std::string& path) const;
+    static bool Remove(const std::string& path);
+
+    //meshIndex Ԗڂ̃bṼf[^(̃bVƐႦ nullptr)
+    const MeshEntry* Find(size_t meshIndex, uint32_t vertexCount, uint32_t indexCount) const;
+
+    void Set(size_t meshIndex, MeshEntry entry);
+
+    //--------Get֐-------
+    bool IsDirty() const { return m_dirty; }
+
+private:
+    std::vector<MeshEntry> m_meshes;
+    bool m_dirty = false;
+};
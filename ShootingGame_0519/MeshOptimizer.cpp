@@ -0,0 +1,433 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "MeshOptimizer.h"
+
+namespace
+{
+    //-----------------------Forsyth ̃XRA-----------------------
+    //Forsyth, "Linear-Speed Vertex Cache Optimisation" ̒l̂܂܎g
+    constexpr int   SCORE_CACHE_SIZE = 32;
+    constexpr float CACHE_DECAY_POWER = 1.5f;
+    constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+    constexpr float VALENCE_BOOST_SCALE = 2.0f;
+    constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+    //̐𒴂Op`W܂钸_̓XRA̕\g킸ɌvZ
+    constexpr int VALENCE_TABLE_SIZE = 32;
+
+    struct ScoreTable
+    {
+        float cache[SCORE_CACHE_SIZE];
+        float valence[VALENCE_TABLE_SIZE];
+
+        ScoreTable()
+        {
+            for (int i = 0; i < SCORE_CACHE_SIZE; ++i)
+            {
+                if (i < 3)
+                {
+                    //O̎Op`̒_́AOp`xgȂ悤ɏ
+                    cache[i] = LAST_TRIANGLE_SCORE;
+                }
+                else
+                {
+                    const float scaler = 1.0f / (SCORE_CACHE_SIZE - 3);
+                    cache[i] = std::pow(1.0f - (i - 3) * scaler, CACHE_DECAY_POWER);
+                }
+            }
+
+            for (int i = 0; i < VALENCE_TABLE_SIZE; ++i)
+            {
+                valence[i] = (i == 0) ? 0.0f : VALENCE_BOOST_SCALE * std::pow(static_cast<float>(i), -VALENCE_BOOST_POWER);
+            }
+        }
+
+        //cachePosition : LbV̈ʒu(-1ȂLbVO), remaining : ܂gĂȂOp`̐
+        float Get(int cachePosition, uint32_t remaining) const
+        {
+            if (remaining == 0) { return -1.0f; }
+
+            float score = (cachePosition >= 0) ? cache[cachePosition] : 0.0f;
+            score += (remaining < VALENCE_TABLE_SIZE) ? valence[remaining]
+                                                      : VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remaining), -VALENCE_BOOST_POWER);
+            return score;
+        }
+    };
+
+    const ScoreTable& GetScoreTable()
+    {
+        static const ScoreTable table;
+        return table;
+    }
+
+    struct Float3
+    {
+        float x, y, z;
+    };
+
+    Float3 LoadPosition(const float* positions, size_t stride, uint32_t index)
+    {
+        const float* p = reinterpret_cast<const float*>(reinterpret_cast<const uint8_t*>(positions) + stride * index);
+        return { p[0], p[1], p[2] };
+    }
+}
+
+VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize)
+{
+    VertexCacheStats stats;
+    if (indices.size() < 3 || vertexCount == 0 || cacheSize == 0) { return stats; }
+
+    //_ɁuLbVɓvĂ΁AFIFO ̒ɂ邩͈Zŕ
+    std::vector<uint32_t> timestamp(vertexCount, 0);
+    uint32_t time = static_cast<uint32_t>(cacheSize) + 1;
+    size_t misses = 0;
+
+    for (uint32_t index : indices)
+    {
+        if (index >= vertexCount) { continue; }
+
+        if (time - timestamp[index] > cacheSize)
+        {
+            timestamp[index] = time++;
+            misses++;
+        }
+    }
+
+    //gꂽ_(ATVR ̕)
+    size_t usedVertices = 0;
+    for (uint32_t t : timestamp)
+    {
+        if (t != 0) { usedVertices++; }
+    }
+
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+    stats.atvr = usedVertices ? static_cast<float>(misses) / static_cast<float>(usedVertices) : 0.0f;
+    return stats;
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount)
+{
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2 || vertexCount == 0) { return; }
+
+    const ScoreTable& table = GetScoreTable();
+
+    //-----------------------_Op`̑Ή\(CSR)-----------------------
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+    {
+        if (indices[i] >= vertexCount) { return; }   //ꂽCfbNXɂ͐GȂ
+        remaining[indices[i]]++;
+    }
+
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        offsets[v + 1] = offsets[v] + remaining[v];
+    }
+
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    {
+        std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            for (int k = 0; k < 3; ++k)
+            {
+                adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+            }
+        }
+    }
+
+    //-----------------------XRA-----------------------
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        vertexScore[v] = table.Get(-1, remaining[v]);
+    }
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<uint8_t> emitted(triangleCount, 0);
+    for (size_t t = 0; t < triangleCount; ++t)
+    {
+        triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+    }
+
+    //-----------------------XRA̍Op`oĂ-----------------------
+    std::vector<uint32_t> result;
+    result.reserve(triangleCount * 3);
+
+    //LbV(+V3_̗]T)
+    uint32_t cache[SCORE_CACHE_SIZE + 3];
+    uint32_t newCache[SCORE_CACHE_SIZE + 3];
+    int cacheCount = 0;
+
+    //LbVɌ₪Ɏ̎Op`Tn߂ʒu
+    size_t deadEndCursor = 0;
+
+    //ŏ͑ŜňԃXRA̍Op`
+    size_t best = 0;
+    for (size_t t = 1; t < triangleCount; ++t)
+    {
+        if (triangleScore[t] > triangleScore[best]) { best = t; }
+    }
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+    {
+        const uint32_t* tri = &indices[best * 3];
+        emitted[best] = 1;
+        result.insert(result.end(), tri, tri + 3);
+
+        //gOp`e_̎c肩O
+        for (int k = 0; k < 3; ++k)
+        {
+            const uint32_t v = tri[k];
+            uint32_t* begin = &adjacency[offsets[v]];
+            uint32_t* end = begin + remaining[v];
+            uint32_t* it = std::find(begin, end, static_cast<uint32_t>(best));
+            if (it != end)
+            {
+                std::swap(*it, *(end - 1));
+                remaining[v]--;
+            }
+        }
+
+        //LbVXV(3_擪ɁAcɂ炷)
+        int newCount = 0;
+        for (int k = 0; k < 3; ++k)
+        {
+            newCache[newCount++] = tri[k];
+        }
+        for (int i = 0; i < cacheCount; ++i)
+        {
+            const uint32_t v = cache[i];
+            if (v != tri[0] && v != tri[1] && v != tri[2])
+            {
+                newCache[newCount++] = v;
+            }
+        }
+
+        //ꂽ_̓LbVO(̒_gOp`̃XRA)
+        for (int i = SCORE_CACHE_SIZE; i < newCount; ++i)
+        {
+            const uint32_t v = newCache[i];
+            const float score = table.Get(-1, remaining[v]);
+            const float diff = score - vertexScore[v];
+            cachePosition[v] = -1;
+            vertexScore[v] = score;
+
+            for (uint32_t a = offsets[v]; a < offsets[v] + remaining[v]; ++a)
+            {
+                triangleScore[adjacency[a]] += diff;
+            }
+        }
+        cacheCount = std::min(newCount, SCORE_CACHE_SIZE);
+        std::copy(newCache, newCache + cacheCount, cache);
+
+        //LbV̒_̃XRAXVA̒_gOp`玟I
+        for (int i = 0; i < cacheCount; ++i)
+        {
+            cachePosition[cache[i]] = i;
+        }
+
+        float bestScore = -1.0f;
+        best = triangleCount;
+
+        for (int i = 0; i < cacheCount; ++i)
+        {
+            const uint32_t v = cache[i];
+            const float score = table.Get(i, remaining[v]);
+            const float diff = score - vertexScore[v];
+            vertexScore[v] = score;
+
+            for (uint32_t a = offsets[v]; a < offsets[v] + remaining[v]; ++a)
+            {
+                const uint32_t t = adjacency[a];
+                triangleScore[t] += diff;
+
+                if (triangleScore[t] > bestScore)
+                {
+                    bestScore = triangleScore[t];
+                    best = t;
+                }
+            }
+        }
+
+        //LbVɌ₪΂܂oĂȂOp`ɒT
+        if (best == triangleCount)
+        {
+            while (deadEndCursor < triangleCount && emitted[deadEndCursor])
+            {
+                deadEndCursor++;
+            }
+            best = deadEndCursor;
+            if (best == triangleCount) { break; }
+        }
+    }
+
+    //Op`ȊO̗](3Ŋ؂Ȃ)͂̂܂܎c
+    std::copy(result.begin(), result.end(), indices.begin());
+}
+
+void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& indices, const float* positions, size_t stride, size_t vertexCount)
+{
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount < 2 || vertexCount == 0 || !positions) { return; }
+
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+    {
+        if (indices[i] >= vertexCount) { return; }
+    }
+
+    //-----------------------LbV̐؂ڂŉɕ-----------------------
+    //3_ƂOOp`̑OȂAԂւĂLbV͂قڕςȂ
+    std::vector<size_t> clusterStarts;
+    {
+        std::vector<uint32_t> timestamp(vertexCount, 0);
+        uint32_t time = static_cast<uint32_t>(DEFAULT_CACHE_SIZE) + 1;
+
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            int misses = 0;
+            for (int k = 0; k < 3; ++k)
+            {
+                const uint32_t v = indices[t * 3 + k];
+                if (time - timestamp[v] > DEFAULT_CACHE_SIZE)
+                {
+                    timestamp[v] = time++;
+                    misses++;
+                }
+            }
+
+            if (t == 0 || misses == 3)
+            {
+                clusterStarts.push_back(t);
+            }
+        }
+    }
+
+    const size_t clusterCount = clusterStarts.size();
+    if (clusterCount < 2) { return; }
+    clusterStarts.push_back(triangleCount);
+
+    //-----------------------̌߂-----------------------
+    //bV̒S̒Sւ̃xNgƉ̖@̓ς傫قǊOŁAɕ`ƌB
+    Float3 meshCenter{ 0.0f, 0.0f, 0.0f };
+    float meshArea = 0.0f;
+
+    std::vector<Float3> clusterCenter(clusterCount);
+    std::vector<Float3> clusterNormal(clusterCount);
+    std::vector<float>  clusterArea(clusterCount);
+
+    for (size_t c = 0; c < clusterCount; ++c)
+    {
+        Float3 center{ 0.0f, 0.0f, 0.0f };
+        Float3 normal{ 0.0f, 0.0f, 0.0f };
+        float area = 0.0f;
+
+        for (size_t t = clusterStarts[c]; t < clusterStarts[c + 1]; ++t)
+        {
+            const Float3 p0 = LoadPosition(positions, stride, indices[t * 3]);
+            const Float3 p1 = LoadPosition(positions, stride, indices[t * 3 + 1]);
+            const Float3 p2 = LoadPosition(positions, stride, indices[t * 3 + 2]);
+
+            const Float3 e1{ p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+            const Float3 e2{ p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+            const Float3 n{ e1.y * e2.z - e1.z * e2.y, e1.z * e2.x - e1.x * e2.z, e1.x * e2.y - e1.y * e2.x };
+            const float a = std::sqrt(n.x * n.x + n.y * n.y + n.z * n.z);
+
+            center.x += (p0.x + p1.x + p2.x) * a;
+            center.y += (p0.y + p1.y + p2.y) * a;
+            center.z += (p0.z + p1.z + p2.z) * a;
+            normal.x += n.x;
+            normal.y += n.y;
+            normal.z += n.z;
+            area += a;
+        }
+
+        meshCenter.x += center.x;
+        meshCenter.y += center.y;
+        meshCenter.z += center.z;
+        meshArea += area;
+
+        const float inv = (area > 0.0f) ? 1.0f / (area * 3.0f) : 0.0f;
+        clusterCenter[c] = { center.x * inv, center.y * inv, center.z * inv };
+
+        const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+        const float invLength = (length > 0.0f) ? 1.0f / length : 0.0f;
+        clusterNormal[c] = { normal.x * invLength, normal.y * invLength, normal.z * invLength };
+        clusterArea[c] = area;
+    }
+
+    if (meshArea <= 0.0f) { return; }
+
+    const float invMesh = 1.0f / (meshArea * 3.0f);
+    meshCenter = { meshCenter.x * invMesh, meshCenter.y * invMesh, meshCenter.z * invMesh };
+
+    std::vector<float> sortKey(clusterCount);
+    for (size_t c = 0; c < clusterCount; ++c)
+    {
+        const Float3 d{ clusterCenter[c].x - meshCenter.x, clusterCenter[c].y - meshCenter.y, clusterCenter[c].z - meshCenter.z };
+        sortKey[c] = d.x * clusterNormal[c].x + d.y * clusterNormal[c].y + d.z * clusterNormal[c].z;
+    }
+
+    //-----------------------O򂩂ג-----------------------
+    std::vector<uint32_t> order(clusterCount);
+    for (size_t c = 0; c < clusterCount; ++c)
+    {
+        order[c] = static_cast<uint32_t>(c);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+    {
+        return sortKey[a] > sortKey[b];
+    });
+
+    std::vector<uint32_t> result;
+    result.reserve(triangleCount * 3);
+    for (uint32_t c : order)
+    {
+        result.insert(result.end(), indices.begin() + clusterStarts[c] * 3, indices.begin() + clusterStarts[c + 1] * 3);
+    }
+
+    std::copy(result.begin(), result.end(), indices.begin());
+}
+
+size_t MeshOptimizer::OptimizeVertexFetch(void* vertices, size_t vertexCount, size_t vertexSize, std::vector<uint32_t>& indices)
+{
+    if (!vertices || vertexCount == 0 || vertexSize == 0) { return vertexCount; }
+
+    for (uint32_t index : indices)
+    {
+        if (index >= vertexCount) { return vertexCount; }
+    }
+
+    //ŏɎgꂽɐVԍU
+    constexpr uint32_t UNUSED = 0xFFFFFFFFu;
+    std::vector<uint32_t> remap(vertexCount, UNUSED);
+    uint32_t next = 0;
+
+    for (uint32_t& index : indices)
+    {
+        if (remap[index] == UNUSED)
+        {
+            remap[index] = next++;
+        }
+        index = remap[index];
+    }
+
+    //_Vԍ̈ʒu֋lߒ
+    const uint8_t* src = static_cast<const uint8_t*>(vertices);
+    std::vector<uint8_t> sorted(static_cast<size_t>(next) * vertexSize);
+
+    for (size_t v = 0; v < vertexCount; ++v)
+    {
+        if (remap[v] != UNUSED)
+        {
+            memcpy(&sorted[remap[v] * vertexSize], src + v * vertexSize, vertexSize);
+        }
+    }
+
+    memcpy(vertices, sorted.data(), sorted.size());
+    return next;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+//---------------------------------------------------------
+// ǂݍݎɃbV GPU ɕבւ֐Q
+// E_LbV : _𑱂Ďg悤ɎOp`בւ(Forsyth)
+// EI[o[h[ : LbV̐؂ڂł܂Ƃ߂Op`̉AO`
+// E_tFb`   : _obt@g鏇ɕגAgȂ_̂Ă
+// GPU ɂ͐GȂ̂ŁAwbhXsłʂmFł
+//---------------------------------------------------------
+
+//_LbV̌(FIFO LbVł̖͋[)
+struct VertexCacheStats
+{
+    float acmr = 0.0f;  //Op`1̒_VF[_[s(0.5`3AقǗǂ)
+    float atvr = 0.0f;  //_1̎s(1ŗ)
+};
+
+namespace MeshOptimizer
+{
+    //͋[ɎgLbV̑傫(ŋ߂GPU̖ڈ)
+    constexpr size_t DEFAULT_CACHE_SIZE = 16;
+
+    //FIFO LbVŒ_VF[_[̎s񐔂𐔂
+    VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+                                        size_t cacheSize = DEFAULT_CACHE_SIZE);
+
+    //_LbVɍ킹ĎOp`̏Ԃבւ
+    void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+    //OptimizeVertexCache ̌ɌĂ
+    //LbV؂鏊ŎOp`ɕAO򂩂`悤ɕבւ
+    //positions : _W(float3)̐擪, stride : _1̃oCg
+    void OptimizeOverdraw(std::vector<uint32_t>& indices, const float* positions, size_t stride, size_t vertexCount);
+
+    //_ŏɎg鏇ɕג(gȂ_͎̂Ă)
+    //vertices : _z(vertexSize oCg ~ vertexCount)B擪lߒ
+    //߂l : ג̒_
+    size_t OptimizeVertexFetch(void* vertices, size_t vertexCount, size_t vertexSize, std::vector<uint32_t>& indices);
+}
@@ -0,0 +1,527 @@
+#include <cmath>
+#include <cstring>
+#include <array>
+#include <queue>
+#include <algorithm>
+#include <unordered_map>
+#include "MeshSimplifier.h"
+
+namespace
+{
+    //̕ӂɑS̏d(傫قǗ֊sۂ)
+    constexpr double BORDER_WEIGHT = 10.0;
+
+    //k̖@XOp`łȂk񂵂Ȃ(cos)
+    constexpr double MIN_NORMAL_DOT = 0.25;
+
+    //Õx炱̊茸Ȃ΃xƂč̗pȂ
+    constexpr float MIN_LEVEL_REDUCTION = 0.85f;
+
+    struct Vec3
+    {
+        double x, y, z;
+
+        Vec3 operator-(const Vec3& o) const { return { x - o.x, y - o.y, z - o.z }; }
+    };
+
+    Vec3 Cross(const Vec3& a, const Vec3& b)
+    {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+
+    double Dot(const Vec3& a, const Vec3& b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    double Length(const Vec3& v)
+    {
+        return std::sqrt(Dot(v, v));
+    }
+
+    // ax+by+cz+d=0 ܂ł̋̓a\Ώ̍s(Əd݂̍v)
+    struct Quadric
+    {
+        double a2 = 0, ab = 0, ac = 0, ad = 0;
+        double b2 = 0, bc = 0, bd = 0;
+        double c2 = 0, cd = 0;
+        double d2 = 0;
+        double weight = 0;
+
+        void AddPlane(const Vec3& n, double d, double w)
+        {
+            a2 += w * n.x * n.x; ab += w * n.x * n.y; ac += w * n.x * n.z; ad += w * n.x * d;
+            b2 += w * n.y * n.y; bc += w * n.y * n.z; bd += w * n.y * d;
+            c2 += w * n.z * n.z; cd += w * n.z * d;
+            d2 += w * d * d;
+            weight += w;
+        }
+
+        void Add(const Quadric& q)
+        {
+            a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad;
+            b2 += q.b2; bc += q.bc; bd += q.bd;
+            c2 += q.c2; cd += q.cd;
+            d2 += q.d2;
+            weight += q.weight;
+        }
+
+        double Eval(const Vec3& p) const
+        {
+            double e = a2 * p.x * p.x + 2.0 * ab * p.x * p.y + 2.0 * ac * p.x * p.z + 2.0 * ad * p.x
+                     + b2 * p.y * p.y + 2.0 * bc * p.y * p.z + 2.0 * bd * p.y
+                     + c2 * p.z * p.z + 2.0 * cd * p.z
+                     + d2;
+            return std::max(e, 0.0);
+        }
+    };
+
+    //k from  to
+    struct Candidate
+    {
+        double cost;
+        uint32_t from;
+        uint32_t to;
+        uint32_t fromVersion;
+        uint32_t toVersion;
+
+        bool operator>(const Candidate& o) const { return cost > o.cost; }
+    };
+
+    using TriIndex = std::array<uint32_t, 3>;
+
+    class Simplifier
+    {
+    public:
+        Simplifier(const float* positions, const float* uvs, size_t stride, size_t vertexCount,
+                   const std::vector<uint32_t>& indices)
+            : m_uvs(uvs), m_stride(stride)
+        {
+            BuildPositions(positions, vertexCount);
+            BuildTriangles(indices);
+            BuildQuadrics();
+
+            for (uint32_t p = 0; p < m_posCount; ++p)
+            {
+                PushCandidates(p);
+            }
+        }
+
+        size_t GetLiveTriangles() const { return m_liveTriangles; }
+        size_t GetSourceTriangles() const { return m_triPos.size(); }
+        double GetExtent() const { return m_extent; }
+        double GetMaxError() const { return m_maxError; }
+
+        //ĂOp` target ȉɂȂ܂ŏk񂷂
+        //maxErrorSq 𒴂k񂵂cĂȂ false
+        bool Run(size_t targetTriangles, double maxErrorSq)
+        {
+            while (m_liveTriangles > targetTriangles)
+            {
+                if (m_heap.empty()) { return false; }
+
+                Candidate c = m_heap.top();
+                m_heap.pop();
+
+                if (!m_posAlive[c.from] || !m_posAlive[c.to]) { continue; }
+                if (m_version[c.from] != c.fromVersion || m_version[c.to] != c.toVersion) { continue; }
+
+                if (c.cost > maxErrorSq) { return false; }
+
+                if (!CanCollapse(c.from, c.to)) { continue; }
+
+                Collapse(c.from, c.to);
+                m_maxError = std::max(m_maxError, c.cost);
+            }
+            return true;
+        }
+
+        //̏ԂCfbNXɂ(̎Op`ۂ)
+        std::vector<uint32_t> Snapshot() const
+        {
+            std::vector<uint32_t> out;
+            out.reserve(m_liveTriangles * 3);
+
+            for (size_t t = 0; t < m_triPos.size(); ++t)
+            {
+                if (!m_triAlive[t]) { continue; }
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    out.push_back(PickVertex(m_triVert[t][k], m_triPos[t][k]));
+                }
+            }
+            return out;
+        }
+
+    private:
+        const uint8_t* VertexPtr(const float* base, size_t v) const
+        {
+            return reinterpret_cast<const uint8_t*>(base) + v * m_stride;
+        }
+
+        //W̒_܂Ƃ߂(UV̌pڂŕꂽ_1̈ʒuƂĈ)
+        void BuildPositions(const float* positions, size_t vertexCount)
+        {
+            struct Key
+            {
+                float v[3];
+                bool operator==(const Key& o) const { return memcmp(v, o.v, sizeof(v)) == 0; }
+            };
+            struct KeyHash
+            {
+                size_t operator()(const Key& k) const
+                {
+                    uint32_t b[3];
+                    memcpy(b, k.v, sizeof(b));
+                    return (b[0] * 73856093u) ^ (b[1] * 19349663u) ^ (b[2] * 83492791u);
+                }
+            };
+
+            std::unordered_map<Key, uint32_t, KeyHash> lookup;
+            lookup.reserve(vertexCount);
+
+            m_posOf.resize(vertexCount);
+
+            Vec3 minP{ 1e30, 1e30, 1e30 };
+            Vec3 maxP{ -1e30, -1e30, -1e30 };
+
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                Key key;
+                memcpy(key.v, VertexPtr(positions, v), sizeof(key.v));
+
+                auto it = lookup.find(key);
+                if (it == lookup.end())
+                {
+                    uint32_t id = static_cast<uint32_t>(m_pos.size());
+                    lookup.emplace(key, id);
+
+                    Vec3 p{ key.v[0], key.v[1], key.v[2] };
+                    m_pos.push_back(p);
+
+                    minP = { std::min(minP.x, p.x), std::min(minP.y, p.y), std::min(minP.z, p.z) };
+                    maxP = { std::max(maxP.x, p.x), std::max(maxP.y, p.y), std::max(maxP.z, p.z) };
+
+                    m_posOf[v] = id;
+                }
+                else
+                {
+                    m_posOf[v] = it->second;
+                }
+            }
+
+            m_posCount = static_cast<uint32_t>(m_pos.size());
+            m_extent = std::max(Length(maxP - minP), 1e-9);
+
+            //ʒu̒_Xg
+            m_posVertexStart.assign(m_posCount + 1, 0);
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                m_posVertexStart[m_posOf[v] + 1]++;
+            }
+            for (uint32_t p = 0; p < m_posCount; ++p)
+            {
+                m_posVertexStart[p + 1] += m_posVertexStart[p];
+            }
+            m_posVertices.resize(vertexCount);
+            std::vector<uint32_t> fill(m_posVertexStart.begin(), m_posVertexStart.end() - 1);
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                m_posVertices[fill[m_posOf[v]]++] = static_cast<uint32_t>(v);
+            }
+
+            m_posAlive.assign(m_posCount, 1);
+            m_version.assign(m_posCount, 0);
+            m_posTris.resize(m_posCount);
+        }
+
+        void BuildTriangles(const std::vector<uint32_t>& indices)
+        {
+            const size_t triCount = indices.size() / 3;
+            m_triPos.reserve(triCount);
+            m_triVert.reserve(triCount);
+            m_triAlive.reserve(triCount);
+
+            for (size_t t = 0; t < triCount; ++t)
+            {
+                uint32_t v0 = indices[t * 3 + 0];
+                uint32_t v1 = indices[t * 3 + 1];
+                uint32_t v2 = indices[t * 3 + 2];
+
+                TriIndex tv = { v0, v1, v2 };
+                TriIndex tp = { m_posOf[v0], m_posOf[v1], m_posOf[v2] };
+
+                //ƂƒׂĂOp`͎̂Ă
+                bool degenerate = (tp[0] == tp[1] || tp[1] == tp[2] || tp[0] == tp[2]);
+
+                uint32_t id = static_cast<uint32_t>(m_triPos.size());
+                m_triPos.push_back(tp);
+                m_triVert.push_back(tv);
+                m_triAlive.push_back(degenerate ? 0 : 1);
+
+                if (degenerate) { continue; }
+
+                m_liveTriangles++;
+                for (int k = 0; k < 3; ++k)
+                {
+                    m_posTris[tp[k]].push_back(id);
+                }
+            }
+        }
+
+        void BuildQuadrics()
+        {
+            m_quadric.assign(m_posCount, Quadric{});
+
+            //ӂ̎gp(1񂾂Ȃ牏)
+            std::unordered_map<uint64_t, int> edgeUse;
+            edgeUse.reserve(m_liveTriangles * 3);
+
+            auto edgeKey = [](uint32_t a, uint32_t b)
+            {
+                if (a > b) { std::swap(a, b); }
+                return (static_cast<uint64_t>(a) << 32) | b;
+            };
+
+            for (size_t t = 0; t < m_triPos.size(); ++t)
+            {
+                if (!m_triAlive[t]) { continue; }
+
+                const TriIndex& tp = m_triPos[t];
+                Vec3 n = Cross(m_pos[tp[1]] - m_pos[tp[0]], m_pos[tp[2]] - m_pos[tp[0]]);
+                double len = Length(n);
+                if (len <= 0.0) { continue; }
+
+                double area = len * 0.5;
+                n = { n.x / len, n.y / len, n.z / len };
+                double d = -Dot(n, m_pos[tp[0]]);
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    m_quadric[tp[k]].AddPlane(n, d, area);
+                    edgeUse[edgeKey(tp[k], tp[(k + 1) % 3])]++;
+                }
+            }
+
+            //̕ӂɂ͖ʂɐȕʂ𑫂āA֊sk܂Ȃ悤ɂ
+            for (size_t t = 0; t < m_triPos.size(); ++t)
+            {
+                if (!m_triAlive[t]) { continue; }
+
+                const TriIndex& tp = m_triPos[t];
+                Vec3 faceN = Cross(m_pos[tp[1]] - m_pos[tp[0]], m_pos[tp[2]] - m_pos[tp[0]]);
+                if (Length(faceN) <= 0.0) { continue; }
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    uint32_t a = tp[k];
+                    uint32_t b = tp[(k + 1) % 3];
+                    if (edgeUse[edgeKey(a, b)] != 1) { continue; }
+
+                    Vec3 edge = m_pos[b] - m_pos[a];
+                    Vec3 n = Cross(edge, faceN);
+                    double len = Length(n);
+                    if (len <= 0.0) { continue; }
+
+                    n = { n.x / len, n.y / len, n.z / len };
+                    double d = -Dot(n, m_pos[a]);
+                    double w = Dot(edge, edge) * BORDER_WEIGHT;
+
+                    m_quadric[a].AddPlane(n, d, w);
+                    m_quadric[b].AddPlane(n, d, w);
+                }
+            }
+        }
+
+        double Cost(uint32_t from, uint32_t to) const
+        {
+            Quadric q = m_quadric[from];
+            q.Add(m_quadric[to]);
+
+            //d(ʐ)ŊāAϓIȋ̓ɂ
+            return q.Eval(m_pos[to]) / std::max(q.weight, 1e-20);
+        }
+
+        void PushCandidates(uint32_t p)
+        {
+            for (uint32_t t : m_posTris[p])
+            {
+                if (!m_triAlive[t]) { continue; }
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    uint32_t q = m_triPos[t][k];
+                    if (q == p) { continue; }
+
+                    m_heap.push({ Cost(p, q), p, q, m_version[p], m_version[q] });
+                    m_heap.push({ Cost(q, p), q, p, m_version[q], m_version[p] });
+                }
+            }
+        }
+
+        //from  to ɈڂɗԂOp`
+        bool CanCollapse(uint32_t from, uint32_t to) const
+        {
+            bool adjacent = false;
+
+            for (uint32_t t : m_posTris[from])
+            {
+                if (!m_triAlive[t]) { continue; }
+
+                const TriIndex& tp = m_triPos[t];
+                if (tp[0] == to || tp[1] == to || tp[2] == to)
+                {
+                    adjacent = true;
+                    continue;   //̎Op`͏
+                }
+
+                Vec3 p0 = m_pos[tp[0]];
+                Vec3 p1 = m_pos[tp[1]];
+                Vec3 p2 = m_pos[tp[2]];
+                Vec3 before = Cross(p1 - p0, p2 - p0);
+
+                if (tp[0] == from) { p0 = m_pos[to]; }
+                if (tp[1] == from) { p1 = m_pos[to]; }
+                if (tp[2] == from) { p2 = m_pos[to]; }
+                Vec3 after = Cross(p1 - p0, p2 - p0);
+
+                double lb = Length(before);
+                double la = Length(after);
+                if (la <= 0.0 || lb <= 0.0) { return false; }
+
+                if (Dot(before, after) < MIN_NORMAL_DOT * lb * la) { return false; }
+            }
+
+            return adjacent;
+        }
+
+        void Collapse(uint32_t from, uint32_t to)
+        {
+            for (uint32_t t : m_posTris[from])
+            {
+                if (!m_triAlive[t]) { continue; }
+
+                TriIndex& tp = m_triPos[t];
+                if (tp[0] == to || tp[1] == to || tp[2] == to)
+                {
+                    m_triAlive[t] = 0;
+                    m_liveTriangles--;
+                    continue;
+                }
+
+                for (int k = 0; k < 3; ++k)
+                {
+                    if (tp[k] == from) { tp[k] = to; }
+                }
+                m_posTris[to].push_back(t);
+            }
+
+            m_quadric[to].Add(m_quadric[from]);
+            m_posAlive[from] = 0;
+            std::vector<uint32_t>().swap(m_posTris[from]);
+
+            //Op`l߂Ă
+            auto& list = m_posTris[to];
+            list.erase(std::remove_if(list.begin(), list.end(),
+                [this](uint32_t t) { return !m_triAlive[t]; }), list.end());
+
+            m_version[to]++;
+            PushCandidates(to);
+        }
+
+        //̒_ vertex ͈ʒu pos ɂ鎞AۂɎg_I
+        //(ʒu̒_̂UVԋ߂)
+        uint32_t PickVertex(uint32_t vertex, uint32_t pos) const
+        {
+            if (m_posOf[vertex] == pos) { return vertex; }
+
+            uint32_t begin = m_posVertexStart[pos];
+            uint32_t end = m_posVertexStart[pos + 1];
+            if (!m_uvs || end - begin == 1) { return m_posVertices[begin]; }
+
+            const float* uv = reinterpret_cast<const float*>(VertexPtr(m_uvs, vertex));
+
+            uint32_t best = m_posVertices[begin];
+            float bestDist = 1e30f;
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                const float* other = reinterpret_cast<const float*>(VertexPtr(m_uvs, m_posVertices[i]));
+                float du = other[0] - uv[0];
+                float dv = other[1] - uv[1];
+                float dist = du * du + dv * dv;
+                if (dist < bestDist)
+                {
+                    bestDist = dist;
+                    best = m_posVertices[i];
+                }
+            }
+            return best;
+        }
+
+        const float* m_uvs;
+        size_t m_stride;
+
+        //ʒu(W̒_܂Ƃ߂)
+        uint32_t m_posCount = 0;
+        std::vector<Vec3> m_pos;
+        std::vector<uint32_t> m_posOf;              //_  ʒu
+        std::vector<uint32_t> m_posVertexStart;     //ʒu  _Xg͈̔
+        std::vector<uint32_t> m_posVertices;
+        std::vector<uint8_t> m_posAlive;
+        std::vector<uint32_t> m_version;            //ςxɐi߂(Â̂Ă)
+        std::vector<std::vector<uint32_t>> m_posTris;
+        std::vector<Quadric> m_quadric;
+
+        //Op`
+        std::vector<TriIndex> m_triPos;             //Op`̈ʒu(kŏ)
+        std::vector<TriIndex> m_triVert;            //Op`̌̒_
+        std::vector<uint8_t> m_triAlive;
+        size_t m_liveTriangles = 0;
+
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> m_heap;
+
+        double m_extent = 1.0;
+        double m_maxError = 0.0;
+    };
+}
+
+std::vector<SimplifyLevel> SimplifyMeshLevels(const float* positions,
+                                              const float* uvs,
+                                              size_t vertexStride,
+                                              size_t vertexCount,
+                                              const std::vector<uint32_t>& indices,
+                                              const std::vector<float>& targetRatios,
+                                              float maxError)
+{
+    std::vector<SimplifyLevel> levels;
+    if (!positions || vertexCount == 0 || indices.size() < 3) { return levels; }
+
+    Simplifier simplifier(positions, uvs, vertexStride, vertexCount, indices);
+
+    const double maxErrorAbs = maxError * simplifier.GetExtent();
+    const double maxErrorSq = maxErrorAbs * maxErrorAbs;
+
+    size_t previousTriangles = simplifier.GetLiveTriangles();
+
+    for (float ratio : targetRatios)
+    {
+        size_t target = static_cast<size_t>(simplifier.GetSourceTriangles() * ratio);
+        bool reached = simplifier.Run(target, maxErrorSq);
+
+        size_t live = simplifier.GetLiveTriangles();
+        if (live > 0 && live <= previousTriangles * MIN_LEVEL_REDUCTION)
+        {
+            SimplifyLevel level;
+            level.indices = simplifier.Snapshot();
+            level.error = static_cast<float>(std::sqrt(simplifier.GetMaxError()) / simplifier.GetExtent());
+            levels.push_back(std::move(level));
+            previousTriangles = live;
+        }
+
+        //덷̏ɒB炻ȏ͌点Ȃ
+        if (!reached) { break; }
+    }
+
+    return levels;
+}
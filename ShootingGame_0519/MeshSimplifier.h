@@ -0,0 +1,32 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+//---------------------------------------------------------
+// 񎟌덷(Quadric Error Metrics)ɂӏkŃbVȗ
+// _obt@͂̂܂܂ɂāAg_炵CfbNX
+// (LOD ɒ_obt@ȂčςށBGPUɂ͐GȂ)
+//---------------------------------------------------------
+
+//ȗ1x
+struct SimplifyLevel
+{
+    std::vector<uint32_t> indices;  //Op`Xg
+    float error = 0.0f;             //̌`̂(bV̑傫ɑ΂銄)
+};
+
+//positions : _W(float3)̐擪
+//uvs : eNX`W(float2)̐擪(nullptr ȂgȂ)
+//      ʒuɕ̒_(UV̌p)ɁAk̒_IԂ̂Ɏg
+//vertexStride : _1̃oCg
+//targetRatios : ex̖ڕWOp`(ɑ΂銄B傫)
+//maxError : ȏジk͂Ȃ(bV̑傫ɑ΂銄)
+//߂l : ꂽxԂ(ÕxقƂǌȂx͏Ȃ)
+std::vector<SimplifyLevel> SimplifyMeshLevels(const float* positions,
+                                              const float* uvs,
+                                              size_t vertexStride,
+                                              size_t vertexCount,
+                                              const std::vector<uint32_t>& indices,
+                                              const std::vector<float>& targetRatios,
+                                              float maxError);
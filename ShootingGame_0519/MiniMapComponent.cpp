@@ -1,4 +1,5 @@
 #include "MiniMapComponent.h"
+#include <d3d11.h>
 #include "Renderer.h"
 #include "GameObject.h"
 #include <algorithm>
@@ -101,7 +102,7 @@ void MiniMapComponent::Draw(float alpha)
 	//wi`
 	if (m_backgroundSRV)
 	{
-		Renderer::DrawTexture(m_backgroundSRV, m_screenPos, m_size);
+		Renderer::DrawTexture(m_backgroundSRV.Get(), m_screenPos, m_size);
 
 	}
 	
@@ -112,7 +113,7 @@ void MiniMapComponent::Draw(float alpha)
 	{
 		Vector2 center = { m_screenPos.x + m_size.x * 0.5f, m_screenPos.y + m_size.y * 0.5f };
 		Vector2 drawPos = { center.x - iconSize.x * 0.5f, center.y - iconSize.y * 0.5f };
-		Renderer::DrawTexture(m_playerIconSRV, drawPos, iconSize);
+		Renderer::DrawTexture(m_playerIconSRV.Get(), drawPos, iconSize);
 	}
 
 	//ACR`
@@ -126,7 +127,7 @@ void MiniMapComponent::Draw(float alpha)
 			Vector2 bPixel = WorldToMiniMap(bPos, playerPos, playerYaw);
 
 			Vector2 drawPos = { bPixel.x - (iconSize.x * 0.5f), bPixel.y - (iconSize.y * 0.5f) };
-			Renderer::DrawTexture(m_buildingIconSRV, drawPos, iconSize);
+			Renderer::DrawTexture(m_buildingIconSRV.Get(), drawPos, iconSize);
 		}
 	}
 
@@ -141,7 +142,7 @@ void MiniMapComponent::Draw(float alpha)
 			Vector2 ePixel = WorldToMiniMap(ePos, playerPos, playerYaw);
 
 			Vector2 drawPos = { ePixel.x - (iconSize.x * 0.5f), ePixel.y - (iconSize.y * 0.5f) };
-			Renderer::DrawTexture(m_enemyIconSRV, drawPos, iconSize);
+			Renderer::DrawTexture(m_enemyIconSRV.Get(), drawPos, iconSize);
 		}
 	}
 }
\ No newline at end of file
@@ -53,10 +53,10 @@ private:
 	DirectX::SimpleMath::Vector2 m_size{ 256.0f,256.0f };
 	float m_iconSizePx = 10.0f;
 
-	ID3D11ShaderResourceView* m_backgroundSRV   = nullptr;
-	ID3D11ShaderResourceView* m_playerIconSRV   = nullptr;
-	ID3D11ShaderResourceView* m_enemyIconSRV    = nullptr;
-	ID3D11ShaderResourceView* m_buildingIconSRV = nullptr;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_backgroundSRV;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_playerIconSRV;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_enemyIconSRV;
+	Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_buildingIconSRV;
 
 	//-----------~j}bvϊϐ-------------
 	float m_coverageRadius = 200.0f; //~j}bvʂ͈͂̔a
@@ -2,6 +2,7 @@
 #include <WICTextureLoader.h> 
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
+#include <d3d11.h>
 #include "renderer.h"
 #include <filesystem>
 #include <iostream>
@@ -0,0 +1,93 @@
+#include "ModelCache.h"
+
+AssetTable<ModelAssetTag, ModelCache::Entry> ModelCache::m_models;
+
+namespace
+{
+    size_t GetBufferBytes(ID3D11Buffer* buffer)
+    {
+        if (!buffer) { return 0; }
+
+        D3D11_BUFFER_DESC desc{};
+        buffer->GetDesc(&desc);
+        return desc.ByteWidth;
+    }
+
+    //GPU obt@̍v(wbhXł̓obt@̂ 0)
+    size_t GetModelBytes(const ModelData& model)
+    {
+        size_t total = 0;
+        for (const auto& mesh : model.meshes)
+        {
+            total += GetBufferBytes(mesh.vertexBuffer.Get());
+            total += GetBufferBytes(mesh.indexBuffer.Get());
+            for (const auto& lod : mesh.lods)
+            {
+                total += GetBufferBytes(lod.indexBuffer.Get());
+            }
+        }
+        return total;
+    }
+}
+
+std::shared_ptr<ModelData> ModelCache::Find(const std::string& path)
+{
+    if (Entry* entry = m_models.Find(ModelId::FromString(path), path.c_str()))
+    {
+        entry->lastUsedFrame = ResidencyManager::GetFrame();
+        return entry->model;
+    }
+
+    return nullptr;
+}
+
+void ModelCache::Add(const std::string& path, const std::shared_ptr<ModelData>& model)
+{
+    if (!model) { return; }
+
+    const ModelId id = ModelId::FromString(path);
+    if (Entry* old = m_models.Find(id, path.c_str()))
+    {
+        ResidencyManager::OnReleased(RESIDENT_MODEL, old->bytes);
+    }
+
+    const size_t bytes = GetModelBytes(*model);
+    m_models.Insert(id, path.c_str(), Entry{ model, bytes, ResidencyManager::GetFrame() });
+    ResidencyManager::OnLoaded(RESIDENT_MODEL, bytes);
+}
+
+void ModelCache::Clear()
+{
+    m_models.ForEach([](ModelId, Entry& entry)
+    {
+        ResidencyManager::OnReleased(RESIDENT_MODEL, entry.bytes);
+    });
+    m_models.Clear();
+}
+
+void ModelCache::GatherResident(std::vector<ResidentAsset>& out)
+{
+    m_models.ForEach([&](ModelId id, Entry& entry)
+    {
+        ResidentAsset asset;
+        asset.id = id.value;
+        asset.bytes = entry.bytes;
+        asset.lastUsedFrame = entry.lastUsedFrame;
+        asset.referenced = entry.model.use_count() > 1;
+        asset.name = entry.model->path.c_str();
+        out.push_back(asset);
+    });
+}
+
+bool ModelCache::Evict(uint64_t id)
+{
+    Entry* entry = m_models.Find(ModelId(id));
+    if (!entry || entry->model.use_count() > 1)
+    {
+        return false;
+    }
+
+    //fĂeNX`͂ŎQƂOA Trim  TextureManager O
+    ResidencyManager::OnReleased(RESIDENT_MODEL, entry->bytes);
+    return m_models.Erase(ModelId(id));
+}
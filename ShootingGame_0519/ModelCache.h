@@ -1 +1,142 @@
 #pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <d3d11.h>
+#include <wrl/client.h>
+#include <DirectXCollision.h>
+#include "renderer.h"
+#include "AssetTable.h"
+#include "ResidencyManager.h"
+
+//---------------------------------------------------------
+// ft@CGPU\[X𕡐ModelComponentŋLLbV
+// (G@̂悤ɓfʂɕׂ鎞ɁAVB/IB/SRV1ɂ܂Ƃ߂)
+//---------------------------------------------------------
+
+//ȗbV1x(_obt@͌̃bVƋL)
+struct ModelMeshLod
+{
+    Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuffer;
+    UINT indexCount = 0;
+    float error = 0.0f;     //̌`̂(bV̑傫ɑ΂銄)
+};
+
+//1bVGPUf[^
+struct ModelMeshData
+{
+    Microsoft::WRL::ComPtr<ID3D11Buffer> vertexBuffer;
+    Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuffer;
+    UINT indexCount = 0;
+
+    //_̌`(packedVertices Ȃ VERTEX_PACKEDAȊO VERTEX_3D)
+    bool packedVertices = false;
+    UINT vertexStride = sizeof(VERTEX_3D);
+
+    //_ 65536 ȉȂ 16bit CfbNX(LOD ̃CfbNXobt@`)
+    RENDER_INDEX_FORMAT indexFormat = RIF_UINT32;
+
+    //LOD x1ȍ~(x0͏ indexBuffer / indexCount)
+    std::vector<ModelMeshLod> lods;
+
+    MATERIAL material{};    //ǂݍݎ̃}eA(eModelComponent͂Rs[Ďg)
+
+    //eNX`ΉiKvɉđ₷j
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srvDiffuse;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srvNormal;
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srvSpecular;
+
+    //[JԂł̋E(JOp)
+    DirectX::BoundingSphere bounds;
+
+    //XLjOpF̃bVɊ܂܂{[̖OXg
+    std::vector<std::string> boneNames;
+
+    //ǂݍݎ̍œǨ(_LbV̌ VB/IB ̃oCgBLOD ܂)
+    float acmrBefore = 0.0f;
+    float acmrAfter = 0.0f;
+    UINT bytesBefore = 0;
+    UINT bytesAfter = 0;
+
+    //--------Get֐-------
+    //x0܂LOD̐
+    int GetLodCount() const { return 1 + static_cast<int>(lods.size()); }
+
+    //͈͊Õx͈ԑexɊۂ߂
+    ID3D11Buffer* GetIndexBuffer(int level) const
+    {
+        if (level <= 0 || lods.empty()) { return indexBuffer.Get(); }
+        return lods[std::min<size_t>(level, lods.size()) - 1].indexBuffer.Get();
+    }
+
+    UINT GetIndexCount(int level) const
+    {
+        if (level <= 0 || lods.empty()) { return indexCount; }
+        return lods[std::min<size_t>(level, lods.size()) - 1].indexCount;
+    }
+};
+
+//1fGPUf[^
+struct ModelData
+{
+    std::string path;
+    std::vector<ModelMeshData> meshes;
+
+    //SbV͂ދE([JԁBLOD ̑IɎg)
+    DirectX::BoundingSphere bounds;
+};
+
+//GPU ɏグO1bV(data  GPU obt@EeNX`ȊO𖄂߂Ă)
+struct PreparedMesh
+{
+    ModelMeshData data;
+    std::vector<VERTEX_3D> vertices;            //data.packedVertices Ȃ
+    std::vector<VERTEX_PACKED> packedVertices;
+    std::vector<uint32_t> indices;
+    std::vector<std::vector<uint32_t>> lodIndices;  //data.lods Ɠ
+
+    //eNX`̃pX(΋)
+    std::string diffusePath;
+    std::string normalPath;
+    std::string specularPath;
+};
+
+//GPU ɏグO1f(D3D GȂ̂Ń[J[Xbhō)
+struct PreparedModel
+{
+    std::string path;
+    std::vector<PreparedMesh> meshes;
+    DirectX::BoundingSphere bounds;
+
+    //ǂݍ݃Op
+    size_t boneCount = 0;
+    size_t materialCount = 0;
+};
+
+class ModelCache
+{
+public:
+    //LbVς݂̃fT(nullptr)
+    static std::shared_ptr<ModelData> Find(const std::string& path);
+
+    //ǂݍ񂾃fo^
+    static void Add(const std::string& path, const std::shared_ptr<ModelData>& model);
+
+    static void Clear();
+
+    //-----------------------풓Ǘ(ResidencyManager ɓo^)-----------------------
+    //ModelComponent  shared_ptr ĂԂ͊OȂ
+    static void GatherResident(std::vector<ResidentAsset>& out);
+    static bool Evict(uint64_t id);
+
+private:
+    struct Entry
+    {
+        std::shared_ptr<ModelData> model;
+        size_t bytes = 0;           //_ECfbNXobt@(eNX` TextureManager Ő)
+        uint64_t lastUsedFrame = 0;
+    };
+
+    static AssetTable<ModelAssetTag, Entry> m_models;
+};
@@ -1,10 +1,16 @@
 #include "ModelComponent.h"
+#include <d3d11.h>
 #include "Renderer.h"
 #include "GameObject.h"
 #include "Application.h"
 #include "TextureManager.h" //  TextureManager gp
+#include "InstancedRenderer.h"
+#include "RenderQueue.h"
+#include "MeshOptimizer.h"
 #include <WICTextureLoader.h>
+#include <DirectXPackedVector.h>
 #include <iostream>
+#include <algorithm>
 
 #ifdef _WIN32
 #include <windows.h> // MultiByteToWideChar g
@@ -13,6 +19,83 @@
 
 using Microsoft::WRL::ComPtr;
 
+namespace
+{
+    // UV ͈̔͂Ɏ܂ half ŎĂ 1/512 ȉ̌덷ōς
+    constexpr float PACK_TEXCOORD_LIMIT = 4.0f;
+
+    uint32_t PackSnorm8x4(float x, float y, float z, float w)
+    {
+        auto pack = [](float v) -> uint32_t
+        {
+            v = std::clamp(v, -1.0f, 1.0f);
+            return static_cast<uint32_t>(static_cast<int8_t>(std::lround(v * 127.0f))) & 0xFF;
+        };
+        return pack(x) | (pack(y) << 8) | (pack(z) << 16) | (pack(w) << 24);
+    }
+
+    uint32_t PackUnorm8x4(float x, float y, float z, float w)
+    {
+        auto pack = [](float v) -> uint32_t
+        {
+            return static_cast<uint32_t>(std::lround(std::clamp(v, 0.0f, 1.0f) * 255.0f));
+        };
+        return pack(x) | (pack(y) << 8) | (pack(z) << 16) | (pack(w) << 24);
+    }
+
+    // VERTEX_3D  VERTEX_PACKED ɋl߂(UV 傫 half ŎĂȂ false)
+    bool PackVertices(const std::vector<VERTEX_3D>& vertices, std::vector<VERTEX_PACKED>& out)
+    {
+        for (const auto& v : vertices)
+        {
+            if (std::abs(v.TexCoord.x) >= PACK_TEXCOORD_LIMIT || std::abs(v.TexCoord.y) >= PACK_TEXCOORD_LIMIT)
+            {
+                return false;
+            }
+        }
+
+        out.resize(vertices.size());
+        for (size_t i = 0; i < vertices.size(); ++i)
+        {
+            const VERTEX_3D& v = vertices[i];
+            VERTEX_PACKED& p = out[i];
+
+            p.Position = v.Position;
+            p.Normal = PackSnorm8x4(v.Normal.x, v.Normal.y, v.Normal.z, 0.0f);
+            p.Diffuse = PackUnorm8x4(v.Diffuse.x, v.Diffuse.y, v.Diffuse.z, v.Diffuse.w);
+            p.TexCoord[0] = DirectX::PackedVector::XMConvertFloatToHalf(v.TexCoord.x);
+            p.TexCoord[1] = DirectX::PackedVector::XMConvertFloatToHalf(v.TexCoord.y);
+        }
+        return true;
+    }
+
+    // CfbNXobt@ format (16bit / 32bit) ō
+    HRESULT CreateIndexBuffer(const std::vector<uint32_t>& indices, RENDER_INDEX_FORMAT format, ID3D11Buffer** out)
+    {
+        std::vector<uint16_t> indices16;
+        const void* data = indices.data();
+        UINT indexSize = sizeof(uint32_t);
+
+        if (format == RIF_UINT16)
+        {
+            indices16.assign(indices.begin(), indices.end());
+            data = indices16.data();
+            indexSize = sizeof(uint16_t);
+        }
+
+        D3D11_BUFFER_DESC ibDesc{};
+        ibDesc.Usage = D3D11_USAGE_DEFAULT;
+        ibDesc.ByteWidth = static_cast<UINT>(indexSize * indices.size());
+        ibDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+        ibDesc.CPUAccessFlags = 0;
+
+        D3D11_SUBRESOURCE_DATA ibData{};
+        ibData.pSysMem = data;
+
+        return Renderer::GetDevice()->CreateBuffer(&ibDesc, &ibData, out);
+    }
+}
+
 // RXgN^ (t@CpXw)
 ModelComponent::ModelComponent(const std::string& filepath)
     : m_filepath(filepath)
@@ -38,54 +121,91 @@ void ModelComponent::Update(float dt)
 // `
 void ModelComponent::Draw(float alpha)
 {
-    Matrix4x4 worldMatrix = GetOwner()->GetTransform().GetMatrix();
-    Renderer::SetWorldMatrix(&worldMatrix);
-
-    ID3D11DeviceContext* ctx = Renderer::GetDeviceContext();
+    if (!m_model) { return; }
 
-    for (auto& mesh : m_meshes)
+    // CX^X`Ȃ܂Ƃ߂ĕ`̂œo^
+    if (m_useInstancing)
     {
-        if (mesh.material.Diffuse.w < 1.0f)
-        {
-            Renderer::SetBlendState(BS_ALPHABLEND);
-        }
-        else
+        Matrix4x4 worldMatrix = GetOwner()->GetTransform().GetMatrix();
+        int lod = SelectLodLevel(worldMatrix);
+
+        for (size_t i = 0; i < m_model->meshes.size(); ++i)
         {
-            Renderer::SetBlendState(BS_NONE);
+            InstancedRenderer::Submit(m_model->meshes[i], worldMatrix, m_meshMaterials[i].Diffuse, lod);
         }
+        return;
+    }
 
-        Renderer::SetMaterial(mesh.material);
+    // ȊO RenderQueue ɓo^ApPbg̓[J[XbhōĂ炤
+    RenderQueue::AddSource(this);
+}
 
-        UINT stride = sizeof(VERTEX_3D);
-        UINT offset = 0;
+void ModelComponent::BuildDrawPackets(const DrawBuildContext& context, DrawPacketList& out) const
+{
+    if (!m_model) { return; }
 
-        ctx->IASetVertexBuffers(0, 1, mesh.vertexBuffer.GetAddressOf(), &stride, &offset);
-        ctx->IASetIndexBuffer(mesh.indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
-        ctx->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    Matrix4x4 worldMatrix = GetOwner()->GetTransform().GetMatrix();
+    int lod = SelectLodLevel(worldMatrix);
 
-        ID3D11ShaderResourceView* srv = mesh.srvDiffuse.Get();
-        ctx->PSSetShaderResources(0, 1, &srv);
+    for (size_t i = 0; i < m_model->meshes.size(); ++i)
+    {
+        const ModelMeshData& mesh = m_model->meshes[i];
+
+        // JO
+        DirectX::BoundingSphere worldBounds;
+        mesh.bounds.Transform(worldBounds, worldMatrix);
+        if (context.frustum.Contains(worldBounds) == DirectX::DISJOINT) { continue; }
+
+        int meshLod = std::min(lod, mesh.GetLodCount() - 1);
+        MeshLod::AddStats(meshLod, mesh.indexCount, mesh.GetIndexCount(meshLod));
+
+        DrawPacket packet;
+        packet.inputLayout = mesh.packedVertices ? Renderer::m_packedInputLayout.Get() : nullptr;
+        packet.vertexBuffer = mesh.vertexBuffer.Get();
+        packet.stride = mesh.vertexStride;
+        packet.indexBuffer = mesh.GetIndexBuffer(meshLod);
+        packet.indexFormat = mesh.indexFormat;
+        packet.indexCount = mesh.GetIndexCount(meshLod);
+        packet.material = m_meshMaterials[i];
+        packet.texture = mesh.srvDiffuse.Get();
+        packet.blendState = (packet.material.Diffuse.w < 1.0f) ? BS_ALPHABLEND : BS_NONE;
+        packet.world = worldMatrix;
+
+        out.Add(packet);
+    }
+}
 
-        ctx->DrawIndexed(mesh.indexCount, 0, 0);
+int ModelComponent::SelectLodLevel(const Matrix4x4& worldMatrix) const
+{
+    // LODbV1ΑI΂Ȃ
+    int levelCount = 1;
+    for (const auto& mesh : m_model->meshes)
+    {
+        levelCount = std::max(levelCount, mesh.GetLodCount());
     }
+    if (levelCount <= 1) { return 0; }
+
+    DirectX::BoundingSphere worldBounds;
+    m_model->bounds.Transform(worldBounds, worldMatrix);
 
-    Renderer::SetBlendState(BS_NONE);
+    m_lodLevel = MeshLod::SelectLevel(MeshLod::GetScreenSize(worldBounds), m_lodLevel, levelCount);
+    return m_lodLevel;
 }
 
 void ModelComponent::SetColor(const Color& color)
 {
     // VvɑSbṼ}eA Diffuse ㏑
-    for (auto& mesh : m_meshes)
+    for (auto& material : m_meshMaterials)
     {
-        mesh.material.Diffuse = color;
+        material.Diffuse = color;
     }
 }
 
 void ModelComponent::SetAlpha(float alpha)
 {
-    for (auto& mesh : m_meshes)
+    for (auto& material : m_meshMaterials)
     {
-        mesh.material.Diffuse.w = alpha;
+        material.Diffuse.w = alpha;
     }
 }
 
@@ -112,88 +232,417 @@ bool ModelComponent::FileExists(const std::string& path)
 }
 
 
-// }eAƃeNX`̓ǂݍ
-void ModelComponent::LoadMaterials(const aiScene* scene)
+namespace
 {
-    m_materials.clear();
-    m_materials.resize(scene->mNumMaterials);
+    // XLjOî߂̃f[^j
+    struct BoneInfo
+    {
+        std::string name;                 // {[
+        aiMatrix4x4 offsetMatrix;         // inverse bind pose
+        // ŏIϊs (Aj[VvZɂɓ)
+        aiMatrix4x4 finalTransform;
+    };
+
+    // PrepareModel ̓ȑ(Ăяoɍ̂Ń[J[mŋLȂ)
+    struct PrepareContext
+    {
+        const aiScene* scene = nullptr;
+        std::string directory;                  // eNX`̃pX̊
+        std::vector<MATERIAL> materials;        // V[Pʂ̃}eA
+        std::vector<BoneInfo> boneInfos;
+        std::unordered_map<std::string, int> boneNameToIndex;
+        MeshLodFile* lodFile = nullptr;
+        PreparedModel* model = nullptr;
+    };
+
+    // }eA̓ǂݍ
+    void LoadMaterials(PrepareContext& ctx)
+    {
+        const aiScene* scene = ctx.scene;
+        ctx.materials.clear();
+        ctx.materials.resize(scene->mNumMaterials);
 
-    for (UINT i = 0; i < scene->mNumMaterials; ++i)
+        for (UINT i = 0; i < scene->mNumMaterials; ++i)
+        {
+            aiMaterial* aimat = scene->mMaterials[i];
+            MATERIAL mat{}; //  MATERIAL \̂ɍ킹ď
+
+            // O
+            aiString name;
+            if (AI_SUCCESS == aimat->Get(AI_MATKEY_NAME, name))
+            {
+                // MATERIAL ɖOtB[h΃Zbg (͉)
+                // mat.Name = name.C_Str();
+            }
+
+            // J[ (Diffuse/Specular/Ambient Ȃ)
+            aiColor4D col;
+            if (AI_SUCCESS == aimat->Get(AI_MATKEY_COLOR_DIFFUSE, col))
+            {
+                mat.Diffuse = Color(col.r, col.g, col.b, col.a);
+            }
+            if (AI_SUCCESS == aimat->Get(AI_MATKEY_COLOR_AMBIENT, col))
+            {
+                mat.Ambient = Color(col.r, col.g, col.b, col.a);
+            }
+            if (AI_SUCCESS == aimat->Get(AI_MATKEY_COLOR_SPECULAR, col))
+            {
+                mat.Specular = Color(col.r, col.g, col.b, col.a);
+            }
+
+            // eNX` MeshData ŌʂɎ擾
+
+            ctx.materials[i] = mat;
+        }
+    }
+
+    // aiMaterial ̃eNX`^CṽpXԂ (݂ȂEߍ݂Ȃ)
+    // ǂݍ(SRV 쐬) UploadModel ŃCXbhs
+    std::string GetTexturePath(const PrepareContext& ctx, aiMaterial* mat, aiTextureType t)
     {
-        aiMaterial* aimat = scene->mMaterials[i];
-        MATERIAL mat{}; //  MATERIAL \̂ɍ킹ď
+        aiString texPath;
+        if (mat->GetTextureCount(t) > 0 && mat->GetTexture(t, 0, &texPath) == AI_SUCCESS)
+        {
+            std::string tex = texPath.C_Str();
 
-        // O
-        aiString name;
-        if (AI_SUCCESS == aimat->Get(AI_MATKEY_NAME, name))
+            // ߍ݃eNX`Ȃ (: "*0") Ōo
+            if (!tex.empty() && tex[0] == '*')
+            {
+                return std::string();
+            }
+
+            // t@CpX̐K (/΂̔)
+            std::filesystem::path p(tex);
+            if (!p.is_absolute())
+            {
+                p = std::filesystem::path(ctx.directory) / p;
+            }
+
+            return p.string();
+        }
+        return std::string();
+    }
+
+    // bV(GPU obt@O܂)
+    void ProcessMesh(PrepareContext& ctx, aiMesh* mesh)
+    {
+        // [Jɒ_ECfbNX
+        std::vector<VERTEX_3D> vertices;
+        vertices.resize(mesh->mNumVertices);
+
+        // CfbNXz (faces ͎Op`ĂO)
+        std::vector<uint32_t> indices;
+        indices.reserve(mesh->mNumFaces * 3);
+
+        // ܂A_𖄂߂
+        for (unsigned int i = 0; i < mesh->mNumVertices; ++i)
         {
-            // MATERIAL ɖOtB[h΃Zbg (͉)
-            // mat.Name = name.C_Str();
+            VERTEX_3D v{};
+            // ʒu
+            v.Position = { mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z };
+
+            // @ (ς݂̂͂)
+            if (mesh->HasNormals())
+            {
+                v.Normal = { mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z };
+            }
+            else
+            {
+                v.Normal = { 0.f, 1.f, 0.f }; // tH[obN
+            }
+
+            // UV
+            if (mesh->HasTextureCoords(0))
+            {
+                v.TexCoord = { mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y };
+            }
+            else
+            {
+                v.TexCoord = { 0.f, 0.f };
+            }
+
+            // _F ()
+            if (mesh->HasVertexColors(0))
+            {
+                aiColor4D c = mesh->mColors[0][i];
+                v.Diffuse = Color(c.r, c.g, c.b, c.a);
+            }
+            else
+            {
+                v.Diffuse = Color(1, 1, 1, 1);
+            }
+
+            // {[֘A (ő4EFCgz)
+            for (int bi = 0; bi < 4; ++bi)
+            {
+                v.BoneIndex[bi] = 0;
+                v.BoneWeight[bi] = 0.0f;
+            }
+            v.bonecnt = 0;
+
+            vertices[i] = v;
         }
 
-        // J[ (Diffuse/Specular/Ambient Ȃ)
-        aiColor4D col;
-        if (AI_SUCCESS == aimat->Get(AI_MATKEY_COLOR_DIFFUSE, col))
+        // CfbNX
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f)
         {
-            mat.Diffuse = Color(col.r, col.g, col.b, col.a);
+            const aiFace& face = mesh->mFaces[f];
+            // face.mNumIndices  3 ̂͂ (triangulate)
+            for (unsigned int k = 0; k < face.mNumIndices; ++k)
+            {
+                indices.push_back(face.mIndices[k]);
+            }
         }
-        if (AI_SUCCESS == aimat->Get(AI_MATKEY_COLOR_AMBIENT, col))
+
+        // {[̎WE_ւ̔f
+        if (mesh->HasBones())
         {
-            mat.Ambient = Color(col.r, col.g, col.b, col.a);
+            for (unsigned int b = 0; b < mesh->mNumBones; ++b)
+            {
+                aiBone* aibone = mesh->mBones[b];
+                std::string boneName = aibone->mName.C_Str();
+
+                int boneIndex = -1;
+                auto it = ctx.boneNameToIndex.find(boneName);
+                if (it == ctx.boneNameToIndex.end())
+                {
+                    // V{[ȂǉăCfbNXU
+                    BoneInfo bi;
+                    bi.name = boneName;
+                    bi.offsetMatrix = aibone->mOffsetMatrix;
+                    bi.finalTransform = aiMatrix4x4(); // 
+                    boneIndex = static_cast<int>(ctx.boneInfos.size());
+                    ctx.boneInfos.push_back(bi);
+                    ctx.boneNameToIndex[boneName] = boneIndex;
+                }
+                else
+                {
+                    boneIndex = it->second;
+                }
+
+                // e_EFCg̔f (ő4)
+                for (unsigned int w = 0; w < aibone->mNumWeights; ++w)
+                {
+                    unsigned int vertexId = aibone->mWeights[w].mVertexId;
+                    float weight = aibone->mWeights[w].mWeight;
+
+                    // _ BoneWeight zɑ} (󂫃XbgT)
+                    bool placed = false;
+                    for (int slot = 0; slot < 4; ++slot)
+                    {
+                        if (vertices[vertexId].BoneWeight[slot] == 0.0f)
+                        {
+                            vertices[vertexId].BoneIndex[slot] = boneIndex;
+                            vertices[vertexId].BoneWeight[slot] = weight;
+                            vertices[vertexId].bonecnt = std::max<int>(vertices[vertexId].bonecnt, slot + 1);
+                            placed = true;
+                            break;
+                        }
+                    }
+                    if (!placed)
+                    {
+                        // 4܂ĂłEFCguȈՐ헪
+                        int minIdx = 0;
+                        float minW = vertices[vertexId].BoneWeight[0];
+                        for (int s = 1; s < 4; ++s)
+                        {
+                            if (vertices[vertexId].BoneWeight[s] < minW)
+                            {
+                                minW = vertices[vertexId].BoneWeight[s];
+                                minIdx = s;
+                            }
+                        }
+                        vertices[vertexId].BoneIndex[minIdx] = boneIndex;
+                        vertices[vertexId].BoneWeight[minIdx] = weight;
+                    }
+                }
+            }
+
+            // (IvV) e_̃EFCgv 1.0 ɂȂ悤K
+            for (auto& v : vertices)
+            {
+                float sum = v.BoneWeight[0] + v.BoneWeight[1] + v.BoneWeight[2] + v.BoneWeight[3];
+                if (sum > 0.0f && sum != 1.0f)
+                {
+                    v.BoneWeight[0] /= sum;
+                    v.BoneWeight[1] /= sum;
+                    v.BoneWeight[2] /= sum;
+                    v.BoneWeight[3] /= sum;
+                }
+            }
         }
-        if (AI_SUCCESS == aimat->Get(AI_MATKEY_COLOR_SPECULAR, col))
+
+        // }eA擾 (mesh->mMaterialIndex LȂ ctx.materials Q)
+        MATERIAL mat{};
+        if (mesh->mMaterialIndex >= 0 && mesh->mMaterialIndex < (int)ctx.materials.size())
         {
-            mat.Specular = Color(col.r, col.g, col.b, col.a);
+            mat = ctx.materials[mesh->mMaterialIndex];
         }
 
-        // eNX` MeshData ŌʂɎ擾邪A
-        // ŃpX肽ꍇ͎擾ĂƂ\B
+        // MeshData (GPU obt@EeNX`ȊO͂Ŗ߂)
+        PreparedMesh prepared;
+        ModelMeshData& meshData = prepared.data;
+        meshData.material = mat;
+        meshData.indexCount = static_cast<UINT>(indices.size());
 
-        m_materials[i] = mat;
-    }
-}
+        // GPU ̕בւ(_LbV  I[o[h[  _tFb`̏)
+        // XLjO郁bV̓{[ƒ_̑Ήۂ߂ɂ̂܂܎g
+        const size_t originalVertexCount = vertices.size();
+        meshData.acmrBefore = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size()).acmr;
 
-// aiMaterial ̃eNX`^Cvǂݍ SRV Ԃ (݂Ȃꍇ nullptr)
-Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> ModelComponent::LoadTextureFromMaterial(aiMaterial* mat, aiTextureType t)
-{
-    aiString texPath;
-    if (mat->GetTextureCount(t) > 0 && mat->GetTexture(t, 0, &texPath) == AI_SUCCESS)
-    {
-        std::string tex = texPath.C_Str();
+        if (!mesh->HasBones() && !vertices.empty())
+        {
+            MeshOptimizer::OptimizeVertexCache(indices, vertices.size());
+            MeshOptimizer::OptimizeOverdraw(indices, &vertices[0].Position.x, sizeof(VERTEX_3D), vertices.size());
+            vertices.resize(MeshOptimizer::OptimizeVertexFetch(vertices.data(), vertices.size(), sizeof(VERTEX_3D), indices));
+        }
+
+        meshData.acmrAfter = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size()).acmr;
+
+        // _l߂邩(@EF 8bitAUV  half)
+        if (!mesh->HasBones() && PackVertices(vertices, prepared.packedVertices))
+        {
+            meshData.packedVertices = true;
+            meshData.vertexStride = sizeof(VERTEX_PACKED);
+        }
+
+        // _ 65536 ȉȂ 16bit CfbNXő
+        if (vertices.size() <= 0x10000)
+        {
+            meshData.indexFormat = RIF_UINT16;
+        }
+
+        // }eÃeNX` (Diffuse/Normal/Specular) ̃pX (݂)
+        if (mesh->mMaterialIndex >= 0)
+        {
+            aiMaterial* aimat = ctx.scene->mMaterials[mesh->mMaterialIndex];
+            prepared.diffusePath = GetTexturePath(ctx, aimat, aiTextureType_DIFFUSE);
+            prepared.normalPath = GetTexturePath(ctx, aimat, aiTextureType_NORMALS); // Normal map
+            prepared.specularPath = GetTexturePath(ctx, aimat, aiTextureType_SPECULAR);
+        }
+
+        // JOp̋E ([J)
+        if (!vertices.empty())
+        {
+            DirectX::BoundingSphere::CreateFromPoints(
+                meshData.bounds,
+                vertices.size(),
+                &vertices[0].Position,
+                sizeof(VERTEX_3D));
+        }
+
+        // LOD (XLjO郁bV͒_̂ōȂ)
+        std::vector<SimplifyLevel> lodLevels;
+        if (!mesh->HasBones() && MeshLod::NeedsLod(indices.size()))
+        {
+            const size_t meshIndex = ctx.model->meshes.size();
+            const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+            const uint32_t indexCount = static_cast<uint32_t>(indices.size());
+
+            if (const MeshLodFile::MeshEntry* entry = ctx.lodFile->Find(meshIndex, vertexCount, indexCount))
+            {
+                lodLevels = entry->levels;
+            }
+            else
+            {
+                lodLevels = MeshLod::BuildLevels(&vertices[0].Position.x, &vertices[0].TexCoord.x, sizeof(VERTEX_3D),
+                                                 vertices.size(), indices);
+
+                MeshLodFile::MeshEntry newEntry;
+                newEntry.vertexCount = vertexCount;
+                newEntry.indexCount = indexCount;
+                newEntry.levels = lodLevels;
+                ctx.lodFile->Set(meshIndex, std::move(newEntry));
+            }
+        }
+
+        for (const auto& level : lodLevels)
+        {
+            ModelMeshLod lod;
+            lod.indexCount = static_cast<UINT>(level.indices.size());
+            lod.error = level.error;
+            meshData.lods.push_back(std::move(lod));
+        }
+
+        // œKÕoCg(œKO VERTEX_3D  32bit CfbNX)
+        {
+            size_t totalIndices = indices.size();
+            for (const auto& level : lodLevels)
+            {
+                totalIndices += level.indices.size();
+            }
+
+            const size_t indexSize = (meshData.indexFormat == RIF_UINT16) ? sizeof(uint16_t) : sizeof(uint32_t);
+            meshData.bytesBefore = static_cast<UINT>(originalVertexCount * sizeof(VERTEX_3D) + totalIndices * sizeof(uint32_t));
+            meshData.bytesAfter = static_cast<UINT>(vertices.size() * meshData.vertexStride + totalIndices * indexSize);
+        }
 
-        // ߍ݃eNX`Ȃ (: "*0") Ōo
-        if (!tex.empty() && tex[0] == '*')
+        // ̃bVɊ܂܂{[Xg (KvȂg)
+        if (mesh->HasBones())
         {
-            return nullptr;
+            meshData.boneNames.reserve(mesh->mNumBones);
+            for (UINT b = 0; b < mesh->mNumBones; ++b)
+            {
+                meshData.boneNames.emplace_back(mesh->mBones[b]->mName.C_Str());
+            }
         }
 
-        // t@CpX̐K (/΂̔)
-        std::filesystem::path p(tex);
-        if (!p.is_absolute())
+        // GPU ɏグ钸_(l߂Ȃ炻炾c)ƃCfbNX
+        if (!meshData.packedVertices)
         {
-            p = std::filesystem::path(m_directory) / p;
+            prepared.vertices = std::move(vertices);
+        }
+        prepared.indices = std::move(indices);
+        for (auto& level : lodLevels)
+        {
+            prepared.lodIndices.push_back(std::move(level.indices));
         }
 
-        std::string fullPath = p.string();
+        // Ō push_back
+        ctx.model->meshes.push_back(std::move(prepared));
+    }
 
-        //  TextureManager gă[h (UTF8 -> ϊ͓łĂz)
-        ID3D11ShaderResourceView* srv = TextureManager::Load(fullPath);
+    // m[hċA
+    void ProcessNode(PrepareContext& ctx, aiNode* node)
+    {
+        // m[h̑SbV
+        for (UINT i = 0; i < node->mNumMeshes; ++i)
+        {
+            ProcessMesh(ctx, ctx.scene->mMeshes[node->mMeshes[i]]);
+        }
 
-        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> comsrv = srv;
-        return comsrv;
+        // qm[hċA
+        for (UINT i = 0; i < node->mNumChildren; ++i)
+        {
+            ProcessNode(ctx, node->mChildren[i]);
+        }
     }
-    return nullptr;
 }
 
 // ۂ̃fǂݍݏ
 void ModelComponent::LoadModel(const std::string& path)
 {
-    // fBNg擾ĕێ (eNX`ǂݍ݂Ɏgp)
+    // ǂݍݍς݂̃fȂ GPU \[XL
+    m_model = ModelCache::Find(path);
+    if (!m_model)
     {
-        std::filesystem::path p(path);
-        m_directory = p.parent_path().string(); // std::string ɈSɓ
+        std::shared_ptr<PreparedModel> prepared = PrepareModel(path);
+        if (!prepared)
+        {
+            return;
+        }
+        m_model = UploadModel(*prepared);
     }
 
+    m_meshMaterials.clear();
+    for (const auto& mesh : m_model->meshes)
+    {
+        m_meshMaterials.push_back(mesh.material);
+    }
+}
+
+std::shared_ptr<PreparedModel> ModelComponent::PrepareModel(const std::string& path)
+{
     // Assimp œǂݍ (ׂ̈ɕKvȃtOǉ)
     // aiProcess_GenSmoothNormals: @ΐ
     // aiProcess_CalcTangentSpace: ^WFgԂvZ (m[}}bvpɕKv)
@@ -204,271 +653,138 @@ void ModelComponent::LoadModel(const std::string& path)
         aiProcess_JoinIdenticalVertices |
         aiProcess_SortByPType;
 
-    // m_importer ̓oȂ̂łœǂݍ m_scene ɕێ
-    m_scene = m_importer.ReadFile(path, flags);
+    // V[ CPU ̃f[^I܂Ŏg(C|[^ƈꏏɎ̂Ă)
+    Assimp::Importer importer;
+    const aiScene* scene = importer.ReadFile(path, flags);
 
-    if (!m_scene || (m_scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) || !m_scene->mRootNode)
+    if (!scene || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE) || !scene->mRootNode)
     {
-        const char* err = m_importer.GetErrorString();
+        const char* err = importer.GetErrorString();
         std::string s = "Assimp ReadFile failed: ";
         s += err ? err : "(null)";
         s += "\n";
         OutputDebugStringA(s.c_str());
-        return;
+        return nullptr;
     }
 
-    // }eA̓ǂݍ (V[S)
-    LoadMaterials(m_scene);
+    auto model = std::make_shared<PreparedModel>();
+    model->path = path;
 
-    // {[W̏ (ł̓bVɒǉĂ)
-    m_boneInfos.clear();
-    m_boneNameToIndex.clear();
+    PrepareContext ctx;
+    ctx.scene = scene;
+    ctx.model = model.get();
 
-    // m[hċAŃbV𐶐
-    ProcessNode(m_scene->mRootNode, m_scene);
+    // fBNg擾ĕێ (eNX`̃pXɎgp)
+    ctx.directory = std::filesystem::path(path).parent_path().string();
 
-    // ǂݍ݌̃O
-    {
-        char buf[256];
-        sprintf_s(buf, "Model loaded: meshes=%zu bones=%zu materials=%zu\n",
-            m_meshes.size(), m_boneInfos.size(), m_materials.size());
-        OutputDebugStringA(buf);
-    }
+    // }eA̓ǂݍ (V[S)
+    LoadMaterials(ctx);
 
-    // () Ń{[p̒萔obt@쐬邱Ƃ𐄏
-    // : m_cbBones = CreateConstantBuffer(sizeof(XMMATRIX) * MAX_BONES);
-}
+    // ȗς݂LODfׂ̗ɂΎg(EÂbV͂ōĕۑ)
+    MeshLodFile lodFile;
+    const std::string lodPath = MeshLodFile::GetPath(path);
+    lodFile.Load(lodPath);
+    ctx.lodFile = &lodFile;
 
-// m[hċA
-void ModelComponent::ProcessNode(aiNode* node, const aiScene* scene)
-{
-    // m[h̑SbV
-    for (UINT i = 0; i < node->mNumMeshes; ++i)
-    {
-        aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        ProcessMesh(mesh, scene);
-    }
+    // m[hċAŃbV𐶐
+    ProcessNode(ctx, scene->mRootNode);
 
-    // qm[hċA
-    for (UINT i = 0; i < node->mNumChildren; ++i)
+    if (lodFile.IsDirty())
     {
-        ProcessNode(node->mChildren[i], scene);
+        lodFile.Save(lodPath);
     }
-}
 
-// bV
-void ModelComponent::ProcessMesh(aiMesh* mesh, const aiScene* scene)
-{
-    // [Jɒ_ECfbNX
-    std::vector<VERTEX_3D> vertices;
-    vertices.resize(mesh->mNumVertices);
-
-    // CfbNXz (faces ͎Op`ĂO)
-    std::vector<uint32_t> indices;
-    indices.reserve(mesh->mNumFaces * 3);
-
-    // ܂A_𖄂߂
-    for (unsigned int i = 0; i < mesh->mNumVertices; ++i)
+    // fŜ̋E(LOD ̑IɎg)
+    for (size_t i = 0; i < model->meshes.size(); ++i)
     {
-        VERTEX_3D v{};
-        // ʒu
-        v.Position = { mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z };
-
-        // @ (ς݂̂͂)
-        if (mesh->HasNormals())
+        if (i == 0)
         {
-            v.Normal = { mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z };
+            model->bounds = model->meshes[i].data.bounds;
         }
         else
         {
-            v.Normal = { 0.f, 1.f, 0.f }; // tH[obN
+            DirectX::BoundingSphere::CreateMerged(model->bounds, model->bounds, model->meshes[i].data.bounds);
         }
+    }
 
-        // UV
-        if (mesh->HasTextureCoords(0))
-        {
-            v.TexCoord = { mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y };
-        }
-        else
-        {
-            v.TexCoord = { 0.f, 0.f };
-        }
+    model->boneCount = ctx.boneInfos.size();
+    model->materialCount = ctx.materials.size();
+    return model;
+}
 
-        // _F ()
-        if (mesh->HasVertexColors(0))
-        {
-            aiColor4D c = mesh->mColors[0][i];
-            v.Diffuse = Color(c.r, c.g, c.b, c.a);
-        }
-        else
-        {
-            v.Diffuse = Color(1, 1, 1, 1);
-        }
+std::shared_ptr<ModelData> ModelComponent::UploadModel(const PreparedModel& prepared)
+{
+    auto model = std::make_shared<ModelData>();
+    model->path = prepared.path;
+    model->bounds = prepared.bounds;
 
-        // {[֘A (ő4EFCgz)
-        for (int bi = 0; bi < 4; ++bi)
-        {
-            v.BoneIndex[bi] = 0;
-            v.BoneWeight[bi] = 0.0f;
-        }
-        v.bonecnt = 0;
+    size_t bytesBefore = 0, bytesAfter = 0;
+    for (const PreparedMesh& mesh : prepared.meshes)
+    {
+        ModelMeshData meshData = mesh.data;
 
-        vertices[i] = v;
-    }
+        // eNX` (TextureManager ̓CXbhG)
+        if (!mesh.diffusePath.empty()) { meshData.srvDiffuse = TextureManager::Load(mesh.diffusePath); }
+        if (!mesh.normalPath.empty()) { meshData.srvNormal = TextureManager::Load(mesh.normalPath); }
+        if (!mesh.specularPath.empty()) { meshData.srvSpecular = TextureManager::Load(mesh.specularPath); }
 
-    // CfbNX
-    for (unsigned int f = 0; f < mesh->mNumFaces; ++f)
-    {
-        const aiFace& face = mesh->mFaces[f];
-        // face.mNumIndices  3 ̂͂ (triangulate)
-        for (unsigned int k = 0; k < face.mNumIndices; ++k)
+        // wbhXsł GPU obt@͍Ȃ(CfbNXƋEg)
+        if (!Renderer::IsHeadless())
         {
-            indices.push_back(face.mIndices[k]);
-        }
-    }
+            // _obt@쐬
+            const size_t vertexCount = meshData.packedVertices ? mesh.packedVertices.size() : mesh.vertices.size();
 
-    // {[̎WE_ւ̔f
-    if (mesh->HasBones())
-    {
-        for (unsigned int b = 0; b < mesh->mNumBones; ++b)
-        {
-            aiBone* aibone = mesh->mBones[b];
-            std::string boneName = aibone->mName.C_Str();
+            D3D11_BUFFER_DESC vbDesc{};
+            vbDesc.Usage = D3D11_USAGE_DEFAULT;
+            vbDesc.ByteWidth = static_cast<UINT>(meshData.vertexStride * vertexCount);
+            vbDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+            vbDesc.CPUAccessFlags = 0;
+
+            D3D11_SUBRESOURCE_DATA vbData{};
+            vbData.pSysMem = meshData.packedVertices ? static_cast<const void*>(mesh.packedVertices.data()) : mesh.vertices.data();
 
-            int boneIndex = -1;
-            auto it = m_boneNameToIndex.find(boneName);
-            if (it == m_boneNameToIndex.end())
+            HRESULT hr = Renderer::GetDevice()->CreateBuffer(&vbDesc, &vbData, meshData.vertexBuffer.GetAddressOf());
+            if (FAILED(hr) || !meshData.vertexBuffer)
             {
-                // V{[ȂǉăCfbNXU
-                BoneInfo bi;
-                bi.name = boneName;
-                bi.offsetMatrix = aibone->mOffsetMatrix;
-                bi.finalTransform = aiMatrix4x4(); // 
-                boneIndex = static_cast<int>(m_boneInfos.size());
-                m_boneInfos.push_back(bi);
-                m_boneNameToIndex[boneName] = boneIndex;
+                OutputDebugStringA("Failed to create vertex buffer for mesh\n");
+                continue;
             }
-            else
+
+            // CfbNXobt@쐬
+            hr = CreateIndexBuffer(mesh.indices, meshData.indexFormat, meshData.indexBuffer.GetAddressOf());
+            if (FAILED(hr) || !meshData.indexBuffer)
             {
-                boneIndex = it->second;
+                OutputDebugStringA("Failed to create index buffer for mesh\n");
+                continue;
             }
 
-            // e_EFCg̔f (ő4)
-            for (unsigned int w = 0; w < aibone->mNumWeights; ++w)
+            // LOD ̃CfbNXobt@(Ȃxȍ~͎gȂ)
+            for (size_t l = 0; l < meshData.lods.size(); ++l)
             {
-                unsigned int vertexId = aibone->mWeights[w].mVertexId;
-                float weight = aibone->mWeights[w].mWeight;
-
-                // _ BoneWeight zɑ} (󂫃XbgT)
-                bool placed = false;
-                for (int slot = 0; slot < 4; ++slot)
-                {
-                    if (vertices[vertexId].BoneWeight[slot] == 0.0f)
-                    {
-                        vertices[vertexId].BoneIndex[slot] = boneIndex;
-                        vertices[vertexId].BoneWeight[slot] = weight;
-                        vertices[vertexId].bonecnt = std::max<int>(vertices[vertexId].bonecnt, slot + 1);
-                        placed = true;
-                        break;
-                    }
-                }
-                if (!placed)
+                hr = CreateIndexBuffer(mesh.lodIndices[l], meshData.indexFormat, meshData.lods[l].indexBuffer.GetAddressOf());
+                if (FAILED(hr) || !meshData.lods[l].indexBuffer)
                 {
-                    // 4܂ĂłEFCguȈՐ헪
-                    int minIdx = 0;
-                    float minW = vertices[vertexId].BoneWeight[0];
-                    for (int s = 1; s < 4; ++s)
-                    {
-                        if (vertices[vertexId].BoneWeight[s] < minW)
-                        {
-                            minW = vertices[vertexId].BoneWeight[s];
-                            minIdx = s;
-                        }
-                    }
-                    vertices[vertexId].BoneIndex[minIdx] = boneIndex;
-                    vertices[vertexId].BoneWeight[minIdx] = weight;
+                    OutputDebugStringA("Failed to create LOD index buffer for mesh\n");
+                    meshData.lods.resize(l);
+                    break;
                 }
             }
         }
 
-        // (IvV) e_̃EFCgv 1.0 ɂȂ悤K
-        for (auto& v : vertices)
-        {
-            float sum = v.BoneWeight[0] + v.BoneWeight[1] + v.BoneWeight[2] + v.BoneWeight[3];
-            if (sum > 0.0f && sum != 1.0f)
-            {
-                v.BoneWeight[0] /= sum;
-                v.BoneWeight[1] /= sum;
-                v.BoneWeight[2] /= sum;
-                v.BoneWeight[3] /= sum;
-            }
-        }
+        bytesBefore += meshData.bytesBefore;
+        bytesAfter += meshData.bytesAfter;
+        model->meshes.push_back(std::move(meshData));
     }
 
-    // }eA擾 (mesh->mMaterialIndex LȂ m_materials Q)
-    MATERIAL mat{};
-    if (mesh->mMaterialIndex >= 0 && mesh->mMaterialIndex < (int)m_materials.size())
-    {
-        mat = m_materials[mesh->mMaterialIndex];
-    }
-
-    // MeshData 
-    MeshData meshData;
-    meshData.material = mat;
-    meshData.indexCount = static_cast<UINT>(indices.size());
-
-    // }eAeNX` (Diffuse/Normal/Specular) [h (݂)
-    if (mesh->mMaterialIndex >= 0)
-    {
-        aiMaterial* aimat = scene->mMaterials[mesh->mMaterialIndex];
-        meshData.srvDiffuse = LoadTextureFromMaterial(aimat, aiTextureType_DIFFUSE);
-        meshData.srvNormal = LoadTextureFromMaterial(aimat, aiTextureType_NORMALS); // Normal map
-        meshData.srvSpecular = LoadTextureFromMaterial(aimat, aiTextureType_SPECULAR);
-    }
-
-    // _obt@쐬
-    D3D11_BUFFER_DESC vbDesc{};
-    vbDesc.Usage = D3D11_USAGE_DEFAULT;
-    vbDesc.ByteWidth = static_cast<UINT>(sizeof(VERTEX_3D) * vertices.size());
-    vbDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    vbDesc.CPUAccessFlags = 0;
-
-    D3D11_SUBRESOURCE_DATA vbData{};
-    vbData.pSysMem = vertices.data();
+    ModelCache::Add(prepared.path, model);
 
-    HRESULT hr = Renderer::GetDevice()->CreateBuffer(&vbDesc, &vbData, meshData.vertexBuffer.GetAddressOf());
-    if (FAILED(hr) || !meshData.vertexBuffer)
-    {
-        OutputDebugStringA("Failed to create vertex buffer for mesh\n");
-        return;
-    }
-
-    // CfbNXobt@쐬
-    D3D11_BUFFER_DESC ibDesc{};
-    ibDesc.Usage = D3D11_USAGE_DEFAULT;
-    ibDesc.ByteWidth = static_cast<UINT>(sizeof(uint32_t) * indices.size());
-    ibDesc.BindFlags = D3D11_BIND_INDEX_BUFFER;
-    ibDesc.CPUAccessFlags = 0;
-
-    D3D11_SUBRESOURCE_DATA ibData{};
-    ibData.pSysMem = indices.data();
-
-    hr = Renderer::GetDevice()->CreateBuffer(&ibDesc, &ibData, meshData.indexBuffer.GetAddressOf());
-    if (FAILED(hr) || !meshData.indexBuffer)
-    {
-        OutputDebugStringA("Failed to create index buffer for mesh\n");
-        return;
-    }
+    // ǂݍ݌̃O
+    char buf[256];
+    sprintf_s(buf, "Model loaded: meshes=%zu bones=%zu materials=%zu bytes=%zu->%zu\n",
+        model->meshes.size(), prepared.boneCount, prepared.materialCount, bytesBefore, bytesAfter);
+    OutputDebugStringA(buf);
 
-    // ̃bVɊ܂܂{[Xg (KvȂg)
-    if (mesh->HasBones())
-    {
-        meshData.boneNames.reserve(mesh->mNumBones);
-        for (UINT b = 0; b < mesh->mNumBones; ++b)
-        {
-            meshData.boneNames.emplace_back(mesh->mBones[b]->mName.C_Str());
-        }
-    }
-    // Ō push_back
-    m_meshes.push_back(std::move(meshData));
+    // () Ń{[p̒萔obt@쐬邱Ƃ𐄏
+    // : m_cbBones = CreateConstantBuffer(sizeof(XMMATRIX) * MAX_BONES);
+    return model;
 }
@@ -1,6 +1,9 @@
 #pragma once
 #include "Component.h"
 #include "renderer.h"
+#include "ModelCache.h"
+#include "IDrawPacketSource.h"
+#include "MeshLod.h"
 #include <assimp/scene.h>
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
@@ -12,7 +15,7 @@
 #include <unordered_map>
 #include <filesystem>
 
-class ModelComponent : public Component
+class ModelComponent : public Component, public IDrawPacketSource
 {
 public:
     //RXgN^
@@ -25,6 +28,12 @@ public:
     //ft@Cǂݍ݊֐
     void LoadModel(const std::string& filepath);
 
+    //Assimp ̓ǂݍ݂ LOD ܂ł CPU ̏(D3DETextureManager GȂ̂łǂ̃XbhłĂׂ)
+    static std::shared_ptr<PreparedModel> PrepareModel(const std::string& filepath);
+
+    //PrepareModel ̌ʂeNX`EGPU obt@ ModelCache ɓo^(CXbh)
+    static std::shared_ptr<ModelData> UploadModel(const PreparedModel& prepared);
+
     //
     void Initialize() override;
 
@@ -34,59 +43,34 @@ public:
     //`
     void Draw(float alpha) override;
 
+    //`pPbg쐬(RenderQueue 烏[J[XbhŌĂ΂)
+    void BuildDrawPackets(const DrawBuildContext& context, DrawPacketList& out) const override;
+
     //--------Set֐-------
     void SetColor(const Color& color);
     void SetAlpha(float alpha);
 
+    //f܂Ƃ߂ĕ`悷(ʂɒuEG)
+    void SetInstanced(bool enable) { m_useInstancing = enable; }
+
 private:
-    // 
-    void ProcessNode(aiNode* node, const aiScene* scene);
-    void ProcessMesh(aiMesh* mesh, const aiScene* scene);
-    void LoadMaterials(const aiScene* scene); // V[}eAꗗ
-    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> LoadTextureFromMaterial(aiMaterial* mat, aiTextureType t);
-
-    // XLjOî߂̃f[^j
-    struct BoneInfo
-    {
-        std::string name;                 // {[
-        aiMatrix4x4 offsetMatrix;         // inverse bind pose
-        // ŏIϊs (Aj[VvZɂɓ)
-        aiMatrix4x4 finalTransform;
-    };
-
-    // 1bṼf[^
-    struct MeshData
-    {
-        Microsoft::WRL::ComPtr<ID3D11Buffer> vertexBuffer;
-        Microsoft::WRL::ComPtr<ID3D11Buffer> indexBuffer;
-        UINT indexCount = 0;
-
-        MATERIAL material; //  MATERIAL ^ɍ킹Ċi[
-        // eNX`ΉiKvɉđ₷j
-        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srvDiffuse;
-        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srvNormal;
-        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srvSpecular;
-
-        // XLjOpF̃bVɊ܂܂{[̖OXg / CfbNX globalBoneMap Q
-        std::vector<std::string> boneNames;
-    };
-
-    std::vector<MeshData> m_meshes;
-
-    // Assimp ̃C|[^ƃV[oɎ lifetime ΂
-    Assimp::Importer m_importer;
-    const aiScene* m_scene = nullptr;
-
-    // {[}bvi{[ -> O[oCfbNXj
-    std::vector<BoneInfo> m_boneInfos;
-    std::unordered_map<std::string, int> m_boneNameToIndex;
-
-    // }eAXgiV[Pʁj
-    std::vector<MATERIAL> m_materials;
+    //ʏ̑傫`LODx߂(ÕxoĂăqXeVXt)
+    int SelectLodLevel(const Matrix4x4& worldMatrix) const;
+
+    // bVf[^{̂ ModelCache ŋLA
+    // R|[lgɕς}eA(FEAt@)ʂɎ
+    std::shared_ptr<ModelData> m_model;
+    std::vector<MATERIAL> m_meshMaterials;
+
+    // CX^X`g
+    bool m_useInstancing = false;
+
+    // O`LODx
+    // (BuildDrawPackets  const A1̃R|[lg1̃[J[GȂ)
+    mutable int m_lodLevel = 0;
 
     // t@CpX֘A
     std::string m_filepath;
-    std::string m_directory;
 
     // Aj[VɎgp萔obt@̃nhɒu (TODO)
     // ComPtr<ID3D11Buffer> m_cbBones;  // {[z𑗂邽߂̒萔obt@Ȃ
@@ -1,5 +1,6 @@
 #include "NumberTextureUI.h"
 #include "TextureManager.h"
+#include <d3d11.h>
 #include "renderer.h"
 
 using namespace DirectX::SimpleMath;
@@ -55,7 +56,7 @@ void NumberTextureUI::DrawNumber(int value)
 
 		int digit = c - '0';
 
-		ID3D11ShaderResourceView* texture = m_digitTextures[digit];
+		ID3D11ShaderResourceView* texture = m_digitTextures[digit].Get();
 
 		if (!texture) { continue; }//eNX`Ȃꍇ̓XLbv
 
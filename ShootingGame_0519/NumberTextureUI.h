@@ -2,6 +2,7 @@
 #include <array>
 #include <string>
 #include <d3d11.h>
+#include <wrl/client.h>
 #include <SimpleMath.h>
 
 class NumberTextureUI
@@ -27,5 +28,5 @@ private:
 	float m_spacing = 2.0f;
 
 	//---------eNX`֘A--------------
-	std::array<ID3D11ShaderResourceView*, 10> m_digitTextures{};
+	std::array<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>, 10> m_digitTextures{};
 };
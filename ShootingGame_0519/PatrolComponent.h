@@ -4,6 +4,8 @@
 #include <vector>
 #include <SimpleMath.h>
 #include <functional>
+#include "PatrolPath.h"
+#include "AiScheduler.h"
 
 using namespace DirectX::SimpleMath;
 
@@ -12,9 +14,11 @@ using namespace DirectX::SimpleMath;
 /// 
 /// ݒn_ spline ̖ڕWn_߁A
 /// SteeringBehavior pĎRȐړsB
+/// iXeAǑvZ PatrolSteering S܂Ƃ߂čsj
 ///
 /// EWaypoint
-/// ECatmull-Rom spline 
+/// ECatmull-Rom spline ԁiPatrolPath ɏĂ̂Lj
+/// ÊŐiނ̂ŋԂɂđςȂ
 /// 
 /// Eʒu\ɂoHǏ]
 /// ESteering ɂ銊炩Ȑ
@@ -25,40 +29,46 @@ class PatrolComponent : public Component , public IMovable
 {
 public:
 	PatrolComponent() = default;
-	~PatrolComponent() override = default;
+	~PatrolComponent() override;
 
 	void Initialize() override;
 	void Update(float dt) override;
 
 	//-------------Set֐--------------
+	//Ă[ggi[g̓G̓nhLj
+	//startDistance : 擪̓̂i瑖oj
+	void SetPath(PatrolPathHandle path, float startDistance = 0.0f);
+	//̏ŏĂi[vBLȂ̂ŃX|[ɂ SetPath gj
 	void SetWaypoints(const std::vector<Vector3>& pts);
-	void SetWaypoints(std::vector<Vector3>&& pts);
 	void SetArrivalThreshold(float t) { m_arrivalThreshold = t; }
 	void SetSpeed(float s) { m_speed = s; }                       //ړx̃Zbg
 	void SetFaceMovement(bool face) { m_faceMovement = face; }    //isǂ
 	void SetUseSpline(bool useSpline) { m_useSpline = useSpline; }
 	void SetSplineTension(float tension) { m_splineTension = tension; }	//XvC̊炩
-	void SetLoop(bool loop) { m_loop = loop; }                    //[v邩ipingpongƂ̑gɒӁj
 	void SetPingPong(bool p) { m_pingPong = p; }
 
 	void SetVelocity(const DirectX::SimpleMath::Vector3& velocity) override;
 
 	//-------------Get֐--------------
-	size_t GetCurrentIndex() const { return m_currentIndex; }				  //Ăn_̃|Cg̃CfbNX擾
-	const std::vector<Vector3>& GetWaypoints() const { return m_waypoints; }  //ݒ肵ĂEFC|Cg̔z擾
+	size_t GetCurrentIndex() const { return m_currentIndex; }				  //Ԃ̎n܂̃EFC|Cg̃CfbNX擾
+	const PatrolPathHandle& GetPath() const { return m_path; }				  //ݒ肵Ă郋[g
+	float GetDistance() const { return m_distance; }						  //[g̐擪̓̂
 	DirectX::SimpleMath::Vector3 GetVelocity() const override { return m_currentDir * m_speed; }
 
 	//Zbg
 	void Reset();
 
 private:
-	//-------------EFC|Cg֘A--------------
-	std::vector<Vector3> m_waypoints;			//n_(EFC|Cg)ۑxN^[̔z
-	size_t m_currentIndex = 0;					//Ăn_̃CfbNX
-	bool m_loop = true;							//[vĂ邩ǂbool
+	//XeAO̓o͂ PatrolSteering ړǂݏ
+	friend class PatrolSteering;
+
+	//-------------[g֘A--------------
+	PatrolPathHandle m_path;					//Ă[gi[v邩ǂ[gj
+	float m_distance = 0.0f;					//[g̐擪̓̂
+	size_t m_currentIndex = 0;					//Ԃ̎n܂̃EFC|Cg̃CfbNX
 
 	//-------------ړE]֘A--------------
-	bool m_faceMovement = true;					//isĂ邩ǂbool					  //
+	bool m_faceMovement = true;					//isĂ邩ǂbool
 	float m_speed = 6.0f;						//ړx
 	bool m_pingPong = true;
 
@@ -66,9 +76,11 @@ private:
 	bool m_useSpline = false;					//XvC⊮gǂbool
 	float m_splineTension = 0.5f;				//XvC̊炩i0`1j
 
-	float m_segmentT = 0.0f;				    //݂̃ZOg̒
 	float m_arrivalThreshold = 0.5f;
 
+	AiScheduler::Agent m_aiAgent;				//͐t[1񂾂i߂
+	float m_stepDt = 0.0f;						//i߂鎞ԁiPatrolSteering ǂށj
+
 	Vector3 m_currentDir = Vector3(0.0f,0.0f,1.0f);		//݂̈ړxNg
 	float m_turnRate = 6.0f;		//Ȃ鑬il傫قǋȂ₷j
 	float m_slowRadius = 2.0f;		//͈̔͂ɓ猸Jn
@@ -79,14 +91,4 @@ private:
 
 	float m_pathRadius = 3.0f;        // spine 狖鋗iL̑j
 	float m_lookAheadTime = 0.6f;     // \ԁibj
-	//-------------֐--------------
-	Vector3 GetPointClamped(int index) const;
-	Vector3 EvalCatmullRom(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t) const;
-	Vector3 EvalCatmullRomTangent(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t) const;
-
-	void AdvanceSegment();
-
-	bool m_isBranchMoving = false; //ړLǂ
-	std::vector<Vector3> m_mainWaypoints;   //G̒ʏ탋[g
-
 };
@@ -0,0 +1,265 @@
+#include "PatrolPath.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX::SimpleMath;
+
+namespace
+{
+    //Tv̊Ԋu([h̒P)B1t[̈ړʂƓ炢
+    constexpr float SAMPLE_SPACING = 1.0f;
+
+    //[głȏ͎Ȃ(Ԋu̕L)
+    constexpr size_t MAX_SAMPLES = 16384;
+
+    //̂𑪂鎞1Ԃ̕(Ȑ܂ŋߎ)
+    //Ԃ̒ɍ킹đ₷(}J[u̒Ԃœ̂肪ƑɂȂ)
+    constexpr int MIN_SUBDIVISIONS = 16;
+    constexpr int MAX_SUBDIVISIONS = 4096;
+
+    //̂̃e[u1s(u  Ԕԍ + ԓ t)
+    struct ArcLengthEntry
+    {
+        float distance;
+        float u;
+    };
+
+    Vector3 EvalCatmullRom(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t)
+    {
+        float t2 = t * t;
+        float t3 = t2 * t;
+
+        return 0.5f * (
+            (2.0f * p1) +
+            (-p0 + p2) * t +
+            (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
+            (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t3
+            );
+    }
+
+    Vector3 EvalCatmullRomTangent(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3, float t)
+    {
+        float t2 = t * t;
+
+        return 0.5f * (
+            (-p0 + p2) +
+            2.0f * (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t +
+            3.0f * (-p0 + 3.0f * p1 - 3.0f * p2 + p3) * t2
+            );
+    }
+}
+
+PatrolPathHandle PatrolPath::Create(const std::vector<Vector3>& waypoints, bool loop)
+{
+    if (waypoints.size() < 2)
+    {
+        return nullptr;
+    }
+
+    //RXgN^ private Ȃ̂ make_shared ͎gȂ
+    std::shared_ptr<PatrolPath> path(new PatrolPath());
+    path->m_waypoints = waypoints;
+    path->m_loop = loop;
+    path->Bake();
+
+    //S_Ɛi߂Ȃ
+    if (path->m_length <= 1e-4f)
+    {
+        return nullptr;
+    }
+
+    return path;
+}
+
+Vector3 PatrolPath::GetPoint(int index) const
+{
+    int count = static_cast<int>(m_waypoints.size());
+
+    //[vȂAłȂΒ[̓_JԂ
+    if (m_loop)
+    {
+        int wrapped = index % count;
+        if (wrapped < 0)
+        {
+            wrapped += count;
+        }
+        return m_waypoints[wrapped];
+    }
+
+    return m_waypoints[std::clamp(index, 0, count - 1)];
+}
+
+void PatrolPath::Bake()
+{
+    const int waypointCount = static_cast<int>(m_waypoints.size());
+    const int segmentCount = m_loop ? waypointCount : waypointCount - 1;
+
+    //==============================
+    // ܂œ̂𑪂
+    //==============================
+    std::vector<ArcLengthEntry> lut;
+    lut.push_back({ 0.0f, 0.0f });
+
+    m_waypointDistances.resize(waypointCount);
+
+    Vector3 prev = m_waypoints[0];
+    for (int s = 0; s < segmentCount; ++s)
+    {
+        m_waypointDistances[s] = lut.back().distance;
+
+        const Vector3 p0 = GetPoint(s - 1);
+        const Vector3 p1 = GetPoint(s);
+        const Vector3 p2 = GetPoint(s + 1);
+        const Vector3 p3 = GetPoint(s + 2);
+
+        const float chord = (p2 - p1).Length();
+        const int subdivisions = std::clamp(static_cast<int>(chord / SAMPLE_SPACING) * 2, MIN_SUBDIVISIONS, MAX_SUBDIVISIONS);
+
+        for (int k = 1; k <= subdivisions; ++k)
+        {
+            const float t = static_cast<float>(k) / subdivisions;
+            const Vector3 p = EvalCatmullRom(p0, p1, p2, p3, t);
+
+            lut.push_back({ lut.back().distance + (p - prev).Length(), static_cast<float>(s) + t });
+            prev = p;
+        }
+    }
+
+    m_length = lut.back().distance;
+
+    //[vłȂ̍Ō̓_͏I[
+    for (int i = segmentCount; i < waypointCount; ++i)
+    {
+        m_waypointDistances[i] = m_length;
+    }
+
+    if (m_length <= 1e-4f)
+    {
+        return;
+    }
+
+    //==============================
+    // ̂̊ԊuŃTvO
+    //==============================
+    size_t sampleCount = static_cast<size_t>(std::ceil(m_length / SAMPLE_SPACING)) + 1;
+    sampleCount = std::clamp<size_t>(sampleCount, 2, MAX_SAMPLES);
+
+    m_spacing = m_length / static_cast<float>(sampleCount - 1);
+    m_invSpacing = 1.0f / m_spacing;
+
+    m_positions.resize(sampleCount);
+    m_tangents.resize(sampleCount);
+    m_segments.resize(sampleCount);
+
+    const size_t lutCount = lut.size();
+    size_t k = 0;
+    for (size_t i = 0; i < sampleCount; ++i)
+    {
+        const float d = std::min(static_cast<float>(i) * m_spacing, m_length);
+
+        //̂͑Ȃ̂ŁAe[u͑O1Ȃ߂邾
+        while (k < lutCount - 2 && lut[k + 1].distance < d)
+        {
+            ++k;
+        }
+
+        const float span = lut[k + 1].distance - lut[k].distance;
+        const float local = span > 1e-6f ? std::clamp((d - lut[k].distance) / span, 0.0f, 1.0f) : 0.0f;
+
+        //Ԃ̐؂ڂ܂ŝ͖ u ͂̂܂ܕԂł
+        const float u = lut[k].u + (lut[k + 1].u - lut[k].u) * local;
+        const int s = std::min(static_cast<int>(u), segmentCount - 1);
+        const float t = u - static_cast<float>(s);
+
+        const Vector3 p0 = GetPoint(s - 1);
+        const Vector3 p1 = GetPoint(s);
+        const Vector3 p2 = GetPoint(s + 1);
+        const Vector3 p3 = GetPoint(s + 2);
+
+        Vector3 tangent = EvalCatmullRomTangent(p0, p1, p2, p3, t);
+        if (tangent.LengthSquared() < 1e-8f)
+        {
+            //Ȑ~܂鏊(_)͋Ԃ̌őp
+            tangent = p2 - p1;
+        }
+        if (tangent.LengthSquared() > 1e-8f)
+        {
+            tangent.Normalize();
+        }
+
+        m_positions[i] = EvalCatmullRom(p0, p1, p2, p3, t);
+        m_tangents[i] = tangent;
+        m_segments[i] = static_cast<uint16_t>(s);
+    }
+}
+
+PatrolPath::Sample PatrolPath::Evaluate(float distance) const
+{
+    if (m_loop)
+    {
+        distance = std::fmod(distance, m_length);
+        if (distance < 0.0f)
+        {
+            distance += m_length;
+        }
+    }
+    else
+    {
+        distance = std::clamp(distance, 0.0f, m_length);
+    }
+
+    //ÕTvԂ邾
+    const float f = distance * m_invSpacing;
+    const size_t i = std::min(static_cast<size_t>(f), m_positions.size() - 2);
+    const float t = std::clamp(f - static_cast<float>(i), 0.0f, 1.0f);
+
+    Sample sample;
+    sample.position = Vector3::Lerp(m_positions[i], m_positions[i + 1], t);
+
+    sample.tangent = Vector3::Lerp(m_tangents[i], m_tangents[i + 1], t);
+    if (sample.tangent.LengthSquared() > 1e-8f)
+    {
+        sample.tangent.Normalize();
+    }
+    else
+    {
+        sample.tangent = m_tangents[i];
+    }
+
+    //Tv̊ԂŃEFC|Cg܂łA܂̋
+    sample.segment = m_segments[i];
+    const size_t next = m_segments[i + 1];
+    if (next != sample.segment && distance >= m_waypointDistances[next])
+    {
+        sample.segment = next;
+    }
+
+    return sample;
+}
+
+float PatrolPath::Advance(float distance, float delta) const
+{
+    distance += delta;
+
+    if (m_loop)
+    {
+        distance = std::fmod(distance, m_length);
+        if (distance < 0.0f)
+        {
+            distance += m_length;
+        }
+        return distance;
+    }
+
+    return std::clamp(distance, 0.0f, m_length);
+}
+
+size_t PatrolPath::GetMemoryBytes() const
+{
+    return sizeof(PatrolPath) +
+        m_waypoints.capacity() * sizeof(Vector3) +
+        m_waypointDistances.capacity() * sizeof(float) +
+        m_positions.capacity() * sizeof(Vector3) +
+        m_tangents.capacity() * sizeof(Vector3) +
+        m_segments.capacity() * sizeof(uint16_t);
+}
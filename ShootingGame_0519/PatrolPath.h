@@ -0,0 +1,68 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <SimpleMath.h>
+
+//---------------------------------------------------------
+// Ă񃋁[g(ύXȂB[g̓GŋL)
+// EFC|Cg Catmull-Rom łȂȐÂ̊Ԋu
+// ʒuƐڐɃTvOĂ
+// G̓nhƁu擪̓̂vĂ΂悭At[
+// XvCvZ͔z2_̕ԂɂȂ(̂肪Ȃ̂őx)
+//---------------------------------------------------------
+class PatrolPath;
+using PatrolPathHandle = std::shared_ptr<const PatrolPath>;
+
+class PatrolPath
+{
+public:
+    //̂ distance ̒n_
+    struct Sample
+    {
+        DirectX::SimpleMath::Vector3 position;
+        DirectX::SimpleMath::Vector3 tangent;   //is(Kς)
+        size_t segment = 0;                     //(waypoints[segment]  waypoints[segment + 1])
+    };
+
+    //loop : Ō̃EFC|Cg擪ɖ߂Ԃ(͎̂񂷂)
+    //EFC|Cg2Ȃ nullptr
+    static PatrolPathHandle Create(const std::vector<DirectX::SimpleMath::Vector3>& waypoints, bool loop);
+
+    //O(1)B[vȂAłȂΗ[Ŏ~߂
+    Sample Evaluate(float distance) const;
+
+    //distance  delta i񂾓̂([vȂAłȂΏI[Ŏ~߂)
+    float Advance(float distance, float delta) const;
+
+    //--------Get֐-------
+    float GetLength() const { return m_length; }
+    bool IsLoop() const { return m_loop; }
+    bool IsEnd(float distance) const { return !m_loop && distance >= m_length; }
+    size_t GetWaypointCount() const { return m_waypoints.size(); }
+    const DirectX::SimpleMath::Vector3& GetWaypoint(size_t index) const { return m_waypoints[index]; }
+    const std::vector<DirectX::SimpleMath::Vector3>& GetWaypoints() const { return m_waypoints; }
+    float GetWaypointDistance(size_t index) const { return m_waypointDistances[index]; }
+    size_t GetSampleCount() const { return m_positions.size(); }
+    size_t GetMemoryBytes() const;
+
+private:
+    PatrolPath() = default;
+
+    void Bake();
+    DirectX::SimpleMath::Vector3 GetPoint(int index) const;
+
+    std::vector<DirectX::SimpleMath::Vector3> m_waypoints;
+    bool m_loop = true;
+
+    //--------------̂̃e[u------------------
+    std::vector<float> m_waypointDistances;     //eEFC|Cg܂ł̓̂(Ԃ̓)
+    float m_length = 0.0f;
+    float m_spacing = 1.0f;                     //Tv̊Ԋu(̂)
+    float m_invSpacing = 1.0f;
+
+    //--------------Tv(̂ i * m_spacing ̒n_)------------------
+    std::vector<DirectX::SimpleMath::Vector3> m_positions;
+    std::vector<DirectX::SimpleMath::Vector3> m_tangents;
+    std::vector<uint16_t> m_segments;
+};
@@ -0,0 +1,462 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include "PatrolSteering.h"
+#include "PatrolComponent.h"
+#include "PatrolPath.h"
+#include "GameObject.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PATROL_STEERING_SSE 1
+#include <emmintrin.h>
+#endif
+
+std::vector<PatrolComponent*> PatrolSteering::m_pending;
+PatrolSteering::Batch PatrolSteering::m_batch;
+
+bool PatrolSteering::m_batched = true;
+#if defined(PATROL_STEERING_SSE)
+PatrolSteering::STEERING_KERNEL PatrolSteering::m_kernel = PatrolSteering::STEERING_SSE;
+#else
+PatrolSteering::STEERING_KERNEL PatrolSteering::m_kernel = PatrolSteering::STEERING_SCALAR;
+#endif
+PatrolSteering::Stats PatrolSteering::m_stats;
+
+namespace
+{
+    constexpr float EPSILON_SQ = 1e-6f;
+    constexpr float HALF_PI = 1.57079632679f;
+    constexpr float PI = 3.14159265359f;
+
+    //-----------------------XJ[(PatrolComponent 1̂ĂvZƓ)-----------------------
+    void SteerScalar(PatrolSteering::Batch& b, size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            const float dt = b.dt[i];
+            const float px = b.posX[i], py = b.posY[i], pz = b.posZ[i];
+            float dx = b.dirX[i], dy = b.dirY[i], dz = b.dirZ[i];
+            const float speed = b.speed[i];
+
+            //Reynolds: ʒu̗\
+            const float ahead = speed * b.lookAhead[i];
+            const float ox = px + dx * ahead - b.targetX[i];
+            const float oy = py + dy * ahead - b.targetY[i];
+            const float oz = pz + dz * ahead - b.targetZ[i];
+
+            //Reynolds: aOȂ Seek
+            float wx = dx, wy = dy, wz = dz;
+            const float radius = b.pathRadius[i];
+            if (ox * ox + oy * oy + oz * oz > radius * radius)
+            {
+                wx = b.targetX[i] - px;
+                wy = b.targetY[i] - py;
+                wz = b.targetZ[i] - pz;
+                const float lenSq = wx * wx + wy * wy + wz * wz;
+                if (lenSq > EPSILON_SQ)
+                {
+                    const float inv = 1.0f / std::sqrt(lenSq);
+                    wx *= inv; wy *= inv; wz *= inv;
+                }
+            }
+
+            //XeAO(񐧌)
+            const float curSq = dx * dx + dy * dy + dz * dz;
+            if (curSq < EPSILON_SQ)
+            {
+                dx = wx; dy = wy; dz = wz;
+            }
+            else
+            {
+                const float inv = 1.0f / std::sqrt(curSq);
+                dx *= inv; dy *= inv; dz *= inv;
+            }
+
+            const float alpha = std::min(b.turnRate[i] * dt, 1.0f);
+            dx += (wx - dx) * alpha;
+            dy += (wy - dy) * alpha;
+            dz += (wz - dz) * alpha;
+
+            const float newSq = dx * dx + dy * dy + dz * dz;
+            if (newSq > EPSILON_SQ)
+            {
+                const float inv = 1.0f / std::sqrt(newSq);
+                dx *= inv; dy *= inv; dz *= inv;
+            }
+
+            //ʒuXV(path ɒtȂ)
+            const float step = speed * dt;
+            b.posX[i] = px + dx * step;
+            b.posY[i] = py + dy * step;
+            b.posZ[i] = pz + dz * step;
+            b.dirX[i] = dx;
+            b.dirY[i] = dy;
+            b.dirZ[i] = dz;
+
+            //(yaw ̂)
+            b.yaw[i] = (dx * dx + dz * dz > EPSILON_SQ) ? std::atan2(dx, dz) : 0.0f;
+        }
+    }
+
+#if defined(PATROL_STEERING_SSE)
+    //-----------------------SSE(4̂)-----------------------
+    inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+    {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+    }
+
+    // 0 ɋ߂΂̂܂
+    inline void Normalize(__m128& x, __m128& y, __m128& z)
+    {
+        const __m128 lenSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        const __m128 valid = _mm_cmpgt_ps(lenSq, _mm_set1_ps(EPSILON_SQ));
+        const __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_max_ps(lenSq, _mm_set1_ps(EPSILON_SQ))));
+        x = Select(valid, _mm_mul_ps(x, inv), x);
+        y = Select(valid, _mm_mul_ps(y, inv), y);
+        z = Select(valid, _mm_mul_ps(z, inv), z);
+    }
+
+    //atan2(y, x) ̋ߎ(덷 2e-4 rad xByaw ɂ͏\)
+    inline __m128 Atan2(__m128 y, __m128 x)
+    {
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 ax = _mm_andnot_ps(signMask, x);
+        const __m128 ay = _mm_andnot_ps(signMask, y);
+
+        const __m128 mx = _mm_max_ps(ax, ay);
+        const __m128 mn = _mm_min_ps(ax, ay);
+        const __m128 a = _mm_div_ps(mn, _mm_max_ps(mx, _mm_set1_ps(1e-30f)));
+        const __m128 s = _mm_mul_ps(a, a);
+
+        __m128 r = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-0.0464964749f), s), _mm_set1_ps(0.15931422f));
+        r = _mm_sub_ps(_mm_mul_ps(r, s), _mm_set1_ps(0.327622764f));
+        r = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(r, s), a), a);
+
+        r = Select(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(HALF_PI), r), r);
+        r = Select(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(PI), r), r);
+        return _mm_or_ps(r, _mm_and_ps(signMask, y));
+    }
+
+    void SteerSse(PatrolSteering::Batch& b, size_t count)
+    {
+        const __m128 epsilonSq = _mm_set1_ps(EPSILON_SQ);
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        //Resize  4 ̔{܂ 0 Ŗ߂Ă̂Œ[̏͗vȂ
+        for (size_t i = 0; i < count; i += 4)
+        {
+            const __m128 px = _mm_loadu_ps(&b.posX[i]);
+            const __m128 py = _mm_loadu_ps(&b.posY[i]);
+            const __m128 pz = _mm_loadu_ps(&b.posZ[i]);
+            __m128 dx = _mm_loadu_ps(&b.dirX[i]);
+            __m128 dy = _mm_loadu_ps(&b.dirY[i]);
+            __m128 dz = _mm_loadu_ps(&b.dirZ[i]);
+            const __m128 tx = _mm_loadu_ps(&b.targetX[i]);
+            const __m128 ty = _mm_loadu_ps(&b.targetY[i]);
+            const __m128 tz = _mm_loadu_ps(&b.targetZ[i]);
+            const __m128 speed = _mm_loadu_ps(&b.speed[i]);
+            const __m128 vdt = _mm_loadu_ps(&b.dt[i]);
+
+            //Reynolds: ʒu̗\
+            const __m128 ahead = _mm_mul_ps(speed, _mm_loadu_ps(&b.lookAhead[i]));
+            const __m128 ox = _mm_sub_ps(_mm_add_ps(px, _mm_mul_ps(dx, ahead)), tx);
+            const __m128 oy = _mm_sub_ps(_mm_add_ps(py, _mm_mul_ps(dy, ahead)), ty);
+            const __m128 oz = _mm_sub_ps(_mm_add_ps(pz, _mm_mul_ps(dz, ahead)), tz);
+            const __m128 offSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ox, ox), _mm_mul_ps(oy, oy)), _mm_mul_ps(oz, oz));
+
+            //Reynolds: aOȂ Seek
+            const __m128 radius = _mm_loadu_ps(&b.pathRadius[i]);
+            const __m128 seek = _mm_cmpgt_ps(offSq, _mm_mul_ps(radius, radius));
+
+            __m128 sx = _mm_sub_ps(tx, px);
+            __m128 sy = _mm_sub_ps(ty, py);
+            __m128 sz = _mm_sub_ps(tz, pz);
+            Normalize(sx, sy, sz);
+
+            const __m128 wx = Select(seek, sx, dx);
+            const __m128 wy = Select(seek, sy, dy);
+            const __m128 wz = Select(seek, sz, dz);
+
+            //XeAO(񐧌)
+            const __m128 curSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            const __m128 noDir = _mm_cmplt_ps(curSq, epsilonSq);
+            Normalize(dx, dy, dz);
+            dx = Select(noDir, wx, dx);
+            dy = Select(noDir, wy, dy);
+            dz = Select(noDir, wz, dz);
+
+            const __m128 alpha = _mm_min_ps(_mm_mul_ps(_mm_loadu_ps(&b.turnRate[i]), vdt), one);
+            dx = _mm_add_ps(dx, _mm_mul_ps(_mm_sub_ps(wx, dx), alpha));
+            dy = _mm_add_ps(dy, _mm_mul_ps(_mm_sub_ps(wy, dy), alpha));
+            dz = _mm_add_ps(dz, _mm_mul_ps(_mm_sub_ps(wz, dz), alpha));
+            Normalize(dx, dy, dz);
+
+            //ʒuXV(path ɒtȂ)
+            const __m128 step = _mm_mul_ps(speed, vdt);
+            _mm_storeu_ps(&b.posX[i], _mm_add_ps(px, _mm_mul_ps(dx, step)));
+            _mm_storeu_ps(&b.posY[i], _mm_add_ps(py, _mm_mul_ps(dy, step)));
+            _mm_storeu_ps(&b.posZ[i], _mm_add_ps(pz, _mm_mul_ps(dz, step)));
+            _mm_storeu_ps(&b.dirX[i], dx);
+            _mm_storeu_ps(&b.dirY[i], dy);
+            _mm_storeu_ps(&b.dirZ[i], dz);
+
+            //(yaw ̂)
+            const __m128 flatSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dz, dz));
+            const __m128 yaw = _mm_and_ps(_mm_cmpgt_ps(flatSq, epsilonSq), Atan2(dx, dz));
+            _mm_storeu_ps(&b.yaw[i], yaw);
+        }
+    }
+#endif
+}
+
+void PatrolSteering::Batch::Resize(size_t n)
+{
+    count = n;
+
+    //SSE  4 ̂ǂ߂悤ɗ] 0 Ŗ߂
+    const size_t padded = (n + 3) & ~static_cast<size_t>(3);
+    for (std::vector<float>* v : { &posX, &posY, &posZ, &dirX, &dirY, &dirZ, &targetX, &targetY, &targetZ,
+        &speed, &turnRate, &pathRadius, &lookAhead, &dt, &yaw })
+    {
+        v->resize(padded);
+        std::fill(v->begin() + n, v->end(), 0.0f);
+    }
+}
+
+void PatrolSteering::Steer(STEERING_KERNEL kernel, Batch& batch)
+{
+#if defined(PATROL_STEERING_SSE)
+    if (kernel == STEERING_SSE)
+    {
+        SteerSse(batch, batch.count);
+        return;
+    }
+#endif
+    SteerScalar(batch, 0, batch.count);
+}
+
+const char* PatrolSteering::GetKernelName(STEERING_KERNEL kernel)
+{
+    switch (kernel)
+    {
+    case STEERING_SCALAR: return "Scalar";
+    case STEERING_SSE:    return "SSE";
+    default:              return "?";
+    }
+}
+
+void PatrolSteering::Submit(PatrolComponent* patrol, float dt)
+{
+    //̂̓[g̃TvȂ̂łŐi߂
+    patrol->m_distance = patrol->m_path->Advance(patrol->m_distance, patrol->m_speed * dt);
+    patrol->m_stepDt = dt;
+
+    if (m_batched)
+    {
+        m_pending.push_back(patrol);
+        return;
+    }
+
+    //ob`Ȃ͍܂Œʂ肻̏1̕
+    m_batch.Resize(1);
+    Gather(patrol, 0);
+    SteerScalar(m_batch, 0, 1);
+    Scatter(patrol, 0);
+}
+
+void PatrolSteering::Cancel(PatrolComponent* patrol)
+{
+    m_pending.erase(std::remove(m_pending.begin(), m_pending.end(), patrol), m_pending.end());
+}
+
+void PatrolSteering::Flush()
+{
+    if (m_pending.empty())
+    {
+        return;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    //W߂(̓IuWFNgƂɃU΂Ă)
+    const size_t count = m_pending.size();
+    m_batch.Resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        Gather(m_pending[i], i);
+    }
+
+    //܂Ƃ߂ČvZ
+    Steer(m_kernel, m_batch);
+
+    //߂
+    for (size_t i = 0; i < count; ++i)
+    {
+        Scatter(m_pending[i], i);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    m_stats.kernel = m_kernel;
+    m_stats.enemies = static_cast<int>(count);
+    m_stats.steerMs = std::chrono::duration<float, std::milli>(end - start).count();
+
+    m_pending.clear();
+}
+
+void PatrolSteering::Clear()
+{
+    m_pending.clear();
+    m_stats = Stats{};
+}
+
+void PatrolSteering::Gather(PatrolComponent* patrol, size_t i)
+{
+    const PatrolPath::Sample sample = patrol->m_path->Evaluate(patrol->m_distance);
+    patrol->m_currentIndex = sample.segment;
+
+    const Vector3& pos = patrol->GetOwner()->GetPosition();
+    const Vector3& dir = patrol->m_currentDir;
+
+    m_batch.posX[i] = pos.x;
+    m_batch.posY[i] = pos.y;
+    m_batch.posZ[i] = pos.z;
+    m_batch.dirX[i] = dir.x;
+    m_batch.dirY[i] = dir.y;
+    m_batch.dirZ[i] = dir.z;
+    m_batch.targetX[i] = sample.position.x;
+    m_batch.targetY[i] = sample.position.y;
+    m_batch.targetZ[i] = sample.position.z;
+    m_batch.speed[i] = patrol->m_speed;
+    m_batch.turnRate[i] = patrol->m_turnRate;
+    m_batch.pathRadius[i] = patrol->m_pathRadius;
+    m_batch.lookAhead[i] = patrol->m_lookAheadTime;
+    m_batch.dt[i] = patrol->m_stepDt;
+}
+
+void PatrolSteering::Scatter(PatrolComponent* patrol, size_t i)
+{
+    GameObject* owner = patrol->GetOwner();
+
+    patrol->m_currentDir = Vector3(m_batch.dirX[i], m_batch.dirY[i], m_batch.dirZ[i]);
+    owner->SetPosition(Vector3(m_batch.posX[i], m_batch.posY[i], m_batch.posZ[i]));
+
+    //Ȍ鎞 yaw ς
+    const Vector3& dir = patrol->m_currentDir;
+    if (patrol->m_faceMovement && dir.x * dir.x + dir.z * dir.z > EPSILON_SQ)
+    {
+        Vector3 rot = owner->GetRotation();
+        rot.y = m_batch.yaw[i];
+        owner->SetRotation(rot);
+    }
+}
+
+void PatrolSteering::RunSteeringBenchmark(std::vector<std::string>& outLines)
+{
+    const int enemyCounts[] = { 10, 100, 1000, 10000 };
+    const int frames = 60;
+    const float dt = 1.0f / 60.0f;
+
+    //Xe[W̏񃋁[g炢̑傫
+    PatrolPathHandle path = PatrolPath::Create({
+        { -100.0f, 15.0f, -170.0f }, { 20.0f, 15.0f, -120.0f }, { 117.0f, 15.0f, -13.0f }, { 86.0f, 15.0f, 73.0f },
+        { -52.0f, 15.0f, 83.0f }, { -23.0f, 15.0f, 196.0f }, { 150.0f, 15.0f, 231.0f }, { -140.0f, 35.0f, 175.0f } }, true);
+    if (!path)
+    {
+        return;
+    }
+
+    //̐ݒ͍Ōɖ߂(s Flush ̌ʂ͎cȂ)
+    const bool batched = m_batched;
+    const STEERING_KERNEL kernel = m_kernel;
+    const Stats stats = m_stats;
+    m_pending.clear();
+
+    char buf[256];
+    sprintf_s(buf, "Patrol steering benchmark (%d frames, ms / frame)", frames);
+    outLines.push_back(buf);
+
+    //mode 0 : 1̂(Update ̒ŌvZ), 1 : ob`EXJ[, 2 : ob`ESSE
+    const int modeCount = 3;
+    const char* modeNames[modeCount] = { "per-object", "batch scalar", "batch SSE" };
+
+    for (int count : enemyCounts)
+    {
+        double ms[modeCount] = {};
+        std::vector<Vector3> finalPositions[modeCount];
+        std::vector<float> finalYaws[modeCount];
+
+        for (int mode = 0; mode < modeCount; ++mode)
+        {
+#if !defined(PATROL_STEERING_SSE)
+            if (mode == 2) { continue; }
+#endif
+            m_batched = (mode != 0);
+            m_kernel = (mode == 2) ? STEERING_SSE : STEERING_SCALAR;
+
+            //[gɕׁAɂ炵ĒǏ](Seek)N悤ɂ
+            std::vector<std::shared_ptr<GameObject>> objects;
+            objects.reserve(count);
+            for (int i = 0; i < count; ++i)
+            {
+                const float distance = path->GetLength() * i / count;
+                const PatrolPath::Sample sample = path->Evaluate(distance);
+
+                auto obj = std::make_shared<GameObject>();
+                obj->SetPosition(sample.position + Vector3(static_cast<float>(i % 7) - 3.0f, 0.0f, 0.0f));
+
+                auto patrol = obj->AddComponent<PatrolComponent>();
+                patrol->SetPath(path, distance);
+                patrol->SetSpeed(80.0f);
+                patrol->SetUseSpline(true);
+                objects.push_back(obj);
+            }
+
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int f = 0; f < frames; ++f)
+            {
+                for (auto& obj : objects)
+                {
+                    obj->Update(dt);
+                }
+                Flush();
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+
+            ms[mode] = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+
+            for (auto& obj : objects)
+            {
+                finalPositions[mode].push_back(obj->GetPosition());
+                finalYaws[mode].push_back(obj->GetRotation().y);
+            }
+        }
+
+        //SSE ƃXJ[̂(yaw  atan2 ̋ߎ̕)
+        float maxDiff = 0.0f;
+        float maxYawDiff = 0.0f;
+        if (!finalPositions[2].empty())
+        {
+            for (size_t i = 0; i < finalPositions[0].size(); ++i)
+            {
+                maxDiff = std::max(maxDiff, (finalPositions[2][i] - finalPositions[0][i]).Length());
+
+                //-pi  pi ̋ڂ͓
+                float yawDiff = std::fabs(finalYaws[2][i] - finalYaws[0][i]);
+                yawDiff = std::min(yawDiff, 2.0f * PI - yawDiff);
+                maxYawDiff = std::max(maxYawDiff, yawDiff);
+            }
+        }
+
+        sprintf_s(buf, "  %5d enemies : %s %.3f / %s %.3f / %s %.3f (x%.1f), SSE diff pos %.5f yaw %.6f rad",
+            count, modeNames[0], ms[0], modeNames[1], ms[1], modeNames[2], ms[2],
+            ms[2] > 0.0 ? ms[0] / ms[2] : 0.0, maxDiff, maxYawDiff);
+        outLines.push_back(buf);
+    }
+
+    m_batched = batched;
+    m_kernel = kernel;
+    m_stats = stats;
+    m_pending.clear();
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <vector>
+#include <string>
+
+class PatrolComponent;
+
+//---------------------------------------------------------
+// 񂷂G̃XeAO܂Ƃ߂ČvZNX
+// PatrolComponent::Update ͓̂i߂Ď Submit 邾ɂāA
+// Flush ňʒuEEE[g̓_z(SoA)ɏW߁A
+// Reynolds  \  ͂ݏoǏ]    yaw 1̃[vŉ񂵂ď߂
+// (SSE ł 4 ̂Batan2 ߎł܂Ƃ߂ČvZ)
+//---------------------------------------------------------
+class PatrolSteering
+{
+public:
+    enum STEERING_KERNEL
+    {
+        STEERING_SCALAR,
+        STEERING_SSE,
+
+        MAX_STEERING_KERNEL
+    };
+
+    //SoA ̓o(Resize  4 ̔{ɂ낦A] 0 Ŗ߂)
+    struct Batch
+    {
+        std::vector<float> posX, posY, posZ;            //:̈ʒu o:i񂾌̈ʒu
+        std::vector<float> dirX, dirY, dirZ;            //:̌ o:Ȃ̌
+        std::vector<float> targetX, targetY, targetZ;   //[g̓_
+        std::vector<float> speed;
+        std::vector<float> turnRate;
+        std::vector<float> pathRadius;
+        std::vector<float> lookAhead;
+        std::vector<float> dt;                          //AILODŔ΂܂ނ̂œGƂɈႤ
+        std::vector<float> yaw;                         //o(Ȍ 0)
+        size_t count = 0;
+
+        void Resize(size_t n);
+    };
+
+    struct Stats
+    {
+        STEERING_KERNEL kernel = STEERING_SCALAR;
+        int enemies = 0;        //߂ Flush œ
+        float steerMs = 0.0f;   //W߂EvZE߂̍v
+    };
+
+    //PatrolComponent::Update Ă(ob`Ȃ炻̏1̕vZ)
+    static void Submit(PatrolComponent* patrol, float dt);
+
+    //j鎞ɊO(Flush OɏĂ߂Ȃ)
+    static void Cancel(PatrolComponent* patrol);
+
+    //IuWFNg Update ̌ɌĂ
+    static void Flush();
+
+    static void Clear();
+
+    //batch.count ̕vZ(x`}[N璼ڌĂ)
+    static void Steer(STEERING_KERNEL kernel, Batch& batch);
+
+    //--------Set֐-------
+    static void SetBatched(bool batched) { m_batched = batched; }
+    static void SetKernel(STEERING_KERNEL kernel) { m_kernel = kernel; }
+
+    //--------Get֐-------
+    static bool IsBatched() { return m_batched; }
+    static STEERING_KERNEL GetKernel() { return m_kernel; }
+    static const Stats& GetStats() { return m_stats; }
+    static const char* GetKernelName(STEERING_KERNEL kernel);
+
+    //10 ` 10000 ̂ 1̂ Update ƃob`ׂ(DebugBenchmark ɓo^)
+    static void RunSteeringBenchmark(std::vector<std::string>& outLines);
+
+private:
+    static void Gather(PatrolComponent* patrol, size_t index);
+    static void Scatter(PatrolComponent* patrol, size_t index);
+
+    static std::vector<PatrolComponent*> m_pending;
+    static Batch m_batch;
+
+    static bool m_batched;
+    static STEERING_KERNEL m_kernel;
+    static Stats m_stats;
+};
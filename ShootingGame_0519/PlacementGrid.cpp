@@ -0,0 +1,351 @@
+#define NOMINMAX
+#include <windows.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "PlacementGrid.h"
+
+using namespace DirectX::SimpleMath;
+
+namespace
+{
+    //}X̐̏(L͈͂ɏ}Xw肳ꂽ̓}X傫)
+    constexpr long long MAX_CELLS = 1ll << 22;
+
+    double ElapsedMs(std::chrono::high_resolution_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+}
+
+void PlacementGrid::Reset(float minX, float minZ, float maxX, float maxZ, float cellSize)
+{
+    m_minX = minX;
+    m_minZ = minZ;
+    m_cellSize = std::max(cellSize, 0.001f);
+
+    const float width = std::max(maxX - minX, 0.0f);
+    const float depth = std::max(maxZ - minZ, 0.0f);
+    while (true)
+    {
+        m_cols = std::max(1, static_cast<int>(std::ceil(width / m_cellSize)));
+        m_rows = std::max(1, static_cast<int>(std::ceil(depth / m_cellSize)));
+        if (static_cast<long long>(m_cols) * m_rows <= MAX_CELLS)
+        {
+            break;
+        }
+        m_cellSize *= 2.0f;
+    }
+    m_invCellSize = 1.0f / m_cellSize;
+
+    m_cellHead.assign(static_cast<size_t>(m_cols) * m_rows, -1);
+    m_rects.clear();
+    m_nodes.clear();
+}
+
+void PlacementGrid::Clear()
+{
+    std::fill(m_cellHead.begin(), m_cellHead.end(), -1);
+    m_rects.clear();
+    m_nodes.clear();
+}
+
+void PlacementGrid::CellRange(const Rect& rect, int& x0, int& z0, int& x1, int& z1) const
+{
+    x0 = std::clamp(static_cast<int>(std::floor((rect.cx - rect.halfW - m_minX) * m_invCellSize)), 0, m_cols - 1);
+    x1 = std::clamp(static_cast<int>(std::floor((rect.cx + rect.halfW - m_minX) * m_invCellSize)), 0, m_cols - 1);
+    z0 = std::clamp(static_cast<int>(std::floor((rect.cz - rect.halfD - m_minZ) * m_invCellSize)), 0, m_rows - 1);
+    z1 = std::clamp(static_cast<int>(std::floor((rect.cz + rect.halfD - m_minZ) * m_invCellSize)), 0, m_rows - 1);
+}
+
+bool PlacementGrid::Overlaps(const Rect& rect) const
+{
+    if (m_cellHead.empty())
+    {
+        return false;
+    }
+
+    //dȂ2̎lp͕K}XɓĂ̂ŁA|}XΗǂ
+    int x0, z0, x1, z1;
+    CellRange(rect, x0, z0, x1, z1);
+    for (int z = z0; z <= z1; ++z)
+    {
+        for (int x = x0; x <= x1; ++x)
+        {
+            for (int node = m_cellHead[static_cast<size_t>(z) * m_cols + x]; node >= 0; node = m_nodes[node].next)
+            {
+                const Rect& placed = m_rects[m_nodes[node].rect];
+                if (std::fabs(rect.cx - placed.cx) < (rect.halfW + placed.halfW) &&
+                    std::fabs(rect.cz - placed.cz) < (rect.halfD + placed.halfD))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+void PlacementGrid::Insert(const Rect& rect)
+{
+    if (m_cellHead.empty())
+    {
+        return;
+    }
+
+    const int index = static_cast<int>(m_rects.size());
+    m_rects.push_back(rect);
+
+    int x0, z0, x1, z1;
+    CellRange(rect, x0, z0, x1, z1);
+    for (int z = z0; z <= z1; ++z)
+    {
+        for (int x = x0; x <= x1; ++x)
+        {
+            int& head = m_cellHead[static_cast<size_t>(z) * m_cols + x];
+            m_nodes.push_back({ index, head });
+            head = static_cast<int>(m_nodes.size()) - 1;
+        }
+    }
+}
+
+bool PlacementGrid::TryInsert(const Rect& rect)
+{
+    if (Overlaps(rect))
+    {
+        return false;
+    }
+    Insert(rect);
+    return true;
+}
+
+void PlacementGrid::SamplePoissonDisk(float minX, float minZ, float maxX, float maxZ, float radius,
+    RandomStream& rng, int maxCount, std::vector<Vector3>& out, int attempts)
+{
+    out.clear();
+    if (radius <= 0.0f || maxX <= minX || maxZ <= minZ)
+    {
+        return;
+    }
+
+    //1}Xɓ_1Ȃ傫(Ίp radius)
+    const float cell = radius / std::sqrt(2.0f);
+    const float invCell = 1.0f / cell;
+    const int cols = static_cast<int>(std::ceil((maxX - minX) * invCell));
+    const int rows = static_cast<int>(std::ceil((maxZ - minZ) * invCell));
+    if (static_cast<long long>(cols) * rows > MAX_CELLS * 16)
+    {
+        OutputDebugStringA("[PlacementGrid] Poisson disk area too large for radius\n");
+        return;
+    }
+
+    std::vector<int> grid(static_cast<size_t>(cols) * rows, -1);
+    std::vector<int> active;
+    const float radiusSq = radius * radius;
+
+    auto cellOf = [&](float x, float z, int& cx, int& cz)
+    {
+        cx = std::min(static_cast<int>((x - minX) * invCell), cols - 1);
+        cz = std::min(static_cast<int>((z - minZ) * invCell), rows - 1);
+    };
+
+    auto add = [&](float x, float z)
+    {
+        int cx, cz;
+        cellOf(x, z, cx, cz);
+        grid[static_cast<size_t>(cz) * cols + cx] = static_cast<int>(out.size());
+        active.push_back(static_cast<int>(out.size()));
+        out.push_back(Vector3(x, 0.0f, z));
+    };
+
+    add(rng.Range(minX, maxX), rng.Range(minZ, maxZ));
+
+    while (!active.empty() && (maxCount <= 0 || static_cast<int>(out.size()) < maxCount))
+    {
+        const int activeIndex = rng.RangeInt(0, static_cast<int>(active.size()));
+        const Vector3 origin = out[active[activeIndex]];
+
+        bool found = false;
+        for (int k = 0; k < attempts && !found; ++k)
+        {
+            //radius ` 2*radius ̗ւ̒ʐςϓɂȂ悤ɑI(lpւ̊ÔĂBsin/cos/sqrt )
+            float ox, oz, lenSq;
+            do
+            {
+                ox = rng.Range(-2.0f, 2.0f);
+                oz = rng.Range(-2.0f, 2.0f);
+                lenSq = ox * ox + oz * oz;
+            } while (lenSq < 1.0f || lenSq >= 4.0f);
+
+            const float x = origin.x + ox * radius;
+            const float z = origin.z + oz * radius;
+            if (x < minX || x >= maxX || z < minZ || z >= maxZ)
+            {
+                continue;
+            }
+
+            //radius ȓ̓_͎ 5x5 }Xɂ
+            int cx, cz;
+            cellOf(x, z, cx, cz);
+            bool nearOther = false;
+            for (int gz = std::max(cz - 2, 0); gz <= std::min(cz + 2, rows - 1) && !nearOther; ++gz)
+            {
+                for (int gx = std::max(cx - 2, 0); gx <= std::min(cx + 2, cols - 1); ++gx)
+                {
+                    //p4}X radius 艓
+                    if (std::abs(gx - cx) == 2 && std::abs(gz - cz) == 2) { continue; }
+
+                    const int other = grid[static_cast<size_t>(gz) * cols + gx];
+                    if (other < 0) { continue; }
+
+                    const float dx = out[other].x - x;
+                    const float dz = out[other].z - z;
+                    if (dx * dx + dz * dz < radiusSq)
+                    {
+                        nearOther = true;
+                        break;
+                    }
+                }
+            }
+
+            if (!nearOther)
+            {
+                add(x, z);
+                found = true;
+            }
+        }
+
+        //ɒuȂȂ_͊O
+        if (!found)
+        {
+            active[activeIndex] = active.back();
+            active.pop_back();
+        }
+    }
+}
+
+void PlacementGrid::RunPlacementBenchmark(std::vector<std::string>& outLines)
+{
+    //1Ԃ̊Ɠ : scale 60 + spacing 30   45
+    const float half = 45.0f;
+    char buf[256];
+
+    outLines.push_back("Placement benchmark (footprint half 45 = rock scale 60 + spacing 30)");
+
+    //-------- ܂ɒu(BuildingSpawner::Spawn) --------
+    auto makeCandidates = [half](int count, RandomStream& rng, std::vector<Rect>& out, float& side)
+    {
+        //炢dȂĎ̂Ă閧x
+        side = std::sqrt(static_cast<float>(count)) * half * 2.5f;
+        out.resize(count);
+        for (Rect& r : out)
+        {
+            r = { rng.Range(0.0f, side), rng.Range(0.0f, side), half, half };
+        }
+    };
+
+    for (int count : { 10000, 100000 })
+    {
+        RandomStream rng(7, 0);
+        std::vector<Rect> candidates;
+        float side = 0.0f;
+        makeCandidates(count, rng, candidates, side);
+
+        //Ô : uSƔׂ(10͎Ԃ|߂̂ 1)
+        int linearPlaced = -1;
+        double linearMs = 0.0;
+        if (count <= 10000)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            std::vector<Rect> placed;
+            for (const Rect& c : candidates)
+            {
+                bool overlap = false;
+                for (const Rect& p : placed)
+                {
+                    if (std::fabs(c.cx - p.cx) < (c.halfW + p.halfW) &&
+                        std::fabs(c.cz - p.cz) < (c.halfD + p.halfD))
+                    {
+                        overlap = true;
+                        break;
+                    }
+                }
+                if (!overlap) { placed.push_back(c); }
+            }
+            linearMs = ElapsedMs(start);
+            linearPlaced = static_cast<int>(placed.size());
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        PlacementGrid grid;
+        grid.Reset(0.0f, 0.0f, side, side, half * 2.0f);
+        int gridPlaced = 0;
+        for (const Rect& c : candidates)
+        {
+            if (grid.TryInsert(c)) { ++gridPlaced; }
+        }
+        const double gridMs = ElapsedMs(start);
+
+        if (linearPlaced >= 0)
+        {
+            sprintf_s(buf, "  fixed %6d candidates : linear %8.2f ms, grid %6.2f ms (placed %d / %d)",
+                count, linearMs, gridMs, linearPlaced, gridPlaced);
+        }
+        else
+        {
+            sprintf_s(buf, "  fixed %6d candidates : grid %6.2f ms (placed %d)", count, gridMs, gridPlaced);
+        }
+        outLines.push_back(buf);
+    }
+
+    //-------- 10U炷(BuildingSpawner::RandomSpawn) --------
+    const int props = 100000;
+
+    //Poisson ̊Ԋu : ̋ȏ㗣ĂΔ 45 ̎lp͕KdȂȂ
+    const float radius = half * 2.0f * std::sqrt(2.0f);
+    const float side = std::sqrt(static_cast<float>(props) / 0.5f) * radius;
+
+    {
+        RandomStream rng(11, 0);
+        auto start = std::chrono::high_resolution_clock::now();
+
+        std::vector<Vector3> points;
+        SamplePoissonDisk(0.0f, 0.0f, side, side, radius, rng, props, points);
+
+        PlacementGrid grid;
+        grid.Reset(0.0f, 0.0f, side, side, half * 2.0f);
+        int placed = 0;
+        for (const Vector3& p : points)
+        {
+            if (grid.TryInsert({ p.x, p.z, half, half })) { ++placed; }
+        }
+        sprintf_s(buf, "  poisson scatter        : %6.2f ms, placed %d / %d samples", ElapsedMs(start), placed, static_cast<int>(points.size()));
+        outLines.push_back(buf);
+    }
+
+    {
+        //ÔƓlȗ50܂Ŏ(̓Obh)
+        RandomStream rng(11, 0);
+        auto start = std::chrono::high_resolution_clock::now();
+
+        PlacementGrid grid;
+        grid.Reset(0.0f, 0.0f, side, side, half * 2.0f);
+        int placed = 0;
+        long long tries = 0;
+        for (int i = 0; i < props; ++i)
+        {
+            for (int attempt = 0; attempt < 50; ++attempt)
+            {
+                ++tries;
+                if (grid.TryInsert({ rng.Range(0.0f, side), rng.Range(0.0f, side), half, half }))
+                {
+                    ++placed;
+                    break;
+                }
+            }
+        }
+        sprintf_s(buf, "  uniform retry scatter  : %6.2f ms, placed %d / %d (%lld tries)", ElapsedMs(start), placed, props, tries);
+        outLines.push_back(buf);
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <SimpleMath.h>
+#include "RandomService.h"
+
+//---------------------------------------------------------
+// ̑(XZ ̎lp)dȂȂ𒲂ׂ邽߂̈lObh
+// Elp͊|}XSɓĂAׂ鎞|}X̒
+// E}X̑傫ԑ傫ȏɂ1̎lp4}XȉȂ̂ŁA
+//   uɊ֌WȂ1̔͂قڈ(O͒uSƔׂĂ)
+// E}XƂ̒g1{̔zɌqŎ(ux new Ȃ)
+//---------------------------------------------------------
+class PlacementGrid
+{
+public:
+    //(SƔ)
+    struct Rect
+    {
+        float cx, cz;
+        float halfW, halfD;
+    };
+
+    //͈͂ƃ}X̑傫߂ċɂ(͈͊O̎lp͒[̃}Xɓ)
+    void Reset(float minX, float minZ, float maxX, float maxZ, float cellSize);
+
+    //gɂ(}X͂̂܂)
+    void Clear();
+
+    //uĂǂꂩƏdȂ邩(BuildingSpawner ƓEڂ邾ȂdȂȂ)
+    bool Overlaps(const Rect& rect) const;
+
+    void Insert(const Rect& rect);
+
+    //dȂȂΒu
+    bool TryInsert(const Rect& rect);
+
+    //--------Get֐-------
+    size_t GetCount() const { return m_rects.size(); }
+    float GetCellSize() const { return m_cellSize; }
+
+    //---------------------------------------------------------
+    // Bridson  Poisson fBXN : ͈͓ɁAǂ2_ radius ȏ㗣ꂽ_U炷
+    // u_̎ attempts oA߂ɓ_΍̗p
+    // maxCount (0 Ȃ疄܂܂)Ŏ~߂Bʂ y  0
+    //---------------------------------------------------------
+    static void SamplePoissonDisk(float minX, float minZ, float maxX, float maxZ, float radius,
+        RandomStream& rng, int maxCount, std::vector<DirectX::SimpleMath::Vector3>& out, int attempts = 30);
+
+    //10𓯂Ԋǔ܂Œu(DebugBenchmark ɓo^)
+    static void RunPlacementBenchmark(std::vector<std::string>& outLines);
+
+private:
+    void CellRange(const Rect& rect, int& x0, int& z0, int& x1, int& z1) const;
+
+    float m_minX = 0.0f;
+    float m_minZ = 0.0f;
+    float m_cellSize = 1.0f;
+    float m_invCellSize = 1.0f;
+    int m_cols = 0;
+    int m_rows = 0;
+
+    std::vector<Rect> m_rects;
+    std::vector<int> m_cellHead;    //}XƂ̍ŏ m_nodes ̔ԍ(-1 Ȃ)
+    struct Node
+    {
+        int rect;
+        int next;
+    };
+    std::vector<Node> m_nodes;
+};
@@ -8,10 +8,11 @@
 #include "BulletComponent.h"
 #include "Collision.h" 
 #include "Enemy.h"
+#include "RandomService.h"
 #include "Sound.h"
 #include "TextureManager.h"
 #include "PushOutComponent.h"
-#include <iostream>
+#include "GameplayEvents.h"
 
 void Player::Initialize()
 {
@@ -64,28 +65,22 @@ void Player::OnCollision(GameObject* other)
 {
     if (!other) { return; }
 
+    //_[W GameplayEvents ɐς݁AeEê OnDamageResolved ōs
+    auto hp = GetComponent<HitPointComponent>();
+
     //--------e̔菈-----------
     if (auto bc = other->GetComponent<BulletComponent>())
     {
         if (bc->GetBulletType() == BulletComponent::BulletType::ENEMY)
         {
             //GeɔC
-            auto hp = GetComponent<HitPointComponent>();
             if (hp)
             {
                 DamageInfo di;
                 di.amount = 2;
                 di.instigator = other;
-                di.tag = "enemy_bullet";
-                bool applied = hp->ApplyDamage(di);
-                if (applied)
-                {
-                    // e͏
-                    if (auto s = GetScene())
-                    {
-                        s->RemoveObject(other);
-                    }
-                }
+                di.source = DamageSource::EnemyBullet;
+                GameplayEvents::PushDamage(this, hp.get(), di);
             }
             else
             {
@@ -101,78 +96,82 @@ void Player::OnCollision(GameObject* other)
     }
 
     //--------Փˏ--------
-    if (auto b = dynamic_cast<Building*>(other))
+    if (dynamic_cast<Building*>(other))
     {
         //HitPointComponentɃ_[W^
-        auto hp = GetComponent<HitPointComponent>();
-
         if (hp)
         {
             DamageInfo di;
             di.amount = 4;
             di.instigator = other;
-            di.tag = "collision_building";
-            hp->ApplyDamage(di);
+            di.source = DamageSource::BuildingCollision;
+            GameplayEvents::PushDamage(this, hp.get(), di);
         }
         return;
     }
 
     //--------GՓˏ--------
-    if (auto enemy = dynamic_cast<Enemy*>(other))
+    if (dynamic_cast<Enemy*>(other))
     {
-        std::cout << "[Player] Collide Enemy : " << enemy << "\n";
-
-        auto hp = GetComponent<HitPointComponent>();
         if (hp)
         {
             DamageInfo di;
             di.amount = 4;
             di.instigator = other;
-            di.tag = "collision_enemy";
-            bool applied = hp->ApplyDamage(di);
+            di.source = DamageSource::EnemyCollision;
+            GameplayEvents::PushDamage(this, hp.get(), di);
+        }
 
-            std::cout << "  applied = " << applied << "\n";
+        return;
+    }
+}
 
-            if (applied)
-            {
-                DirectX::SimpleMath::Vector3 dir = GetPosition() - other->GetPosition();
-                dir.y = 0.0f;
+void Player::OnDamageResolved(const DamageInfo& info, bool applied)
+{
+    if (!applied || !info.instigator) { return; }
 
-                if (dir.LengthSquared() < 1e-6f)
-                {
-                    int r = std::rand() % 2;
-                    if (r == 0)
-                    {
-                        dir = DirectX::SimpleMath::Vector3(1.0f, 0.0f, 0.0f);
-                    }
-                    else
-                    {
-                        dir = DirectX::SimpleMath::Vector3(-1.0f, 0.0f, 0.0f);
-                    }
-                }
+    //--------Ge͓--------
+    if (info.source == DamageSource::EnemyBullet)
+    {
+        if (auto s = GetScene())
+        {
+            s->RemoveObject(info.instigator);
+        }
+        return;
+    }
+
+    //--------Gɓ牡ɒe--------
+    if (info.source == DamageSource::EnemyCollision)
+    {
+        DirectX::SimpleMath::Vector3 dir = GetPosition() - info.instigator->GetPosition();
+        dir.y = 0.0f;
 
-                dir.Normalize();
+        if (dir.LengthSquared() < 1e-6f)
+        {
+            int r = RandomService::GetSharedStream(RandomService::RANDOM_SYSTEM_PLAYER).RangeInt(0, 2);
+            if (r == 0)
+            {
+                dir = DirectX::SimpleMath::Vector3(1.0f, 0.0f, 0.0f);
+            }
+            else
+            {
+                dir = DirectX::SimpleMath::Vector3(-1.0f, 0.0f, 0.0f);
+            }
+        }
 
-                DirectX::SimpleMath::Vector3 lateral = DirectX::SimpleMath::Vector3(-dir.z, 0.0f, dir.x);
-                lateral.Normalize();
+        dir.Normalize();
 
-                float sign = (std::rand() % 2 == 0) ? 1.0f : -1.0f;
-                const float impulseStrength = 3.0f;
-                DirectX::SimpleMath::Vector3 impulse = lateral * sign * impulseStrength;
+        DirectX::SimpleMath::Vector3 lateral = DirectX::SimpleMath::Vector3(-dir.z, 0.0f, dir.x);
+        lateral.Normalize();
 
-                std::cout << "  impulse = "
-                    << impulse.x << ", "
-                    << impulse.y << ", "
-                    << impulse.z << "\n";
+        float sign = RandomService::GetSharedStream(RandomService::RANDOM_SYSTEM_PLAYER).Chance(0.5f) ? 1.0f : -1.0f;
+        const float impulseStrength = 3.0f;
+        DirectX::SimpleMath::Vector3 impulse = lateral * sign * impulseStrength;
 
-                auto mv = GetComponent<MoveComponent>();
-                if (mv)
-                {
-                    mv->AddImpulse(impulse);
-                }
-            }
+        auto mv = GetComponent<MoveComponent>();
+        if (mv)
+        {
+            mv->AddImpulse(impulse);
         }
-
-        return;
     }
 }
\ No newline at end of file
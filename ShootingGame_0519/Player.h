@@ -13,6 +13,7 @@ public:
     void Update(float dt) override;
 
     void OnCollision(GameObject* other) override;
+    void OnDamageResolved(const DamageInfo& info, bool applied) override;
 
 private:
     std::shared_ptr<OBBColliderComponent> m_Collider;
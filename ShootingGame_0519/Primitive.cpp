@@ -1,4 +1,6 @@
 #include "Primitive.h"
+#include <d3d11.h>
+#include "renderer.h"
 #include <iostream>
 
 void Primitive::CreateSphere(ID3D11Device* device, float radius, int sliceCount, int stackCount)
@@ -108,6 +110,9 @@ void Primitive::CreatePlane(ID3D11Device* device, float width, float depth, floa
 
 void Primitive::CreateBuffers(ID3D11Device* device)
 {
+    //wbhXsł̓foCX(_ECfbNX̔z񂾂c)
+    if (!device) { return; }
+
     if (vertexBuffer)
     {
         vertexBuffer->Release(); vertexBuffer = nullptr;
@@ -152,7 +157,17 @@ void Primitive::CreateBuffers(ID3D11Device* device)
 
 void Primitive::Draw(ID3D11DeviceContext* context)
 {
-    if (!context) { return; }
+    if (!context)
+    {
+        //wbhXsł̓obNGhɃR}h
+        if (Renderer::IsHeadless() && !indices.empty())
+        {
+            RenderBackend* backend = Renderer::GetBackend();
+            backend->SetGeometry(nullptr, sizeof(Vertex), nullptr, RIF_UINT32, RT_TRIANGLE_LIST);
+            backend->DrawIndexed(static_cast<UINT>(indices.size()));
+        }
+        return;
+    }
     if (!vertexBuffer || !indexBuffer) { return; }
     if (indices.empty()) { return; }
 
@@ -38,6 +38,12 @@ public:
     //`
     void Draw(ID3D11DeviceContext* context);
 
+    //--------Get֐-------
+    ID3D11Buffer* GetVertexBuffer() const { return vertexBuffer; }
+    ID3D11Buffer* GetIndexBuffer() const { return indexBuffer; }
+    UINT GetIndexCount() const { return static_cast<UINT>(indices.size()); }
+    UINT GetStride() const { return sizeof(Vertex); }
+
     
 
 private:
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include "RadixSort.h"
+#include "WorkerPool.h"
+
+namespace
+{
+    constexpr int RADIX_BITS = 8;
+    constexpr int BUCKETS = 1 << RADIX_BITS;
+    constexpr int PASSES = 64 / RADIX_BITS;
+
+    //菭Ȃ͕Ȃ(XbhN)
+    constexpr size_t MIN_ENTRIES_PER_CHUNK = 4096;
+}
+
+void ParallelRadixSort(std::vector<SortKeyEntry>& entries,
+                       std::vector<SortKeyEntry>& temp,
+                       int maxThreads)
+{
+    const size_t count = entries.size();
+    if (count <= 1) { return; }
+
+    temp.resize(count);
+
+    //`N߂
+    int threads = WorkerPool::GetThreadCount();
+    if (maxThreads > 0) { threads = std::min(threads, maxThreads); }
+
+    size_t chunkCount = std::min<size_t>(static_cast<size_t>(threads), (count + MIN_ENTRIES_PER_CHUNK - 1) / MIN_ENTRIES_PER_CHUNK);
+    chunkCount = std::max<size_t>(chunkCount, 1);
+    const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    //`ÑqXgO / ݈ʒu
+    std::vector<uint32_t> histogram(chunkCount * BUCKETS);
+
+    SortKeyEntry* src = entries.data();
+    SortKeyEntry* dst = temp.data();
+
+    for (int pass = 0; pass < PASSES; ++pass)
+    {
+        const int shift = pass * RADIX_BITS;
+
+        //-----------------------`Nɐ-----------------------
+        std::fill(histogram.begin(), histogram.end(), 0);
+
+        WorkerPool::ParallelFor(chunkCount, [&](size_t chunk, int)
+        {
+            uint32_t* hist = &histogram[chunk * BUCKETS];
+            size_t begin = chunk * chunkSize;
+            size_t end = std::min(begin + chunkSize, count);
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                hist[(src[i].key >> shift) & (BUCKETS - 1)]++;
+            }
+        }, threads);
+
+        //SoPbgȂ炱͕̌בւsv
+        bool skip = false;
+        for (int b = 0; b < BUCKETS; ++b)
+        {
+            uint32_t total = 0;
+            for (size_t c = 0; c < chunkCount; ++c)
+            {
+                total += histogram[c * BUCKETS + b];
+            }
+            if (total == count) { skip = true; break; }
+            if (total != 0) { break; }
+        }
+        if (skip) { continue; }
+
+        //-----------------------݈ʒu߂-----------------------
+        //oPbg  `NɕׂƈɂȂ
+        uint32_t offset = 0;
+        for (int b = 0; b < BUCKETS; ++b)
+        {
+            for (size_t c = 0; c < chunkCount; ++c)
+            {
+                uint32_t n = histogram[c * BUCKETS + b];
+                histogram[c * BUCKETS + b] = offset;
+                offset += n;
+            }
+        }
+
+        //-----------------------`Nɏ-----------------------
+        WorkerPool::ParallelFor(chunkCount, [&](size_t chunk, int)
+        {
+            uint32_t* pos = &histogram[chunk * BUCKETS];
+            size_t begin = chunk * chunkSize;
+            size_t end = std::min(begin + chunkSize, count);
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                dst[pos[(src[i].key >> shift) & (BUCKETS - 1)]++] = src[i];
+            }
+        }, threads);
+
+        std::swap(src, dst);
+    }
+
+    //ւĂ猋ʂ temp ɂ
+    if (src != entries.data())
+    {
+        entries.swap(temp);
+    }
+}
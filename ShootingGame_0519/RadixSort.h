@@ -0,0 +1,22 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+//---------------------------------------------------------
+// 64bit\[gL[p̕\[g(LSD, 8bit~8pX)
+// L[͌̏Ԃۂ(\[g)
+//---------------------------------------------------------
+
+//\[gL[ƌ̔z̈ʒu
+struct SortKeyEntry
+{
+    uint64_t key;
+    uint32_t index;
+};
+
+//entries L[̏ɕׂ
+//temp : Ɨp(g͉Bt[g񂷂ƊmۂNȂ)
+//maxThreads : gXbh̏(0ȂWorkerPoolS)
+void ParallelRadixSort(std::vector<SortKeyEntry>& entries,
+                       std::vector<SortKeyEntry>& temp,
+                       int maxThreads = 0);
@@ -0,0 +1,229 @@
+#define NOMINMAX
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <windows.h>
+#include "RandomService.h"
+
+namespace
+{
+    constexpr uint64_t PCG_MULTIPLIER = 6364136223846793005ull;
+
+    //V[h̔ԍU炷(߂ԍłɂȂȂ悤)
+    inline uint64_t SplitMix64(uint64_t x)
+    {
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    //VXe̗ƃIuWFNg̗񂪏dȂȂ悤ɏʂŕ
+    constexpr uint64_t ENTITY_STREAM_TAG = 1ull << 32;
+
+    //IuWFNg̗͉̖ڂԍ
+    inline uint64_t MakeStreamId(int system, uint64_t index)
+    {
+        return SplitMix64((static_cast<uint64_t>(system) << 40) ^ index);
+    }
+}
+
+uint64_t RandomService::m_sessionSeed = 0;
+uint64_t RandomService::m_entityCounts[RandomService::MAX_RANDOM_SYSTEM] = {};
+RandomStream RandomService::m_shared[RandomService::MAX_RANDOM_SYSTEM];
+
+//-----------------------RandomStream-----------------------
+void RandomStream::Seed(uint64_t seed, uint64_t stream)
+{
+    //PCG32 ̌܂(inc ͊ɂ)
+    m_state = 0;
+    m_inc = (stream << 1) | 1u;
+    Next();
+    m_state += seed;
+    Next();
+}
+
+uint32_t RandomStream::Next()
+{
+    const uint64_t old = m_state;
+    m_state = old * PCG_MULTIPLIER + m_inc;
+
+    const uint32_t xorShifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+    const uint32_t rot = static_cast<uint32_t>(old >> 59);
+    return (xorShifted >> rot) | (xorShifted << ((0u - rot) & 31));
+}
+
+int RandomStream::RangeInt(int min, int max)
+{
+    if (max <= min)
+    {
+        return min;
+    }
+
+    //32bit ̗ɕ|ʂgBʂ臒l̎
+    const uint32_t range = static_cast<uint32_t>(static_cast<int64_t>(max) - min);
+    uint64_t m = static_cast<uint64_t>(Next()) * range;
+    uint32_t low = static_cast<uint32_t>(m);
+    if (low < range)
+    {
+        const uint32_t threshold = (0u - range) % range;
+        while (low < threshold)
+        {
+            m = static_cast<uint64_t>(Next()) * range;
+            low = static_cast<uint32_t>(m);
+        }
+    }
+    return static_cast<int>(static_cast<int64_t>(min) + static_cast<int64_t>(m >> 32));
+}
+
+RandomStream RandomStream::Split()
+{
+    const uint64_t seed = (static_cast<uint64_t>(Next()) << 32) | Next();
+    return RandomStream(seed, SplitMix64(seed ^ m_inc));
+}
+
+//-----------------------RandomService-----------------------
+void RandomService::Init(uint64_t seed)
+{
+    if (seed == 0)
+    {
+        std::random_device rd;
+        seed = (static_cast<uint64_t>(rd()) << 32) | rd();
+        if (seed == 0)
+        {
+            seed = 1;
+        }
+    }
+    m_sessionSeed = seed;
+
+    for (int i = 0; i < MAX_RANDOM_SYSTEM; ++i)
+    {
+        m_shared[i] = CreateSystemStream(static_cast<RANDOM_SYSTEM>(i));
+    }
+    ResetEntities();
+
+    char buf[64];
+    sprintf_s(buf, "RandomService: session seed %llu\n", static_cast<unsigned long long>(m_sessionSeed));
+    OutputDebugStringA(buf);
+}
+
+void RandomService::ResetEntities()
+{
+    for (uint64_t& count : m_entityCounts)
+    {
+        count = 0;
+    }
+}
+
+RandomStream RandomService::CreateSystemStream(RANDOM_SYSTEM system)
+{
+    return RandomStream(m_sessionSeed, MakeStreamId(system, 0));
+}
+
+RandomStream RandomService::CreateEntityStream(RANDOM_SYSTEM system)
+{
+    const uint64_t index = ENTITY_STREAM_TAG + m_entityCounts[system]++;
+    return RandomStream(m_sessionSeed, MakeStreamId(system, index));
+}
+
+void RandomService::RunRandomBenchmark(std::vector<std::string>& outLines)
+{
+    const int draws = 10000000;
+
+    char buf[256];
+    sprintf_s(buf, "Random benchmark (%d draws, ns / draw)", draws);
+    outLines.push_back(buf);
+
+    sprintf_s(buf, "  state size : mt19937 %zu bytes, mt19937_64 %zu bytes, PCG32 %zu bytes",
+        sizeof(std::mt19937), sizeof(std::mt19937_64), sizeof(RandomStream));
+    outLines.push_back(buf);
+
+    auto toNs = [draws](std::chrono::high_resolution_clock::time_point start)
+    {
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::nano>(end - start).count() / draws;
+    };
+
+    //ʂ̂ĂȂ悤ɑĂ
+    double sink = 0.0;
+
+    //float ͈̔(BuildingSpawner ̒uꏊƓgBdistribution ͖)
+    {
+        std::mt19937_64 mt(12345);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < draws; ++i)
+        {
+            std::uniform_real_distribution<float> d(-200.0f, 200.0f);
+            sink += d(mt);
+        }
+        const double mtNs = toNs(start);
+
+        RandomStream rng(12345, 0);
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < draws; ++i)
+        {
+            sink += rng.Range(-200.0f, 200.0f);
+        }
+        const double pcgNs = toNs(start);
+
+        sprintf_s(buf, "  float range : mt19937_64 %.2f, PCG32 %.2f (x%.1f)", mtNs, pcgNs, mtNs / std::max(pcgNs, 1e-6));
+        outLines.push_back(buf);
+    }
+
+    //int ͈̔(EnemySpawner ̃[gIтƓg)
+    {
+        std::mt19937 mt(12345);
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < draws; ++i)
+        {
+            std::uniform_int_distribution<int> d(0, 4);
+            sink += d(mt);
+        }
+        const double mtNs = toNs(start);
+
+        RandomStream rng(12345, 0);
+        start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < draws; ++i)
+        {
+            sink += rng.RangeInt(0, 5);
+        }
+        const double pcgNs = toNs(start);
+
+        sprintf_s(buf, "  int range   : mt19937 %.2f, PCG32 %.2f (x%.1f)", mtNs, pcgNs, mtNs / std::max(pcgNs, 1e-6));
+        outLines.push_back(buf);
+    }
+
+    //V[h瓯񂪏o邩ÃׂIuWFNg̗񂪏dȂȂ
+    {
+        const uint64_t seed = m_sessionSeed;
+        uint64_t counts[MAX_RANDOM_SYSTEM];
+        std::copy(std::begin(m_entityCounts), std::end(m_entityCounts), counts);
+
+        m_sessionSeed = 42;
+        ResetEntities();
+        RandomStream a = CreateEntityStream(RANDOM_SYSTEM_ROUTE);
+        RandomStream b = CreateEntityStream(RANDOM_SYSTEM_ROUTE);
+        ResetEntities();
+        RandomStream a2 = CreateEntityStream(RANDOM_SYSTEM_ROUTE);
+
+        int same = 0;
+        int collide = 0;
+        for (int i = 0; i < 1000; ++i)
+        {
+            const uint32_t va = a.Next();
+            same += (va == a2.Next()) ? 1 : 0;
+            collide += (va == b.Next()) ? 1 : 0;
+        }
+
+        m_sessionSeed = seed;
+        std::copy(std::begin(counts), std::end(counts), m_entityCounts);
+
+        sprintf_s(buf, "  determinism : replay %d / 1000 same, neighbour stream %d / 1000 same", same, collide);
+        outLines.push_back(buf);
+    }
+
+    sprintf_s(buf, "  (checksum %.1f)", sink);
+    outLines.push_back(buf);
+}
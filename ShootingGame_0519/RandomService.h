@@ -0,0 +1,88 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+
+//---------------------------------------------------------
+// ̗(PCG32 XSH-RR)
+// Ԃ 16 oCg(std::mt19937 ͖ 5KB)Ȃ̂œG1̂ɎĂ悢
+// ͈̗͂ uniform_*_distribution 炸ɂ̏ŏo
+//---------------------------------------------------------
+class RandomStream
+{
+public:
+    RandomStream() { Seed(0, 0); }
+    RandomStream(uint64_t seed, uint64_t stream) { Seed(seed, stream); }
+
+    //stream ႦΓ seed łʂ̗ɂȂ
+    void Seed(uint64_t seed, uint64_t stream);
+
+    uint32_t Next();
+
+    //[0, 1)
+    float NextFloat() { return static_cast<float>(Next() >> 8) * (1.0f / 16777216.0f); }
+
+    //[min, max)
+    float Range(float min, float max) { return min + (max - min) * NextFloat(); }
+
+    //[min, max)(΂̖ Lemire ̕@Bmax <= min Ȃ min)
+    int RangeInt(int min, int max);
+
+    //probability ̊m true
+    bool Chance(float probability) { return NextFloat() < probability; }
+
+    //̗񂩂Ɨq̗(e2i)
+    RandomStream Split();
+
+private:
+    uint64_t m_state = 0;
+    uint64_t m_inc = 1;
+};
+
+//---------------------------------------------------------
+// ̌
+// 1̃ZbVV[hAVXeƁEIuWFNgƂ̗؂o
+// EVXe̗ (V[h, VXe) Ō܂(蒼Ă)
+// EIuWFNg̗̓VXeōԂŌ܂(ResetEntities Ő)
+// V[hȂ瓯ԂœôŁAwbhX̎sČł
+//---------------------------------------------------------
+class RandomService
+{
+public:
+    enum RANDOM_SYSTEM
+    {
+        RANDOM_SYSTEM_ENEMY_SPAWN,
+        RANDOM_SYSTEM_BUILDING,
+        RANDOM_SYSTEM_ROUTE,
+        RANDOM_SYSTEM_PLAYER,
+        RANDOM_SYSTEM_AI,
+
+        MAX_RANDOM_SYSTEM
+    };
+
+    //seed  0 Ȃ random_device 猈߂(߂V[h̓fobOo͂ɏo)
+    static void Init(uint64_t seed = 0);
+
+    //IuWFNg̗̔ԍ 0 ɖ߂(V[̏ŌĂ)
+    static void ResetEntities();
+
+    //VXe̗V(Spawner ȂǂŎ)
+    static RandomStream CreateSystemStream(RANDOM_SYSTEM system);
+
+    //IuWFNg1̗
+    static RandomStream CreateEntityStream(RANDOM_SYSTEM system);
+
+    //VXeŋL(̂ȂƂŎg)
+    static RandomStream& GetSharedStream(RANDOM_SYSTEM system) { return m_shared[system]; }
+
+    //--------Get֐-------
+    static uint64_t GetSessionSeed() { return m_sessionSeed; }
+
+    //mt19937 + distribution Ɣׂ(DebugBenchmark ɓo^)
+    static void RunRandomBenchmark(std::vector<std::string>& outLines);
+
+private:
+    static uint64_t m_sessionSeed;
+    static uint64_t m_entityCounts[MAX_RANDOM_SYSTEM];
+    static RandomStream m_shared[MAX_RANDOM_SYSTEM];
+};
@@ -0,0 +1,43 @@
+#include "RenderBackend.h"
+
+const char* RenderBackend::GetCommandName(RENDER_COMMAND command)
+{
+    switch (command)
+    {
+    case RC_BEGIN_FRAME:         return "BeginFrame";
+    case RC_END_FRAME:           return "EndFrame";
+    case RC_SET_SHADERS:         return "SetShaders";
+    case RC_SET_BLEND:           return "SetBlend";
+    case RC_SET_DEPTH:           return "SetDepth";
+    case RC_SET_CULLING:         return "SetCulling";
+    case RC_SET_GEOMETRY:        return "SetGeometry";
+    case RC_SET_INSTANCE_BUFFER: return "SetInstanceBuffer";
+    case RC_SET_TEXTURE:         return "SetTexture";
+    case RC_SET_MATERIAL:        return "SetMaterial";
+    case RC_SET_WORLD:           return "SetWorld";
+    case RC_SET_VIEW:            return "SetView";
+    case RC_SET_PROJECTION:      return "SetProjection";
+    case RC_DRAW_INDEXED:        return "DrawIndexed";
+    case RC_DRAW_INSTANCED:      return "DrawIndexedInstanced";
+    case RC_DRAW_TEXTURE:        return "DrawTexture";
+    case RC_DRAW_BILLBOARD:      return "DrawBillboard";
+    default:                     return "Unknown";
+    }
+}
+
+void RenderBackend::CloseFrameStats()
+{
+    m_stats.frames = 1;
+
+    for (int i = 0; i < MAX_RENDER_COMMAND; ++i)
+    {
+        m_totalStats.commands[i] += m_stats.commands[i];
+    }
+    m_totalStats.drawCalls += m_stats.drawCalls;
+    m_totalStats.instances += m_stats.instances;
+    m_totalStats.triangles += m_stats.triangles;
+    m_totalStats.frames++;
+
+    m_lastStats = m_stats;
+    m_stats = RenderBackendStats{};
+}
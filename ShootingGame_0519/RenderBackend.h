@@ -0,0 +1,143 @@
+#pragma once
+#include <cstdint>
+#include <SimpleMath.h>
+#include "commontypes.h"
+
+struct MATERIAL;
+
+//D3D ̃C^[tF[X͎󂯓nȂ̂őO錾ɂ
+//(wbhX̃obNGh d3d11.h Ńrhł)
+struct ID3D11Buffer;
+struct ID3D11ShaderResourceView;
+struct ID3D11VertexShader;
+struct ID3D11PixelShader;
+struct ID3D11InputLayout;
+
+//---------------------------------------------------------
+// `R}h̔s̃C^[tF[X
+// RenderQueue / InstancedRenderer / Renderer ̕`֐͂ʂĔs
+//  D3D11RenderBackendBwbhXsł GPU Ȃ
+// NullRenderBackend / RecordingRenderBackend ɍւ
+//---------------------------------------------------------
+
+//`R}h̎(vEL^p)
+enum RENDER_COMMAND
+{
+    RC_BEGIN_FRAME = 0,
+    RC_END_FRAME,
+    RC_SET_SHADERS,
+    RC_SET_BLEND,
+    RC_SET_DEPTH,
+    RC_SET_CULLING,
+    RC_SET_GEOMETRY,
+    RC_SET_INSTANCE_BUFFER,
+    RC_SET_TEXTURE,
+    RC_SET_MATERIAL,
+    RC_SET_WORLD,
+    RC_SET_VIEW,
+    RC_SET_PROJECTION,
+    RC_DRAW_INDEXED,
+    RC_DRAW_INSTANCED,
+    RC_DRAW_TEXTURE,
+    RC_DRAW_BILLBOARD,
+    MAX_RENDER_COMMAND
+};
+
+//CfbNXobt@̌`(D3D11RenderBackend  DXGI_FORMAT ɒ)
+enum RENDER_INDEX_FORMAT
+{
+    RIF_UNKNOWN = 0,
+    RIF_UINT16,
+    RIF_UINT32,
+};
+
+//v~eBu̎(D3D11RenderBackend  D3D11_PRIMITIVE_TOPOLOGY ɒ)
+enum RENDER_TOPOLOGY
+{
+    RT_UNDEFINED = 0,
+    RT_TRIANGLE_LIST,
+    RT_TRIANGLE_STRIP,
+    RT_LINE_LIST,
+};
+
+//obNGh󂯎R}h̏Wv
+struct RenderBackendStats
+{
+    int commands[MAX_RENDER_COMMAND]{};
+    int drawCalls = 0;          //DrawIndexed / DrawIndexedInstanced / DrawTexture / DrawBillboard ̍v
+    int instances = 0;          //`CX^X(ʏ̕`1)
+    int triangles = 0;          //`Op`̐(2DEr{[h͎lp`1)
+    int frames = 0;
+};
+
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() = default;
+
+    //--------Get֐-------
+    virtual const char* GetName() const = 0;
+
+    //true Ȃ D3D foCXȂ(Renderer ̓obt@쐬Ȃ)
+    virtual bool IsHeadless() const = 0;
+
+    //-----------------------t[-----------------------
+    virtual void BeginFrame() = 0;
+    virtual void EndFrame() = 0;
+
+    //-----------------------Xe[g-----------------------
+    virtual void SetShaders(ID3D11VertexShader* vertexShader, ID3D11PixelShader* pixelShader, ID3D11InputLayout* inputLayout) = 0;
+    virtual void SetBlendState(int blendState) = 0;
+    virtual void SetDepthEnable(bool enable) = 0;
+    virtual void SetCulling(bool cullBack) = 0;
+
+    //Xbg0̒_obt@ECfbNXobt@(R16_UINT / R32_UINT)Eg|W[
+    virtual void SetGeometry(ID3D11Buffer* vertexBuffer, uint32_t stride, ID3D11Buffer* indexBuffer, RENDER_INDEX_FORMAT indexFormat, RENDER_TOPOLOGY topology) = 0;
+    //Xbg1̃CX^Xobt@(nullptr ŉ)
+    virtual void SetInstanceBuffer(ID3D11Buffer* instanceBuffer, uint32_t stride) = 0;
+
+    virtual void SetTexture(ID3D11ShaderResourceView* texture) = 0;
+    virtual void SetMaterial(const MATERIAL& material) = 0;
+    virtual void SetWorldMatrix(const Matrix4x4& world) = 0;
+    virtual void SetViewMatrix(const Matrix4x4& view) = 0;
+    virtual void SetProjectionMatrix(const Matrix4x4& projection) = 0;
+
+    //-----------------------`-----------------------
+    virtual void DrawIndexed(uint32_t indexCount) = 0;
+    virtual void DrawIndexedInstanced(uint32_t indexCount, uint32_t instanceCount, uint32_t startInstance) = 0;
+    virtual void DrawTexture(ID3D11ShaderResourceView* texture, const Vector2& position, const Vector2& size) = 0;
+    virtual void DrawBillboard(ID3D11ShaderResourceView* texture, const Vector3& worldPos, float size) = 0;
+
+    //-----------------------v-----------------------
+    const RenderBackendStats& GetStats() const { return m_lastStats; }       //Õt[
+    const RenderBackendStats& GetTotalStats() const { return m_totalStats; } //ResetStats ̍v
+    void ResetStats()
+    {
+        m_stats = RenderBackendStats{};
+        m_lastStats = RenderBackendStats{};
+        m_totalStats = RenderBackendStats{};
+    }
+
+    static const char* GetCommandName(RENDER_COMMAND command);
+
+protected:
+    //e̓R}h󂯎炱Ă
+    void Count(RENDER_COMMAND command)
+    {
+        m_stats.commands[command]++;
+    }
+
+    void CountDraw(uint32_t indexCount, uint32_t instanceCount)
+    {
+        m_stats.drawCalls++;
+        m_stats.instances += static_cast<int>(instanceCount);
+        m_stats.triangles += static_cast<int>(indexCount / 3 * instanceCount);
+    }
+
+    //EndFrame ŌĂ(̃t[̏Wvm肷)
+    void CloseFrameStats();
+
+    RenderBackendStats m_stats;
+    RenderBackendStats m_lastStats;
+    RenderBackendStats m_totalStats;
+};
@@ -0,0 +1,539 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include "RenderQueue.h"
+#include "WorkerPool.h"
+
+DrawPacketList RenderQueue::m_mainList;
+
+std::vector<const IDrawPacketSource*> RenderQueue::m_sources;
+std::vector<DrawPacketList> RenderQueue::m_jobLists;
+
+std::vector<DrawPacket>   RenderQueue::m_packets;
+std::vector<SortKeyEntry> RenderQueue::m_sortEntries;
+std::vector<SortKeyEntry> RenderQueue::m_sortTemp;
+
+RenderQueue::Stats RenderQueue::m_stats;
+RenderQueue::Stats RenderQueue::m_lastStats;
+
+namespace
+{
+    //\[gL[̊etB[h̃rbg
+    constexpr int PASS_BITS     = 2;
+    constexpr int SHADER_BITS   = 8;
+    constexpr int MATERIAL_BITS = 12;
+    constexpr int TEXTURE_BITS  = 12;
+    constexpr int DEPTH_BITS    = 16;
+
+    //̋艜͓[xƂĈ
+    constexpr float MAX_SORT_DEPTH = 2000.0f;
+
+    //1WuŎ󂯎 IDrawPacketSource ̐
+    constexpr size_t SOURCES_PER_JOB = 256;
+
+    uint64_t Mask(uint32_t value, int bits)
+    {
+        return static_cast<uint64_t>(value) & ((1ull << bits) - 1);
+    }
+
+    //|C^\[gL[pID
+    //([J[XbhĂԂ̂ŕ\nbVɂBՓ˂Ăяς邾)
+    uint32_t GetObjectId(const void* ptr)
+    {
+        if (!ptr) { return 0; }
+
+        uint64_t v = reinterpret_cast<uintptr_t>(ptr) >> 4;
+        v *= 0x9E3779B97F4A7C15ull;
+        return static_cast<uint32_t>(v >> 40) | 1;
+    }
+
+    //}eA̒gID
+    uint32_t GetMaterialId(const MATERIAL& material)
+    {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&material);
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < sizeof(MATERIAL); ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 16777619u;
+        }
+        return hash ^ (hash >> MATERIAL_BITS) ^ (hash >> (MATERIAL_BITS * 2));
+    }
+
+    float ElapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        auto now = std::chrono::steady_clock::now();
+        return std::chrono::duration<float, std::milli>(now - start).count();
+    }
+}
+
+int RenderQueue::Stats::TotalChanges() const
+{
+    int total = 0;
+    for (int i = 0; i < MAX_STATE; ++i) { total += changes[i]; }
+    return total;
+}
+
+int RenderQueue::Stats::TotalSkipped() const
+{
+    int total = 0;
+    for (int i = 0; i < MAX_STATE; ++i) { total += skipped[i]; }
+    return total;
+}
+
+uint64_t RenderQueue::MakeSortKey(RENDER_PASS pass, bool isTransparent,
+                                  uint32_t shaderId, uint32_t materialId,
+                                  uint32_t textureId, float depth)
+{
+    //[x 0`1 ɐKėʎq
+    float d = std::clamp(depth / MAX_SORT_DEPTH, 0.0f, 1.0f);
+    uint32_t depthBits = static_cast<uint32_t>(d * static_cast<float>((1u << DEPTH_BITS) - 1));
+
+    uint64_t key = Mask(pass, PASS_BITS);
+    key = (key << 1) | (isTransparent ? 1 : 0);
+
+    if (!isTransparent)
+    {
+        //s : Ԃł܂Ƃ߁AԂ͎̒O(ZŎ̂Ă₷)
+        key = (key << SHADER_BITS)   | Mask(shaderId, SHADER_BITS);
+        key = (key << MATERIAL_BITS) | Mask(materialId, MATERIAL_BITS);
+        key = (key << TEXTURE_BITS)  | Mask(textureId, TEXTURE_BITS);
+        key = (key << DEPTH_BITS)    | Mask(depthBits, DEPTH_BITS);
+    }
+    else
+    {
+        // : dȂ悤`̂ŗD
+        uint32_t backToFront = ((1u << DEPTH_BITS) - 1) - depthBits;
+        key = (key << DEPTH_BITS)    | Mask(backToFront, DEPTH_BITS);
+        key = (key << SHADER_BITS)   | Mask(shaderId, SHADER_BITS);
+        key = (key << MATERIAL_BITS) | Mask(materialId, MATERIAL_BITS);
+        key = (key << TEXTURE_BITS)  | Mask(textureId, TEXTURE_BITS);
+    }
+
+    //c̉ʃrbg0̂܂(̊gp)
+    const int usedBits = PASS_BITS + 1 + SHADER_BITS + MATERIAL_BITS + TEXTURE_BITS + DEPTH_BITS;
+    return key << (64 - usedBits);
+}
+
+void DrawPacketList::Add(const DrawPacket& packet, RENDER_PASS pass)
+{
+    if (packet.indexCount == 0) { return; }
+
+    //wbhXsł̓obt@Ȃ̂ŁAR}h
+    if (!Renderer::IsHeadless() && (!packet.vertexBuffer || !packet.indexBuffer)) { return; }
+
+    DrawPacket p = packet;
+    if (!p.vertexShader) { p.vertexShader = Renderer::m_vertexShader.Get(); }
+    if (!p.pixelShader)  { p.pixelShader = Renderer::m_pixelShader.Get(); }
+    if (!p.inputLayout)  { p.inputLayout = Renderer::m_inputLayout.Get(); }
+
+    //J̋(EnȂ̂Ńr[Ԃł -z O)
+    Vector3 viewPos = Vector3::Transform(p.world.Translation(), Renderer::m_cachedView);
+    float depth = -viewPos.z;
+
+    bool isTransparent = (p.blendState != BS_NONE) || (p.material.Diffuse.w < 1.0f);
+    if (isTransparent && p.blendState == BS_NONE)
+    {
+        p.blendState = BS_ALPHABLEND;
+    }
+
+    uint32_t shaderId = GetObjectId(p.vertexShader) ^ (GetObjectId(p.pixelShader) << 4);
+
+    m_keys.push_back(RenderQueue::MakeSortKey(pass, isTransparent, shaderId,
+                                              GetMaterialId(p.material), GetObjectId(p.texture), depth));
+    m_packets.push_back(p);
+}
+
+void RenderQueue::Submit(const DrawPacket& packet, RENDER_PASS pass)
+{
+    m_mainList.Add(packet, pass);
+}
+
+void RenderQueue::AddSource(const IDrawPacketSource* source)
+{
+    if (!source) { return; }
+
+    m_sources.push_back(source);
+}
+
+void RenderQueue::Execute(const DrawPacket& packet, StateCache& cache)
+{
+    RenderBackend* backend = Renderer::GetBackend();
+
+    //-----------------------VF[_[-----------------------
+    if (packet.vertexShader != cache.vertexShader ||
+        packet.pixelShader != cache.pixelShader ||
+        packet.inputLayout != cache.inputLayout)
+    {
+        backend->SetShaders(packet.vertexShader, packet.pixelShader, packet.inputLayout);
+        cache.vertexShader = packet.vertexShader;
+        cache.pixelShader = packet.pixelShader;
+        cache.inputLayout = packet.inputLayout;
+        m_stats.changes[STATE_SHADER]++;
+    }
+    else
+    {
+        m_stats.skipped[STATE_SHADER]++;
+    }
+
+    //-----------------------Xe[g-----------------------
+    if (packet.blendState != cache.blendState)
+    {
+        backend->SetBlendState(packet.blendState);
+        cache.blendState = packet.blendState;
+        m_stats.changes[STATE_BLEND]++;
+    }
+    else
+    {
+        m_stats.skipped[STATE_BLEND]++;
+    }
+
+    if (static_cast<int>(packet.depthEnable) != cache.depthEnable)
+    {
+        backend->SetDepthEnable(packet.depthEnable);
+        cache.depthEnable = packet.depthEnable;
+        m_stats.changes[STATE_DEPTH]++;
+    }
+    else
+    {
+        m_stats.skipped[STATE_DEPTH]++;
+    }
+
+    if (static_cast<int>(packet.cullBack) != cache.cullBack)
+    {
+        backend->SetCulling(packet.cullBack);
+        cache.cullBack = packet.cullBack;
+        m_stats.changes[STATE_RASTERIZER]++;
+    }
+    else
+    {
+        m_stats.skipped[STATE_RASTERIZER]++;
+    }
+
+    //-----------------------WIg-----------------------
+    if (packet.vertexBuffer != cache.vertexBuffer ||
+        packet.stride != cache.stride ||
+        packet.indexBuffer != cache.indexBuffer ||
+        packet.indexFormat != cache.indexFormat ||
+        packet.topology != cache.topology)
+    {
+        backend->SetGeometry(packet.vertexBuffer, packet.stride, packet.indexBuffer, packet.indexFormat, packet.topology);
+        cache.vertexBuffer = packet.vertexBuffer;
+        cache.stride = packet.stride;
+        cache.indexBuffer = packet.indexBuffer;
+        cache.indexFormat = packet.indexFormat;
+        cache.topology = packet.topology;
+        m_stats.changes[STATE_GEOMETRY]++;
+    }
+    else
+    {
+        m_stats.skipped[STATE_GEOMETRY]++;
+    }
+
+    //-----------------------eNX`E}eA-----------------------
+    if (!cache.hasTexture || packet.texture != cache.texture)
+    {
+        backend->SetTexture(packet.texture);
+        cache.texture = packet.texture;
+        cache.hasTexture = true;
+        m_stats.changes[STATE_TEXTURE]++;
+    }
+    else
+    {
+        m_stats.skipped[STATE_TEXTURE]++;
+    }
+
+    if (!cache.hasMaterial || memcmp(&packet.material, &cache.material, sizeof(MATERIAL)) != 0)
+    {
+        backend->SetMaterial(packet.material);
+        cache.material = packet.material;
+        cache.hasMaterial = true;
+        m_stats.changes[STATE_MATERIAL]++;
+    }
+    else
+    {
+        m_stats.skipped[STATE_MATERIAL]++;
+    }
+
+    if (!cache.hasWorld || memcmp(&packet.world, &cache.world, sizeof(Matrix4x4)) != 0)
+    {
+        backend->SetWorldMatrix(packet.world);
+        cache.world = packet.world;
+        cache.hasWorld = true;
+        m_stats.changes[STATE_WORLD]++;
+    }
+    else
+    {
+        m_stats.skipped[STATE_WORLD]++;
+    }
+
+    backend->DrawIndexed(packet.indexCount);
+    m_stats.drawCalls++;
+}
+
+void RenderQueue::BuildDrawList(int maxThreads)
+{
+    int threads = WorkerPool::GetThreadCount();
+    if (maxThreads > 0) { threads = std::min(threads, maxThreads); }
+    m_stats.threads = threads;
+    m_stats.sources += static_cast<int>(m_sources.size());
+
+    auto buildStart = std::chrono::steady_clock::now();
+
+    //-----------------------(JOp)-----------------------
+    DrawBuildContext context;
+    DirectX::BoundingFrustum::CreateFromMatrix(context.frustum, Renderer::m_cachedProjection);
+    context.frustum.Transform(context.frustum, Renderer::m_cachedView.Invert());
+
+    //-----------------------WuɃpPbg-----------------------
+    const size_t jobCount = (m_sources.size() + SOURCES_PER_JOB - 1) / SOURCES_PER_JOB;
+    if (m_jobLists.size() < jobCount)
+    {
+        m_jobLists.resize(jobCount);
+    }
+
+    WorkerPool::ParallelFor(jobCount, [&](size_t job, int)
+    {
+        DrawPacketList& list = m_jobLists[job];
+        list.Clear();
+
+        size_t begin = job * SOURCES_PER_JOB;
+        size_t end = std::min(begin + SOURCES_PER_JOB, m_sources.size());
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_sources[i]->BuildDrawPackets(context, list);
+        }
+    }, threads);
+
+    //-----------------------1̔zɌ-----------------------
+    //CXbh̕擪ɁAăWuɕׂ(L[Ȃo^ɂȂ)
+    std::vector<size_t> offsets(jobCount + 1);
+    size_t total = m_mainList.GetCount();
+    for (size_t j = 0; j < jobCount; ++j)
+    {
+        offsets[j] = total;
+        total += m_jobLists[j].GetCount();
+    }
+    offsets[jobCount] = total;
+
+    m_packets.resize(total);
+    m_sortEntries.resize(total);
+
+    auto copyList = [&](const DrawPacketList& list, size_t offset)
+    {
+        const auto& packets = list.GetPackets();
+        const auto& keys = list.GetKeys();
+        for (size_t i = 0; i < packets.size(); ++i)
+        {
+            m_packets[offset + i] = packets[i];
+            m_sortEntries[offset + i].key = keys[i];
+            m_sortEntries[offset + i].index = static_cast<uint32_t>(offset + i);
+        }
+    };
+
+    copyList(m_mainList, 0);
+
+    WorkerPool::ParallelFor(jobCount, [&](size_t job, int)
+    {
+        copyList(m_jobLists[job], offsets[job]);
+    }, threads);
+
+    m_stats.packets += static_cast<int>(total);
+    m_stats.buildMs += ElapsedMs(buildStart);
+
+    //-----------------------\[g-----------------------
+    auto sortStart = std::chrono::steady_clock::now();
+
+    ParallelRadixSort(m_sortEntries, m_sortTemp, threads);
+
+    m_stats.sortMs += ElapsedMs(sortStart);
+
+    m_mainList.Clear();
+    m_sources.clear();
+}
+
+void RenderQueue::Flush()
+{
+    if (m_mainList.GetCount() == 0 && m_sources.empty()) { return; }
+
+    BuildDrawList(0);
+
+    if (m_sortEntries.empty()) { return; }
+
+    //Flush̊Ԃɑ̕`悪܂Ă\̂ŁAŏ͕KZbg
+    StateCache cache;
+
+    for (const auto& entry : m_sortEntries)
+    {
+        Execute(m_packets[entry.index], cache);
+    }
+
+    //-----------------------ʏ`pɖ߂-----------------------
+    RenderBackend* backend = Renderer::GetBackend();
+    backend->SetShaders(Renderer::m_vertexShader.Get(), Renderer::m_pixelShader.Get(), Renderer::m_inputLayout.Get());
+    backend->SetBlendState(BS_NONE);
+    backend->SetDepthEnable(true);
+
+    m_packets.clear();
+    m_sortEntries.clear();
+}
+
+namespace
+{
+    //x`}[Np̃_~[IuWFNg(GPU\[X͎Ȃ)
+    class BenchmarkSource : public IDrawPacketSource
+    {
+    public:
+        SRT transform;
+        ID3D11Buffer* vertexBuffer = nullptr;
+        ID3D11Buffer* indexBuffer = nullptr;
+        ID3D11ShaderResourceView* texture = nullptr;
+        MATERIAL material{};
+
+        void BuildDrawPackets(const DrawBuildContext& context, DrawPacketList& out) const override
+        {
+            Matrix4x4 world = transform.GetMatrix();
+
+            DirectX::BoundingSphere bounds(world.Translation(), transform.scale.x);
+            if (context.frustum.Contains(bounds) == DirectX::DISJOINT) { return; }
+
+            DrawPacket packet;
+            packet.vertexBuffer = vertexBuffer;
+            packet.stride = sizeof(VERTEX_3D);
+            packet.indexBuffer = indexBuffer;
+            packet.indexCount = 36;
+            packet.material = material;
+            packet.texture = texture;
+            packet.world = world;
+            out.Add(packet);
+        }
+    };
+}
+
+void RenderQueue::RunBuildBenchmark(std::vector<std::string>& outLines)
+{
+    const int objectCounts[] = { 10000, 30000, 60000 };
+    const int iterations = 5;
+
+    //`҂̃pPbg鎞͍̂ŎsȂ
+    if (m_mainList.GetCount() > 0 || !m_sources.empty())
+    {
+        outLines.push_back("DrawList build benchmark skipped (queue is not empty)");
+        return;
+    }
+
+    //ۂ̕`̓v󂳂Ȃ悤ɑޔ
+    Stats savedStats = m_stats;
+
+    //|C^̒lg_~[(QƂ͂Ȃ)
+    static int s_dummyResources[16];
+
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> posDist(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> rotDist(0.0f, 6.28f);
+
+    char buf[256];
+    sprintf_s(buf, "DrawList build benchmark (pool threads=%d, best of %d)", WorkerPool::GetThreadCount(), iterations);
+    outLines.push_back(buf);
+
+    for (int objectCount : objectCounts)
+    {
+        std::vector<BenchmarkSource> sources(objectCount);
+        for (int i = 0; i < objectCount; ++i)
+        {
+            BenchmarkSource& src = sources[i];
+            src.transform.pos = { posDist(rng), posDist(rng) * 0.1f, posDist(rng) };
+            src.transform.rot = { 0.0f, rotDist(rng), 0.0f };
+            src.transform.scale = { 2.0f, 2.0f, 2.0f };
+            src.vertexBuffer = reinterpret_cast<ID3D11Buffer*>(&s_dummyResources[i % 4]);
+            src.indexBuffer = reinterpret_cast<ID3D11Buffer*>(&s_dummyResources[4 + i % 4]);
+            src.texture = reinterpret_cast<ID3D11ShaderResourceView*>(&s_dummyResources[8 + i % 8]);
+            src.material.Diffuse = Color(1.0f, 1.0f, 1.0f, (i % 10 == 0) ? 0.5f : 1.0f);
+        }
+
+        //1,2,4... ƃv[Ŝ̃Xbhő
+        std::vector<int> threadCounts;
+        for (int t = 1; t < WorkerPool::GetThreadCount(); t *= 2)
+        {
+            threadCounts.push_back(t);
+        }
+        threadCounts.push_back(WorkerPool::GetThreadCount());
+
+        for (int threads : threadCounts)
+        {
+            float bestBuild = 0.0f;
+            float bestSort = 0.0f;
+            int packets = 0;
+
+            for (int it = 0; it < iterations; ++it)
+            {
+                m_stats = Stats{};
+                for (const auto& src : sources)
+                {
+                    m_sources.push_back(&src);
+                }
+
+                BuildDrawList(threads);
+
+                if (it == 0 || m_stats.buildMs + m_stats.sortMs < bestBuild + bestSort)
+                {
+                    bestBuild = m_stats.buildMs;
+                    bestSort = m_stats.sortMs;
+                }
+                packets = m_stats.packets;
+
+                m_packets.clear();
+                m_sortEntries.clear();
+            }
+
+            sprintf_s(buf, "  objects=%6d threads=%2d packets=%6d build=%7.3fms sort=%7.3fms total=%7.3fms",
+                objectCount, threads, packets, bestBuild, bestSort, bestBuild + bestSort);
+            outLines.push_back(buf);
+        }
+    }
+
+    m_stats = savedStats;
+
+    //x`}[Npɖc񂾍Ɨ̈
+    std::vector<DrawPacketList>().swap(m_jobLists);
+    std::vector<DrawPacket>().swap(m_packets);
+    std::vector<SortKeyEntry>().swap(m_sortEntries);
+    std::vector<SortKeyEntry>().swap(m_sortTemp);
+
+    for (const auto& line : outLines)
+    {
+        OutputDebugStringA((line + "\n").c_str());
+    }
+}
+
+void RenderQueue::EndFrame()
+{
+    m_lastStats = m_stats;
+    m_stats = Stats{};
+}
+
+void RenderQueue::Clear()
+{
+    m_mainList.Clear();
+    m_sources.clear();
+    m_jobLists.clear();
+    m_packets.clear();
+    m_sortEntries.clear();
+    m_sortTemp.clear();
+    m_stats = Stats{};
+    m_lastStats = Stats{};
+}
+
+const char* RenderQueue::GetStateName(int type)
+{
+    static const char* names[MAX_STATE] =
+    {
+        "Shader", "Blend", "Depth", "Rasterizer", "Geometry", "Texture", "Material", "World"
+    };
+
+    if (type < 0 || type >= MAX_STATE) { return "Unknown"; }
+    return names[type];
+}
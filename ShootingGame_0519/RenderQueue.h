@@ -0,0 +1,183 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <string>
+#include <d3d11.h>
+#include "renderer.h"
+#include "RadixSort.h"
+#include "IDrawPacketSource.h"
+
+//---------------------------------------------------------
+// `pPbg𗭂߂ă\[gL[ɕ`悷L[
+// eR|[lg͎ŏԂZbgɃpPbg Submit A
+// Flush ł܂Ƃ߂ĕ`悷BOƓԂ̓ZbgȂ
+// IDrawPacketSource o^ĂƁApPbg쐬ƃ\[g
+// WorkerPool ŕɍsAD3D ւ̔sCXbhōs
+//---------------------------------------------------------
+
+//`pX(\[gL[̍ŏ)
+enum RENDER_PASS
+{
+    RENDER_PASS_WORLD = 0,    //ʏ3D`
+    RENDER_PASS_OVERLAY,      //[ȟɕ`
+    MAX_RENDER_PASS
+};
+
+//`1񕪂̏
+struct DrawPacket
+{
+    //VF[_[(nullptrȂ Renderer ̕WVF[_[)
+    ID3D11VertexShader* vertexShader = nullptr;
+    ID3D11PixelShader*  pixelShader = nullptr;
+    ID3D11InputLayout*  inputLayout = nullptr;
+
+    //WIg
+    ID3D11Buffer* vertexBuffer = nullptr;
+    UINT          stride = 0;
+    ID3D11Buffer* indexBuffer = nullptr;
+    RENDER_INDEX_FORMAT indexFormat = RIF_UINT32;
+    UINT          indexCount = 0;
+    RENDER_TOPOLOGY topology = RT_TRIANGLE_LIST;
+
+    //}eAEeNX`
+    MATERIAL material{};
+    ID3D11ShaderResourceView* texture = nullptr;
+
+    //Xe[g
+    int  blendState = BS_NONE;
+    bool depthEnable = true;
+    bool cullBack = false;     //̕`ɍ킹Ċ̓JO
+
+    Matrix4x4 world;
+};
+
+//pPbgƃ\[gL[̈ꎞXg(XbhEWuɎ)
+class DrawPacketList
+{
+public:
+    //pPbgǉ(\[gL[͂ŌvZ)
+    void Add(const DrawPacket& packet, RENDER_PASS pass = RENDER_PASS_WORLD);
+
+    void Clear()
+    {
+        m_packets.clear();
+        m_keys.clear();
+    }
+
+    //--------Get֐-------
+    size_t GetCount() const { return m_packets.size(); }
+    const std::vector<DrawPacket>& GetPackets() const { return m_packets; }
+    const std::vector<uint64_t>& GetKeys() const { return m_keys; }
+
+private:
+    std::vector<DrawPacket> m_packets;
+    std::vector<uint64_t>   m_keys;
+};
+
+class RenderQueue
+{
+public:
+    //ԕύX̎
+    enum StateType
+    {
+        STATE_SHADER = 0,   //VS/PS/̓CAEg
+        STATE_BLEND,
+        STATE_DEPTH,
+        STATE_RASTERIZER,
+        STATE_GEOMETRY,     //VB/IB/g|W
+        STATE_TEXTURE,
+        STATE_MATERIAL,
+        STATE_WORLD,
+        MAX_STATE
+    };
+
+    //1t[̓v
+    struct Stats
+    {
+        int packets = 0;                //Submitꂽ
+        int sources = 0;                //o^ꂽ IDrawPacketSource ̐
+        int drawCalls = 0;              //DrawIndexed̉
+        int threads = 0;                //Xg쐬ɎgXbh
+        float buildMs = 0.0f;           //pPbg쐬ɂ
+        float sortMs = 0.0f;            //\[gɂ
+        int changes[MAX_STATE] = {};    //ۂɃZbg
+        int skipped[MAX_STATE] = {};    //OƓ̂ŏȂ
+
+        int TotalChanges() const;
+        int TotalSkipped() const;
+    };
+
+    //\[gL[
+    //ʂ pass(2) / (1) / c͕sƔŕтႤ
+    //  s : shader(8) / material(12) / texture(12) / depth(16, O)
+    //   : depth(16, ) / shader(8) / material(12) / texture(12)
+    static uint64_t MakeSortKey(RENDER_PASS pass, bool isTransparent,
+                                uint32_t shaderId, uint32_t materialId,
+                                uint32_t textureId, float depth);
+
+    //pPbgo^(\[gL[͂ŌvZ)
+    static void Submit(const DrawPacket& packet, RENDER_PASS pass = RENDER_PASS_WORLD);
+
+    //pPbgIuWFNgo^(Flush ̒ŕ BuildDrawPackets Ă)
+    static void AddSource(const IDrawPacketSource* source);
+
+    //܂pPbg\[gĕ`悷
+    static void Flush();
+
+    //`惊Xg쐬̃x`}[N(IuWFNg~Xbh̍쐬E\[g)
+    static void RunBuildBenchmark(std::vector<std::string>& outLines);
+
+    //t[̓vm肳(Game::GameDraw ̍ŌɌĂ)
+    static void EndFrame();
+
+    static void Clear();
+
+    //--------Get֐-------
+    static const Stats& GetStats() { return m_lastStats; }
+
+    static const char* GetStateName(int type);
+
+private:
+    //OɃZbg
+    struct StateCache
+    {
+        ID3D11VertexShader* vertexShader = nullptr;
+        ID3D11PixelShader*  pixelShader = nullptr;
+        ID3D11InputLayout*  inputLayout = nullptr;
+        ID3D11Buffer* vertexBuffer = nullptr;
+        UINT          stride = 0;
+        ID3D11Buffer* indexBuffer = nullptr;
+        RENDER_INDEX_FORMAT indexFormat = RIF_UNKNOWN;
+        RENDER_TOPOLOGY topology = RT_UNDEFINED;
+        ID3D11ShaderResourceView* texture = nullptr;
+        MATERIAL material{};
+        Matrix4x4 world;
+        int  blendState = -1;
+        int  depthEnable = -1;
+        int  cullBack = -1;
+        bool hasMaterial = false;
+        bool hasWorld = false;
+        bool hasTexture = false;
+    };
+
+    //D3D ɐGȂ(pPbg쐬EE\[g)
+    //maxThreads : gXbh̏(0ȂWorkerPoolS)
+    static void BuildDrawList(int maxThreads);
+
+    static void Execute(const DrawPacket& packet, StateCache& cache);
+
+    //CXbh Submit ꂽpPbg
+    static DrawPacketList m_mainList;
+
+    //쐬p
+    static std::vector<const IDrawPacketSource*> m_sources;
+    static std::vector<DrawPacketList> m_jobLists;
+
+    //E\[g
+    static std::vector<DrawPacket>   m_packets;
+    static std::vector<SortKeyEntry> m_sortEntries;
+    static std::vector<SortKeyEntry> m_sortTemp;
+
+    static Stats m_stats;
+    static Stats m_lastStats;
+};
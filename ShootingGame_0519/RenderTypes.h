@@ -0,0 +1,116 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <DirectXMath.h>
+#include "CommonTypes.h"
+
+//---------------------------------------------------------
+// _E}eAECgȂǁA`Ŏgf̃f[^
+// D3D ̌^܂܂Ȃ̂ŁAGPU gȂwbhX̃obNGhǂ߂
+// (Renderer g renderer.h ǂ܂)
+//---------------------------------------------------------
+
+//{[̉eێ\
+struct WEIGHT
+{
+    std::string bonename;   //{[
+    std::string meshname;   //bV
+    float weight;           //EFCgl
+    int vertexindex;        //_CfbNX
+};
+
+//{[\́iDXΉŁj
+struct BONE
+{
+    std::string bonename;          //{[
+    std::string meshname;          //bV
+    std::string armaturename;      //A[}`A
+    Matrix4x4 Matrix{};            //eq֌Wls
+    Matrix4x4 AnimationMatrix{};   //̕ό`݂̂ls
+    Matrix4x4 OffsetMatrix{};      //{[ItZbgs
+    int idx;                       //z񒆂̃CfbNX
+    std::vector<WEIGHT> weights;   //̃{[e^钸_ƃEFCgl̃Xg
+};
+
+
+//R_f[^i[\
+struct VERTEX_3D
+{
+    Vector3 Position;            //_̍W
+    Vector3 Normal;              //@xNg
+    Color Diffuse;               //gUːF
+    Vector2 TexCoord;            //eNX`W
+    int BoneIndex[4];            //{[CfbNXiő4j 20231225
+    float BoneWeight[4];         //e{[̃EFCgl 20231225
+    //std::string BoneName[4];     //e{[̖O 20231226
+    int bonecnt = 0;             //e^{[ 20231226
+};
+
+//{[gȂfpɋl߂_(VERTEX_3D  84 oCg  24 oCg)
+//VF[_[͂̂܂܂ŁA̓CAEǧ` float ɖ߂
+struct VERTEX_PACKED
+{
+    Vector3  Position;           //_̍W
+    uint32_t Normal;             //@xNg (R8G8B8A8_SNORM)
+    uint32_t Diffuse;            //gUːF (R8G8B8A8_UNORM)
+    uint16_t TexCoord[2];        //eNX`W (R16G16_FLOAT)
+};
+static_assert(sizeof(VERTEX_PACKED) == 24, "VERTEX_PACKED size mismatch");
+
+
+//}eAێ\
+struct MATERIAL
+{
+    Color Ambient;         //ArGgF
+    Color Diffuse;         //gUF
+    Color Specular;        //ʔːF
+    Color Emission;        //ȔF
+    float Shiness;         //x
+    int TextureEnable;     //eNX`gptO(HLSL  bool Ɠ4oCg)
+    float Dummy[2]{};      //\̈
+};
+
+//s̏ێ\
+struct LIGHT
+{
+    int Enable;            //Cg̗L/tO
+    int Dummy[3];          //pfBOpi_~[j
+    Vector4 Direction;     //̕
+    Color Diffuse;         //gU̐F
+    Color Ambient;         //̐F
+};
+
+//bṼTuZbgi}eAjێ\
+struct SUBSET
+{
+    std::string MtrlName;           //}eA
+    unsigned int IndexNum = 0;      //CfbNX
+    unsigned int VertexNum = 0;     //_
+    unsigned int IndexBase = 0;     //JnCfbNX
+    unsigned int VertexBase = 0;    //_x[X
+    unsigned int MaterialIdx = 0;   //}eACfbNX
+};
+
+//uhXe[g̎
+enum EBlendState
+{
+    BS_NONE = 0,      //
+    BS_ALPHABLEND,    //
+    BS_ADDITIVE,      //Z
+    BS_SUBTRACTION,   //Z
+    MAX_BLENDSTATE    //uhXe[g̍ől
+};
+
+//{[Rrl[Vsێ\
+constexpr int MAX_BONE = 400;
+struct CBBoneCombMatrix
+{
+    DirectX::XMFLOAT4X4 BoneCombMtx[MAX_BONE];  ///< {[Rrl[Vs̔z
+};
+
+struct CBTextureAlpha
+{
+    float Alpha;
+    float Padding[3];
+};
@@ -0,0 +1,171 @@
+#define NOMINMAX
+#include <windows.h>
+#include <cstdio>
+#include <algorithm>
+#include "ResidencyManager.h"
+
+namespace
+{
+    //̗\Z(eNX`EfESE ̍v)
+    constexpr size_t DEFAULT_BUDGET = 512ull * 1024 * 1024;
+}
+
+ResidencyManager::Cache ResidencyManager::m_caches[MAX_RESIDENT_TYPE];
+ResidencyManager::TypeStats ResidencyManager::m_stats[MAX_RESIDENT_TYPE];
+size_t ResidencyManager::m_budget = DEFAULT_BUDGET;
+uint64_t ResidencyManager::m_frame = 1;
+
+void ResidencyManager::RegisterCache(RESIDENT_TYPE type, GatherFunc gather, EvictFunc evict)
+{
+    m_caches[type].gather = std::move(gather);
+    m_caches[type].evict = std::move(evict);
+}
+
+void ResidencyManager::Clear()
+{
+    for (int type = 0; type < MAX_RESIDENT_TYPE; ++type)
+    {
+        m_caches[type] = Cache{};
+        m_stats[type] = TypeStats{};
+    }
+}
+
+void ResidencyManager::OnLoaded(RESIDENT_TYPE type, size_t bytes)
+{
+    TypeStats& stats = m_stats[type];
+    stats.residentBytes += bytes;
+    stats.residentCount++;
+    stats.peakBytes = std::max(stats.peakBytes, stats.residentBytes);
+}
+
+void ResidencyManager::OnReleased(RESIDENT_TYPE type, size_t bytes)
+{
+    TypeStats& stats = m_stats[type];
+    stats.residentBytes -= std::min(stats.residentBytes, bytes);
+    stats.residentCount = std::max(stats.residentCount - 1, 0);
+}
+
+void ResidencyManager::EndFrame()
+{
+    if (GetResidentBytes() > m_budget)
+    {
+        Trim();
+    }
+    m_frame++;
+}
+
+size_t ResidencyManager::Trim()
+{
+    size_t resident = GetResidentBytes();
+    if (resident <= m_budget) { return 0; }
+
+    struct Candidate
+    {
+        RESIDENT_TYPE type;
+        uint64_t id;
+        size_t bytes;
+        uint64_t lastUsedFrame;
+    };
+
+    //SLbV̊OW߂
+    std::vector<Candidate> candidates;
+    std::vector<ResidentAsset> assets;
+    for (int type = 0; type < MAX_RESIDENT_TYPE; ++type)
+    {
+        if (!m_caches[type].gather) { continue; }
+
+        assets.clear();
+        m_caches[type].gather(assets);
+        for (const auto& asset : assets)
+        {
+            if (asset.referenced || asset.lastUsedFrame >= m_frame) { continue; }
+            candidates.push_back({ static_cast<RESIDENT_TYPE>(type), asset.id, asset.bytes, asset.lastUsedFrame });
+        }
+    }
+
+    //ÂBt[Ȃ傫
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b)
+    {
+        if (a.lastUsedFrame != b.lastUsedFrame) { return a.lastUsedFrame < b.lastUsedFrame; }
+        return a.bytes > b.bytes;
+    });
+
+    size_t freed = 0;
+    for (const auto& candidate : candidates)
+    {
+        if (resident <= m_budget) { break; }
+
+        //evict ̒ OnReleased Ă΂ residentBytes 
+        if (!m_caches[candidate.type].evict(candidate.id)) { continue; }
+
+        TypeStats& stats = m_stats[candidate.type];
+        stats.evictedCount++;
+        stats.evictedBytes += candidate.bytes;
+
+        freed += candidate.bytes;
+        resident -= std::min(resident, candidate.bytes);
+    }
+
+    if (freed > 0)
+    {
+        char buf[160];
+        sprintf_s(buf, "ResidencyManager: evicted %zu KB (resident %zu KB / budget %zu KB)\n",
+            freed / 1024, GetResidentBytes() / 1024, m_budget / 1024);
+        OutputDebugStringA(buf);
+    }
+    return freed;
+}
+
+size_t ResidencyManager::GetResidentBytes()
+{
+    size_t total = 0;
+    for (const auto& stats : m_stats)
+    {
+        total += stats.residentBytes;
+    }
+    return total;
+}
+
+const char* ResidencyManager::GetTypeName(RESIDENT_TYPE type)
+{
+    switch (type)
+    {
+    case RESIDENT_TEXTURE: return "Texture";
+    case RESIDENT_MODEL:   return "Model";
+    case RESIDENT_SOUND:   return "Sound";
+    default:               return "?";
+    }
+}
+
+void ResidencyManager::GetReport(std::vector<std::string>& outLines, int topCount)
+{
+    char buf[256];
+    sprintf_s(buf, "Resident %zu KB / budget %zu KB", GetResidentBytes() / 1024, m_budget / 1024);
+    outLines.push_back(buf);
+
+    std::vector<ResidentAsset> assets;
+    for (int type = 0; type < MAX_RESIDENT_TYPE; ++type)
+    {
+        const TypeStats& stats = m_stats[type];
+        sprintf_s(buf, "  %-7s : %zu KB in %d (peak %zu KB, evicted %d / %zu KB)",
+            GetTypeName(static_cast<RESIDENT_TYPE>(type)), stats.residentBytes / 1024, stats.residentCount,
+            stats.peakBytes / 1024, stats.evictedCount, stats.evictedBytes / 1024);
+        outLines.push_back(buf);
+
+        if (!m_caches[type].gather || topCount <= 0) { continue; }
+
+        //傫 topCount 
+        assets.clear();
+        m_caches[type].gather(assets);
+        const size_t count = std::min<size_t>(assets.size(), static_cast<size_t>(topCount));
+        std::partial_sort(assets.begin(), assets.begin() + count, assets.end(),
+            [](const ResidentAsset& a, const ResidentAsset& b) { return a.bytes > b.bytes; });
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            sprintf_s(buf, "    %8zu KB %s %s", assets[i].bytes / 1024,
+                assets[i].referenced ? "ref " : "free", assets[i].name ? assets[i].name : "");
+            outLines.push_back(buf);
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <functional>
+
+//---------------------------------------------------------
+// AZbgLbV̏풓\ZɎ߂NX
+// eLbV(TextureManager / ModelCache / Sound  SE)
+// ǂݍ݁EĵтɃoCgm点Agt[̗vfɋL^
+// \Z𒴂AǂQƂĂȂAZbg
+// ŌɎĝÂ(LRU)ɃLbVO
+// (V[؂ւĂÓIȃLbVȂ悤ɂ邽)
+//---------------------------------------------------------
+
+//AZbg̎
+enum RESIDENT_TYPE
+{
+    RESIDENT_TEXTURE = 0,
+    RESIDENT_MODEL,
+    RESIDENT_SOUND,
+    MAX_RESIDENT_TYPE
+};
+
+//LbVԂ풓AZbg1
+struct ResidentAsset
+{
+    uint64_t id = 0;                //LbṼL[(AssetId ̒l)
+    size_t bytes = 0;
+    uint64_t lastUsedFrame = 0;
+    bool referenced = false;        //R|[lgȂǂgĂ(OȂ)
+    const char* name = nullptr;     //|[gp(Gather ̊ԂL)
+};
+
+class ResidencyManager
+{
+public:
+    //풓ĂAZbgS out ɑ֐
+    using GatherFunc = std::function<void(std::vector<ResidentAsset>& out)>;
+    //id ̃AZbgLbVO֐(O true)
+    using EvictFunc = std::function<bool(uint64_t id)>;
+
+    //ނƂ̏Wv
+    struct TypeStats
+    {
+        size_t residentBytes = 0;
+        int residentCount = 0;
+        size_t peakBytes = 0;
+        int evictedCount = 0;       //N̍v
+        size_t evictedBytes = 0;
+    };
+
+    static void RegisterCache(RESIDENT_TYPE type, GatherFunc gather, EvictFunc evict);
+    static void Clear();
+
+    //-----------------------LbVĂ-----------------------
+    static void OnLoaded(RESIDENT_TYPE type, size_t bytes);
+    static void OnReleased(RESIDENT_TYPE type, size_t bytes);
+
+    //vf lastUsedFrame ɓl
+    static uint64_t GetFrame() { return m_frame; }
+
+    //-----------------------t[ / V[؂ւ-----------------------
+    //t[i߁A\Z𒴂Ă Trim 
+    static void EndFrame();
+
+    //\ZɎ܂܂ŎQƂĂȂAZbgÂɊO
+    //(̃t[Ɏĝ͊OȂ)
+    //߂l : OoCg
+    static size_t Trim();
+
+    //--------Set֐-------
+    static void SetBudget(size_t bytes) { m_budget = bytes; }
+
+    //--------Get֐-------
+    static size_t GetBudget() { return m_budget; }
+    static size_t GetResidentBytes();
+    static const TypeStats& GetStats(RESIDENT_TYPE type) { return m_stats[type]; }
+    static const char* GetTypeName(RESIDENT_TYPE type);
+
+    //ނƂ̏풓oCgƁA傫̃AZbg1s
+    static void GetReport(std::vector<std::string>& outLines, int topCount = 5);
+
+private:
+    struct Cache
+    {
+        GatherFunc gather;
+        EvictFunc evict;
+    };
+
+    static Cache m_caches[MAX_RESIDENT_TYPE];
+    static TypeStats m_stats[MAX_RESIDENT_TYPE];
+    static size_t m_budget;
+    static uint64_t m_frame;
+};
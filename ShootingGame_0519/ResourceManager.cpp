@@ -2,6 +2,7 @@
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
 #include <filesystem>
+#include <d3d11.h>
 #include "Renderer.h" // for device/context
 #include <iostream>
 
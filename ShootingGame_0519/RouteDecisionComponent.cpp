@@ -6,13 +6,12 @@
 
 void RouteDecisionComponent::Initialize()
 {
-    std::random_device rd;
-    m_rng = std::mt19937(rd());
+    m_rng = RandomService::CreateEntityStream(RandomService::RANDOM_SYSTEM_ROUTE);
 
     m_isBranching = false;
     m_activeBranchPointIndex = 0;
     m_resumeMainIndex = 0;
-    m_cooldownTimer = 0.0f;
+    m_cooldownTimer.Stop();
     m_editingBranchPoint = -1;
 }
 
@@ -33,18 +32,16 @@ void RouteDecisionComponent::Update(float dt)
         return;
     }
 
-    if (m_mainWaypoints.size() < 2)
+    if (!m_mainPath)
     {
         return;
     }
 
-    if (m_cooldownTimer > 0.0f)
+    //EĂȂG͐t[1(̃N[_E͊ԈɊ֌WȂԒʂɏI)
+    AiScheduler::Slice slice(m_aiAgent, GetOwner(), dt);
+    if (!slice)
     {
-        m_cooldownTimer -= dt;
-        if (m_cooldownTimer < 0.0f)
-        {
-            m_cooldownTimer = 0.0f;
-        }
+        return;
     }
 
     if (m_isBranching)
@@ -64,23 +61,20 @@ void RouteDecisionComponent::SetPatrol(PatrolComponent* patrol)
     m_patrol = patrol;
 }
 
-void RouteDecisionComponent::SetMainWaypoints(const std::vector<Vector3>& pts)
+void RouteDecisionComponent::SetMainPath(PatrolPathHandle path)
 {
-    m_mainWaypoints = pts;
-
-    if (m_patrol)
-    {
-        m_patrol->SetWaypoints(m_mainWaypoints);
-    }
-}
+    m_mainPath = std::move(path);
 
-void RouteDecisionComponent::SetMainWaypoints(std::vector<Vector3>&& pts)
-{
-    m_mainWaypoints = std::move(pts);
+    // v[g񂷎ɑÕ[g̏ԂcȂ
+    ClearBranchPoints();
+    m_activeBranchRoute.reset();
+    m_isBranching = false;
+    m_cooldownTimer.Stop();
+    m_lastTriggeredMainIndex = static_cast<size_t>(-1);
 
     if (m_patrol)
     {
-        m_patrol->SetWaypoints(m_mainWaypoints);
+        m_patrol->SetPath(m_mainPath);
     }
 }
 
@@ -103,28 +97,14 @@ void RouteDecisionComponent::AddBranchPoint(size_t mainIndex)
     m_editingBranchPoint = static_cast<int>(m_branchPoints.size()) - 1;
 }
 
-void RouteDecisionComponent::AddBranchOption(const std::vector<Vector3>& loopPts, float weight)
+void RouteDecisionComponent::AddBranchOption(PatrolPathHandle route, float weight)
 {
     if (m_editingBranchPoint < 0)
     {
         return;
     }
 
-    if (weight <= 0.0f)
-    {
-        weight = 1.0f;
-    }
-
-    BranchOption opt;
-    opt.loopWaypoints = loopPts;
-    opt.weight = weight;
-
-    m_branchPoints[m_editingBranchPoint].options.push_back(opt);
-}
-
-void RouteDecisionComponent::AddBranchOption(std::vector<Vector3>&& loopPts, float weight)
-{
-    if (m_editingBranchPoint < 0)
+    if (!route)
     {
         return;
     }
@@ -135,7 +115,7 @@ void RouteDecisionComponent::AddBranchOption(std::vector<Vector3>&& loopPts, flo
     }
 
     BranchOption opt;
-    opt.loopWaypoints = std::move(loopPts);
+    opt.route = std::move(route);
     opt.weight = weight;
 
     m_branchPoints[m_editingBranchPoint].options.push_back(opt);
@@ -173,7 +153,7 @@ int RouteDecisionComponent::FindBranchPointIndexByMainIndex(size_t mainIndex) co
 
 void RouteDecisionComponent::TryEnterBranch()
 {
-    if (m_cooldownTimer > 0.0f)
+    if (m_cooldownTimer.IsActive())
     {
         return;
     }
@@ -200,12 +180,12 @@ void RouteDecisionComponent::TryEnterBranch()
     // g{ɕn_ɋ߂h ʒuōŏImFiXvC/XeAO index ƌ딭΂邽߁j
     Vector3 pos = GetOwner()->GetPosition();
 
-    if (bp.mainIndex >= m_mainWaypoints.size())
+    if (bp.mainIndex >= m_mainPath->GetWaypointCount())
     {
         return;
     }
 
-    Vector3 junctionPos = m_mainWaypoints[bp.mainIndex];
+    Vector3 junctionPos = m_mainPath->GetWaypoint(bp.mainIndex);
 
     if (!IsCloseTo(pos, junctionPos, m_arrivalThreshold))
     {
@@ -234,42 +214,52 @@ void RouteDecisionComponent::EnterBranch(size_t branchPointIndex)
         return;
     }
 
-    if (bp.mainIndex >= m_mainWaypoints.size())
+    if (bp.mainIndex >= m_mainPath->GetWaypointCount())
     {
         return;
     }
 
     m_activeBranchPointIndex = branchPointIndex;
-    m_activeJunctionPos = m_mainWaypoints[bp.mainIndex];
+    m_activeJunctionPos = m_mainPath->GetWaypoint(bp.mainIndex);
 
     // I g{͎̖{h ĊJi򂵂ɂj
     m_resumeMainIndex = bp.mainIndex + 1;
-    if (m_resumeMainIndex >= m_mainWaypoints.size())
+    if (m_resumeMainIndex >= m_mainPath->GetWaypointCount())
     {
-        m_resumeMainIndex = m_mainWaypoints.size() - 1;
+        m_resumeMainIndex = m_mainPath->GetWaypointCount() - 1;
     }
 
-    m_activeBranchRoute = BuildLoopRoute(m_activeJunctionPos, bp.options[optionIndex].loopWaypoints);
-
-    // 򃋁[g g񃋁[vh ɂďI[m₷
-    m_patrol->SetLoop(false);
+    // 򃋁[g g񃋁[vh ŏĂĂ̂ŏI[m₷
+    m_activeBranchRoute = bp.options[optionIndex].route;
     m_patrol->SetPingPong(false);
-    m_patrol->SetWaypoints(m_activeBranchRoute);
+    m_patrol->SetPath(m_activeBranchRoute);
 
     m_isBranching = true;
     m_lastTriggeredMainIndex = bp.mainIndex;
-    m_cooldownTimer = m_branchCooldown;
+    StartCooldown();
 }
 
 void RouteDecisionComponent::ExitBranch()
 {
     // {ɖ߂i{̓[v^pzj
-    m_patrol->SetWaypoints(m_mainWaypoints);
-    m_patrol->SetLoop(true);
+    m_patrol->SetPath(m_mainPath, m_mainPath->GetWaypointDistance(m_resumeMainIndex));
 
-    m_activeBranchRoute.clear();
+    m_activeBranchRoute.reset();
     m_isBranching = false;
-    m_cooldownTimer = m_branchCooldown;
+    StartCooldown();
+}
+
+void RouteDecisionComponent::StartCooldown()
+{
+    //Ԃ~܂邾(ĂԂ͖̂)
+    if (m_branchCooldown > 0.0f)
+    {
+        m_cooldownTimer.Start(m_branchCooldown, nullptr);
+    }
+    else
+    {
+        m_cooldownTimer.Stop();
+    }
 }
 
 bool RouteDecisionComponent::IsCloseTo(const Vector3& a, const Vector3& b, float threshold) const
@@ -296,8 +286,7 @@ size_t RouteDecisionComponent::ChooseOptionIndex(const BranchPoint& bp)
         return 0;
     }
 
-    std::uniform_real_distribution<float> dist(0.0f, total);
-    float r = dist(m_rng);
+    float r = m_rng.Range(0.0f, total);
 
     float acc = 0.0f;
     for (size_t i = 0; i < bp.options.size(); i++)
@@ -318,7 +307,7 @@ size_t RouteDecisionComponent::ChooseOptionIndex(const BranchPoint& bp)
     return 0;
 }
 
-std::vector<Vector3> RouteDecisionComponent::BuildLoopRoute(const Vector3& junctionPos, const std::vector<Vector3>& loopPts) const
+PatrolPathHandle RouteDecisionComponent::BakeBranchRoute(const Vector3& junctionPos, const std::vector<Vector3>& loopPts)
 {
     std::vector<Vector3> out;
 
@@ -334,7 +323,7 @@ std::vector<Vector3> RouteDecisionComponent::BuildLoopRoute(const Vector3& junct
     // Ō͕n_ɖ߂idlj
     out.push_back(junctionPos);
 
-    return out;
+    return PatrolPath::Create(out, false);
 }
 
 bool RouteDecisionComponent::IsBranchRouteFinished() const
@@ -344,12 +333,12 @@ bool RouteDecisionComponent::IsBranchRouteFinished() const
         return false;
     }
 
-    if (m_activeBranchRoute.size() < 2)
+    if (!m_activeBranchRoute)
     {
         return false;
     }
 
-    size_t endSegmentIndex = m_activeBranchRoute.size() - 2;
+    size_t endSegmentIndex = m_activeBranchRoute->GetWaypointCount() - 2;
     size_t curIndex = m_patrol->GetCurrentIndex();
 
     if (curIndex != endSegmentIndex)
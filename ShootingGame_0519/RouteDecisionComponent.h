@@ -1,9 +1,12 @@
 #pragma once
 #include "Component.h"
 #include <vector>
-#include <random>
+#include "RandomService.h"
 #include <cstddef>
 #include <SimpleMath.h>
+#include "PatrolPath.h"
+#include "AiScheduler.h"
+#include "TimerWheel.h"
 
 using namespace DirectX::SimpleMath;
 
@@ -20,8 +23,8 @@ public:
 
     //--------Set֐-------
     void SetPatrol(PatrolComponent* patrol);
-    void SetMainWaypoints(const std::vector<Vector3>& pts);
-    void SetMainWaypoints(std::vector<Vector3>&& pts);
+    //{ւ(򒆂Ȃł؂A_)
+    void SetMainPath(PatrolPathHandle path);
     void SetArrivalThreshold(float t);
     void SetBranchCooldown(float sec);
 
@@ -29,19 +32,22 @@ public:
     void AddBranchPoint(size_t mainIndex);
 
     // ߂ AddBranchPoint() n_ցA⃋[vǉiő3zj
-    // loopPts ́un_oĖ߂܂Łv́gr_hłOKiŌ junction őj
-    void AddBranchOption(const std::vector<Vector3>& loopPts, float weight = 1.0f);
-    void AddBranchOption(std::vector<Vector3>&& loopPts, float weight = 1.0f);
+    // route  BakeBranchRoute() ŏẮi̓GŋLj
+    void AddBranchOption(PatrolPathHandle route, float weight = 1.0f);
 
     void ClearBranchPoints();
 
     //--------Get֐-------
     bool IsBranching() const { return m_isBranching; }
 
+    // 򃋁[gĂi񃋁[vj
+    // loopPts ́un_oĖ߂܂Łv́gr_hłOKiO junction őj
+    static PatrolPathHandle BakeBranchRoute(const Vector3& junctionPos, const std::vector<Vector3>& loopPts);
+
 private:
     struct BranchOption
     {
-        std::vector<Vector3> loopWaypoints;
+        PatrolPathHandle route;
         float weight = 1.0f;
     };
 
@@ -56,7 +62,7 @@ private:
     PatrolComponent* m_patrol = nullptr;
 
     //--------------{֘A------------------
-    std::vector<Vector3> m_mainWaypoints;
+    PatrolPathHandle m_mainPath;
 
     //--------------֘A------------------
     std::vector<BranchPoint> m_branchPoints;
@@ -70,16 +76,19 @@ private:
     Vector3 m_activeJunctionPos = Vector3(0.0f, 0.0f, 0.0f);
 
     // Ă镪򃋁[gimɎgj
-    std::vector<Vector3> m_activeBranchRoute;
+    PatrolPathHandle m_activeBranchRoute;
 
     //--------------/N[_E֘A------------------
     float m_arrivalThreshold = 0.5f;
     float m_branchCooldown = 0.25f;
-    float m_cooldownTimer = 0.0f;
+    TimerWheel::Timer m_cooldownTimer;  //ĂԂ͎̕ɓȂ
     size_t m_lastTriggeredMainIndex = static_cast<size_t>(-1);
 
+    //--------------AILOD------------------
+    AiScheduler::Agent m_aiAgent;   //PatrolComponent Ɠt[ŉ
+
     //--------------֘A------------------
-    std::mt19937 m_rng;
+    RandomStream m_rng;     //G1̂̗(16 oCg)
 
 private:
     const BranchPoint* FindBranchPointByMainIndex(size_t mainIndex) const;
@@ -88,11 +97,11 @@ private:
     void TryEnterBranch();
     void EnterBranch(size_t branchPointIndex);
     void ExitBranch();
+    void StartCooldown();
 
     bool IsCloseTo(const Vector3& a, const Vector3& b, float threshold) const;
 
     size_t ChooseOptionIndex(const BranchPoint& bp);
-    std::vector<Vector3> BuildLoopRoute(const Vector3& junctionPos, const std::vector<Vector3>& loopPts) const;
 
     bool IsBranchRouteFinished() const;
 };
@@ -11,8 +11,11 @@
 #include "Application.h" 
 #include "ResultLooseScene.h"
 #include "IScene.h"
+#include "ResidencyManager.h"
+#include "Sound.h"
        
-std::unordered_map<std::string, std::unique_ptr<IScene>> SceneManager::m_scenes;
+AssetTable<SceneAssetTag, std::unique_ptr<IScene>> SceneManager::m_scenes;
+IScene* SceneManager::m_currentScene = nullptr;
 std::string SceneManager::m_currentSceneName;
 bool SceneManager::m_sceneChangedThisFrame = false;
 
@@ -23,7 +26,16 @@ bool SceneManager::m_sceneChangedThisFrame = false;
 /// <param name="scene">Scene̎</param>
 void SceneManager::RegisterScene(const std::string& name, std::unique_ptr<IScene> scene)
 {
-    m_scenes[name] = std::move(scene); //m_sceneɈSceneƃX[}[g|C^gēo^
+    m_scenes.Insert(SceneId::FromString(name), name.c_str(), std::move(scene)); //m_sceneɈSceneƃX[}[g|C^gēo^
+}
+
+/// <summary>
+/// o^ς݂Scene𖼑OŒT֐( nullptr)
+/// </summary>
+IScene* SceneManager::FindScene(const std::string& name)
+{
+    std::unique_ptr<IScene>* scene = m_scenes.Find(SceneId::FromString(name), name.c_str());
+    return scene ? scene->get() : nullptr;
 }
 
 /// <summary>
@@ -32,20 +44,31 @@ void SceneManager::RegisterScene(const std::string& name, std::unique_ptr<IScene
 /// <param name="name"></param>
 void SceneManager::SetCurrentScene(const std::string& name)
 {
+    IScene* next = FindScene(name);
+    if (!next)
+    {
+        OutputDebugStringA(("SceneManager: unknown scene " + name + "\n").c_str());
+        return;
+    }
+
     // ύXÕV[Έx Uninit
-    if (!m_currentSceneName.empty() && m_scenes.count(m_currentSceneName))
+    if (m_currentScene)
     {
-        m_scenes[m_currentSceneName]->Uninit();
+        m_currentScene->Uninit();
     }
 
     Input::Reset();
 
     // VV[ZbgInit
     m_currentSceneName = name;
-    m_scenes[m_currentSceneName]->Init();
+    m_currentScene = next;
+    m_currentScene->Init();
     Sound::StopBgm();
     Sound::StopAllSe();
 
+    // ÕV[gĂAZbg͂ŎQƂOĂ
+    ResidencyManager::Trim();
+
     // EBhE^CgύXistd::string  wchar_t* ֕ϊj
     int wlen = MultiByteToWideChar(CP_UTF8, 0, name.c_str(), -1, nullptr, 0);
     std::wstring wname(wlen, L'\0');
@@ -70,6 +93,13 @@ std::string SceneManager::GetCurrentSceneName()
 /// <param name="name"></param>
 void SceneManager::SetChangeScene(const std::string& name)
 {
+    IScene* next = FindScene(name);
+    if (!next)
+    {
+        OutputDebugStringA(("SceneManager: unknown scene " + name + "\n").c_str());
+        return;
+    }
+
     // mark change so Update loop can skip remaining steps
     m_sceneChangedThisFrame = true;
 
@@ -77,16 +107,18 @@ void SceneManager::SetChangeScene(const std::string& name)
     CollisionManager::Clear();
 
     // ݂̃V[ Uninit ĂVV[ Init
-    if (!m_currentSceneName.empty() && m_scenes.count(m_currentSceneName))
+    if (m_currentScene)
     {
-        m_scenes[m_currentSceneName]->Uninit();
+        m_currentScene->Uninit();
     }
 
     Input::Reset();
 
     m_currentSceneName = name;
-    m_scenes[m_currentSceneName]->Init();
+    m_currentScene = next;
+    m_currentScene->Init();
 
+    ResidencyManager::Trim();
 }
 
 /// <summary>
@@ -97,7 +129,7 @@ void SceneManager::Init()
     //-------------------------------------------------------------
     //jTitleSceneo^
     //RegisterScene("TitleScene", std::make_unique<TitleScene>());
-    //m_scenes["TitleScene"]->init();
+    //SetCurrentScene("TitleScene");
     //-------------------------------------------------------------
 
     RegisterScene("TitleScene", std::make_unique<TitleScene>());
@@ -112,9 +144,13 @@ void SceneManager::Init()
 
     RegisterScene("GameForwardScene", std::make_unique<GameForwardScene>());
 
+    //SE ͂܂Ƃ߂ă}bvĂ(Q[ .wav JȂB1ǂ)
+    Sound::LoadSeBank(L"Asset/Sound/SE.bank");
+
     //V[TitleSceneݒ
     m_currentSceneName = "TitleScene";
-    m_scenes[m_currentSceneName]->Init();
+    m_currentScene = FindScene(m_currentSceneName);
+    m_currentScene->Init();
 
 }
 
@@ -124,9 +160,9 @@ void SceneManager::Update(float deltatime)
 
     if (!TransitionManager::IsTransitioning())
     {
-        if (!m_currentSceneName.empty() && m_scenes.count(m_currentSceneName))
+        if (m_currentScene)
         {
-            m_scenes[m_currentSceneName]->Update(deltatime);
+            m_currentScene->Update(deltatime);
         }
         
         if (m_sceneChangedThisFrame)
@@ -135,9 +171,9 @@ void SceneManager::Update(float deltatime)
             return; 
         }
 
-        if (!m_currentSceneName.empty() && m_scenes.count(m_currentSceneName))
+        if (m_currentScene)
         {
-            m_scenes[m_currentSceneName]->FinishFrameCleanup();
+            m_currentScene->FinishFrameCleanup();
         }
     } 
 
@@ -147,9 +183,9 @@ void SceneManager::Draw(float deltatime)
 {
 
     //݃V[`
-    if (!m_currentSceneName.empty() && m_scenes.count(m_currentSceneName))
+    if (m_currentScene)
     {
-        m_scenes[m_currentSceneName]->Draw(deltatime);
+        m_currentScene->Draw(deltatime);
     }
 
     //fobOUI̕`
@@ -159,18 +195,18 @@ void SceneManager::Draw(float deltatime)
 
 void SceneManager::DrawWorld(float deltatime)
 {
-    if (!m_currentSceneName.empty() && m_scenes.count(m_currentSceneName))
+    if (m_currentScene)
     {
-        m_scenes[m_currentSceneName]->DrawWorld(deltatime);
+        m_currentScene->DrawWorld(deltatime);
     }
 }
 
 void SceneManager::DrawUI(float deltatime)
 {
     //݃V[`
-    if (!m_currentSceneName.empty() && m_scenes.count(m_currentSceneName))
+    if (m_currentScene)
     {
-        m_scenes[m_currentSceneName]->DrawUI(deltatime);
+        m_currentScene->DrawUI(deltatime);
     }
 
     // fobOUI̕`
@@ -181,11 +217,12 @@ void SceneManager::DrawUI(float deltatime)
 void SceneManager::Uninit()
 {
     // o^Ă邷ׂăV[̏I
-    for (auto& s : m_scenes)
+    m_scenes.ForEach([](SceneId, std::unique_ptr<IScene>& scene)
     {
-        s.second->Uninit();
-    }
+        scene->Uninit();
+    });
 
-    m_scenes.clear();
+    m_scenes.Clear();
+    m_currentScene = nullptr;
     m_currentSceneName.clear();
 }
\ No newline at end of file
@@ -1,8 +1,8 @@
 #pragma once
 #include <memory>
-#include <unordered_map>
 #include <string>
 #include "NonCopyable.h"
+#include "AssetTable.h"
 
 class IScene;
 
@@ -30,10 +30,12 @@ public:
 private:
 	//--------------Scene֘A------------------
 	static void ChangeSceneInternal(const std::string& name);
+	static IScene* FindScene(const std::string& name);
 	static void UpdateWindowTitle(const std::string& title);
 
 	//--------------SceneǗ֘A------------------
-	static std::unordered_map<std::string, std::unique_ptr<IScene>> m_scenes;
+	static AssetTable<SceneAssetTag, std::unique_ptr<IScene>> m_scenes;	//ÕnbVň
+	static IScene* m_currentScene;		//t[͖Oňɂg
 	static std::string m_currentSceneName;
 	static bool m_sceneChangedThisFrame;
 };
\ No newline at end of file
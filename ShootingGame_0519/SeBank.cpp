@@ -0,0 +1,334 @@
+#if defined(_MSC_VER) && !defined(_CRT_SECURE_NO_WARNINGS)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#endif
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include "SeBank.h"
+
+namespace
+{
+    constexpr char BANK_MAGIC[4] = { 'S', 'E', 'B', 'K' };
+    constexpr uint32_t BANK_VERSION = 1;
+
+    //PCM ̐擪낦(~LT[ SIMD ǂݍݗp)
+    constexpr uint32_t DATA_ALIGNMENT = 16;
+
+    struct BankHeader
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t count;
+        uint32_t namesBytes;
+    };
+
+    struct BankEntry
+    {
+        uint64_t id;
+        uint32_t dataOffset;
+        uint32_t dataBytes;
+        uint32_t nameOffset;
+        uint32_t sampleRate;
+        uint16_t channels;
+        uint16_t bitsPerSample;
+        uint16_t blockAlign;
+        uint16_t formatTag;
+    };
+    static_assert(sizeof(BankHeader) == 16, "SeBank header layout");
+    static_assert(sizeof(BankEntry) == 32, "SeBank entry layout");
+
+    void Print(const char* text)
+    {
+        printf("%s\n", text);
+#ifdef _WIN32
+        OutputDebugStringA(text);
+        OutputDebugStringA("\n");
+#endif
+    }
+
+    void Log(const std::string& message)
+    {
+#ifdef _WIN32
+        OutputDebugStringA(message.c_str());
+#else
+        fputs(message.c_str(), stderr);
+#endif
+    }
+
+    uint32_t AlignUp(uint32_t value)
+    {
+        return (value + DATA_ALIGNMENT - 1) & ~(DATA_ALIGNMENT - 1);
+    }
+
+    template<typename T>
+    T ReadAt(const uint8_t* p)
+    {
+        T v;
+        memcpy(&v, p, sizeof(T));
+        return v;
+    }
+
+    bool ReadWholeFile(const std::string& path, std::vector<uint8_t>& out)
+    {
+        FILE* fp = fopen(path.c_str(), "rb");
+        if (!fp) { return false; }
+
+        fseek(fp, 0, SEEK_END);
+        const long size = ftell(fp);
+        fseek(fp, 0, SEEK_SET);
+
+        out.resize(size > 0 ? static_cast<size_t>(size) : 0);
+        const bool ok = fread(out.data(), 1, out.size(), fp) == out.size();
+        fclose(fp);
+        return ok;
+    }
+}
+
+bool SeBank::ParseWav(const uint8_t* bytes, size_t size, WavView& out)
+{
+    if (size < 12 || memcmp(bytes, "RIFF", 4) != 0 || memcmp(bytes + 8, "WAVE", 4) != 0)
+    {
+        return false;
+    }
+
+    bool foundFmt = false;
+    size_t pos = 12;
+    while (pos + 8 <= size)
+    {
+        const uint8_t* chunk = bytes + pos;
+        const uint32_t chunkSize = ReadAt<uint32_t>(chunk + 4);
+        const uint8_t* body = chunk + 8;
+        if (chunkSize > size - pos - 8) { return false; }
+
+        if (memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16)
+        {
+            WavFormat& fmt = out.format;
+            fmt.formatTag = ReadAt<uint16_t>(body);
+            fmt.channels = ReadAt<uint16_t>(body + 2);
+            fmt.sampleRate = ReadAt<uint32_t>(body + 4);
+            fmt.bytesPerSec = ReadAt<uint32_t>(body + 8);
+            fmt.blockAlign = ReadAt<uint16_t>(body + 12);
+            fmt.bitsPerSample = ReadAt<uint16_t>(body + 14);
+
+            if (fmt.formatTag != WavFormat::TAG_PCM || fmt.bitsPerSample != 16 ||
+                (fmt.channels != 1 && fmt.channels != 2))
+            {
+                return false;
+            }
+            foundFmt = true;
+        }
+        else if (memcmp(chunk, "data", 4) == 0)
+        {
+            out.data = body;
+            out.bytes = chunkSize;
+            return foundFmt;
+        }
+
+        //`N͋oCgɂ낦Ă
+        pos += 8 + chunkSize + (chunkSize & 1);
+    }
+
+    return false;
+}
+
+bool SeBank::Open(const std::wstring& filepath)
+{
+    Close();
+
+    if (!m_file.Open(filepath))
+    {
+        return false;
+    }
+
+    const uint8_t* base = m_file.GetData();
+    const size_t size = m_file.GetSize();
+
+    //ꂽt@Cǂł͈͊OwȂ悤ɑSm߂
+    auto fail = [&](const char* reason)
+    {
+        Log(std::string("SeBank: ") + reason + "\n");
+        Close();
+        return false;
+    };
+
+    if (size < sizeof(BankHeader)) { return fail("file is too small"); }
+
+    const BankHeader header = ReadAt<BankHeader>(base);
+    if (memcmp(header.magic, BANK_MAGIC, 4) != 0 || header.version != BANK_VERSION)
+    {
+        return fail("bad magic or version");
+    }
+
+    const size_t indexEnd = sizeof(BankHeader) + static_cast<size_t>(header.count) * sizeof(BankEntry);
+    const size_t namesEnd = indexEnd + header.namesBytes;
+    if (namesEnd > size) { return fail("index is truncated"); }
+
+    const char* names = reinterpret_cast<const char*>(base + indexEnd);
+    if (header.namesBytes == 0 || names[header.namesBytes - 1] != '\0') { return fail("bad name table"); }
+
+    m_entries.reserve(header.count);
+    for (uint32_t i = 0; i < header.count; ++i)
+    {
+        const BankEntry e = ReadAt<BankEntry>(base + sizeof(BankHeader) + i * sizeof(BankEntry));
+        if (static_cast<size_t>(e.dataOffset) + e.dataBytes > size || e.nameOffset >= header.namesBytes)
+        {
+            return fail("entry is out of range");
+        }
+
+        Entry entry;
+        entry.id = SoundId(e.id);
+        entry.format.formatTag = e.formatTag;
+        entry.format.channels = e.channels;
+        entry.format.sampleRate = e.sampleRate;
+        entry.format.blockAlign = e.blockAlign;
+        entry.format.bitsPerSample = e.bitsPerSample;
+        entry.format.bytesPerSec = e.sampleRate * e.blockAlign;
+        entry.data = base + e.dataOffset;
+        entry.bytes = e.dataBytes;
+        entry.name = names + e.nameOffset;
+        m_entries.push_back(entry);
+    }
+
+    return true;
+}
+
+void SeBank::Close()
+{
+    m_entries.clear();
+    m_file.Close();
+}
+
+int SeBank::Bake(const std::vector<std::string>& paths, const std::string& outPath)
+{
+    std::vector<std::string> files;
+    for (const auto& path : paths)
+    {
+        std::error_code ec;
+        if (std::filesystem::is_directory(path, ec))
+        {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(path, ec))
+            {
+                if (entry.is_regular_file() && entry.path().extension() == ".wav")
+                {
+                    files.push_back(entry.path().generic_string());
+                }
+            }
+        }
+        else
+        {
+            files.push_back(path);
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    const auto start = std::chrono::steady_clock::now();
+    char buf[512];
+    int result = 0;
+
+    //ɑSǂŁAƖȎ傫߂
+    std::vector<std::vector<uint8_t>> sources;
+    std::vector<WavView> views;
+    std::vector<std::string> names;
+    for (const auto& path : files)
+    {
+        std::vector<uint8_t> bytes;
+        WavView view;
+        if (!ReadWholeFile(path, bytes) || !ParseWav(bytes.data(), bytes.size(), view))
+        {
+            snprintf(buf, sizeof(buf), "  skip %s (16bit PCM only)", path.c_str());
+            Print(buf);
+            result = 1;
+            continue;
+        }
+
+        //ParseWav ̃|C^ bytes ŵŁAvector Ɠĕۂ
+        sources.push_back(std::move(bytes));
+        views.push_back(view);
+        names.push_back(path);
+    }
+
+    std::vector<BankEntry> entries(views.size());
+    std::string nameTable;
+    for (size_t i = 0; i < views.size(); ++i)
+    {
+        entries[i].nameOffset = static_cast<uint32_t>(nameTable.size());
+        nameTable += names[i];
+        nameTable.push_back('\0');
+    }
+    if (nameTable.empty())
+    {
+        nameTable.push_back('\0');
+    }
+
+    uint32_t offset = AlignUp(static_cast<uint32_t>(sizeof(BankHeader) + entries.size() * sizeof(BankEntry) + nameTable.size()));
+    for (size_t i = 0; i < views.size(); ++i)
+    {
+        const WavView& view = views[i];
+        BankEntry& e = entries[i];
+        e.id = SoundId::FromString(names[i]).value;
+        e.dataOffset = offset;
+        e.dataBytes = view.bytes;
+        e.sampleRate = view.format.sampleRate;
+        e.channels = view.format.channels;
+        e.bitsPerSample = view.format.bitsPerSample;
+        e.blockAlign = view.format.blockAlign;
+        e.formatTag = view.format.formatTag;
+        offset = AlignUp(offset + view.bytes);
+    }
+
+    FILE* fp = fopen(outPath.c_str(), "wb");
+    if (!fp)
+    {
+        snprintf(buf, sizeof(buf), "SE bank failed: cannot write %s", outPath.c_str());
+        Print(buf);
+        return 1;
+    }
+
+    BankHeader header{};
+    memcpy(header.magic, BANK_MAGIC, 4);
+    header.version = BANK_VERSION;
+    header.count = static_cast<uint32_t>(entries.size());
+    header.namesBytes = static_cast<uint32_t>(nameTable.size());
+
+    const uint8_t padding[DATA_ALIGNMENT] = {};
+    uint32_t written = 0;
+    auto write = [&](const void* data, size_t bytes)
+    {
+        fwrite(data, 1, bytes, fp);
+        written += static_cast<uint32_t>(bytes);
+    };
+    auto pad = [&](uint32_t to)
+    {
+        write(padding, to - written);
+    };
+
+    write(&header, sizeof(header));
+    write(entries.data(), entries.size() * sizeof(BankEntry));
+    write(nameTable.data(), nameTable.size());
+
+    size_t totalBytes = 0;
+    for (size_t i = 0; i < views.size(); ++i)
+    {
+        pad(entries[i].dataOffset);
+        write(views[i].data, views[i].bytes);
+        totalBytes += views[i].bytes;
+
+        snprintf(buf, sizeof(buf), "  %s : %uHz %uch, %u KB", names[i].c_str(), views[i].format.sampleRate,
+            views[i].format.channels, views[i].bytes / 1024);
+        Print(buf);
+    }
+    fclose(fp);
+
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    snprintf(buf, sizeof(buf), "SE bank: %zu sounds -> %s (%u KB, PCM %zu KB), %.0f ms",
+        views.size(), outPath.c_str(), written / 1024, totalBytes / 1024, ms);
+    Print(buf);
+
+    return result;
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "AssetId.h"
+#include "MappedFile.h"
+
+//---------------------------------------------------------
+// SE ܂Ƃ߂1̃t@C(<bank>)
+// wb_EEOEPCM(16 oCgE)̏ɕłāA
+// J̓}bvčm߂邾BPCM ̓}bv܂܎g(Rs[Ȃ)
+// ̂ --bake-sebank(Asset/Sound/SE  .wav Sl߂)
+//---------------------------------------------------------
+
+//RIFF  fmt `N(WAVEFORMATEX ƓсBwindows.h Ŏg悤ɎOŎ)
+struct WavFormat
+{
+    static constexpr uint16_t TAG_PCM = 1;
+
+    uint16_t formatTag = 0;
+    uint16_t channels = 0;
+    uint32_t sampleRate = 0;
+    uint32_t bytesPerSec = 0;
+    uint16_t blockAlign = 0;
+    uint16_t bitsPerSample = 0;
+};
+
+//RIFF ̒ PCM ̏ꏊ(data ͌̃oCgw)
+struct WavView
+{
+    WavFormat format;
+    const uint8_t* data = nullptr;
+    uint32_t bytes = 0;
+};
+
+class SeBank
+{
+public:
+    struct Entry
+    {
+        SoundId id;
+        WavFormat format;
+        const uint8_t* data = nullptr;  //}bv̈̒
+        uint32_t bytes = 0;
+        const char* name = nullptr;     //ẴpX(Asset/Sound/SE/xxx.wav)
+    };
+
+    SeBank() = default;
+    SeBank(const SeBank&) = delete;
+    SeBank& operator=(const SeBank&) = delete;
+
+    bool Open(const std::wstring& filepath);
+    void Close();
+
+    //--------Get֐-------
+    const std::vector<Entry>& GetEntries() const { return m_entries; }
+    size_t GetMappedBytes() const { return m_file.GetSize(); }
+    bool IsOpen() const { return m_file.IsOpen(); }
+
+    //RIFF ̃`N1Ȃ߂ fmt  data T(16bit PCM ̃mEXeI)
+    static bool ParseWav(const uint8_t* bytes, size_t size, WavView& out);
+
+    //paths(t@CfBNg) .wav  outPath ɋl߂
+    //(main  --bake-sebank Ă)
+    static int Bake(const std::vector<std::string>& paths, const std::string& outPath);
+
+private:
+    MappedFile m_file;
+    std::vector<Entry> m_entries;
+};
@@ -0,0 +1,185 @@
+#include <algorithm>
+#include "SeVoicePool.h"
+
+namespace
+{
+    //SE ŜœɎg{CX̐(c BGM Ȃǂɋ󂯂Ă)
+    constexpr int MAX_SE_VOICES = 24;
+}
+
+void SeVoicePool::Init(AudioMixer* mixer)
+{
+    m_mixer = mixer;
+    m_voices.clear();
+    m_voices.reserve(MAX_SE_VOICES);
+    m_stats = Stats{};
+    m_stats.pooled = MAX_SE_VOICES;
+}
+
+void SeVoicePool::Uninit()
+{
+    StopAll();
+    m_voices.clear();
+    m_sounds.Clear();
+    m_mixer = nullptr;
+    m_stats.active = 0;
+}
+
+bool SeVoicePool::Play(SoundId soundId, const AudioClip& clip, const void* owner,
+                       float volume, const SeLimits& limits, float now)
+{
+    if (!m_mixer) { return false; }
+
+    SoundState* state = m_sounds.Find(soundId);
+    if (!state)
+    {
+        state = &m_sounds.Insert(soundId, static_cast<const char*>(nullptr), SoundState{});
+    }
+
+    //Ał̊Ԉ
+    if (now - state->lastStart < limits.minInterval)
+    {
+        m_stats.throttled++;
+        return false;
+    }
+
+    for (auto& voice : m_voices)
+    {
+        Reclaim(voice);
+    }
+
+    Voice* target = nullptr;
+    bool steal = false;
+
+    if (state->playing >= std::max(limits.maxPolyphony, 1))
+    {
+        //܂ŖĂΈԌÂ̂炵
+        for (auto& voice : m_voices)
+        {
+            if (voice.active && voice.soundId == soundId &&
+                (!target || voice.startOrder < target->startOrder))
+            {
+                target = &voice;
+            }
+        }
+        steal = (target != nullptr);
+    }
+
+    if (!target)
+    {
+        for (auto& voice : m_voices)
+        {
+            if (!voice.active) { target = &voice; break; }
+        }
+    }
+
+    if (!target && static_cast<int>(m_voices.size()) < MAX_SE_VOICES)
+    {
+        m_voices.push_back(Voice{});
+        target = &m_voices.back();
+        m_stats.created++;
+    }
+
+    if (!target)
+    {
+        //DxႢ(ȂÂ){CX肷
+        for (auto& voice : m_voices)
+        {
+            if (voice.priority > limits.priority) { continue; }
+            if (!target || voice.priority < target->priority ||
+                (voice.priority == target->priority && voice.startOrder < target->startOrder))
+            {
+                target = &voice;
+            }
+        }
+        steal = (target != nullptr);
+    }
+
+    if (!target)
+    {
+        m_stats.drops++;
+        return false;
+    }
+
+    if (steal)
+    {
+        m_mixer->Stop(target->handle);
+        Release(*target);
+        m_stats.steals++;
+    }
+
+    AudioMixer::VoiceHandle handle = m_mixer->Play(clip, volume, false, AUDIO_BUS_SE);
+    if (handle == AudioMixer::INVALID_VOICE)
+    {
+        m_stats.drops++;
+        return false;
+    }
+
+    target->handle = handle;
+    target->active = true;
+    target->soundId = soundId;
+    target->priority = limits.priority;
+    target->startOrder = ++m_startCounter;
+    target->owner = owner;
+
+    state->playing++;
+    state->lastStart = now;
+
+    m_stats.plays++;
+    m_stats.active++;
+    return true;
+}
+
+void SeVoicePool::Update()
+{
+    for (auto& voice : m_voices)
+    {
+        Reclaim(voice);
+    }
+}
+
+void SeVoicePool::StopAll()
+{
+    for (auto& voice : m_voices)
+    {
+        if (!voice.active) { continue; }
+
+        if (m_mixer)
+        {
+            m_mixer->Stop(voice.handle);
+        }
+        Release(voice);
+    }
+}
+
+bool SeVoicePool::IsPlaying(const void* owner) const
+{
+    for (const auto& voice : m_voices)
+    {
+        if (voice.active && voice.owner == owner && m_mixer->IsPlaying(voice.handle)) { return true; }
+    }
+    return false;
+}
+
+void SeVoicePool::Reclaim(Voice& voice)
+{
+    if (voice.active && !m_mixer->IsPlaying(voice.handle))
+    {
+        Release(voice);
+    }
+}
+
+void SeVoicePool::Release(Voice& voice)
+{
+    if (!voice.active) { return; }
+
+    if (SoundState* state = m_sounds.Find(voice.soundId))
+    {
+        state->playing = std::max(state->playing - 1, 0);
+    }
+
+    voice.active = false;
+    voice.owner = nullptr;
+    voice.handle = AudioMixer::INVALID_VOICE;
+    m_stats.active = std::max(m_stats.active - 1, 0);
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "AssetTable.h"
+#include "AudioMixer.h"
+
+//---------------------------------------------------------
+// SE p̃{CX̊蓖Ă߂v[
+// ̓EDxɂ鉡EAł̊ԈōsA
+// ۂ̍Đ AudioMixer ̃{CXōs
+//---------------------------------------------------------
+
+//SE 1̖炵̐
+struct SeLimits
+{
+    int maxPolyphony = 4;       //𓯎ɖ点鐔(ԌÂ̂~߂Ė炵)
+    int priority = 0;           //{CXȂAȉ̗Dx̃{CXł
+    float minInterval = 0.0f;   //O炵Ă炱̕bȓȂ炳Ȃ
+};
+
+class SeVoicePool
+{
+public:
+    //N̍v(active / pooled ͍̒l)
+    struct Stats
+    {
+        int plays = 0;
+        int created = 0;        //gn߂{CX̘g̐
+        int steals = 0;         //Ă{CX~߂Ďg
+        int drops = 0;          //{CXĖ点Ȃ
+        int throttled = 0;      //minInterval ŊԈ
+        int active = 0;
+        int pooled = 0;
+    };
+
+    SeVoicePool() = default;
+    ~SeVoicePool() = default;
+    SeVoicePool(const SeVoicePool&) = delete;
+    SeVoicePool& operator=(const SeVoicePool&) = delete;
+
+    void Init(AudioMixer* mixer);
+    void Uninit();
+
+    //soundId : 𐔂P
+    //owner : 炵Ăg`(IsPlaying Œׂ鎞̃L[)
+    //now : Sound ̌oߎ(b)
+    bool Play(SoundId soundId, const AudioClip& clip, const void* owner,
+              float volume, const SeLimits& limits, float now);
+
+    //I{CX󂫂ɖ߂
+    void Update();
+
+    void StopAll();
+
+    bool IsPlaying(const void* owner) const;
+
+    //--------Get֐-------
+    const Stats& GetStats() const { return m_stats; }
+
+private:
+    struct Voice
+    {
+        AudioMixer::VoiceHandle handle = AudioMixer::INVALID_VOICE;
+        bool active = false;
+        SoundId soundId;
+        int priority = 0;
+        uint64_t startOrder = 0;
+        const void* owner = nullptr;
+    };
+
+    //Ƃ̏
+    struct SoundState
+    {
+        int playing = 0;
+        float lastStart = -1.0e9f;
+    };
+
+    void Reclaim(Voice& voice);
+    void Release(Voice& voice);
+
+    AudioMixer* m_mixer = nullptr;
+    std::vector<Voice> m_voices;
+    AssetTable<SoundAssetTag, SoundState> m_sounds;
+    uint64_t m_startCounter = 0;
+    Stats m_stats;
+};
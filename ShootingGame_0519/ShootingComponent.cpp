@@ -11,10 +11,15 @@
 
 using namespace DirectX::SimpleMath;
 
-void ShootingComponent::Update(float dt)
+namespace
 {
-    m_timer += dt;
+    constexpr SoundPath PLAYER_SHOT_SE(L"Asset/Sound/SE/PlayerShot_SE.wav");
+    //連射で鳴り続けるので数を絞る(敵の被弾音よりは優先)
+    constexpr SeLimits PLAYER_SHOT_LIMITS{ 4, 1, 0.05f };
+}
 
+void ShootingComponent::Update(float dt)
+{
     GameObject* owner = GetOwner();
 
     if (!owner)
@@ -22,6 +27,12 @@ void ShootingComponent::Update(float dt)
         return;
     }
 
+    //最初の更新からクールダウンを数え始める
+    if (!m_ready && !m_cooldownTimer.IsActive())
+    {
+        StartCooldown();
+    }
+
     //UpdateAimInfo(owner);
 
     bool wantFire = m_autoFire || Input::IsKeyDown(VK_SPACE);
@@ -31,7 +42,7 @@ void ShootingComponent::Update(float dt)
         return;
     }
 
-    if (m_timer < m_cooldown)
+    if (!m_ready)
     {
         return;
     }
@@ -39,6 +50,12 @@ void ShootingComponent::Update(float dt)
     Fire();
 }
 
+void ShootingComponent::StartCooldown()
+{
+    m_ready = false;
+    m_cooldownTimer.Start(m_cooldown, [this]() { m_ready = true; });
+}
+
 void ShootingComponent::UpdateAimInfo(GameObject* owner)
 {
     if (!owner)
@@ -177,7 +194,7 @@ void ShootingComponent::Fire()
 {
     GameObject* owner = GetOwner();
     if (!owner) { return; }
-    if (m_timer < m_cooldown) { return; }
+    if (!m_ready) { return; }
 
     UpdateAimInfo(owner);
 
@@ -207,7 +224,7 @@ void ShootingComponent::Fire()
     if (!bullet) { return; }
 
     AddBulletToScene(bullet);
-    Sound::PlaySeWav(L"Asset/Sound/SE/PlayerShot_SE.wav", 0.3f);
+    Sound::PlaySeWav(PLAYER_SHOT_SE, 0.3f, PLAYER_SHOT_LIMITS);
 
-    m_timer = 0.0f;
+    StartCooldown();
 }
\ No newline at end of file
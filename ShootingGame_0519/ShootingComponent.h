@@ -4,6 +4,7 @@
 #include "ICameraViewProvider.h"
 #include <memory>
 #include <SimpleMath.h>
+#include "TimerWheel.h"
 
 using namespace DirectX::SimpleMath;
 
@@ -44,6 +45,9 @@ private:
     //--------------Ə֘A------------------
     void UpdateAimInfo(GameObject* owner);
 
+    //--------------ˊԊu֘A------------------
+    void StartCooldown();
+
 private:
     //--------------QƊ֘A------------------
     IScene* m_scene = nullptr;
@@ -51,7 +55,8 @@ private:
 
     //--------------ːݒ֘A------------------
     float m_cooldown = 0.1f;
-    float m_timer = 0.0f;
+    bool m_ready = false;                   //N[_EIČĂ
+    TimerWheel::Timer m_cooldownTimer;      //I m_ready 𗧂Ă
     float m_bulletSpeed = 300.0f;
     float m_spawnOffset = 14.0f;
     bool m_autoFire = false;
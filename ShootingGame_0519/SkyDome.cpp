@@ -1,4 +1,5 @@
 #include "Skydome.h"
+#include <d3d11.h>
 #include "Renderer.h"
 #include "TextureManager.h"
 #include "Application.h"
@@ -47,7 +48,7 @@ void SkyDome::Draw(float alpha)
 
 	if (m_texture)
 	{
-		Renderer::GetDeviceContext()->PSSetShaderResources(0, 1, m_texture.GetAddressOf());
+		Renderer::SetTexture(m_texture.Get());
 	}
 
 	//`֐
@@ -55,8 +56,7 @@ void SkyDome::Draw(float alpha)
 	m_primitive.Draw(Renderer::GetDeviceContext());
 
 	//㏈
-	ID3D11ShaderResourceView* nullSRV[1] = { nullptr };
-	Renderer::GetDeviceContext()->PSSetShaderResources(0, 1, nullSRV);
+	Renderer::SetTexture(nullptr);
 
 	//O̐ݒɖ߂
 	Renderer::SetDepthEnable(true);			//[xeXgiZobt@jL
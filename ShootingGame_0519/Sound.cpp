@@ -1,322 +1,247 @@
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#endif
 #include "Sound.h"
+#include <cstdio>
 #include <fstream>
+#include <filesystem>
 #include <algorithm>
+#ifdef _WIN32
+#include "XAudio2AudioBackend.h"
+#endif
 
-Microsoft::WRL::ComPtr<IXAudio2> Sound::m_XAudio2;
-IXAudio2MasteringVoice* Sound::m_MasterVoice = nullptr;
-IXAudio2SourceVoice* Sound::m_BgmVoice = nullptr;
-float Sound::m_BgmVolume = 0.7f;
-Sound::WavData Sound::m_BgmData;
-
-bool  Sound::m_IsFading = false;
-bool  Sound::m_FadeIn = true;
-float Sound::m_FadeTimer = 0.0f;
-float Sound::m_FadeDuration = 0.0f;
-float Sound::m_FadeStartVolume = 0.0f;
-float Sound::m_FadeTargetVolume = 0.0f;
-
-float Sound::m_SeVolume = 1.0f;
-std::unordered_map<std::wstring, Sound::WavData> Sound::m_SeCache;
-std::vector<Sound::SeVoiceEntry> Sound::m_SeVoices;
-
-static uint32_t ReadU32(std::ifstream& ifs)
+namespace
 {
-    uint32_t v = 0;
-    ifs.read(reinterpret_cast<char*>(&v), sizeof(v));
-    return v;
+    void Log(const std::string& message)
+    {
+#ifdef _WIN32
+        OutputDebugStringA(message.c_str());
+#else
+        fputs(message.c_str(), stderr);
+#endif
+    }
 }
 
-static uint16_t ReadU16(std::ifstream& ifs)
-{
-    uint16_t v = 0;
-    ifs.read(reinterpret_cast<char*>(&v), sizeof(v));
-    return v;
-}
+AudioMixer Sound::m_Mixer;
+std::unique_ptr<AudioBackend> Sound::m_Backend;
+AudioMixer::VoiceHandle Sound::m_BgmVoice = AudioMixer::INVALID_VOICE;
+float Sound::m_BgmVolume = 0.7f;
+std::unique_ptr<BgmStream> Sound::m_BgmStream;
+
+float Sound::m_SeVolume = 1.0f;
+AssetTable<SoundAssetTag, std::unique_ptr<Sound::WavData>> Sound::m_SeCache;
+SeVoicePool Sound::m_SePool;
+float Sound::m_Time = 0.0f;
+SeBank Sound::m_SeBank;
+int Sound::m_SeDiskLoads = 0;
 
-bool Sound::Init()
+bool Sound::Init(std::unique_ptr<AudioBackend> backend)
 {
-    HRESULT hr = XAudio2Create(m_XAudio2.ReleaseAndGetAddressOf(), 0, XAUDIO2_DEFAULT_PROCESSOR);
-    if (FAILED(hr))
+    if (!backend)
     {
-        return false;
+#ifdef _WIN32
+        backend = std::make_unique<XAudio2AudioBackend>();
+#else
+        backend = std::make_unique<NullAudioBackend>();
+#endif
     }
 
-    hr = m_XAudio2->CreateMasteringVoice(&m_MasterVoice);
-    if (FAILED(hr))
+    m_Mixer.SetBusGain(AUDIO_BUS_BGM, 1.0f);
+    m_Mixer.SetBusGain(AUDIO_BUS_SE, m_SeVolume);
+
+    if (!backend->Start(AudioMixer::OUTPUT_RATE, AudioMixer::OUTPUT_CHANNELS,
+        [](float* out, int frames) { m_Mixer.Render(out, frames); }))
     {
         return false;
     }
 
+    m_Backend = std::move(backend);
+    m_SePool.Init(&m_Mixer);
+    m_Time = 0.0f;
+
     return true;
 }
 
 void Sound::Update(float dt)
 {
-    // ---- BGMtF[hiOɍj----
-    if (m_IsFading)
+    if (dt > 0.0f)
     {
-        if (dt > 0.0f && m_BgmVoice)
-        {
-            m_FadeTimer += dt;
-
-            float t = 1.0f;
-            if (m_FadeDuration > 0.0f)
-            {
-                t = std::clamp(m_FadeTimer / m_FadeDuration, 0.0f, 1.0f);
-            }
-
-            float volume = m_FadeStartVolume + (m_FadeTargetVolume - m_FadeStartVolume) * t;
-            SetBgmVolume(volume);
-
-            if (t >= 1.0f)
-            {
-                m_IsFading = false;
-                if (!m_FadeIn)
-                {
-                    StopBgm();
-                }
-            }
-        }
-        else
-        {
-            m_IsFading = false;
-        }
+        m_Time += dt;
     }
 
-    // ---- SĚniĐVoicejj----
-    for (size_t i = 0; i < m_SeVoices.size();)
+    // foCXȂo͐͂Ń~bNXi
+    if (m_Backend)
     {
-        IXAudio2SourceVoice* v = m_SeVoices[i].voice;
-        if (!v)
-        {
-            m_SeVoices.erase(m_SeVoices.begin() + i);
-            continue;
-        }
-
-        XAUDIO2_VOICE_STATE st{};
-        v->GetState(&st);
-
-        if (st.BuffersQueued == 0)
-        {
-            v->Stop();
-            v->FlushSourceBuffers();
-            v->DestroyVoice();
-            m_SeVoices.erase(m_SeVoices.begin() + i);
-            continue;
-        }
+        m_Backend->Update(dt);
+    }
 
-        ++i;
+    // tF[hAEgIĎ~܂BGM̃Xg[
+    if (m_BgmVoice != AudioMixer::INVALID_VOICE && !m_Mixer.IsPlaying(m_BgmVoice))
+    {
+        StopBgm();
     }
+
+    // ---- ISẼ{CX󂫂ɖ߂ ----
+    m_SePool.Update();
 }
 
 void Sound::Uninit()
 {
+    // o͂~߂Ăg`EXg[̂Ă(render ǂł̂)
+    if (m_Backend)
+    {
+        m_Backend->Stop();
+        m_Backend.reset();
+    }
+
     StopAllSe();
     StopBgm();
 
-    if (m_MasterVoice)
-    {
-        m_MasterVoice->DestroyVoice();
-        m_MasterVoice = nullptr;
-    }
+    // }bvOɁAwĂLbV
+    ClearSeCache();
+    UnloadSeBank();
 
-    m_XAudio2.Reset();
+    m_SePool.Uninit();
 }
 
 
 void Sound::FadeInBgm(float targetVolume, float durationSec)
 {
     targetVolume = std::clamp(targetVolume, 0.0f, 1.0f);
-    durationSec = max(durationSec, 0.0f);
+    durationSec = std::max(durationSec, 0.0f);
 
-    if (!m_BgmVoice)
+    if (m_BgmVoice == AudioMixer::INVALID_VOICE)
     {
         return;
     }
 
-    m_IsFading = true;
-    m_FadeIn = true;
-    m_FadeTimer = 0.0f;
-    m_FadeDuration = durationSec;
-
-    m_FadeStartVolume = 0.0f;
-    m_FadeTargetVolume = targetVolume;
-
-    SetBgmVolume(0.0f);
+    // ʂ̕ὠ~LT[TvPʂōs
+    m_Mixer.SetGain(m_BgmVoice, 0.0f);
+    m_Mixer.SetGain(m_BgmVoice, targetVolume, durationSec);
+    m_BgmVolume = targetVolume;
 }
 
 void Sound::FadeOutBgm(float durationSec)
 {
-    durationSec = max(durationSec, 0.0f);
+    durationSec = std::max(durationSec, 0.0f);
 
-    if (!m_BgmVoice)
+    if (m_BgmVoice == AudioMixer::INVALID_VOICE)
     {
         return;
     }
 
-    m_IsFading = true;
-    m_FadeIn = false;
-    m_FadeTimer = 0.0f;
-    m_FadeDuration = durationSec;
-
-    m_FadeStartVolume = m_BgmVolume;
-    m_FadeTargetVolume = 0.0f;
+    // 0 ɂȂ~LT[Ŏ~܂(Xg[͎ Update ŕ)
+    m_Mixer.FadeOut(m_BgmVoice, durationSec);
 }
 
-const Sound::WavData* Sound::GetOrLoadSeWav(const std::wstring& filepath)
+const Sound::WavData* Sound::GetOrLoadSeWav(SoundId id, const wchar_t* filepath)
 {
-    auto it = m_SeCache.find(filepath);
-    if (it != m_SeCache.end())
+    if (auto* cached = m_SeCache.Find(id, filepath))
+    {
+        (*cached)->lastUsedFrame = ResidencyManager::GetFrame();
+        return cached->get();
+    }
+
+    // oNJĂ̂ɖ = ĂY(Q[Ƀt@CJƂɂȂ)
+    if (m_SeBank.IsOpen())
     {
-        return &it->second;
+        m_SeDiskLoads++;
+        std::string msg = "Sound: SE not in bank, loading from disk: ";
+        for (const wchar_t* c = filepath; *c; ++c)
+        {
+            msg.push_back(static_cast<char>(*c));
+        }
+        Log(msg + "\n");
     }
 
-    WavData wav{};
-    if (!LoadWavPcm(filepath, wav))
+    auto wav = std::make_unique<WavData>();
+    if (!LoadWavPcm(filepath, *wav))
     {
         return nullptr;
     }
 
-    auto res = m_SeCache.emplace(filepath, std::move(wav));
-    return &res.first->second;
+    for (const wchar_t* c = filepath; *c; ++c)
+    {
+        wav->name.push_back(static_cast<char>(*c));
+    }
+    wav->lastUsedFrame = ResidencyManager::GetFrame();
+    ResidencyManager::OnLoaded(RESIDENT_SOUND, wav->buffer.size());
+
+    return m_SeCache.Insert(id, filepath, std::move(wav)).get();
 }
 
 
 bool Sound::LoadWavPcm(const std::wstring& filepath, WavData& outData)
 {
-    std::ifstream ifs(filepath, std::ios::binary);
+    // 1őSǂłA`N̓łȂ߂
+    std::ifstream ifs(std::filesystem::path(filepath), std::ios::binary | std::ios::ate);
     if (!ifs.is_open())
     {
         return false;
     }
 
-    char riff[4]{};
-    ifs.read(riff, 4);
-    if (std::memcmp(riff, "RIFF", 4) != 0)
+    const std::streamoff size = ifs.tellg();
+    if (size <= 0)
     {
         return false;
     }
 
-    (void)ReadU32(ifs); // file size
-
-    char wave[4]{};
-    ifs.read(wave, 4);
-    if (std::memcmp(wave, "WAVE", 4) != 0)
+    std::vector<uint8_t> file(static_cast<size_t>(size));
+    ifs.seekg(0, std::ios::beg);
+    if (!ifs.read(reinterpret_cast<char*>(file.data()), size))
     {
         return false;
     }
 
-    bool foundFmt = false;
-    bool foundData = false;
-
-    WAVEFORMATEX fmt{};
-    std::vector<uint8_t> data;
-
-    while (ifs && (!foundFmt || !foundData))
-    {
-        char chunkId[4]{};
-        ifs.read(chunkId, 4);
-        if (!ifs)
-        {
-            break;
-        }
-
-        uint32_t chunkSize = ReadU32(ifs);
-
-        if (std::memcmp(chunkId, "fmt ", 4) == 0)
-        {
-            uint16_t audioFormat = ReadU16(ifs);
-            uint16_t numChannels = ReadU16(ifs);
-            uint32_t sampleRate = ReadU32(ifs);
-            uint32_t byteRate = ReadU32(ifs);
-            uint16_t blockAlign = ReadU16(ifs);
-            uint16_t bitsPerSample = ReadU16(ifs);
-
-            if (chunkSize > 16)
-            {
-                ifs.seekg(chunkSize - 16, std::ios::cur);
-            }
-
-            if (audioFormat != 1)
-            {
-                // PCMȊO͂̍ŏł͔Ή
-                return false;
-            }
-
-            fmt.wFormatTag = WAVE_FORMAT_PCM;
-            fmt.nChannels = numChannels;
-            fmt.nSamplesPerSec = sampleRate;
-            fmt.nAvgBytesPerSec = byteRate;
-            fmt.nBlockAlign = blockAlign;
-            fmt.wBitsPerSample = bitsPerSample;
-            fmt.cbSize = 0;
-
-            foundFmt = true;
-        }
-        else if (std::memcmp(chunkId, "data", 4) == 0)
-        {
-            data.resize(chunkSize);
-            ifs.read(reinterpret_cast<char*>(data.data()), chunkSize);
-            foundData = true;
-        }
-        else
-        {
-            ifs.seekg(chunkSize, std::ios::cur);
-        }
-    }
-
-    if (!foundFmt || !foundData)
+    // 16bit PCM(mEXeI)ȊO͂̍ŏł͔Ή
+    WavView view;
+    if (!SeBank::ParseWav(file.data(), file.size(), view))
     {
         return false;
     }
 
-    outData.format = fmt;
-    outData.buffer = std::move(data);
+    // RIFF wb_͎̕Ȃ(data `N̒gc)
+    outData.format = view.format;
+    outData.buffer.assign(view.data, view.data + view.bytes);
+    outData.data = outData.buffer.data();
+    outData.bytes = view.bytes;
     return true;
 }
 
+AudioClip Sound::MakeClip(const WavData& wav)
+{
+    AudioClip clip;
+    clip.samples = reinterpret_cast<const int16_t*>(wav.data);
+    clip.channels = wav.format.channels;
+    clip.sampleRate = static_cast<int>(wav.format.sampleRate);
+    clip.frames = wav.format.blockAlign > 0 ? wav.bytes / wav.format.blockAlign : 0;
+    return clip;
+}
+
 bool Sound::PlayBgmWav(const std::wstring& filepath, float volume)
 {
-    if (!m_XAudio2)
+    if (!m_Backend)
     {
         return false;
     }
 
     StopBgm();
 
-    WavData wav{};
-    if (!LoadWavPcm(filepath, wav))
-    {
-        return false;
-    }
+    // wb_ǂŕԂ(g͓ǂݍ݃XbhOɗ߂Ă)
+    const std::wstring path = BgmStream::HasFreshCompressed(filepath) ? BgmStream::GetCompressedPath(filepath) : filepath;
 
-    m_BgmData = std::move(wav);
-
-    HRESULT hr = m_XAudio2->CreateSourceVoice(&m_BgmVoice, &m_BgmData.format);
-    if (FAILED(hr))
+    auto stream = std::make_unique<BgmStream>();
+    if (!stream->Open(path, true))
     {
-        m_BgmVoice = nullptr;
         return false;
     }
 
-    XAUDIO2_BUFFER buf{};
-    buf.AudioBytes = static_cast<UINT32>(m_BgmData.buffer.size());
-    buf.pAudioData = m_BgmData.buffer.data();
-    buf.Flags = XAUDIO2_END_OF_STREAM;
-    buf.LoopCount = XAUDIO2_LOOP_INFINITE;
-
-    hr = m_BgmVoice->SubmitSourceBuffer(&buf);
-    if (FAILED(hr))
-    {
-        StopBgm();
-        return false;
-    }
+    m_BgmStream = std::move(stream);
 
     m_BgmVolume = std::clamp(volume, 0.0f, 1.0f);
-    m_BgmVoice->SetVolume(m_BgmVolume);
-
-    hr = m_BgmVoice->Start();
-    if (FAILED(hr))
+    m_BgmVoice = m_Mixer.PlayStream(m_BgmStream.get(), m_BgmVolume, AUDIO_BUS_BGM);
+    if (m_BgmVoice == AudioMixer::INVALID_VOICE)
     {
         StopBgm();
         return false;
@@ -325,77 +250,50 @@ bool Sound::PlayBgmWav(const std::wstring& filepath, float volume)
     return true;
 }
 
-bool Sound::PlaySeWav(const std::wstring& filepath, float volume)
+bool Sound::PlaySeWav(const std::wstring& filepath, float volume, const SeLimits& limits)
 {
-    if (!m_XAudio2)
-    {
-        return false;
-    }
-
-    const WavData* wav = GetOrLoadSeWav(filepath);
-    if (!wav)
-    {
-        return false;
-    }
-
-    IXAudio2SourceVoice* seVoice = nullptr;
-    HRESULT hr = m_XAudio2->CreateSourceVoice(&seVoice, &wav->format);
-    if (FAILED(hr) || !seVoice)
-    {
-        return false;
-    }
+    return PlaySe(SoundId::FromString(filepath), filepath.c_str(), volume, limits);
+}
 
-    XAUDIO2_BUFFER buf{};
-    buf.AudioBytes = static_cast<UINT32>(wav->buffer.size());
-    buf.pAudioData = wav->buffer.data();
-    buf.Flags = XAUDIO2_END_OF_STREAM;
+bool Sound::PlaySeWav(const SoundPath& path, float volume, const SeLimits& limits)
+{
+    return PlaySe(path.id, path.path, volume, limits);
+}
 
-    hr = seVoice->SubmitSourceBuffer(&buf);
-    if (FAILED(hr))
+bool Sound::PlaySe(SoundId id, const wchar_t* filepath, float volume, const SeLimits& limits)
+{
+    if (!m_Backend)
     {
-        seVoice->DestroyVoice();
         return false;
     }
 
-    float finalVol = std::clamp(volume, 0.0f, 1.0f) * std::clamp(m_SeVolume, 0.0f, 1.0f);
-    seVoice->SetVolume(finalVol);
-
-    hr = seVoice->Start();
-    if (FAILED(hr))
+    const WavData* wav = GetOrLoadSeWav(id, filepath);
+    if (!wav)
     {
-        seVoice->DestroyVoice();
         return false;
     }
 
-    SeVoiceEntry entry{};
-    entry.voice = seVoice;
-    entry.wav = wav;
-    m_SeVoices.push_back(entry);
-
-    return true;
+    // SE Ŝ̉ʂ̓~LT[̃oXŊ|
+    return m_SePool.Play(id, MakeClip(*wav), wav, std::clamp(volume, 0.0f, 1.0f), limits, m_Time);
 }
 
 
 void Sound::StopBgm()
 {
-    if (m_BgmVoice)
+    if (m_BgmVoice != AudioMixer::INVALID_VOICE)
     {
-        m_BgmVoice->Stop();
-        m_BgmVoice->FlushSourceBuffers();
-        m_BgmVoice->DestroyVoice();
-        m_BgmVoice = nullptr;
+        m_Mixer.Stop(m_BgmVoice);
+        m_BgmVoice = AudioMixer::INVALID_VOICE;
     }
 
-    m_BgmData.buffer.clear();
+    // ~LT[ǂ܂ȂȂĂ
+    m_BgmStream.reset();
 }
 
 void Sound::SetBgmVolume(float volume)
 {
     m_BgmVolume = std::clamp(volume, 0.0f, 1.0f);
-    if (m_BgmVoice)
-    {
-        m_BgmVoice->SetVolume(m_BgmVolume);
-    }
+    m_Mixer.SetGain(m_BgmVoice, m_BgmVolume);
 }
 
 float Sound::GetBgmVolume()
@@ -406,6 +304,7 @@ float Sound::GetBgmVolume()
 void Sound::SetSeVolume(float volume)
 {
     m_SeVolume = std::clamp(volume, 0.0f, 1.0f);
+    m_Mixer.SetBusGain(AUDIO_BUS_SE, m_SeVolume);
 }
 
 float Sound::GetSeVolume()
@@ -413,24 +312,160 @@ float Sound::GetSeVolume()
     return m_SeVolume;
 }
 
+const SeVoicePool::Stats& Sound::GetSeStats()
+{
+    return m_SePool.GetStats();
+}
+
+AudioMixer::Stats Sound::GetMixerStats()
+{
+    return m_Mixer.GetStats();
+}
+
+BgmStream::Stats Sound::GetBgmStats()
+{
+    return m_BgmStream ? m_BgmStream->GetStats() : BgmStream::Stats{};
+}
+
+const char* Sound::GetBackendName()
+{
+    return m_Backend ? m_Backend->GetName() : "none";
+}
+
 void Sound::StopAllSe()
 {
-    for (auto& e : m_SeVoices)
+    m_SePool.StopAll();
+}
+
+void Sound::ClearSeCache()
+{
+    // ĐSEƎQƂĉŎ~߂Ă
+    StopAllSe();
+
+    std::vector<SoundId> loose;
+    m_SeCache.ForEach([&](SoundId id, std::unique_ptr<WavData>& wav)
     {
-        if (e.voice)
+        if (!wav->fromBank)
         {
-            e.voice->Stop();
-            e.voice->FlushSourceBuffers();
-            e.voice->DestroyVoice();
-            e.voice = nullptr;
+            ResidencyManager::OnReleased(RESIDENT_SOUND, wav->buffer.size());
+            loose.push_back(id);
         }
+    });
+    for (SoundId id : loose)
+    {
+        m_SeCache.Erase(id);
     }
-    m_SeVoices.clear();
 }
 
-void Sound::ClearSeCache()
+bool Sound::LoadSeBank(const std::wstring& filepath)
 {
-    // ĐSEƎQƂĉŎ~߂Ă
+    if (m_SeBank.IsOpen())
+    {
+        return true;
+    }
+
+    if (!m_SeBank.Open(filepath))
+    {
+        return false;
+    }
+
+    for (const SeBank::Entry& entry : m_SeBank.GetEntries())
+    {
+        //  .wav ǂł́AĂȂ΃oN̕ɍւ
+        if (auto* cached = m_SeCache.Find(entry.id, entry.name))
+        {
+            if (IsSePlaying(cached->get()))
+            {
+                continue;
+            }
+            ResidencyManager::OnReleased(RESIDENT_SOUND, (*cached)->buffer.size());
+        }
+
+        auto wav = std::make_unique<WavData>();
+        wav->format = entry.format;
+        wav->data = entry.data;
+        wav->bytes = entry.bytes;
+        wav->name = entry.name;
+        wav->fromBank = true;
+        m_SeCache.Insert(entry.id, entry.name, std::move(wav));
+    }
+
+    char buf[256];
+    snprintf(buf, sizeof(buf), "Sound: SE bank loaded (%zu sounds, %zu KB mapped)\n",
+        m_SeBank.GetEntries().size(), m_SeBank.GetMappedBytes() / 1024);
+    Log(buf);
+
+    return true;
+}
+
+void Sound::UnloadSeBank()
+{
+    if (!m_SeBank.IsOpen())
+    {
+        return;
+    }
+
+    // oNwĂ{CX~߂ĂALbVƃ}bv
     StopAllSe();
-    m_SeCache.clear();
+
+    std::vector<SoundId> banked;
+    m_SeCache.ForEach([&](SoundId id, std::unique_ptr<WavData>& wav)
+    {
+        if (wav->fromBank)
+        {
+            banked.push_back(id);
+        }
+    });
+    for (SoundId id : banked)
+    {
+        m_SeCache.Erase(id);
+    }
+
+    m_SeBank.Close();
+}
+
+Sound::SeBankStats Sound::GetSeBankStats()
+{
+    SeBankStats stats;
+    stats.sounds = static_cast<int>(m_SeBank.GetEntries().size());
+    stats.mappedBytes = m_SeBank.GetMappedBytes();
+    stats.diskLoads = m_SeDiskLoads;
+    return stats;
+}
+
+bool Sound::IsSePlaying(const WavData* wav)
+{
+    return m_SePool.IsPlaying(wav);
+}
+
+void Sound::GatherResidentSe(std::vector<ResidentAsset>& out)
+{
+    m_SeCache.ForEach([&](SoundId id, std::unique_ptr<WavData>& wav)
+    {
+        // oN̓̕}bvƏ풓(\Z̑ΏۊO)
+        if (wav->fromBank)
+        {
+            return;
+        }
+
+        ResidentAsset asset;
+        asset.id = id.value;
+        asset.bytes = wav->buffer.size();
+        asset.lastUsedFrame = wav->lastUsedFrame;
+        asset.referenced = IsSePlaying(wav.get());
+        asset.name = wav->name.c_str();
+        out.push_back(asset);
+    });
+}
+
+bool Sound::EvictSe(uint64_t id)
+{
+    auto* wav = m_SeCache.Find(SoundId(id));
+    if (!wav || (*wav)->fromBank || IsSePlaying(wav->get()))
+    {
+        return false;
+    }
+
+    ResidencyManager::OnReleased(RESIDENT_SOUND, (*wav)->buffer.size());
+    return m_SeCache.Erase(SoundId(id));
 }
\ No newline at end of file
@@ -1,29 +1,56 @@
 #pragma once
-#include <wrl/client.h>
-#include <xaudio2.h>
 #include <cstdint>
 #include <string>
 #include <vector>
-#include <unordered_map>
+#include <memory>
+#include "AssetTable.h"
+#include "ResidencyManager.h"
+#include "SeVoicePool.h"
+#include "AudioMixer.h"
+#include "AudioBackend.h"
+#include "BgmStream.h"
+#include "SeBank.h"
 
+//---------------------------------------------------------
+// BGMESE ̍Đ
+// ͑S AudioMixer ōĂ AudioBackend ɓn
+// (Q[ XAudio2AwbhXsł Null / WAV o)
+//---------------------------------------------------------
 class Sound
 {
 public:
-    static bool Init();
+    //backend : o͐(nullptr Ȃ XAudio2BWindows ȊOł Null)
+    static bool Init(std::unique_ptr<AudioBackend> backend = nullptr);
     static void Update(float dt);
     static void Uninit();
 
     //--------BGM֘A-------
+    //t@C͓ǂݍ݃Xbhǂ(<filepath>.adpcm ΂𗬂)
     static bool PlayBgmWav(const std::wstring& filepath, float volume = 0.7f);
     static void StopBgm();
     static void FadeInBgm(float targetVolume, float durationSec);
     static void FadeOutBgm(float durationSec);
 
     //--------SE֘A-------
-    static bool PlaySeWav(const std::wstring& filepath, float volume = 1.0f);
+    static bool PlaySeWav(const std::wstring& filepath, float volume = 1.0f, const SeLimits& limits = SeLimits{});
+    //t[炷͂(ID ̓RpCɌvZς)
+    //limits : EDxEAł̊Ԉ(SeVoicePool.h)
+    static bool PlaySeWav(const SoundPath& path, float volume = 1.0f, const SeLimits& limits = SeLimits{});
     static void StopAllSe();
+    //SE oN͎̕c(ǂݍݒȂĂ̂)
     static void ClearSeCache();
 
+    //--------SE oN(V[̏Oɓǂł)-------
+    //oN SE ̓}bv܂ܖ炷(t@CJȂERs[Ȃ)
+    //JĂΉȂB false ŁASE ͍܂Œʂ1ǂ
+    static bool LoadSeBank(const std::wstring& filepath);
+    static void UnloadSeBank();
+
+    //--------풓Ǘ(ResidencyManager ɓo^)-------
+    //Đ̃{CXgĂ SE ͊OȂ
+    static void GatherResidentSe(std::vector<ResidentAsset>& out);
+    static bool EvictSe(uint64_t id);
+
     //--------Set֐-------
     static void SetBgmVolume(float volume);
     static void SetSeVolume(float volume);
@@ -31,42 +58,52 @@ public:
     //--------Get֐-------
     static float GetBgmVolume();
     static float GetSeVolume();
+    static const SeVoicePool::Stats& GetSeStats();
+    static AudioMixer::Stats GetMixerStats();
+    //BGM 𗬂ĂȂ͋
+    static BgmStream::Stats GetBgmStats();
+    static const char* GetBackendName();
 
-private:
-    struct WavData
+    struct SeBankStats
     {
-        WAVEFORMATEX format{};
-        std::vector<uint8_t> buffer;
+        int sounds = 0;         // oNo^ SE ̐
+        size_t mappedBytes = 0;
+        int diskLoads = 0;      // oNJ .wav ǂ݂ɍs(0 ̂͂)
     };
+    static SeBankStats GetSeBankStats();
 
-    struct SeVoiceEntry
+private:
+    struct WavData
     {
-        IXAudio2SourceVoice* voice = nullptr;
-        const WavData* wav = nullptr; // LbVQƁiobt@mہj
+        WavFormat format;
+        const uint8_t* data = nullptr;  // buffer ̒ASE oÑ}bv̒
+        uint32_t bytes = 0;
+        std::vector<uint8_t> buffer;    // .wav ǂ񂾎g
+        std::string name;               // |[gp
+        uint64_t lastUsedFrame = 0;
+        bool fromBank = false;          // 풓ǗŊOȂ(oN鎞ɂ܂Ƃ߂ď)
     };
 
     static bool LoadWavPcm(const std::wstring& filepath, WavData& outData);
-    static const WavData* GetOrLoadSeWav(const std::wstring& filepath);
+    static AudioClip MakeClip(const WavData& wav);
+    static const WavData* GetOrLoadSeWav(SoundId id, const wchar_t* filepath);
+    static bool PlaySe(SoundId id, const wchar_t* filepath, float volume, const SeLimits& limits);
+    static bool IsSePlaying(const WavData* wav);
 
-    static Microsoft::WRL::ComPtr<IXAudio2> m_XAudio2;
-    static IXAudio2MasteringVoice* m_MasterVoice;
+    static AudioMixer m_Mixer;
+    static std::unique_ptr<AudioBackend> m_Backend;
 
-    //--------------BGM֘A------------------
-    static IXAudio2SourceVoice* m_BgmVoice;
+    //--------------BGM֘A(tF[h̓~LT[̃{CX̉ʂōs)------------------
+    static AudioMixer::VoiceHandle m_BgmVoice;
     static float m_BgmVolume;
-    static WavData m_BgmData;
-
-    //--------------BGMtF[h֘A------------------
-    static bool m_IsFading;
-    static bool m_FadeIn;
-    static float m_FadeTimer;
-    static float m_FadeDuration;
-    static float m_FadeStartVolume;
-    static float m_FadeTargetVolume;
+    static std::unique_ptr<BgmStream> m_BgmStream;
 
     //--------------SE֘A------------------
     static float m_SeVolume;
-    static std::unordered_map<std::wstring, WavData> m_SeCache;
-    static std::vector<SeVoiceEntry> m_SeVoices;
+    static AssetTable<SoundAssetTag, std::unique_ptr<WavData>> m_SeCache; // Ă{CX WavData ŵ unique_ptr Ŏ
+    static SeVoicePool m_SePool;   // {CX͎g(ĂԂ WavData wĂ)
+    static float m_Time;           // Ał̊Ԉp̌oߎ
+    static SeBank m_SeBank;
+    static int m_SeDiskLoads;
 };
 
@@ -1,4 +1,5 @@
 #include "SphereComponent.h"
+#include <d3d11.h>
 #include "Renderer.h"
 #include "GameObject.h"
 #include <cassert>
@@ -11,7 +12,7 @@ static std::shared_ptr<Primitive> s_sharedSphere = nullptr;
 void SphereComponent::Initialize()
 {
     ID3D11Device* device = Renderer::GetDevice();
-    assert(device && "Renderer::GetDevice() is null in SphereComponent::Initialize");
+    assert((device || Renderer::IsHeadless()) && "Renderer::GetDevice() is null in SphereComponent::Initialize");
 
     if (!s_sharedSphere)
     {
@@ -0,0 +1,452 @@
+#define NOMINMAX
+#include <windows.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include "StageCache.h"
+#include "MappedFile.h"
+#include "RandomService.h"
+
+using namespace DirectX::SimpleMath;
+
+namespace
+{
+    constexpr char STAGE_MAGIC[4] = { 'S', 'T', 'G', 'C' };
+    constexpr uint32_t STAGE_VERSION = 1;
+
+    constexpr uint32_t STAGE_FLAG_CENTER_ROWS = 1u << 0;
+    constexpr uint32_t STAGE_FLAG_CELLS_8BIT = 1u << 1;     //}XS 0 ` 255 Ȃ1oCgŎ
+
+    //uꏊ}X̒l̏(傫l̓Obhɂc)
+    constexpr int MAX_PLACEMENT_VALUE = 255;
+
+    struct StageHeader
+    {
+        char magic[4];
+        uint32_t version;
+        int32_t rows;
+        int32_t cols;
+        float cellSize;
+        float baseY;
+        uint32_t flags;
+        uint32_t valueCount;    //placements ̐(l 0 ` valueCount - 1)
+    };
+    static_assert(sizeof(StageHeader) == 32, "StageCache header layout");
+    static_assert(sizeof(Vector3) == sizeof(float) * 3, "Vector3 is written as 3 floats");
+
+    bool SameLayout(const StageHeader& header, const StageLayout& layout)
+    {
+        const bool centerRows = (header.flags & STAGE_FLAG_CENTER_ROWS) != 0;
+        return header.cellSize == layout.cellSize && header.baseY == layout.baseY &&
+               centerRows == layout.centerRows;
+    }
+
+    const std::vector<Vector3> EMPTY_PLACEMENTS;
+}
+
+StageCache::Stats StageCache::m_stats;
+
+const std::vector<Vector3>& StageData::GetPlacements(int value) const
+{
+    if (value <= 0 || value >= static_cast<int>(placements.size()))
+    {
+        return EMPTY_PLACEMENTS;
+    }
+    return placements[value];
+}
+
+bool StageCache::Load(const std::string& csvPath, const StageLayout& layout, StageData& out)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    const std::string cachePath = GetCachePath(csvPath);
+    bool fromCache = HasFreshCache(csvPath) && Read(cachePath, layout, out);
+
+    if (!fromCache)
+    {
+        StageGrid grid;
+        if (!CsvGridLoader::LoadFlatGrid(csvPath, grid))
+        {
+            OutputDebugStringA(("StageCache: cannot load " + csvPath + "\n").c_str());
+            out = StageData();
+            return false;
+        }
+
+        Build(grid, layout, out);
+        out.grid = std::move(grid);
+
+        //ȂĂ̓ǂݍ݂͐( CSV )
+        Write(cachePath, out);
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    m_stats.fromCache = fromCache;
+    m_stats.loadMs = static_cast<float>(std::chrono::duration<double, std::milli>(end - start).count());
+    m_stats.rows = out.grid.rows;
+    m_stats.cols = out.grid.cols;
+    m_stats.placements = 0;
+    for (const auto& list : out.placements)
+    {
+        m_stats.placements += static_cast<int>(list.size());
+    }
+    return true;
+}
+
+void StageCache::Build(const StageGrid& grid, const StageLayout& layout, StageData& out)
+{
+    out.layout = layout;
+    out.placements.clear();
+
+    //lƂ̐ɐāAuꏊ̔z1񂸂mۂ
+    size_t counts[MAX_PLACEMENT_VALUE + 1] = {};
+    for (int value : grid.cells)
+    {
+        if (static_cast<unsigned>(value) <= MAX_PLACEMENT_VALUE)
+        {
+            counts[value]++;
+        }
+    }
+
+    int maxValue = MAX_PLACEMENT_VALUE;
+    while (maxValue > 0 && counts[maxValue] == 0)
+    {
+        --maxValue;
+    }
+    if (maxValue == 0)
+    {
+        return;
+    }
+
+    out.placements.resize(static_cast<size_t>(maxValue) + 1);
+    for (int v = 1; v <= maxValue; ++v)
+    {
+        out.placements[v].reserve(counts[v]);
+    }
+
+    //GameScene / GameForwardScene ̒u(͐^񒆂 0)
+    const int centerCol = grid.cols / 2;
+    const int centerRow = layout.centerRows ? grid.rows / 2 : 0;
+
+    for (int row = 0; row < grid.rows; ++row)
+    {
+        const int* line = &grid.cells[static_cast<size_t>(row) * grid.cols];
+        const float z = static_cast<float>(row - centerRow) * layout.cellSize;
+
+        for (int col = 0; col < grid.cols; ++col)
+        {
+            const int value = line[col];
+            if (value <= 0 || value > maxValue)
+            {
+                continue;
+            }
+
+            const float x = static_cast<float>(col - centerCol) * layout.cellSize;
+            out.placements[value].push_back(Vector3(x, layout.baseY, z));
+        }
+    }
+}
+
+bool StageCache::Write(const std::string& path, const StageData& data)
+{
+    const StageGrid& grid = data.grid;
+    if (grid.IsEmpty())
+    {
+        return false;
+    }
+
+    bool cells8bit = true;
+    for (int value : grid.cells)
+    {
+        if (value < 0 || value > 255)
+        {
+            cells8bit = false;
+            break;
+        }
+    }
+
+    StageHeader header{};
+    memcpy(header.magic, STAGE_MAGIC, 4);
+    header.version = STAGE_VERSION;
+    header.rows = grid.rows;
+    header.cols = grid.cols;
+    header.cellSize = data.layout.cellSize;
+    header.baseY = data.layout.baseY;
+    header.flags = (data.layout.centerRows ? STAGE_FLAG_CENTER_ROWS : 0) | (cells8bit ? STAGE_FLAG_CELLS_8BIT : 0);
+    header.valueCount = static_cast<uint32_t>(data.placements.size());
+
+    //rŗĂꂽLbVcȂ悤ɁAIĂ獷ւ
+    const std::string tempPath = path + ".tmp";
+    FILE* fp = nullptr;
+    if (fopen_s(&fp, tempPath.c_str(), "wb") != 0 || !fp)
+    {
+        OutputDebugStringA(("StageCache: cannot write " + path + "\n").c_str());
+        return false;
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1;
+
+    if (cells8bit)
+    {
+        std::vector<uint8_t> packed(grid.cells.begin(), grid.cells.end());
+        ok = ok && fwrite(packed.data(), 1, packed.size(), fp) == packed.size();
+    }
+    else
+    {
+        ok = ok && fwrite(grid.cells.data(), sizeof(int32_t), grid.cells.size(), fp) == grid.cells.size();
+    }
+
+    for (const auto& list : data.placements)
+    {
+        const uint32_t count = static_cast<uint32_t>(list.size());
+        ok = ok && fwrite(&count, sizeof(count), 1, fp) == 1;
+    }
+    for (const auto& list : data.placements)
+    {
+        ok = ok && fwrite(list.data(), sizeof(Vector3), list.size(), fp) == list.size();
+    }
+    fclose(fp);
+
+    std::error_code ec;
+    if (ok)
+    {
+        std::filesystem::rename(tempPath, path, ec);
+    }
+    if (!ok || ec)
+    {
+        std::filesystem::remove(tempPath, ec);
+        OutputDebugStringA(("StageCache: cannot write " + path + "\n").c_str());
+        return false;
+    }
+    return true;
+}
+
+bool StageCache::Read(const std::string& path, const StageLayout& layout, StageData& out)
+{
+    out = StageData();
+
+    MappedFile file;
+    if (!file.Open(std::filesystem::path(path).wstring()))
+    {
+        return false;
+    }
+
+    const uint8_t* base = file.GetData();
+    const size_t size = file.GetSize();
+
+    //ꂽt@Cǂł͈͊OwȂ悤ɑSm߂
+    auto fail = [&](const char* reason)
+    {
+        OutputDebugStringA(("StageCache: " + path + " : " + reason + "\n").c_str());
+        out = StageData();
+        return false;
+    };
+
+    if (size < sizeof(StageHeader)) { return fail("file is too small"); }
+
+    StageHeader header;
+    memcpy(&header, base, sizeof(header));
+    if (memcmp(header.magic, STAGE_MAGIC, 4) != 0 || header.version != STAGE_VERSION)
+    {
+        return fail("bad magic or version");
+    }
+
+    //uႤLbV͎gȂ(Ăяoō蒼ď㏑)
+    if (!SameLayout(header, layout))
+    {
+        return false;
+    }
+
+    if (header.rows <= 0 || header.cols <= 0 || header.valueCount > MAX_PLACEMENT_VALUE + 1)
+    {
+        return fail("bad grid size");
+    }
+
+    const size_t cellCount = static_cast<size_t>(header.rows) * header.cols;
+    const bool cells8bit = (header.flags & STAGE_FLAG_CELLS_8BIT) != 0;
+    const size_t cellBytes = cellCount * (cells8bit ? 1 : sizeof(int32_t));
+    const size_t countsOffset = sizeof(StageHeader) + cellBytes;
+    const size_t positionsOffset = countsOffset + header.valueCount * sizeof(uint32_t);
+    if (size < positionsOffset) { return fail("truncated"); }
+
+    std::vector<uint32_t> counts(header.valueCount);
+    memcpy(counts.data(), base + countsOffset, counts.size() * sizeof(uint32_t));
+
+    size_t totalPlacements = 0;
+    for (uint32_t count : counts)
+    {
+        totalPlacements += count;
+    }
+    if (size != positionsOffset + totalPlacements * sizeof(Vector3)) { return fail("size mismatch"); }
+
+    //}X
+    out.grid.rows = header.rows;
+    out.grid.cols = header.cols;
+    out.grid.cells.resize(cellCount);
+    const uint8_t* cells = base + sizeof(StageHeader);
+    if (cells8bit)
+    {
+        std::copy(cells, cells + cellCount, out.grid.cells.begin());
+    }
+    else
+    {
+        memcpy(out.grid.cells.data(), cells, cellBytes);
+    }
+
+    //uꏊ͂̂܂܎ʂ
+    out.layout = layout;
+    out.placements.resize(header.valueCount);
+    const uint8_t* positions = base + positionsOffset;
+    for (size_t v = 0; v < counts.size(); ++v)
+    {
+        out.placements[v].resize(counts[v]);
+        memcpy(out.placements[v].data(), positions, counts[v] * sizeof(Vector3));
+        positions += counts[v] * sizeof(Vector3);
+    }
+    return true;
+}
+
+bool StageCache::HasFreshCache(const std::string& csvPath)
+{
+    std::error_code ec;
+    const std::string cachePath = GetCachePath(csvPath);
+    if (!std::filesystem::exists(cachePath, ec))
+    {
+        return false;
+    }
+
+    //CSV ̌ÂLbV͎gȂ
+    const auto cacheTime = std::filesystem::last_write_time(cachePath, ec);
+    if (ec) { return false; }
+
+    const auto csvTime = std::filesystem::last_write_time(csvPath, ec);
+    if (ec) { return true; }    //CSV ΃LbVŗǂ
+
+    return cacheTime >= csvTime;
+}
+
+void StageCache::RunStageBenchmark(std::vector<std::string>& outLines)
+{
+    struct Size { int cols; int rows; };
+    const Size sizes[] = { { 9, 13 }, { 64, 64 }, { 256, 256 }, { 1024, 1024 }, { 4096, 4096 } };
+
+    std::error_code ec;
+    const std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+    if (ec)
+    {
+        outLines.push_back("Stage load benchmark: no temp directory");
+        return;
+    }
+    const std::string csvPath = (dir / "stage_benchmark.csv").string();
+    const std::string cachePath = GetCachePath(csvPath);
+
+    char buf[256];
+    outLines.push_back("Stage load benchmark (ms / load, csv = file bytes)");
+
+    //FreeStage01 Ɠ炢̊̊(1  12%A2  3%)
+    RandomStream rng(12345, 0);
+    StageLayout layout;
+    layout.baseY = -12.0f;
+
+    for (const Size& s : sizes)
+    {
+        std::string text;
+        text.reserve(static_cast<size_t>(s.cols) * s.rows * 2);
+        for (int row = 0; row < s.rows; ++row)
+        {
+            for (int col = 0; col < s.cols; ++col)
+            {
+                const float r = rng.NextFloat();
+                text += (r < 0.12f) ? '1' : (r < 0.15f) ? '2' : '0';
+                text += (col + 1 < s.cols) ? ',' : '\n';
+            }
+        }
+
+        FILE* fp = nullptr;
+        if (fopen_s(&fp, csvPath.c_str(), "wb") != 0 || !fp)
+        {
+            outLines.push_back("Stage load benchmark: cannot write " + csvPath);
+            return;
+        }
+        fwrite(text.data(), 1, text.size(), fp);
+        fclose(fp);
+
+        //Obh͉񂩉񂵂ĕς
+        const size_t cells = static_cast<size_t>(s.cols) * s.rows;
+        const int iterations = static_cast<int>(std::clamp<size_t>((1u << 20) / cells, 1, 200));
+
+        auto measure = [iterations](auto&& fn)
+        {
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < iterations; ++i)
+            {
+                fn();
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+        };
+
+        //getline  + GameScene Ɠ2d[vł̒uꏊ
+        size_t legacyCount = 0;
+        const double legacyMs = measure([&]()
+        {
+            auto grid = CsvGridLoader::LoadGrid(csvPath);
+            std::vector<Vector3> type1;
+            std::vector<Vector3> type2;
+            const int centerCol = grid.empty() ? 0 : static_cast<int>(grid[0].size()) / 2;
+            const int centerRow = static_cast<int>(grid.size()) / 2;
+            for (int row = 0; row < static_cast<int>(grid.size()); ++row)
+            {
+                for (int col = 0; col < static_cast<int>(grid[row].size()); ++col)
+                {
+                    const Vector3 pos(static_cast<float>(col - centerCol) * layout.cellSize, layout.baseY,
+                                      static_cast<float>(row - centerRow) * layout.cellSize);
+                    if (grid[row][col] == 1) { type1.push_back(pos); }
+                    else if (grid[row][col] == 2) { type2.push_back(pos); }
+                }
+            }
+            legacyCount = type1.size() + type2.size();
+        });
+
+        //}bv + from_chars + uꏊ
+        StageData flat;
+        const double flatMs = measure([&]()
+        {
+            StageGrid grid;
+            CsvGridLoader::LoadFlatGrid(csvPath, grid);
+            Build(grid, layout, flat);
+            flat.grid = std::move(grid);
+        });
+
+        //LbV
+        Write(cachePath, flat);
+        const size_t cacheBytes = static_cast<size_t>(std::filesystem::file_size(cachePath, ec));
+        StageData cached;
+        const double cacheMs = measure([&]()
+        {
+            Read(cachePath, layout, cached);
+        });
+
+        //3ƂuꏊɂȂĂ邩
+        bool match = cached.grid.cells == flat.grid.cells && cached.placements.size() == flat.placements.size();
+        size_t flatCount = 0;
+        for (size_t v = 0; match && v < flat.placements.size(); ++v)
+        {
+            match = flat.placements[v].size() == cached.placements[v].size() &&
+                    (flat.placements[v].empty() ||
+                     memcmp(flat.placements[v].data(), cached.placements[v].data(), flat.placements[v].size() * sizeof(Vector3)) == 0);
+            flatCount += flat.placements[v].size();
+        }
+        match = match && flatCount == legacyCount;
+
+        sprintf_s(buf, "  %4dx%-4d : getline %9.3f, mapped %8.3f (x%.1f), cache %8.3f (x%.1f) | csv %zu KB, cache %zu KB, %zu placements%s",
+            s.cols, s.rows, legacyMs, flatMs, legacyMs / std::max(flatMs, 1e-6), cacheMs, legacyMs / std::max(cacheMs, 1e-6),
+            text.size() / 1024, cacheBytes / 1024, flatCount, match ? "" : " MISMATCH");
+        outLines.push_back(buf);
+    }
+
+    std::filesystem::remove(csvPath, ec);
+    std::filesystem::remove(cachePath, ec);
+}
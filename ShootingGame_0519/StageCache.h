@@ -0,0 +1,67 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <SimpleMath.h>
+#include "CsvGridLoader.h"
+
+//---------------------------------------------------------
+// Xe[W̔zu(CSV)ǂݍŁA}X̒lƂ̒uꏊ܂ōNX
+// ʂ CSV ̉ <csv>.stage ɏĂA͂}bvĎʂɂ
+// (CSV ̕VEuႤ CSV 蒼ď)
+// <csv>.stage : wb_E}X(S 0 ` 255 Ȃ 1 oCg)ElƂ̐Euꏊ(float x3)
+//---------------------------------------------------------
+
+//}Xuꏊւ̕ϊ
+struct StageLayout
+{
+    float cellSize = 45.0f;
+    float baseY = 0.0f;
+    bool centerRows = true;     //false Ȃ1sڂ z = 0(GameForwardScene)
+};
+
+struct StageData
+{
+    StageGrid grid;
+    StageLayout layout;
+
+    //}X̒lƂ̒uꏊ(sD̏B0 ͋󂫂Ȃ̂ŏɋ)
+    std::vector<std::vector<DirectX::SimpleMath::Vector3>> placements;
+
+    const std::vector<DirectX::SimpleMath::Vector3>& GetPlacements(int value) const;
+};
+
+class StageCache
+{
+public:
+    //߂ Load ̌
+    struct Stats
+    {
+        bool fromCache = false;
+        float loadMs = 0.0f;
+        int rows = 0;
+        int cols = 0;
+        int placements = 0;
+    };
+
+    //<csv>.stage V΂A CSV ďo
+    static bool Load(const std::string& csvPath, const StageLayout& layout, StageData& out);
+
+    //ObhlƂ̒uꏊ
+    static void Build(const StageGrid& grid, const StageLayout& layout, StageData& out);
+
+    static bool Write(const std::string& path, const StageData& data);
+    static bool Read(const std::string& path, const StageLayout& layout, StageData& out);
+
+    static std::string GetCachePath(const std::string& csvPath) { return csvPath + ".stage"; }
+
+    //--------Get֐-------
+    static const Stats& GetStats() { return m_stats; }
+
+    //9x13 ` 4096x4096  getline ŁE}bvŁELbVׂ(DebugBenchmark ɓo^)
+    static void RunStageBenchmark(std::vector<std::string>& outLines);
+
+private:
+    static bool HasFreshCache(const std::string& csvPath);
+
+    static Stats m_stats;
+};
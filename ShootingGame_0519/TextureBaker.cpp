@@ -0,0 +1,277 @@
+#include <cstdio>
+#include <chrono>
+#include <cctype>
+#include <algorithm>
+#include <filesystem>
+#include <windows.h>
+#include <wincodec.h>
+#include <wrl/client.h>
+#include "TextureBaker.h"
+#include "TextureManager.h"
+
+using Microsoft::WRL::ComPtr;
+
+namespace
+{
+    //舫(dB)kʂ͏oɌ̉摜g킹
+    constexpr double MIN_PSNR = 30.0;
+
+    //R\[ƃfobOo̗͂ɏo
+    void Print(const char* text)
+    {
+        printf("%s\n", text);
+        OutputDebugStringA(text);
+        OutputDebugStringA("\n");
+    }
+
+    bool IsImageFile(const std::filesystem::path& path)
+    {
+        std::string ext = path.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(tolower(c)); });
+        return ext == ".png" || ext == ".jpg" || ext == ".jpeg";
+    }
+
+    //fBNgWJĉ摜t@C̈ꗗɂ
+    std::vector<std::string> CollectImages(const std::vector<std::string>& paths)
+    {
+        std::vector<std::string> result;
+        for (const auto& path : paths)
+        {
+            std::error_code ec;
+            if (std::filesystem::is_directory(path, ec))
+            {
+                for (const auto& entry : std::filesystem::recursive_directory_iterator(path, ec))
+                {
+                    if (entry.is_regular_file() && IsImageFile(entry.path()))
+                    {
+                        result.push_back(entry.path().generic_string());
+                    }
+                }
+            }
+            else
+            {
+                result.push_back(path);
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    //WICTextureLoader ƓAPNG  sRGB/gAMA `N JPEG  EXIF Ŕ肷
+    bool IsSrgbImage(IWICBitmapFrameDecode* frame, const GUID& container)
+    {
+        ComPtr<IWICMetadataQueryReader> reader;
+        if (FAILED(frame->GetMetadataQueryReader(reader.GetAddressOf())))
+        {
+            return false;
+        }
+
+        PROPVARIANT value;
+        PropVariantInit(&value);
+
+        bool srgb = false;
+        if (container == GUID_ContainerFormatPng)
+        {
+            if (SUCCEEDED(reader->GetMetadataByName(L"/sRGB/RenderingIntent", &value)) && value.vt == VT_UI1)
+            {
+                srgb = true;
+            }
+            else if (SUCCEEDED(reader->GetMetadataByName(L"/gAMA/ImageGamma", &value)) && value.vt == VT_UI4)
+            {
+                srgb = (value.uintVal == 45455);
+            }
+        }
+        else if (container == GUID_ContainerFormatJpeg)
+        {
+            if (SUCCEEDED(reader->GetMetadataByName(L"/app1/ifd/exif/{ushort=40961}", &value)) && value.vt == VT_UI2)
+            {
+                srgb = (value.uiVal == 1);
+            }
+        }
+
+        PropVariantClear(&value);
+        return srgb;
+    }
+
+    bool ParseFormat(const std::string& name, bool& autoFormat, BLOCK_FORMAT& format)
+    {
+        autoFormat = false;
+        if (name == "auto") { autoFormat = true; format = BLOCK_BC7; return true; }
+        if (name == "bc1") { format = BLOCK_BC1; return true; }
+        if (name == "bc3") { format = BLOCK_BC3; return true; }
+        if (name == "bc7") { format = BLOCK_BC7; return true; }
+        return false;
+    }
+
+    float ElapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+bool TextureBaker::LoadImageRGBA(const std::string& path, ImageRGBA& out, bool& srgb)
+{
+    ComPtr<IWICImagingFactory> factory;
+    HRESULT hr = CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER, IID_PPV_ARGS(factory.GetAddressOf()));
+    if (FAILED(hr)) { return false; }
+
+    std::wstring wpath(path.begin(), path.end());
+
+    ComPtr<IWICBitmapDecoder> decoder;
+    hr = factory->CreateDecoderFromFilename(wpath.c_str(), nullptr, GENERIC_READ, WICDecodeMetadataCacheOnDemand, decoder.GetAddressOf());
+    if (FAILED(hr)) { return false; }
+
+    ComPtr<IWICBitmapFrameDecode> frame;
+    hr = decoder->GetFrame(0, frame.GetAddressOf());
+    if (FAILED(hr)) { return false; }
+
+    GUID container = {};
+    decoder->GetContainerFormat(&container);
+    srgb = IsSrgbImage(frame.Get(), container);
+
+    UINT width = 0, height = 0;
+    frame->GetSize(&width, &height);
+
+    //ǂ̉f`ł RGBA8 ɑ
+    ComPtr<IWICFormatConverter> converter;
+    hr = factory->CreateFormatConverter(converter.GetAddressOf());
+    if (FAILED(hr)) { return false; }
+
+    hr = converter->Initialize(frame.Get(), GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone, nullptr, 0.0, WICBitmapPaletteTypeMedianCut);
+    if (FAILED(hr)) { return false; }
+
+    out.width = static_cast<int>(width);
+    out.height = static_cast<int>(height);
+    out.pixels.resize(static_cast<size_t>(width) * height * 4);
+
+    hr = converter->CopyPixels(nullptr, width * 4, static_cast<UINT>(out.pixels.size()), out.pixels.data());
+    return SUCCEEDED(hr);
+}
+
+int TextureBaker::Bake(const std::vector<std::string>& paths, const std::string& formatName, const std::string& filterName)
+{
+    char buf[512];
+
+    bool autoFormat = false;
+    BLOCK_FORMAT requested = BLOCK_BC7;
+    if (!ParseFormat(formatName, autoFormat, requested))
+    {
+        sprintf_s(buf, "Texture bake: unknown format '%s' (auto / bc1 / bc3 / bc7)", formatName.c_str());
+        Print(buf);
+        return 1;
+    }
+    const MIP_FILTER filter = (filterName == "kaiser") ? MIP_FILTER_KAISER : MIP_FILTER_BOX;
+
+    //WIC ĝ COM Ă(ɕʂ̃[hŏς݂łg)
+    const HRESULT comResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+    int result = 0;
+    size_t totalSource = 0;
+    size_t totalBaked = 0;
+    int bakedCount = 0;
+
+    for (const auto& path : CollectImages(paths))
+    {
+        ImageRGBA image;
+        bool srgb = false;
+        if (!LoadImageRGBA(path, image, srgb))
+        {
+            sprintf_s(buf, "Texture bake failed: %s", path.c_str());
+            Print(buf);
+            result = 1;
+            continue;
+        }
+
+        //BC ͍ŏʂ̃~bv4̔{łȂƍȂ̂Ō̉摜̂܂܎g
+        if (image.width % 4 != 0 || image.height % 4 != 0)
+        {
+            sprintf_s(buf, "  skip %s (%dx%d is not a multiple of 4)", path.c_str(), image.width, image.height);
+            Print(buf);
+            continue;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+
+        const bool opaque = TextureCompressor::IsOpaque(image);
+        std::vector<ImageRGBA> mips = TextureCompressor::GenerateMipChain(image, filter, srgb);
+
+        //ŏʂ̒iŌ`߂ĉ掿𑪂
+        BLOCK_FORMAT format = requested;
+        std::vector<uint8_t> top;
+        double psnr = 0.0;
+
+        std::vector<BLOCK_FORMAT> candidates;
+        if (!autoFormat)          { candidates = { requested }; }
+        else if (opaque)          { candidates = { BLOCK_BC1 }; }
+        else                      { candidates = { BLOCK_BC3, BLOCK_BC7 }; }
+
+        for (BLOCK_FORMAT candidate : candidates)
+        {
+            std::vector<uint8_t> blocks = TextureCompressor::Compress(mips[0], candidate);
+            ImageRGBA decoded = TextureCompressor::Decompress(blocks.data(), image.width, image.height, candidate);
+            const double candidatePsnr = TextureCompressor::ComputePsnr(image, decoded, !opaque);
+
+            if (top.empty() || candidatePsnr > psnr)
+            {
+                format = candidate;
+                top = std::move(blocks);
+                psnr = candidatePsnr;
+            }
+        }
+
+        //̉摜ƔׂĕꂷĂ珑oȂ
+        if (psnr < MIN_PSNR)
+        {
+            sprintf_s(buf, "  reject %s : %s PSNR %.2f dB < %.1f dB (keeps the source image)",
+                path.c_str(), TextureCompressor::GetFormatName(format), psnr, MIN_PSNR);
+            Print(buf);
+            result = 1;
+            continue;
+        }
+
+        std::vector<std::vector<uint8_t>> blocks;
+        blocks.push_back(std::move(top));
+        for (size_t level = 1; level < mips.size(); ++level)
+        {
+            blocks.push_back(TextureCompressor::Compress(mips[level], format));
+        }
+
+        const std::string bakedPath = TextureManager::GetBakedPath(path);
+        if (!TextureCompressor::WriteDds(bakedPath, image.width, image.height, format, srgb, blocks))
+        {
+            sprintf_s(buf, "Texture bake failed: cannot write %s", bakedPath.c_str());
+            Print(buf);
+            result = 1;
+            continue;
+        }
+
+        //GPU ̑傫 : ̓ǂݍ(RGBA8 + GenerateMips) BC
+        size_t sourceBytes = 0;
+        size_t bakedBytes = 0;
+        for (size_t level = 0; level < mips.size(); ++level)
+        {
+            sourceBytes += mips[level].pixels.size();
+            bakedBytes += blocks[level].size();
+        }
+
+        sprintf_s(buf, "  %s -> %s : %dx%d %s%s, %zu mips, %zu KB -> %zu KB, PSNR %.2f dB, %.0f ms",
+            path.c_str(), bakedPath.c_str(), image.width, image.height,
+            TextureCompressor::GetFormatName(format), srgb ? " sRGB" : "", mips.size(),
+            sourceBytes / 1024, bakedBytes / 1024, psnr, ElapsedMs(start));
+        Print(buf);
+
+        totalSource += sourceBytes;
+        totalBaked += bakedBytes;
+        bakedCount++;
+    }
+
+    sprintf_s(buf, "Texture bake: %d textures, GPU memory %zu KB -> %zu KB (%s mips)",
+        bakedCount, totalSource / 1024, totalBaked / 1024, filter == MIP_FILTER_KAISER ? "kaiser" : "box");
+    Print(buf);
+
+    if (SUCCEEDED(comResult))
+    {
+        CoUninitialize();
+    }
+    return result;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "TextureCompressor.h"
+
+//---------------------------------------------------------
+// PNG / JPEG O BC kς݂ DDS ɕϊNX
+// CPU Ń~bvăubNkA<摜>.dds ɏo
+// (main  --bake-textures ĂԁBTextureManager  DDS ΂ǂ)
+//---------------------------------------------------------
+class TextureBaker
+{
+public:
+    //paths : 摜t@CfBNg(fBNg͒ .png / .jpg S)
+    //formatName : "auto" / "bc1" / "bc3" / "bc7"
+    //             auto ͕sȂ BC1AAt@ BC3  BC7 ̗ǂ
+    //filterName : ~bv̏ktB^ "box" / "kaiser"
+    //߂l : vZX̏IR[h(掿ɓ͂Ȃ 1)
+    static int Bake(const std::vector<std::string>& paths, const std::string& formatName, const std::string& filterName);
+
+    //WIC  RGBA8 ɓǂݍ
+    //srgb ɂ WICTextureLoader Ɠ sRGB ƂĈ摜ǂԂ
+    static bool LoadImageRGBA(const std::string& path, ImageRGBA& out, bool& srgb);
+};
@@ -1,6 +1,7 @@
 #include "TextureComponent.h"
+#include <d3d11.h>
 #include "Renderer.h"
-#include <WICTextureLoader.h>
+#include "TextureManager.h"
 #include "Application.h"
 #include <iostream>
 
@@ -15,11 +16,16 @@ TextureComponent::TextureComponent()
 
 bool TextureComponent::LoadTexture(const std::wstring& filepath)
 {
-    ID3D11Device* device = Renderer::GetDevice();
-    if (!device) { return false; }
-
-    HRESULT hr = CreateWICTextureFromFile(device, filepath.c_str(), nullptr, m_TextureSRV.GetAddressOf());
-    return SUCCEEDED(hr);
+    //TextureManager ʂƓ摜LłAOϊ DDS g
+    std::string path;
+    path.reserve(filepath.size());
+    for (wchar_t c : filepath)
+    {
+        path.push_back(static_cast<char>(c));
+    }
+
+    m_TextureSRV = TextureManager::Load(path);
+    return m_TextureSRV.Get() != nullptr;
 }
 
 void TextureComponent::Initialize() 
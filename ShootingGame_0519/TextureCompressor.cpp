@@ -0,0 +1,1139 @@
+#if defined(_MSC_VER) && !defined(_CRT_SECURE_NO_WARNINGS)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include "TextureCompressor.h"
+
+namespace
+{
+    //-----------------------DDS / DXGI ̒萔-----------------------
+    //(̃t@C GPU ̃c[łĝ d3d ̃wb_[͓ǂ܂Ȃ)
+    constexpr uint32_t DDS_MAGIC = 0x20534444;              // "DDS "
+    constexpr uint32_t DDS_FOURCC_DX10 = 0x30315844;        // "DX10"
+
+    constexpr uint32_t DDSD_CAPS = 0x1;
+    constexpr uint32_t DDSD_HEIGHT = 0x2;
+    constexpr uint32_t DDSD_WIDTH = 0x4;
+    constexpr uint32_t DDSD_PIXELFORMAT = 0x1000;
+    constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+    constexpr uint32_t DDSD_LINEARSIZE = 0x80000;
+    constexpr uint32_t DDPF_FOURCC = 0x4;
+    constexpr uint32_t DDSCAPS_COMPLEX = 0x8;
+    constexpr uint32_t DDSCAPS_TEXTURE = 0x1000;
+    constexpr uint32_t DDSCAPS_MIPMAP = 0x400000;
+    constexpr uint32_t DDS_DIMENSION_TEXTURE2D = 3;
+
+    //DXGI_FORMAT ̒l(UNORM, UNORM_SRGB ̏)
+    constexpr uint32_t DXGI_FORMATS[MAX_BLOCK_FORMAT][2] =
+    {
+        { 71, 72 },     //BC1
+        { 77, 78 },     //BC3
+        { 98, 99 },     //BC7
+    };
+
+    //-----------------------ubN̎o-----------------------
+    struct Block
+    {
+        uint8_t px[16][4];
+    };
+
+    //4̔{łȂ[͒[̉fJԂ
+    Block FetchBlock(const ImageRGBA& image, int bx, int by)
+    {
+        Block block;
+        for (int y = 0; y < 4; ++y)
+        {
+            const int sy = std::min(by * 4 + y, image.height - 1);
+            for (int x = 0; x < 4; ++x)
+            {
+                const int sx = std::min(bx * 4 + x, image.width - 1);
+                memcpy(block.px[y * 4 + x], &image.pixels[(static_cast<size_t>(sy) * image.width + sx) * 4], 4);
+            }
+        }
+        return block;
+    }
+
+    void StoreBlock(ImageRGBA& image, int bx, int by, const uint8_t px[16][4])
+    {
+        for (int y = 0; y < 4; ++y)
+        {
+            const int dy = by * 4 + y;
+            if (dy >= image.height) { break; }
+            for (int x = 0; x < 4; ++x)
+            {
+                const int dx = bx * 4 + x;
+                if (dx >= image.width) { break; }
+                memcpy(&image.pixels[(static_cast<size_t>(dy) * image.width + dx) * 4], px[y * 4 + x], 4);
+            }
+        }
+    }
+
+    //-----------------------听(F̕zԐLтĂ)-----------------------
+    //channels (3 or 4)̓_Q̕ςƎ厲߂
+    void ComputePrincipalAxis(const float (*points)[4], int count, int channels, float mean[4], float axis[4])
+    {
+        for (int c = 0; c < 4; ++c) { mean[c] = 0.0f; axis[c] = 0.0f; }
+        if (count == 0) { return; }
+
+        for (int i = 0; i < count; ++i)
+        {
+            for (int c = 0; c < channels; ++c) { mean[c] += points[i][c]; }
+        }
+        for (int c = 0; c < channels; ++c) { mean[c] /= count; }
+
+        float cov[4][4] = {};
+        for (int i = 0; i < count; ++i)
+        {
+            float d[4] = {};
+            for (int c = 0; c < channels; ++c) { d[c] = points[i][c] - mean[c]; }
+            for (int a = 0; a < channels; ++a)
+            {
+                for (int b = 0; b < channels; ++b) { cov[a][b] += d[a] * d[b]; }
+            }
+        }
+
+        //ׂ@(l͑Ίp̈ԑ傫)
+        int start = 0;
+        for (int c = 1; c < channels; ++c)
+        {
+            if (cov[c][c] > cov[start][start]) { start = c; }
+        }
+        axis[start] = 1.0f;
+
+        for (int iter = 0; iter < 8; ++iter)
+        {
+            float next[4] = {};
+            for (int a = 0; a < channels; ++a)
+            {
+                for (int b = 0; b < channels; ++b) { next[a] += cov[a][b] * axis[b]; }
+            }
+
+            float length = 0.0f;
+            for (int c = 0; c < channels; ++c) { length += next[c] * next[c]; }
+            length = std::sqrt(length);
+            if (length < 1.0e-6f) { break; }
+
+            for (int c = 0; c < channels; ++c) { axis[c] = next[c] / length; }
+        }
+    }
+
+    //厲̗[[_ɂ
+    void ComputeEndpoints(const float (*points)[4], int count, int channels, float e0[4], float e1[4])
+    {
+        float mean[4], axis[4];
+        ComputePrincipalAxis(points, count, channels, mean, axis);
+
+        float tMin = 0.0f, tMax = 0.0f;
+        for (int i = 0; i < count; ++i)
+        {
+            float t = 0.0f;
+            for (int c = 0; c < channels; ++c) { t += (points[i][c] - mean[c]) * axis[c]; }
+            tMin = std::min(tMin, t);
+            tMax = std::max(tMax, t);
+        }
+
+        for (int c = 0; c < 4; ++c)
+        {
+            e0[c] = std::clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f);
+            e1[c] = std::clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f);
+        }
+    }
+
+    //indices Ƃ̏d(0`1, e1 ̊)[_ŏŋߒ
+    bool FitEndpoints(const float (*points)[4], const float* weights, int count, int channels, float e0[4], float e1[4])
+    {
+        float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+        float ax[4] = {}, bx[4] = {};
+
+        for (int i = 0; i < count; ++i)
+        {
+            const float b = weights[i];
+            const float a = 1.0f - b;
+            aa += a * a;
+            ab += a * b;
+            bb += b * b;
+            for (int c = 0; c < channels; ++c)
+            {
+                ax[c] += a * points[i][c];
+                bx[c] += b * points[i][c];
+            }
+        }
+
+        const float det = aa * bb - ab * ab;
+        if (std::fabs(det) < 1.0e-6f) { return false; }
+
+        const float inv = 1.0f / det;
+        for (int c = 0; c < channels; ++c)
+        {
+            e0[c] = std::clamp((ax[c] * bb - bx[c] * ab) * inv, 0.0f, 255.0f);
+            e1[c] = std::clamp((bx[c] * aa - ax[c] * ab) * inv, 0.0f, 255.0f);
+        }
+        return true;
+    }
+
+    //-----------------------BC1 ̐FubN-----------------------
+    uint16_t Pack565(const float c[4])
+    {
+        const int r = static_cast<int>(std::lround(c[0] * 31.0f / 255.0f));
+        const int g = static_cast<int>(std::lround(c[1] * 63.0f / 255.0f));
+        const int b = static_cast<int>(std::lround(c[2] * 31.0f / 255.0f));
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    void Unpack565(uint16_t v, int out[3])
+    {
+        const int r = (v >> 11) & 31;
+        const int g = (v >> 5) & 63;
+        const int b = v & 31;
+        out[0] = (r << 3) | (r >> 2);
+        out[1] = (g << 2) | (g >> 4);
+        out[2] = (b << 3) | (b >> 2);
+    }
+
+    //c0, c1 4F(threeColor Ȃ3F+)̃pbg
+    void BuildColorPalette(uint16_t c0, uint16_t c1, bool threeColor, int palette[4][4])
+    {
+        Unpack565(c0, palette[0]);
+        Unpack565(c1, palette[1]);
+        palette[0][3] = palette[1][3] = 255;
+
+        for (int c = 0; c < 3; ++c)
+        {
+            if (threeColor)
+            {
+                palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+                palette[3][c] = 0;
+            }
+            else
+            {
+                palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+            }
+        }
+        palette[2][3] = 255;
+        palette[3][3] = threeColor ? 0 : 255;
+    }
+
+    //efɈԋ߂pbg̔ԍIсA덷̍vԂ
+    //transparent[i]  true ̉f3F[h̓(3)ɂ
+    int SelectColorIndices(const Block& block, const int palette[4][4], bool threeColor,
+                           const bool* transparent, uint8_t indices[16])
+    {
+        int total = 0;
+        const int usable = threeColor ? 3 : 4;
+
+        for (int i = 0; i < 16; ++i)
+        {
+            if (transparent && transparent[i])
+            {
+                indices[i] = 3;
+                continue;
+            }
+
+            int best = 0;
+            int bestError = INT32_MAX;
+            for (int p = 0; p < usable; ++p)
+            {
+                const int dr = block.px[i][0] - palette[p][0];
+                const int dg = block.px[i][1] - palette[p][1];
+                const int db = block.px[i][2] - palette[p][2];
+                const int error = dr * dr + dg * dg + db * db;
+                if (error < bestError)
+                {
+                    bestError = error;
+                    best = p;
+                }
+            }
+            indices[i] = static_cast<uint8_t>(best);
+            total += bestError;
+        }
+        return total;
+    }
+
+    //[_(float) c0/c1 ƃ[h߂ĕт𐮂
+    //4F[h c0 > c1A3F[h c0 <= c1
+    int EvaluateColorEndpoints(const Block& block, const float e0[4], const float e1[4], bool threeColor,
+                               const bool* transparent, uint16_t& outC0, uint16_t& outC1, uint8_t indices[16])
+    {
+        uint16_t c0 = Pack565(e1);     //厲̑傫 c0 
+        uint16_t c1 = Pack565(e0);
+
+        if (threeColor ? (c0 > c1) : (c0 < c1))
+        {
+            std::swap(c0, c1);
+        }
+
+        int palette[4][4];
+        //c0 == c1 ̎͂ǂ̃[hł0Ԃ c0 ɂȂ
+        const bool paletteThree = threeColor || c0 == c1;
+        BuildColorPalette(c0, c1, paletteThree, palette);
+
+        const int error = SelectColorIndices(block, palette, paletteThree, transparent, indices);
+
+        outC0 = c0;
+        outC1 = c1;
+        return error;
+    }
+
+    void WriteColorBlock(uint16_t c0, uint16_t c1, const uint8_t indices[16], uint8_t* out)
+    {
+        out[0] = static_cast<uint8_t>(c0 & 0xFF);
+        out[1] = static_cast<uint8_t>(c0 >> 8);
+        out[2] = static_cast<uint8_t>(c1 & 0xFF);
+        out[3] = static_cast<uint8_t>(c1 >> 8);
+
+        uint32_t bits = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            bits |= static_cast<uint32_t>(indices[i] & 3) << (i * 2);
+        }
+        memcpy(out + 4, &bits, 4);
+    }
+
+    //allowTransparent : BC1  a < 128 ̉f3F[h̓ɂ
+    //(BC3 ̐FubN͏4FƂēǂ܂̂ false)
+    void EncodeColorBlock(const Block& block, bool allowTransparent, uint8_t* out)
+    {
+        bool transparent[16] = {};
+        bool threeColor = false;
+
+        float points[16][4];
+        int count = 0;
+
+        for (int i = 0; i < 16; ++i)
+        {
+            if (allowTransparent && block.px[i][3] < 128)
+            {
+                transparent[i] = true;
+                threeColor = true;
+                continue;
+            }
+            for (int c = 0; c < 4; ++c) { points[count][c] = block.px[i][c]; }
+            count++;
+        }
+
+        uint8_t indices[16] = {};
+
+        //S
+        if (count == 0)
+        {
+            for (int i = 0; i < 16; ++i) { indices[i] = 3; }
+            WriteColorBlock(0, 0, indices, out);
+            return;
+        }
+
+        float e0[4], e1[4];
+        ComputeEndpoints(points, count, 3, e0, e1);
+
+        uint16_t c0, c1;
+        int bestError = EvaluateColorEndpoints(block, e0, e1, threeColor, threeColor ? transparent : nullptr, c0, c1, indices);
+
+        //I񂾔ԍŒ[_ŏō킹(ǂȂg)
+        for (int iter = 0; iter < 2 && bestError > 0; ++iter)
+        {
+            int palette[4][4];
+            BuildColorPalette(c0, c1, threeColor || c0 == c1, palette);
+
+            //pbg̔ԍuc1 ̊vɒ
+            const float weights4[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+            const float weights3[4] = { 0.0f, 1.0f, 0.5f, 0.0f };
+
+            float weights[16];
+            int n = 0;
+            for (int i = 0; i < 16; ++i)
+            {
+                if (transparent[i]) { continue; }
+                weights[n++] = (threeColor || c0 == c1) ? weights3[indices[i]] : weights4[indices[i]];
+            }
+
+            float f0[4] = {}, f1[4] = {};
+            if (!FitEndpoints(points, weights, count, 3, f0, f1)) { break; }
+
+            //FitEndpoints  c0  f0Ac1  f1 ɕԂ̂ŁAEvaluateColorEndpoints ̕тɍ킹
+            uint16_t n0, n1;
+            uint8_t newIndices[16];
+            const int error = EvaluateColorEndpoints(block, f1, f0, threeColor, threeColor ? transparent : nullptr, n0, n1, newIndices);
+            if (error >= bestError) { break; }
+
+            bestError = error;
+            c0 = n0;
+            c1 = n1;
+            memcpy(indices, newIndices, 16);
+        }
+
+        WriteColorBlock(c0, c1, indices, out);
+    }
+
+    void DecodeColorBlock(const uint8_t* in, bool forceFourColor, uint8_t px[16][4])
+    {
+        const uint16_t c0 = static_cast<uint16_t>(in[0] | (in[1] << 8));
+        const uint16_t c1 = static_cast<uint16_t>(in[2] | (in[3] << 8));
+        uint32_t bits;
+        memcpy(&bits, in + 4, 4);
+
+        int palette[4][4];
+        BuildColorPalette(c0, c1, !forceFourColor && c0 <= c1, palette);
+
+        for (int i = 0; i < 16; ++i)
+        {
+            const int index = (bits >> (i * 2)) & 3;
+            for (int c = 0; c < 4; ++c) { px[i][c] = static_cast<uint8_t>(palette[index][c]); }
+        }
+    }
+
+    //-----------------------BC3 ̃At@ubN-----------------------
+    void BuildAlphaPalette(int a0, int a1, int palette[8])
+    {
+        palette[0] = a0;
+        palette[1] = a1;
+        if (a0 > a1)
+        {
+            for (int k = 2; k < 8; ++k)
+            {
+                palette[k] = ((8 - k) * a0 + (k - 1) * a1 + 3) / 7;
+            }
+        }
+        else
+        {
+            for (int k = 2; k < 6; ++k)
+            {
+                palette[k] = ((6 - k) * a0 + (k - 1) * a1 + 2) / 5;
+            }
+            palette[6] = 0;
+            palette[7] = 255;
+        }
+    }
+
+    void EncodeAlphaBlock(const Block& block, uint8_t* out)
+    {
+        int aMin = 255, aMax = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            aMin = std::min<int>(aMin, block.px[i][3]);
+            aMax = std::max<int>(aMax, block.px[i][3]);
+        }
+
+        //8iK[h(a0 > a1)BSlȂ a0 == a1 őS0
+        int palette[8];
+        BuildAlphaPalette(aMax, aMin, palette);
+
+        out[0] = static_cast<uint8_t>(aMax);
+        out[1] = static_cast<uint8_t>(aMin);
+
+        uint64_t bits = 0;
+        for (int i = 0; i < 16; ++i)
+        {
+            int best = 0;
+            int bestError = INT32_MAX;
+            const int usable = (aMax > aMin) ? 8 : 1;
+            for (int p = 0; p < usable; ++p)
+            {
+                const int error = std::abs(block.px[i][3] - palette[p]);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    best = p;
+                }
+            }
+            bits |= static_cast<uint64_t>(best) << (i * 3);
+        }
+
+        for (int b = 0; b < 6; ++b)
+        {
+            out[2 + b] = static_cast<uint8_t>((bits >> (b * 8)) & 0xFF);
+        }
+    }
+
+    void DecodeAlphaBlock(const uint8_t* in, uint8_t px[16][4])
+    {
+        int palette[8];
+        BuildAlphaPalette(in[0], in[1], palette);
+
+        uint64_t bits = 0;
+        for (int b = 0; b < 6; ++b)
+        {
+            bits |= static_cast<uint64_t>(in[2 + b]) << (b * 8);
+        }
+
+        for (int i = 0; i < 16; ++i)
+        {
+            px[i][3] = static_cast<uint8_t>(palette[(bits >> (i * 3)) & 7]);
+        }
+    }
+
+    //-----------------------BC7 ([h6 : 1TuZbg RGBA 7bit+pbitA4bit CfbNX)-----------------------
+    constexpr int BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    class BitWriter
+    {
+    public:
+        explicit BitWriter(uint8_t* out) : m_out(out) { memset(m_out, 0, 16); }
+
+        void Write(uint32_t value, int bits)
+        {
+            for (int i = 0; i < bits; ++i, ++m_pos)
+            {
+                if (value & (1u << i))
+                {
+                    m_out[m_pos >> 3] |= static_cast<uint8_t>(1u << (m_pos & 7));
+                }
+            }
+        }
+
+    private:
+        uint8_t* m_out;
+        int m_pos = 0;
+    };
+
+    class BitReader
+    {
+    public:
+        explicit BitReader(const uint8_t* in) : m_in(in) {}
+
+        uint32_t Read(int bits)
+        {
+            uint32_t value = 0;
+            for (int i = 0; i < bits; ++i, ++m_pos)
+            {
+                value |= static_cast<uint32_t>((m_in[m_pos >> 3] >> (m_pos & 7)) & 1) << i;
+            }
+            return value;
+        }
+
+    private:
+        const uint8_t* m_in;
+        int m_pos = 0;
+    };
+
+    struct Bc7Candidate
+    {
+        int q0[4];          //7bit ̒[_
+        int q1[4];
+        int p0 = 0;         //pbit
+        int p1 = 0;
+        uint8_t indices[16];
+        int error = INT32_MAX;
+    };
+
+    //[_(float) pbit ̑gݍ킹SŎĈԗǂ̂Ԃ
+    Bc7Candidate EvaluateBc7(const Block& block, const float e0[4], const float e1[4])
+    {
+        Bc7Candidate best;
+
+        for (int p = 0; p < 4; ++p)
+        {
+            Bc7Candidate candidate;
+            candidate.p0 = p & 1;
+            candidate.p1 = p >> 1;
+
+            int end0[4], end1[4];
+            for (int c = 0; c < 4; ++c)
+            {
+                candidate.q0[c] = std::clamp(static_cast<int>(std::lround((e0[c] - candidate.p0) * 0.5f)), 0, 127);
+                candidate.q1[c] = std::clamp(static_cast<int>(std::lround((e1[c] - candidate.p1) * 0.5f)), 0, 127);
+                end0[c] = (candidate.q0[c] << 1) | candidate.p0;
+                end1[c] = (candidate.q1[c] << 1) | candidate.p1;
+            }
+
+            int palette[16][4];
+            for (int i = 0; i < 16; ++i)
+            {
+                for (int c = 0; c < 4; ++c)
+                {
+                    palette[i][c] = ((64 - BC7_WEIGHTS[i]) * end0[c] + BC7_WEIGHTS[i] * end1[c] + 32) >> 6;
+                }
+            }
+
+            int total = 0;
+            for (int i = 0; i < 16 && total < best.error; ++i)
+            {
+                int bestIndex = 0;
+                int bestError = INT32_MAX;
+                for (int k = 0; k < 16; ++k)
+                {
+                    int error = 0;
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        const int d = block.px[i][c] - palette[k][c];
+                        error += d * d;
+                    }
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestIndex = k;
+                    }
+                }
+                candidate.indices[i] = static_cast<uint8_t>(bestIndex);
+                total += bestError;
+            }
+
+            candidate.error = total;
+            if (candidate.error < best.error)
+            {
+                best = candidate;
+            }
+        }
+
+        return best;
+    }
+
+    void EncodeBc7Block(const Block& block, uint8_t* out)
+    {
+        float points[16][4];
+        for (int i = 0; i < 16; ++i)
+        {
+            for (int c = 0; c < 4; ++c) { points[i][c] = block.px[i][c]; }
+        }
+
+        float e0[4], e1[4];
+        ComputeEndpoints(points, 16, 4, e0, e1);
+
+        Bc7Candidate best = EvaluateBc7(block, e0, e1);
+
+        //I񂾔ԍŒ[_킹
+        for (int iter = 0; iter < 2 && best.error > 0; ++iter)
+        {
+            float weights[16];
+            for (int i = 0; i < 16; ++i)
+            {
+                weights[i] = BC7_WEIGHTS[best.indices[i]] / 64.0f;
+            }
+
+            float f0[4], f1[4];
+            if (!FitEndpoints(points, weights, 16, 4, f0, f1)) { break; }
+
+            Bc7Candidate candidate = EvaluateBc7(block, f0, f1);
+            if (candidate.error >= best.error) { break; }
+            best = candidate;
+        }
+
+        //擪f̔ԍ̍ŏʃrbg͏Ȃ̂ŁAĂ[_ւ
+        if (best.indices[0] & 8)
+        {
+            std::swap(best.q0, best.q1);
+            std::swap(best.p0, best.p1);
+            for (int i = 0; i < 16; ++i)
+            {
+                best.indices[i] = static_cast<uint8_t>(15 - best.indices[i]);
+            }
+        }
+
+        BitWriter writer(out);
+        writer.Write(1u << 6, 7);     //[h6
+        for (int c = 0; c < 4; ++c)
+        {
+            writer.Write(best.q0[c], 7);
+            writer.Write(best.q1[c], 7);
+        }
+        writer.Write(best.p0, 1);
+        writer.Write(best.p1, 1);
+        writer.Write(best.indices[0], 3);
+        for (int i = 1; i < 16; ++i)
+        {
+            writer.Write(best.indices[i], 4);
+        }
+    }
+
+    //̃GR[_[o[h6߂(ȊO͍)
+    void DecodeBc7Block(const uint8_t* in, uint8_t px[16][4])
+    {
+        memset(px, 0, 16 * 4);
+        if ((in[0] & 0x7F) != 0x40) { return; }
+
+        BitReader reader(in);
+        reader.Read(7);
+
+        int q0[4], q1[4];
+        for (int c = 0; c < 4; ++c)
+        {
+            q0[c] = static_cast<int>(reader.Read(7));
+            q1[c] = static_cast<int>(reader.Read(7));
+        }
+        const int p0 = static_cast<int>(reader.Read(1));
+        const int p1 = static_cast<int>(reader.Read(1));
+
+        int end0[4], end1[4];
+        for (int c = 0; c < 4; ++c)
+        {
+            end0[c] = (q0[c] << 1) | p0;
+            end1[c] = (q1[c] << 1) | p1;
+        }
+
+        for (int i = 0; i < 16; ++i)
+        {
+            const int index = static_cast<int>(reader.Read(i == 0 ? 3 : 4));
+            for (int c = 0; c < 4; ++c)
+            {
+                px[i][c] = static_cast<uint8_t>(((64 - BC7_WEIGHTS[index]) * end0[c] + BC7_WEIGHTS[index] * end1[c] + 32) >> 6);
+            }
+        }
+    }
+
+    //-----------------------~bv-----------------------
+    float SrgbToLinear(float v)
+    {
+        return (v <= 0.04045f) ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+    }
+
+    float LinearToSrgb(float v)
+    {
+        return (v <= 0.0031308f) ? v * 12.92f : 1.055f * std::pow(v, 1.0f / 2.4f) - 0.055f;
+    }
+
+    struct ImageFloat
+    {
+        int width = 0;
+        int height = 0;
+        std::vector<float> pixels;  //RGBA 0`1
+    };
+
+    ImageFloat ToFloat(const ImageRGBA& image, bool srgb)
+    {
+        float table[256];
+        for (int i = 0; i < 256; ++i)
+        {
+            table[i] = srgb ? SrgbToLinear(i / 255.0f) : i / 255.0f;
+        }
+
+        ImageFloat result;
+        result.width = image.width;
+        result.height = image.height;
+        result.pixels.resize(image.pixels.size());
+        for (size_t i = 0; i < image.pixels.size(); ++i)
+        {
+            //At@͏ɃjA
+            result.pixels[i] = ((i & 3) == 3) ? image.pixels[i] / 255.0f : table[image.pixels[i]];
+        }
+        return result;
+    }
+
+    ImageRGBA ToRGBA(const ImageFloat& image, bool srgb)
+    {
+        ImageRGBA result;
+        result.width = image.width;
+        result.height = image.height;
+        result.pixels.resize(image.pixels.size());
+        for (size_t i = 0; i < image.pixels.size(); ++i)
+        {
+            float v = std::clamp(image.pixels[i], 0.0f, 1.0f);
+            if (srgb && (i & 3) != 3) { v = LinearToSrgb(v); }
+            result.pixels[i] = static_cast<uint8_t>(std::lround(v * 255.0f));
+        }
+        return result;
+    }
+
+    ImageFloat DownsampleBox(const ImageFloat& src)
+    {
+        ImageFloat dst;
+        dst.width = std::max(1, src.width / 2);
+        dst.height = std::max(1, src.height / 2);
+        dst.pixels.resize(static_cast<size_t>(dst.width) * dst.height * 4);
+
+        for (int y = 0; y < dst.height; ++y)
+        {
+            const int y0 = std::min(y * 2, src.height - 1);
+            const int y1 = std::min(y * 2 + 1, src.height - 1);
+            for (int x = 0; x < dst.width; ++x)
+            {
+                const int x0 = std::min(x * 2, src.width - 1);
+                const int x1 = std::min(x * 2 + 1, src.width - 1);
+                for (int c = 0; c < 4; ++c)
+                {
+                    const float sum = src.pixels[(static_cast<size_t>(y0) * src.width + x0) * 4 + c] +
+                                      src.pixels[(static_cast<size_t>(y0) * src.width + x1) * 4 + c] +
+                                      src.pixels[(static_cast<size_t>(y1) * src.width + x0) * 4 + c] +
+                                      src.pixels[(static_cast<size_t>(y1) * src.width + x1) * 4 + c];
+                    dst.pixels[(static_cast<size_t>(y) * dst.width + x) * 4 + c] = sum * 0.25f;
+                }
+            }
+        }
+        return dst;
+    }
+
+    //Kaiser t sinc (3, alpha 4)
+    constexpr float KAISER_WIDTH = 3.0f;
+    constexpr float KAISER_ALPHA = 4.0f;
+
+    float BesselI0(float x)
+    {
+        //WJ(܂)
+        float sum = 1.0f;
+        float term = 1.0f;
+        const float half = x * 0.5f;
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= (half / k) * (half / k);
+            sum += term;
+            if (term < sum * 1.0e-7f) { break; }
+        }
+        return sum;
+    }
+
+    float KaiserSinc(float t)
+    {
+        if (std::fabs(t) >= KAISER_WIDTH) { return 0.0f; }
+
+        const float pi = 3.14159265358979f;
+        const float sinc = (std::fabs(t) < 1.0e-5f) ? 1.0f : std::sin(pi * t) / (pi * t);
+        const float r = t / KAISER_WIDTH;
+        const float window = BesselI0(KAISER_ALPHA * std::sqrt(1.0f - r * r)) / BesselI0(KAISER_ALPHA);
+        return sinc * window;
+    }
+
+    //1k(horizontal Ȃ牡AłȂΏc)
+    ImageFloat DownsampleKaiser1D(const ImageFloat& src, int dstSize, bool horizontal)
+    {
+        const int srcSize = horizontal ? src.width : src.height;
+
+        ImageFloat dst;
+        dst.width = horizontal ? dstSize : src.width;
+        dst.height = horizontal ? src.height : dstSize;
+        dst.pixels.assign(static_cast<size_t>(dst.width) * dst.height * 4, 0.0f);
+
+        const float scale = static_cast<float>(srcSize) / dstSize;
+        const float radius = KAISER_WIDTH * scale;
+
+        //o1񕪂̏d݂͍sɈ˂Ȃ̂Őɍ
+        std::vector<std::vector<std::pair<int, float>>> taps(dstSize);
+        for (int d = 0; d < dstSize; ++d)
+        {
+            const float center = (d + 0.5f) * scale;
+            const int first = static_cast<int>(std::floor(center - radius));
+            const int last = static_cast<int>(std::ceil(center + radius));
+
+            float total = 0.0f;
+            for (int s = first; s <= last; ++s)
+            {
+                const float w = KaiserSinc((s + 0.5f - center) / scale);
+                if (w == 0.0f) { continue; }
+                taps[d].push_back({ std::clamp(s, 0, srcSize - 1), w });
+                total += w;
+            }
+            for (auto& tap : taps[d])
+            {
+                tap.second /= total;
+            }
+        }
+
+        const int lines = horizontal ? src.height : src.width;
+        for (int line = 0; line < lines; ++line)
+        {
+            for (int d = 0; d < dstSize; ++d)
+            {
+                float sum[4] = {};
+                for (const auto& tap : taps[d])
+                {
+                    const size_t s = horizontal ? (static_cast<size_t>(line) * src.width + tap.first)
+                                                : (static_cast<size_t>(tap.first) * src.width + line);
+                    for (int c = 0; c < 4; ++c) { sum[c] += src.pixels[s * 4 + c] * tap.second; }
+                }
+
+                const size_t o = horizontal ? (static_cast<size_t>(line) * dst.width + d)
+                                            : (static_cast<size_t>(d) * dst.width + line);
+                for (int c = 0; c < 4; ++c) { dst.pixels[o * 4 + c] = sum[c]; }
+            }
+        }
+        return dst;
+    }
+
+    ImageFloat DownsampleKaiser(const ImageFloat& src)
+    {
+        ImageFloat result = src;
+        if (src.width > 1)
+        {
+            result = DownsampleKaiser1D(result, src.width / 2, true);
+        }
+        if (src.height > 1)
+        {
+            result = DownsampleKaiser1D(result, src.height / 2, false);
+        }
+
+        //̃[uŔ͈͊OɂȂ߂
+        for (float& v : result.pixels)
+        {
+            v = std::clamp(v, 0.0f, 1.0f);
+        }
+        return result;
+    }
+}
+
+std::vector<ImageRGBA> TextureCompressor::GenerateMipChain(const ImageRGBA& top, MIP_FILTER filter, bool srgb)
+{
+    std::vector<ImageRGBA> mips;
+    mips.push_back(top);
+    if (top.width <= 0 || top.height <= 0) { return mips; }
+
+    //1O̒i(덷܂Ȃ悤 float ̂܂܎)
+    ImageFloat level = ToFloat(top, srgb);
+    while (level.width > 1 || level.height > 1)
+    {
+        level = (filter == MIP_FILTER_KAISER) ? DownsampleKaiser(level) : DownsampleBox(level);
+        mips.push_back(ToRGBA(level, srgb));
+    }
+    return mips;
+}
+
+std::vector<uint8_t> TextureCompressor::Compress(const ImageRGBA& image, BLOCK_FORMAT format)
+{
+    const int blocksX = (image.width + 3) / 4;
+    const int blocksY = (image.height + 3) / 4;
+    const size_t blockBytes = GetBlockBytes(format);
+
+    std::vector<uint8_t> result(static_cast<size_t>(blocksX) * blocksY * blockBytes);
+    if (image.width <= 0 || image.height <= 0) { return result; }
+
+    for (int by = 0; by < blocksY; ++by)
+    {
+        for (int bx = 0; bx < blocksX; ++bx)
+        {
+            const Block block = FetchBlock(image, bx, by);
+            uint8_t* out = &result[(static_cast<size_t>(by) * blocksX + bx) * blockBytes];
+
+            switch (format)
+            {
+            case BLOCK_BC1:
+                EncodeColorBlock(block, true, out);
+                break;
+            case BLOCK_BC3:
+                EncodeAlphaBlock(block, out);
+                EncodeColorBlock(block, false, out + 8);
+                break;
+            case BLOCK_BC7:
+                EncodeBc7Block(block, out);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+ImageRGBA TextureCompressor::Decompress(const uint8_t* data, int width, int height, BLOCK_FORMAT format)
+{
+    ImageRGBA image;
+    image.width = width;
+    image.height = height;
+    image.pixels.assign(static_cast<size_t>(width) * height * 4, 0);
+    if (!data) { return image; }
+
+    const int blocksX = (width + 3) / 4;
+    const int blocksY = (height + 3) / 4;
+    const size_t blockBytes = GetBlockBytes(format);
+
+    for (int by = 0; by < blocksY; ++by)
+    {
+        for (int bx = 0; bx < blocksX; ++bx)
+        {
+            const uint8_t* in = data + (static_cast<size_t>(by) * blocksX + bx) * blockBytes;
+            uint8_t px[16][4];
+
+            switch (format)
+            {
+            case BLOCK_BC1:
+                DecodeColorBlock(in, false, px);
+                break;
+            case BLOCK_BC3:
+                DecodeColorBlock(in + 8, true, px);
+                DecodeAlphaBlock(in, px);
+                break;
+            case BLOCK_BC7:
+                DecodeBc7Block(in, px);
+                break;
+            default:
+                memset(px, 0, sizeof(px));
+                break;
+            }
+
+            StoreBlock(image, bx, by, px);
+        }
+    }
+    return image;
+}
+
+double TextureCompressor::ComputePsnr(const ImageRGBA& a, const ImageRGBA& b, bool includeAlpha)
+{
+    if (a.width != b.width || a.height != b.height || a.pixels.size() != b.pixels.size() || a.pixels.empty())
+    {
+        return 0.0;
+    }
+
+    const int channels = includeAlpha ? 4 : 3;
+    double sum = 0.0;
+    for (size_t i = 0; i < a.pixels.size(); i += 4)
+    {
+        for (int c = 0; c < channels; ++c)
+        {
+            const double d = static_cast<double>(a.pixels[i + c]) - b.pixels[i + c];
+            sum += d * d;
+        }
+    }
+
+    const double mse = sum / (static_cast<double>(a.pixels.size() / 4) * channels);
+    if (mse <= 1.0e-10) { return 100.0; }
+
+    return 10.0 * std::log10(255.0 * 255.0 / mse);
+}
+
+size_t TextureCompressor::GetBlockBytes(BLOCK_FORMAT format)
+{
+    return (format == BLOCK_BC1) ? 8 : 16;
+}
+
+size_t TextureCompressor::GetCompressedSize(int width, int height, BLOCK_FORMAT format)
+{
+    return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * GetBlockBytes(format);
+}
+
+bool TextureCompressor::IsOpaque(const ImageRGBA& image)
+{
+    for (size_t i = 3; i < image.pixels.size(); i += 4)
+    {
+        if (image.pixels[i] != 255) { return false; }
+    }
+    return true;
+}
+
+bool TextureCompressor::WriteDds(const std::string& path, int width, int height, BLOCK_FORMAT format, bool srgb,
+                                 const std::vector<std::vector<uint8_t>>& mips)
+{
+    if (mips.empty() || format >= MAX_BLOCK_FORMAT) { return false; }
+
+    FILE* fp = fopen(path.c_str(), "wb");
+    if (!fp)
+    {
+        return false;
+    }
+
+    //DDS_HEADER (124 oCg)  uint32 ̕тƂč
+    uint32_t header[31] = {};
+    header[0] = 124;
+    header[1] = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE;
+    header[2] = static_cast<uint32_t>(height);
+    header[3] = static_cast<uint32_t>(width);
+    header[4] = static_cast<uint32_t>(mips[0].size());
+    header[6] = static_cast<uint32_t>(mips.size());
+    //[7..17] reserved, [18..25] DDS_PIXELFORMAT
+    header[18] = 32;
+    header[19] = DDPF_FOURCC;
+    header[20] = DDS_FOURCC_DX10;
+    header[26] = DDSCAPS_TEXTURE | DDSCAPS_MIPMAP | DDSCAPS_COMPLEX;
+
+    //DDS_HEADER_DXT10
+    uint32_t dx10[5] = {};
+    dx10[0] = DXGI_FORMATS[format][srgb ? 1 : 0];
+    dx10[1] = DDS_DIMENSION_TEXTURE2D;
+    dx10[3] = 1;    //arraySize
+
+    const uint32_t magic = DDS_MAGIC;
+    fwrite(&magic, sizeof(magic), 1, fp);
+    fwrite(header, sizeof(header), 1, fp);
+    fwrite(dx10, sizeof(dx10), 1, fp);
+    for (const auto& mip : mips)
+    {
+        fwrite(mip.data(), 1, mip.size(), fp);
+    }
+
+    const bool ok = (ferror(fp) == 0);
+    fclose(fp);
+    return ok;
+}
+
+bool TextureCompressor::RunSelfCheck(std::vector<std::string>& outLines)
+{
+    //Of[V : 4̔{łȂ傫ŁAAt@ 255  128 ɕς([̃ubŇJԂʂ)
+    //(BC1  a < 128 𓧖ɂ̂ 128 Ŏ~߂)
+    ImageRGBA gradient;
+    gradient.width = 61;
+    gradient.height = 37;
+    gradient.pixels.resize(static_cast<size_t>(gradient.width) * gradient.height * 4);
+    for (int y = 0; y < gradient.height; ++y)
+    {
+        for (int x = 0; x < gradient.width; ++x)
+        {
+            uint8_t* p = &gradient.pixels[(static_cast<size_t>(y) * gradient.width + x) * 4];
+            p[0] = static_cast<uint8_t>(x * 255 / (gradient.width - 1));
+            p[1] = static_cast<uint8_t>(y * 255 / (gradient.height - 1));
+            p[2] = static_cast<uint8_t>((x + y) * 255 / (gradient.width + gradient.height - 2));
+            p[3] = static_cast<uint8_t>(255 - x * 127 / (gradient.width - 1));
+        }
+    }
+
+    //`FbJ[ : 3f̃}XȂ̂ŃubN̒2F̋ڂ
+    ImageRGBA checker;
+    checker.width = 64;
+    checker.height = 64;
+    checker.pixels.resize(static_cast<size_t>(checker.width) * checker.height * 4);
+    for (int y = 0; y < checker.height; ++y)
+    {
+        for (int x = 0; x < checker.width; ++x)
+        {
+            const bool odd = ((x / 3) + (y / 3)) % 2 != 0;
+            uint8_t* p = &checker.pixels[(static_cast<size_t>(y) * checker.width + x) * 4];
+            p[0] = odd ? 230 : 20;
+            p[1] = odd ? 40 : 20;
+            p[2] = odd ? 40 : 200;
+            p[3] = 255;
+        }
+    }
+
+    //`Ƃ̉(dB)BBC1 ̃At@ 1bit Ȃ̂ RGB Ō
+    struct Case
+    {
+        const char* name;
+        const ImageRGBA* image;
+        BLOCK_FORMAT format;
+        double minPsnr;
+    };
+    const Case cases[] =
+    {
+        { "gradient", &gradient, BLOCK_BC1, 35.0 },
+        { "gradient", &gradient, BLOCK_BC3, 36.0 },
+        { "gradient", &gradient, BLOCK_BC7, 37.0 },
+        { "checker ", &checker,  BLOCK_BC1, 40.0 },
+        { "checker ", &checker,  BLOCK_BC3, 40.0 },
+        { "checker ", &checker,  BLOCK_BC7, 50.0 },
+    };
+
+    outLines.push_back("Texture compressor self-check (encode -> decode, PSNR)");
+
+    bool passed = true;
+    char buf[256];
+    for (const Case& c : cases)
+    {
+        const std::vector<uint8_t> data = Compress(*c.image, c.format);
+        const bool sizeOk = (data.size() == GetCompressedSize(c.image->width, c.image->height, c.format));
+
+        double psnr = 0.0;
+        if (sizeOk)
+        {
+            const ImageRGBA decoded = Decompress(data.data(), c.image->width, c.image->height, c.format);
+            psnr = ComputePsnr(*c.image, decoded, c.format != BLOCK_BC1);
+        }
+
+        const bool ok = sizeOk && psnr >= c.minPsnr;
+        passed = passed && ok;
+
+        snprintf(buf, sizeof(buf), "  %s %dx%d %s : %6.2f dB (min %.1f)%s %s",
+            c.name, c.image->width, c.image->height, GetFormatName(c.format), psnr, c.minPsnr,
+            sizeOk ? "" : " size mismatch", ok ? "OK" : "FAIL");
+        outLines.push_back(buf);
+    }
+
+    outLines.push_back(passed ? "  result : PASS" : "  result : FAIL");
+    return passed;
+}
+
+const char* TextureCompressor::GetFormatName(BLOCK_FORMAT format)
+{
+    switch (format)
+    {
+    case BLOCK_BC1: return "BC1";
+    case BLOCK_BC3: return "BC3";
+    case BLOCK_BC7: return "BC7";
+    default:        return "?";
+    }
+}
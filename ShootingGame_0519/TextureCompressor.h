@@ -0,0 +1,69 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+
+//---------------------------------------------------------
+// eNX`̃ItCϊ(~bvEBCkEDDSo)
+// CPU Ŋ̂ŁAGPU ̃c[g
+// (摜̓ǂݍ݂ TextureBaker  WIC ōs)
+//---------------------------------------------------------
+
+//RGBA8 ̉摜1
+struct ImageRGBA
+{
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;    //width * height * 4 (RGBA ̏)
+};
+
+//ubNǩ`
+enum BLOCK_FORMAT
+{
+    BLOCK_BC1 = 0,      //RGB 4bpp (At@ 1bit)
+    BLOCK_BC3,          //RGBA 8bpp (At@ʂɎ)
+    BLOCK_BC7,          //RGBA 8bpp (i)
+    MAX_BLOCK_FORMAT
+};
+
+//~bv̏ktB^
+enum MIP_FILTER
+{
+    MIP_FILTER_BOX = 0,     //2x2 ̕(GPU  GenerateMips Ɠ)
+    MIP_FILTER_KAISER,      //Kaiser t sinc(ڂ₯ɂ)
+};
+
+namespace TextureCompressor
+{
+    //top  1x1 ܂ł̃~bv(߂l̐擪 top ̃Rs[)
+    //srgb : true Ȃ烊jAɖ߂Ă畽ς
+    std::vector<ImageRGBA> GenerateMipChain(const ImageRGBA& top, MIP_FILTER filter, bool srgb);
+
+    //摜Ŝk(4̔{łȂ[̓ubNŒ[̉fJԂ)
+    std::vector<uint8_t> Compress(const ImageRGBA& image, BLOCK_FORMAT format);
+
+    //kf[^ RGBA8 ɖ߂(i̊mFpBBC7  Compress o[h6߂)
+    ImageRGBA Decompress(const uint8_t* data, int width, int height, BLOCK_FORMAT format);
+
+    //2̉摜 PSNR (dB)B摜Ȃ傫Ȓl(100)Ԃ
+    double ComputePsnr(const ImageRGBA& a, const ImageRGBA& b, bool includeAlpha);
+
+    //1ubN(4x4)̃oCg
+    size_t GetBlockBytes(BLOCK_FORMAT format);
+
+    //~bv1ïk̃oCg
+    size_t GetCompressedSize(int width, int height, BLOCK_FORMAT format);
+
+    //Sf̃At@ 255 
+    bool IsOpaque(const ImageRGBA& image);
+
+    //kς݂̃~bv DDS (DX10 wb_[t) ŏo
+    bool WriteDds(const std::string& path, int width, int height, BLOCK_FORMAT format, bool srgb,
+                  const std::vector<std::vector<uint8_t>>& mips);
+
+    const char* GetFormatName(BLOCK_FORMAT format);
+
+    //摜(Of[VE`FbJ[)e`ňkĖ߂APSNR ȏォm߂
+    //(DebugBenchmark  main  --self-check ĂԁB߂l : SȏȂ true)
+    bool RunSelfCheck(std::vector<std::string>& outLines);
+}
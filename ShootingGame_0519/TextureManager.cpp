@@ -1,40 +1,210 @@
 #ifdef _WIN32
 #include <windows.h>
 #endif
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
 #include "TextureManager.h"
 #include <WICTextureLoader.h>
+#include <DDSTextureLoader.h>
+#include <d3d11.h>
 #include "Renderer.h"
 
-std::unordered_map<std::string, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> TextureManager::m_textures;
+AssetTable<TextureAssetTag, TextureManager::Entry> TextureManager::m_textures;
+TextureManager::Stats TextureManager::m_stats;
+
+namespace
+{
+    float ElapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    //eNX`̃~bv݂̑傫(悭g`B 32bpp ƂĐ)
+    size_t GetTextureBytes(ID3D11Resource* resource)
+    {
+        Microsoft::WRL::ComPtr<ID3D11Texture2D> tex2D;
+        if (!resource || FAILED(resource->QueryInterface(IID_PPV_ARGS(tex2D.GetAddressOf()))))
+        {
+            return 0;
+        }
+
+        D3D11_TEXTURE2D_DESC desc{};
+        tex2D->GetDesc(&desc);
+
+        size_t blockBytes = 0;      //BC  4x4 ubNP
+        size_t pixelBytes = 4;
+        switch (desc.Format)
+        {
+        case DXGI_FORMAT_BC1_UNORM:
+        case DXGI_FORMAT_BC1_UNORM_SRGB:
+        case DXGI_FORMAT_BC4_UNORM:
+            blockBytes = 8;
+            break;
+        case DXGI_FORMAT_BC2_UNORM:
+        case DXGI_FORMAT_BC2_UNORM_SRGB:
+        case DXGI_FORMAT_BC3_UNORM:
+        case DXGI_FORMAT_BC3_UNORM_SRGB:
+        case DXGI_FORMAT_BC5_UNORM:
+        case DXGI_FORMAT_BC7_UNORM:
+        case DXGI_FORMAT_BC7_UNORM_SRGB:
+            blockBytes = 16;
+            break;
+        case DXGI_FORMAT_R16G16B16A16_UNORM:
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:
+            pixelBytes = 8;
+            break;
+        case DXGI_FORMAT_R8_UNORM:
+            pixelBytes = 1;
+            break;
+        default:
+            break;
+        }
+
+        size_t total = 0;
+        UINT width = desc.Width;
+        UINT height = desc.Height;
+        for (UINT level = 0; level < desc.MipLevels; ++level)
+        {
+            if (blockBytes > 0)
+            {
+                total += static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * blockBytes;
+            }
+            else
+            {
+                total += static_cast<size_t>(width) * height * pixelBytes;
+            }
+            width = (width > 1) ? width / 2 : 1;
+            height = (height > 1) ? height / 2 : 1;
+        }
+        return total * desc.ArraySize;
+    }
+
+    //LbVȊOɎQƂ邩
+    //(COM ̎QƃJEg AddRef / Release ̖߂lłȂ)
+    bool IsReferenced(ID3D11ShaderResourceView* srv)
+    {
+        if (!srv) { return false; }
+        srv->AddRef();
+        return srv->Release() > 1;
+    }
+}
 
 ID3D11ShaderResourceView* TextureManager::Load(const std::string& filepath)
 {
-    auto it = m_textures.find(filepath);
-    if (it != m_textures.end())
+    return Load(TextureId::FromString(filepath), filepath.c_str());
+}
+
+ID3D11ShaderResourceView* TextureManager::Load(const TexturePath& path)
+{
+    return Load(path.id, path.path);
+}
+
+ID3D11ShaderResourceView* TextureManager::Load(TextureId id, const char* filepath)
+{
+    if (Entry* entry = m_textures.Find(id, filepath))
     {
-        return it->second.Get();
+        entry->lastUsedFrame = ResidencyManager::GetFrame();
+        return entry->srv.Get();
+    }
+
+    //wbhXsł̓foCX̂œǂݍ܂Ȃ
+    if (Renderer::IsHeadless())
+    {
+        return nullptr;
     }
 
-    Microsoft::WRL::ComPtr<ID3D11Resource> res;
     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> texture;
+    size_t bytes = 0;
+    const auto start = std::chrono::steady_clock::now();
 
+    //Oϊ DDS ΂̂܂ GPU ɏグ
+    if (HasFreshBake(filepath) && SUCCEEDED(LoadBaked(filepath, texture, bytes)))
+    {
+        m_stats.bakedCount++;
+        m_stats.bakedMs += ElapsedMs(start);
+        m_stats.bakedBytes += bytes;
+    }
+    else if (SUCCEEDED(LoadDecoded(filepath, texture, bytes)))
+    {
+        m_stats.decodedCount++;
+        m_stats.decodedMs += ElapsedMs(start);
+        m_stats.decodedBytes += bytes;
+    }
+    else
+    {
+        return nullptr;
+    }
+
+    m_textures.Insert(id, filepath, Entry{ texture, filepath, bytes, ResidencyManager::GetFrame() });
+    ResidencyManager::OnLoaded(RESIDENT_TEXTURE, bytes);
+
+    return texture.Get();
+}
+
+std::string TextureManager::GetBakedPath(const std::string& filepath)
+{
+    return filepath + ".dds";
+}
+
+bool TextureManager::HasFreshBake(const std::string& filepath)
+{
+    std::error_code ec;
+    const std::string bakedPath = GetBakedPath(filepath);
+    if (!std::filesystem::exists(bakedPath, ec))
+    {
+        return false;
+    }
+
+    //̉摜ւ̌Â DDS ͎gȂ
+    const auto bakedTime = std::filesystem::last_write_time(bakedPath, ec);
+    if (ec) { return false; }
+
+    const auto sourceTime = std::filesystem::last_write_time(filepath, ec);
+    if (ec) { return true; }    //̉摜 DDS ŗǂ
+
+    return bakedTime >= sourceTime;
+}
+
+HRESULT TextureManager::LoadBaked(const std::string& filepath, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& out, size_t& bytes)
+{
+    Microsoft::WRL::ComPtr<ID3D11Resource> res;
+    std::string bakedPath = GetBakedPath(filepath);
+    std::wstring wpath(bakedPath.begin(), bakedPath.end());
+
+    //~bv DDS ɓĂ̂ŃfoCXReLXg͓nȂ(GenerateMips Ȃ)
+    HRESULT hr = DirectX::CreateDDSTextureFromFile(Renderer::GetDevice(),
+                                                   wpath.c_str(),
+                                                   res.GetAddressOf(),
+                                                   out.ReleaseAndGetAddressOf());
+    if (FAILED(hr) || !out)
+    {
+        OutputDebugStringA(("TextureManager: failed to load " + bakedPath + "\n").c_str());
+        return FAILED(hr) ? hr : E_FAIL;
+    }
+
+    bytes = GetTextureBytes(res.Get());
+    return S_OK;
+}
+
+HRESULT TextureManager::LoadDecoded(const std::string& filepath, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& out, size_t& bytes)
+{
+    Microsoft::WRL::ComPtr<ID3D11Resource> res;
     std::wstring wpath(filepath.begin(), filepath.end());
 
     HRESULT hr = DirectX::CreateWICTextureFromFile(Renderer::GetDevice(),
                                                    Renderer::GetDeviceContext(),
                                                    wpath.c_str(),
                                                    res.GetAddressOf(),
-                                                   texture.GetAddressOf(),
+                                                   out.ReleaseAndGetAddressOf(),
                                                    0);
 
-    if (FAILED(hr) || !texture)
+    if (FAILED(hr) || !out)
     {
-        return nullptr;
+        return FAILED(hr) ? hr : E_FAIL;
     }
 
-    Renderer::GetDeviceContext()->GenerateMips(texture.Get());
-
-    m_textures[filepath] = texture;
+    Renderer::GetDeviceContext()->GenerateMips(out.Get());
 
     /*Microsoft::WRL::ComPtr<ID3D11Texture2D> tex2D;
     res.As(&tex2D);
@@ -46,5 +216,111 @@ ID3D11ShaderResourceView* TextureManager::Load(const std::string& filepath)
     sprintf_s(buf, "Texture MipLevels=%u, Format=%u, BindFlags=0x%08X\n", d.MipLevels, d.Format, d.BindFlags);
     OutputDebugStringA(buf);*/
 
-    return texture.Get();
+    bytes = GetTextureBytes(res.Get());
+    return S_OK;
+}
+
+void TextureManager::RunLoadBenchmark(std::vector<std::string>& outLines)
+{
+    if (Renderer::IsHeadless())
+    {
+        outLines.push_back("Texture load benchmark skipped (headless)");
+        return;
+    }
+
+    //LbVʂɓǂݒ(eNX`͂̂Ă)
+    std::vector<std::string> paths;
+    m_textures.ForEach([&](TextureId, Entry& entry)
+    {
+        paths.push_back(entry.path);
+    });
+    std::sort(paths.begin(), paths.end());
+
+    char buf[256];
+    sprintf_s(buf, "Texture load benchmark (%zu loaded textures)", paths.size());
+    outLines.push_back(buf);
+
+    float totalDecodedMs = 0.0f, totalBakedMs = 0.0f;
+    size_t totalDecodedBytes = 0, totalBakedBytes = 0;
+    int bakedCount = 0;
+
+    for (const auto& path : paths)
+    {
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
+        size_t decodedBytes = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        if (FAILED(LoadDecoded(path, srv, decodedBytes)))
+        {
+            continue;   //DDS eNX`
+        }
+        const float decodedMs = ElapsedMs(start);
+        srv.Reset();
+
+        totalDecodedMs += decodedMs;
+        totalDecodedBytes += decodedBytes;
+
+        if (!HasFreshBake(path))
+        {
+            sprintf_s(buf, "  %s : WIC %.2f ms %zu KB (not baked)", path.c_str(), decodedMs, decodedBytes / 1024);
+            outLines.push_back(buf);
+            continue;
+        }
+
+        size_t bakedBytes = 0;
+        start = std::chrono::steady_clock::now();
+        if (FAILED(LoadBaked(path, srv, bakedBytes)))
+        {
+            continue;
+        }
+        const float bakedMs = ElapsedMs(start);
+        srv.Reset();
+
+        totalBakedMs += bakedMs;
+        totalBakedBytes += bakedBytes;
+        bakedCount++;
+
+        sprintf_s(buf, "  %s : WIC %.2f ms %zu KB / DDS %.2f ms %zu KB",
+            path.c_str(), decodedMs, decodedBytes / 1024, bakedMs, bakedBytes / 1024);
+        outLines.push_back(buf);
+    }
+
+    sprintf_s(buf, "total : WIC %.1f ms %zu KB / DDS %.1f ms %zu KB (%d baked)",
+        totalDecodedMs, totalDecodedBytes / 1024, totalBakedMs, totalBakedBytes / 1024, bakedCount);
+    outLines.push_back(buf);
+}
+
+void TextureManager::GatherResident(std::vector<ResidentAsset>& out)
+{
+    m_textures.ForEach([&](TextureId id, Entry& entry)
+    {
+        ResidentAsset asset;
+        asset.id = id.value;
+        asset.bytes = entry.bytes;
+        asset.lastUsedFrame = entry.lastUsedFrame;
+        asset.referenced = IsReferenced(entry.srv.Get());
+        asset.name = entry.path.c_str();
+        out.push_back(asset);
+    });
+}
+
+bool TextureManager::Evict(uint64_t id)
+{
+    Entry* entry = m_textures.Find(TextureId(id));
+    if (!entry || IsReferenced(entry->srv.Get()))
+    {
+        return false;
+    }
+
+    ResidencyManager::OnReleased(RESIDENT_TEXTURE, entry->bytes);
+    return m_textures.Erase(TextureId(id));
+}
+
+void TextureManager::Clear()
+{
+    m_textures.ForEach([](TextureId, Entry& entry)
+    {
+        ResidencyManager::OnReleased(RESIDENT_TEXTURE, entry.bytes);
+    });
+    m_textures.Clear();
 }
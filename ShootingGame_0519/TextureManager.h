@@ -1,15 +1,63 @@
 // TextureManager.h
 #pragma once
 #include <string>
-#include <unordered_map>
+#include <vector>
 #include <wrl/client.h>
 #include <d3d11.h>
+#include "AssetTable.h"
+#include "ResidencyManager.h"
 
 class TextureManager
 {
 public:
+    //ǂݍ݂̏Wv(N̍v)
+    struct Stats
+    {
+        int bakedCount = 0;         //Oϊ DDS ǂ񂾐
+        int decodedCount = 0;       //PNG / JPEG fR[h
+        float bakedMs = 0.0f;
+        float decodedMs = 0.0f;
+        size_t bakedBytes = 0;      //GPU ̑傫(~bv݂̐)
+        size_t decodedBytes = 0;
+    };
+
+    //<filepath>.dds 茳̉摜V΂ǂ(fR[h~bvȂ)
+    // WIC ŃfR[h GPU Ń~bv
     static ID3D11ShaderResourceView* Load(const std::string& filepath);
 
+    //t[Ăԏ͂(ID ̓RpCɌvZς݂Ȃ̂ŕȂ)
+    static ID3D11ShaderResourceView* Load(const TexturePath& path);
+
+    //--------Get֐-------
+    static const Stats& GetStats() { return m_stats; }
+
+    //Oϊ DDS ̃pX(TextureBaker ̏o)
+    static std::string GetBakedPath(const std::string& filepath);
+
+    //ǂݍݍς݂̃eNX` WIC  DDS ̗œǂݒĎԂƑ傫ׂ
+    static void RunLoadBenchmark(std::vector<std::string>& outLines);
+
+    //-----------------------풓Ǘ(ResidencyManager ɓo^)-----------------------
+    //gĂ鑤 ComPtr Ŏ(QƃJEg1ȂLbVĂȂ)
+    static void GatherResident(std::vector<ResidentAsset>& out);
+    static bool Evict(uint64_t id);
+    static void Clear();
+
 private:
-    static std::unordered_map<std::string, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> m_textures;
+    struct Entry
+    {
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
+        std::string path;
+        size_t bytes = 0;
+        uint64_t lastUsedFrame = 0;
+    };
+
+    static ID3D11ShaderResourceView* Load(TextureId id, const char* filepath);
+
+    static bool HasFreshBake(const std::string& filepath);
+    static HRESULT LoadBaked(const std::string& filepath, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& out, size_t& bytes);
+    static HRESULT LoadDecoded(const std::string& filepath, Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>& out, size_t& bytes);
+
+    static AssetTable<TextureAssetTag, Entry> m_textures;
+    static Stats m_stats;
 };
@@ -0,0 +1,369 @@
+#define NOMINMAX
+#include <windows.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include "TimerWheel.h"
+#include "RandomService.h"
+
+TimerWheel TimerWheel::s_game;
+
+namespace
+{
+    //4iŎĂԒ҂(蒷\͐؂l߂)
+    constexpr uint64_t MAX_TICKS = (1ull << 32) - 256;
+}
+
+//-----------------------Timer-----------------------
+
+void TimerWheel::Timer::Start(float seconds, Callback callback)
+{
+    Stop();
+    m_handle = TimerWheel::GetGame().Schedule(seconds, std::move(callback));
+}
+
+void TimerWheel::Timer::Stop()
+{
+    if (m_handle != 0)
+    {
+        TimerWheel::GetGame().Cancel(m_handle);
+        m_handle = 0;
+    }
+}
+
+bool TimerWheel::Timer::IsActive() const
+{
+    return m_handle != 0 && TimerWheel::GetGame().IsPending(m_handle);
+}
+
+float TimerWheel::Timer::GetRemaining() const
+{
+    return (m_handle != 0) ? TimerWheel::GetGame().GetRemaining(m_handle) : 0.0f;
+}
+
+//-----------------------TimerWheel-----------------------
+
+TimerWheel::TimerWheel()
+{
+    std::fill(std::begin(m_slots), std::end(m_slots), -1);
+}
+
+TimerWheel::Handle TimerWheel::Schedule(float seconds, Callback callback)
+{
+    //Œ 1 tick ( tick ͂ĂяIĂ)
+    const double ticks = std::ceil(static_cast<double>(seconds) * TICKS_PER_SECOND - 1e-3);
+    const uint64_t delay = std::clamp<uint64_t>(ticks > 1.0 ? static_cast<uint64_t>(ticks) : 1, 1, MAX_TICKS);
+
+    int index;
+    if (!m_free.empty())
+    {
+        index = m_free.back();
+        m_free.pop_back();
+    }
+    else
+    {
+        index = static_cast<int>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+
+    Node& node = m_nodes[index];
+    node.expire = m_tick + delay;
+    node.callback = std::move(callback);
+    Link(index);
+
+    m_active++;
+    m_stats.scheduled++;
+    return (static_cast<Handle>(node.generation) << 32) | static_cast<Handle>(index + 1);
+}
+
+bool TimerWheel::Cancel(Handle handle)
+{
+    const int index = Resolve(handle);
+    if (index < 0)
+    {
+        return false;
+    }
+
+    Unlink(index);
+    Release(index);
+    m_stats.cancelled++;
+    return true;
+}
+
+bool TimerWheel::IsPending(Handle handle) const
+{
+    return Resolve(handle) >= 0;
+}
+
+float TimerWheel::GetRemaining(Handle handle) const
+{
+    const int index = Resolve(handle);
+    if (index < 0)
+    {
+        return 0.0f;
+    }
+
+    const double remaining = static_cast<double>(m_nodes[index].expire) / TICKS_PER_SECOND - m_time;
+    return static_cast<float>(std::max(remaining, 0.0));
+}
+
+void TimerWheel::Advance(float dt)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+
+    m_stats.fired = 0;
+    m_stats.scheduled = 0;
+    m_stats.cancelled = 0;
+    m_stats.cascaded = 0;
+
+    m_time += dt;
+    const uint64_t target = static_cast<uint64_t>(m_time * TICKS_PER_SECOND + 1e-6);
+
+    while (m_tick < target)
+    {
+        ++m_tick;
+
+        //̒iA̒i̍̃Xbg낷
+        if ((m_tick & (SLOTS - 1)) == 0)
+        {
+            for (int level = 1; level < LEVELS; ++level)
+            {
+                Cascade(level);
+                if (((m_tick >> (SLOT_BITS * level)) & (SLOTS - 1)) != 0)
+                {
+                    break;
+                }
+            }
+        }
+
+        // tick ̃XbgɂȂ܂ŌĂ(ĂԒł̗\͕K tick ɓ)
+        int& head = m_slots[m_tick & (SLOTS - 1)];
+        while (head >= 0)
+        {
+            const int index = head;
+            Unlink(index);
+
+            Callback callback = std::move(m_nodes[index].callback);
+            Release(index);
+
+            m_stats.fired++;
+            if (callback)
+            {
+                callback();
+            }
+        }
+    }
+
+    m_stats.active = m_active;
+    m_stats.advanceMs = static_cast<float>(std::chrono::duration<double, std::milli>(
+        std::chrono::high_resolution_clock::now() - start).count());
+}
+
+void TimerWheel::Clear()
+{
+    //͐i߂̂ŁAcĂ Timer  handle ͖ɂȂ
+    for (int i = 0; i < static_cast<int>(m_nodes.size()); ++i)
+    {
+        if (m_nodes[i].slot >= 0)
+        {
+            Unlink(i);
+            Release(i);
+        }
+    }
+
+    m_tick = 0;
+    m_time = 0.0;
+    m_active = 0;
+    m_stats = Stats();
+}
+
+int TimerWheel::Resolve(Handle handle) const
+{
+    if (handle == 0)
+    {
+        return -1;
+    }
+
+    const int index = static_cast<int>(handle & 0xffffffffu) - 1;
+    const uint32_t generation = static_cast<uint32_t>(handle >> 32);
+    if (index < 0 || index >= static_cast<int>(m_nodes.size()))
+    {
+        return -1;
+    }
+
+    const Node& node = m_nodes[index];
+    return (node.slot >= 0 && node.generation == generation) ? index : -1;
+}
+
+void TimerWheel::Link(int index)
+{
+    Node& node = m_nodes[index];
+
+    //c̒Œi߁A̒ǐŃXbg߂
+    const uint64_t delta = node.expire - m_tick;
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (1ull << (SLOT_BITS * (level + 1))))
+    {
+        ++level;
+    }
+
+    const int slot = level * SLOTS + static_cast<int>((node.expire >> (SLOT_BITS * level)) & (SLOTS - 1));
+
+    node.slot = slot;
+    node.prev = -1;
+    node.next = m_slots[slot];
+    if (node.next >= 0)
+    {
+        m_nodes[node.next].prev = index;
+    }
+    m_slots[slot] = index;
+}
+
+void TimerWheel::Unlink(int index)
+{
+    Node& node = m_nodes[index];
+
+    if (node.prev >= 0)
+    {
+        m_nodes[node.prev].next = node.next;
+    }
+    else
+    {
+        m_slots[node.slot] = node.next;
+    }
+
+    if (node.next >= 0)
+    {
+        m_nodes[node.next].prev = node.prev;
+    }
+
+    node.prev = -1;
+    node.next = -1;
+}
+
+void TimerWheel::Release(int index)
+{
+    Node& node = m_nodes[index];
+    node.callback = nullptr;
+    node.slot = -1;
+    node.generation++;
+    m_free.push_back(index);
+    m_active--;
+}
+
+void TimerWheel::Cascade(int level)
+{
+    const int slot = level * SLOTS + static_cast<int>((m_tick >> (SLOT_BITS * level)) & (SLOTS - 1));
+
+    //XbgƊOĂq(c肪ZȂ̂ŉ̒iɓ)
+    int index = m_slots[slot];
+    m_slots[slot] = -1;
+    while (index >= 0)
+    {
+        const int next = m_nodes[index].next;
+        Link(index);
+        m_stats.cascaded++;
+        index = next;
+    }
+}
+
+void TimerWheel::RunTimerBenchmark(std::vector<std::string>& outLines)
+{
+    const int entities = 100000;
+    const int frames = 600;
+    const float dt = 1.0f / 60.0f;
+    char buf[256];
+
+    outLines.push_back("Timer benchmark (100000 entities, 600 frames at 60 fps)");
+
+    //O̍ : R|[lgƂɖt[ float 𑫂Ĕׂ
+    struct PollingTimer
+    {
+        virtual ~PollingTimer() = default;
+        virtual void Update(float dt)
+        {
+            m_timer += dt;
+            if (m_timer >= m_cooldown)
+            {
+                m_timer = 0.0f;
+                ++*m_fired;
+            }
+        }
+        float m_timer = 0.0f;
+        float m_cooldown = 1.0f;
+        int* m_fired = nullptr;
+    };
+
+    //zC[Ɏ̎Ԃ\񂷂
+    struct WheelTimer
+    {
+        void Arm()
+        {
+            m_wheel->Schedule(m_cooldown, [this]()
+                {
+                    ++*m_fired;
+                    Arm();
+                });
+        }
+        TimerWheel* m_wheel = nullptr;
+        float m_cooldown = 1.0f;
+        int* m_fired = nullptr;
+    };
+
+    //cooldown 0.5 ` 5 b(G)ƁA60 b(҂ŉȂG)
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        const bool idle = (pass == 1);
+        RandomStream rng(99, 0);
+        std::vector<float> cooldowns(entities);
+        for (float& c : cooldowns)
+        {
+            c = idle ? 60.0f : rng.Range(0.5f, 5.0f);
+        }
+
+        int pollFired = 0;
+        std::vector<std::unique_ptr<PollingTimer>> polling;
+        polling.reserve(entities);
+        for (float c : cooldowns)
+        {
+            auto t = std::make_unique<PollingTimer>();
+            t->m_cooldown = c;
+            t->m_fired = &pollFired;
+            polling.push_back(std::move(t));
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            for (auto& t : polling)
+            {
+                t->Update(dt);
+            }
+        }
+        const double pollMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        int wheelFired = 0;
+        TimerWheel wheel;
+        std::vector<WheelTimer> wheelTimers(entities);
+        for (int i = 0; i < entities; ++i)
+        {
+            wheelTimers[i].m_wheel = &wheel;
+            wheelTimers[i].m_cooldown = cooldowns[i];
+            wheelTimers[i].m_fired = &wheelFired;
+            wheelTimers[i].Arm();
+        }
+
+        start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < frames; ++frame)
+        {
+            wheel.Advance(dt);
+        }
+        const double wheelMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        sprintf_s(buf, "  %s : polling %.3f ms/frame (%d fired), wheel %.3f ms/frame (%d fired)",
+            idle ? "idle 60s  " : "cooldowns ", pollMs / frames, pollFired, wheelMs / frames, wheelFired);
+        outLines.push_back(buf);
+    }
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <functional>
+
+//---------------------------------------------------------
+// ҂ԁEN[_EEԂĂԊKw^C}[zC[
+// E1 tick = 1/240 bB256 Xbg x 4 iŁAiƂ 256 {̒
+// E\Ǝ O(1)(Xbg̑oXgɌqEO)
+// E̒ĩXbg͉̒i1񂾂낷(JXP[h)
+// E҂Ă邾̃IuWFNg͖t[Ȃ
+// R|[lg TimerWheel::Timer oɎA鎞ɎŎ
+//---------------------------------------------------------
+class TimerWheel
+{
+public:
+    using Callback = std::function<void()>;
+    using Handle = uint64_t;    //0 ͖
+
+    static constexpr int TICKS_PER_SECOND = 240;
+
+    //߂ Advance ̓v
+    struct Stats
+    {
+        int active = 0;         //҂Ă鐔
+        int fired = 0;          //Ă񂾐
+        int scheduled = 0;      //\񂵂
+        int cancelled = 0;      //
+        int cascaded = 0;       //̒i牺낵
+        float advanceMs = 0.0f;
+    };
+
+    //---------------------------------------------------------
+    // Q[̃zC[ւ̗\1(Rs[s)
+    // Start ƑO̗\͎B鎞
+    //---------------------------------------------------------
+    class Timer
+    {
+    public:
+        Timer() = default;
+        ~Timer() { Stop(); }
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        void Start(float seconds, Callback callback);
+        void Stop();
+
+        bool IsActive() const;
+        float GetRemaining() const;     //~܂Ă 0
+
+    private:
+        Handle m_handle = 0;
+    };
+
+    TimerWheel();
+
+    //seconds (Œ 1 tick ) callback Ă
+    Handle Schedule(float seconds, Callback callback);
+
+    //܂ĂłȂΎ(Ă񂾌E handle ͉Ȃ)
+    bool Cancel(Handle handle);
+
+    bool IsPending(Handle handle) const;
+    float GetRemaining(Handle handle) const;
+
+    //dt i߂āAԂ̂ tick ̑ɌĂ( tick ̒̏Ԃ񓯂)
+    //ĂԒŐV\EĂǂ
+    void Advance(float dt);
+
+    //SĎԂ 0 ɖ߂(callback ͌Ă΂Ȃ)
+    void Clear();
+
+    //--------Get֐-------
+    uint64_t GetTick() const { return m_tick; }
+    const Stats& GetStats() const { return m_stats; }
+
+    //Q[ŎgzC[(Game ̍XVŐi߂)
+    static TimerWheel& GetGame() { return s_game; }
+
+    //t[ float ̃^C}[𑫂Ɣׂ(DebugBenchmark ɓo^)
+    static void RunTimerBenchmark(std::vector<std::string>& outLines);
+
+private:
+    static constexpr int SLOT_BITS = 8;
+    static constexpr int SLOTS = 1 << SLOT_BITS;
+    static constexpr int LEVELS = 4;
+
+    struct Node
+    {
+        uint64_t expire = 0;
+        Callback callback;
+        int prev = -1;
+        int next = -1;
+        int slot = -1;              //qĂXbg(-1 Ȃ)
+        uint32_t generation = 1;    //g񂷓xɐi߂(Â handle e)
+    };
+
+    int Resolve(Handle handle) const;
+    void Link(int index);
+    void Unlink(int index);
+    void Release(int index);
+    void Cascade(int level);
+
+    std::vector<Node> m_nodes;
+    std::vector<int> m_free;
+    int m_slots[LEVELS * SLOTS];    //XbgƂ̐擪(-1 Ȃ)
+
+    uint64_t m_tick = 0;
+    double m_time = 0.0;            //Advance Ői߂b(tick ̒[)
+    int m_active = 0;
+
+    Stats m_stats;
+
+    static TimerWheel s_game;
+};
@@ -13,6 +13,14 @@
 #include "EffectManager.h"
 #include "SceneManager.h"
 
+namespace
+{
+    constexpr SoundPath TITLE_PASSING_SE(L"Asset/Sound/SE/TitlePlayerPassing.wav");
+    constexpr SoundPath TITLE_SELECT_SE(L"Asset/Sound/SE/TitleSelect01.wav");
+    //J[\ړ̉͏d˂炵
+    constexpr SeLimits TITLE_SE_LIMITS{ 1, 2, 0.0f };
+}
+
 void TitleScene::Init()
 {
     m_camera = std::make_shared<CameraObject>();
@@ -73,7 +81,7 @@ void TitleScene::Init()
         m_SkyDome->SetCamera(freeCamComp.get());
     }
     
-    Sound::PlaySeWav(L"Asset/Sound/SE/TitlePlayerPassing.wav", 0.5f);
+    Sound::PlaySeWav(TITLE_PASSING_SE, 0.5f, TITLE_SE_LIMITS);
 }
 
 void TitleScene::Update(float deltatime)
@@ -159,7 +167,7 @@ void TitleScene::Update(float deltatime)
         {
             if (TransitionManager::IsTransitioning()){ return; }
 
-            Sound::PlaySeWav(L"Asset/Sound/SE/TitleSelect01.wav", 0.5f);
+            Sound::PlaySeWav(TITLE_SELECT_SE, 0.5f, TITLE_SE_LIMITS);
             
             TransitionManager::Start(3.0f,
                 []()
@@ -172,7 +180,7 @@ void TitleScene::Update(float deltatime)
         {
             if (TransitionManager::IsTransitioning()) { return; }
 
-            Sound::PlaySeWav(L"Asset/Sound/SE/TitleSelect01.wav", 0.5f);
+            Sound::PlaySeWav(TITLE_SELECT_SE, 0.5f, TITLE_SE_LIMITS);
 
             TransitionManager::Start(3.0f,
                 []()
@@ -1,13 +1,14 @@
 #include "TransitionManager.h"
 #include "TextureManager.h"
 #include "SceneManager.h"
+#include <d3d11.h>
 #include "Renderer.h"         // DrawFullScreenQuad iŎgj
 #include "Application.h"
 #include <cassert>
 #include <iostream>
 #include <algorithm>
 
-ID3D11ShaderResourceView* TransitionManager::m_TextureSRV;
+Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> TransitionManager::m_TextureSRV;
 bool  TransitionManager::m_isTransitioning;
 float TransitionManager::m_fadeSpeed;
 TransitionType TransitionManager::m_type = TransitionType::FADE;
@@ -131,7 +132,7 @@ void TransitionManager::Draw(float deltaTime)
     Renderer::SetTextureAlpha(m_alpha);
 
     //摜`
-    Renderer::DrawTexture(m_TextureSRV, topLeft, size);
+    Renderer::DrawTexture(m_TextureSRV.Get(), topLeft, size);
 
     Renderer::SetBlendState(BS_NONE);
     Renderer::SetDepthEnable(true);
@@ -1,4 +1,5 @@
 #include "TransitionRenderer.h"
+#include <d3d11.h>
 #include "renderer.h" // Renderer::GetDevice()/GetDeviceContext()
 #include <d3dcompiler.h>
 #include <wrl/client.h>
@@ -0,0 +1,129 @@
+#include <algorithm>
+#include "WorkerPool.h"
+
+std::vector<std::thread> WorkerPool::m_threads;
+
+std::mutex WorkerPool::m_mutex;
+std::condition_variable WorkerPool::m_wakeCv;
+std::condition_variable WorkerPool::m_doneCv;
+
+const WorkerPool::JobFunc* WorkerPool::m_func = nullptr;
+size_t WorkerPool::m_jobCount = 0;
+std::atomic<size_t> WorkerPool::m_nextJob{ 0 };
+int WorkerPool::m_participants = 1;
+int WorkerPool::m_pendingWorkers = 0;
+unsigned int WorkerPool::m_generation = 0;
+bool WorkerPool::m_stop = false;
+
+void WorkerPool::Init(int threadCount)
+{
+    Uninit();
+
+    if (threadCount <= 0)
+    {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    threadCount = std::max(threadCount, 1);
+
+    m_stop = false;
+
+    //Ăяo[J[0Ȃ̂ŁA풓Xbh1ȂĂ悢
+    for (int i = 1; i < threadCount; ++i)
+    {
+        m_threads.emplace_back(WorkerMain, i);
+    }
+}
+
+void WorkerPool::Uninit()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeCv.notify_all();
+
+    for (auto& t : m_threads)
+    {
+        if (t.joinable()) { t.join(); }
+    }
+    m_threads.clear();
+}
+
+void WorkerPool::RunJobs(int workerIndex)
+{
+    while (true)
+    {
+        size_t job = m_nextJob.fetch_add(1);
+        if (job >= m_jobCount) { break; }
+
+        (*m_func)(job, workerIndex);
+    }
+}
+
+void WorkerPool::WorkerMain(int workerIndex)
+{
+    unsigned int seenGeneration = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCv.wait(lock, [&]() { return m_stop || m_generation != seenGeneration; });
+
+            if (m_stop) { return; }
+            seenGeneration = m_generation;
+
+            //͎QȂ
+            if (workerIndex >= m_participants) { continue; }
+        }
+
+        RunJobs(workerIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pendingWorkers--;
+        }
+        m_doneCv.notify_one();
+    }
+}
+
+void WorkerPool::ParallelFor(size_t jobCount, const JobFunc& func, int maxThreads)
+{
+    if (jobCount == 0) { return; }
+
+    int participants = GetThreadCount();
+    if (maxThreads > 0)
+    {
+        participants = std::min(participants, maxThreads);
+    }
+    participants = static_cast<int>(std::min<size_t>(participants, jobCount));
+
+    //1XbhȂ炻̂܂܉
+    if (participants <= 1)
+    {
+        for (size_t i = 0; i < jobCount; ++i)
+        {
+            func(i, 0);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_func = &func;
+        m_jobCount = jobCount;
+        m_nextJob.store(0);
+        m_participants = participants;
+        m_pendingWorkers = participants - 1;
+        m_generation++;
+    }
+    m_wakeCv.notify_all();
+
+    //Ăяo[J[0ƂĎQ
+    RunJobs(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCv.wait(lock, []() { return m_pendingWorkers == 0; });
+
+    m_func = nullptr;
+}
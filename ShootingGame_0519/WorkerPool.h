@@ -0,0 +1,48 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+
+//---------------------------------------------------------
+// 풓[J[Xbh ParallelFor sNX
+// ĂяoXbh[J[0ƂĎQASWuI܂Ŗ߂Ȃ
+// (D3ĎĂяo̓CXbĥ݁BłCPU𗬂)
+//---------------------------------------------------------
+class WorkerPool
+{
+public:
+    //job : Wuԍ, worker : sĂ郏[J[ԍ(0 ͌Ăяo)
+    using JobFunc = std::function<void(size_t job, int worker)>;
+
+    //threadCount : Ăяo܂ރXbh(0ȂCPURA)
+    static void Init(int threadCount = 0);
+    static void Uninit();
+
+    //jobCount ̃WuɎs
+    //maxThreads : gXbh̏(0Ȃv[S)
+    static void ParallelFor(size_t jobCount, const JobFunc& func, int maxThreads = 0);
+
+    //--------Get֐-------
+    static int GetThreadCount() { return static_cast<int>(m_threads.size()) + 1; }
+
+private:
+    static void WorkerMain(int workerIndex);
+    static void RunJobs(int workerIndex);
+
+    static std::vector<std::thread> m_threads;
+
+    static std::mutex m_mutex;
+    static std::condition_variable m_wakeCv;
+    static std::condition_variable m_doneCv;
+
+    static const JobFunc* m_func;
+    static size_t m_jobCount;
+    static std::atomic<size_t> m_nextJob;
+    static int m_participants;          //QXbh(Ăяo)
+    static int m_pendingWorkers;        //܂IĂȂ[J[
+    static unsigned int m_generation;   //ParallelFor ̌Ăяoɐi߂
+    static bool m_stop;
+};
@@ -0,0 +1,638 @@
+#define NOMINMAX
+#include <windows.h>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include "WorldStreamer.h"
+#include "Building.h"
+#include "IScene.h"
+#include "ModelCache.h"
+#include "ModelComponent.h"
+#include "RandomService.h"
+
+using namespace DirectX::SimpleMath;
+
+bool WorldStreamer::m_active = false;
+WorldStreamer::Settings WorldStreamer::m_settings;
+BuildingSpawner* WorldStreamer::m_spawner = nullptr;
+std::vector<WorldStreamer::Layer> WorldStreamer::m_layers;
+
+std::vector<WorldStreamer::ModelSlot> WorldStreamer::m_modelSlots;
+std::vector<int> WorldStreamer::m_layerSlot;
+std::vector<std::shared_ptr<PreparedModel>> WorldStreamer::m_prepared;
+std::vector<std::shared_ptr<ModelData>> WorldStreamer::m_models;
+
+StageGrid WorldStreamer::m_grid;
+StageLayout WorldStreamer::m_layout;
+int WorldStreamer::m_chunkCols = 0;
+int WorldStreamer::m_chunkRows = 0;
+std::vector<WorldStreamer::Chunk> WorldStreamer::m_chunks;
+std::vector<int> WorldStreamer::m_activeChunks;
+std::deque<int> WorldStreamer::m_placeOrder;
+
+std::vector<std::vector<WorldStreamer::Instance>> WorldStreamer::m_plan;
+std::atomic<bool> WorldStreamer::m_planReady{ false };
+float WorldStreamer::m_planMs = 0.0f;
+
+std::thread WorldStreamer::m_thread;
+std::mutex WorldStreamer::m_mutex;
+std::condition_variable WorldStreamer::m_wakeCv;
+std::condition_variable WorldStreamer::m_doneCv;
+std::deque<WorldStreamer::Request> WorldStreamer::m_requests;
+std::vector<WorldStreamer::Result> WorldStreamer::m_results;
+int WorldStreamer::m_inFlight = 0;
+bool WorldStreamer::m_quit = false;
+
+WorldStreamer::Stats WorldStreamer::m_stats;
+
+bool WorldStreamer::Init(BuildingSpawner* spawner, const StageData& stage, const std::vector<Layer>& layers, const Settings& settings)
+{
+    Uninit();
+
+    if (stage.grid.IsEmpty() || stage.layout.cellSize <= 0.0f || settings.chunkCells <= 0)
+    {
+        OutputDebugStringA("[WorldStreamer] empty stage\n");
+        return false;
+    }
+
+    m_settings = settings;
+    m_settings.unloadRadius = std::max(m_settings.unloadRadius, m_settings.loadRadius);
+    m_settings.spawnBudget = std::max(m_settings.spawnBudget, 1);
+
+    m_spawner = spawner;
+    m_grid = stage.grid;
+    m_layout = stage.layout;
+
+    //eC[̌̓Xe[W̒uꏊS(dȂ̑Iʂ͓ǂݍݗpXbhōs)
+    m_layers = layers;
+    for (Layer& layer : m_layers)
+    {
+        layer.config.fixedPositions = stage.GetPlacements(layer.cellValue);
+        layer.config.count = 0;
+    }
+
+    //f̃C[1̘gɂ܂Ƃ߂(ǂݍݍς݂̃f͓ǂݍݗpXbhɗ܂Ȃ)
+    m_layerSlot.assign(m_layers.size(), -1);
+    for (size_t i = 0; i < m_layers.size(); ++i)
+    {
+        const std::string& path = m_layers[i].config.modelPath;
+        if (path.empty())
+        {
+            continue;
+        }
+
+        auto it = std::find_if(m_modelSlots.begin(), m_modelSlots.end(),
+            [&path](const ModelSlot& slot) { return slot.path == path; });
+        if (it != m_modelSlots.end())
+        {
+            m_layerSlot[i] = static_cast<int>(it - m_modelSlots.begin());
+            continue;
+        }
+
+        ModelSlot slot;
+        slot.path = path;
+        std::shared_ptr<ModelData> model = ModelCache::Find(path);
+        slot.cached = (model != nullptr);
+        m_layerSlot[i] = static_cast<int>(m_modelSlots.size());
+        m_modelSlots.push_back(slot);
+        m_models.push_back(std::move(model));
+    }
+    m_prepared.assign(m_modelSlots.size(), nullptr);
+
+    BuildChunks(m_grid, m_layout, m_settings.chunkCells, m_chunkCols, m_chunkRows, m_chunks);
+
+    m_stats = Stats();
+    m_stats.chunks = static_cast<int>(m_chunks.size());
+
+    m_planReady = false;
+    m_planMs = 0.0f;
+    m_quit = false;
+    m_inFlight = 0;
+    m_thread = std::thread(&WorldStreamer::LoaderMain);
+
+    m_active = true;
+    return true;
+}
+
+void WorldStreamer::Uninit()
+{
+    if (m_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_quit = true;
+        }
+        m_wakeCv.notify_one();
+        m_thread.join();
+    }
+
+    //V[̌nŌ͏̂ŁAł͎QƂO
+    m_chunks.clear();
+    m_activeChunks.clear();
+    m_placeOrder.clear();
+    m_plan.clear();
+    m_requests.clear();
+    m_results.clear();
+    m_layers.clear();
+    m_modelSlots.clear();
+    m_layerSlot.clear();
+    m_prepared.clear();
+    m_models.clear();
+    m_grid = StageGrid();
+    m_inFlight = 0;
+    m_planReady = false;
+    m_spawner = nullptr;
+    m_active = false;
+}
+
+void WorldStreamer::Update(const Vector3& focusPos)
+{
+    if (!m_active || !m_planReady.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    //m_planReady Ȃ̂œǂݍݗpXbh̏Ԃ
+    m_stats.planMs = m_planMs;
+
+    ReceiveResults();
+
+    //ǂݍ : focusPos  loadRadius ̎lpɊ|`N
+    const int n = m_settings.chunkCells;
+    const int centerCol = m_grid.cols / 2;
+    const int centerRow = m_layout.centerRows ? m_grid.rows / 2 : 0;
+    const float invChunk = 1.0f / (m_layout.cellSize * n);
+    const float radius = m_settings.loadRadius;
+
+    auto toChunk = [invChunk](float world, int center, int n, int limit)
+    {
+        const float cellIndex = world * invChunk * n + center + 0.5f;
+        return std::clamp(static_cast<int>(std::floor(cellIndex / n)), 0, limit - 1);
+    };
+    const int cx0 = toChunk(focusPos.x - radius, centerCol, n, m_chunkCols);
+    const int cx1 = toChunk(focusPos.x + radius, centerCol, n, m_chunkCols);
+    const int cz0 = toChunk(focusPos.z - radius, centerRow, n, m_chunkRows);
+    const int cz1 = toChunk(focusPos.z + radius, centerRow, n, m_chunkRows);
+
+    const float loadSq = radius * radius;
+    for (int cz = cz0; cz <= cz1; ++cz)
+    {
+        for (int cx = cx0; cx <= cx1; ++cx)
+        {
+            const int index = cz * m_chunkCols + cx;
+            if (m_chunks[index].state == CHUNK_UNLOADED && DistanceSqToChunk(m_chunks[index], focusPos) <= loadSq)
+            {
+                RequestChunk(index);
+            }
+        }
+    }
+
+    //O : unloadRadius 艓Ȃ`N(ǂݍݒȂ)
+    const float unloadSq = m_settings.unloadRadius * m_settings.unloadRadius;
+    for (size_t i = 0; i < m_activeChunks.size(); )
+    {
+        const int index = m_activeChunks[i];
+        if (DistanceSqToChunk(m_chunks[index], focusPos) > unloadSq)
+        {
+            UnloadChunk(index);
+            m_activeChunks[i] = m_activeChunks.back();
+            m_activeChunks.pop_back();
+            continue;
+        }
+        ++i;
+    }
+
+    PlaceWaiting(m_settings.spawnBudget);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    m_stats.placeMs = static_cast<float>(std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+void WorldStreamer::LoadAround(const Vector3& focusPos)
+{
+    if (!m_active)
+    {
+        return;
+    }
+
+    //v悪I܂ő҂
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCv.wait(lock, []() { return m_quit || m_planReady.load(std::memory_order_acquire); });
+    }
+
+    Update(focusPos);
+
+    //񂾃`NS͂܂ő҂ĂAŒu
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_doneCv.wait(lock, []() { return m_quit || static_cast<int>(m_results.size()) >= m_inFlight; });
+    }
+
+    ReceiveResults();
+    PlaceWaiting(INT_MAX);
+}
+
+void WorldStreamer::LoaderMain()
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    BuildPlan(m_grid, m_layout, m_settings.chunkCells, m_chunkCols, m_layers, m_plan);
+    auto end = std::chrono::high_resolution_clock::now();
+    m_planMs = static_cast<float>(std::chrono::duration<double, std::milli>(end - start).count());
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_planReady.store(true, std::memory_order_release);
+    }
+    m_doneCv.notify_all();
+
+    //ǂݍނ悤ɗ񂾃f(̃XbhG)
+    std::vector<bool> modelRequested(m_modelSlots.size(), false);
+
+    while (true)
+    {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCv.wait(lock, []() { return m_quit || !m_requests.empty(); });
+            if (m_quit)
+            {
+                return;
+            }
+            request = m_requests.front();
+            m_requests.pop_front();
+        }
+
+        //uꏊn(RC_[̓CXbhō)
+        Result result;
+        result.chunk = request.chunk;
+        result.generation = request.generation;
+        result.instances = m_plan[request.chunk];
+
+        //̃`Nŏ߂ďoĂf CPU ̓ǂݍ݂܂łōς܂(GPU ւ̓]̓CXbh)
+        for (const Instance& instance : result.instances)
+        {
+            const int slot = m_layerSlot[instance.layer];
+            if (slot < 0 || modelRequested[slot] || m_modelSlots[slot].cached)
+            {
+                continue;
+            }
+            modelRequested[slot] = true;
+
+            auto modelStart = std::chrono::high_resolution_clock::now();
+            result.models.push_back({ slot, ModelComponent::PrepareModel(m_modelSlots[slot].path) });
+            auto modelEnd = std::chrono::high_resolution_clock::now();
+            result.modelMs += static_cast<float>(std::chrono::duration<double, std::milli>(modelEnd - modelStart).count());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_results.push_back(std::move(result));
+        }
+        m_doneCv.notify_all();
+    }
+}
+
+void WorldStreamer::BuildChunks(const StageGrid& grid, const StageLayout& layout, int chunkCells, int& outCols, int& outRows, std::vector<Chunk>& out)
+{
+    const int n = chunkCells;
+    outCols = (grid.cols + n - 1) / n;
+    outRows = (grid.rows + n - 1) / n;
+
+    const int centerCol = grid.cols / 2;
+    const int centerRow = layout.centerRows ? grid.rows / 2 : 0;
+    const float cell = layout.cellSize;
+
+    //`N͈̔([̃}X̒S甼}XL)
+    out.assign(static_cast<size_t>(outCols) * outRows, Chunk());
+    for (int cz = 0; cz < outRows; ++cz)
+    {
+        for (int cx = 0; cx < outCols; ++cx)
+        {
+            Chunk& chunk = out[static_cast<size_t>(cz) * outCols + cx];
+            const int lastCol = std::min((cx + 1) * n, grid.cols) - 1;
+            const int lastRow = std::min((cz + 1) * n, grid.rows) - 1;
+            chunk.minX = (cx * n - centerCol) * cell - cell * 0.5f;
+            chunk.maxX = (lastCol - centerCol) * cell + cell * 0.5f;
+            chunk.minZ = (cz * n - centerRow) * cell - cell * 0.5f;
+            chunk.maxZ = (lastRow - centerRow) * cell + cell * 0.5f;
+        }
+    }
+}
+
+void WorldStreamer::BuildPlan(const StageGrid& grid, const StageLayout& layout, int chunkCells, int chunkCols,
+    std::vector<Layer>& layers, std::vector<std::vector<Instance>>& out)
+{
+    const int n = chunkCells;
+    const int chunkRows = (grid.rows + n - 1) / n;
+    out.assign(static_cast<size_t>(chunkCols) * chunkRows, std::vector<Instance>());
+
+    const int centerCol = grid.cols / 2;
+    const int centerRow = layout.centerRows ? grid.rows / 2 : 0;
+    const float invCell = 1.0f / layout.cellSize;
+
+    std::vector<Vector3> accepted;
+    for (int layer = 0; layer < static_cast<int>(layers.size()); ++layer)
+    {
+        //BuildingSpawner::Spawn ƓdȂ̑I(Xe[WŜ1)
+        BuildingSpawner::SelectFixedPositions(layers[layer].config, accepted);
+
+        for (const Vector3& pos : accepted)
+        {
+            const int col = std::clamp(static_cast<int>(std::lround(pos.x * invCell)) + centerCol, 0, grid.cols - 1);
+            const int row = std::clamp(static_cast<int>(std::lround(pos.z * invCell)) + centerRow, 0, grid.rows - 1);
+            out[static_cast<size_t>(row / n) * chunkCols + col / n].push_back({ layer, pos });
+        }
+
+        //͂gȂ
+        std::vector<Vector3>().swap(layers[layer].config.fixedPositions);
+    }
+}
+
+void WorldStreamer::RequestChunk(int index)
+{
+    Chunk& chunk = m_chunks[index];
+    chunk.state = CHUNK_REQUESTED;
+    m_activeChunks.push_back(index);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_requests.push_back({ index, chunk.generation });
+        m_inFlight++;
+    }
+    m_wakeCv.notify_one();
+}
+
+void WorldStreamer::UnloadChunk(int index)
+{
+    Chunk& chunk = m_chunks[index];
+
+    //܂ǂݍݗpXbhĂȂΗ񂾂̂
+    if (chunk.state == CHUNK_REQUESTED)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = std::find_if(m_requests.begin(), m_requests.end(),
+            [index](const Request& r) { return r.chunk == index; });
+        if (it != m_requests.end())
+        {
+            m_requests.erase(it);
+            m_inFlight--;
+        }
+    }
+
+    //V[O(RC_[̓o^ RemoveObject ŊO)
+    IScene* scene = m_spawner ? m_spawner->GetScene() : nullptr;
+    if (scene)
+    {
+        for (const auto& building : chunk.placed)
+        {
+            scene->RemoveObject(building.get());
+        }
+    }
+
+    m_stats.resident -= static_cast<int>(chunk.placed.size());
+    if (chunk.state != CHUNK_REQUESTED)
+    {
+        m_stats.unloads++;
+    }
+
+    chunk.placed.clear();
+    chunk.placed.shrink_to_fit();
+    chunk.waiting.clear();
+    chunk.state = CHUNK_UNLOADED;
+    chunk.generation++;
+}
+
+void WorldStreamer::ReceiveResults()
+{
+    std::vector<Result> results;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        results.swap(m_results);
+        m_inFlight -= static_cast<int>(results.size());
+    }
+
+    for (Result& result : results)
+    {
+        //f1񂵂ǂݍ܂Ȃ̂ŁAO`Ňʂł󂯎Ă
+        for (PreparedSlot& prepared : result.models)
+        {
+            m_prepared[prepared.slot] = std::move(prepared.model);
+        }
+        m_stats.modelMs += result.modelMs;
+
+        Chunk& chunk = m_chunks[result.chunk];
+
+        //񂾌ɊO`Ňʂ͎̂Ă(͂܂ĂȂ)
+        if (chunk.state != CHUNK_REQUESTED || chunk.generation != result.generation)
+        {
+            continue;
+        }
+
+        chunk.state = CHUNK_PLACING;
+        chunk.waiting = std::move(result.instances);
+        chunk.placed.reserve(chunk.waiting.size());
+        m_placeOrder.push_back(result.chunk);
+    }
+}
+
+void WorldStreamer::PlaceWaiting(int budget)
+{
+    while (budget > 0 && !m_placeOrder.empty())
+    {
+        Chunk& chunk = m_chunks[m_placeOrder.front()];
+
+        //rŊOꂽ`N
+        if (chunk.state != CHUNK_PLACING)
+        {
+            m_placeOrder.pop_front();
+            continue;
+        }
+
+        //납u(vector ̐擪lߒȂ)
+        while (budget > 0 && !chunk.waiting.empty())
+        {
+            const Instance instance = chunk.waiting.back();
+            chunk.waiting.pop_back();
+
+            //RC_[̓o^̂Ō͂(CXbh)ō
+            const BuildingConfig& config = m_layers[instance.layer].config;
+            std::shared_ptr<Building> building = BuildingSpawner::CreateBuilding(config, instance.position);
+
+            //spawner (x`}[N)̓V[ɒuɐ
+            if (m_spawner)
+            {
+                UploadModel(instance.layer);
+                m_spawner->Place(config, building);
+            }
+            chunk.placed.push_back(std::move(building));
+            m_stats.resident++;
+            --budget;
+        }
+
+        if (chunk.waiting.empty())
+        {
+            chunk.state = CHUNK_LOADED;
+            m_stats.loads++;
+            m_placeOrder.pop_front();
+        }
+    }
+
+    //ԂƂ̐
+    m_stats.loaded = 0;
+    m_stats.pending = 0;
+    for (int index : m_activeChunks)
+    {
+        if (m_chunks[index].state == CHUNK_LOADED) { m_stats.loaded++; }
+        else { m_stats.pending++; }
+    }
+}
+
+void WorldStreamer::UploadModel(int layer)
+{
+    const int slot = m_layerSlot[layer];
+    if (slot < 0 || m_models[slot] || !m_prepared[slot])
+    {
+        return;
+    }
+
+    //ǂݍݗpXbh_ECfbNX GPU obt@(̊Ԃɑœǂݍ܂Ă΂g)
+    //(̌ Place  LoadModel  ModelCache Bǂݍ߂Ȃ͂œǂݒ)
+    m_models[slot] = ModelCache::Find(m_modelSlots[slot].path);
+    if (!m_models[slot])
+    {
+        m_models[slot] = ModelComponent::UploadModel(*m_prepared[slot]);
+    }
+    m_prepared[slot].reset();
+}
+
+float WorldStreamer::DistanceSqToChunk(const Chunk& chunk, const Vector3& pos)
+{
+    //XZ ʂŃ`N̎lp̈ԋ߂_܂
+    const float dx = std::max({ chunk.minX - pos.x, 0.0f, pos.x - chunk.maxX });
+    const float dz = std::max({ chunk.minZ - pos.z, 0.0f, pos.z - chunk.maxZ });
+    return dx * dx + dz * dz;
+}
+
+void WorldStreamer::RunStreamingBenchmark(std::vector<std::string>& outLines)
+{
+    const int sizes[] = { 128, 256, 512 };
+    const int frames = 600;
+    const Settings settings;
+    char buf[256];
+
+    outLines.push_back("World streaming benchmark (player crosses the stage diagonally in 600 frames, sync)");
+
+    for (int size : sizes)
+    {
+        //FreeStage01 Ɠ炢̊̊
+        StageGrid grid;
+        grid.rows = size;
+        grid.cols = size;
+        grid.cells.resize(static_cast<size_t>(size) * size);
+        RandomStream rng(12345, 0);
+        for (int& value : grid.cells)
+        {
+            const float r = rng.NextFloat();
+            value = (r < 0.12f) ? 1 : (r < 0.15f) ? 2 : 0;
+        }
+
+        StageLayout layout;
+        layout.baseY = -12.0f;
+        StageData stage;
+        StageCache::Build(grid, layout, stage);
+
+        //GameScene Ɠ̐ݒ
+        std::vector<Layer> layers(2);
+        layers[0].cellValue = 1;
+        layers[0].config.scaleX = 60.0f;
+        layers[0].config.scaleZ = 60.0f;
+        layers[0].config.spacing = 30.0f;
+        layers[1].cellValue = 2;
+        layers[1].config.scaleX = 80.0f;
+        layers[1].config.scaleZ = 80.0f;
+        layers[1].config.spacing = 40.0f;
+        for (Layer& layer : layers)
+        {
+            layer.config.fixedPositions = stage.GetPlacements(layer.cellValue);
+            layer.config.count = 0;
+        }
+
+        int chunkCols = 0;
+        int chunkRows = 0;
+        std::vector<Chunk> chunks;
+        std::vector<std::vector<Instance>> plan;
+
+        auto planStart = std::chrono::high_resolution_clock::now();
+        BuildChunks(grid, layout, settings.chunkCells, chunkCols, chunkRows, chunks);
+        BuildPlan(grid, layout, settings.chunkCells, chunkCols, layers, plan);
+        auto planEnd = std::chrono::high_resolution_clock::now();
+
+        size_t total = 0;
+        for (const auto& list : plan)
+        {
+            total += list.size();
+        }
+
+        //S̃`NāA߂Â猚Aꂽ̂Ă
+        const float loadSq = settings.loadRadius * settings.loadRadius;
+        const float unloadSq = settings.unloadRadius * settings.unloadRadius;
+        const float half = size * layout.cellSize * 0.5f;
+
+        int resident = 0;
+        int maxResident = 0;
+        double residentSum = 0.0;
+        int loads = 0;
+        int unloads = 0;
+        double totalMs = 0.0;
+        double maxMs = 0.0;
+        for (int frame = 0; frame <= frames; ++frame)
+        {
+            const float t = static_cast<float>(frame) / frames;
+            const float p = -half + 2.0f * half * t;
+            const Vector3 focus(p, 0.0f, p);
+
+            auto start = std::chrono::high_resolution_clock::now();
+            for (size_t i = 0; i < chunks.size(); ++i)
+            {
+                Chunk& chunk = chunks[i];
+                const float distSq = DistanceSqToChunk(chunk, focus);
+                if (chunk.state == CHUNK_UNLOADED && distSq <= loadSq)
+                {
+                    for (const Instance& instance : plan[i])
+                    {
+                        chunk.placed.push_back(BuildingSpawner::CreateBuilding(layers[instance.layer].config, instance.position));
+                    }
+                    resident += static_cast<int>(chunk.placed.size());
+                    chunk.state = CHUNK_LOADED;
+                    loads++;
+                }
+                else if (chunk.state == CHUNK_LOADED && distSq > unloadSq)
+                {
+                    resident -= static_cast<int>(chunk.placed.size());
+                    chunk.placed.clear();
+                    chunk.state = CHUNK_UNLOADED;
+                    unloads++;
+                }
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+
+            const double ms = std::chrono::duration<double, std::milli>(end - start).count();
+            totalMs += ms;
+            maxMs = std::max(maxMs, ms);
+            maxResident = std::max(maxResident, resident);
+            residentSum += resident;
+        }
+
+        sprintf_s(buf, "  %3dx%-3d : %zu buildings in %zu chunks, resident avg %.0f / max %d, loads %d, unloads %d",
+            size, size, total, chunks.size(), residentSum / (frames + 1), maxResident, loads, unloads);
+        outLines.push_back(buf);
+        sprintf_s(buf, "            plan %.1f ms (loader thread in game), frame avg %.3f / max %.3f ms",
+            std::chrono::duration<double, std::milli>(planEnd - planStart).count(), totalMs / (frames + 1), maxMs);
+        outLines.push_back(buf);
+    }
+}
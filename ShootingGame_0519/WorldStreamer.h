@@ -0,0 +1,182 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <SimpleMath.h>
+#include "StageCache.h"
+#include "BuildingSpawner.h"
+
+class Building;
+struct ModelData;
+struct PreparedModel;
+
+//---------------------------------------------------------
+// Xe[W̌`N(chunkCells x chunkCells }X)ɕāA
+// vC[̎肾V[ɒuNX
+// EloadRadius ɓ`Nǂݍ݁AunloadRadius oO(Ԃ͉Ȃ)
+// Eǂݍݗp̃Xbhōs
+//   dȂ̑Iʂƃ`NƂ̒uꏊ(C[ƈʒu)A
+//   `Nɏ߂ďoĂf CPU ̓ǂݍ(AssimpE_̍œKELODBModelComponent::PrepareModel)
+// ECXbhōs
+//   f GPU ւ̓](ModelComponent::UploadModel)ƁA(RC_[EoEf)
+//   V[ɒu(1t[ spawnBudget ܂)
+//   (D3D ̃foCX CollisionManager Ȃǂ static ȓo^̓CXbhG)
+// ẼRC_[̓C[̐ݒ̑傫 AABB Ȃ̂ŁAƂɑOč`͖
+// E~j}bv̓V[ Building 疈t[̂ŁAuo
+//---------------------------------------------------------
+class WorldStreamer
+{
+public:
+    struct Settings
+    {
+        int chunkCells = 8;             //1`N̕ӂ̃}X
+        float loadRadius = 600.0f;      //`N͈̔͂܂ł̋߂Γǂݍ
+        float unloadRadius = 750.0f;    //艓ΊO(loadRadius 傫)
+        int spawnBudget = 64;           //1t[ɃV[ɒu̐̏
+    };
+
+    //}X̒l1̌(cfg.fixedPositions ̓Xe[W疄߂)
+    struct Layer
+    {
+        int cellValue = 0;
+        BuildingConfig config;
+    };
+
+    struct Stats
+    {
+        int chunks = 0;         //Xe[WŜ̃`N
+        int loaded = 0;         //uI`N
+        int pending = 0;        //ǂݍݑ҂EuĂr̃`N
+        int resident = 0;       //V[ɒuĂ錚
+        int loads = 0;          //ǂݍ񂾉񐔂̍v
+        int unloads = 0;        //O񐔂̍v
+        float planMs = 0.0f;    //dȂ̑Iʂƃ`N(ǂݍݗpXbh)
+        float modelMs = 0.0f;   //f CPU ̓ǂݍ݂̍v(ǂݍݗpXbh)
+        float placeMs = 0.0f;   //߂ Update ŃV[ɒu
+    };
+
+    //ǂݍݗp̃Xbh𗧂ĂĔzǔvn߂(Update ͌v悪I܂ŉȂ)
+    static bool Init(BuildingSpawner* spawner, const StageData& stage, const std::vector<Layer>& layers, const Settings& settings);
+    static void Uninit();
+
+    //focusPos ̎̃`N𗊂݁A͂̂uÂO
+    static void Update(const DirectX::SimpleMath::Vector3& focusPos);
+
+    //v focusPos ̎̓ǂݍ݂I܂ő҂đSu(V[̏p)
+    static void LoadAround(const DirectX::SimpleMath::Vector3& focusPos);
+
+    //--------Get֐-------
+    static bool IsActive() { return m_active; }
+    static const Stats& GetStats() { return m_stats; }
+
+    //傫Xe[WvC[؂̒uĂ鐔Ǝ(DebugBenchmark ɓo^)
+    //Q[ WorldStreamer Ƃ͕ʂɁA`NEv𓯊œ
+    static void RunStreamingBenchmark(std::vector<std::string>& outLines);
+
+private:
+    enum CHUNK_STATE
+    {
+        CHUNK_UNLOADED,
+        CHUNK_REQUESTED,    //ǂݍݗpXbhɗ
+        CHUNK_PLACING,      //͂̂ŏuĂ
+        CHUNK_LOADED,
+    };
+
+    struct Instance
+    {
+        int layer;
+        DirectX::SimpleMath::Vector3 position;
+    };
+
+    //ǂݍރf1(Init ōA͓ǂނ)
+    struct ModelSlot
+    {
+        std::string path;
+        bool cached = false;    //Init ̎ ModelCache ɂ(ǂݍݗpXbhł͓ǂ܂Ȃ)
+    };
+
+    //CXbhG
+    struct Chunk
+    {
+        CHUNK_STATE state = CHUNK_UNLOADED;
+        uint32_t generation = 0;    //Oi߂(Âǂݍ݌ʂ̂Ă)
+        float minX = 0.0f, minZ = 0.0f, maxX = 0.0f, maxZ = 0.0f;
+        std::vector<std::shared_ptr<Building>> placed;
+        std::vector<Instance> waiting;      //͂܂ĂȂ
+    };
+
+    //ǂݍݗpXbhƂ̂
+    struct Request
+    {
+        int chunk;
+        uint32_t generation;
+    };
+    struct PreparedSlot
+    {
+        int slot;
+        std::shared_ptr<PreparedModel> model;   //ǂݍ߂Ȃ nullptr
+    };
+    struct Result
+    {
+        int chunk;
+        uint32_t generation;
+        std::vector<Instance> instances;
+        std::vector<PreparedSlot> models;       //̃`Nŏ߂ďoĂf
+        float modelMs = 0.0f;
+    };
+
+    static void LoaderMain();
+
+    //Xe[W`Nɕ / dȂIʂĒu`NƂɕ(ǂoGȂ)
+    static void BuildChunks(const StageGrid& grid, const StageLayout& layout, int chunkCells, int& outCols, int& outRows, std::vector<Chunk>& out);
+    static void BuildPlan(const StageGrid& grid, const StageLayout& layout, int chunkCells, int chunkCols,
+        std::vector<Layer>& layers, std::vector<std::vector<Instance>>& out);
+
+    static void RequestChunk(int index);
+    static void UnloadChunk(int index);
+    static void ReceiveResults();
+    static void PlaceWaiting(int budget);
+    static void UploadModel(int layer);
+
+    static float DistanceSqToChunk(const Chunk& chunk, const DirectX::SimpleMath::Vector3& pos);
+
+    static bool m_active;
+    static Settings m_settings;
+    static BuildingSpawner* m_spawner;
+    static std::vector<Layer> m_layers;
+
+    //f(m_modelSlots  m_layerSlot  Init ͓̌ǂނ)
+    static std::vector<ModelSlot> m_modelSlots;
+    static std::vector<int> m_layerSlot;                            //C[ -> m_modelSlots ̔ԍ(f -1)
+    static std::vector<std::shared_ptr<PreparedModel>> m_prepared;  //͂܂ GPU ɏグĂȂ(CXbh)
+    static std::vector<std::shared_ptr<ModelData>> m_models;        //グfBuĂ ModelCache OȂ悤Ɏ(CXbh)
+
+    static StageGrid m_grid;
+    static StageLayout m_layout;
+    static int m_chunkCols;
+    static int m_chunkRows;
+    static std::vector<Chunk> m_chunks;
+    static std::vector<int> m_activeChunks;     //UNLOADED ȊÕ`N
+    static std::deque<int> m_placeOrder;        //͂(PLACING ̃`N)
+
+    //v(ǂݍݗpXbhAm_planReady ͓̌ǂނ)
+    static std::vector<std::vector<Instance>> m_plan;
+    static std::atomic<bool> m_planReady;
+    static float m_planMs;                      //v̎(m_planReady ̑OɏAɃCXbh Stats ֎ʂ)
+
+    static std::thread m_thread;
+    static std::mutex m_mutex;
+    static std::condition_variable m_wakeCv;
+    static std::condition_variable m_doneCv;
+    static std::deque<Request> m_requests;
+    static std::vector<Result> m_results;
+    static int m_inFlight;                      //񂾂ʂ܂󂯎ĂȂ
+    static bool m_quit;
+
+    static Stats m_stats;
+};
@@ -0,0 +1,107 @@
+#ifdef _WIN32
+#include "XAudio2AudioBackend.h"
+
+XAudio2AudioBackend::~XAudio2AudioBackend()
+{
+    Stop();
+}
+
+bool XAudio2AudioBackend::Start(int sampleRate, int channels, RenderFunc render)
+{
+    HRESULT hr = XAudio2Create(m_xaudio.ReleaseAndGetAddressOf(), 0, XAUDIO2_DEFAULT_PROCESSOR);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("XAudio2AudioBackend: XAudio2Create failed\n");
+        return false;
+    }
+
+    hr = m_xaudio->CreateMasteringVoice(&m_masterVoice);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("XAudio2AudioBackend: CreateMasteringVoice failed\n");
+        Stop();
+        return false;
+    }
+
+    //~LT[̏o͂̂܂(float)
+    WAVEFORMATEX format{};
+    format.wFormatTag = WAVE_FORMAT_IEEE_FLOAT;
+    format.nChannels = static_cast<WORD>(channels);
+    format.nSamplesPerSec = static_cast<DWORD>(sampleRate);
+    format.wBitsPerSample = 32;
+    format.nBlockAlign = static_cast<WORD>(channels * sizeof(float));
+    format.nAvgBytesPerSec = format.nSamplesPerSec * format.nBlockAlign;
+    format.cbSize = 0;
+
+    hr = m_xaudio->CreateSourceVoice(&m_sourceVoice, &format, 0, XAUDIO2_DEFAULT_FREQ_RATIO, &m_callback);
+    if (FAILED(hr))
+    {
+        OutputDebugStringA("XAudio2AudioBackend: CreateSourceVoice failed\n");
+        Stop();
+        return false;
+    }
+
+    m_render = std::move(render);
+    m_channels = channels;
+    for (auto& buffer : m_buffers)
+    {
+        buffer.assign(static_cast<size_t>(BLOCK_FRAMES) * channels, 0.0f);
+    }
+    m_nextBuffer = 0;
+    m_running = true;
+
+    //ɑSςł炵n߂
+    for (int i = 0; i < BUFFER_COUNT; ++i)
+    {
+        SubmitNext();
+    }
+
+    hr = m_sourceVoice->Start();
+    if (FAILED(hr))
+    {
+        Stop();
+        return false;
+    }
+
+    return true;
+}
+
+void XAudio2AudioBackend::Stop()
+{
+    m_running = false;
+
+    //DestroyVoice ̓R[obNÎ҂̂ŁǍ render ͌Ă΂Ȃ
+    if (m_sourceVoice)
+    {
+        m_sourceVoice->Stop();
+        m_sourceVoice->FlushSourceBuffers();
+        m_sourceVoice->DestroyVoice();
+        m_sourceVoice = nullptr;
+    }
+
+    if (m_masterVoice)
+    {
+        m_masterVoice->DestroyVoice();
+        m_masterVoice = nullptr;
+    }
+
+    m_xaudio.Reset();
+    m_render = nullptr;
+}
+
+void XAudio2AudioBackend::SubmitNext()
+{
+    if (!m_running || !m_sourceVoice) { return; }
+
+    std::vector<float>& buffer = m_buffers[m_nextBuffer];
+    m_nextBuffer = (m_nextBuffer + 1) % BUFFER_COUNT;
+
+    m_render(buffer.data(), BLOCK_FRAMES);
+
+    XAUDIO2_BUFFER buf{};
+    buf.AudioBytes = static_cast<UINT32>(buffer.size() * sizeof(float));
+    buf.pAudioData = reinterpret_cast<const BYTE*>(buffer.data());
+
+    m_sourceVoice->SubmitSourceBuffer(&buf);
+}
+#endif
@@ -0,0 +1,64 @@
+#pragma once
+//Windows (ł Sound  NullAudioBackend g)
+#ifdef _WIN32
+#include <wrl/client.h>
+#include <xaudio2.h>
+#include <array>
+#include <atomic>
+#include <vector>
+#include "AudioBackend.h"
+
+//---------------------------------------------------------
+// XAudio2 ɏo͂
+// float ̃\[X{CX1Aobt@1Ix
+// XAudio2 ̃Xbh玟̃ubN render Čp
+//---------------------------------------------------------
+class XAudio2AudioBackend : public AudioBackend
+{
+public:
+    XAudio2AudioBackend() = default;
+    ~XAudio2AudioBackend() override;
+
+    const char* GetName() const override { return "XAudio2"; }
+
+    bool Start(int sampleRate, int channels, RenderFunc render) override;
+    void Stop() override;
+
+private:
+    //L[ɐςłubN̐ƒ(BUFFER_COUNT * BLOCK_FRAMES xɂȂ)
+    static constexpr int BUFFER_COUNT = 3;
+    static constexpr int BLOCK_FRAMES = 480;
+
+    class VoiceCallback : public IXAudio2VoiceCallback
+    {
+    public:
+        explicit VoiceCallback(XAudio2AudioBackend* owner) : m_owner(owner) {}
+
+        void STDMETHODCALLTYPE OnBufferEnd(void*) override { m_owner->SubmitNext(); }
+
+        void STDMETHODCALLTYPE OnVoiceProcessingPassStart(UINT32) override {}
+        void STDMETHODCALLTYPE OnVoiceProcessingPassEnd() override {}
+        void STDMETHODCALLTYPE OnStreamEnd() override {}
+        void STDMETHODCALLTYPE OnBufferStart(void*) override {}
+        void STDMETHODCALLTYPE OnLoopEnd(void*) override {}
+        void STDMETHODCALLTYPE OnVoiceError(void*, HRESULT) override {}
+
+    private:
+        XAudio2AudioBackend* m_owner;
+    };
+
+    //̃ubN~bNXăL[ɐς
+    void SubmitNext();
+
+    Microsoft::WRL::ComPtr<IXAudio2> m_xaudio;
+    IXAudio2MasteringVoice* m_masterVoice = nullptr;
+    IXAudio2SourceVoice* m_sourceVoice = nullptr;
+    VoiceCallback m_callback{ this };
+
+    RenderFunc m_render;
+    int m_channels = 0;
+    std::array<std::vector<float>, BUFFER_COUNT> m_buffers;
+    int m_nextBuffer = 0;
+    std::atomic<bool> m_running{ false };
+};
+#endif
@@ -1,5 +1,7 @@
 #pragma once
+#ifdef _WIN32
 #include	<wrl/client.h>
+#endif
 #include	<cstdint>
 #include	<numbers>
 #include	<SimpleMath.h>
@@ -15,7 +17,9 @@ using Color = DirectX::SimpleMath::Color;
 
 using Quaternion = DirectX::SimpleMath::Quaternion;
 
+#ifdef _WIN32
 using Microsoft::WRL::ComPtr;
+#endif
 
 constexpr float PI = std::numbers::pi_v<float>;
 
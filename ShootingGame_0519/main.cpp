@@ -1,7 +1,14 @@
 #include    "main.h"
 #include    "Application.h"
+#include    "HeadlessRunner.h"
+#include    "TextureBaker.h"
+#include    "BgmStream.h"
+#include    "SeBank.h"
 #include <Windows.h>
 #include <iostream>
+#include <cstring>
+#include <vector>
+#include <string>
 
 static void ForceShowConsole()
 {
@@ -26,8 +33,138 @@ static void ForceShowConsole()
     }
 }
 
-int main(void)
+int main(int argc, char* argv[])
 {
+    //--bake-lod <model>... : f LOD  <model>.lod ɏo
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--bake-lod") != 0) { continue; }
+
+        std::vector<std::string> modelPaths(argv + i + 1, argv + argc);
+
+        Application app(SCREEN_WIDTH, SCREEN_HEIGHT);
+        return HeadlessRunner::BakeLods(modelPaths);
+    }
+
+    //--bake-textures [--format auto|bc1|bc3|bc7] [--filter box|kaiser] [file or dir]... :
+    //PNG / JPEG  BC k <摜>.dds ɏo(w肪 Asset S)
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--bake-textures") != 0) { continue; }
+
+        std::string format = "auto";
+        std::string filter = "box";
+        std::vector<std::string> paths;
+
+        for (int j = i + 1; j < argc; ++j)
+        {
+            if (strcmp(argv[j], "--format") == 0 && j + 1 < argc)
+            {
+                format = argv[++j];
+            }
+            else if (strcmp(argv[j], "--filter") == 0 && j + 1 < argc)
+            {
+                filter = argv[++j];
+            }
+            else
+            {
+                paths.push_back(argv[j]);
+            }
+        }
+        if (paths.empty())
+        {
+            paths.push_back("Asset");
+        }
+
+        return TextureBaker::Bake(paths, format, filter);
+    }
+
+    //--encode-adpcm [file or dir]... : 16bit PCM  WAV  IMA-ADPCM  <WAV>.adpcm ɏo
+    //(w肪 Asset/Sound/BGMBBGM ͂΂𗬂)
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--encode-adpcm") != 0) { continue; }
+
+        std::vector<std::string> paths(argv + i + 1, argv + argc);
+        if (paths.empty())
+        {
+            paths.push_back("Asset/Sound/BGM");
+        }
+
+        return BgmStream::Encode(paths);
+    }
+
+    //--bake-sebank [file or dir]... [--out file] : SE  WAV 1̃oNɋl߂
+    //(w肪 Asset/Sound/SE -> Asset/Sound/SE.bankBV[̏OɃ}bv)
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--bake-sebank") != 0) { continue; }
+
+        std::vector<std::string> paths;
+        std::string outPath = "Asset/Sound/SE.bank";
+        for (int j = i + 1; j < argc; ++j)
+        {
+            if (strcmp(argv[j], "--out") == 0 && j + 1 < argc)
+            {
+                outPath = argv[++j];
+            }
+            else
+            {
+                paths.push_back(argv[j]);
+            }
+        }
+        if (paths.empty())
+        {
+            paths.push_back("Asset/Sound/SE");
+        }
+
+        return SeBank::Bake(paths, outPath);
+    }
+
+    //--self-check : GPU Ŋm߂鎩ȃ`FbN(ǂꂩΏIR[h 1)
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--self-check") != 0) { continue; }
+
+        return HeadlessRunner::RunSelfChecks();
+    }
+
+    //--headless [frames] [--trace file] [--audio-out file] [--seed n] : EBhE GameScene 񂵂ĕ`擝vo(--audio-out ŉ WAV ɏo)
+    //(--seed ȂƖ 1B0 Ȃ烉_)
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--headless") != 0) { continue; }
+
+        int frames = 600;
+        std::string tracePath;
+        std::string audioPath;
+        uint64_t seed = 1;
+
+        for (int j = i + 1; j < argc; ++j)
+        {
+            if (strcmp(argv[j], "--seed") == 0 && j + 1 < argc)
+            {
+                seed = strtoull(argv[++j], nullptr, 10);
+            }
+            else if (strcmp(argv[j], "--trace") == 0 && j + 1 < argc)
+            {
+                tracePath = argv[++j];
+            }
+            else if (strcmp(argv[j], "--audio-out") == 0 && j + 1 < argc)
+            {
+                audioPath = argv[++j];
+            }
+            else if (atoi(argv[j]) > 0)
+            {
+                frames = atoi(argv[j]);
+            }
+        }
+
+        //ʃTCY(ˉesEUIWp)߂Ă
+        Application app(SCREEN_WIDTH, SCREEN_HEIGHT);
+        return HeadlessRunner::Run(frames, tracePath, audioPath, seed);
+    }
+
 #if defined(DEBUG) || defined(_DEBUG)
     ForceShowConsole();
     _CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
@@ -7,19 +7,30 @@
  */
 
 #include <stdexcept>
+#include <d3d11.h>
 #include <d3dcompiler.h>
 #include <iostream>
 #include <algorithm>
 #include "renderer.h"
+#include "D3D11RenderBackend.h"
 #include "Application.h"
 #include "TransitionManager.h"
 
+// NׂOCu
+#pragma comment(lib,"directxtk.lib")
+#pragma comment(lib,"d3d11.lib")
+
 
 //------------------------------------------------------------------------------
 // X^eBbNoϐ̏
 //------------------------------------------------------------------------------
 
-D3D_FEATURE_LEVEL       Renderer::m_featureLevel = D3D_FEATURE_LEVEL_11_0;
+//D3D ̒l^ renderer.h ɏoȂ̂łŎ
+namespace
+{
+    D3D_FEATURE_LEVEL s_featureLevel = D3D_FEATURE_LEVEL_11_0;
+    D3D11_VIEWPORT s_viewport;                      // V[`pr[|[g
+}
 
 ComPtr<ID3D11Device> Renderer::m_device;
 ComPtr<ID3D11DeviceContext> Renderer::m_deviceContext;
@@ -43,6 +54,7 @@ ComPtr<ID3D11BlendState> Renderer::m_blendStateATC;
 ComPtr<ID3D11VertexShader> Renderer::m_vertexShader;
 ComPtr<ID3D11PixelShader>  Renderer::m_pixelShader;
 ComPtr<ID3D11InputLayout>  Renderer::m_inputLayout;
+ComPtr<ID3D11InputLayout>  Renderer::m_packedInputLayout;
 ComPtr<ID3D11InputLayout>  Renderer::m_axisInputLayout;
 
 ComPtr<ID3D11VertexShader> Renderer::m_gridVertexShader;
@@ -75,7 +87,6 @@ ComPtr<ID3D11DeviceContext> Renderer::m_pContext; // 
 ComPtr<ID3D11BlendState> Renderer::m_pBlendState; // At@uhp
 ComPtr<ID3D11Buffer> Renderer::m_pVertexBuffer; // tXN[p_obt@
 
-D3D11_VIEWPORT Renderer::m_viewport;                // V[`pr[|[g
 ComPtr<ID3D11RasterizerState> Renderer::m_rasterizerState;
 
 PostProcessSettings Renderer::s_postProcess{};
@@ -90,6 +101,8 @@ ComPtr<ID3D11ShaderResourceView> Renderer::m_prevSceneColorSRV;
 ComPtr<ID3D11PixelShader>      Renderer::m_motionBlurPixelShader;
 ComPtr<ID3D11Buffer>           Renderer::m_postProcessBuffer;
 
+std::unique_ptr<RenderBackend> Renderer::m_backend;
+
 
 struct MotionBlurParams
 {
@@ -136,8 +149,25 @@ Microsoft::WRL::ComPtr<ID3DBlob> Renderer::CompileShader(
     return shaderBlob;
 }
 
+void Renderer::SetBackend(std::unique_ptr<RenderBackend> backend)
+{
+    m_backend = std::move(backend);
+}
+
 void Renderer::Init()
 {
+    //obNGh܂ĂȂ D3D11 g
+    if (!m_backend)
+    {
+        m_backend = std::make_unique<D3D11RenderBackend>();
+    }
+
+    //wbhXȂfoCXEXbv`F[͍Ȃ
+    if (m_backend->IsHeadless())
+    {
+        OutputDebugStringA(("Renderer: headless backend (" + std::string(m_backend->GetName()) + ")\n").c_str());
+        return;
+    }
 
     HRESULT hr = S_OK;
 
@@ -163,7 +193,7 @@ void Renderer::Init()
         nullptr, 0, D3D11_SDK_VERSION, &swapChainDesc,
         m_swapChain.GetAddressOf(),
         m_device.GetAddressOf(),
-        &m_featureLevel,
+        &s_featureLevel,
         m_deviceContext.GetAddressOf());
     if (FAILED(hr))
     {
@@ -307,13 +337,13 @@ void Renderer::Init()
         throw std::runtime_error("Failed to create MotionBlur pixel shader");
     }
 
-    m_viewport.Width = static_cast<FLOAT>(Application::GetWidth());
-    m_viewport.Height = static_cast<FLOAT>(Application::GetHeight());
-    m_viewport.MinDepth = 0.0f;
-    m_viewport.MaxDepth = 1.0f;
-    m_viewport.TopLeftX = 0;
-    m_viewport.TopLeftY = 0;
-    m_deviceContext->RSSetViewports(1, &m_viewport);
+    s_viewport.Width = static_cast<FLOAT>(Application::GetWidth());
+    s_viewport.Height = static_cast<FLOAT>(Application::GetHeight());
+    s_viewport.MinDepth = 0.0f;
+    s_viewport.MaxDepth = 1.0f;
+    s_viewport.TopLeftX = 0;
+    s_viewport.TopLeftY = 0;
+    m_deviceContext->RSSetViewports(1, &s_viewport);
 
 
     // --- X^CUXe[gݒ ---
@@ -487,6 +517,21 @@ void Renderer::Init()
 
     m_device->CreateInputLayout(layoutDesc, _countof(layoutDesc),vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(),m_inputLayout.GetAddressOf());
 
+    // l߂_(VERTEX_PACKED)pBSNORM / UNORM / FLOAT16 ͓͎ float ֖߂̂œVF[_[ŕ`
+    D3D11_INPUT_ELEMENT_DESC packedLayoutDesc[] =
+    {
+        { "POSITION",  0, DXGI_FORMAT_R32G32B32_FLOAT,      0, offsetof(VERTEX_PACKED, Position), D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "NORMAL",    0, DXGI_FORMAT_R8G8B8A8_SNORM,       0, offsetof(VERTEX_PACKED, Normal),   D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "COLOR",     0, DXGI_FORMAT_R8G8B8A8_UNORM,       0, offsetof(VERTEX_PACKED, Diffuse),  D3D11_INPUT_PER_VERTEX_DATA, 0 },
+        { "TEXCOORD",  0, DXGI_FORMAT_R16G16_FLOAT,         0, offsetof(VERTEX_PACKED, TexCoord), D3D11_INPUT_PER_VERTEX_DATA, 0 },
+    };
+
+    hr = m_device->CreateInputLayout(packedLayoutDesc, _countof(packedLayoutDesc), vsBlob->GetBufferPointer(), vsBlob->GetBufferSize(), m_packedInputLayout.GetAddressOf());
+    if (FAILED(hr))
+    {
+        throw std::runtime_error("Failed to create packed input layout");
+    }
+
     //-----------------------ŌɃVF[_[^CAEgZbg-----------------------
     m_deviceContext->IASetInputLayout(m_inputLayout.Get());
     m_deviceContext->VSSetShader(m_vertexShader.Get(), nullptr, 0);
@@ -644,6 +689,9 @@ void Renderer::Uninit()
     m_deviceContext.Reset();
     m_device.Reset();
     m_pContext.Reset();
+
+    // Init ł͉߂ SetBackend 邩 D3D11 ɂȂ
+    m_backend.reset();
 }
 
 //ʂwFiFjŃNA
@@ -651,6 +699,9 @@ void Renderer::Uninit()
 //t[KĂяoāAÕt[̎c܂B
 void Renderer::Begin()
 {
+    m_backend->BeginFrame();
+    if (IsHeadless()) { return; }
+
     ID3D11RenderTargetView* rtv = m_sceneColorRTV.Get();
     m_deviceContext->OMSetRenderTargets(1, &rtv, m_depthStencilView.Get());
 
@@ -667,6 +718,9 @@ void Renderer::Begin()
 
 void Renderer::End()
 {
+    m_backend->EndFrame();
+    if (IsHeadless()) { return; }
+
     ID3D11RenderTargetView* backRTV = m_renderTargetView.Get();
     m_deviceContext->OMSetRenderTargets(1, &backRTV, nullptr);
     m_swapChain->Present(1, 0);
@@ -675,11 +729,27 @@ void Renderer::End()
 
 void Renderer::Present()
 {
+    if (IsHeadless()) { return; }
+
     m_swapChain->Present(1, 0);
 }
 
+void Renderer::SetTexture(ID3D11ShaderResourceView* texture)
+{
+    if (IsHeadless()) { m_backend->SetTexture(texture); return; }
+    m_deviceContext->PSSetShaderResources(0, 1, &texture);
+}
+
+void Renderer::ClearDepthBuffer()
+{
+    if (IsHeadless()) { return; }
+    m_deviceContext->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
+}
+
 void Renderer::SetDepthEnable(bool Enable)
 {
+    if (IsHeadless()) { m_backend->SetDepthEnable(Enable); return; }
+
     m_deviceContext->OMSetDepthStencilState(
         Enable ? m_depthStateEnable.Get() : m_depthStateDisable.Get(), 0);
 }
@@ -692,6 +762,8 @@ void Renderer::SetDepthEnable(bool Enable)
  */
 void Renderer::SetATCEnable(bool Enable)
 {
+    if (IsHeadless()) { return; }
+
     float blendFactor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
     m_deviceContext->OMSetBlendState(
         Enable ? m_blendStateATC.Get() : m_blendState[0].Get(),
@@ -706,6 +778,8 @@ void Renderer::SetATCEnable(bool Enable)
  */
 void Renderer::SetWorldViewProjection2D()
 {
+    if (IsHeadless()) { return; }
+
     Matrix4x4 world = Matrix4x4::Identity.Transpose();
     m_deviceContext->UpdateSubresource(m_worldBuffer.Get(), 0, nullptr, &world, 0, 0);
 
@@ -725,6 +799,8 @@ void Renderer::SetWorldViewProjection2D()
 
 void Renderer::SetTextureAlpha(float alpha)
 {
+    if (IsHeadless()) { return; }
+
     CBTextureAlpha cb{};
     cb.Alpha = alpha;
     // UpdateSubresource  CB XV
@@ -741,6 +817,8 @@ void Renderer::SetTextureAlpha(float alpha)
  */
 void Renderer::SetWorldMatrix(Matrix4x4* WorldMatrix)
 {
+    if (IsHeadless()) { m_backend->SetWorldMatrix(*WorldMatrix); return; }
+
     Matrix4x4 mat = WorldMatrix->Transpose();
     m_deviceContext->UpdateSubresource(m_worldBuffer.Get(), 0, nullptr, &mat, 0, 0);
 }
@@ -752,6 +830,7 @@ void Renderer::SetWorldMatrix(Matrix4x4* WorldMatrix)
 void Renderer::SetViewMatrix(SimpleMath::Matrix ViewMatrix)
 {
     m_cachedView = ViewMatrix;
+    if (IsHeadless()) { m_backend->SetViewMatrix(ViewMatrix); return; }
 
     SimpleMath::Matrix mat = ViewMatrix.Transpose();
     m_deviceContext->UpdateSubresource(m_viewBuffer.Get(), 0, nullptr, &mat, 0, 0);
@@ -764,6 +843,7 @@ void Renderer::SetViewMatrix(SimpleMath::Matrix ViewMatrix)
 void Renderer::SetProjectionMatrix(SimpleMath::Matrix ProjectionMatrix)
 {
     m_cachedProjection = ProjectionMatrix;
+    if (IsHeadless()) { m_backend->SetProjectionMatrix(ProjectionMatrix); return; }
 
     SimpleMath::Matrix mat = ProjectionMatrix.Transpose();
     m_deviceContext->UpdateSubresource(m_projectionBuffer.Get(), 0, nullptr, &mat, 0, 0);
@@ -775,6 +855,8 @@ void Renderer::SetProjectionMatrix(SimpleMath::Matrix ProjectionMatrix)
  */
 void Renderer::SetMaterial(MATERIAL Material)
 {
+    if (IsHeadless()) { m_backend->SetMaterial(Material); return; }
+
     m_deviceContext->UpdateSubresource(m_materialBuffer.Get(), 0, nullptr, &Material, 0, 0);
 }
 
@@ -784,6 +866,8 @@ void Renderer::SetMaterial(MATERIAL Material)
  */
 void Renderer::SetLight(LIGHT Light)
 {
+    if (IsHeadless()) { return; }
+
     m_deviceContext->UpdateSubresource(m_lightBuffer.Get(), 0, nullptr, &Light, 0, 0);
 }
 
@@ -793,6 +877,8 @@ void Renderer::SetLight(LIGHT Light)
  */
 void Renderer::SetBlendState(int nBlendState)
 {
+    if (IsHeadless()) { m_backend->SetBlendState(nBlendState); return; }
+
     if (nBlendState >= 0 && nBlendState < MAX_BLENDSTATE) 
     {
         float blendFactor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
@@ -806,6 +892,8 @@ void Renderer::SetBlendState(int nBlendState)
  */
 void Renderer::DisableCulling(bool cullflag)
 {
+    if (IsHeadless()) { m_backend->SetCulling(cullflag); return; }
+
     D3D11_RASTERIZER_DESC rasterizerDesc{};
     rasterizerDesc.FillMode = D3D11_FILL_SOLID;
     rasterizerDesc.CullMode = cullflag ? D3D11_CULL_BACK : D3D11_CULL_NONE;
@@ -828,12 +916,14 @@ void Renderer::DisableCulling(bool cullflag)
 
 /**
  * @brief X^CUXe[g̃tB[hihԂ/C[t[jݒ肵܂B
- * @param FillMode D3D11_FILL_SOLID ܂ D3D11_FILL_WIREFRAME
+ * @param wireframe true Ȃ D3D11_FILL_WIREFRAMEAfalse Ȃ D3D11_FILL_SOLID
  */
-void Renderer::SetFillMode(D3D11_FILL_MODE FillMode)
+void Renderer::SetFillMode(bool wireframe)
 {
+    if (IsHeadless()) { return; }
+
     D3D11_RASTERIZER_DESC rasterizerDesc{};
-    rasterizerDesc.FillMode = FillMode;
+    rasterizerDesc.FillMode = wireframe ? D3D11_FILL_WIREFRAME : D3D11_FILL_SOLID;
     rasterizerDesc.CullMode = D3D11_CULL_BACK;
     rasterizerDesc.DepthClipEnable = TRUE;
     rasterizerDesc.MultisampleEnable = FALSE;
@@ -853,6 +943,8 @@ void Renderer::SetFillMode(D3D11_FILL_MODE FillMode)
  */
 void Renderer::SetDepthAllwaysWrite()
 {
+    if (IsHeadless()) { return; }
+
     D3D11_DEPTH_STENCIL_DESC depthStencilDesc{};
     depthStencilDesc.DepthEnable = TRUE;
     depthStencilDesc.DepthFunc = D3D11_COMPARISON_ALWAYS; // ɐ[xeXg
@@ -885,6 +977,8 @@ const PostProcessSettings& Renderer::GetPostProcessSettings()
  */
 void Renderer::DrawTexture(ID3D11ShaderResourceView* texture, const Vector2& position, const Vector2& size)
 {
+    if (IsHeadless()) { m_backend->DrawTexture(texture, position, size); return; }
+
     //std::cout << "[Renderer] DrawTexture start texture=" << texture << " pos=(" << position.x << "," << position.y << ") size=(" << size.x << "," << size.y << ")\n";
        
     if (!texture) { OutputDebugStringA("DBG: DrawTexture - texture null\n"); return; }
@@ -1036,6 +1130,8 @@ void Renderer::DrawTexture(ID3D11ShaderResourceView* texture, const Vector2& pos
 
 void Renderer::ApplyMotionBlur()
 {
+    if (IsHeadless()) { return; }
+
     float blur = std::clamp(s_postProcess.motionBlurAmount, 0.0f, 1.0f);
    
     if (!m_sceneColorTex || !m_sceneColorSRV || !m_prevSceneColorSRV){ return; }
@@ -1279,6 +1375,13 @@ void Renderer::ApplyMotionBlur()
 
 void Renderer::DrawReticle(ID3D11ShaderResourceView* texture, const POINT& center, const Vector2& size)
 {
+    if (IsHeadless())
+    {
+        Vector2 topLeft(static_cast<float>(center.x) - size.x * 0.5f, static_cast<float>(center.y) - size.y * 0.5f);
+        m_backend->DrawTexture(texture, topLeft, size);
+        return;
+    }
+
     if (!texture) return;
 
     // Save/restore depth & blend state quickly (we'll use DrawTexture which restores most state)
@@ -1311,6 +1414,8 @@ void Renderer::DrawReticle(ID3D11ShaderResourceView* texture, const POINT& cente
 
 void Renderer::BeginSceneRenderTarget()
 {
+    if (IsHeadless()) { return; }
+
     ID3D11RenderTargetView* rtv = m_sceneColorRTV.Get();
     ID3D11DepthStencilView* dsv = m_depthStencilView.Get();
 
@@ -1323,12 +1428,14 @@ void Renderer::BeginSceneRenderTarget()
 
     // V[pXe[g
     m_deviceContext->RSSetState(m_rasterizerState.Get());
-    m_deviceContext->RSSetViewports(1, &m_viewport);
+    m_deviceContext->RSSetViewports(1, &s_viewport);
 }
 
 
 void Renderer::BeginBackBuffer()
 {
+    if (IsHeadless()) { return; }
+
     ID3D11RenderTargetView* rtv = m_renderTargetView.Get();
     m_deviceContext->OMSetRenderTargets(1, &rtv, nullptr);
 
@@ -1341,6 +1448,8 @@ void Renderer::BeginBackBuffer()
 
 void Renderer::BeginPlayerRenderTarget()
 {
+    if (IsHeadless()) { return; }
+
     ID3D11RenderTargetView* rtv = m_playerColorRTV.Get();
 
     // [x͎gĂOKiPlayer̃f`pj
@@ -1353,17 +1462,19 @@ void Renderer::BeginPlayerRenderTarget()
         D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1.0f, 0);
 
     m_deviceContext->RSSetState(m_rasterizerState.Get());
-    m_deviceContext->RSSetViewports(1, &m_viewport);
+    m_deviceContext->RSSetViewports(1, &s_viewport);
 }
 
 void Renderer::SetSceneRenderTarget()
 {
+    if (IsHeadless()) { return; }
+
     ID3D11RenderTargetView* rtv = m_sceneColorRTV.Get();
     m_deviceContext->OMSetRenderTargets(1, &rtv, m_depthStencilView.Get());
 
     // ł̓NAȂiłɕ`wiȂ߁j
     m_deviceContext->RSSetState(m_rasterizerState.Get());
-    m_deviceContext->RSSetViewports(1, &m_viewport);
+    m_deviceContext->RSSetViewports(1, &s_viewport);
 }
 
 struct BillboardVertex
@@ -1382,6 +1493,8 @@ void Renderer::DrawBillboard(ID3D11ShaderResourceView* texture,
                              int frameIndex,
                              bool isAdditive)
 {
+    if (IsHeadless()) { m_backend->DrawBillboard(texture, worldPos, size); return; }
+
     if (!texture)
     {
         return;
@@ -1559,6 +1672,8 @@ void Renderer::DrawTrailBillboard(ID3D11ShaderResourceView* texture,
                                   bool isAdditive,
                                   float uvTileU)
 {
+    if (IsHeadless()) { m_backend->DrawBillboard(texture, (startPos + endPos) * 0.5f, width); return; }
+
     if (!texture)
     {
         return;
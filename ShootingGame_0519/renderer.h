@@ -1,113 +1,33 @@
 #pragma once
-#include <d3d11.h>
-#include <io.h>
 #include <string>
 #include <vector>
+#include <memory>
 #include <wrl/client.h>
 #include <SimpleMath.h>
 #include "CommonTypes.h"
 #include "Transform.h"
 #include "VisualSettings.h"
 #include "Sound.h"
+#include "RenderTypes.h"
+#include "RenderBackend.h"
 
 using namespace DirectX;
 
- // NׂOCu
-#pragma comment(lib,"directxtk.lib")
-#pragma comment(lib,"d3d11.lib")
-
- //{[̉eێ\
-struct WEIGHT
-{
-    std::string bonename;   //{[
-    std::string meshname;   //bV
-    float weight;           //EFCgl
-    int vertexindex;        //_CfbNX
-};
-
-//{[\́iDXΉŁj
-struct BONE
-{
-    std::string bonename;          //{[
-    std::string meshname;          //bV
-    std::string armaturename;      //A[}`A
-    Matrix4x4 Matrix{};            //eq֌Wls
-    Matrix4x4 AnimationMatrix{};   //̕ό`݂̂ls
-    Matrix4x4 OffsetMatrix{};      //{[ItZbgs
-    int idx;                       //z񒆂̃CfbNX
-    std::vector<WEIGHT> weights;   //̃{[e^钸_ƃEFCgl̃Xg
-};
-
-
-//R_f[^i[\
-struct VERTEX_3D
-{
-    Vector3 Position;            //_̍W
-    Vector3 Normal;              //@xNg
-    Color Diffuse;               //gUːF
-    Vector2 TexCoord;            //eNX`W
-    int BoneIndex[4];            //{[CfbNXiő4j 20231225
-    float BoneWeight[4];         //e{[̃EFCgl 20231225
-    //std::string BoneName[4];     //e{[̖O 20231226
-    int bonecnt = 0;             //e^{[ 20231226
-};
-
-
-//}eAێ\
-struct MATERIAL
-{
-    Color Ambient;         //ArGgF
-    Color Diffuse;         //gUF
-    Color Specular;        //ʔːF
-    Color Emission;        //ȔF
-    float Shiness;         //x
-    BOOL TextureEnable;    //eNX`gptO
-    float Dummy[2]{};      //\̈
-};
-
-//s̏ێ\
-struct LIGHT
-{
-    BOOL Enable;           //Cg̗L/tO
-    BOOL Dummy[3];         //pfBOpi_~[j
-    Vector4 Direction;     //̕
-    Color Diffuse;         //gU̐F
-    Color Ambient;         //̐F
-};
-
-//bṼTuZbgi}eAjێ\
-struct SUBSET
-{
-    std::string MtrlName;           //}eA
-    unsigned int IndexNum = 0;      //CfbNX
-    unsigned int VertexNum = 0;     //_
-    unsigned int IndexBase = 0;     //JnCfbNX
-    unsigned int VertexBase = 0;    //_x[X
-    unsigned int MaterialIdx = 0;   //}eACfbNX
-};
-
-//uhXe[g̎
-enum EBlendState
-{
-    BS_NONE = 0,      //
-    BS_ALPHABLEND,    //
-    BS_ADDITIVE,      //Z
-    BS_SUBTRACTION,   //Z
-    MAX_BLENDSTATE    //uhXe[g̍ől
-};
-
-//{[Rrl[Vsێ\
-constexpr int MAX_BONE = 400;
-struct CBBoneCombMatrix
-{
-    DirectX::XMFLOAT4X4 BoneCombMtx[MAX_BONE];  ///< {[Rrl[Vs̔z
-};
-
-struct CBTextureAlpha
-{
-    float Alpha;
-    float Padding[3];
-};
+//D3D ̃C^[tF[X̓|C^łȂ̂őO錾ɂ
+//(d3d11.h  D3D 𒼐ڌĂԃt@Cꂼǂ)
+struct ID3D11Device;
+struct ID3D11DeviceContext;
+struct IDXGISwapChain;
+struct ID3D11RenderTargetView;
+struct ID3D11DepthStencilView;
+struct ID3D11SamplerState;
+struct ID3D11DepthStencilState;
+struct ID3D11BlendState;
+struct ID3D11RasterizerState;
+struct ID3D11Texture2D;
+struct ID3D10Blob;
+typedef ID3D10Blob ID3DBlob;
+struct tagPOINT;
 
 // @brief DirectX_OǗ郌_NX
 //̃NX́ADirect3DfoCXAReLXgAXbv`F[Ȃǂ̊ǗƁA
@@ -116,8 +36,6 @@ struct CBTextureAlpha
 class Renderer// : NonCopyable
 {
 private:
-    static D3D_FEATURE_LEVEL m_featureLevel;
-
     static ComPtr<ID3D11Device> m_device;
     static ComPtr<ID3D11DeviceContext> m_deviceContext;
     static ComPtr<IDXGISwapChain> m_swapChain;
@@ -160,13 +78,23 @@ private:
     static Microsoft::WRL::ComPtr<ID3D11Texture2D>          m_prevPlayerColorTex;
     static Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_prevPlayerColorSRV;
 
-    //VF[_RpC̋ʃwp
+    //-------------------------------`obNGh------------------------------
+    static std::unique_ptr<RenderBackend> m_backend;
+
+public:
+    //VF[_RpC̋ʃwp(InstancedRenderer Ȃǂg)
     static Microsoft::WRL::ComPtr<ID3DBlob> CompileShader(const wchar_t* filePath,
                                                           const char* entryPoint,
                                                           const char* target);
 
-public:
     static Renderer& Get();
+
+    //`obNGhւ(Init OɌĂԁBĂ΂Ȃ D3D11)
+    //wbhX̃obNGhȂ D3D foCX͍炸A`̓obNGh֗ɂȂ
+    static void SetBackend(std::unique_ptr<RenderBackend> backend);
+    static RenderBackend* GetBackend() { return m_backend.get(); }
+    static bool IsHeadless() { return m_backend && m_backend->IsHeadless(); }
+
     static void Init();
     static void Uninit();
     static void Begin();
@@ -190,17 +118,14 @@ public:
     static void SetProjectionMatrix(SimpleMath::Matrix ProjectionMatrix);
     static void SetMaterial(MATERIAL Material);
     static void SetLight(LIGHT Light);
-    static void SetTexture(ID3D11ShaderResourceView* texture){m_deviceContext->PSSetShaderResources(0, 1, &texture);}
+    static void SetTexture(ID3D11ShaderResourceView* texture);
     static ID3D11Device* GetDevice(void) { return m_device.Get(); }
     static ID3D11DeviceContext* GetDeviceContext(void) { return m_deviceContext.Get(); }
     static void SetBlendState(int nBlendState);
     static IDXGISwapChain* GetSwapChain() { return m_swapChain.Get(); }
-    static void ClearDepthBuffer()
-    {
-        m_deviceContext->ClearDepthStencilView(m_depthStencilView.Get(), D3D11_CLEAR_DEPTH, 1.0f, 0);
-    }
+    static void ClearDepthBuffer();
     static void DisableCulling(bool cullflag = false);
-    static void SetFillMode(D3D11_FILL_MODE FillMode);
+    static void SetFillMode(bool wireframe);
     static int GetIndexCount() { return m_indexCount; }
     static ID3D11Buffer* GetViewBuffer(){ return m_viewBuffer.Get(); }
     static ID3D11Buffer* GetWorldBuffer(){ return m_worldBuffer.Get(); }
@@ -212,7 +137,7 @@ public:
     static void SetTextureAlpha(float alpha);
 
     //eBNp̊֐
-    static void DrawReticle(ID3D11ShaderResourceView* texture, const POINT& center, const Vector2& size);
+    static void DrawReticle(ID3D11ShaderResourceView* texture, const tagPOINT& center, const Vector2& size);
 
     static void DrawBillboard(ID3D11ShaderResourceView* texture,
                               const DirectX::SimpleMath::Vector3& worldPos,
@@ -254,6 +179,7 @@ public:
     static ComPtr<ID3D11VertexShader> m_vertexShader;
     static ComPtr<ID3D11PixelShader>  m_pixelShader;
     static ComPtr<ID3D11InputLayout>  m_inputLayout;
+    static ComPtr<ID3D11InputLayout>  m_packedInputLayout;   //VERTEX_PACKED p(VF[_[ m_vertexShader)
     static ComPtr<ID3D11InputLayout>  m_axisInputLayout;
 
     //eNX``p̃VF[_[ƃCAEg
@@ -262,7 +188,6 @@ public:
     static ComPtr<ID3D11InputLayout>  m_textureInputLayout;
     static ComPtr<ID3D11Buffer>       m_textureAlphaBuffer;
 
-    static D3D11_VIEWPORT m_viewport;                // V[`pr[|[g
     static Microsoft::WRL::ComPtr<ID3D11RasterizerState> m_rasterizerState; // WX^CU
 
     // Gridp̃VF[_[